@@ -235,6 +235,12 @@ set(
 		executables/cath_resolve_hits/cath_resolve_hits.cpp
 )
 
+set(
+	NORMSOURCES_EXECUTABLES_CATH_RESOLVE_HITS_BENCHMARK
+		executables/cath_resolve_hits_benchmark/cath_resolve_hits_benchmark.cpp
+		executables/cath_resolve_hits_benchmark/heap_alloc_counter.cpp
+)
+
 set(
 	NORMSOURCES_EXECUTABLES_CATH_SCORE_ALIGN
 		executables/cath_score_align/cath_score_align.cpp
@@ -250,6 +256,11 @@ set(
 		executables/cath_superpose/cath_superpose.cpp
 )
 
+set(
+	NORMSOURCES_EXECUTABLES_CATH_SUPERPOSE_PDB_BENCHMARK
+		executables/cath_superpose_pdb_benchmark/cath_superpose_pdb_benchmark.cpp
+)
+
 set(
 	NORMSOURCES_EXECUTABLES_SNAP_JUDGEMENT
 		executables/snap_judgement/snap_judgement.cpp
@@ -264,9 +275,11 @@ set(
 		${NORMSOURCES_EXECUTABLES_CATH_MAP_CLUSTERS}
 		${NORMSOURCES_EXECUTABLES_CATH_REFINE_ALIGN}
 		${NORMSOURCES_EXECUTABLES_CATH_RESOLVE_HITS}
+		${NORMSOURCES_EXECUTABLES_CATH_RESOLVE_HITS_BENCHMARK}
 		${NORMSOURCES_EXECUTABLES_CATH_SCORE_ALIGN}
 		${NORMSOURCES_EXECUTABLES_CATH_SSAP}
 		${NORMSOURCES_EXECUTABLES_CATH_SUPERPOSE}
+		${NORMSOURCES_EXECUTABLES_CATH_SUPERPOSE_PDB_BENCHMARK}
 		${NORMSOURCES_EXECUTABLES_SNAP_JUDGEMENT}
 )
 
@@ -312,10 +325,19 @@ set(
 set(
 	NORMSOURCES_RESOLVE_HITS_ALGO
 		resolve_hits/algo/discont_hits_index_by_start.cpp
+		resolve_hits/algo/dominated_hits_finder.cpp
+		resolve_hits/algo/masked_bests_cache.cpp
 		resolve_hits/algo/masked_bests_cacher.cpp
 		resolve_hits/algo/scored_arch_proxy.cpp
 )
 
+set(
+	NORMSOURCES_RESOLVE_HITS_BENCHMARK
+		resolve_hits/benchmark/crh_benchmark.cpp
+		resolve_hits/benchmark/synthetic_hits_generator.cpp
+		resolve_hits/benchmark/synthetic_hits_spec.cpp
+)
+
 set(
 	NORMSOURCES_RESOLVE_HITS_FILE_DETAIL
 		resolve_hits/file/detail/hmmer_aln.cpp
@@ -326,6 +348,7 @@ set(
 	NORMSOURCES_RESOLVE_HITS_FILE
 		resolve_hits/file/alnd_rgn.cpp
 		resolve_hits/file/cath_id_score_category.cpp
+		resolve_hits/file/crh_columnar_format.cpp
 		${NORMSOURCES_RESOLVE_HITS_FILE_DETAIL}
 		resolve_hits/file/hits_input_format_tag.cpp
 		resolve_hits/file/parse_domain_hits_table.cpp
@@ -374,8 +397,11 @@ set(
 		resolve_hits/read_and_process_hits/hits_processor/gather_hits_processor.cpp
 		resolve_hits/read_and_process_hits/hits_processor/hits_processor_list.cpp
 		resolve_hits/read_and_process_hits/hits_processor/summarise_hits_processor.cpp
+		resolve_hits/read_and_process_hits/hits_processor/write_columnar_hits_processor.cpp
+		resolve_hits/read_and_process_hits/hits_processor/write_html_dir_hits_processor.cpp
 		resolve_hits/read_and_process_hits/hits_processor/write_html_hits_processor.cpp
 		resolve_hits/read_and_process_hits/hits_processor/write_json_hits_processor.cpp
+		resolve_hits/read_and_process_hits/hits_processor/write_jsonl_hits_processor.cpp
 		resolve_hits/read_and_process_hits/hits_processor/write_results_hits_processor.cpp
 )
 
@@ -387,6 +413,7 @@ set(
 
 set(
 	NORMSOURCES_RESOLVE_HITS_RESOLVE
+		resolve_hits/resolve/crh_result_cache.cpp
 		resolve_hits/resolve/hit_resolver.cpp
 		resolve_hits/resolve/naive_greedy_hit_resolver.cpp
 )
@@ -400,6 +427,7 @@ set(
 set(
 	NORMSOURCES_RESOLVE_HITS
 		${NORMSOURCES_RESOLVE_HITS_ALGO}
+		${NORMSOURCES_RESOLVE_HITS_BENCHMARK}
 		resolve_hits/calc_hit.cpp
 		resolve_hits/calc_hit_list.cpp
 		resolve_hits/cath_hit_resolver.cpp
@@ -410,6 +438,7 @@ set(
 		resolve_hits/full_hit_list_fns.cpp
 		resolve_hits/hit_arch.cpp
 		resolve_hits/hit_extras.cpp
+		resolve_hits/hit_label_table.cpp
 		resolve_hits/hit_score_type.cpp
 		${NORMSOURCES_RESOLVE_HITS_HTML_OUTPUT}
 		${NORMSOURCES_RESOLVE_HITS_OPTIONS}
@@ -826,6 +855,7 @@ set(
 		uni/file/pdb/pdb_atom_parse_status.cpp
 		uni/file/pdb/pdb_list.cpp
 		uni/file/pdb/pdb_record.cpp
+		uni/file/pdb/pdb_record_buffer.cpp
 		uni/file/pdb/pdb_residue.cpp
 		uni/file/pdb/proximity_calculator.cpp
 		uni/file/pdb/read_domain_def_from_pdb.cpp
@@ -1090,6 +1120,7 @@ set(
 		uni/score/score_classification/rbf_model.cpp
 		uni/score/score_classification/score_classn_value.cpp
 		uni/score/score_classification/score_classn_value_better_value.cpp
+		uni/score/score_classification/score_classn_value_columns.cpp
 		uni/score/score_classification/score_classn_value_list.cpp
 		uni/score/score_classification/score_classn_value_results_set.cpp
 		uni/score/score_classification/value_list_scaling.cpp
@@ -1139,6 +1170,7 @@ set(
 		${NORMSOURCES_UNI_SSAP_OPTIONS}
 		uni/ssap/selected_pair.cpp
 		uni/ssap/ssap.cpp
+		uni/ssap/ssap_phase_timings.cpp
 		uni/ssap/ssap_scores.cpp
 		uni/ssap/windowed_matrix.cpp
 )
@@ -1195,6 +1227,7 @@ set(
 		uni/structure/protein/amino_acid.cpp
 		uni/structure/protein/dna_atom.cpp
 		uni/structure/protein/protein.cpp
+		uni/structure/protein/protein_comparison_view.cpp
 		uni/structure/protein/protein_io.cpp
 		uni/structure/protein/protein_list.cpp
 		${NORMSOURCES_UNI_STRUCTURE_PROTEIN_PROTEIN_LOADER}
@@ -1520,9 +1553,15 @@ set(
 
 set(
 	TESTSOURCES_RESOLVE_HITS_ALGO
+		resolve_hits/algo/dominated_hits_finder_test.cpp
 		resolve_hits/algo/masked_bests_cache_test.cpp
 )
 
+set(
+	TESTSOURCES_RESOLVE_HITS_BENCHMARK
+		resolve_hits/benchmark/synthetic_hits_generator_test.cpp
+)
+
 set(
 	TESTSOURCES_RESOLVE_HITS_FILE_DETAIL
 		resolve_hits/file/detail/hmmer_parser_test.cpp
@@ -1531,6 +1570,7 @@ set(
 set(
 	TESTSOURCES_RESOLVE_HITS_FILE
 		resolve_hits/file/cath_id_score_category_test.cpp
+		resolve_hits/file/crh_columnar_format_test.cpp
 		${TESTSOURCES_RESOLVE_HITS_FILE_DETAIL}
 )
 
@@ -1576,6 +1616,7 @@ set(
 
 set(
 	TESTSOURCES_RESOLVE_HITS_RESOLVE
+		resolve_hits/resolve/crh_result_cache_test.cpp
 		resolve_hits/resolve/hit_resolver_test.cpp
 )
 
@@ -1594,6 +1635,7 @@ set(
 set(
 	TESTSOURCES_RESOLVE_HITS
 		${TESTSOURCES_RESOLVE_HITS_ALGO}
+		${TESTSOURCES_RESOLVE_HITS_BENCHMARK}
 		resolve_hits/calc_hit_list_test.cpp
 		resolve_hits/cath_hit_resolver_test.cpp
 		${TESTSOURCES_RESOLVE_HITS_FILE}
@@ -1601,6 +1643,7 @@ set(
 		resolve_hits/full_hit_list_test.cpp
 		resolve_hits/full_hit_test.cpp
 		resolve_hits/hit_extras_test.cpp
+		resolve_hits/hit_label_table_test.cpp
 		resolve_hits/hit_test.cpp
 		${TESTSOURCES_RESOLVE_HITS_HTML_OUTPUT}
 		${TESTSOURCES_RESOLVE_HITS_OPTIONS}
@@ -1663,6 +1706,7 @@ set(
 		src_common/common/algorithm/constexpr_is_uniq_test.cpp
 		src_common/common/algorithm/constexpr_modulo_fns_test.cpp
 		src_common/common/algorithm/for_n_test.cpp
+		src_common/common/algorithm/parallel_for_blocks_test.cpp
 		src_common/common/algorithm/transform_build_test.cpp
 		src_common/common/algorithm/variadic_and_test.cpp
 )
@@ -1716,6 +1760,7 @@ set(
 		src_common/common/container/id_of_string_ref_test.cpp
 		src_common/common/container/id_of_string_test.cpp
 		src_common/common/container/id_of_string_view_test.cpp
+		src_common/common/container/string_arena_test.cpp
 )
 
 set(
@@ -2080,6 +2125,7 @@ set(
 		uni/file/pdb/element_type_string_test.cpp
 		uni/file/pdb/pdb_atom_test.cpp
 		uni/file/pdb/pdb_list_test.cpp
+		uni/file/pdb/pdb_record_buffer_test.cpp
 		uni/file/pdb/pdb_residue_test.cpp
 		uni/file/pdb/pdb_test.cpp
 		uni/file/pdb/proximity_calculator_test.cpp
@@ -2294,6 +2340,7 @@ set(
 		${TESTSOURCES_UNI_SCORE_SCORE_CLASSIFICATION_LABEL_PAIR_IS_POSITIVE}
 		uni/score/score_classification/rbf_model_test.cpp
 		uni/score/score_classification/score_classn_value_better_value_test.cpp
+		uni/score/score_classification/score_classn_value_columns_test.cpp
 		uni/score/score_classification/score_classn_value_list_test.cpp
 		uni/score/score_classification/score_classn_value_results_set_test.cpp
 		uni/score/score_classification/score_classn_value_test.cpp
@@ -2337,6 +2384,7 @@ set(
 		uni/ssap/distance_score_formula_test.cpp
 		${TESTSOURCES_UNI_SSAP_OPTIONS}
 		uni/ssap/selected_pair_test.cpp
+		uni/ssap/ssap_phase_timings_test.cpp
 		uni/ssap/ssap_scores_test.cpp
 		uni/ssap/ssap_test.cpp
 		uni/ssap/windowed_matrix_test.cpp
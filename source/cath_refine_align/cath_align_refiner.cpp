@@ -108,7 +108,9 @@ void cath_align_refiner::refine(const cath_refine_align_options &prm_cath_refine
 //
 //	return;
 
-	const alignment refined_alignment        = alignment_refiner().iterate( the_alignment, proteins, gap_penalty( 50, 0 ) );
+	const alignment refined_alignment        = alignment_refiner(
+		prm_cath_refine_align_options.get_alignment_input_spec().get_refining_num_threads()
+	).iterate( the_alignment, proteins, gap_penalty( 50, 0 ) );
 	const alignment scored_refined_alignment = score_alignment_copy( residue_scorer(), refined_alignment, proteins );
 
 //	const protein &protein_a = proteins[0];
@@ -138,16 +138,20 @@ void cath::clust::perform_map_clusters(const clustmap_input_spec   &prm_input_sp
 		const auto        &job_old_clustmemb_file = job.get_old_cluster_membership_file();
 
 		id_of_str_bidirnl seq_ider;
+		reserve_for_membership_file( seq_ider, job_new_clustmemb_file );
 
 		auto &the_istream = istream_wrapper.set_path( job_new_clustmemb_file ).get_istream();
-		const new_cluster_data new_to_clusters = parse_new_membership( the_istream, seq_ider, ref( prm_stderr ) );
+		const new_cluster_data new_to_clusters = parse_new_membership( the_istream, seq_ider, ref( prm_stderr ), prm_mapping_spec.get_num_threads() );
 		istream_wrapper.close();
 
 		const old_cluster_data_opt old_from_clusters = make_optional_if_fn(
 			static_cast<bool>( job_old_clustmemb_file ),
-			[&] { return parse_old_membership( *job_old_clustmemb_file, seq_ider, ref( prm_stderr )  ); }
+			[&] { return parse_old_membership( *job_old_clustmemb_file, seq_ider, ref( prm_stderr ), prm_mapping_spec.get_num_threads() ); }
 		);
 
+		// All the sequence names have now been parsed so compact them and prevent any more being added
+		seq_ider.freeze();
+
 		const auto results = map_clusters(
 			old_from_clusters,
 			new_to_clusters,
@@ -634,5 +634,16 @@ BOOST_AUTO_TEST_CASE(provides_entry_level_output) {
 	BOOST_CHECK_STRING_MATCHES_FILE( output_ss.str(), eg_entry_mapping_result_file() );
 }
 
+BOOST_AUTO_TEST_CASE(provides_identical_entry_level_output_with_multiple_threads) {
+	// When calling perform_map_clusters with options: an input file, a map-from file, the --print-entry-results flag and multiple threads
+	execute_perform_map_clusters( { eg_input_file().string(),
+		"--" + clustmap_input_options_block::PO_MAP_FROM_CLUSTMEMB_FILE, eg_input_mapfrom_file().string(),
+		"--" + clustmap_output_options_block::PO_PRINT_DOMAIN_MAPPING,
+		"--" + clust_mapping_options_block::PO_NUM_THREADS,              "3" } );
+
+	// Then expect the same results in the output stream as with one thread
+	BOOST_CHECK_STRING_MATCHES_FILE( output_ss.str(), eg_entry_mapping_result_file() );
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -57,7 +57,7 @@ string cath::clust::to_string(const cluster_domains   &prm_cluster_domains, ///<
 		prm_cluster_domains.sorted_seq_ids()
 			| transformed( [&] (const cluster_id_t &seq_id) {
 				return
-					  prm_ider.get_name_of_id( seq_id )
+					  prm_ider.get_name_of_id( seq_id ).to_string()
 					+ "("
 					+ to_string( prm_cluster_domains.domain_cluster_ids_of_seq_id( seq_id ), false )
 					+ ")";
@@ -49,13 +49,13 @@ namespace cath {
 			clusters_info() = default;
 
 			cluster_id_t add_name(const boost::string_ref &);
-			const std::string & get_name_of_id(const size_t &);
+			boost::string_ref get_name_of_id(const size_t &);
 			clusters_info & update_info_for_cluster_of_id(const cluster_id_t &,
 			                                              const boost::string_ref &,
 			                                              const seq::seq_seg_run_opt &);
 			size_t get_num_clusters() const;
 			const cluster_info & get_info_of_cluster_of_id(const cluster_id_t &) const;
-			const std::string & get_name_of_cluster_of_id(const cluster_id_t &) const;
+			boost::string_ref get_name_of_cluster_of_id(const cluster_id_t &) const;
 
 			const common::id_of_str_bidirnl & get_ider() const;
 		};
@@ -76,8 +76,8 @@ namespace cath {
 		}
 
 		/// \brief Get the name of the cluster with the specified ID
-		inline const std::string & clusters_info::get_name_of_id(const size_t &prm_cluster_id ///< The ID of the cluster to get the name
-		                                                         ) {
+		inline boost::string_ref clusters_info::get_name_of_id(const size_t &prm_cluster_id ///< The ID of the cluster to get the name
+		                                                       ) {
 			return ider.get_name_of_id( prm_cluster_id );
 		}
 
@@ -102,8 +102,8 @@ namespace cath {
 		}
 
 		/// \brief Get the name of the cluster with the specified ID
-		inline const std::string & clusters_info::get_name_of_cluster_of_id(const cluster_id_t &prm_cluster_id ///< The ID of the cluster whose name should be retrieved
-		                                                                    ) const {
+		inline boost::string_ref clusters_info::get_name_of_cluster_of_id(const cluster_id_t &prm_cluster_id ///< The ID of the cluster whose name should be retrieved
+		                                                                  ) const {
 			return ider.get_name_of_id( prm_cluster_id );
 		}
 
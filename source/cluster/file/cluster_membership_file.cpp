@@ -20,40 +20,74 @@
 
 #include "cluster_membership_file.hpp"
 
+#include <boost/filesystem.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/utility/string_ref.hpp>
 
 #include "cluster/cluster_type_aliases.hpp"
 #include "cluster/old_cluster_data.hpp"
 #include "common/boost_addenda/log/log_to_ostream_guard.hpp"
+#include "common/boost_addenda/range/indices.hpp"
+#include "common/container/id_of_str_bidirnl.hpp"
 #include "common/debug_numeric_cast.hpp"
 #include "common/exception/runtime_error_exception.hpp"
 #include "common/file/open_fstream.hpp"
 #include "common/optional/make_optional_if.hpp"
+#include "common/size_t_literal.hpp"
 #include "common/string/string_parse_tools.hpp"
 #include "seq/seq_seg_run_parser.hpp"
+#include "seq/seq_type_aliases.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace cath;
 using namespace cath::clust;
 using namespace cath::common;
+using namespace cath::common::literals;
 using namespace cath::seq;
 
 using boost::filesystem::path;
 using boost::string_ref;
+using std::async;
+using std::future;
 using std::ifstream;
 using std::istream;
 using std::istringstream;
+using std::launch;
+using std::min;
 using std::ostream;
+using std::streamsize;
 using std::string;
+using std::vector;
 
 static constexpr size_t CLUSTER_ID_OFFSET = 0;
 static constexpr size_t DOMAIN_ID_OFFSET  = 1;
 
+/// \brief The number of bytes of input to give to each thread in each batch when parsing in parallel
+///
+/// This bounds the amount of input (and staged, parsed lines) held in memory at any one time
+static constexpr size_t PARALLEL_PARSE_CHUNK_SIZE = 4 * 1024 * 1024;
+
+/// \brief A typical number of bytes per line of a cluster membership file
+///        (used to estimate the number of entries from the file's size)
+static constexpr size_t TYPICAL_MEMBERSHIP_LINE_LENGTH = 32;
+
+/// \brief A typical number of characters in a sequence name in a cluster membership file
+static constexpr size_t TYPICAL_SEQ_NAME_LENGTH = 12;
+
+/// \brief The maximum number of names for which reserve_for_membership_file() reserves space up front
+///
+/// The id_of_str_bidirnl value-initialises its hash table when reserving, so this stops a large
+/// file committing lots of memory before parsing starts (with 8-byte slots kept under 0.7 full,
+/// this reserves at most 16MB of slots). Beyond this, the id_of_str_bidirnl grows as usual.
+static constexpr size_t MAX_RESERVED_NUM_NAMES = 1024 * 1024;
+
 /// \brief Print any warnings to the specified (optional) ostream arising from the interaction (if any) of the new entry
 static inline void warn_if_neccessary(const clust_entry_problem &prm_problem,                 ///< The type of problem encountered when reading the new entry
                                       const ostream_ref_opt     &prm_ostream_ref_opt,         ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
@@ -95,63 +129,139 @@ static inline void warn_if_neccessary(const clust_entry_problem &prm_problem,
 	}
 }
 
-/// \brief Parse the data for old "from" clusters from a cluster membership istream
-old_cluster_data cath::clust::parse_old_membership(istream               &prm_istream,           ///< The istream to parse from
-                                                   id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
-                                                   const ostream_ref_opt &prm_ostream_ref_opt    ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
-                                                   ) {
-	using std::to_string;
-	bool warned_duplicate = false;
-	old_cluster_data result{ prm_id_of_str_bidirnl };
-	seq_seg_run_parser segs_parser;
-	string line;
-	size_t line_ctr = 0;
-	while ( getline( prm_istream, line ) ) {
-		++line_ctr;
-		const auto cluster_id_itrs = find_field_itrs( line, CLUSTER_ID_OFFSET                                               );
-		const auto domain_id_itrs  = find_field_itrs( line, DOMAIN_ID_OFFSET, 1 + CLUSTER_ID_OFFSET, cluster_id_itrs.second );
+namespace {
+
+	/// \brief A problem with the number of fields on a line of cluster membership
+	enum class membership_fields_problem : char {
+		NONE,     ///< The line has the correct number of fields
+		TOO_FEW,  ///< The line has fewer than two fields
+		TOO_MANY  ///< The line has more than two fields
+	};
+
+	/// \brief The data parsed from a single line of cluster membership, staged before being added to old/new cluster data
+	///
+	/// The string_refs all point into the text from which the line was parsed, which must outlive this
+	struct parsed_membership_line final {
+		/// \brief The full text of the line
+		string_ref                line;
+
+		/// \brief The name of the cluster
+		string_ref                cluster_name;
+
+		/// \brief The name of the sequence within which the entry appears
+		string_ref                sequence_name;
+
+		/// \brief The name of the entry
+		string_ref                entry_name;
+
+		/// \brief The (optional) segments of the entry within the sequence
+		seq_seg_run_opt           segments;
+
+		/// \brief A description of the error encountered when parsing the segments (if any)
+		str_opt                   segments_error;
+
+		/// \brief Any problem with the number of fields on the line
+		membership_fields_problem fields_problem = membership_fields_problem::NONE;
+	};
+
+	/// \brief Type alias for a vector of parsed_membership_line values
+	using parsed_membership_line_vec = vector<parsed_membership_line>;
+
+	/// \brief Parse a single line of cluster membership
+	///
+	/// This doesn't throw on a line with the wrong number of fields but records the problem in the result
+	/// so that it can be reported (with the line number) when the line is added to the cluster data.
+	parsed_membership_line parse_membership_line(const string       &prm_line,       ///< The line to parse
+	                                             const string_ref   &prm_line_ref,   ///< A string_ref to persistent storage of the same text as prm_line, into which the result's string_refs should point
+	                                             seq_seg_run_parser &prm_segs_parser ///< The seq_seg_run_parser with which to parse any segments
+	                                             ) {
+		parsed_membership_line result;
+		result.line = prm_line_ref;
+
+		const auto cluster_id_itrs = find_field_itrs( prm_line, CLUSTER_ID_OFFSET                                               );
+		const auto domain_id_itrs  = find_field_itrs( prm_line, DOMAIN_ID_OFFSET, 1 + CLUSTER_ID_OFFSET, cluster_id_itrs.second );
 
 		// Check that the line doesn't have too few or too many fields
 		if ( domain_id_itrs.first == domain_id_itrs.second ) {
-			BOOST_THROW_EXCEPTION(runtime_error_exception(
-				  "Cannot parse cluster membership from fewer than two fields at line number "
-				+ to_string( line_ctr )
-				+ ". Line is: \""
-				+ line
-				+ "\""
-			));
+			result.fields_problem = membership_fields_problem::TOO_FEW;
+			return result;
 		}
-		if ( find_itr_before_first_non_space( domain_id_itrs.second, common::cend( line ) ) != common::cend( line ) ) {
-			BOOST_THROW_EXCEPTION(runtime_error_exception(
-				  "Cannot parse cluster membership from more than two fields at line number "
-				+ to_string( line_ctr )
-				+ ". Line is: \""
-				+ line
-				+ "\""
-			));
+		if ( find_itr_before_first_non_space( domain_id_itrs.second, common::cend( prm_line ) ) != common::cend( prm_line ) ) {
+			result.fields_problem = membership_fields_problem::TOO_MANY;
+			return result;
 		}
 
-		/// \TODO Check there are no more fields (but allow whitespace)
 		const auto         slash_index          = make_string_ref( domain_id_itrs ).find_last_of( '/' );
 		const bool         has_segs             = ( slash_index != string_ref::npos );
 		const auto         pre_split_point_itr  = has_segs ? next( domain_id_itrs.first, debug_numeric_cast<ptrdiff_t>( slash_index     ) )
 		                                                   : domain_id_itrs.second;
-		const auto cluster_name  = make_string_ref( cluster_id_itrs.first, cluster_id_itrs.second );
-		const auto sequence_name = make_string_ref( domain_id_itrs.first,  pre_split_point_itr    );
-		const auto entry_name    = make_string_ref( domain_id_itrs.first,  domain_id_itrs.second  );
+
+		// Make a string_ref into prm_line_ref that corresponds to the specified iterators into prm_line
+		const auto line_ref_of_itrs = [&] (const str_citr &prm_begin, const str_citr &prm_end) {
+			return prm_line_ref.substr(
+				debug_numeric_cast<size_t>( distance( common::cbegin( prm_line ), prm_begin ) ),
+				debug_numeric_cast<size_t>( distance( prm_begin,                  prm_end   ) )
+			);
+		};
+		result.cluster_name  = line_ref_of_itrs( cluster_id_itrs.first, cluster_id_itrs.second );
+		result.sequence_name = line_ref_of_itrs( domain_id_itrs.first,  pre_split_point_itr    );
+		result.entry_name    = line_ref_of_itrs( domain_id_itrs.first,  domain_id_itrs.second  );
+
+		if ( has_segs ) {
+			try {
+				result.segments = prm_segs_parser.parse( next( pre_split_point_itr ), domain_id_itrs.second );
+			}
+			catch (const std::exception &x) {
+				result.segments_error = string{ x.what() };
+			}
+		}
+		return result;
+	}
+
+	/// \brief Add a parsed line of cluster membership to the specified old/new cluster data, warning of any problems
+	///
+	/// \throws runtime_error_exception If the line has too few or too many fields
+	template <typename DATA>
+	void add_parsed_membership_line(DATA                   &prm_data,             ///< The old/new cluster data to which the line should be added
+	                                parsed_membership_line &prm_parsed_line,      ///< The parsed line to add (its segments may be moved from)
+	                                const size_t           &prm_line_number,      ///< The (1-based) number of the line in the input (for error messages)
+	                                const ostream_ref_opt  &prm_ostream_ref_opt,  ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+	                                bool                   &prm_warned_duplicate  ///< Whether a warning about duplicates has already been given
+	                                ) {
+		using std::to_string;
+		if ( prm_parsed_line.fields_problem != membership_fields_problem::NONE ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception(
+				  "Cannot parse cluster membership from "
+				+ string{ ( prm_parsed_line.fields_problem == membership_fields_problem::TOO_FEW ) ? "fewer" : "more" }
+				+ " than two fields at line number "
+				+ to_string( prm_line_number )
+				+ ". Line is: \""
+				+ prm_parsed_line.line.to_string()
+				+ "\""
+			));
+		}
+
+		const string_ref &cluster_name = prm_parsed_line.cluster_name;
+		const string_ref &entry_name   = prm_parsed_line.entry_name;
+		if ( prm_parsed_line.segments_error ) {
+			warn_if_neccessary(
+				clust_entry_problem::PARSE_ERROR,
+				prm_ostream_ref_opt,
+				cluster_name,
+				entry_name,
+				prm_warned_duplicate,
+				prm_parsed_line.segments_error
+			);
+			return;
+		}
 		try {
-			const auto &interaction  = result.add_entry(
+			const auto problem = prm_data.add_entry(
 				cluster_name,
-				sequence_name,
+				prm_parsed_line.sequence_name,
 				entry_name,
-				make_optional_if_fn(
-					has_segs,
-					[&] {
-						return segs_parser.parse( next( pre_split_point_itr ), domain_id_itrs.second );
-					}
-				)
+				std::move( prm_parsed_line.segments )
 			);
-			warn_if_neccessary( interaction, prm_ostream_ref_opt, cluster_name, entry_name, warned_duplicate );
+			warn_if_neccessary( problem, prm_ostream_ref_opt, cluster_name, entry_name, prm_warned_duplicate );
 		}
 		catch (const std::exception &x) {
 			warn_if_neccessary(
@@ -159,120 +269,225 @@ old_cluster_data cath::clust::parse_old_membership(istream               &prm_is
 				prm_ostream_ref_opt,
 				cluster_name,
 				entry_name,
-				warned_duplicate,
+				prm_warned_duplicate,
 				string{ x.what() }
 			);
 		}
 	}
-	return result;
+
+	/// \brief Parse the data for old/new clusters from a cluster membership istream, one line at a time
+	template <typename DATA>
+	DATA parse_membership_serially(istream               &prm_istream,           ///< The istream to parse from
+	                               id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
+	                               const ostream_ref_opt &prm_ostream_ref_opt    ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+	                               ) {
+		bool warned_duplicate = false;
+		DATA result{ prm_id_of_str_bidirnl };
+		seq_seg_run_parser segs_parser;
+		string line;
+		size_t line_ctr = 0;
+		while ( getline( prm_istream, line ) ) {
+			++line_ctr;
+			auto parsed_line = parse_membership_line( line, string_ref{ line }, segs_parser );
+			add_parsed_membership_line( result, parsed_line, line_ctr, prm_ostream_ref_opt, warned_duplicate );
+		}
+		return result;
+	}
+
+	/// \brief Find the index of the first newline in the specified text at or after the specified index
+	///        (or string_ref::npos if there is none)
+	size_t find_newline(const string_ref &prm_text,      ///< The text to search
+	                    const size_t     &prm_from_index ///< The index from which to search
+	                    ) {
+		const size_t index_in_rest = prm_text.substr( prm_from_index ).find( '\n' );
+		return ( index_in_rest == string_ref::npos ) ? string_ref::npos : prm_from_index + index_in_rest;
+	}
+
+	/// \brief Parse all the lines in the specified chunk of cluster membership text
+	///
+	/// This stops after any line with the wrong number of fields because adding that line will throw
+	parsed_membership_line_vec parse_membership_chunk(const string_ref &prm_chunk ///< The chunk of text to parse, which must start at the start of a line
+	                                                  ) {
+		parsed_membership_line_vec results;
+		seq_seg_run_parser segs_parser;
+		string line;
+		size_t line_begin = 0;
+		while ( line_begin < prm_chunk.size() ) {
+			const size_t     newline_index = find_newline( prm_chunk, line_begin );
+			const size_t     line_end      = ( newline_index == string_ref::npos ) ? prm_chunk.size() : newline_index;
+			const string_ref line_ref      = prm_chunk.substr( line_begin, line_end - line_begin );
+			line.assign( common::cbegin( line_ref ), common::cend( line_ref ) );
+			results.push_back( parse_membership_line( line, line_ref, segs_parser ) );
+			if ( results.back().fields_problem != membership_fields_problem::NONE ) {
+				break;
+			}
+			line_begin = line_end + 1;
+		}
+		return results;
+	}
+
+	/// \brief Split the specified text into (at most) the specified number of chunks, each of which ends at the end of a line
+	vector<string_ref> newline_aligned_chunks(const string_ref &prm_text,      ///< The text to split
+	                                          const size_t     &prm_num_chunks ///< The number of chunks into which the text should be split
+	                                          ) {
+		vector<string_ref> results;
+		size_t chunk_begin = 0;
+		for (const size_t &chunk_ctr : indices( prm_num_chunks ) ) {
+			if ( chunk_begin >= prm_text.size() ) {
+				break;
+			}
+			const size_t target_end    = ( ( chunk_ctr + 1 ) * prm_text.size() ) / prm_num_chunks;
+			const size_t newline_index = ( target_end > chunk_begin ) ? find_newline( prm_text, target_end - 1 )
+			                                                          : find_newline( prm_text, chunk_begin    );
+			const size_t chunk_end     = ( newline_index == string_ref::npos ) ? prm_text.size() : newline_index + 1;
+			results.push_back( prm_text.substr( chunk_begin, chunk_end - chunk_begin ) );
+			chunk_begin = chunk_end;
+		}
+		return results;
+	}
+
+	/// \brief Parse the data for old/new clusters from a cluster membership istream, parsing
+	///        newline-aligned chunks of the input in parallel
+	///
+	/// The input is read in batches of up to prm_num_threads * PARALLEL_PARSE_CHUNK_SIZE bytes.
+	/// Each batch is split into newline-aligned chunks, which are parsed in parallel into staged
+	/// parsed_membership_lines. The staged lines are then added to the cluster data in input order
+	/// so that the IDs assigned, the warnings and any errors exactly match those of the serial parse.
+	template <typename DATA>
+	DATA parse_membership_in_parallel(istream               &prm_istream,           ///< The istream to parse from
+	                                  id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
+	                                  const size_t          &prm_num_threads,       ///< The number of threads to use to parse the input
+	                                  const ostream_ref_opt &prm_ostream_ref_opt    ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+	                                  ) {
+		bool warned_duplicate = false;
+		DATA result{ prm_id_of_str_bidirnl };
+		size_t line_ctr = 0;
+
+		const size_t batch_size = prm_num_threads * PARALLEL_PARSE_CHUNK_SIZE;
+		string buffer;
+		bool reached_end = false;
+		while ( ! reached_end ) {
+			// Append the next batch of input to any incomplete line left over from the previous batch
+			const size_t prev_size = buffer.size();
+			buffer.resize( prev_size + batch_size );
+			prm_istream.read( &buffer[ prev_size ], static_cast<streamsize>( batch_size ) );
+			buffer.resize( prev_size + static_cast<size_t>( prm_istream.gcount() ) );
+			reached_end = ! prm_istream;
+
+			// Unless this is the end of the input, only parse up to the end of the last complete line
+			const size_t last_newline_index = buffer.rfind( '\n' );
+			const size_t parse_size         = reached_end                                ? buffer.size()
+			                                : ( last_newline_index == string::npos )     ? 0_z
+			                                                                             : last_newline_index + 1;
+
+			vector<future<parsed_membership_line_vec>> chunk_futures;
+			for (const string_ref &chunk : newline_aligned_chunks( string_ref{ buffer.data(), parse_size }, prm_num_threads ) ) {
+				chunk_futures.push_back( async(
+					launch::async,
+					[chunk] { return parse_membership_chunk( chunk ); }
+				) );
+			}
+			for (future<parsed_membership_line_vec> &chunk_future : chunk_futures) {
+				for (parsed_membership_line &parsed_line : chunk_future.get() ) {
+					++line_ctr;
+					add_parsed_membership_line( result, parsed_line, line_ctr, prm_ostream_ref_opt, warned_duplicate );
+				}
+			}
+
+			buffer.erase( 0, parse_size );
+		}
+		return result;
+	}
+
+	/// \brief Parse the data for old/new clusters from a cluster membership istream using the specified number of threads
+	template <typename DATA>
+	DATA parse_membership(istream               &prm_istream,           ///< The istream to parse from
+	                      id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
+	                      const ostream_ref_opt &prm_ostream_ref_opt,   ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+	                      const size_t          &prm_num_threads        ///< The number of threads to use to parse the input
+	                      ) {
+		return ( prm_num_threads > 1 )
+			? parse_membership_in_parallel<DATA>( prm_istream, prm_id_of_str_bidirnl, prm_num_threads, prm_ostream_ref_opt )
+			: parse_membership_serially   <DATA>( prm_istream, prm_id_of_str_bidirnl,                  prm_ostream_ref_opt );
+	}
+
+} // namespace
+
+/// \brief Parse the data for old "from" clusters from a cluster membership istream
+old_cluster_data cath::clust::parse_old_membership(istream               &prm_istream,           ///< The istream to parse from
+                                                   id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
+                                                   const ostream_ref_opt &prm_ostream_ref_opt,   ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const size_t          &prm_num_threads        ///< The number of threads to use to parse the input (the results are identical whatever the number of threads)
+                                                   ) {
+	return parse_membership<old_cluster_data>( prm_istream, prm_id_of_str_bidirnl, prm_ostream_ref_opt, prm_num_threads );
 }
 
 /// \brief Parse the data for old "from" clusters from a cluster membership istream
 old_cluster_data cath::clust::parse_old_membership(const string          &prm_input,             ///< The string to parse from
                                                    id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
-                                                   const ostream_ref_opt &prm_ostream_ref_opt    ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const ostream_ref_opt &prm_ostream_ref_opt,   ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const size_t          &prm_num_threads        ///< The number of threads to use to parse the input (the results are identical whatever the number of threads)
                                                    ) {
 	istringstream in_ss{ prm_input };
-	return parse_old_membership( in_ss, prm_id_of_str_bidirnl, prm_ostream_ref_opt );
+	return parse_old_membership( in_ss, prm_id_of_str_bidirnl, prm_ostream_ref_opt, prm_num_threads );
 }
 
 /// \brief Parse the data for old "from" clusters from a cluster membership istream
 old_cluster_data cath::clust::parse_old_membership(const path            &prm_input,             ///< The file to parse from
                                                    id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
-                                                   const ostream_ref_opt &prm_ostream_ref_opt    ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const ostream_ref_opt &prm_ostream_ref_opt,   ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const size_t          &prm_num_threads        ///< The number of threads to use to parse the input (the results are identical whatever the number of threads)
                                                    ) {
 	ifstream in_stream;
 	open_ifstream( in_stream, prm_input );
-	return parse_old_membership( in_stream, prm_id_of_str_bidirnl, prm_ostream_ref_opt );
+	return parse_old_membership( in_stream, prm_id_of_str_bidirnl, prm_ostream_ref_opt, prm_num_threads );
 }
 
 /// \brief Parse the data for new "to" clusters from a cluster membership istream
 new_cluster_data cath::clust::parse_new_membership(istream               &prm_istream,           ///< The istream to parse from
                                                    id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
-                                                   const ostream_ref_opt &prm_ostream_ref_opt    ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const ostream_ref_opt &prm_ostream_ref_opt,   ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const size_t          &prm_num_threads        ///< The number of threads to use to parse the input (the results are identical whatever the number of threads)
                                                    ) {
-	using std::to_string;
-	bool warned_duplicate = false;
-	new_cluster_data result{ prm_id_of_str_bidirnl };
-	seq_seg_run_parser segs_parser;
-	string line;
-	size_t line_ctr = 0;
-	while ( getline( prm_istream, line ) ) {
-		++line_ctr;
-		const auto cluster_id_itrs = find_field_itrs( line, CLUSTER_ID_OFFSET                                               );
-		const auto domain_id_itrs  = find_field_itrs( line, DOMAIN_ID_OFFSET, 1 + CLUSTER_ID_OFFSET, cluster_id_itrs.second );
-
-		// Check that the line doesn't have too few or too many fields
-		if ( domain_id_itrs.first == domain_id_itrs.second ) {
-			BOOST_THROW_EXCEPTION(runtime_error_exception(
-				  "Cannot parse cluster membership from fewer than two fields at line number "
-				+ to_string( line_ctr )
-				+ ". Line is: \""
-				+ line
-				+ "\""
-			));
-		}
-		if ( find_itr_before_first_non_space( domain_id_itrs.second, common::cend( line ) ) != common::cend( line ) ) {
-			BOOST_THROW_EXCEPTION(runtime_error_exception(
-				  "Cannot parse cluster membership from more than two fields at line number "
-				+ to_string( line_ctr )
-				+ ". Line is: \""
-				+ line
-				+ "\""
-			));
-		}
-
-		const auto         slash_index          = make_string_ref( domain_id_itrs ).find_last_of( '/' );
-		const bool         has_segs             = ( slash_index != string_ref::npos );
-		const auto         pre_split_point_itr  = has_segs ? next( domain_id_itrs.first, debug_numeric_cast<ptrdiff_t>( slash_index     ) )
-		                                                   : domain_id_itrs.second;
-		const auto cluster_name  = make_string_ref( cluster_id_itrs.first, cluster_id_itrs.second );
-		const auto sequence_name = make_string_ref( domain_id_itrs.first,  pre_split_point_itr    );
-		const auto entry_name    = make_string_ref( domain_id_itrs.first,  domain_id_itrs.second  );
-		try {
-			const auto problem   = result.add_entry(
-				cluster_name,
-				sequence_name,
-				entry_name,
-				make_optional_if_fn(
-					has_segs,
-					[&] {
-						return segs_parser.parse( next( pre_split_point_itr ), domain_id_itrs.second );
-					}
-				)
-			);
-			warn_if_neccessary( problem, prm_ostream_ref_opt, cluster_name, entry_name, warned_duplicate );
-		}
-		catch (const std::exception &x) {
-			warn_if_neccessary(
-				clust_entry_problem::PARSE_ERROR,
-				prm_ostream_ref_opt,
-				cluster_name,
-				entry_name,
-				warned_duplicate,
-				string{ x.what() }
-			);
-		}
-	}
-
-	return result;
+	return parse_membership<new_cluster_data>( prm_istream, prm_id_of_str_bidirnl, prm_ostream_ref_opt, prm_num_threads );
 }
 
 /// \brief Parse the data for new "to" clusters from a cluster membership istream
 new_cluster_data cath::clust::parse_new_membership(const string          &prm_input,             ///< The string to parse from
                                                    id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
-                                                   const ostream_ref_opt &prm_ostream_ref_opt    ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const ostream_ref_opt &prm_ostream_ref_opt,   ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const size_t          &prm_num_threads        ///< The number of threads to use to parse the input (the results are identical whatever the number of threads)
                                                    ) {
 	istringstream in_ss{ prm_input };
-	return parse_new_membership( in_ss, prm_id_of_str_bidirnl, prm_ostream_ref_opt );
+	return parse_new_membership( in_ss, prm_id_of_str_bidirnl, prm_ostream_ref_opt, prm_num_threads );
 }
 
 /// \brief Parse the data for new "to" clusters from a cluster membership istream
 new_cluster_data cath::clust::parse_new_membership(const path            &prm_input,             ///< The file to parse from
                                                    id_of_str_bidirnl     &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl to use to map from sequences names to IDs
-                                                   const ostream_ref_opt &prm_ostream_ref_opt    ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const ostream_ref_opt &prm_ostream_ref_opt,   ///< An optional ostream ref to which warnings about parsing (eg duplicates/clashes) can be written
+                                                   const size_t          &prm_num_threads        ///< The number of threads to use to parse the input (the results are identical whatever the number of threads)
                                                    ) {
 	ifstream in_stream;
 	open_ifstream( in_stream, prm_input );
-	return parse_new_membership( in_stream, prm_id_of_str_bidirnl, prm_ostream_ref_opt );
+	return parse_new_membership( in_stream, prm_id_of_str_bidirnl, prm_ostream_ref_opt, prm_num_threads );
+}
+
+/// \brief Reserve space in the specified id_of_str_bidirnl for the sequence names of the specified
+///        cluster membership file, estimated from the file's size
+///
+/// This avoids the id_of_str_bidirnl having to repeatedly grow its storage whilst parsing a file.
+/// The estimate assumes every line holds a new name, so it's capped at MAX_RESERVED_NUM_NAMES.
+/// It does nothing if the path isn't a regular file (eg if it's "-" for standard input).
+void cath::clust::reserve_for_membership_file(id_of_str_bidirnl &prm_id_of_str_bidirnl, ///< The id_of_str_bidirnl in which to reserve space
+                                              const path        &prm_file               ///< The cluster membership file that will be parsed into the id_of_str_bidirnl
+                                              ) {
+	if ( ! is_regular_file( prm_file ) ) {
+		return;
+	}
+	const size_t num_names_estimate = min(
+		static_cast<size_t>( file_size( prm_file ) ) / TYPICAL_MEMBERSHIP_LINE_LENGTH,
+		MAX_RESERVED_NUM_NAMES
+	);
+	prm_id_of_str_bidirnl.reserve( num_names_estimate, num_names_estimate * TYPICAL_SEQ_NAME_LENGTH );
 }
@@ -26,6 +26,7 @@
 #include "cluster/new_cluster_data.hpp" // Required for the deleted function definitions
 #include "cluster/old_cluster_data.hpp" // Required for the deleted function definitions
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 
@@ -36,64 +37,79 @@ namespace cath {
 
 		old_cluster_data parse_old_membership(std::istream &,
 		                                      common::id_of_str_bidirnl &,
-		                                      const ostream_ref_opt & = boost::none);
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1);
 
 		/// \brief Prevent calling with an rvalue id_of_str_bidirnl
 		old_cluster_data parse_old_membership(std::istream &,
 		                                      const common::id_of_str_bidirnl &&,
-		                                      const ostream_ref_opt & = boost::none) = delete;
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1) = delete;
 
 
 		old_cluster_data parse_old_membership(const std::string &,
 		                                      common::id_of_str_bidirnl &,
-		                                      const ostream_ref_opt & = boost::none);
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1);
 
 		/// \brief Prevent calling with an rvalue id_of_str_bidirnl
 		old_cluster_data parse_old_membership(const std::string &,
 		                                      const common::id_of_str_bidirnl &&,
-		                                      const ostream_ref_opt & = boost::none) = delete;
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1) = delete;
 
 
 		old_cluster_data parse_old_membership(const boost::filesystem::path &,
 		                                      common::id_of_str_bidirnl &,
-		                                      const ostream_ref_opt & = boost::none);
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1);
 
 		/// \brief Prevent calling with an rvalue id_of_str_bidirnl
 		old_cluster_data parse_old_membership(const boost::filesystem::path &,
 		                                      const common::id_of_str_bidirnl &&,
-		                                      const ostream_ref_opt & = boost::none) = delete;
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1) = delete;
 
 
 
 
 		new_cluster_data parse_new_membership(std::istream &,
 		                                      common::id_of_str_bidirnl &,
-		                                      const ostream_ref_opt & = boost::none);
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1);
 
 		/// \brief Prevent calling with an rvalue id_of_str_bidirnl
 		new_cluster_data parse_new_membership(std::istream &,
 		                                      const common::id_of_str_bidirnl &&,
-		                                      const ostream_ref_opt & = boost::none) = delete;
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1) = delete;
 
 
 		new_cluster_data parse_new_membership(const std::string &,
 		                                      common::id_of_str_bidirnl &,
-		                                      const ostream_ref_opt & = boost::none);
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1);
 
 		/// \brief Prevent calling with an rvalue id_of_str_bidirnl
 		new_cluster_data parse_new_membership(const std::string &,
 		                                      const common::id_of_str_bidirnl &&,
-		                                      const ostream_ref_opt & = boost::none) = delete;
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1) = delete;
 
 
 		new_cluster_data parse_new_membership(const boost::filesystem::path &,
 		                                      common::id_of_str_bidirnl &,
-		                                      const ostream_ref_opt & = boost::none);
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1);
 
 		/// \brief Prevent calling with an rvalue id_of_str_bidirnl
 		new_cluster_data parse_new_membership(const boost::filesystem::path &,
 		                                      const common::id_of_str_bidirnl &&,
-		                                      const ostream_ref_opt & = boost::none) = delete;
+		                                      const ostream_ref_opt & = boost::none,
+		                                      const size_t & = 1) = delete;
+
+		void reserve_for_membership_file(common::id_of_str_bidirnl &,
+		                                 const boost::filesystem::path &);
 
 	} // namespace clust
 } // namespace cath
@@ -24,18 +24,24 @@
 #include "cluster/file/cluster_membership_file.hpp"
 #include "cluster/map/map_clusters.hpp"
 #include "cluster/options/spec/clust_mapping_spec.hpp"
+#include "common/boost_addenda/range/indices.hpp"
 #include "common/exception/runtime_error_exception.hpp"
+#include "common/size_t_literal.hpp"
 #include "test/boost_addenda/boost_check_no_throw_diag.hpp"
 
 #include <regex>
+#include <sstream>
 
 namespace cath { namespace test { } }
 
+using namespace cath;
 using namespace cath::clust;
 using namespace cath::common;
+using namespace cath::common::literals;
 using namespace cath::test;
 
 using boost::none;
+using std::ostringstream;
 using std::regex;
 using std::regex_search;
 using std::string;
@@ -88,6 +94,21 @@ namespace cath {
 			/// \brief Example of input that's invalid due to having a spurious extra column
 			const string spurious_extra_column_input_str = "a 1\nb 2 x\nc 3 y\nd 4 z\n";
 
+			/// \brief Make an example membership string with enough lines to be split between several threads
+			///        and that includes repeats, clashes and unparseable segments (that each generate warnings)
+			static string make_many_lines_membership_str() {
+				string result;
+				for (const size_t &line_ctr : indices( 500_z ) ) {
+					result += "clust" + std::to_string( line_ctr % 7 ) + " seq" + std::to_string( line_ctr % 60 )
+						+ ( ( line_ctr % 13 == 0 ) ? string{ "/x-y" } : "/" + std::to_string( line_ctr ) + "-" + std::to_string( line_ctr + 40 ) )
+						+ "\n";
+				}
+				return result + "clust1 seq1/1-41";
+			}
+
+			/// \brief An example membership string with enough lines to be split between several threads
+			const string many_lines_membership_str = make_many_lines_membership_str();
+
 		};
 	}
 }
@@ -167,6 +188,51 @@ BOOST_AUTO_TEST_CASE(new_cluster_info_third) {
 // }
 
 
+BOOST_AUTO_TEST_SUITE(parallel_parse)
+
+BOOST_AUTO_TEST_CASE(old_parse_in_parallel_matches_serial_parse) {
+	for (const size_t &num_threads : { 2_z, 3_z, 8_z } ) {
+		id_of_str_bidirnl serial_ider;
+		id_of_str_bidirnl parallel_ider;
+		ostringstream     serial_warnings;
+		ostringstream     parallel_warnings;
+		const auto serial_data   = parse_old_membership( many_lines_membership_str, serial_ider,   ostream_ref{ serial_warnings   }              );
+		const auto parallel_data = parse_old_membership( many_lines_membership_str, parallel_ider, ostream_ref{ parallel_warnings }, num_threads );
+		BOOST_CHECK_EQUAL( to_string( parallel_data ), to_string( serial_data ) );
+		BOOST_CHECK_EQUAL( parallel_ider.size(),       serial_ider.size()       );
+		BOOST_CHECK_EQUAL( parallel_warnings.str(),    serial_warnings.str()    );
+		BOOST_CHECK      ( ! serial_warnings.str().empty() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(new_parse_in_parallel_matches_serial_parse) {
+	for (const size_t &num_threads : { 2_z, 3_z, 8_z } ) {
+		id_of_str_bidirnl serial_ider;
+		id_of_str_bidirnl parallel_ider;
+		ostringstream     serial_warnings;
+		ostringstream     parallel_warnings;
+		const auto serial_data   = parse_new_membership( many_lines_membership_str, serial_ider,   ostream_ref{ serial_warnings   }              );
+		const auto parallel_data = parse_new_membership( many_lines_membership_str, parallel_ider, ostream_ref{ parallel_warnings }, num_threads );
+		BOOST_CHECK_EQUAL( to_string( parallel_data ), to_string( serial_data ) );
+		BOOST_CHECK_EQUAL( parallel_ider.size(),       serial_ider.size()       );
+		BOOST_CHECK_EQUAL( parallel_warnings.str(),    serial_warnings.str()    );
+		BOOST_CHECK      ( ! serial_warnings.str().empty() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parse_in_parallel_reports_same_line_number_on_error) {
+	BOOST_REQUIRE_THROW( parse_new_membership( spurious_extra_column_input_str, seq_id_mapper, none, 3 ), runtime_error_exception );
+	try {
+		parse_new_membership( spurious_extra_column_input_str, seq_id_mapper, none, 3 );
+	}
+	catch (const runtime_error_exception &ex) {
+		BOOST_CHECK( regex_search( ex.what(), regex{ R"(Cannot parse cluster membership from more than two fields at line number 2. Line is: "b 2 x")" } ) );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
 BOOST_AUTO_TEST_SUITE(edge_case_input)
 
 
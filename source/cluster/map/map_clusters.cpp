@@ -24,6 +24,7 @@
 #include <boost/optional.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/algorithm/stable_partition.hpp>
+#include <boost/range/irange.hpp>
 
 #include "cluster/map/map_results.hpp"
 #include "cluster/new_cluster_data.hpp"
@@ -32,68 +33,85 @@
 #include "common/algorithm/copy_build.hpp"
 #include "common/algorithm/sort_uniq_build.hpp"
 #include "common/boost_addenda/range/indices.hpp"
+#include "common/cpp14/cbegin_cend.hpp"
+#include "common/size_t_literal.hpp"
 #include "common/type_aliases.hpp"
 
+#include <future>
+#include <sstream>
+#include <vector>
+
 using namespace cath;
 using namespace cath::clust::detail;
 using namespace cath::clust;
 using namespace cath::common;
+using namespace cath::common::literals;
 using namespace cath::seq;
 
 using boost::adaptors::filtered;
 using boost::algorithm::any_of;
+using boost::irange;
 using boost::none;
 using boost::range::stable_partition;
+using std::async;
+using std::future;
+using std::launch;
 using std::less;
 using std::max;
+using std::min;
+using std::ostringstream;
 using std::string;
+using std::vector;
 
-/// \brief Map old clusters to new clusters
-///
-/// \todo Consider trying to break this long function up further
-map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_clusters,     ///< The old clusters
-                                      const new_cluster_data     &prm_new_clusters,     ///< The new clusters
-                                      const clust_mapping_spec   &prm_mapping_spec,     ///< The specification for the mapping
-                                      const ostream_ref_opt      &prm_domain_out_stream ///< An optional stream to which individual domain mappings should be printed
-                                      ) {
-	const string dom_map_result_tag = "DOMAIN-MAP-RESULT";
+namespace {
 
-	// Grab the number of new clusters
-	const size_t num_new_clusters = get_num_clusters( prm_new_clusters );
+	/// \brief The tag that starts each line of the domain mapping output
+	const string DOM_MAP_RESULT_TAG{ "DOMAIN-MAP-RESULT" };
 
-	if ( prm_domain_out_stream ) {
-		prm_domain_out_stream->get() << "# Columns: tag(" << dom_map_result_tag << ") old_domain cluster_of_old_domain best_overlap_pc (best_new_domain) (cluster_of_best_new_domain) # [where last two columns absent if no new domains on the sequence]\n";
-	}
+	/// \brief The maximum number of old entries in each of the blocks that are mapped in parallel
+	///
+	/// This bounds the amount of domain-level output that's buffered in memory
+	constexpr size_t MAX_ENTRIES_PER_PARALLEL_BLOCK = 1000000;
 
-	// Prepare some data structures
-	doub_vec           highest_old_clust_overlap_fractions;
-	overlap_frac_distn highest_old_dom_overlap_fractions;
-	size_t             num_with_nothing_on_parent = 0;
-	potential_map_vec  chosen_maps;
-	potential_map_vec  potential_maps;
-	size_vec           num_mapped_by_new_cluster;
-	size_vec           num_mapped_by_old_cluster;
+	/// \brief The results of mapping a contiguous block of the old clusters
+	///
+	/// The results of the blocks are merged in block order so that the overall results
+	/// are identical to mapping all the old clusters in one block
+	struct old_clusters_block_mapping final {
+		/// \brief The potential maps from the block's old clusters, in order of old cluster and then new cluster
+		potential_map_vec  potential_maps;
 
-	// If there are old clusters perform a mapping
-	if ( prm_old_clusters ) {
+		/// \brief The distribution of the highest overlap fraction for each of the block's old domains
+		overlap_frac_distn highest_old_dom_overlap_fractions;
 
-		// Grab the number of old clusters and initialise num_mapped_by_new_cluster & num_mapped_by_old_cluster
-		const size_t num_old_clusters = prm_old_clusters->size();
-		num_mapped_by_new_cluster.resize( num_new_clusters, 0 );
-		num_mapped_by_old_cluster.resize( num_old_clusters, 0 );
+		/// \brief The number of the block's old domains on sequences on which the new clusters have no entries
+		size_t             num_with_nothing_on_parent = 0;
+	};
 
-		// For each old cluster
-		for (const size_t &old_cluster_idx : indices( num_old_clusters ) ) {
-			const cluster_domains &old_cluster = ( *prm_old_clusters ) [ old_cluster_idx ];
+	/// \brief Map the old clusters with indices in the specified [begin, end) block to the new clusters
+	///
+	/// This only reads from the old and new clusters so it's safe to call concurrently for different blocks
+	old_clusters_block_mapping map_old_clusters_block(const old_cluster_data   &prm_old_clusters,     ///< The old clusters
+	                                                  const new_cluster_data   &prm_new_clusters,     ///< The new clusters
+	                                                  const clust_mapping_spec &prm_mapping_spec,     ///< The specification for the mapping
+	                                                  const size_size_pair     &prm_block,            ///< The [begin, end) indices of the old clusters to map
+	                                                  const ostream_ref_opt    &prm_domain_out_stream ///< An optional stream to which individual domain mappings should be printed
+	                                                  ) {
+		// Grab the number of new clusters
+		const size_t num_new_clusters = get_num_clusters( prm_new_clusters );
+
+		old_clusters_block_mapping result;
+
+		// For each old cluster in the block
+		for (const size_t &old_cluster_idx : irange( prm_block.first, prm_block.second ) ) {
+			const cluster_domains &old_cluster = prm_old_clusters[ old_cluster_idx ];
 
 			// Initialise a store of the number of equivalents to this old cluster for each of the new clusters
 			size_vec new_clust_equivs( num_new_clusters, 0 );
 
 			// Prepare a function for recording a new domain mapping
 			const auto record_mapping_fn = [&] (const size_t &x) {
-				++( num_mapped_by_old_cluster[ old_cluster_idx ] );
-				++( num_mapped_by_new_cluster[ x               ] );
-				++( new_clust_equivs         [ x               ] );
+				++( new_clust_equivs[ x ] );
 			};
 
 			// Loop over the sequences in the old cluster
@@ -102,19 +120,19 @@ map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_cluste
 
 				// If the new clusters have no entries on the sequence then record overlaps of 0 for all the old domains
 				if ( ! has_domain_cluster_ids_of_seq_id( prm_new_clusters, seq_id ) ) {
-					num_with_nothing_on_parent += old_dom_cluster_ids.size();
-					highest_old_dom_overlap_fractions.add_overlap_fraction( 0.0, old_dom_cluster_ids.size() );
+					result.num_with_nothing_on_parent += old_dom_cluster_ids.size();
+					result.highest_old_dom_overlap_fractions.add_overlap_fraction( 0.0, old_dom_cluster_ids.size() );
 
 					// If prm_domain_out_stream, print out the name of any old seq ID for which *nothing* could be found
 					if ( prm_domain_out_stream ) {
 						for (const auto &old_dom_clust_id : old_dom_cluster_ids) {
 							prm_domain_out_stream->get()
-								<< dom_map_result_tag
+								<< DOM_MAP_RESULT_TAG
 								<< " "
-								<< prm_old_clusters->get_id_of_seq_name().get_name_of_id( seq_id )
+								<< prm_old_clusters.get_id_of_seq_name().get_name_of_id( seq_id )
 								<< get_segments_suffix_string( old_dom_clust_id.segments )
 								<< " "
-								<< get_name_of_cluster_of_id( *prm_old_clusters, old_dom_clust_id.cluster_id )
+								<< get_name_of_cluster_of_id( prm_old_clusters, old_dom_clust_id.cluster_id )
 								<< " 0\n";
 						}
 					}
@@ -136,7 +154,7 @@ map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_cluste
 							if ( old_dom_cluster_ids.size() != 1 || new_dom_clust_ids.size() != 1 || front( new_dom_clust_ids ).segments ) {
 								BOOST_THROW_EXCEPTION(invalid_argument_exception(
 									"Inconsistent whole-chain-domain on seq "
-									+ prm_old_clusters->get_id_of_seq_name().get_name_of_id( seq_id )
+									+ prm_old_clusters.get_id_of_seq_name().get_name_of_id( seq_id ).to_string()
 								));
 							}
 
@@ -145,13 +163,13 @@ map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_cluste
 							// If prm_domain_out_stream, print out the name of any old seq ID for which *nothing* could be found
 							if ( prm_domain_out_stream ) {
 								prm_domain_out_stream->get()
-									<< dom_map_result_tag
+									<< DOM_MAP_RESULT_TAG
 									<< " "
-									<< prm_old_clusters->get_id_of_seq_name().get_name_of_id( seq_id )
+									<< prm_old_clusters.get_id_of_seq_name().get_name_of_id( seq_id )
 									<< " "
-									<< get_name_of_cluster_of_id( *prm_old_clusters, old_dom_clust_id.cluster_id )
+									<< get_name_of_cluster_of_id( prm_old_clusters, old_dom_clust_id.cluster_id )
 									<< " 100 "
-									<< prm_old_clusters->get_id_of_seq_name().get_name_of_id( seq_id )
+									<< prm_old_clusters.get_id_of_seq_name().get_name_of_id( seq_id )
 									<< " "
 									<< get_name_of_cluster_of_id( prm_new_clusters, equiv_new.cluster_id )
 									<< "\n";
@@ -159,7 +177,7 @@ map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_cluste
 
 							// ...and record that the entries are equivalent 
 							record_mapping_fn( equiv_new.cluster_id );
-							highest_old_dom_overlap_fractions.add_overlap_fraction( 1.0 );
+							result.highest_old_dom_overlap_fractions.add_overlap_fraction( 1.0 );
 							continue;
 						}
 
@@ -179,7 +197,7 @@ map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_cluste
 						if ( any_of( new_dom_clust_ids, [&] (const domain_cluster_id &x) { return ! x.segments; } ) ) {
 							BOOST_THROW_EXCEPTION(invalid_argument_exception(
 								"Inconsistent whole-chain-domain on seq "
-								+ prm_old_clusters->get_id_of_seq_name().get_name_of_id( seq_id )
+								+ prm_old_clusters.get_id_of_seq_name().get_name_of_id( seq_id ).to_string()
 							));
 						}
 
@@ -197,20 +215,20 @@ map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_cluste
 						const double best_ol = get_dom_ol_fn( new_with_best_ol_over_longer );
 
 						// Record the best overlap
-						highest_old_dom_overlap_fractions.add_overlap_fraction( best_ol );
+						result.highest_old_dom_overlap_fractions.add_overlap_fraction( best_ol );
 
 						if ( prm_domain_out_stream ) {
 							prm_domain_out_stream->get()
-								<< dom_map_result_tag
+								<< DOM_MAP_RESULT_TAG
 								<< " "
-								<< prm_old_clusters->get_id_of_seq_name().get_name_of_id( seq_id )
+								<< prm_old_clusters.get_id_of_seq_name().get_name_of_id( seq_id )
 								<< get_segments_suffix_string( old_segments_opt )
 								<< " "
-								<< get_name_of_cluster_of_id( *prm_old_clusters, old_dom_clust_id.cluster_id )
+								<< get_name_of_cluster_of_id( prm_old_clusters, old_dom_clust_id.cluster_id )
 								<< " "
 								<< ( 100.0 * best_ol )
 								<< " "
-								<< prm_old_clusters->get_id_of_seq_name().get_name_of_id( seq_id )
+								<< prm_old_clusters.get_id_of_seq_name().get_name_of_id( seq_id )
 								<< get_segments_suffix_string( new_with_best_ol_over_longer.segments )
 								<< " "
 								<< get_name_of_cluster_of_id( prm_new_clusters, new_with_best_ol_over_longer.cluster_id )
@@ -230,7 +248,7 @@ map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_cluste
 			// At the end of the old cluster, store any potential new maps
 			for (const size_t &new_cluster_idx : indices( num_new_clusters ) ) {
 				if ( new_clust_equivs[ new_cluster_idx ] > 0 ) {
-					potential_maps.emplace_back(
+					result.potential_maps.emplace_back(
 						old_cluster_idx,
 						new_cluster_idx,
 						new_clust_equivs[ new_cluster_idx ]
@@ -238,6 +256,148 @@ map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_cluste
 				}
 			}
 		}
+		return result;
+	}
+
+	/// \brief Split the specified old clusters into contiguous [begin, end) blocks for mapping with the specified number of threads
+	///
+	/// The blocks are balanced by number of entries (rather than number of clusters) and are kept below
+	/// MAX_ENTRIES_PER_PARALLEL_BLOCK entries (unless a single cluster exceeds that). For one thread,
+	/// this returns a single block covering all the old clusters.
+	size_size_pair_vec old_cluster_blocks(const old_cluster_data &prm_old_clusters, ///< The old clusters
+	                                      const size_t           &prm_num_threads   ///< The number of threads that will be used to map the blocks
+	                                      ) {
+		const size_t num_old_clusters = prm_old_clusters.size();
+		if ( prm_num_threads <= 1 || num_old_clusters == 0 ) {
+			return { { 0, num_old_clusters } };
+		}
+
+		const size_t num_old_entries  = get_num_entries( prm_old_clusters );
+		const size_t entries_per_blk  = min(
+			MAX_ENTRIES_PER_PARALLEL_BLOCK,
+			max( 1_z, ( num_old_entries + prm_num_threads - 1 ) / prm_num_threads )
+		);
+
+		size_size_pair_vec blocks;
+		size_t block_begin   = 0;
+		size_t block_entries = 0;
+		for (const size_t &old_cluster_idx : indices( num_old_clusters ) ) {
+			block_entries += num_entries( prm_old_clusters[ old_cluster_idx ] );
+			if ( block_entries >= entries_per_blk ) {
+				blocks.emplace_back( block_begin, old_cluster_idx + 1 );
+				block_begin   = old_cluster_idx + 1;
+				block_entries = 0;
+			}
+		}
+		if ( block_begin < num_old_clusters ) {
+			blocks.emplace_back( block_begin, num_old_clusters );
+		}
+		return blocks;
+	}
+
+} // namespace
+
+/// \brief Map old clusters to new clusters
+///
+/// If the mapping spec specifies more than one thread, contiguous blocks of the old clusters are
+/// mapped concurrently (in waves of up to that many blocks) with each block's domain mapping output
+/// buffered and then written in block order. The results and output are identical to using one thread.
+///
+/// \todo Consider trying to break this long function up further
+map_results cath::clust::map_clusters(const old_cluster_data_opt &prm_old_clusters,     ///< The old clusters
+                                      const new_cluster_data     &prm_new_clusters,     ///< The new clusters
+                                      const clust_mapping_spec   &prm_mapping_spec,     ///< The specification for the mapping
+                                      const ostream_ref_opt      &prm_domain_out_stream ///< An optional stream to which individual domain mappings should be printed
+                                      ) {
+	// Grab the number of new clusters
+	const size_t num_new_clusters = get_num_clusters( prm_new_clusters );
+
+	if ( prm_domain_out_stream ) {
+		prm_domain_out_stream->get() << "# Columns: tag(" << DOM_MAP_RESULT_TAG << ") old_domain cluster_of_old_domain best_overlap_pc (best_new_domain) (cluster_of_best_new_domain) # [where last two columns absent if no new domains on the sequence]\n";
+	}
+
+	// Prepare some data structures
+	doub_vec           highest_old_clust_overlap_fractions;
+	overlap_frac_distn highest_old_dom_overlap_fractions;
+	size_t             num_with_nothing_on_parent = 0;
+	potential_map_vec  chosen_maps;
+	potential_map_vec  potential_maps;
+	size_vec           num_mapped_by_new_cluster;
+	size_vec           num_mapped_by_old_cluster;
+
+	// If there are old clusters perform a mapping
+	if ( prm_old_clusters ) {
+
+		// Grab the number of old clusters and initialise num_mapped_by_new_cluster & num_mapped_by_old_cluster
+		const size_t num_old_clusters = prm_old_clusters->size();
+		num_mapped_by_new_cluster.resize( num_new_clusters, 0 );
+		num_mapped_by_old_cluster.resize( num_old_clusters, 0 );
+
+		// Prepare a function for merging the results of mapping a block into the overall results
+		//
+		// Each potential map records all the mappings between its old and new clusters, so the
+		// numbers mapped by old and new cluster can be accumulated from the potential maps
+		const auto merge_block_fn = [&] (const old_clusters_block_mapping &x) {
+			for (const potential_map &pot_map : x.potential_maps) {
+				num_mapped_by_old_cluster[ pot_map.old_cluster_idx ] += pot_map.num_mapped;
+				num_mapped_by_new_cluster[ pot_map.new_cluster_idx ] += pot_map.num_mapped;
+			}
+			potential_maps.insert( common::cend( potential_maps ), common::cbegin( x.potential_maps ), common::cend( x.potential_maps ) );
+			highest_old_dom_overlap_fractions += x.highest_old_dom_overlap_fractions;
+			num_with_nothing_on_parent        += x.num_with_nothing_on_parent;
+		};
+
+		const size_t             num_threads = prm_mapping_spec.get_num_threads();
+		const size_size_pair_vec blocks      = old_cluster_blocks( *prm_old_clusters, num_threads );
+
+		// If using one thread, map the single block directly, writing straight to any domain output stream
+		if ( blocks.size() == 1 ) {
+			merge_block_fn( map_old_clusters_block(
+				*prm_old_clusters,
+				prm_new_clusters,
+				prm_mapping_spec,
+				blocks.front(),
+				prm_domain_out_stream
+			) );
+		}
+		// Otherwise, map waves of up to num_threads blocks concurrently and then merge them in order
+		else {
+			for (size_t wave_begin = 0; wave_begin < blocks.size(); wave_begin += num_threads) {
+				const size_t wave_size = min( num_threads, blocks.size() - wave_begin );
+
+				// Give each block its own output buffer, formatted like the domain output stream
+				vector<ostringstream> block_out_sss( wave_size );
+				if ( prm_domain_out_stream ) {
+					for (ostringstream &block_out_ss : block_out_sss) {
+						block_out_ss.copyfmt( prm_domain_out_stream->get() );
+					}
+				}
+
+				vector<future<old_clusters_block_mapping>> block_futures;
+				block_futures.reserve( wave_size );
+				for (const size_t &wave_idx : indices( wave_size ) ) {
+					block_futures.push_back( async(
+						launch::async,
+						[&, wave_idx] {
+							return map_old_clusters_block(
+								*prm_old_clusters,
+								prm_new_clusters,
+								prm_mapping_spec,
+								blocks[ wave_begin + wave_idx ],
+								prm_domain_out_stream ? ostream_ref_opt{ ostream_ref{ block_out_sss[ wave_idx ] } } : none
+							);
+						}
+					) );
+				}
+
+				for (const size_t &wave_idx : indices( wave_size ) ) {
+					merge_block_fn( block_futures[ wave_idx ].get() );
+					if ( prm_domain_out_stream ) {
+						prm_domain_out_stream->get() << block_out_sss[ wave_idx ].str();
+					}
+				}
+			}
+		}
 
 		// Calculate the highest overlap for each of the old clusters
 		highest_old_clust_overlap_fractions.resize( num_old_clusters, 0.0 );
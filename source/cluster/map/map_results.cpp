@@ -125,9 +125,9 @@ string cath::clust::results_string(const old_cluster_data_opt &prm_old_clusters,
 			chosen_maps
 				| transformed( [&] (const potential_map &the_map) {
 					return
-						  get_name_of_cluster_of_id(  prm_new_clusters, the_map.new_cluster_idx )
+						  get_name_of_cluster_of_id(  prm_new_clusters, the_map.new_cluster_idx ).to_string()
 						+ " "
-						+ get_name_of_cluster_of_id( *prm_old_clusters, the_map.old_cluster_idx )
+						+ get_name_of_cluster_of_id( *prm_old_clusters, the_map.old_cluster_idx ).to_string()
 						+ ( prm_batch_id ? ( " " + *prm_batch_id ) : "" )
 						+ "\n";
 				} ),
@@ -150,7 +150,7 @@ string cath::clust::results_string(const old_cluster_data_opt &prm_old_clusters,
 				| transformed( [&] (const size_t &new_cluster_index_index) {
 					const size_t &new_cluster_index = unmapped_new_cluster_indices[ new_cluster_index_index ];
 					return
-						  get_name_of_cluster_of_id( prm_new_clusters,  new_cluster_index )
+						  get_name_of_cluster_of_id( prm_new_clusters,  new_cluster_index ).to_string()
 						+ " "
 						+ detail::get_name_of_new_unmapped_cluster_of_index( precede_index, new_cluster_index_index )
 						+ ( prm_batch_id ? ( " " + *prm_batch_id ) : "" )
@@ -240,7 +240,7 @@ string cath::clust::longer_results_string(const old_cluster_data_opt &prm_old_cl
 					return
 						  "RENAME      "
 						+ ( prm_batch_id ? " " +*prm_batch_id : "" )
-						+ get_name_of_cluster_of_id( prm_new_clusters,  new_cluster_index )
+						+ get_name_of_cluster_of_id( prm_new_clusters,  new_cluster_index ).to_string()
 						+ " to "
 						+ detail::get_name_of_new_unmapped_cluster_of_index( precede_index, new_cluster_index_index );
 				} ),
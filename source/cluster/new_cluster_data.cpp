@@ -56,7 +56,7 @@ std::string cath::clust::to_string(const new_cluster_data &prm_new_cluster_data
 				| transformed( [&] (const size_t &x) {
 					return to_string( x )
 						+ R"((")"
-						+ get_name_of_cluster_of_id( prm_new_cluster_data, x )
+						+ get_name_of_cluster_of_id( prm_new_cluster_data, x ).to_string()
 						+ R"("):)"
 						+ to_string( get_size_of_cluster_of_id( prm_new_cluster_data, x ) );
 				} ),
@@ -140,9 +140,9 @@ namespace cath {
 		/// \brief Get the name of the cluster with the specified ID in the specified new_cluster_data
 		///
 		/// \relates new_cluster_data
-		inline const std::string & get_name_of_cluster_of_id(const new_cluster_data &prm_new_cluster_data, ///< The new_cluster_data to query
-		                                                     const cluster_id_t     &prm_cluster_id        ///< The ID of the cluster of interest
-		                                                     ) {
+		inline boost::string_ref get_name_of_cluster_of_id(const new_cluster_data &prm_new_cluster_data, ///< The new_cluster_data to query
+		                                                   const cluster_id_t     &prm_cluster_id        ///< The ID of the cluster of interest
+		                                                   ) {
 			return prm_new_cluster_data.get_clust_info().get_name_of_cluster_of_id( prm_cluster_id );
 		}
 
@@ -48,7 +48,7 @@ std::string cath::clust::to_string(const old_cluster_data &prm_old_cluster_data
 				| transformed( [&] (const size_t &x) {
 					return to_string( x )
 						+ R"((")"
-						+ get_name_of_cluster_of_id( prm_old_cluster_data, x )
+						+ get_name_of_cluster_of_id( prm_old_cluster_data, x ).to_string()
 						+ R"("): )"
 						+ to_string(
 							prm_old_cluster_data[ x ],
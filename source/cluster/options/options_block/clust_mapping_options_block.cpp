@@ -44,6 +44,9 @@ const string clust_mapping_options_block::PO_MIN_EQUIV_DOM_OL   { "min_equiv_dom
 /// \brief The option name for the fraction of the old cluster's entries that must map to a map-from cluster for them to be considered equivalent
 const string clust_mapping_options_block::PO_MIN_EQUIV_CLUST_OL { "min_equiv_clust_ol" };
 
+/// \brief The option name for the number of threads to use to map the old clusters
+const string clust_mapping_options_block::PO_NUM_THREADS        { "num-threads"        };
+
 /// \brief A standard do_clone method
 unique_ptr<options_block> clust_mapping_options_block::do_clone() const {
 	return { make_uptr_clone( *this ) };
@@ -60,9 +63,11 @@ void clust_mapping_options_block::do_add_visible_options_to_description(options_
                                                                         ) {
 	using std::to_string;
 	const string percent_varname   { "<percent>" };
+	const string num_varname       { "<num>"     };
 
 	const auto min_equiv_dom_ol_notifier   = [&] (const double &x) { the_spec.set_min_equiv_dom_ol  ( x / 100.0 ); };
 	const auto min_equiv_clust_ol_notifier = [&] (const double &x) { the_spec.set_min_equiv_clust_ol( x / 100.0 ); };
+	const auto num_threads_notifier        = [&] (const size_t &x) { the_spec.set_num_threads       ( x         ); };
 
 	prm_desc.add_options()
 		(
@@ -98,6 +103,15 @@ void clust_mapping_options_block::do_add_visible_options_to_description(options_
 				+ R"( must be ≥ )"
 				+ lexical_cast<string>( 100.0 * clust_mapping_spec::MIN_MIN_EQUIV_CLUST_OL             )
 				+ R"(%))" ).c_str()
+		)
+		(
+			PO_NUM_THREADS.c_str(),
+			value<size_t>()
+				->value_name   ( num_varname                                            )
+				->notifier     ( num_threads_notifier                                   )
+				->default_value( clust_mapping_spec::DEFAULT_NUM_THREADS                ),
+			( "Parse the inputs and map the map-from clusters using " + num_varname + " threads" "\n"
+				"(the results are identical whatever the number of threads)" ).c_str()
 		);
 }
 
@@ -113,6 +127,7 @@ str_vec clust_mapping_options_block::do_get_all_options_names() const {
 	return {
 		clust_mapping_options_block::PO_MIN_EQUIV_DOM_OL,
 		clust_mapping_options_block::PO_MIN_EQUIV_CLUST_OL,
+		clust_mapping_options_block::PO_NUM_THREADS,
 	};
 }
 
@@ -45,6 +45,7 @@ namespace cath {
 		public:
 			static const std::string PO_MIN_EQUIV_DOM_OL;
 			static const std::string PO_MIN_EQUIV_CLUST_OL;
+			static const std::string PO_NUM_THREADS;
 
 			const clust_mapping_spec & get_clust_mapping_spec() const;
 		};
@@ -23,6 +23,7 @@
 
 #include <boost/operators.hpp>
 
+#include <cstddef>
 #include <stdexcept>
 
 namespace cath {
@@ -44,6 +45,11 @@ namespace cath {
 			/// \brief The fraction of the old cluster's entries that must map to a new cluster for them to be considered equivalent
 			double min_equiv_clust_ol = DEFAULT_MIN_EQUIV_CLUST_OL;
 
+			/// \brief The number of threads to use to map the old clusters
+			///
+			/// The results are identical whatever the number of threads
+			size_t num_threads        = DEFAULT_NUM_THREADS;
+
 			static constexpr double check_frac_against_strict_min_and_return(const double &,
 			                                                                 const double &);
 
@@ -66,6 +72,9 @@ namespace cath {
 			/// \brief Strict minimum value for the fraction of the new cluster's entries that have mapped anywhere that must map to a map-from cluster for them to be considered equivalent
 			static constexpr double MIN_EQUIV_FRAC_OF_NEW_CLUST_EQUIVS = 0.5;
 
+			/// \brief Default value for the number of threads to use to map the old clusters
+			static constexpr size_t DEFAULT_NUM_THREADS                = 1;
+
 			/// \brief Default ctor
 			constexpr clust_mapping_spec() = default;
 
@@ -74,9 +83,11 @@ namespace cath {
 
 			constexpr const double & get_min_equiv_dom_ol() const;
 			constexpr const double & get_min_equiv_clust_ol() const;
+			constexpr const size_t & get_num_threads() const;
 
 			clust_mapping_spec & set_min_equiv_dom_ol(const double &);
 			clust_mapping_spec & set_min_equiv_clust_ol(const double &);
+			clust_mapping_spec & set_num_threads(const size_t &);
 		};
 
 		/// \brief Check a fraction is within [0, 1] and is strictly greater than the specified minimum.
@@ -106,6 +117,11 @@ namespace cath {
 			return min_equiv_clust_ol;
 		}
 
+		/// \brief Getter for the number of threads to use to map the old clusters
+		inline constexpr const size_t & clust_mapping_spec::get_num_threads() const {
+			return num_threads;
+		}
+
 		/// \brief Setter for the fraction that the overlap over the longest of two domains must exceed for them to be considered equivalent
 		inline clust_mapping_spec & clust_mapping_spec::set_min_equiv_dom_ol(const double &prm_min_equiv_dom_ol ///< The fraction that the overlap over the longest of two domains must exceed for them to be considered equivalent
 		                                                                     ) {
@@ -120,6 +136,16 @@ namespace cath {
 			return *this;
 		}
 
+		/// \brief Setter for the number of threads to use to map the old clusters
+		inline clust_mapping_spec & clust_mapping_spec::set_num_threads(const size_t &prm_num_threads ///< The number of threads to use to map the old clusters
+		                                                                ) {
+			if ( prm_num_threads == 0 ) {
+				throw std::invalid_argument("The number of threads to use for cluster mapping must be at least one");
+			}
+			num_threads = prm_num_threads;
+			return *this;
+		}
+
 		/// \brief Return whether the two specified clust_mapping_specs are identical
 		///
 		/// \relates clust_mapping_spec
@@ -130,6 +156,8 @@ namespace cath {
 				prm_lhs.get_min_equiv_dom_ol()   == prm_rhs.get_min_equiv_dom_ol()
 				&&
 				prm_lhs.get_min_equiv_clust_ol() == prm_rhs.get_min_equiv_clust_ol()
+				&&
+				prm_lhs.get_num_threads()        == prm_rhs.get_num_threads()
 			);
 		}
 
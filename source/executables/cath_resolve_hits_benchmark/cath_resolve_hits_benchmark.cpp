@@ -0,0 +1,123 @@
+/// \file
+/// \brief The cath_resolve_hits_benchmark_program_exception_wrapper definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/program_options.hpp>
+
+#include "common/file/open_fstream.hpp"
+#include "common/program_exception_wrapper.hpp"
+#include "executables/cath_resolve_hits_benchmark/heap_alloc_counter.hpp"
+#include "resolve_hits/benchmark/crh_benchmark.hpp"
+#include "resolve_hits/benchmark/synthetic_hits_spec.hpp"
+
+#include <fstream>
+#include <iostream>
+
+using namespace cath::common;
+using namespace cath::rslv;
+
+using boost::program_options::notify;
+using boost::program_options::options_description;
+using boost::program_options::parse_command_line;
+using boost::program_options::store;
+using boost::program_options::value;
+using boost::program_options::variables_map;
+using std::cout;
+using std::ofstream;
+using std::string;
+
+namespace {
+
+	/// \brief A concrete program_exception_wrapper that implements do_run_program() to parse the options and then run the benchmark
+	///
+	/// Using program_exception_wrapper allows the program to be wrapped in standard last-chance exception handling.
+	class cath_resolve_hits_benchmark_program_exception_wrapper final : public program_exception_wrapper {
+		string do_get_program_name() const final {
+			return "cath-resolve-hits-benchmark";
+		}
+
+		/// \brief Parse the options, run the benchmark and write the JSON report
+		void do_run_program(int argc, char * argv[]) final {
+			size_t num_queries      = synthetic_hits_spec::DEFAULT_NUM_QUERIES;
+			size_t seq_length       = synthetic_hits_spec::DEFAULT_SEQ_LENGTH;
+			size_t num_hits         = synthetic_hits_spec::DEFAULT_NUM_HITS;
+			double overlap_density  = synthetic_hits_spec::DEFAULT_OVERLAP_DENSITY;
+			double discont_fraction = synthetic_hits_spec::DEFAULT_DISCONT_FRACTION;
+			string score_distn      = to_string( synthetic_hits_spec::DEFAULT_SCORE_DISTN );
+			size_t seed             = synthetic_hits_spec::DEFAULT_SEED;
+			size_t num_repeats      = 3;
+			string output_file;
+
+			options_description the_options{ "Benchmark cath-resolve-hits on synthetic hits, writing a JSON report of each stage's throughput, allocations and the process's peak RSS so far.\n\nOptions" };
+			the_options.add_options()
+				( "help,h",                                                                              "Output this help message"                                                          )
+				( "num-queries",      value<size_t>( &num_queries      )->default_value( num_queries      ), "Generate hits for <arg> queries"                                                   )
+				( "seq-length",       value<size_t>( &seq_length       )->default_value( seq_length       ), "Make each query sequence <arg> residues long"                                      )
+				( "num-hits",         value<size_t>( &num_hits         )->default_value( num_hits         ), "Generate <arg> hits per query"                                                    )
+				( "overlap-density",  value<double>( &overlap_density  )->default_value( overlap_density  ), "Make the mean number of hits covering each residue <arg> (sets the mean hit length)" )
+				( "discont-fraction", value<double>( &discont_fraction )->default_value( discont_fraction ), "Make a fraction <arg> of the hits discontinuous"                                    )
+				( "score-distn",      value<string>( &score_distn      )->default_value( score_distn      ), "Draw scores from distribution <arg> (uniform or exponential)"                     )
+				( "seed",             value<size_t>( &seed             )->default_value( seed             ), "Seed the random number generator with <arg>"                                      )
+				( "num-repeats",      value<size_t>( &num_repeats      )->default_value( num_repeats      ), "Run each stage <arg> times and report the fastest"                                )
+				( "output-file",      value<string>( &output_file      ),                                    "Write the JSON report to file <arg> rather than to stdout"                         );
+
+			variables_map the_vm;
+			store( parse_command_line( argc, argv, the_options ), the_vm );
+			notify( the_vm );
+			if ( the_vm.count( "help" ) ) {
+				cout << the_options << "\n";
+				return;
+			}
+
+			const auto the_spec = synthetic_hits_spec{}
+				.set_num_queries     ( num_queries                                 )
+				.set_seq_length      ( static_cast<cath::seq::residx_t>( seq_length ) )
+				.set_num_hits        ( num_hits                                    )
+				.set_overlap_density ( overlap_density                             )
+				.set_discont_fraction( discont_fraction                            )
+				.set_score_distn     ( synthetic_score_distn_of_string( score_distn ) )
+				.set_seed            ( seed                                        );
+
+			const string report = crh_benchmark_json_string(
+				the_spec,
+				num_repeats,
+				run_crh_benchmark(
+					the_spec,
+					num_repeats,
+					&get_num_heap_allocs
+				)
+			);
+
+			if ( output_file.empty() ) {
+				cout << report << "\n";
+			}
+			else {
+				ofstream out_stream;
+				open_ofstream( out_stream, output_file );
+				out_stream << report << "\n";
+				out_stream.close();
+			}
+		}
+	};
+} // namespace
+
+/// \brief A main function for cath_resolve_hits_benchmark that just calls run_program() on a cath_resolve_hits_benchmark_program_exception_wrapper
+int main(int argc, char * argv[] ) {
+	return cath_resolve_hits_benchmark_program_exception_wrapper().run_program( argc, argv );
+}
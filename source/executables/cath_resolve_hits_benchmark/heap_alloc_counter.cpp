@@ -0,0 +1,131 @@
+/// \file
+/// \brief The heap_alloc_counter definitions
+///
+/// This replaces every form of the global operator new and operator delete so that the
+/// benchmark can count heap allocations. It is only linked into cath-resolve-hits-benchmark,
+/// never into the cath-tools libraries.
+///
+/// The replacements are kept in their own translation unit so that the compiler can't inline
+/// the malloc()/free() calls into code that pairs a new-expression with a delete-expression
+/// (which would trigger -Wmismatched-new-delete).
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "heap_alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using std::atomic;
+using std::bad_alloc;
+using std::nothrow_t;
+
+namespace {
+
+	/// \brief The number of heap allocations made through the global operator new
+	atomic<size_t> num_heap_allocs{ 0 };
+
+	/// \brief Count an allocation and allocate the specified number of bytes, returning nullptr on failure
+	void * counted_malloc(const size_t &prm_size ///< The number of bytes to allocate
+	                      ) noexcept {
+		++num_heap_allocs;
+		return std::malloc( prm_size == 0 ? 1 : prm_size );
+	}
+
+	/// \brief Count an allocation and allocate the specified number of bytes, throwing bad_alloc on failure
+	void * counted_malloc_or_throw(const size_t &prm_size ///< The number of bytes to allocate
+	                               ) {
+		if ( void * const ptr = counted_malloc( prm_size ) ) {
+			return ptr;
+		}
+		throw bad_alloc{};
+	}
+
+} // namespace
+
+/// \brief Get the number of heap allocations made through the global operator new so far
+size_t cath::rslv::get_num_heap_allocs() {
+	return num_heap_allocs.load();
+}
+
+/// \brief Replace the global operator new to count the heap allocations
+void * operator new(size_t prm_size ///< The number of bytes to allocate
+                    ) {
+	return counted_malloc_or_throw( prm_size );
+}
+
+/// \brief Replace the global array operator new to count the heap allocations
+void * operator new[](size_t prm_size ///< The number of bytes to allocate
+                      ) {
+	return counted_malloc_or_throw( prm_size );
+}
+
+/// \brief Replace the global nothrow operator new to count the heap allocations
+void * operator new(size_t           prm_size, ///< The number of bytes to allocate
+                    const nothrow_t &          ///< The nothrow tag
+                    ) noexcept {
+	return counted_malloc( prm_size );
+}
+
+/// \brief Replace the global nothrow array operator new to count the heap allocations
+void * operator new[](size_t           prm_size, ///< The number of bytes to allocate
+                      const nothrow_t &          ///< The nothrow tag
+                      ) noexcept {
+	return counted_malloc( prm_size );
+}
+
+/// \brief Replace the global operator delete to match the replaced operator new
+void operator delete(void *prm_ptr ///< The memory to free
+                     ) noexcept {
+	std::free( prm_ptr );
+}
+
+/// \brief Replace the global array operator delete to match the replaced operator new
+void operator delete[](void *prm_ptr ///< The memory to free
+                       ) noexcept {
+	std::free( prm_ptr );
+}
+
+/// \brief Replace the global sized operator delete to match the replaced operator new
+void operator delete(void   *prm_ptr, ///< The memory to free
+                     size_t           ///< The size of the memory to free (unused)
+                     ) noexcept {
+	std::free( prm_ptr );
+}
+
+/// \brief Replace the global sized array operator delete to match the replaced operator new
+void operator delete[](void   *prm_ptr, ///< The memory to free
+                       size_t           ///< The size of the memory to free (unused)
+                       ) noexcept {
+	std::free( prm_ptr );
+}
+
+/// \brief Replace the global nothrow operator delete to match the replaced operator new
+void operator delete(void            *prm_ptr, ///< The memory to free
+                     const nothrow_t &         ///< The nothrow tag
+                     ) noexcept {
+	std::free( prm_ptr );
+}
+
+/// \brief Replace the global nothrow array operator delete to match the replaced operator new
+void operator delete[](void            *prm_ptr, ///< The memory to free
+                       const nothrow_t &         ///< The nothrow tag
+                       ) noexcept {
+	std::free( prm_ptr );
+}
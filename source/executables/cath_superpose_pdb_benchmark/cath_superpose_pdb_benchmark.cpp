@@ -0,0 +1,149 @@
+/// \file
+/// \brief The cath_superpose_pdb_benchmark_program_exception_wrapper definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/filesystem/path.hpp>
+#include <boost/program_options.hpp>
+
+#include "chopping/region/region.hpp"
+#include "common/exception/runtime_error_exception.hpp"
+#include "common/program_exception_wrapper.hpp"
+#include "file/pdb/pdb.hpp"
+#include "file/pdb/pdb_atom.hpp"
+#include "file/pdb/pdb_residue.hpp"
+#include "structure/geometry/angle.hpp"
+#include "structure/geometry/coord.hpp"
+#include "structure/geometry/rotation.hpp"
+#include "superposition/io/superposition_io.hpp"
+#include "superposition/superposition.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::file;
+using namespace cath::geom;
+using namespace cath::sup;
+
+using boost::filesystem::path;
+using boost::program_options::notify;
+using boost::program_options::options_description;
+using boost::program_options::parse_command_line;
+using boost::program_options::store;
+using boost::program_options::value;
+using boost::program_options::variables_map;
+using std::chrono::duration;
+using std::chrono::high_resolution_clock;
+using std::cout;
+using std::ostringstream;
+using std::string;
+
+namespace {
+
+	/// \brief Write the specified pdb superposed in the old way: by transforming a copy and then calling write_pdb_file()
+	string superposed_pdb_string_via_copy(const superposition &prm_superposition, ///< The superposition to apply
+	                                      const pdb           &prm_pdb,           ///< The pdb to superpose and write
+	                                      const size_t        &prm_index          ///< The index of the pdb in the superposition
+	                                      ) {
+		pdb pdb_copy = prm_pdb;
+		pdb_copy += prm_superposition.get_translation_of_index( prm_index );
+		pdb_copy.rotate( prm_superposition.get_rotation_of_index( prm_index ) );
+		ostringstream out_ss;
+		write_pdb_file( out_ss, pdb_copy );
+		return out_ss.str();
+	}
+
+	/// \brief Write the specified pdb superposed via write_superposed_pdb_to_ostream()
+	string superposed_pdb_string(const superposition &prm_superposition, ///< The superposition to apply
+	                             const pdb           &prm_pdb,           ///< The pdb to superpose and write
+	                             const size_t        &prm_index          ///< The index of the pdb in the superposition
+	                             ) {
+		ostringstream out_ss;
+		write_superposed_pdb_to_ostream( out_ss, prm_superposition, prm_pdb, prm_index );
+		return out_ss.str();
+	}
+
+	/// \brief Time the specified number of calls to the specified function and return the duration in seconds
+	template <typename Fn>
+	double seconds_for_repeats(const size_t &prm_num_repeats, ///< The number of times to call the function
+	                           Fn          &&prm_fn           ///< The function to call
+	                           ) {
+		const auto start_time = high_resolution_clock::now();
+		for (size_t repeat_ctr = 0; repeat_ctr < prm_num_repeats; ++repeat_ctr) {
+			prm_fn();
+		}
+		const duration<double> the_duration = high_resolution_clock::now() - start_time;
+		return the_duration.count();
+	}
+
+	/// \brief A concrete program_exception_wrapper that implements do_run_program() to parse the options and then run the benchmark
+	///
+	/// Using program_exception_wrapper allows the program to be wrapped in standard last-chance exception handling.
+	class cath_superpose_pdb_benchmark_program_exception_wrapper final : public program_exception_wrapper {
+		string do_get_program_name() const final {
+			return "cath-superpose-pdb-benchmark";
+		}
+
+		/// \brief Parse the options, check the two writers agree and then report how long each takes
+		void do_run_program(int argc, char * argv[]) final {
+			path   pdb_file;
+			size_t num_repeats = 20;
+
+			options_description the_options{ "Benchmark writing a superposed PDB via write_superposed_pdb_to_ostream() against transforming a copy and then writing it.\n\nOptions" };
+			the_options.add_options()
+				( "help,h",                                                                   "Output this help message"                      )
+				( "pdb-file",    value<path>  ( &pdb_file    ),                               "Superpose and write the PDB in file <arg>"     )
+				( "num-repeats", value<size_t>( &num_repeats )->default_value( num_repeats ), "Write the superposed PDB <arg> times each way" );
+
+			variables_map the_vm;
+			store( parse_command_line( argc, argv, the_options ), the_vm );
+			notify( the_vm );
+			if ( the_vm.count( "help" ) || pdb_file.empty() ) {
+				cout << the_options << "\n";
+				return;
+			}
+
+			const pdb           the_pdb = read_pdb_file( pdb_file );
+			const superposition the_sup{
+				coord_vec   { ORIGIN_COORD, coord{ 12.3456, -7.0005, 0.1234 } },
+				rotation_vec{ rotation::IDENTITY_ROTATION(), rotation_of_angle( make_angle_from_degrees<double>( 37.5 ) ) }
+			};
+
+			if ( superposed_pdb_string( the_sup, the_pdb, 1 ) != superposed_pdb_string_via_copy( the_sup, the_pdb, 1 ) ) {
+				BOOST_THROW_EXCEPTION(runtime_error_exception(
+					"Writing the superposed PDB via write_superposed_pdb_to_ostream() didn't give the same bytes as transforming a copy"
+				));
+			}
+
+			const double copy_seconds = seconds_for_repeats( num_repeats, [&] { superposed_pdb_string_via_copy( the_sup, the_pdb, 1 ); } );
+			const double fast_seconds = seconds_for_repeats( num_repeats, [&] { superposed_pdb_string         ( the_sup, the_pdb, 1 ); } );
+
+			cout << "Writing superposed PDB with " << the_pdb.get_num_atoms() << " atoms " << num_repeats << " times took "
+				<< copy_seconds << "s by transforming a copy and "
+				<< fast_seconds << "s via write_superposed_pdb_to_ostream()\n";
+		}
+	};
+} // namespace
+
+/// \brief A main function for cath_superpose_pdb_benchmark that just calls run_program() on a cath_superpose_pdb_benchmark_program_exception_wrapper
+int main(int argc, char * argv[] ) {
+	return cath_superpose_pdb_benchmark_program_exception_wrapper().run_program( argc, argv );
+}
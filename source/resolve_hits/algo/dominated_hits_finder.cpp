@@ -0,0 +1,196 @@
+/// \file
+/// \brief The dominated_hits_finder class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "dominated_hits_finder.hpp"
+
+#include <boost/range/algorithm/lower_bound.hpp>
+#include <boost/range/algorithm/sort.hpp>
+#include <boost/range/irange.hpp>
+
+#include "common/algorithm/sort_uniq_copy.hpp"
+#include "common/boost_addenda/range/indices.hpp"
+#include "resolve_hits/full_hit_fns.hpp"
+#include "resolve_hits/full_hit_list.hpp"
+#include "resolve_hits/trim/trim_spec.hpp"
+
+#include <limits>
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::rslv::detail;
+using namespace cath::seq;
+
+using boost::irange;
+using boost::range::lower_bound;
+using boost::range::sort;
+using std::min;
+using std::numeric_limits;
+
+/// \brief Make a copy of the specified crh_filter_spec containing only the score-filtering parts
+///
+/// This avoids copying potentially long lists of filter query IDs into every finder
+static crh_filter_spec make_score_filter_spec(const crh_filter_spec &prm_filter_spec ///< The crh_filter_spec to copy
+                                              ) {
+	crh_filter_spec result;
+	result.set_worst_permissible_evalue  ( prm_filter_spec.get_worst_permissible_evalue()   )
+	      .set_worst_permissible_bitscore( prm_filter_spec.get_worst_permissible_bitscore() )
+	      .set_worst_permissible_score   ( prm_filter_spec.get_worst_permissible_score()    );
+	return result;
+}
+
+/// \brief Ctor from the specs that define how the hits are used in the resolving calculations
+dominated_hits_finder::dominated_hits_finder(const crh_score_spec   &prm_score_spec,   ///< The crh_score_spec to specify how the crh-scores are to be calculated from the full-hits
+                                             const crh_segment_spec &prm_segment_spec, ///< The crh_segment_spec to specify how the segments are to be handled before being put into the hits for calculation
+                                             const crh_filter_spec  &prm_filter_spec   ///< The crh_filter_spec specifying how hits should be filtered
+                                             ) : the_score_spec   { prm_score_spec                            },
+                                                 the_segment_spec { prm_segment_spec                          },
+                                                 the_filter_spec  { make_score_filter_spec( prm_filter_spec ) } {
+}
+
+/// \brief Clear the data for any previously-processed hits
+void dominated_hits_finder::clear_hits() {
+	scores.clear();
+	can_dominates.clear();
+	segs.clear();
+	seg_offsets.assign( 1, 0 );
+}
+
+/// \brief Add the data for the specified hit, in the form in which it would be used in the resolving calculations
+void dominated_hits_finder::add_hit(const full_hit &prm_full_hit ///< The full_hit to add
+                                    ) {
+	const trim_spec &overlap_trim_spec = the_segment_spec.get_overlap_trim_spec();
+	const residx_t  &min_seg_length    = the_segment_spec.get_min_seg_length();
+
+	const size_t segs_size_before = segs.size();
+	for (const seq_seg &the_seg : prm_full_hit.get_segments() ) {
+		if ( get_length( the_seg ) >= min_seg_length ) {
+			segs.push_back( trim_seq_seg_copy( the_seg, overlap_trim_spec ) );
+		}
+	}
+	const size_t num_segs = segs.size() - segs_size_before;
+
+	scores.push_back( get_crh_score( prm_full_hit, the_score_spec ) );
+	can_dominates.push_back(
+		( num_segs == 1 )
+		&&
+		score_passes_filter( the_filter_spec, prm_full_hit.get_score(), prm_full_hit.get_score_type() )
+	);
+	seg_offsets.push_back( segs.size() );
+}
+
+/// \brief Calculate the (sorted) indices of the hits that have been added that are strictly dominated
+///        by other hits that have been added
+///
+/// This processes the hits in descending order of score, using a Fenwick tree (over the dominators'
+/// starts) of the minimum stop of the dominators that have been seen so far. For each of a hit's segments,
+/// that gives the smallest stop of any better dominator starting at or after the segment's start; if that's
+/// no later than the segment's stop, the dominator lies within the segment.
+///
+/// Hits of equal score are all queried before any of them are inserted so that only strictly better hits dominate.
+cath::size_vec dominated_hits_finder::calc_dominated_indices() {
+	const size_t num_hits = scores.size();
+
+	dominator_starts.clear();
+	for (const size_t &hit_ctr : indices( num_hits ) ) {
+		if ( can_dominates[ hit_ctr ] ) {
+			dominator_starts.push_back( segs[ seg_offsets[ hit_ctr ] ].get_start_arrow().get_index() );
+		}
+	}
+	if ( dominator_starts.empty() ) {
+		return {};
+	}
+	sort_uniq( dominator_starts );
+
+	const size_t num_starts = dominator_starts.size();
+	min_stop_tree.assign( num_starts + 1, numeric_limits<resarw_t>::max() );
+
+	// Get the suffix position of the specified start arrow index (ie the number of dominator starts at or after it)
+	const auto num_starts_from_fn = [&] (const resarw_t &x) {
+		return num_starts - static_cast<size_t>( lower_bound( dominator_starts, x ) - common::cbegin( dominator_starts ) );
+	};
+
+	sorted_indices.resize( num_hits );
+	for (const size_t &hit_ctr : indices( num_hits ) ) {
+		sorted_indices[ hit_ctr ] = hit_ctr;
+	}
+	sort(
+		sorted_indices,
+		[&] (const size_t &x, const size_t &y) {
+			return ( scores[ x ] > scores[ y ] ) || ( scores[ x ] == scores[ y ] && x < y );
+		}
+	);
+
+	size_vec results;
+	size_t group_begin = 0;
+	while ( group_begin < num_hits ) {
+		const resscr_t &group_score = scores[ sorted_indices[ group_begin ] ];
+		size_t group_end = group_begin + 1;
+		while ( group_end < num_hits && scores[ sorted_indices[ group_end ] ] == group_score ) {
+			++group_end;
+		}
+
+		// Query each hit in the group against the strictly better dominators seen so far
+		for (const size_t &sorted_ctr : irange( group_begin, group_end ) ) {
+			const size_t &hit_idx = sorted_indices[ sorted_ctr ];
+			for (const size_t &seg_ctr : irange( seg_offsets[ hit_idx ], seg_offsets[ hit_idx + 1 ] ) ) {
+				const seq_seg &the_seg  = segs[ seg_ctr ];
+				resarw_t       min_stop = numeric_limits<resarw_t>::max();
+				for (size_t tree_idx = num_starts_from_fn( the_seg.get_start_arrow().get_index() ); tree_idx > 0; tree_idx &= ( tree_idx - 1 ) ) {
+					min_stop = min( min_stop, min_stop_tree[ tree_idx ] );
+				}
+				if ( min_stop <= the_seg.get_stop_arrow().get_index() ) {
+					results.push_back( hit_idx );
+					break;
+				}
+			}
+		}
+
+		// Insert the group's dominators
+		for (const size_t &sorted_ctr : irange( group_begin, group_end ) ) {
+			const size_t &hit_idx = sorted_indices[ sorted_ctr ];
+			if ( can_dominates[ hit_idx ] ) {
+				const seq_seg &the_seg = segs[ seg_offsets[ hit_idx ] ];
+				const resarw_t stop    = the_seg.get_stop_arrow().get_index();
+				for (size_t tree_idx = num_starts_from_fn( the_seg.get_start_arrow().get_index() ); tree_idx <= num_starts; tree_idx += ( tree_idx & ( ~tree_idx + 1 ) ) ) {
+					min_stop_tree[ tree_idx ] = min( min_stop_tree[ tree_idx ], stop );
+				}
+			}
+		}
+
+		group_begin = group_end;
+	}
+
+	sort( results );
+	return results;
+}
+
+/// \brief Count the number of hits in the specified full_hit_list that are strictly dominated by
+///        other hits in the list and so could be pruned without changing the resolved architecture
+///
+/// \relates dominated_hits_finder
+size_t cath::rslv::detail::count_dominated_hits(const full_hit_list    &prm_full_hits,    ///< The full_hits to query
+                                                const crh_score_spec   &prm_score_spec,   ///< The crh_score_spec to specify how the crh-scores are to be calculated from the full-hits
+                                                const crh_segment_spec &prm_segment_spec, ///< The crh_segment_spec to specify how the segments are to be handled before being put into the hits for calculation
+                                                const crh_filter_spec  &prm_filter_spec   ///< The crh_filter_spec specifying how hits should be filtered
+                                                ) {
+	return dominated_hits_finder{ prm_score_spec, prm_segment_spec, prm_filter_spec }
+		.find_dominated_indices( prm_full_hits )
+		.size();
+}
@@ -0,0 +1,117 @@
+/// \file
+/// \brief The dominated_hits_finder class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_ALGO_DOMINATED_HITS_FINDER_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_ALGO_DOMINATED_HITS_FINDER_HPP
+
+#include "common/type_aliases.hpp"
+#include "resolve_hits/full_hit.hpp"
+#include "resolve_hits/options/spec/crh_filter_spec.hpp"
+#include "resolve_hits/options/spec/crh_score_spec.hpp"
+#include "resolve_hits/options/spec/crh_segment_spec.hpp"
+#include "resolve_hits/resolve_hits_type_aliases.hpp"
+
+#include <vector>
+
+namespace cath {
+	namespace rslv {
+		namespace detail {
+
+			/// \brief Find the hits that are strictly dominated by another hit and so can never
+			///        appear in a resolved architecture
+			///
+			/// Hit a strictly dominates hit b if a's crh-score is strictly greater than b's and a's
+			/// segments (as used in the resolving calculations, ie after applying the crh_segment_spec)
+			/// are within b's. In that case, any architecture containing b could be improved by
+			/// swapping b for a, so b can be discarded without changing the resolved architecture.
+			///
+			/// Only contiguous hits that pass the score filter are used as dominators, which makes the
+			/// search a fast, sorted sweep. This means some dominated hits may be missed but that
+			/// none will be wrongly reported.
+			///
+			/// This stores working buffers so that repeated calls needn't reallocate.
+			class dominated_hits_finder final {
+			private:
+				/// \brief The score spec with which to calculate the hits' crh-scores
+				crh_score_spec the_score_spec;
+
+				/// \brief The segment spec with which to calculate the hits' segments
+				crh_segment_spec the_segment_spec;
+
+				/// \brief A filter spec containing just the score-filtering part of the filter spec
+				crh_filter_spec the_filter_spec;
+
+				/// \brief The crh-score of each of the hits being processed
+				std::vector<resscr_t> scores;
+
+				/// \brief Whether each of the hits being processed can be used to dominate others
+				///        (ie is contiguous and passes the score filter)
+				std::vector<char> can_dominates;
+
+				/// \brief The trimmed segments of all the hits being processed, stored contiguously
+				seq::seq_seg_vec segs;
+
+				/// \brief The offset of each hit's first segment in segs (with an extra end offset)
+				size_vec seg_offsets;
+
+				/// \brief The indices of the hits, for sorting by descending score
+				size_vec sorted_indices;
+
+				/// \brief The sorted, unique start arrow indices of the dominators
+				std::vector<seq::resarw_t> dominator_starts;
+
+				/// \brief The Fenwick tree of the minimum stop of dominators over start suffixes
+				std::vector<seq::resarw_t> min_stop_tree;
+
+				void clear_hits();
+				void add_hit(const full_hit &);
+				size_vec calc_dominated_indices();
+
+			public:
+				dominated_hits_finder(const crh_score_spec &,
+				                      const crh_segment_spec &,
+				                      const crh_filter_spec &);
+
+				template <typename FullHitRng>
+				size_vec find_dominated_indices(const FullHitRng &);
+			};
+
+			/// \brief Return the (sorted) indices of the hits in the specified range of full_hits
+			///        that are strictly dominated by other hits in the range
+			template <typename FullHitRng>
+			size_vec dominated_hits_finder::find_dominated_indices(const FullHitRng &prm_full_hits ///< The range of full_hits to query
+			                                                       ) {
+				clear_hits();
+				for (const full_hit &the_full_hit : prm_full_hits) {
+					add_hit( the_full_hit );
+				}
+				return calc_dominated_indices();
+			}
+
+			size_t count_dominated_hits(const full_hit_list &,
+			                            const crh_score_spec &,
+			                            const crh_segment_spec &,
+			                            const crh_filter_spec &);
+
+		} // namespace detail
+	} // namespace rslv
+} // namespace cath
+
+#endif
@@ -0,0 +1,111 @@
+/// \file
+/// \brief The dominated_hits_finder test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "resolve_hits/algo/dominated_hits_finder.hpp"
+#include "resolve_hits/detail/full_hit_prune_builder.hpp"
+#include "resolve_hits/full_hit_list.hpp"
+#include "test/boost_addenda/boost_check_equal_ranges.hpp"
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::rslv::detail;
+using namespace cath::seq;
+
+namespace cath {
+	namespace test {
+
+		/// \brief The dominated_hits_finder_test_suite_fixture to assist in testing dominated_hits_finder
+		struct dominated_hits_finder_test_suite_fixture {
+		protected:
+			~dominated_hits_finder_test_suite_fixture() noexcept = default;
+
+			/// \brief Find the dominated indices in the specified full_hits using neutral specs
+			static size_vec find_dominated(const full_hit_vec &prm_full_hits ///< The full_hits to query
+			                               ) {
+				return dominated_hits_finder{
+					make_neutral_score_spec(),
+					make_no_action_crh_segment_spec(),
+					crh_filter_spec{}
+				}.find_dominated_indices( prm_full_hits );
+			}
+		};
+
+	}  // namespace test
+}  // namespace cath
+
+BOOST_FIXTURE_TEST_SUITE(dominated_hits_finder_test_suite, cath::test::dominated_hits_finder_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(finds_worse_hit_containing_better_hit) {
+	BOOST_CHECK_EQUAL_RANGES(
+		find_dominated( {
+			full_hit( { seq_seg{ 10, 19 } }, "match_a", 2.0 ),
+			full_hit( { seq_seg{  0, 29 } }, "match_b", 1.0 ),
+			full_hit( { seq_seg{ 15, 40 } }, "match_c", 1.5 ),
+		} ),
+		size_vec{ 1 }
+	);
+}
+
+BOOST_AUTO_TEST_CASE(does_not_find_hit_containing_equally_good_hit) {
+	BOOST_CHECK_EQUAL( find_dominated( {
+		full_hit( { seq_seg{ 10, 19 } }, "match_a", 1.0 ),
+		full_hit( { seq_seg{  0, 29 } }, "match_b", 1.0 ),
+	} ).size(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE(finds_discontig_hit_with_segment_containing_better_hit) {
+	BOOST_CHECK_EQUAL_RANGES(
+		find_dominated( {
+			full_hit( { seq_seg{  0,  9 }, seq_seg{ 40, 69 } }, "match_a", 1.0 ),
+			full_hit( { seq_seg{ 50, 59 }                    }, "match_b", 2.0 ),
+		} ),
+		size_vec{ 0 }
+	);
+}
+
+BOOST_AUTO_TEST_CASE(does_not_use_discontig_hit_as_dominator) {
+	BOOST_CHECK_EQUAL( find_dominated( {
+		full_hit( { seq_seg{ 10, 19 }, seq_seg{ 30, 39 } }, "match_a", 2.0 ),
+		full_hit( { seq_seg{  0, 49 }                    }, "match_b", 1.0 ),
+	} ).size(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE(full_hit_prune_builder_prunes_dominated_hits_iff_pruning) {
+	const full_hit_vec the_hits{
+		full_hit( { seq_seg{ 10, 19 } }, "match_a", 2.0 ),
+		full_hit( { seq_seg{  0, 29 } }, "match_b", 1.0 ),
+		full_hit( { seq_seg{ 15, 40 } }, "match_c", 1.5 ),
+	};
+	for (const seg_dupl_hit_policy &policy : { seg_dupl_hit_policy::PRESERVE, seg_dupl_hit_policy::PRUNE } ) {
+		full_hit_prune_builder the_builder{ policy, make_neutral_score_spec(), make_no_action_crh_segment_spec(), crh_filter_spec{} };
+		for (const full_hit &the_hit : the_hits) {
+			the_builder.add_hit( the_hit );
+		}
+		const full_hit_list built_hits = the_builder.get_built_hits();
+		const bool prunes = ( policy == seg_dupl_hit_policy::PRUNE );
+		BOOST_CHECK_EQUAL( built_hits.size(), prunes ? 2 : 3 );
+		BOOST_CHECK_EQUAL( the_builder.get_num_dominated_pruned(), prunes ? 1 : 0 );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
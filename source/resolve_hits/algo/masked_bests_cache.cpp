@@ -0,0 +1,152 @@
+/// \file
+/// \brief The masked_bests_cache class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "masked_bests_cache.hpp"
+
+#include <boost/range/algorithm/equal.hpp>
+#include <boost/range/algorithm/sort.hpp>
+
+#include "common/exception/out_of_range_exception.hpp"
+#include "common/hash/hash_value_combine.hpp"
+
+#include <functional>
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::seq;
+
+using boost::range::sort;
+using std::hash;
+
+constexpr size_t masked_bests_cache::EMPTY_INDEX;
+constexpr size_t masked_bests_cache::INITIAL_TABLE_SIZE;
+
+/// \brief Build the signature of the regions unmasked by the specified mask up to the specified point
+///        in signature_buffer and return its hash
+size_t masked_bests_cache::build_signature(const calc_hit_vec &prm_mask_hits, ///< The mask that defines the unmasked regions
+                                           const seq_arrow    &prm_stop_arrow ///< The stop boundary at which the signature of unmasked regions should stop
+                                           ) {
+	mask_segs_buffer.clear();
+	for (const calc_hit &the_hit : prm_mask_hits) {
+		for (size_t seg_ctr = 0; seg_ctr < get_num_segments( the_hit ); ++seg_ctr) {
+			mask_segs_buffer.emplace_back(
+				get_start_arrow_of_segment( the_hit, seg_ctr ),
+				get_stop_arrow_of_segment ( the_hit, seg_ctr )
+			);
+		}
+	}
+	sort(
+		mask_segs_buffer,
+		[] (const seq_seg &x, const seq_seg &y) { return x.get_start_arrow() < y.get_start_arrow(); }
+	);
+
+	signature_buffer.clear();
+	size_t seed = 0;
+	detail::for_each_unmasked_region_before_arrow(
+		mask_segs_buffer,
+		prm_stop_arrow,
+		[&] (const seq_arrow &x, const seq_arrow &y) {
+			for (const resarw_t &index : { x.get_index(), y.get_index() } ) {
+				signature_buffer.push_back( index );
+				hash_value_combine( seed, hash<resarw_t>{}( index ) );
+			}
+		}
+	);
+	return seed;
+}
+
+/// \brief Whether the stored entry of the specified index has the signature in signature_buffer
+bool masked_bests_cache::signature_matches(const size_t &prm_index ///< The index of the stored entry to check
+                                           ) const {
+	return boost::range::equal(
+		boost::make_iterator_range(
+			std::next( common::cbegin( signatures ), static_cast<ptrdiff_t>( signature_offsets[ prm_index     ] ) ),
+			std::next( common::cbegin( signatures ), static_cast<ptrdiff_t>( signature_offsets[ prm_index + 1 ] ) )
+		),
+		signature_buffer
+	);
+}
+
+/// \brief Find the position in the table of the entry with the signature in signature_buffer
+///        (which has the specified hash) or, if there's no such entry, of the empty entry where it should go
+size_t masked_bests_cache::find_entry(const size_t &prm_hash ///< The hash of the signature in signature_buffer
+                                      ) const {
+	const size_t mask = table.size() - 1;
+	for (size_t table_ctr = ( prm_hash & mask ); ; table_ctr = ( ( table_ctr + 1 ) & mask ) ) {
+		const table_entry &the_entry = table[ table_ctr ];
+		if ( the_entry.index == EMPTY_INDEX || ( the_entry.hash == prm_hash && signature_matches( the_entry.index ) ) ) {
+			return table_ctr;
+		}
+	}
+}
+
+/// \brief Double the size of the table and re-insert all the entries (using their stored hashes)
+void masked_bests_cache::grow_table() {
+	std::vector<table_entry> old_table( table.size() * 2, table_entry{ 0, EMPTY_INDEX } );
+	table.swap( old_table );
+	const size_t mask = table.size() - 1;
+	for (const table_entry &the_entry : old_table) {
+		if ( the_entry.index != EMPTY_INDEX ) {
+			size_t table_ctr = ( the_entry.hash & mask );
+			while ( table[ table_ctr ].index != EMPTY_INDEX ) {
+				table_ctr = ( ( table_ctr + 1 ) & mask );
+			}
+			table[ table_ctr ] = the_entry;
+		}
+	}
+}
+
+/// \brief Get the optimum architecture (scored_arch_proxy) for the signature of regions unmasked by the specified mask up to the specified point
+///
+/// This returns a copy because the architectures are stored in a vector that a later store may reallocate
+///
+/// \pre An architecture must have been stored for the signature, else an out_of_range_exception will be thrown
+scored_arch_proxy masked_bests_cache::get_best_for_masks_up_to_arrow(const calc_hit_vec &prm_mask_hits, ///< The mask that defines the unmasked regions for which the architecture is optimal
+                                                                     const seq_arrow    &prm_stop_arrow ///< The stop boundary at which the signature of unmasked regions should stop
+                                                                     ) {
+	const size_t       the_hash  = build_signature( prm_mask_hits, prm_stop_arrow );
+	const table_entry &the_entry = table[ find_entry( the_hash ) ];
+	if ( the_entry.index == EMPTY_INDEX ) {
+		BOOST_THROW_EXCEPTION(out_of_range_exception("No best architecture has been stored in the masked_bests_cache for the requested unmasked regions"));
+	}
+	return bests[ the_entry.index ];
+}
+
+/// \brief Store the optimum architecture for the signature of regions unmasked by the specified mask up to the specified point
+///
+/// If an architecture has already been stored for the signature, this leaves it unchanged
+void masked_bests_cache::store_best_for_masks_up_to_arrow(const calc_hit_vec      &prm_mask_hits,              ///< The mask that defines the unmasked regions for which the architecture is optimal
+                                                          const seq_arrow         &prm_stop_arrow,             ///< The stop boundary at which the signature of unmasked regions should stop
+                                                          const scored_arch_proxy &prm_best_scored_arch_proxy  ///< The optimum architecture (scored_arch_proxy) to store
+                                                          ) {
+	// Keep the load factor at or below a half
+	if ( 2 * ( bests.size() + 1 ) > table.size() ) {
+		grow_table();
+	}
+
+	const size_t  the_hash  = build_signature( prm_mask_hits, prm_stop_arrow );
+	table_entry  &the_entry = table[ find_entry( the_hash ) ];
+	if ( the_entry.index == EMPTY_INDEX ) {
+		the_entry = table_entry{ the_hash, bests.size() };
+		signatures.insert( common::cend( signatures ), common::cbegin( signature_buffer ), common::cend( signature_buffer ) );
+		signature_offsets.push_back( signatures.size() );
+		bests.push_back( prm_best_scored_arch_proxy );
+	}
+}
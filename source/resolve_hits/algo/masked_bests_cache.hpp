@@ -21,55 +21,34 @@
 #ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_ALGO_MASKED_BESTS_CACHE_HPP
 #define _CATH_TOOLS_SOURCE_RESOLVE_HITS_ALGO_MASKED_BESTS_CACHE_HPP
 
-#include "common/hash/hash_value_combine.hpp"
 #include "resolve_hits/algo/scored_arch_proxy.hpp"
 #include "resolve_hits/calc_hit.hpp"
 #include "seq/seq_seg.hpp"
 
-#include <unordered_map>
+#include <limits>
+#include <vector>
 
 namespace cath {
 	namespace rslv {
 		namespace detail {
 
-			/// \brief Provide function operator that hashes seq_seg_vec so that they can be used as
-			///        keys in an unordered map
-			struct seq_seg_vec_hasher final {
-
-				/// \brief Hash function for seq_seg_vec
-				size_t operator()(const seq::seq_seg_vec &prm_seq_seg_vec ///< The seq_seg_vec to hash
-				                  ) const {
-					size_t seed = 0;
-					for (const seq::seq_seg &the_hit : prm_seq_seg_vec) {
-						for (const auto &index : { the_hit.get_start_arrow().get_index(),
-						                           the_hit.get_stop_arrow ().get_index(), } ) {
-							using index_type = std::decay_t< decltype( index ) >;
-							common::hash_value_combine( seed, std::hash< index_type >{}( index ) );
-						}
-					}
-					return seed;
-				}
-			};
-
-			/// \brief Build a list of the regions between zero and the specified arrow
-			///        that aren't masked by the specified hits.
+			/// \brief Call the specified function with the start and stop arrows of each of the regions
+			///        between zero and the specified arrow that aren't masked by the specified segments
 			///
-			/// \brief The specified hits must be non-overlapping.
+			/// \pre The specified segments must be non-overlapping and sorted by their starts
 			///
 			/// Note: this excludes any zero-length regions left by the mask, which means that
-			///       it can give identical results for different hit_vecs
-			inline seq::seq_seg_vec get_unmasked_regions_before_arrow(const calc_hit_vec   &prm_hits, ///< The hits defining the mask. These must be non-overlapping but may be unsorted.
-			                                                          const seq::seq_arrow &prm_arrow ///< The point at which to stop
-			                                                          ) {
-				// Get a sorted copy of prm_hits's segments
-				const auto seq_segs = get_start_sorted_seq_segs( prm_hits );
-
-				// Prepare the working data: a seq_seg_vec to populate and a seq_arrow at the end of the most-recently-handled seq_seg
-				seq::seq_seg_vec results;
+			///       it can give identical results for different masks
+			template <typename FN>
+			void for_each_unmasked_region_before_arrow(const seq::seq_seg_vec &prm_sorted_segs, ///< The start-sorted, non-overlapping segments defining the mask
+			                                           const seq::seq_arrow   &prm_arrow,       ///< The point at which to stop
+			                                           FN                    &&prm_fn           ///< The function to call with the start and stop arrows of each unmasked region
+			                                           ) {
+				// Prepare the working data: a seq_arrow at the end of the most-recently-handled seq_seg
 				auto prev_stop = seq::start_arrow();
 
 				// Loop over the mask segments
-				for (const seq::seq_seg &the_seq_seg : seq_segs) {
+				for (const seq::seq_seg &the_seq_seg : prm_sorted_segs) {
 
 					// If this mask segment starts after the stop arrow, then break out of the loop
 					if ( the_seq_seg.get_start_arrow() >= prm_arrow ) {
@@ -77,7 +56,7 @@ namespace cath {
 					}
 					// Else if this mask segment starts *strictly* after the previous stop, add a record for the gap
 					if ( the_seq_seg.get_start_arrow() >  prev_stop ) {
-						results.emplace_back( prev_stop, the_seq_seg.get_start_arrow() );
+						prm_fn( prev_stop, the_seq_seg.get_start_arrow() );
 					}
 					// Update the prev_stop to this segment's stop
 					prev_stop = the_seq_seg.get_stop_arrow();
@@ -86,52 +65,105 @@ namespace cath {
 				// If the stop point is *strictly* after the previously handled segment's stop, add a record for the gap
 				// (this happens in all cases except those where there is a mask segment stopping-at or straddling prm_arrow)
 				if ( prm_arrow > prev_stop ) {
-					results.emplace_back( prev_stop, prm_arrow );
+					prm_fn( prev_stop, prm_arrow );
 				}
+			}
 
+			/// \brief Build a list of the regions between zero and the specified arrow
+			///        that aren't masked by the specified hits.
+			///
+			/// \brief The specified hits must be non-overlapping.
+			///
+			/// Note: this excludes any zero-length regions left by the mask, which means that
+			///       it can give identical results for different hit_vecs
+			inline seq::seq_seg_vec get_unmasked_regions_before_arrow(const calc_hit_vec   &prm_hits, ///< The hits defining the mask. These must be non-overlapping but may be unsorted.
+			                                                          const seq::seq_arrow &prm_arrow ///< The point at which to stop
+			                                                          ) {
+				seq::seq_seg_vec results;
+				for_each_unmasked_region_before_arrow(
+					get_start_sorted_seq_segs( prm_hits ),
+					prm_arrow,
+					[&] (const seq::seq_arrow &x, const seq::seq_arrow &y) { results.emplace_back( x, y ); }
+				);
 				return results;
 			}
 		} // namespace detail
 
 		/// \brief Store the best scored_arch_proxy for a given unmasked pattern
+		///
+		/// Each pattern of unmasked regions is stored as a packed signature of the regions'
+		/// start/stop arrow indices, hashed once and stored back-to-back in a single buffer.
+		/// The entries are looked up in a flat, open-addressing (linear-probing) table.
+		///
+		/// The signature for a lookup is built in a buffer that's reused across calls so
+		/// that querying the cache doesn't cause any heap traffic once it's warmed up.
 		class masked_bests_cache final {
 		private:
-			/// \brief The unordered map (ie hash-map to store the optimal architecture (scored_arch_proxy) for a given set of unmasked regions (seq_seg_vec))
-			std::unordered_map<seq::seq_seg_vec, scored_arch_proxy, detail::seq_seg_vec_hasher> store;
+			/// \brief Type alias for the type in which a signature is stored
+			using signature_vec = std::vector<seq::resarw_t>;
+
+			/// \brief An entry in the open-addressing table
+			struct table_entry final {
+				/// \brief The hash of the entry's signature
+				size_t hash;
+
+				/// \brief The index of the entry's signature and architecture, or EMPTY_INDEX if the entry is empty
+				size_t index;
+			};
+
+			/// \brief The index value that marks an empty table entry
+			static constexpr size_t EMPTY_INDEX = std::numeric_limits<size_t>::max();
+
+			/// \brief The initial number of entries in the table (must be a power of two)
+			static constexpr size_t INITIAL_TABLE_SIZE = 64;
+
+			/// \brief The open-addressing table of entries, the size of which is always a power of two
+			std::vector<table_entry> table = std::vector<table_entry>( INITIAL_TABLE_SIZE, table_entry{ 0, EMPTY_INDEX } );
+
+			/// \brief The signatures of all stored entries, back-to-back
+			signature_vec signatures;
+
+			/// \brief The offset of each stored entry's signature in signatures (with an extra end offset)
+			size_vec signature_offsets = size_vec( 1, 0 );
+
+			/// \brief The optimum architecture (scored_arch_proxy) for each stored entry
+			std::vector<scored_arch_proxy> bests;
+
+			/// \brief A reusable buffer for the sorted segments of a mask
+			seq::seq_seg_vec mask_segs_buffer;
+
+			/// \brief A reusable buffer for the signature being looked up or stored
+			signature_vec signature_buffer;
+
+			size_t build_signature(const calc_hit_vec &,
+			                       const seq::seq_arrow &);
+			bool signature_matches(const size_t &) const;
+			size_t find_entry(const size_t &) const;
+			void grow_table();
 
 		public:
-			const scored_arch_proxy & get_best_for_unmasked(const seq::seq_seg_vec &) const;
-			void store_best_for_unmasked(seq::seq_seg_vec &&,
-			                             const scored_arch_proxy &);
+			scored_arch_proxy get_best_for_masks_up_to_arrow(const calc_hit_vec &,
+			                                                 const seq::seq_arrow &);
+			void store_best_for_masks_up_to_arrow(const calc_hit_vec &,
+			                                      const seq::seq_arrow &,
+			                                      const scored_arch_proxy &);
+			size_t size() const;
 		};
 
-		/// \brief Get the optimum architecture (scored_arch_proxy) for the specified signature of unmasked regions
-		inline const scored_arch_proxy & masked_bests_cache::get_best_for_unmasked(const seq::seq_seg_vec &prm_unmasked ///< The set of unmasked regions for which the optimum architecture is required
-		                                                                           ) const {
-			return store.at( prm_unmasked );
-		}
-
-		/// \brief Store the optimum architecture for a signature of unmasked regions
-		inline void masked_bests_cache::store_best_for_unmasked(seq::seq_seg_vec        &&prm_unmasked,              ///< The set of unmasked regions for which the optimum architecture is to be stored
-		                                                        const scored_arch_proxy  &prm_best_scored_arch_proxy ///< The optimum architecture (scored_arch_proxy) to store
-		                                                        ) {
-			store.emplace(
-				std::move( prm_unmasked ),
-				prm_best_scored_arch_proxy
-			);
+		/// \brief Get the number of architectures stored in the cache
+		inline size_t masked_bests_cache::size() const {
+			return bests.size();
 		}
 
 		/// \brief Get the optimum architecture (scored_arch_proxy) from the specified masked_bests_cache
 		///        for the signature of regions unmasked by the specified mask up to the specified point
 		///
 		/// \relates masked_bests_cache
-		inline const scored_arch_proxy & get_best_for_masks_up_to_arrow(const masked_bests_cache &prm_masked_bests_cache, ///< The masked_bests_cache to query
-		                                                                const calc_hit_vec       &prm_mask_hits,          ///< The mask that defines the unmasked regions for which the architecture is optimal
-		                                                                const seq::seq_arrow     &prm_stop_arrow          ///< The stop boundary at which the signature of unmasked regions should stop
-		                                                                ) {
-			return prm_masked_bests_cache.get_best_for_unmasked(
-				detail::get_unmasked_regions_before_arrow( prm_mask_hits, prm_stop_arrow )
-			);
+		inline scored_arch_proxy get_best_for_masks_up_to_arrow(masked_bests_cache   &prm_masked_bests_cache, ///< The masked_bests_cache to query
+		                                                        const calc_hit_vec   &prm_mask_hits,          ///< The mask that defines the unmasked regions for which the architecture is optimal
+		                                                        const seq::seq_arrow &prm_stop_arrow          ///< The stop boundary at which the signature of unmasked regions should stop
+		                                                        ) {
+			return prm_masked_bests_cache.get_best_for_masks_up_to_arrow( prm_mask_hits, prm_stop_arrow );
 		}
 
 		/// \brief Store the optimum architecture (scored_arch_proxy) in the specified masked_bests_cache
@@ -146,10 +178,7 @@ namespace cath {
 		                                             const calc_hit_vec      &prm_mask_hits,              ///< The mask that defines the unmasked regions for which the architecture is optimal
 		                                             const seq::seq_arrow    &prm_stop_arrow              ///< The stop boundary at which the signature of unmasked regions should stop
 		                                             ) {
-			prm_masked_bests_cache.store_best_for_unmasked(
-				detail::get_unmasked_regions_before_arrow( prm_mask_hits, prm_stop_arrow ),
-				prm_best_scored_arch_proxy
-			);
+			prm_masked_bests_cache.store_best_for_masks_up_to_arrow( prm_mask_hits, prm_stop_arrow, prm_best_scored_arch_proxy );
 		}
 
 	} // namespace rslv
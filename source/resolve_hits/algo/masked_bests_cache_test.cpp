@@ -19,8 +19,10 @@
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <boost/lexical_cast.hpp>
+#include <boost/range/irange.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "common/exception/out_of_range_exception.hpp"
 #include "resolve_hits/algo/discont_hits_index_by_start.hpp"
 #include "resolve_hits/algo/masked_bests_cache.hpp"
 #include "resolve_hits/algo/masked_bests_cacher.hpp"
@@ -78,4 +80,46 @@ BOOST_AUTO_TEST_CASE(get_arrows_before_starts_of_doms_right_interspersed_with_al
 	);
 }
 
+BOOST_AUTO_TEST_CASE(cache_retrieves_best_for_masks_with_same_unmasked_regions) {
+	masked_bests_cache the_cache;
+	store_best_for_masks_up_to_arrow(
+		the_cache,
+		add_hit_copy( scored_arch_proxy{}, 3.0, 7 ),
+		calc_hit_vec{ calc_hit{ arrow_before_res( 10 ), arrow_before_res( 20 ), 1.0, 0 } },
+		arrow_before_res( 30 )
+	);
+	store_best_for_masks_up_to_arrow(
+		the_cache,
+		add_hit_copy( scored_arch_proxy{}, 5.0, 8 ),
+		calc_hit_vec{ calc_hit{ arrow_before_res( 10 ), arrow_before_res( 25 ), 1.0, 1 } },
+		arrow_before_res( 30 )
+	);
+	BOOST_CHECK_EQUAL( the_cache.size(), 2 );
+
+	// A different mask with the same unmasked regions before the arrow gets the same result
+	const auto best = get_best_for_masks_up_to_arrow(
+		the_cache,
+		calc_hit_vec{ calc_hit( { seq_seg{ 10, 19 }, seq_seg{ 30, 39 } }, 1.0, 2 ) },
+		arrow_before_res( 30 )
+	);
+	BOOST_CHECK_EQUAL( best.get_score(), 3.0 );
+	BOOST_CHECK_EQUAL( best[ 0 ], 7 );
+
+	BOOST_CHECK_THROW(
+		get_best_for_masks_up_to_arrow( the_cache, calc_hit_vec{}, arrow_before_res( 30 ) ),
+		out_of_range_exception
+	);
+}
+
+BOOST_AUTO_TEST_CASE(cache_grows_to_store_many_bests) {
+	masked_bests_cache the_cache;
+	for (const residx_t &stop : boost::irange( 1U, 1000U ) ) {
+		store_best_for_masks_up_to_arrow( the_cache, add_hit_copy( scored_arch_proxy{}, 1.0, stop ), calc_hit_vec{}, arrow_before_res( stop ) );
+	}
+	BOOST_CHECK_EQUAL( the_cache.size(), 999 );
+	for (const residx_t &stop : boost::irange( 1U, 1000U ) ) {
+		BOOST_CHECK_EQUAL( get_best_for_masks_up_to_arrow( the_cache, calc_hit_vec{}, arrow_before_res( stop ) )[ 0 ], stop );
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,322 @@
+/// \file
+/// \brief The crh_benchmark definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "crh_benchmark.hpp"
+
+#include "common/boost_addenda/range/indices.hpp"
+#include "common/chrono/duration_to_seconds_string.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
+#include "common/rapidjson_addenda/rapidjson_writer.hpp"
+#include "resolve_hits/benchmark/synthetic_hits_generator.hpp"
+#include "resolve_hits/benchmark/synthetic_hits_spec.hpp"
+#include "resolve_hits/calc_hit_list.hpp"
+#include "resolve_hits/cath_hit_resolver.hpp"
+#include "resolve_hits/file/parse_domain_hits_table.hpp"
+#include "resolve_hits/options/spec/crh_filter_spec.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/gather_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/summarise_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_html_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_json_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_results_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/read_and_process_mgr.hpp"
+#include "resolve_hits/resolve/hit_resolver.hpp"
+#include "resolve_hits/scored_hit_arch.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <sstream>
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::opts;
+using namespace cath::rslv;
+using namespace cath::rslv::detail;
+
+using std::chrono::high_resolution_clock;
+using std::function;
+using std::istringstream;
+using std::ostream;
+using std::ostringstream;
+using std::string;
+
+/// \brief Ctor from all the metrics
+crh_stage_metrics::crh_stage_metrics(string              prm_name,                ///< The name of the stage
+                                     const size_t       &prm_num_hits,            ///< The number of hits processed in one run of the stage
+                                     const hrc_duration &prm_best_durn,           ///< The fastest duration over the repeated runs of the stage
+                                     const size_t       &prm_num_allocs,          ///< The number of heap allocations made in one run of the stage
+                                     const size_t       &prm_process_peak_rss_kib ///< The process's peak resident set size so far (in KiB), read after the stage
+                                     ) : name                 { std::move( prm_name )    },
+                                         num_hits             { prm_num_hits             },
+                                         best_durn            { prm_best_durn            },
+                                         num_allocs           { prm_num_allocs           },
+                                         process_peak_rss_kib { prm_process_peak_rss_kib } {
+}
+
+/// \brief Getter for the name of the stage
+const string & crh_stage_metrics::get_name() const {
+	return name;
+}
+
+/// \brief Getter for the number of hits processed in one run of the stage
+const size_t & crh_stage_metrics::get_num_hits() const {
+	return num_hits;
+}
+
+/// \brief Getter for the fastest duration over the repeated runs of the stage
+const hrc_duration & crh_stage_metrics::get_best_durn() const {
+	return best_durn;
+}
+
+/// \brief Getter for the number of heap allocations made in one run of the stage
+const size_t & crh_stage_metrics::get_num_allocs() const {
+	return num_allocs;
+}
+
+/// \brief Getter for the process's peak resident set size so far (in KiB), read after the stage
+const size_t & crh_stage_metrics::get_process_peak_rss_kib() const {
+	return process_peak_rss_kib;
+}
+
+/// \brief Get the throughput of the specified stage in hits per second (based on its fastest run)
+///
+/// \relates crh_stage_metrics
+double cath::rslv::get_hits_per_second(const crh_stage_metrics &prm_metrics ///< The crh_stage_metrics to query
+                                       ) {
+	const double seconds = durn_to_seconds_double( prm_metrics.get_best_durn() );
+	return ( seconds > 0.0 ) ? ( static_cast<double>( prm_metrics.get_num_hits() ) / seconds )
+	                         : 0.0;
+}
+
+/// \brief Get the peak resident set size of this process so far (in KiB)
+size_t cath::rslv::get_process_peak_rss_kib() {
+	rusage usage;
+	if ( getrusage( RUSAGE_SELF, &usage ) != 0 ) {
+		return 0;
+	}
+#ifdef __APPLE__
+	// macOS reports ru_maxrss in bytes rather than KiB
+	return static_cast<size_t>( usage.ru_maxrss ) / 1024;
+#else
+	return static_cast<size_t>( usage.ru_maxrss );
+#endif
+}
+
+/// \brief Run the specified stage the specified number of times and return the resulting metrics
+///
+/// The allocations are counted over the final run, by which time any one-off allocations
+/// (eg of labels into the global hit_label_table) will have been made
+static crh_stage_metrics measure_stage(const string                  &prm_name,        ///< The name of the stage
+                                       const size_t                  &prm_num_hits,    ///< The number of hits processed in one run of the stage
+                                       const size_t                  &prm_num_repeats, ///< The number of times to run the stage
+                                       const alloc_count_fn          &prm_alloc_count, ///< A function returning the number of heap allocations made so far
+                                       const function<void(size_t)>  &prm_prepare_fn,  ///< A function to prepare (untimed) for the specified repeat of the stage
+                                       const function<void()>        &prm_stage_fn     ///< A function to run the stage
+                                       ) {
+	hrc_duration best_durn  = hrc_duration::max();
+	size_t       num_allocs = 0;
+	for (const size_t &repeat_ctr : indices( prm_num_repeats ) ) {
+		prm_prepare_fn( repeat_ctr );
+		const size_t allocs_before = prm_alloc_count();
+		const auto   start_time    = high_resolution_clock::now();
+		prm_stage_fn();
+		const auto   durn          = high_resolution_clock::now() - start_time;
+		num_allocs = prm_alloc_count() - allocs_before;
+		best_durn  = std::min( best_durn, durn );
+	}
+	return { prm_name, prm_num_hits, best_durn, num_allocs, get_process_peak_rss_kib() };
+}
+
+/// \brief Run a benchmark of the stages of cath-resolve-hits on synthetic hits described by the specified
+///        synthetic_hits_spec, running each stage the specified number of times
+///
+/// The stages are:
+///  * `parse_raw_with_scores`  : parsing raw_with_scores text through read_and_process_mgr (including building the calc_hit_lists)
+///  * `parse_hmmer_domtblout`  : parsing HMMER domtblout text through read_and_process_mgr (including building the calc_hit_lists)
+///  * `build_calc_hit_lists`   : building calc_hit_lists from full_hit_lists
+///  * `resolve`                : resolving each calc_hit_list (ie the core dynamic-programming algorithm)
+///  * `process_write_results`  : the write_results_hits_processor (including its resolving)
+///  * `process_write_json`     : the write_json_hits_processor (including its resolving)
+///  * `process_write_html`     : the write_html_hits_processor (including its resolving)
+///  * `process_summarise`      : the summarise_hits_processor
+///  * `end_to_end`             : a complete perform_resolve_hits() run on the raw_with_scores text
+crh_stage_metrics_vec cath::rslv::run_crh_benchmark(const synthetic_hits_spec &prm_spec,        ///< The synthetic_hits_spec describing the hits to benchmark
+                                                    const size_t              &prm_num_repeats, ///< The number of times to run each stage (of which the fastest is reported)
+                                                    const alloc_count_fn      &prm_alloc_count  ///< A function returning the number of heap allocations made so far
+                                                    ) {
+	if ( prm_num_repeats == 0 ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot benchmark cath-resolve-hits with zero repeats"));
+	}
+
+	const size_t            num_hits       = get_total_num_hits( prm_spec );
+	const full_hit_list_vec full_hit_lists = make_synthetic_full_hit_lists( prm_spec );
+	const string            raw_string     = synthetic_raw_hits_string      ( full_hit_lists                          );
+	const string            domtbl_string  = synthetic_domtblout_hits_string( full_hit_lists, prm_spec.get_seq_length() );
+
+	const crh_score_spec    score_spec;
+	const crh_segment_spec  segment_spec;
+	const crh_filter_spec   filter_spec = make_accept_all_filter_spec();
+
+	const auto no_prepare_fn = [] (const size_t &) {};
+
+	crh_stage_metrics_vec results;
+
+	// Parsing stages, which gather the resulting calc_hit_lists so that they can be reused below
+	str_calc_hit_list_pair_vec gathered_hit_lists;
+	const auto parse_stage_fn = [&] (const string &prm_input_string, const auto &prm_parse_fn) {
+		return [&, prm_parse_fn] {
+			istringstream input_ss{ prm_input_string };
+			gathered_hit_lists.clear();
+			hits_processor_list the_processors{ score_spec, segment_spec };
+			the_processors.add_processor( gather_hits_processor{ gathered_hit_lists } );
+			read_and_process_mgr the_read_and_process_mgr{ the_processors, filter_spec };
+			prm_parse_fn( the_read_and_process_mgr, input_ss );
+		};
+	};
+	results.push_back( measure_stage(
+		"parse_raw_with_scores", num_hits, prm_num_repeats, prm_alloc_count, no_prepare_fn,
+		parse_stage_fn( raw_string, [] (read_and_process_mgr &x, istringstream &y) {
+			read_hit_list_from_istream( x, y, hit_score_type::CRH_SCORE );
+		} )
+	) );
+	results.push_back( measure_stage(
+		"parse_hmmer_domtblout", num_hits, prm_num_repeats, prm_alloc_count, no_prepare_fn,
+		parse_stage_fn( domtbl_string, [] (read_and_process_mgr &x, istringstream &y) {
+			parse_domain_hits_table( x, y, false );
+		} )
+	) );
+
+	// Build the calc_hit_lists from copies of the full_hit_lists
+	full_hit_list_vec          full_hit_list_copies;
+	std::vector<calc_hit_list> calc_hit_lists;
+	results.push_back( measure_stage(
+		"build_calc_hit_lists", num_hits, prm_num_repeats, prm_alloc_count,
+		[&] (const size_t &) {
+			calc_hit_lists.clear();
+			full_hit_list_copies = full_hit_lists;
+		},
+		[&] {
+			for (full_hit_list &the_full_hits : full_hit_list_copies) {
+				calc_hit_lists.emplace_back( std::move( the_full_hits ), score_spec, segment_spec, filter_spec );
+			}
+		}
+	) );
+	full_hit_list_copies.clear();
+
+	// Resolve each of the calc_hit_lists
+	results.push_back( measure_stage(
+		"resolve", num_hits, prm_num_repeats, prm_alloc_count, no_prepare_fn,
+		[&] {
+			for (const calc_hit_list &the_calc_hits : calc_hit_lists) {
+				const scored_hit_arch the_arch = resolve_hits( the_calc_hits, false );
+			}
+		}
+	) );
+
+	// Run each of the hits_processors over the calc_hit_lists
+	ostringstream output_ss;
+	const ref_vec<ostream> output_refs{ std::ref<ostream>( output_ss ) };
+	const auto processor_stage_fn = [&] (const hits_processor &prm_processor) {
+		return [&] {
+			const hits_processor_uptr the_processor_ptr = prm_processor.clone();
+			for (const size_t &query_ctr : indices( calc_hit_lists.size() ) ) {
+				the_processor_ptr->process_hits_for_query(
+					synthetic_query_id( query_ctr ),
+					filter_spec,
+					score_spec,
+					segment_spec,
+					calc_hit_lists[ query_ctr ]
+				);
+			}
+			the_processor_ptr->finish_work();
+		};
+	};
+	const auto clear_output_fn = [&] (const size_t &) {
+		output_ss.str( "" );
+	};
+	const write_results_hits_processor results_processor { output_refs };
+	const write_json_hits_processor    json_processor    { output_refs };
+	const write_html_hits_processor    html_processor    { output_refs };
+	const summarise_hits_processor     summarise_processor{ output_refs };
+	results.push_back( measure_stage( "process_write_results", num_hits, prm_num_repeats, prm_alloc_count, clear_output_fn, processor_stage_fn( results_processor   ) ) );
+	results.push_back( measure_stage( "process_write_json",    num_hits, prm_num_repeats, prm_alloc_count, clear_output_fn, processor_stage_fn( json_processor      ) ) );
+	results.push_back( measure_stage( "process_write_html",    num_hits, prm_num_repeats, prm_alloc_count, clear_output_fn, processor_stage_fn( html_processor      ) ) );
+	results.push_back( measure_stage( "process_summarise",     num_hits, prm_num_repeats, prm_alloc_count, clear_output_fn, processor_stage_fn( summarise_processor ) ) );
+	calc_hit_lists.clear();
+
+	// Run the whole of cath-resolve-hits on the raw_with_scores text
+	results.push_back( measure_stage(
+		"end_to_end", num_hits, prm_num_repeats, prm_alloc_count, clear_output_fn,
+		[&] {
+			istringstream input_ss{ raw_string };
+			perform_resolve_hits(
+				{ "cath-resolve-hits", "--input-format", "raw_with_scores", "-" },
+				input_ss,
+				output_ss,
+				parse_sources::CMND_LINE_ONLY
+			);
+		}
+	) );
+
+	return results;
+}
+
+/// \brief Generate a JSON string describing the specified benchmark results
+///        (as produced by run_crh_benchmark() from the specified synthetic_hits_spec and number of repeats)
+///
+/// \relates crh_stage_metrics
+string cath::rslv::crh_benchmark_json_string(const synthetic_hits_spec   &prm_spec,        ///< The synthetic_hits_spec describing the hits that were benchmarked
+                                             const size_t                &prm_num_repeats, ///< The number of times each stage was run
+                                             const crh_stage_metrics_vec &prm_metrics      ///< The metrics from the benchmark
+                                             ) {
+	rapidjson_writer<> json_writer;
+	json_writer.start_object();
+
+	json_writer.write_key( "spec" );
+	json_writer.start_object();
+	json_writer.write_key_value( "num_queries",      uint64_t{ prm_spec.get_num_queries() } );
+	json_writer.write_key_value( "seq_length",       prm_spec.get_seq_length()               );
+	json_writer.write_key_value( "num_hits",         uint64_t{ prm_spec.get_num_hits() }    );
+	json_writer.write_key_value( "overlap_density",  prm_spec.get_overlap_density()          );
+	json_writer.write_key_value( "discont_fraction", prm_spec.get_discont_fraction()         );
+	json_writer.write_key_value( "score_distn",      to_string( prm_spec.get_score_distn() ) );
+	json_writer.write_key_value( "seed",             uint64_t{ prm_spec.get_seed() }        );
+	json_writer.write_key_value( "num_repeats",      uint64_t{ prm_num_repeats }            );
+	json_writer.end_object();
+
+	json_writer.write_key( "stages" );
+	json_writer.start_array();
+	for (const crh_stage_metrics &stage_metrics : prm_metrics) {
+		json_writer.start_object();
+		json_writer.write_key_value( "name",                 stage_metrics.get_name()                                );
+		json_writer.write_key_value( "num_hits",             uint64_t{ stage_metrics.get_num_hits() }                );
+		json_writer.write_key_value( "best_seconds",         durn_to_seconds_double( stage_metrics.get_best_durn() ) );
+		json_writer.write_key_value( "hits_per_second",      get_hits_per_second( stage_metrics )                    );
+		json_writer.write_key_value( "num_allocs",           uint64_t{ stage_metrics.get_num_allocs() }              );
+		json_writer.write_key_value( "process_peak_rss_kib", uint64_t{ stage_metrics.get_process_peak_rss_kib() }    );
+		json_writer.end_object();
+	}
+	json_writer.end_array();
+
+	json_writer.end_object();
+	return json_writer.get_cpp_string();
+}
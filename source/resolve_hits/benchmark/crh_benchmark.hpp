@@ -0,0 +1,94 @@
+/// \file
+/// \brief The crh_benchmark header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_BENCHMARK_CRH_BENCHMARK_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_BENCHMARK_CRH_BENCHMARK_HPP
+
+#include "common/chrono/chrono_type_aliases.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cath { namespace rslv { class synthetic_hits_spec; } }
+
+namespace cath {
+	namespace rslv {
+
+		/// \brief Type alias for a function that returns the number of heap allocations made so far
+		///
+		/// Counting allocations requires replacing the global operator new, which should only be done
+		/// in an executable, so the executable passes in one of these to read its count
+		using alloc_count_fn = std::function<size_t()>;
+
+		/// \brief The metrics from benchmarking one stage of cath-resolve-hits
+		class crh_stage_metrics final {
+		private:
+			/// \brief The name of the stage
+			std::string  name;
+
+			/// \brief The number of hits processed in one run of the stage
+			size_t       num_hits;
+
+			/// \brief The fastest duration over the repeated runs of the stage
+			hrc_duration best_durn;
+
+			/// \brief The number of heap allocations made in one run of the stage
+			size_t       num_allocs;
+
+			/// \brief The process's peak resident set size so far (in KiB), read after the stage
+			///
+			/// The peak is a high-water mark over the life of the process so it only shows
+			/// a stage's memory use if that stage uses more than all the stages before it
+			size_t       process_peak_rss_kib;
+
+		public:
+			crh_stage_metrics(std::string,
+			                  const size_t &,
+			                  const hrc_duration &,
+			                  const size_t &,
+			                  const size_t &);
+
+			const std::string & get_name() const;
+			const size_t & get_num_hits() const;
+			const hrc_duration & get_best_durn() const;
+			const size_t & get_num_allocs() const;
+			const size_t & get_process_peak_rss_kib() const;
+		};
+
+		/// \brief Type alias for a vector of crh_stage_metrics
+		using crh_stage_metrics_vec = std::vector<crh_stage_metrics>;
+
+		double get_hits_per_second(const crh_stage_metrics &);
+
+		size_t get_process_peak_rss_kib();
+
+		crh_stage_metrics_vec run_crh_benchmark(const synthetic_hits_spec &,
+		                                        const size_t &,
+		                                        const alloc_count_fn &);
+
+		std::string crh_benchmark_json_string(const synthetic_hits_spec &,
+		                                      const size_t &,
+		                                      const crh_stage_metrics_vec &);
+
+	} // namespace rslv
+} // namespace cath
+
+#endif
@@ -0,0 +1,207 @@
+/// \file
+/// \brief The synthetic_hits_generator definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "synthetic_hits_generator.hpp"
+
+#include <boost/core/ignore_unused.hpp>
+
+#include "common/boost_addenda/range/indices.hpp"
+#include "resolve_hits/benchmark/synthetic_hits_spec.hpp"
+#include "resolve_hits/full_hit.hpp"
+#include "seq/seq_seg.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <sstream>
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::seq;
+
+using boost::ignore_unused;
+using std::bernoulli_distribution;
+using std::exponential_distribution;
+using std::llround;
+using std::max;
+using std::min;
+using std::mt19937;
+using std::ostream;
+using std::ostringstream;
+using std::string;
+using std::uniform_int_distribution;
+using std::uniform_real_distribution;
+
+/// \brief The mean of the exponential score distribution (above its minimum)
+static constexpr double SYNTHETIC_EXPONENTIAL_SCORE_MEAN = 20.0;
+
+/// \brief The maximum of the uniform score distribution
+static constexpr double SYNTHETIC_UNIFORM_SCORE_MAX      = 100.0;
+
+/// \brief The minimum synthetic score, which keeps all scores positive
+static constexpr double SYNTHETIC_MIN_SCORE              = 0.1;
+
+/// \brief Draw a random score from the specified distribution
+///
+/// The score is rounded to one decimal place so that it survives being written
+/// to text and parsed back unchanged
+static double random_synthetic_score(const synthetic_score_distn &prm_score_distn, ///< The distribution from which the score should be drawn
+                                     mt19937                     &prm_rng          ///< The random number generator to use
+                                     ) {
+	const double raw_score = ( prm_score_distn == synthetic_score_distn::UNIFORM )
+		? uniform_real_distribution<double>{ SYNTHETIC_MIN_SCORE, SYNTHETIC_UNIFORM_SCORE_MAX }( prm_rng )
+		: SYNTHETIC_MIN_SCORE + exponential_distribution<double>{ 1.0 / SYNTHETIC_EXPONENTIAL_SCORE_MEAN }( prm_rng );
+	return max( SYNTHETIC_MIN_SCORE, static_cast<double>( llround( raw_score * 10.0 ) ) / 10.0 );
+}
+
+/// \brief Get the query ID to use for the synthetic query with the specified index
+string cath::rslv::synthetic_query_id(const size_t &prm_query_index ///< The index of the query
+                                      ) {
+	return "synth_query_" + ::std::to_string( prm_query_index );
+}
+
+/// \brief Make a full_hit_list of synthetic hits for a single query, as described by the specified synthetic_hits_spec,
+///        using the specified random number generator
+///
+/// Each hit's length is drawn uniformly from within 50% of the spec's mean hit length.
+/// A discontinuous hit splits that length into two segments separated by a gap
+/// of up to the hit's length (or is left contiguous if that wouldn't fit in the sequence).
+full_hit_list cath::rslv::make_synthetic_full_hit_list(const synthetic_hits_spec &prm_spec, ///< The synthetic_hits_spec describing the hits to generate
+                                                       mt19937                   &prm_rng   ///< The random number generator to use
+                                                       ) {
+	const residx_t &seq_length  = prm_spec.get_seq_length();
+	const double    mean_length = get_mean_hit_length( prm_spec );
+	const residx_t  min_length  = static_cast<residx_t>( max( 1.0,                               std::floor( 0.5 * mean_length ) ) );
+	const residx_t  max_length  = static_cast<residx_t>( min( static_cast<double>( seq_length ), std::ceil ( 1.5 * mean_length ) ) );
+
+	uniform_int_distribution<residx_t> length_distn  { min_length, max_length };
+	bernoulli_distribution             discont_distn { prm_spec.get_discont_fraction() };
+
+	full_hit_vec the_hits;
+	the_hits.reserve( prm_spec.get_num_hits() );
+	for (const size_t &hit_ctr : indices( prm_spec.get_num_hits() ) ) {
+		const residx_t length       = length_distn( prm_rng );
+		const bool     want_discont = discont_distn( prm_rng ) && ( length >= 2 );
+		const residx_t gap          = want_discont ? uniform_int_distribution<residx_t>{ 1, length }( prm_rng ) : 0;
+		const bool     is_discont   = want_discont && ( length + gap <= seq_length );
+		const residx_t span         = is_discont ? ( length + gap ) : length;
+		const residx_t start        = uniform_int_distribution<residx_t>{ 1, seq_length + 1 - span }( prm_rng );
+
+		seq_seg_vec segments;
+		if ( is_discont ) {
+			const residx_t first_length = length / 2;
+			segments.emplace_back( start,                      start + first_length - 1 );
+			segments.emplace_back( start + first_length + gap, start + span         - 1 );
+		}
+		else {
+			segments.emplace_back( start, start + span - 1 );
+		}
+
+		the_hits.emplace_back(
+			std::move( segments ),
+			"synth_match_" + ::std::to_string( hit_ctr ),
+			random_synthetic_score( prm_spec.get_score_distn(), prm_rng ),
+			hit_score_type::CRH_SCORE
+		);
+	}
+	return full_hit_list{ std::move( the_hits ) };
+}
+
+/// \brief Make a full_hit_list of synthetic hits for each of the queries described by the specified synthetic_hits_spec
+///
+/// This uses a random number generator seeded with the spec's seed so that the results are reproducible
+full_hit_list_vec cath::rslv::make_synthetic_full_hit_lists(const synthetic_hits_spec &prm_spec ///< The synthetic_hits_spec describing the hits to generate
+                                                            ) {
+	mt19937 rng{ static_cast<mt19937::result_type>( prm_spec.get_seed() ) };
+	full_hit_list_vec results;
+	results.reserve( prm_spec.get_num_queries() );
+	for (const size_t &query_ctr : indices( prm_spec.get_num_queries() ) ) {
+		ignore_unused( query_ctr );
+		results.push_back( make_synthetic_full_hit_list( prm_spec, rng ) );
+	}
+	return results;
+}
+
+/// \brief Write the specified synthetic hits to the specified ostream in cath-resolve-hits' raw_with_scores format
+///
+/// The hits of the nth full_hit_list are written against the query ID synthetic_query_id( n )
+void cath::rslv::write_synthetic_raw_hits(ostream                 &prm_os,       ///< The ostream to which the hits should be written
+                                          const full_hit_list_vec &prm_hit_lists ///< The synthetic hits for each of the queries
+                                          ) {
+	for (const size_t &query_ctr : indices( prm_hit_lists.size() ) ) {
+		const string query_id = synthetic_query_id( query_ctr );
+		for (const full_hit &the_hit : prm_hit_lists[ query_ctr ] ) {
+			prm_os << query_id
+				<< ' '  << the_hit.get_label()
+				<< ' '  << the_hit.get_score()
+				<< ' '  << get_segments_string( the_hit.get_segments() )
+				<< '\n';
+		}
+	}
+}
+
+/// \brief Write the specified synthetic hits to the specified ostream in HMMER domtblout format
+///
+/// The domtblout format can only represent continuous hits so each hit is written with its
+/// full span (from its first start to its last stop) as the envelope and alignment boundaries.
+///
+/// The hits of the nth full_hit_list are written against the target ID synthetic_query_id( n )
+void cath::rslv::write_synthetic_domtblout_hits(ostream                 &prm_os,        ///< The ostream to which the hits should be written
+                                                const full_hit_list_vec &prm_hit_lists, ///< The synthetic hits for each of the queries
+                                                const residx_t          &prm_seq_length ///< The length of the query sequences
+                                                ) {
+	prm_os << "# target name  accession tlen query name accession qlen E-value score bias # of c-Evalue i-Evalue score bias from to from to from to acc description\n";
+	for (const size_t &query_ctr : indices( prm_hit_lists.size() ) ) {
+		const string query_id = synthetic_query_id( query_ctr );
+		for (const full_hit &the_hit : prm_hit_lists[ query_ctr ] ) {
+			const residx_t start = get_start_res_index( the_hit.get_segments().front() );
+			const residx_t stop  = get_stop_res_index ( the_hit.get_segments().back()  );
+			prm_os << query_id
+				<< " - "    << prm_seq_length
+				<< ' '      << the_hit.get_label()
+				<< " - "    << ( stop + 1 - start )
+				<< " 1e-10 " << the_hit.get_score()
+				<< " 0.0 1 1 1e-10 1e-10 " << the_hit.get_score()
+				<< " 0.0 1 " << ( stop + 1 - start )
+				<< ' '      << start
+				<< ' '      << stop
+				<< ' '      << start
+				<< ' '      << stop
+				<< " 0.90 -\n";
+		}
+	}
+}
+
+/// \brief Get a string of the specified synthetic hits in cath-resolve-hits' raw_with_scores format
+std::string cath::rslv::synthetic_raw_hits_string(const full_hit_list_vec &prm_hit_lists ///< The synthetic hits for each of the queries
+                                                  ) {
+	ostringstream out_ss;
+	write_synthetic_raw_hits( out_ss, prm_hit_lists );
+	return out_ss.str();
+}
+
+/// \brief Get a string of the specified synthetic hits in HMMER domtblout format
+std::string cath::rslv::synthetic_domtblout_hits_string(const full_hit_list_vec &prm_hit_lists, ///< The synthetic hits for each of the queries
+                                                        const residx_t          &prm_seq_length ///< The length of the query sequences
+                                                        ) {
+	ostringstream out_ss;
+	write_synthetic_domtblout_hits( out_ss, prm_hit_lists, prm_seq_length );
+	return out_ss.str();
+}
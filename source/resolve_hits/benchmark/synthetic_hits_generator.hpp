@@ -0,0 +1,62 @@
+/// \file
+/// \brief The synthetic_hits_generator header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_BENCHMARK_SYNTHETIC_HITS_GENERATOR_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_BENCHMARK_SYNTHETIC_HITS_GENERATOR_HPP
+
+#include "resolve_hits/full_hit_list.hpp"
+#include "seq/seq_type_aliases.hpp"
+
+#include <iosfwd>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace cath { namespace rslv { class synthetic_hits_spec; } }
+
+namespace cath {
+	namespace rslv {
+
+		/// \brief Type alias for a vector of full_hit_list objects
+		using full_hit_list_vec = std::vector<full_hit_list>;
+
+		std::string synthetic_query_id(const size_t &);
+
+		full_hit_list make_synthetic_full_hit_list(const synthetic_hits_spec &,
+		                                           std::mt19937 &);
+
+		full_hit_list_vec make_synthetic_full_hit_lists(const synthetic_hits_spec &);
+
+		void write_synthetic_raw_hits(std::ostream &,
+		                              const full_hit_list_vec &);
+
+		void write_synthetic_domtblout_hits(std::ostream &,
+		                                    const full_hit_list_vec &,
+		                                    const seq::residx_t &);
+
+		std::string synthetic_raw_hits_string(const full_hit_list_vec &);
+
+		std::string synthetic_domtblout_hits_string(const full_hit_list_vec &,
+		                                            const seq::residx_t &);
+
+	} // namespace rslv
+} // namespace cath
+
+#endif
@@ -0,0 +1,115 @@
+/// \file
+/// \brief The synthetic_hits_generator test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/exception/invalid_argument_exception.hpp"
+#include "resolve_hits/benchmark/synthetic_hits_generator.hpp"
+#include "resolve_hits/benchmark/synthetic_hits_spec.hpp"
+#include "resolve_hits/calc_hit_list.hpp"
+#include "resolve_hits/full_hit.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/gather_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/read_and_process_mgr.hpp"
+#include "seq/seq_seg.hpp"
+
+#include <sstream>
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::rslv::detail;
+using namespace cath::seq;
+
+using std::istringstream;
+
+namespace cath {
+	namespace test {
+
+		/// \brief The synthetic_hits_generator_test_suite_fixture to assist in testing synthetic_hits_generator
+		struct synthetic_hits_generator_test_suite_fixture {
+		protected:
+			~synthetic_hits_generator_test_suite_fixture() noexcept = default;
+
+			/// \brief A small synthetic_hits_spec to use in the tests
+			const synthetic_hits_spec small_spec = synthetic_hits_spec{}
+				.set_num_queries     (   3 )
+				.set_seq_length      ( 300 )
+				.set_num_hits        (  50 )
+				.set_overlap_density (  10 )
+				.set_discont_fraction( 0.5 );
+		};
+
+	}  // namespace test
+}  // namespace cath
+
+BOOST_FIXTURE_TEST_SUITE(synthetic_hits_generator_test_suite, cath::test::synthetic_hits_generator_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(generates_specified_numbers_of_hits_within_sequence) {
+	const full_hit_list_vec hit_lists = make_synthetic_full_hit_lists( small_spec );
+	BOOST_REQUIRE_EQUAL( hit_lists.size(), 3 );
+	for (const full_hit_list &hit_list : hit_lists) {
+		BOOST_REQUIRE_EQUAL( hit_list.size(), 50 );
+		for (const full_hit &the_hit : hit_list) {
+			BOOST_CHECK_GT( the_hit.get_score(), 0.0 );
+			BOOST_CHECK_GE( get_start_res_index( the_hit.get_segments().front() ), 1   );
+			BOOST_CHECK_LE( get_stop_res_index ( the_hit.get_segments().back()  ), 300 );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(discont_fraction_controls_number_of_segments) {
+	const full_hit_list_vec contig_hit_lists  = make_synthetic_full_hit_lists( synthetic_hits_spec{ small_spec }.set_discont_fraction( 0.0 ) );
+	const full_hit_list_vec discont_hit_lists  = make_synthetic_full_hit_lists( synthetic_hits_spec{ small_spec }.set_discont_fraction( 1.0 ) );
+	for (const full_hit &the_hit : contig_hit_lists.front() ) {
+		BOOST_CHECK_EQUAL( the_hit.get_segments().size(), 1 );
+	}
+	for (const full_hit &the_hit : discont_hit_lists.front() ) {
+		BOOST_CHECK_EQUAL( the_hit.get_segments().size(), 2 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(same_seed_gives_same_hits) {
+	BOOST_CHECK_EQUAL(
+		synthetic_raw_hits_string( make_synthetic_full_hit_lists( small_spec ) ),
+		synthetic_raw_hits_string( make_synthetic_full_hit_lists( small_spec ) )
+	);
+}
+
+BOOST_AUTO_TEST_CASE(raw_hits_string_can_be_parsed) {
+	str_calc_hit_list_pair_vec gathered_hit_lists;
+	hits_processor_list the_processors{ crh_score_spec{}, make_no_action_crh_segment_spec() };
+	the_processors.add_processor( gather_hits_processor{ gathered_hit_lists } );
+	read_and_process_mgr the_read_and_process_mgr{ the_processors, make_accept_all_filter_spec() };
+
+	istringstream input_ss{ synthetic_raw_hits_string( make_synthetic_full_hit_lists( small_spec ) ) };
+	read_hit_list_from_istream( the_read_and_process_mgr, input_ss, hit_score_type::CRH_SCORE );
+
+	BOOST_REQUIRE_EQUAL( gathered_hit_lists.size(), 3 );
+	BOOST_CHECK_EQUAL( gathered_hit_lists.front().first, synthetic_query_id( 0 ) );
+	BOOST_CHECK_GT   ( gathered_hit_lists.front().second.size(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE(rejects_invalid_specs) {
+	BOOST_CHECK_THROW( synthetic_hits_spec{}.set_num_hits        ( 0    ), invalid_argument_exception );
+	BOOST_CHECK_THROW( synthetic_hits_spec{}.set_discont_fraction( 1.5  ), invalid_argument_exception );
+	BOOST_CHECK_THROW( synthetic_score_distn_of_string           ( "no" ), invalid_argument_exception );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
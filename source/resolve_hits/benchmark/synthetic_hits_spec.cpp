@@ -0,0 +1,216 @@
+/// \file
+/// \brief The synthetic_hits_spec class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "synthetic_hits_spec.hpp"
+
+#include "common/exception/invalid_argument_exception.hpp"
+
+#include <algorithm>
+#include <ostream>
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::seq;
+
+using std::ostream;
+using std::string;
+
+constexpr size_t                synthetic_hits_spec::DEFAULT_NUM_QUERIES;
+constexpr residx_t              synthetic_hits_spec::DEFAULT_SEQ_LENGTH;
+constexpr size_t                synthetic_hits_spec::DEFAULT_NUM_HITS;
+constexpr double                synthetic_hits_spec::DEFAULT_OVERLAP_DENSITY;
+constexpr double                synthetic_hits_spec::DEFAULT_DISCONT_FRACTION;
+constexpr synthetic_score_distn synthetic_hits_spec::DEFAULT_SCORE_DISTN;
+constexpr size_t                synthetic_hits_spec::DEFAULT_SEED;
+
+/// \brief Generate a string describing the specified synthetic_score_distn
+///
+/// \relates synthetic_score_distn
+string cath::rslv::to_string(const synthetic_score_distn &prm_score_distn ///< The synthetic_score_distn to describe
+                             ) {
+	switch ( prm_score_distn ) {
+		case ( synthetic_score_distn::UNIFORM     ) : { return "uniform"     ; }
+		case ( synthetic_score_distn::EXPONENTIAL ) : { return "exponential" ; }
+	}
+	BOOST_THROW_EXCEPTION(invalid_argument_exception("Value of synthetic_score_distn not recognised whilst converting to_string()"));
+}
+
+/// \brief Insert a description of the specified synthetic_score_distn into the specified ostream
+///
+/// \relates synthetic_score_distn
+ostream & cath::rslv::operator<<(ostream                     &prm_os,         ///< The ostream into which the description should be inserted
+                                 const synthetic_score_distn &prm_score_distn ///< The synthetic_score_distn to describe
+                                 ) {
+	prm_os << to_string( prm_score_distn );
+	return prm_os;
+}
+
+/// \brief Get the synthetic_score_distn corresponding to the specified name (as generated by to_string())
+///
+/// \relates synthetic_score_distn
+synthetic_score_distn cath::rslv::synthetic_score_distn_of_string(const string &prm_name ///< The name of the synthetic_score_distn
+                                                                  ) {
+	for (const synthetic_score_distn &score_distn : { synthetic_score_distn::UNIFORM, synthetic_score_distn::EXPONENTIAL } ) {
+		if ( prm_name == to_string( score_distn ) ) {
+			return score_distn;
+		}
+	}
+	BOOST_THROW_EXCEPTION(invalid_argument_exception(
+		"Score distribution \"" + prm_name + "\" not recognised (should be \"uniform\" or \"exponential\")"
+	));
+}
+
+/// \brief Getter for the number of queries (each with its own set of hits)
+const size_t & synthetic_hits_spec::get_num_queries() const {
+	return num_queries;
+}
+
+/// \brief Getter for the length of each query sequence
+const residx_t & synthetic_hits_spec::get_seq_length() const {
+	return seq_length;
+}
+
+/// \brief Getter for the number of hits for each query
+const size_t & synthetic_hits_spec::get_num_hits() const {
+	return num_hits;
+}
+
+/// \brief Getter for the mean number of hits covering each residue of the query sequence
+const double & synthetic_hits_spec::get_overlap_density() const {
+	return overlap_density;
+}
+
+/// \brief Getter for the fraction of hits that are discontinuous (ie have two segments)
+const double & synthetic_hits_spec::get_discont_fraction() const {
+	return discont_fraction;
+}
+
+/// \brief Getter for the distribution from which the hits' scores are drawn
+const synthetic_score_distn & synthetic_hits_spec::get_score_distn() const {
+	return score_distn;
+}
+
+/// \brief Getter for the seed for the random number generator
+const size_t & synthetic_hits_spec::get_seed() const {
+	return seed;
+}
+
+/// \brief Setter for the number of queries (each with its own set of hits)
+synthetic_hits_spec & synthetic_hits_spec::set_num_queries(const size_t &prm_num_queries ///< The number of queries
+                                                           ) {
+	num_queries = prm_num_queries;
+	return *this;
+}
+
+/// \brief Setter for the length of each query sequence
+synthetic_hits_spec & synthetic_hits_spec::set_seq_length(const residx_t &prm_seq_length ///< The length of each query sequence
+                                                          ) {
+	if ( prm_seq_length < 2 ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("The synthetic sequence length must be at least 2"));
+	}
+	seq_length = prm_seq_length;
+	return *this;
+}
+
+/// \brief Setter for the number of hits for each query
+synthetic_hits_spec & synthetic_hits_spec::set_num_hits(const size_t &prm_num_hits ///< The number of hits for each query
+                                                        ) {
+	if ( prm_num_hits == 0 ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("The number of synthetic hits per query must be at least 1"));
+	}
+	num_hits = prm_num_hits;
+	return *this;
+}
+
+/// \brief Setter for the mean number of hits covering each residue of the query sequence
+synthetic_hits_spec & synthetic_hits_spec::set_overlap_density(const double &prm_overlap_density ///< The mean number of hits covering each residue of the query sequence
+                                                               ) {
+	if ( ! ( prm_overlap_density > 0.0 ) ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("The synthetic hits' overlap density must be positive"));
+	}
+	overlap_density = prm_overlap_density;
+	return *this;
+}
+
+/// \brief Setter for the fraction of hits that are discontinuous (ie have two segments)
+synthetic_hits_spec & synthetic_hits_spec::set_discont_fraction(const double &prm_discont_fraction ///< The fraction of hits that are discontinuous
+                                                                ) {
+	if ( ! ( prm_discont_fraction >= 0.0 && prm_discont_fraction <= 1.0 ) ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("The fraction of discontinuous synthetic hits must be between 0 and 1 (inclusive)"));
+	}
+	discont_fraction = prm_discont_fraction;
+	return *this;
+}
+
+/// \brief Setter for the distribution from which the hits' scores are drawn
+synthetic_hits_spec & synthetic_hits_spec::set_score_distn(const synthetic_score_distn &prm_score_distn ///< The distribution from which the hits' scores are drawn
+                                                           ) {
+	score_distn = prm_score_distn;
+	return *this;
+}
+
+/// \brief Setter for the seed for the random number generator
+synthetic_hits_spec & synthetic_hits_spec::set_seed(const size_t &prm_seed ///< The seed for the random number generator
+                                                    ) {
+	seed = prm_seed;
+	return *this;
+}
+
+/// \brief Get the mean length of the hits described by the specified synthetic_hits_spec
+///
+/// This is clamped so that it's at least 1 and no more than the sequence length
+///
+/// \relates synthetic_hits_spec
+double cath::rslv::get_mean_hit_length(const synthetic_hits_spec &prm_spec ///< The synthetic_hits_spec to query
+                                       ) {
+	const double seq_length = static_cast<double>( prm_spec.get_seq_length() );
+	const double raw_length = prm_spec.get_overlap_density() * seq_length / static_cast<double>( prm_spec.get_num_hits() );
+	return std::max( 1.0, std::min( seq_length, raw_length ) );
+}
+
+/// \brief Get the total number of hits (over all queries) described by the specified synthetic_hits_spec
+///
+/// \relates synthetic_hits_spec
+size_t cath::rslv::get_total_num_hits(const synthetic_hits_spec &prm_spec ///< The synthetic_hits_spec to query
+                                      ) {
+	return prm_spec.get_num_queries() * prm_spec.get_num_hits();
+}
+
+/// \brief Generate a string describing the specified synthetic_hits_spec
+///
+/// \relates synthetic_hits_spec
+string cath::rslv::to_string(const synthetic_hits_spec &prm_spec ///< The synthetic_hits_spec to describe
+                             ) {
+	return "synthetic_hits_spec[num_queries:"
+		+ ::std::to_string( prm_spec.get_num_queries()      )
+		+ ", seq_length:"
+		+ ::std::to_string( prm_spec.get_seq_length()       )
+		+ ", num_hits:"
+		+ ::std::to_string( prm_spec.get_num_hits()         )
+		+ ", overlap_density:"
+		+ ::std::to_string( prm_spec.get_overlap_density()  )
+		+ ", discont_fraction:"
+		+ ::std::to_string( prm_spec.get_discont_fraction() )
+		+ ", score_distn:"
+		+ to_string       ( prm_spec.get_score_distn()      )
+		+ ", seed:"
+		+ ::std::to_string( prm_spec.get_seed()             )
+		+ "]";
+}
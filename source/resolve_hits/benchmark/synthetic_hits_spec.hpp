@@ -0,0 +1,120 @@
+/// \file
+/// \brief The synthetic_hits_spec class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_BENCHMARK_SYNTHETIC_HITS_SPEC_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_BENCHMARK_SYNTHETIC_HITS_SPEC_HPP
+
+#include "seq/seq_type_aliases.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace cath {
+	namespace rslv {
+
+		/// \brief The distribution from which synthetic hits' scores are drawn
+		enum class synthetic_score_distn : char {
+			UNIFORM,     ///< Uniform between a small positive value and a maximum (few hits strictly dominate others)
+			EXPONENTIAL  ///< Exponential, like typical HMMER bitscores (a few strong hits and many weak ones)
+		};
+
+		std::string to_string(const synthetic_score_distn &);
+
+		std::ostream & operator<<(std::ostream &,
+		                          const synthetic_score_distn &);
+
+		synthetic_score_distn synthetic_score_distn_of_string(const std::string &);
+
+		/// \brief Specify the shape of a synthetic set of hits with which to benchmark cath-resolve-hits
+		class synthetic_hits_spec final {
+		private:
+			/// \brief The number of queries (each with its own set of hits)
+			size_t                num_queries      = DEFAULT_NUM_QUERIES;
+
+			/// \brief The length of each query sequence
+			seq::residx_t         seq_length       = DEFAULT_SEQ_LENGTH;
+
+			/// \brief The number of hits for each query
+			size_t                num_hits         = DEFAULT_NUM_HITS;
+
+			/// \brief The mean number of hits covering each residue of the query sequence
+			///
+			/// This determines the mean hit length, which is `overlap_density * seq_length / num_hits`
+			double                overlap_density  = DEFAULT_OVERLAP_DENSITY;
+
+			/// \brief The fraction of hits that are discontinuous (ie have two segments)
+			double                discont_fraction = DEFAULT_DISCONT_FRACTION;
+
+			/// \brief The distribution from which the hits' scores are drawn
+			synthetic_score_distn score_distn      = DEFAULT_SCORE_DISTN;
+
+			/// \brief The seed for the random number generator
+			size_t                seed             = DEFAULT_SEED;
+
+		public:
+			/// \brief The default value for the number of queries
+			static constexpr size_t                DEFAULT_NUM_QUERIES      = 20;
+
+			/// \brief The default value for the length of each query sequence
+			static constexpr seq::residx_t         DEFAULT_SEQ_LENGTH       = 800;
+
+			/// \brief The default value for the number of hits for each query
+			static constexpr size_t                DEFAULT_NUM_HITS         = 2000;
+
+			/// \brief The default value for the mean number of hits covering each residue of the query sequence
+			static constexpr double                DEFAULT_OVERLAP_DENSITY  = 200.0;
+
+			/// \brief The default value for the fraction of hits that are discontinuous
+			static constexpr double                DEFAULT_DISCONT_FRACTION = 0.1;
+
+			/// \brief The default value for the distribution from which the hits' scores are drawn
+			static constexpr synthetic_score_distn DEFAULT_SCORE_DISTN      = synthetic_score_distn::EXPONENTIAL;
+
+			/// \brief The default value for the seed for the random number generator
+			static constexpr size_t                DEFAULT_SEED             = 0;
+
+			const size_t & get_num_queries() const;
+			const seq::residx_t & get_seq_length() const;
+			const size_t & get_num_hits() const;
+			const double & get_overlap_density() const;
+			const double & get_discont_fraction() const;
+			const synthetic_score_distn & get_score_distn() const;
+			const size_t & get_seed() const;
+
+			synthetic_hits_spec & set_num_queries(const size_t &);
+			synthetic_hits_spec & set_seq_length(const seq::residx_t &);
+			synthetic_hits_spec & set_num_hits(const size_t &);
+			synthetic_hits_spec & set_overlap_density(const double &);
+			synthetic_hits_spec & set_discont_fraction(const double &);
+			synthetic_hits_spec & set_score_distn(const synthetic_score_distn &);
+			synthetic_hits_spec & set_seed(const size_t &);
+		};
+
+		double get_mean_hit_length(const synthetic_hits_spec &);
+
+		size_t get_total_num_hits(const synthetic_hits_spec &);
+
+		std::string to_string(const synthetic_hits_spec &);
+
+	} // namespace rslv
+} // namespace cath
+
+#endif
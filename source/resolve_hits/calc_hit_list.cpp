@@ -326,7 +326,7 @@ void cath::rslv::read_hit_list_from_istream(read_and_process_mgr &prm_read_and_p
 		prm_read_and_process_mgr.add_hit(
 			query_id_str_ref,
 			segments_from_bounds( bounds ),
-			string{ begin_of_match_id_itr, end_of_match_id_itr },
+			make_string_ref( begin_of_match_id_itr, end_of_match_id_itr ),
 			score,
 			prm_score_type
 		);
@@ -33,6 +33,7 @@
 #include "resolve_hits/full_hit_list.hpp"
 #include "resolve_hits/options/spec/crh_filter_spec.hpp"
 #include "resolve_hits/score_functions.hpp"
+#include "resolve_hits/scored_hit_arch.hpp"
 #include "resolve_hits/seg_dupl_hit_policy.hpp"
 
 #include <tuple>
@@ -59,6 +60,12 @@ namespace cath {
 			/// \brief The list of hits
 			calc_hit_vec the_hits;
 
+			/// \brief A resolution of the hits that's already known (eg from a result cache), if any
+			scored_hit_arch_opt known_resolution;
+
+			/// \brief Whether known_resolution was made using the naive, greedy approach
+			bool known_resolution_is_naive_greedy = false;
+
 			static void sort_hit_vec(calc_hit_vec &,
 			                         const full_hit_list &);
 
@@ -95,10 +102,12 @@ namespace cath {
 						}
 					}
 
+					const full_hit &full_hit_x = prm_full_hits[ x.get_label_idx() ];
+					const full_hit &full_hit_y = prm_full_hits[ y.get_label_idx() ];
 					return (
-						prm_full_hits[ x.get_label_idx() ].get_label()
-						<
-						prm_full_hits[ y.get_label_idx() ].get_label()
+						( full_hit_x.get_label_id() != full_hit_y.get_label_id() )
+						&&
+						( full_hit_x.get_label() < full_hit_y.get_label() )
 					);
 				};
 			}
@@ -116,6 +125,10 @@ namespace cath {
 
 			const full_hit_list & get_full_hits() const;
 
+			const scored_hit_arch * get_known_resolution(const bool &) const;
+			calc_hit_list & set_known_resolution(scored_hit_arch,
+			                                     const bool &);
+
 			iterator begin();
 			iterator end();
 			const_iterator begin() const;
@@ -206,6 +219,27 @@ namespace cath {
 			return full_hits;
 		}
 
+		/// \brief Get the already-known resolution of these hits that was made with the specified approach
+		///        or nullptr if there isn't one
+		inline const scored_hit_arch * calc_hit_list::get_known_resolution(const bool &prm_naive_greedy ///< Whether the resolution should have been made using the naive, greedy approach
+		                                                                   ) const {
+			return ( known_resolution && known_resolution_is_naive_greedy == prm_naive_greedy )
+				? &*known_resolution
+				: nullptr;
+		}
+
+		/// \brief Record an already-known resolution of these hits (eg from a result cache) so that
+		///        resolve_hits() can return it rather than resolving the hits again
+		///
+		/// \pre The scored_hit_arch must be built from the hits in this calc_hit_list
+		inline calc_hit_list & calc_hit_list::set_known_resolution(scored_hit_arch  prm_resolution,  ///< The resolution of the hits
+		                                                           const bool      &prm_naive_greedy ///< Whether the resolution was made using the naive, greedy approach
+		                                                           ) {
+			known_resolution                 = std::move( prm_resolution );
+			known_resolution_is_naive_greedy = prm_naive_greedy;
+			return *this;
+		}
+
 		/// \brief Standard non-const begin() method, as part of making this into a range over the hits
 		inline auto calc_hit_list::begin() -> iterator {
 			return std::begin( the_hits );
@@ -18,16 +18,26 @@
 /// You should have received a copy of the GNU General Public License
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <rapidjson/document.h>
+
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/range/join.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include "common/algorithm/copy_build.hpp"
 #include "common/boost_addenda/log/stringstream_log_sink.hpp"
+#include "common/file/open_fstream.hpp"
 #include "common/file/read_string_from_file.hpp"
 #include "common/file/simple_file_read_write.hpp"
 #include "common/file/temp_file.hpp"
 #include "resolve_hits/cath_hit_resolver.hpp"
+#include "resolve_hits/file/crh_columnar_format.hpp"
+#include "resolve_hits/html_output/resolve_hits_html_outputter.hpp"
 #include "resolve_hits/options/options_block/crh_filter_options_block.hpp"
 #include "resolve_hits/options/options_block/crh_html_options_block.hpp"
 #include "resolve_hits/options/options_block/crh_input_options_block.hpp"
@@ -41,7 +51,9 @@
 #include "test/predicate/files_equal.hpp"
 #include "test/predicate/string_matches_file.hpp"
 
+#include <fstream>
 #include <regex>
+#include <sstream>
 
 namespace cath { namespace test { } }
 
@@ -53,16 +65,20 @@ using namespace ::cath::test;
 using namespace ::std::literals::string_literals;
 
 using ::boost::algorithm::contains;
+using ::boost::filesystem::file_size;
 using ::boost::filesystem::path;
+using ::boost::filesystem::remove_all;
 using ::boost::range::join;
 using ::cath::common::copy_build;
 using ::cath::common::temp_file;
 using ::cath::common::write_file;
+using ::std::ifstream;
 using ::std::istringstream;
 using ::std::ostringstream;
 using ::std::regex;
 using ::std::regex_replace;
 using ::std::string;
+using ::std::stringstream;
 
 namespace cath {
 	namespace test {
@@ -474,6 +490,44 @@ BOOST_AUTO_TEST_CASE(html__deprecated_opts) {
 	BOOST_CHECK( regex_search( log_sink.str(), regex{ R"(deprecated.* \-\-html\-output\-to\-file \-)" } ) );
 }
 
+BOOST_AUTO_TEST_CASE(html_to_dir_writes_index_css_and_query_pages) {
+	const auto html_dir = TEMP_TEST_FILE_FILENAME;
+	execute_perform_resolve_hits( {
+		CRH_EG_HMMSEARCH_IN_FILENAME().string(),
+		"--" + crh_input_options_block::PO_INPUT_FORMAT, to_string( hits_input_format_tag::HMMSEARCH_OUT ),
+		"--" + crh_segment_options_block::PO_OVERLAP_TRIM_SPEC, "150/90",
+		"--" + crh_output_options_block::PO_QUIET,
+		"--" + crh_output_options_block::PO_HTML_OUTPUT_TO_DIR, html_dir.string(),
+		"--" + crh_filter_options_block::PO_WORST_PERMISSIBLE_BITSCORE, "14",
+		"--" + crh_html_options_block::PO_MAX_NUM_NON_SOLN_HITS, "10"
+	} );
+	const string index_html     = read_string_from_file( html_dir / "index.html"                   );
+	const string css            = read_string_from_file( html_dir / "crh.css"                      );
+	const string first_page     = read_string_from_file( html_dir / "queries" / "0" / "0.html"     );
+	const string first_all_page = read_string_from_file( html_dir / "queries" / "0" / "0.all.html" );
+	remove_all( html_dir );
+
+	BOOST_CHECK_EQUAL( output_ss.str(), "" );
+	BOOST_CHECK_EQUAL( css, resolve_hits_html_outputter::css_string() );
+	BOOST_CHECK( boost::algorithm::contains( index_html, R"(<a href="queries/0/0.html">)" ) );
+	BOOST_CHECK( boost::algorithm::contains( index_html, "</html>" ) );
+	BOOST_CHECK( boost::algorithm::contains( first_page, R"(<link rel="stylesheet" href="../../crh.css">)" ) );
+	BOOST_CHECK( boost::algorithm::contains( first_page, R"(href="0.all.html")" ) );
+	BOOST_CHECK( ! boost::algorithm::contains( first_page, "<style>" ) );
+	BOOST_CHECK( boost::algorithm::contains( first_page, "</html>" ) );
+	BOOST_CHECK( ! boost::algorithm::contains( first_all_page, R"(href="0.all.html")" ) );
+	BOOST_CHECK_GT( first_all_page.size(), first_page.size() );
+}
+
+BOOST_AUTO_TEST_CASE(fails_on_html_to_dir_with_stdout_flag) {
+	execute_perform_resolve_hits( {
+		CRH_EG_HMMSEARCH_IN_FILENAME().string(),
+		"--" + crh_input_options_block::PO_INPUT_FORMAT, to_string( hits_input_format_tag::HMMSEARCH_OUT ),
+		"--" + crh_output_options_block::PO_HTML_OUTPUT_TO_DIR, "-",
+	} );
+	BOOST_CHECK_EQUAL( output_ss.str(), "cath-resolve-hits: Cannot send output for --html-output-to-dir to stdout (which is specified as \"-\") because it must be a directory\nSee 'cath-resolve-hits -h' for usage.\n" );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -497,6 +551,101 @@ BOOST_AUTO_TEST_CASE(json_from_domtblout) {
 	BOOST_CHECK_STRING_MATCHES_FILE( output_ss.str(), CRH_EG_DOMTBL_JSON_OUT_FILENAME() );
 }
 
+BOOST_AUTO_TEST_CASE(jsonl_from_domtblout_has_one_line_per_query_matching_json) {
+	execute_perform_resolve_hits( {
+		(CRH_TEST_DATA_DIR() / "eg_domtblout.in" ).string(),
+		"--" + crh_input_options_block::PO_INPUT_FORMAT, to_string( hits_input_format_tag::HMMER_DOMTBLOUT ),
+		"--" + crh_output_options_block::PO_JSONL_OUTPUT_TO_FILE, "-",
+	} );
+
+	rapidjson::Document expected_doc;
+	expected_doc.Parse( read_string_from_file( CRH_EG_DOMTBL_JSON_OUT_FILENAME() ).c_str() );
+	BOOST_REQUIRE( expected_doc.IsObject() );
+
+	stringstream jsonl_ss{ output_ss.str() };
+	size_t num_lines = 0;
+	string line;
+	while ( getline( jsonl_ss, line ) ) {
+		++num_lines;
+		rapidjson::Document line_doc;
+		line_doc.Parse( line.c_str() );
+		BOOST_REQUIRE( line_doc.IsObject() );
+		BOOST_REQUIRE_EQUAL( line_doc.MemberCount(), 1 );
+		const auto &query_and_hits = *line_doc.MemberBegin();
+		BOOST_REQUIRE( expected_doc.HasMember( query_and_hits.name ) );
+		BOOST_CHECK( expected_doc[ query_and_hits.name ] == query_and_hits.value );
+	}
+	BOOST_CHECK_EQUAL( num_lines, expected_doc.MemberCount() );
+}
+
+BOOST_AUTO_TEST_CASE(gzipped_jsonl_decompresses_to_uncompressed_jsonl) {
+	execute_perform_resolve_hits( {
+		(CRH_TEST_DATA_DIR() / "eg_domtblout.in" ).string(),
+		"--" + crh_input_options_block::PO_INPUT_FORMAT, to_string( hits_input_format_tag::HMMER_DOMTBLOUT ),
+		"--" + crh_output_options_block::PO_JSONL_OUTPUT_TO_FILE, "-",
+	} );
+	const string uncompressed_jsonl = output_ss.str();
+
+	execute_perform_resolve_hits( {
+		(CRH_TEST_DATA_DIR() / "eg_domtblout.in" ).string(),
+		"--" + crh_input_options_block::PO_INPUT_FORMAT, to_string( hits_input_format_tag::HMMER_DOMTBLOUT ),
+		"--" + crh_output_options_block::PO_QUIET,
+		"--" + crh_output_options_block::PO_JSONL_OUTPUT_TO_FILE, TEMP_TEST_FILE_FILENAME.string(),
+		"--" + crh_output_options_block::PO_GZIP_JSONL_OUTPUT,
+	} );
+
+	string decompressed_jsonl;
+	boost::iostreams::filtering_istream gunzip_stream;
+	gunzip_stream.push( boost::iostreams::gzip_decompressor{} );
+	gunzip_stream.push( boost::iostreams::file_source{ TEMP_TEST_FILE_FILENAME.string(), std::ios::binary } );
+	boost::iostreams::copy( gunzip_stream, boost::iostreams::back_inserter( decompressed_jsonl ) );
+
+	BOOST_CHECK( ! uncompressed_jsonl.empty() );
+	BOOST_CHECK_EQUAL( decompressed_jsonl, uncompressed_jsonl );
+}
+
+BOOST_AUTO_TEST_CASE(fails_on_gzip_jsonl_without_jsonl_output) {
+	execute_perform_resolve_hits( {
+		(CRH_TEST_DATA_DIR() / "eg_domtblout.in" ).string(),
+		"--" + crh_input_options_block::PO_INPUT_FORMAT, to_string( hits_input_format_tag::HMMER_DOMTBLOUT ),
+		"--" + crh_output_options_block::PO_GZIP_JSONL_OUTPUT,
+	} );
+	BOOST_CHECK_EQUAL( output_ss.str(), "cath-resolve-hits: Cannot gzip-compress JSON Lines output if not outputting any JSON Lines (with --jsonl-output-to-file)\nSee 'cath-resolve-hits -h' for usage.\n" );
+}
+
+BOOST_AUTO_TEST_CASE(columnar_from_domtblout_matches_hits_text) {
+	execute_perform_resolve_hits( {
+		(CRH_TEST_DATA_DIR() / "eg_domtblout.in" ).string(),
+		"--" + crh_input_options_block::PO_INPUT_FORMAT, to_string( hits_input_format_tag::HMMER_DOMTBLOUT ),
+		"--" + crh_output_options_block::PO_COLUMNAR_OUTPUT_TO_FILE, TEMP_TEST_FILE_FILENAME.string(),
+	} );
+
+	ifstream columnar_ifstream;
+	open_ifstream( columnar_ifstream, TEMP_TEST_FILE_FILENAME, std::ios::in | std::ios::binary );
+	const crh_columnar_table table = read_crh_columnar( columnar_ifstream );
+	columnar_ifstream.close();
+
+	stringstream hits_text_ss{ output_ss.str() };
+	size_t num_rows = 0;
+	string line;
+	while ( getline( hits_text_ss, line ) ) {
+		if ( line.empty() || line.front() == '#' ) {
+			continue;
+		}
+		istringstream line_ss{ line };
+		string query_id, match_id, score, boundaries, resolved;
+		line_ss >> query_id >> match_id >> score >> boundaries >> resolved;
+		BOOST_REQUIRE_LT ( num_rows, table.query_ids.size() );
+		BOOST_CHECK_EQUAL( table.query_ids[ num_rows ],                                query_id   );
+		BOOST_CHECK_EQUAL( table.match_ids[ num_rows ],                                match_id   );
+		BOOST_CHECK_EQUAL( get_segments_string( table.segments         [ num_rows ] ), boundaries );
+		BOOST_CHECK_EQUAL( get_segments_string( table.resolved_segments[ num_rows ] ), resolved   );
+		++num_rows;
+	}
+	BOOST_CHECK_GT   ( num_rows, 0                      );
+	BOOST_CHECK_EQUAL( num_rows, table.query_ids.size() );
+}
+
 BOOST_AUTO_TEST_CASE(json_from_hmmsearch_out__deprecated_opts) {
 	// Redirect any logging
 	stringstream_log_sink log_sink;
@@ -527,6 +676,29 @@ BOOST_AUTO_TEST_CASE(json_from_domtblout__deprecated_opts) {
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(result_cache)
+
+BOOST_AUTO_TEST_CASE(output_is_unchanged_by_cold_and_warm_result_cache) {
+	const str_vec args = {
+		(CRH_TEST_DATA_DIR() / "eg_domtblout.in" ).string(),
+		"--" + crh_input_options_block::PO_INPUT_FORMAT, to_string( hits_input_format_tag::HMMER_DOMTBLOUT ),
+		"--" + crh_input_options_block::PO_RESULT_CACHE_FILE, TEMP_TEST_FILE_FILENAME.string(),
+		"--" + crh_output_options_block::PO_JSON_OUTPUT_TO_FILE, "-",
+	};
+
+	execute_perform_resolve_hits( args );
+	BOOST_CHECK_STRING_MATCHES_FILE( output_ss.str(), CRH_EG_DOMTBL_JSON_OUT_FILENAME() );
+	const auto cache_size_after_cold_run = file_size( TEMP_TEST_FILE_FILENAME );
+	BOOST_CHECK_GT( cache_size_after_cold_run, 0 );
+
+	output_ss.str( "" );
+	execute_perform_resolve_hits( args );
+	BOOST_CHECK_STRING_MATCHES_FILE( output_ss.str(), CRH_EG_DOMTBL_JSON_OUT_FILENAME() );
+	BOOST_CHECK_EQUAL( file_size( TEMP_TEST_FILE_FILENAME ), cache_size_after_cold_run );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE(hmm_coverage)
 
 BOOST_AUTO_TEST_CASE(hmm_coverage__neither) {
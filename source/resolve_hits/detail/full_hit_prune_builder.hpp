@@ -21,15 +21,17 @@
 #ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_DETAIL_FULL_HIT_PRUNE_BUILDER_HPP
 #define _CATH_TOOLS_SOURCE_RESOLVE_HITS_DETAIL_FULL_HIT_PRUNE_BUILDER_HPP
 
+#include <boost/optional.hpp>
 #include <boost/range/algorithm/equal.hpp>
 
 #include "common/boost_addenda/tribool/tribool.hpp"
-#include "resolve_hits/first_hit_is_better.hpp"
+#include "resolve_hits/algo/dominated_hits_finder.hpp"
 #include "resolve_hits/first_hit_is_better.hpp"
 #include "resolve_hits/full_hit.hpp"
 #include "resolve_hits/resolve_hits_type_aliases.hpp"
 #include "resolve_hits/seg_dupl_hit_policy.hpp"
 
+#include <algorithm>
 #include <unordered_map>
 
 namespace cath {
@@ -85,6 +87,11 @@ namespace cath {
 			/// \brief Build a full_hit_vec of hits whilst pruning hits that have a better hit (or not worse) with *identical* segments
 			///
 			/// This does a better job than calc_hit_prune_builder
+			///
+			/// If constructed with the specs that define how hits are used in the resolving calculations,
+			/// this also periodically prunes hits that are strictly dominated by a better hit within one of their
+			/// segments (see dominated_hits_finder). This is done each time the number of stored hits doubles,
+			/// which keeps memory bounded by the (typically much smaller) number of hits that survive pruning.
 			class full_hit_prune_builder final {
 			private:
 				/// \brief Whether the strictly-worse hits should be preserved or pruned
@@ -109,12 +116,62 @@ namespace cath {
 				/// \brief A lookup from a full_hit_ref to an index the index of an example full_hit with those segments
 				full_hit_to_index_uomap index_of_full_hit_ref;
 
+				/// \brief The (optional) finder of dominated hits, present iff dominated hits should be pruned
+				boost::optional<dominated_hits_finder> dominance_finder;
+
+				/// \brief The number of stored hits at which the next pass of pruning dominated hits should be performed
+				size_t next_dominance_prune_size = MIN_DOMINANCE_PRUNE_SIZE;
+
+				/// \brief The number of hits that have been pruned for being dominated by a better hit
+				size_t num_dominated_pruned = 0;
+
+				/// \brief Prune any hits that are dominated by better hits and rebuild the index
+				inline void prune_dominated_hits() {
+					const size_vec dominated_indices = dominance_finder->find_dominated_indices( hits );
+					if ( ! dominated_indices.empty() ) {
+						std::deque<full_hit> kept_hits;
+						auto dominated_itr = common::cbegin( dominated_indices );
+						for (size_t hit_ctr = 0; hit_ctr < hits.size(); ++hit_ctr) {
+							if ( dominated_itr != common::cend( dominated_indices ) && *dominated_itr == hit_ctr ) {
+								++dominated_itr;
+							}
+							else {
+								kept_hits.push_back( std::move( hits[ hit_ctr ] ) );
+							}
+						}
+						hits = std::move( kept_hits );
+						num_dominated_pruned += dominated_indices.size();
+
+						index_of_full_hit_ref.clear();
+						for (size_t hit_ctr = 0; hit_ctr < hits.size(); ++hit_ctr) {
+							index_of_full_hit_ref.emplace( hits[ hit_ctr ], hit_ctr );
+						}
+					}
+					next_dominance_prune_size = std::max( size_t{ MIN_DOMINANCE_PRUNE_SIZE }, 2 * hits.size() );
+				}
+
 			public:
+				/// \brief The minimum number of stored hits before a pass of pruning dominated hits is performed
+				static constexpr size_t MIN_DOMINANCE_PRUNE_SIZE = 4096;
+
 				/// \brief Ctor to populate require_strictly_worse_hits
 				inline explicit full_hit_prune_builder(const seg_dupl_hit_policy &prm_policy ///< Whether the strictly-worse hits should be preserved or pruned
 				                                       ) : policy { prm_policy } {
 				}
 
+				/// \brief Ctor to populate require_strictly_worse_hits and the specs with which to prune dominated hits
+				///
+				/// Dominated hits are only pruned if the policy is seg_dupl_hit_policy::PRUNE
+				inline full_hit_prune_builder(const seg_dupl_hit_policy &prm_policy,       ///< Whether the strictly-worse hits should be preserved or pruned
+				                              const crh_score_spec      &prm_score_spec,   ///< The crh_score_spec to specify how the crh-scores are to be calculated from the full-hits
+				                              const crh_segment_spec    &prm_segment_spec, ///< The crh_segment_spec to specify how the segments are to be handled before being put into the hits for calculation
+				                              const crh_filter_spec     &prm_filter_spec   ///< The crh_filter_spec specifying how hits should be filtered
+				                              ) : policy { prm_policy } {
+					if ( policy == seg_dupl_hit_policy::PRUNE ) {
+						dominance_finder.emplace( prm_score_spec, prm_segment_spec, prm_filter_spec );
+					}
+				}
+
 				/// \brief Reserve space for the specified number of hits
 				inline void reserve(const size_t &prm_capacity ///< The number of hits for which space should be reserved
 				                    ) {
@@ -132,6 +189,11 @@ namespace cath {
 					return hits.empty();
 				}
 
+				/// \brief Return the number of hits that have been pruned thus far for being dominated by a better hit
+				inline const size_t & get_num_dominated_pruned() const {
+					return num_dominated_pruned;
+				}
+
 				/// \brief Add a hit (or skip it if it's found to be worse than existing hit)
 				inline void add_hit(full_hit prm_full_hit ///< The hit to be added
 				                    ) {
@@ -144,6 +206,9 @@ namespace cath {
 						const auto hits_size_before = hits.size();
 						hits.push_back( std::move( prm_full_hit ) );
 						index_of_full_hit_ref.emplace( hits.back(), hits_size_before );
+						if ( dominance_finder && hits.size() >= next_dominance_prune_size ) {
+							prune_dominated_hits();
+						}
 					}
 					else {
 						const auto &comp_hit = hits[ itr->second ];
@@ -158,6 +223,9 @@ namespace cath {
 
 				/// \brief Get the built hits
 				inline full_hit_list get_built_hits() {
+					if ( dominance_finder ) {
+						prune_dominated_hits();
+					}
 					full_hit_list result{ common::make_vector_of_rvalue_deque( std::move( hits ) ) };
 					index_of_full_hit_ref.clear();
 					return result;
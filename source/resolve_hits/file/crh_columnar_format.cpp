@@ -0,0 +1,418 @@
+/// \file
+/// \brief The crh_columnar_format class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "crh_columnar_format.hpp"
+
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/optional.hpp>
+
+#include "common/exception/runtime_error_exception.hpp"
+#include "resolve_hits/full_hit.hpp"
+#include "resolve_hits/full_hit_list.hpp"
+#include "resolve_hits/full_hit_list_fns.hpp"
+#include "resolve_hits/hit_extras.hpp"
+#include "resolve_hits/options/spec/crh_segment_spec.hpp"
+#include "resolve_hits/trim/trim_spec.hpp"
+
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <utility>
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::seq;
+
+using boost::make_optional;
+using boost::numeric_cast;
+using cath::doub_vec;
+using cath::str_vec;
+using std::istream;
+using std::numeric_limits;
+using std::streamsize;
+using std::string;
+using std::vector;
+
+/// \brief The magic at the start of a cath-resolve-hits binary columnar file
+static const string CRH_COLUMNAR_HEADER_MAGIC    { "CRHCOLS", 8 };
+
+/// \brief The magic at the start of each row group in a cath-resolve-hits binary columnar file
+static const string CRH_COLUMNAR_ROW_GROUP_MAGIC { "CRHRGRP", 8 };
+
+/// \brief The version of the cath-resolve-hits binary columnar format that's written
+static constexpr uint32_t CRH_COLUMNAR_FORMAT_VERSION = 1;
+
+/// \brief The alignment (in bytes) of each block in a cath-resolve-hits binary columnar file
+static constexpr size_t CRH_COLUMNAR_ALIGNMENT = 8;
+
+/// \brief Append the specified unsigned integer to the specified bytes in little-endian order
+template <typename T>
+static void append_le(string  &prm_bytes, ///< The bytes to which the value should be appended
+                      const T &prm_value  ///< The value to append
+                      ) {
+	static_assert( std::is_unsigned<T>::value, "append_le() should only be used with unsigned integers" );
+	for (size_t byte_ctr = 0; byte_ctr < sizeof( T ); ++byte_ctr) {
+		prm_bytes.push_back( static_cast<char>( ( prm_value >> ( 8 * byte_ctr ) ) & 0xFFu ) );
+	}
+}
+
+/// \brief Append the specified double to the specified bytes as a little-endian IEEE 754 binary64
+static void append_le(string       &prm_bytes, ///< The bytes to which the value should be appended
+                      const double &prm_value  ///< The value to append
+                      ) {
+	static_assert( sizeof( double ) == sizeof( uint64_t ), "This code requires that double is 64 bits" );
+	uint64_t bits;
+	std::memcpy( &bits, &prm_value, sizeof( bits ) );
+	append_le( prm_bytes, bits );
+}
+
+/// \brief Zero-pad the specified bytes up to the next multiple of CRH_COLUMNAR_ALIGNMENT
+static void pad_to_alignment(string &prm_bytes ///< The bytes to pad
+                             ) {
+	prm_bytes.append( ( CRH_COLUMNAR_ALIGNMENT - ( prm_bytes.size() % CRH_COLUMNAR_ALIGNMENT ) ) % CRH_COLUMNAR_ALIGNMENT, '\0' );
+}
+
+/// \brief Append the specified column of values to the specified bytes, followed by any padding
+template <typename T>
+static void append_column(string          &prm_bytes,  ///< The bytes to which the column should be appended
+                          const vector<T> &prm_values  ///< The values in the column
+                          ) {
+	for (const T &value : prm_values) {
+		append_le( prm_bytes, value );
+	}
+	pad_to_alignment( prm_bytes );
+}
+
+/// \brief Append the starts and stops of the specified segments to the specified columns
+static void append_segments(const seq_seg_vec &prm_segments, ///< The segments to append
+                            vector<uint32_t>  &prm_offsets,  ///< The offsets column, to which the new end offset is appended
+                            vector<uint32_t>  &prm_starts,   ///< The starts column
+                            vector<uint32_t>  &prm_stops     ///< The stops column
+                            ) {
+	for (const seq_seg &the_segment : prm_segments) {
+		prm_starts.push_back( numeric_cast<uint32_t>( get_start_res_index( the_segment ) ) );
+		prm_stops.push_back ( numeric_cast<uint32_t>( get_stop_res_index ( the_segment ) ) );
+	}
+	prm_offsets.push_back( numeric_cast<uint32_t>( prm_starts.size() ) );
+}
+
+/// \brief Get the index of the match with the specified label ID, adding it to the pending dictionary entries if it's new
+uint32_t crh_columnar_encoder::match_index_of(const hitlbl_t &prm_label_id ///< The label ID of the match
+                                              ) {
+	const auto find_itr = match_index_of_label.find( prm_label_id );
+	if ( find_itr != match_index_of_label.end() ) {
+		return find_itr->second;
+	}
+	const uint32_t new_index = numeric_cast<uint32_t>( match_index_of_label.size() );
+	match_index_of_label.emplace( prm_label_id, new_index );
+	new_match_ids.push_back( get_global_hit_label( prm_label_id ).to_string() );
+	return new_index;
+}
+
+/// \brief Get the bytes of the header with which a cath-resolve-hits binary columnar file starts
+string crh_columnar_encoder::header_bytes() {
+	string bytes = CRH_COLUMNAR_HEADER_MAGIC;
+	append_le( bytes, CRH_COLUMNAR_FORMAT_VERSION );
+	append_le( bytes, uint32_t{ 0 } );
+	return bytes;
+}
+
+/// \brief Add rows for the specified (resolved) hits for the specified query to the pending row group
+///
+/// \pre The query must not have been added previously
+void crh_columnar_encoder::add_query(const string              &prm_query_id,       ///< The query_protein_id string
+                                     const full_hit_list       &prm_full_hits,      ///< The resolved hits for the query
+                                     const crh_segment_spec    &prm_segment_spec,   ///< The segment spec used to resolve the hits' boundaries
+                                     const hit_boundary_output &prm_boundary_output ///< Whether to trim the boundaries before outputting them
+                                     ) {
+	if ( prm_full_hits.empty() ) {
+		return;
+	}
+
+	const uint32_t query_index = numeric_cast<uint32_t>( num_query_ids );
+	++num_query_ids;
+	new_query_ids.push_back( prm_query_id );
+
+	const auto trim_spec_if_trim_output = make_optional(
+		prm_boundary_output == hit_boundary_output::TRIMMED,
+		prm_segment_spec.get_overlap_trim_spec()
+	);
+	const double absent_evalue = numeric_limits<double>::quiet_NaN();
+
+	for (const full_hit &the_hit : prm_full_hits) {
+		query_indices.push_back( query_index                                                                              );
+		match_indices.push_back( match_index_of( the_hit.get_label_id() )                                                 );
+		score_types.push_back  ( static_cast<uint8_t>( the_hit.get_score_type() )                                         );
+		scores.push_back       ( the_hit.get_score()                                                                      );
+		cond_evalues.push_back ( get_first< hit_extra_cat::COND_EVAL >( the_hit.get_extras_store() ).value_or( absent_evalue ) );
+		indp_evalues.push_back ( get_first< hit_extra_cat::INDP_EVAL >( the_hit.get_extras_store() ).value_or( absent_evalue ) );
+
+		aligned_regions_chars += get_first< hit_extra_cat::ALND_RGNS >( the_hit.get_extras_store() ).value_or( string{} );
+		aligned_regions_offsets.push_back( numeric_cast<uint32_t>( aligned_regions_chars.size() ) );
+
+		append_segments(
+			get_segments( the_hit.get_segments(), trim_spec_if_trim_output ),
+			seg_offsets,
+			seg_starts,
+			seg_stops
+		);
+		append_segments(
+			get_present_segments( resolve_all_boundaries( the_hit, prm_full_hits, prm_segment_spec ) ),
+			resolved_offsets,
+			resolved_starts,
+			resolved_stops
+		);
+	}
+}
+
+/// \brief Get the number of rows in the pending row group
+size_t crh_columnar_encoder::num_pending_rows() const {
+	return query_indices.size();
+}
+
+/// \brief Get the bytes of the pending row group (or an empty string if there are no pending rows)
+///        and reset ready for the next row group
+string crh_columnar_encoder::row_group_bytes() {
+	if ( num_pending_rows() == 0 ) {
+		return {};
+	}
+
+	// Build the dictionary of new IDs
+	vector<uint32_t> dict_offsets{ 0 };
+	string           dict_chars;
+	for (const str_vec *ids_ptr : { &new_query_ids, &new_match_ids } ) {
+		for (const string &id : *ids_ptr) {
+			dict_chars += id;
+			dict_offsets.push_back( numeric_cast<uint32_t>( dict_chars.size() ) );
+		}
+	}
+
+	string bytes = CRH_COLUMNAR_ROW_GROUP_MAGIC;
+	append_le( bytes, uint64_t{ num_pending_rows()           } );
+	append_le( bytes, uint64_t{ seg_starts.size()            } );
+	append_le( bytes, uint64_t{ resolved_starts.size()       } );
+	append_le( bytes, uint64_t{ new_query_ids.size()         } );
+	append_le( bytes, uint64_t{ new_match_ids.size()         } );
+	append_le( bytes, uint64_t{ dict_chars.size()            } );
+	append_le( bytes, uint64_t{ aligned_regions_chars.size() } );
+
+	append_column( bytes, dict_offsets            );
+	bytes += dict_chars;
+	pad_to_alignment( bytes );
+
+	append_column( bytes, query_indices           );
+	append_column( bytes, match_indices           );
+	append_column( bytes, score_types             );
+	append_column( bytes, scores                  );
+	append_column( bytes, cond_evalues            );
+	append_column( bytes, indp_evalues            );
+	append_column( bytes, seg_offsets             );
+	append_column( bytes, seg_starts              );
+	append_column( bytes, seg_stops               );
+	append_column( bytes, resolved_offsets        );
+	append_column( bytes, resolved_starts         );
+	append_column( bytes, resolved_stops          );
+	append_column( bytes, aligned_regions_offsets );
+	bytes += aligned_regions_chars;
+	pad_to_alignment( bytes );
+
+	new_query_ids.clear();
+	new_match_ids.clear();
+	query_indices.clear();
+	match_indices.clear();
+	score_types.clear();
+	scores.clear();
+	cond_evalues.clear();
+	indp_evalues.clear();
+	seg_offsets.assign( 1, 0 );
+	seg_starts.clear();
+	seg_stops.clear();
+	resolved_offsets.assign( 1, 0 );
+	resolved_starts.clear();
+	resolved_stops.clear();
+	aligned_regions_offsets.assign( 1, 0 );
+	aligned_regions_chars.clear();
+
+	return bytes;
+}
+
+/// \brief Read the specified number of bytes from the specified istream or throw if that isn't possible
+static string read_bytes(istream      &prm_istream,  ///< The istream from which to read
+                         const size_t &prm_num_bytes ///< The number of bytes to read
+                         ) {
+	if ( prm_num_bytes == 0 ) {
+		return {};
+	}
+	string bytes( prm_num_bytes, '\0' );
+	prm_istream.read( &bytes.front(), static_cast<streamsize>( prm_num_bytes ) );
+	if ( static_cast<size_t>( prm_istream.gcount() ) != prm_num_bytes ) {
+		BOOST_THROW_EXCEPTION(runtime_error_exception("Unexpected end of data whilst reading cath-resolve-hits binary columnar data"));
+	}
+	return bytes;
+}
+
+/// \brief Decode a little-endian unsigned integer from the specified position in the specified bytes
+template <typename T>
+static T decode_le(const string &prm_bytes, ///< The bytes from which to decode
+                   const size_t &prm_offset ///< The offset of the value in the bytes
+                   ) {
+	static_assert( std::is_unsigned<T>::value, "decode_le() should only be used with unsigned integers" );
+	T value = 0;
+	for (size_t byte_ctr = 0; byte_ctr < sizeof( T ); ++byte_ctr) {
+		value = static_cast<T>( value | ( static_cast<T>( static_cast<unsigned char>( prm_bytes[ prm_offset + byte_ctr ] ) ) << ( 8 * byte_ctr ) ) );
+	}
+	return value;
+}
+
+/// \brief Read a u64 from the specified istream
+static uint64_t read_u64(istream &prm_istream ///< The istream from which to read
+                         ) {
+	return decode_le<uint64_t>( read_bytes( prm_istream, sizeof( uint64_t ) ), 0 );
+}
+
+/// \brief Read a column of the specified number of values of type Stored from the specified istream
+///        (including any padding), converting each to type T
+template <typename Stored, typename T = Stored>
+static vector<T> read_column(istream      &prm_istream,   ///< The istream from which to read
+                             const size_t &prm_num_values ///< The number of values in the column
+                             ) {
+	const size_t num_bytes = prm_num_values * sizeof( Stored );
+	const string bytes     = read_bytes( prm_istream, ( num_bytes + CRH_COLUMNAR_ALIGNMENT - 1 ) / CRH_COLUMNAR_ALIGNMENT * CRH_COLUMNAR_ALIGNMENT );
+	vector<T> values;
+	values.reserve( prm_num_values );
+	for (size_t value_ctr = 0; value_ctr < prm_num_values; ++value_ctr) {
+		values.push_back( static_cast<T>( decode_le<Stored>( bytes, value_ctr * sizeof( Stored ) ) ) );
+	}
+	return values;
+}
+
+/// \brief Read a column of doubles of the specified length from the specified istream
+static doub_vec read_double_column(istream      &prm_istream,   ///< The istream from which to read
+                                   const size_t &prm_num_values ///< The number of values in the column
+                                   ) {
+	doub_vec values;
+	values.reserve( prm_num_values );
+	for (const uint64_t &bits : read_column<uint64_t>( prm_istream, prm_num_values ) ) {
+		double value;
+		std::memcpy( &value, &bits, sizeof( value ) );
+		values.push_back( value );
+	}
+	return values;
+}
+
+/// \brief Read the segments columns (offsets, starts and stops) from the specified istream and append each row's segments
+static void read_segments_columns(istream                &prm_istream,  ///< The istream from which to read
+                                  const size_t           &prm_num_rows, ///< The number of rows in the row group
+                                  const size_t           &prm_num_segs, ///< The number of segments in the row group
+                                  vector<seq_seg_vec>    &prm_segments  ///< The per-row segments to which this row group's rows' segments should be appended
+                                  ) {
+	const auto offsets = read_column<uint32_t>( prm_istream, prm_num_rows + 1 );
+	const auto starts  = read_column<uint32_t>( prm_istream, prm_num_segs     );
+	const auto stops   = read_column<uint32_t>( prm_istream, prm_num_segs     );
+	for (size_t row_ctr = 0; row_ctr < prm_num_rows; ++row_ctr) {
+		if ( offsets[ row_ctr ] > offsets[ row_ctr + 1 ] || offsets[ row_ctr + 1 ] > prm_num_segs ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception("Invalid segment offsets in cath-resolve-hits binary columnar data"));
+		}
+		seq_seg_vec row_segments;
+		for (size_t seg_ctr = offsets[ row_ctr ]; seg_ctr < offsets[ row_ctr + 1 ]; ++seg_ctr) {
+			row_segments.emplace_back( starts[ seg_ctr ], stops[ seg_ctr ] );
+		}
+		prm_segments.push_back( std::move( row_segments ) );
+	}
+}
+
+/// \brief Read the specified number of strings from the specified istream, stored as u32 offsets[N+1]
+///        into the specified number of characters (each block including any padding)
+static str_vec read_strings(istream      &prm_istream,     ///< The istream from which to read
+                            const size_t &prm_num_strings, ///< The number of strings
+                            const size_t &prm_num_chars    ///< The total number of characters in the strings
+                            ) {
+	const auto   offsets = read_column<uint32_t>( prm_istream, prm_num_strings + 1 );
+	const string chars   = read_bytes( prm_istream, ( prm_num_chars + CRH_COLUMNAR_ALIGNMENT - 1 ) / CRH_COLUMNAR_ALIGNMENT * CRH_COLUMNAR_ALIGNMENT );
+	str_vec strings;
+	strings.reserve( prm_num_strings );
+	for (size_t string_ctr = 0; string_ctr < prm_num_strings; ++string_ctr) {
+		if ( offsets[ string_ctr ] > offsets[ string_ctr + 1 ] || offsets[ string_ctr + 1 ] > prm_num_chars ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception("Invalid string offsets in cath-resolve-hits binary columnar data"));
+		}
+		strings.push_back( chars.substr( offsets[ string_ctr ], offsets[ string_ctr + 1 ] - offsets[ string_ctr ] ) );
+	}
+	return strings;
+}
+
+/// \brief Read cath-resolve-hits binary columnar data (as written by crh_columnar_encoder) from the specified istream
+///
+/// \relates crh_columnar_encoder
+crh_columnar_table cath::rslv::read_crh_columnar(istream &prm_istream ///< The istream from which to read the data
+                                                 ) {
+	const string header = read_bytes( prm_istream, CRH_COLUMNAR_HEADER_MAGIC.size() + 2 * sizeof( uint32_t ) );
+	if ( header.compare( 0, CRH_COLUMNAR_HEADER_MAGIC.size(), CRH_COLUMNAR_HEADER_MAGIC ) != 0 ) {
+		BOOST_THROW_EXCEPTION(runtime_error_exception("Data does not start with the cath-resolve-hits binary columnar magic"));
+	}
+	if ( decode_le<uint32_t>( header, CRH_COLUMNAR_HEADER_MAGIC.size() ) != CRH_COLUMNAR_FORMAT_VERSION ) {
+		BOOST_THROW_EXCEPTION(runtime_error_exception("Unsupported version of cath-resolve-hits binary columnar data"));
+	}
+
+	str_vec            query_dict;
+	str_vec            match_dict;
+	crh_columnar_table table;
+	while ( prm_istream.peek() != istream::traits_type::eof() ) {
+		if ( read_bytes( prm_istream, CRH_COLUMNAR_ROW_GROUP_MAGIC.size() ) != CRH_COLUMNAR_ROW_GROUP_MAGIC ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception("Unrecognised block in cath-resolve-hits binary columnar data"));
+		}
+
+		const size_t num_rows                  = numeric_cast<size_t>( read_u64( prm_istream ) );
+		const size_t num_segs                  = numeric_cast<size_t>( read_u64( prm_istream ) );
+		const size_t num_resolved_segs         = numeric_cast<size_t>( read_u64( prm_istream ) );
+		const size_t num_new_query_ids         = numeric_cast<size_t>( read_u64( prm_istream ) );
+		const size_t num_new_match_ids         = numeric_cast<size_t>( read_u64( prm_istream ) );
+		const size_t num_dict_chars            = numeric_cast<size_t>( read_u64( prm_istream ) );
+		const size_t num_aligned_regions_chars = numeric_cast<size_t>( read_u64( prm_istream ) );
+
+		str_vec new_ids = read_strings( prm_istream, num_new_query_ids + num_new_match_ids, num_dict_chars );
+		for (size_t id_ctr = 0; id_ctr < new_ids.size(); ++id_ctr) {
+			( id_ctr < num_new_query_ids ? query_dict : match_dict ).push_back( std::move( new_ids[ id_ctr ] ) );
+		}
+
+		const auto query_indices = read_column<uint32_t>( prm_istream, num_rows );
+		const auto match_indices = read_column<uint32_t>( prm_istream, num_rows );
+		const auto score_types   = read_column<uint8_t, hit_score_type>( prm_istream, num_rows );
+		const auto scores        = read_double_column( prm_istream, num_rows );
+		const auto cond_evalues  = read_double_column( prm_istream, num_rows );
+		const auto indp_evalues  = read_double_column( prm_istream, num_rows );
+		for (size_t row_ctr = 0; row_ctr < num_rows; ++row_ctr) {
+			if ( query_indices[ row_ctr ] >= query_dict.size() || match_indices[ row_ctr ] >= match_dict.size() ) {
+				BOOST_THROW_EXCEPTION(runtime_error_exception("Invalid dictionary index in cath-resolve-hits binary columnar data"));
+			}
+			table.query_ids.push_back   ( query_dict[ query_indices[ row_ctr ] ] );
+			table.match_ids.push_back   ( match_dict[ match_indices[ row_ctr ] ] );
+			table.score_types.push_back ( score_types [ row_ctr ] );
+			table.scores.push_back      ( scores      [ row_ctr ] );
+			table.cond_evalues.push_back( cond_evalues[ row_ctr ] );
+			table.indp_evalues.push_back( indp_evalues[ row_ctr ] );
+		}
+		read_segments_columns( prm_istream, num_rows, num_segs,          table.segments          );
+		read_segments_columns( prm_istream, num_rows, num_resolved_segs, table.resolved_segments );
+		for (string &aligned_regions : read_strings( prm_istream, num_rows, num_aligned_regions_chars ) ) {
+			table.aligned_regions.push_back( std::move( aligned_regions ) );
+		}
+	}
+	return table;
+}
@@ -0,0 +1,181 @@
+/// \file
+/// \brief The crh_columnar_format header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_FILE_CRH_COLUMNAR_FORMAT_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_FILE_CRH_COLUMNAR_FORMAT_HPP
+
+#include "common/type_aliases.hpp"
+#include "resolve_hits/hit_score_type.hpp"
+#include "resolve_hits/options/spec/hit_boundary_output.hpp"
+#include "resolve_hits/resolve_hits_type_aliases.hpp"
+#include "seq/seq_seg.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cath { namespace rslv { class crh_segment_spec; } }
+namespace cath { namespace rslv { class full_hit_list; } }
+
+namespace cath {
+	namespace rslv {
+
+		/// \brief Encode resolved hits in the cath-resolve-hits binary columnar format
+		///
+		/// This provides the same information as the standard hits-text output but in a form that
+		/// downstream loaders can use directly (eg via a memory map) without any text parsing.
+		///
+		/// All integers are little-endian and every block starts on an 8-byte boundary
+		/// (blocks are zero-padded at the end as necessary). A file is:
+		///
+		///  * a header: the magic `CRHCOLS\0`, a u32 format version (1) and a reserved u32 (0)
+		///  * any number of row groups (up to the end of the file), each being:
+		///    * the magic `CRHRGRP\0`
+		///    * u64 counts: rows (R), segments (S), resolved segments (T),
+		///      new query IDs (Q), new match IDs (M), dictionary characters (C)
+		///      and aligned-regions characters (A)
+		///    * the new dictionary entries: u32 offsets[Q+M+1] into char[C] (the new query IDs then the new match IDs)
+		///    * the columns: u32 query_idx[R], u32 match_idx[R], u8 score_type[R], f64 score[R],
+		///      f64 cond_evalue[R], f64 indp_evalue[R] (NaN where absent),
+		///      u32 seg_offsets[R+1], u32 seg_starts[S], u32 seg_stops[S],
+		///      u32 resolved_offsets[R+1], u32 resolved_starts[T], u32 resolved_stops[T],
+		///      u32 aligned_regions_offsets[R+1], char aligned_regions[A]
+		///
+		/// There's no footer because a hits_processor can't know which of its calls to
+		/// finish_work() is the last, so the row groups just run to the end of the file.
+		///
+		/// The query/match IDs are dictionary-encoded: each row group introduces the dictionary
+		/// entries that are new in that row group, which take the next indices after those
+		/// from previous row groups. Each query's rows are contiguous and each query is added
+		/// to the dictionary once. The score_type values are those of hit_score_type.
+		/// The segment starts/stops are as in the hits-text output (trimmed if requested).
+		/// Each row's aligned regions are the hits-text output's aligned-regions string
+		/// (empty where absent).
+		class crh_columnar_encoder final {
+		private:
+			/// \brief The number of query IDs that have been assigned indices so far
+			size_t num_query_ids = 0;
+
+			/// \brief The index assigned to each match's label ID
+			std::unordered_map<hitlbl_t, uint32_t> match_index_of_label;
+
+			/// \brief The query IDs that are new in the pending row group
+			str_vec               new_query_ids;
+
+			/// \brief The match IDs that are new in the pending row group
+			str_vec               new_match_ids;
+
+			/// \brief The pending rows' query indices
+			std::vector<uint32_t> query_indices;
+
+			/// \brief The pending rows' match indices
+			std::vector<uint32_t> match_indices;
+
+			/// \brief The pending rows' score types
+			std::vector<uint8_t>  score_types;
+
+			/// \brief The pending rows' scores
+			doub_vec              scores;
+
+			/// \brief The pending rows' conditional evalues (NaN where absent)
+			doub_vec              cond_evalues;
+
+			/// \brief The pending rows' independent evalues (NaN where absent)
+			doub_vec              indp_evalues;
+
+			/// \brief The offsets of each pending row's segments in seg_starts/seg_stops
+			std::vector<uint32_t> seg_offsets{ 0 };
+
+			/// \brief The pending rows' segment starts
+			std::vector<uint32_t> seg_starts;
+
+			/// \brief The pending rows' segment stops
+			std::vector<uint32_t> seg_stops;
+
+			/// \brief The offsets of each pending row's resolved segments in resolved_starts/resolved_stops
+			std::vector<uint32_t> resolved_offsets{ 0 };
+
+			/// \brief The pending rows' resolved segment starts
+			std::vector<uint32_t> resolved_starts;
+
+			/// \brief The pending rows' resolved segment stops
+			std::vector<uint32_t> resolved_stops;
+
+			/// \brief The offsets of each pending row's aligned regions in aligned_regions_chars
+			std::vector<uint32_t> aligned_regions_offsets{ 0 };
+
+			/// \brief The pending rows' aligned regions strings, concatenated
+			std::string           aligned_regions_chars;
+
+			uint32_t match_index_of(const hitlbl_t &);
+
+		public:
+			static std::string header_bytes();
+
+			void add_query(const std::string &,
+			               const full_hit_list &,
+			               const crh_segment_spec &,
+			               const hit_boundary_output &);
+
+			size_t num_pending_rows() const;
+
+			std::string row_group_bytes();
+		};
+
+		/// \brief The contents of a cath-resolve-hits binary columnar file, expanded to one entry per row in each vector
+		///
+		/// This is mainly for testing and for smaller files; large files are better read column-by-column directly
+		struct crh_columnar_table final {
+			/// \brief The query ID of each row
+			str_vec                          query_ids;
+
+			/// \brief The match ID of each row
+			str_vec                          match_ids;
+
+			/// \brief The score type of each row
+			std::vector<hit_score_type>      score_types;
+
+			/// \brief The score of each row
+			doub_vec                         scores;
+
+			/// \brief The conditional evalue of each row (NaN where absent)
+			doub_vec                         cond_evalues;
+
+			/// \brief The independent evalue of each row (NaN where absent)
+			doub_vec                         indp_evalues;
+
+			/// \brief The segments of each row
+			std::vector<seq::seq_seg_vec>    segments;
+
+			/// \brief The resolved segments of each row
+			std::vector<seq::seq_seg_vec>    resolved_segments;
+
+			/// \brief The aligned regions of each row (empty where absent)
+			str_vec                          aligned_regions;
+		};
+
+		crh_columnar_table read_crh_columnar(std::istream &);
+
+	} // namespace rslv
+} // namespace cath
+
+#endif
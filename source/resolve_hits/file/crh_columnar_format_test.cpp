@@ -0,0 +1,141 @@
+/// \file
+/// \brief The crh_columnar_format test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/exception/runtime_error_exception.hpp"
+#include "resolve_hits/file/crh_columnar_format.hpp"
+#include "resolve_hits/full_hit.hpp"
+#include "resolve_hits/full_hit_list.hpp"
+#include "resolve_hits/hit_extras.hpp"
+#include "resolve_hits/options/spec/crh_segment_spec.hpp"
+#include "test/boost_addenda/boost_check_equal_ranges.hpp"
+
+#include <cmath>
+#include <sstream>
+
+namespace cath { namespace test { } }
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::seq;
+using namespace cath::test;
+
+using std::isnan;
+using std::istringstream;
+using std::string;
+
+namespace cath {
+	namespace test {
+
+		/// \brief The crh_columnar_format_test_suite_fixture to assist in testing crh_columnar_format
+		struct crh_columnar_format_test_suite_fixture {
+		protected:
+			~crh_columnar_format_test_suite_fixture() noexcept = default;
+
+			/// \brief Make an example full_hit_list for a first query
+			static full_hit_list make_eg_query_1_hits() {
+				return full_hit_list{ {
+					full_hit( { seq_seg{ 10, 50 }                     }, "match_a", 20.0, hit_score_type::BITSCORE, hit_extras_store{}.push_back<hit_extra_cat::COND_EVAL>( 1e-5 ).push_back<hit_extra_cat::INDP_EVAL>( 2e-3 ) ),
+					full_hit( { seq_seg{ 60, 80 }, seq_seg{ 90, 120 } }, "match_b", 21.0, hit_score_type::BITSCORE, hit_extras_store{}.push_back<hit_extra_cat::ALND_RGNS>( "61-80=1-20;91-120=21-50" )                        ),
+				} };
+			}
+
+			/// \brief Make an example full_hit_list for a second query
+			static full_hit_list make_eg_query_2_hits() {
+				return full_hit_list{ {
+					full_hit( { seq_seg{ 5, 25 } }, "match_b", 30.0 ),
+					full_hit( { seq_seg{ 30, 45 } }, "match_c", 31.0 ),
+				} };
+			}
+
+			/// \brief A segment spec that doesn't trim or alter the boundaries
+			const crh_segment_spec segment_spec = make_no_action_crh_segment_spec();
+		};
+
+	}  // namespace test
+}  // namespace cath
+
+BOOST_FIXTURE_TEST_SUITE(crh_columnar_format_test_suite, crh_columnar_format_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(blocks_are_aligned) {
+	crh_columnar_encoder encoder;
+	encoder.add_query( "query_1", make_eg_query_1_hits(), segment_spec, hit_boundary_output::ORIG );
+	BOOST_CHECK_EQUAL( crh_columnar_encoder::header_bytes().size() % 8, 0 );
+	BOOST_CHECK_EQUAL( encoder.row_group_bytes().size()            % 8, 0 );
+}
+
+BOOST_AUTO_TEST_CASE(empty_data_round_trips) {
+	istringstream in_ss{ crh_columnar_encoder::header_bytes() };
+	const crh_columnar_table table = read_crh_columnar( in_ss );
+	BOOST_CHECK( table.query_ids.empty() );
+	BOOST_CHECK( table.segments.empty()  );
+}
+
+BOOST_AUTO_TEST_CASE(round_trips_across_row_groups) {
+	crh_columnar_encoder encoder;
+	string bytes = crh_columnar_encoder::header_bytes();
+	encoder.add_query( "query_1", make_eg_query_1_hits(), segment_spec, hit_boundary_output::ORIG );
+	BOOST_CHECK_EQUAL( encoder.num_pending_rows(), 2 );
+	bytes += encoder.row_group_bytes();
+	BOOST_CHECK_EQUAL( encoder.num_pending_rows(), 0 );
+	encoder.add_query( "query_2", make_eg_query_2_hits(), segment_spec, hit_boundary_output::ORIG );
+	encoder.add_query( "query_3", full_hit_list{},        segment_spec, hit_boundary_output::ORIG );
+	bytes += encoder.row_group_bytes();
+
+	istringstream in_ss{ bytes };
+	const crh_columnar_table table = read_crh_columnar( in_ss );
+
+	BOOST_CHECK_EQUAL_RANGES( table.query_ids,   str_vec{ "query_1", "query_1", "query_2", "query_2" } );
+	BOOST_CHECK_EQUAL_RANGES( table.match_ids,   str_vec{ "match_a", "match_b", "match_b", "match_c" } );
+	BOOST_CHECK_EQUAL_RANGES( table.scores,      doub_vec{ 20.0, 21.0, 30.0, 31.0 } );
+	BOOST_REQUIRE_EQUAL     ( table.score_types.size(), 4 );
+	BOOST_CHECK             ( table.score_types.front() == hit_score_type::BITSCORE  );
+	BOOST_CHECK             ( table.score_types.back()  == hit_score_type::CRH_SCORE );
+
+	BOOST_CHECK_EQUAL( table.cond_evalues[ 0 ], 1e-5 );
+	BOOST_CHECK_EQUAL( table.indp_evalues[ 0 ], 2e-3 );
+	BOOST_CHECK      ( isnan( table.cond_evalues[ 1 ] ) );
+	BOOST_CHECK      ( isnan( table.indp_evalues[ 3 ] ) );
+
+	BOOST_REQUIRE_EQUAL     ( table.segments.size(), 4 );
+	BOOST_CHECK_EQUAL_RANGES( table.segments[ 1 ], seq_seg_vec{ seq_seg{ 60, 80 }, seq_seg{ 90, 120 } } );
+	BOOST_CHECK_EQUAL_RANGES( table.segments[ 3 ], seq_seg_vec{ seq_seg{ 30, 45 }                     } );
+	BOOST_REQUIRE_EQUAL     ( table.resolved_segments.size(), 4 );
+	BOOST_CHECK_EQUAL_RANGES( table.resolved_segments[ 1 ], table.segments[ 1 ] );
+
+	BOOST_CHECK_EQUAL_RANGES( table.aligned_regions, str_vec{ "", "61-80=1-20;91-120=21-50", "", "" } );
+}
+
+BOOST_AUTO_TEST_CASE(rejects_data_without_magic) {
+	istringstream in_ss{ "This isn't cath-resolve-hits binary columnar data" };
+	BOOST_CHECK_THROW( read_crh_columnar( in_ss ), runtime_error_exception );
+}
+
+BOOST_AUTO_TEST_CASE(rejects_truncated_data) {
+	crh_columnar_encoder encoder;
+	encoder.add_query( "query_1", make_eg_query_1_hits(), segment_spec, hit_boundary_output::ORIG );
+	const string row_group = encoder.row_group_bytes();
+	istringstream in_ss{ crh_columnar_encoder::header_bytes() + row_group.substr( 0, row_group.size() / 2 ) };
+	BOOST_CHECK_THROW( read_crh_columnar( in_ss ), runtime_error_exception );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
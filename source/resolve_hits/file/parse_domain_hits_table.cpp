@@ -151,7 +151,7 @@ void cath::rslv::parse_domain_hits_table(read_and_process_mgr &prm_read_and_proc
 		prm_read_and_process_mgr.add_hit(
 			target_id_str_ref,
 			{ { seq_seg{ arrow_before_res( start ), arrow_after_res ( stop  ) } } },
-			string{ query_field_itrs.first, query_field_itrs.second },
+			query_id_str_ref,
 			bitscore / bitscore_divisor( prm_apply_cath_policies, evalues_are_susp ),
 			hit_score_type::BITSCORE,
 			std::move( extras_store )
@@ -22,6 +22,7 @@
 #define _CATH_TOOLS_SOURCE_RESOLVE_HITS_FIRST_HIT_IS_BETTER_HPP
 
 #include <boost/logic/tribool.hpp>
+#include <boost/utility/string_ref.hpp>
 
 #include "common/boost_addenda/tribool/tribool.hpp"
 #include "resolve_hits/calc_hit.hpp"
@@ -98,10 +99,10 @@ namespace cath {
 			// Otherwise, both score and segments are equal so...
 
 			/// Compare labels and then label indices
-			const hitidx_t    &idx_lhs   = prm_lhs.get_label_idx();
-			const hitidx_t    &idx_rhs   = prm_rhs.get_label_idx();
-			const std::string &label_lhs = prm_full_hits[ idx_lhs ].get_label();
-			const std::string &label_rhs = prm_full_hits[ idx_rhs ].get_label();
+			const hitidx_t          &idx_lhs   = prm_lhs.get_label_idx();
+			const hitidx_t          &idx_rhs   = prm_rhs.get_label_idx();
+			const boost::string_ref  label_lhs = prm_full_hits[ idx_lhs ].get_label();
+			const boost::string_ref  label_rhs = prm_full_hits[ idx_rhs ].get_label();
 			return ( std::tie( label_lhs, idx_lhs ) < std::tie( label_rhs, idx_rhs ) ) ? boost::logic::tribool{ true  } :
 			       ( std::tie( label_lhs, idx_lhs ) > std::tie( label_rhs, idx_rhs ) ) ? boost::logic::tribool{ false } :
 			                                                                             boost::logic::indeterminate;
@@ -172,9 +173,12 @@ namespace cath {
 
 			// Otherwise, both score and segments are equal so...
 
-			/// Compare labels and then label indices
-			const std::string &label_lhs = prm_lhs.get_label();
-			const std::string &label_rhs = prm_rhs.get_label();
+			/// Compare labels (which are only looked up if their interned IDs differ)
+			if ( prm_lhs.get_label_id() == prm_rhs.get_label_id() ) {
+				return boost::logic::indeterminate;
+			}
+			const boost::string_ref label_lhs = prm_lhs.get_label();
+			const boost::string_ref label_rhs = prm_rhs.get_label();
 			return ( label_lhs < label_rhs ) ? boost::logic::tribool{ true  } :
 			       ( label_lhs > label_rhs ) ? boost::logic::tribool{ false } :
 			                                   boost::logic::indeterminate;
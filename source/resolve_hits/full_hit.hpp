@@ -23,9 +23,11 @@
 
 #include <boost/operators.hpp>
 #include <boost/optional.hpp>
+#include <boost/utility/string_ref.hpp>
 
 #include "resolve_hits/file/alnd_rgn.hpp"
 #include "resolve_hits/hit_extras.hpp"
+#include "resolve_hits/hit_label_table.hpp"
 #include "resolve_hits/hit_score_type.hpp"
 #include "resolve_hits/resolve_hits_type_aliases.hpp"
 #include "seq/seq_seg.hpp"
@@ -47,8 +49,10 @@ namespace cath {
 			/// \brief The list of segments
 			seq::seq_seg_vec segments;
 
-			/// \brief The label for this full_hit
-			std::string label;
+			/// \brief The ID of the label for this full_hit in the global_hit_label_table()
+			///
+			/// The same labels recur across very many hits so this just stores the interned ID
+			hitlbl_t label_id;
 
 			/// \brief The score associated with this full_hit
 			///
@@ -65,13 +69,14 @@ namespace cath {
 
 		public:
 			full_hit(seq::seq_seg_vec,
-			         std::string,
+			         const boost::string_ref &,
 			         const double &,
 			         const hit_score_type & = hit_score_type::CRH_SCORE,
 			         hit_extras_store = {});
 
 			const seq::seq_seg_vec & get_segments() const;
-			const std::string & get_label() const;
+			const hitlbl_t & get_label_id() const;
+			boost::string_ref get_label() const;
 			const double & get_score() const;
 			const hit_score_type & get_score_type() const;
 			const hit_extras_store & get_extras_store() const;
@@ -101,7 +106,7 @@ namespace cath {
 				if ( score_type != hit_score_type::FULL_EVALUE || the_score < 0 ) {
 					BOOST_THROW_EXCEPTION(common::invalid_argument_exception(
 						"Hit with label "
-						+ get_label()
+						+ get_label().to_string()
 						+ " cannot be processed because its "
 						+ to_string( get_score_type() )
 						+ " score of "
@@ -113,16 +118,16 @@ namespace cath {
 		}
 
 		/// \brief Ctor
-		inline full_hit::full_hit(seq::seq_seg_vec      prm_segments,     ///< The segments of the full_hit
-		                          std::string           prm_label,        ///< The label of the hits' match protein
-		                          const double         &prm_score,        ///< The score associated with the full_hit
-		                          const hit_score_type &prm_score_type,   ///< The type of score stored in this hit (eg evalue / bitscore / crh-score)
-		                          hit_extras_store      prm_extras_store  ///< The store of any extra pieces of information associated with the hit
-		                          ) : segments     { std::move( prm_segments     ) },
-		                              label        { std::move( prm_label        ) },
-		                              the_score    { prm_score                     },
-		                              score_type   { prm_score_type                },
-		                              extras_store { std::move( prm_extras_store ) } {
+		inline full_hit::full_hit(seq::seq_seg_vec         prm_segments,     ///< The segments of the full_hit
+		                          const boost::string_ref &prm_label,        ///< The label of the hits' match protein
+		                          const double            &prm_score,        ///< The score associated with the full_hit
+		                          const hit_score_type    &prm_score_type,   ///< The type of score stored in this hit (eg evalue / bitscore / crh-score)
+		                          hit_extras_store         prm_extras_store  ///< The store of any extra pieces of information associated with the hit
+		                          ) : segments     { std::move( prm_segments     )     },
+		                              label_id     { add_global_hit_label( prm_label ) },
+		                              the_score    { prm_score                         },
+		                              score_type   { prm_score_type                    },
+		                              extras_store { std::move( prm_extras_store )     } {
 			sanity_check();
 		}
 
@@ -131,9 +136,14 @@ namespace cath {
 			return segments;
 		}
 		
+		/// \brief Getter for the ID of the label of the hits' match protein in the global_hit_label_table()
+		inline const hitlbl_t & full_hit::get_label_id() const {
+			return label_id;
+		}
+
 		/// \brief Getter for the label of the hits' match protein
-		inline const std::string & full_hit::get_label() const {
-			return label;
+		inline boost::string_ref full_hit::get_label() const {
+			return get_global_hit_label( label_id );
 		}
 
 		/// \brief Getter for the score associated with the full_hit
@@ -162,7 +172,7 @@ namespace cath {
 			return (
 				( prm_lhs.get_segments()                  == prm_rhs.get_segments()                  )
 				&&
-				( prm_lhs.get_label()                     == prm_rhs.get_label()                     )
+				( prm_lhs.get_label_id()                  == prm_rhs.get_label_id()                  )
 				&&
 				( prm_lhs.get_score()                     == prm_rhs.get_score()                     )
 				&&
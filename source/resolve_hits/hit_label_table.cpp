@@ -0,0 +1,83 @@
+/// \file
+/// \brief The hit_label_table class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "hit_label_table.hpp"
+
+#include "common/exception/out_of_range_exception.hpp"
+
+#include <limits>
+#include <mutex>
+
+using namespace cath::common;
+using namespace cath::rslv;
+
+using boost::string_ref;
+using std::numeric_limits;
+using std::shared_lock;
+using std::shared_timed_mutex;
+using std::to_string;
+using std::unique_lock;
+
+/// \brief Add the specified label (if it isn't already present) and return its ID
+///
+/// This only takes an exclusive lock if the label isn't already present
+hitlbl_t hit_label_table::add_label(const string_ref &prm_label ///< The label to add
+                                    ) {
+	{
+		const shared_lock<shared_timed_mutex> the_lock{ labels_mutex };
+		const auto id_opt = labels.find_id_of_name( prm_label );
+		if ( id_opt ) {
+			return static_cast<hitlbl_t>( *id_opt );
+		}
+	}
+
+	const unique_lock<shared_timed_mutex> the_lock{ labels_mutex };
+	const size_t id = labels.add_name( prm_label );
+	if ( id > numeric_limits<hitlbl_t>::max() ) {
+		BOOST_THROW_EXCEPTION(out_of_range_exception(
+			"Unable to store more than "
+			+ to_string( numeric_limits<hitlbl_t>::max() )
+			+ " distinct hit labels"
+		));
+	}
+	return static_cast<hitlbl_t>( id );
+}
+
+/// \brief Get the number of distinct labels that have been stored
+size_t hit_label_table::size() const {
+	const shared_lock<shared_timed_mutex> the_lock{ labels_mutex };
+	return labels.size();
+}
+
+/// \brief Get the global hit_label_table, in which full_hit stores its labels
+///
+/// \relates hit_label_table
+hit_label_table & cath::rslv::global_hit_label_table() {
+	static hit_label_table the_table;
+	return the_table;
+}
+
+/// \brief Add the specified label to the global hit_label_table (if it isn't already present) and return its ID
+///
+/// \relates hit_label_table
+hitlbl_t cath::rslv::add_global_hit_label(const string_ref &prm_label ///< The label to add
+                                          ) {
+	return global_hit_label_table().add_label( prm_label );
+}
@@ -0,0 +1,92 @@
+/// \file
+/// \brief The hit_label_table class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_HIT_LABEL_TABLE_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_HIT_LABEL_TABLE_HPP
+
+#include <boost/utility/string_ref.hpp>
+
+#include "common/container/id_of_str_bidirnl.hpp"
+#include "resolve_hits/resolve_hits_type_aliases.hpp"
+
+#include <shared_mutex>
+#include <string>
+
+namespace cath {
+	namespace rslv {
+
+		/// \brief Intern the match labels of hits so that each hit need only store a hitlbl_t
+		///
+		/// The same few hundred thousand match labels (eg HMM names) recur across
+		/// very many hits so it's much cheaper to store each one once and have the hits
+		/// just store the label's ID. The IDs are only resolved back to names when
+		/// they're needed (eg when writing output or when breaking ties between hits).
+		///
+		/// This is thread-safe: the parsing thread may be adding labels whilst a worker
+		/// thread is resolving a previous query's hits. It's optimised for lookups,
+		/// which only take a shared lock.
+		///
+		/// The string_refs returned by get_label_of_id() remain valid for the lifetime
+		/// of the table because the underlying id_of_str_bidirnl stores the names'
+		/// characters in a string_arena, which doesn't move them as it grows.
+		class hit_label_table final {
+		private:
+			/// \brief The mutex to protect the labels
+			mutable std::shared_timed_mutex labels_mutex;
+
+			/// \brief The bidirectional lookup between labels and their IDs
+			common::id_of_str_bidirnl labels;
+
+		public:
+			hit_label_table() = default;
+			hit_label_table(const hit_label_table &) = delete;
+			hit_label_table & operator=(const hit_label_table &) = delete;
+
+			hitlbl_t add_label(const boost::string_ref &);
+			boost::string_ref get_label_of_id(const hitlbl_t &) const;
+			size_t size() const;
+		};
+
+		hit_label_table & global_hit_label_table();
+
+		hitlbl_t add_global_hit_label(const boost::string_ref &);
+		boost::string_ref get_global_hit_label(const hitlbl_t &);
+
+		/// \brief Get the label corresponding to the specified ID
+		///
+		/// \pre The ID must have been returned by add_label() on this hit_label_table
+		inline boost::string_ref hit_label_table::get_label_of_id(const hitlbl_t &prm_label_id ///< The ID of the label to return
+		                                                          ) const {
+			const std::shared_lock<std::shared_timed_mutex> the_lock{ labels_mutex };
+			return labels.get_name_of_id( prm_label_id );
+		}
+
+		/// \brief Get the label in the global hit_label_table corresponding to the specified ID
+		///
+		/// \relates hit_label_table
+		inline boost::string_ref get_global_hit_label(const hitlbl_t &prm_label_id ///< The ID of the label to return
+		                                              ) {
+			return global_hit_label_table().get_label_of_id( prm_label_id );
+		}
+
+	} // namespace rslv
+} // namespace cath
+
+#endif
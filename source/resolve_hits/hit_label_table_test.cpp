@@ -0,0 +1,60 @@
+/// \file
+/// \brief The hit_label_table test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/size_t_literal.hpp"
+#include "resolve_hits/full_hit.hpp"
+#include "resolve_hits/hit_label_table.hpp"
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::seq;
+
+using std::string;
+
+BOOST_AUTO_TEST_SUITE(hit_label_table_test_suite)
+
+BOOST_AUTO_TEST_CASE(add_label_returns_stable_ids) {
+	hit_label_table the_table;
+	const hitlbl_t badger_id = the_table.add_label( "badger" );
+	const hitlbl_t ferret_id = the_table.add_label( "ferret" );
+
+	BOOST_CHECK_NE   ( badger_id, ferret_id                     );
+	BOOST_CHECK_EQUAL( the_table.add_label( "badger" ), badger_id );
+	BOOST_CHECK_EQUAL( the_table.size(), 2_z                      );
+
+	BOOST_CHECK_EQUAL( the_table.get_label_of_id( badger_id ), "badger" );
+	BOOST_CHECK_EQUAL( the_table.get_label_of_id( ferret_id ), "ferret" );
+}
+
+BOOST_AUTO_TEST_CASE(full_hits_with_same_label_share_label_id) {
+	const full_hit hit_a{ { seq_seg{  10,  50 } }, "otter", 1.0 };
+	const full_hit hit_b{ { seq_seg{ 100, 150 } }, string{ "otter" }, 2.0 };
+	const full_hit hit_c{ { seq_seg{  10,  50 } }, "stoat", 1.0 };
+
+	BOOST_CHECK_EQUAL( hit_a.get_label_id(), hit_b.get_label_id() );
+	BOOST_CHECK_NE   ( hit_a.get_label_id(), hit_c.get_label_id() );
+	BOOST_CHECK_EQUAL( hit_b.get_label(),    "otter"              );
+	BOOST_CHECK_EQUAL( hit_c.get_label(),    "stoat"              );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
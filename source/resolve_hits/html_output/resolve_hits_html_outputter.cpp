@@ -245,7 +245,7 @@ string resolve_hits_html_outputter::hit_html(const html_hit         &prm_html_hi
 							//     })
 							{
 								make_pair( "crh-hit-id"s,                                 "batch" + batch_idx_str + "-hit" + hit_idx_str ),
-								make_pair( "crh-hit-"  + full_hit::get_label_name(),      the_full_hit.get_label() ),
+								make_pair( "crh-hit-"  + full_hit::get_label_name(),      the_full_hit.get_label().to_string() ),
 								make_pair( "crh-hit-"s + full_hit::get_segments_name(),   join( boundaries_strs, ", " ) ),
 								make_pair( "crh-hit-"  + full_hit::get_score_name(),      ::std::to_string( the_full_hit.get_score() ) ),
 								make_pair( "crh-hit-"  + full_hit::get_score_type_name(), to_string( the_full_hit.get_score_type() ) ),
@@ -297,7 +297,7 @@ string resolve_hits_html_outputter::hits_row_html(const html_hit_vec     &prm_fu
 	// For strictly-worse rows, can set: background-color: #ddd; color: #999;
 	return R"(<tr )" + row_css_class_and_data_of_hit_row_context( prm_row_context ) + R"(>
 	<td class="crh-cell crh-cell-data )" + first_cell_css_class_of_hit_row_context( prm_row_context ) + R"(">
-		)" + ( isnt_full_result ? dumb_html_escape_copy( first_hit.get_label() ) : "&nbsp;"s ) + R"(
+		)" + ( isnt_full_result ? dumb_html_escape_copy( first_hit.get_label().to_string() ) : "&nbsp;"s ) + R"(
 	</td>
 	<td class="crh-cell crh-cell-data">
 		<div class="crh-figure-div-line">
@@ -362,8 +362,9 @@ string resolve_hits_html_outputter::hits_row_html(const html_hit_vec     &prm_fu
 </tr>)";
 }
 
-/// \brief Generate the HTML prefix string
-string resolve_hits_html_outputter::html_prefix() {
+/// \brief Generate the HTML prefix string, with the specified HTML for the CSS inserted at the start of the body
+string resolve_hits_html_outputter::html_prefix_with_css_html(const string &prm_css_html ///< The HTML that provides the CSS (eg a style element or a link to a stylesheet)
+                                                              ) {
 	return R"(<!DOCTYPE html>
 <html lang="en">
 
@@ -450,13 +451,30 @@ string resolve_hits_html_outputter::html_prefix() {
 
 <body class="crh-body">
 
-<style>
+)"
+	+ prm_css_html;
+}
 
+/// \brief Generate the HTML prefix string, with the CSS inline
+string resolve_hits_html_outputter::html_prefix() {
+	return html_prefix_with_css_html(
+		"<style>\n\n"
+		+ css_string()
+		+ "\n</style>\n"
+	);
+}
+
+/// \brief Generate the HTML prefix string, linking to the CSS at the specified href rather than including it inline
+///
+/// This avoids repeating the CSS in each of many HTML files
+string resolve_hits_html_outputter::html_prefix(const string &prm_css_href ///< The href of the CSS file (as written by css_string())
+                                                ) {
+	return html_prefix_with_css_html(
+		R"(<link rel="stylesheet" href=")"
+		+ dumb_html_escape_copy( prm_css_href )
+		+ R"(">
 )"
-	+ css_string()
-	+ R"(
-</style>
-)";
+	);
 }
 
 /* .crh-hit-pill-core:hover {
@@ -500,6 +518,56 @@ string resolve_hits_html_outputter::html_suffix() {
 )";
 }
 
+/// \brief Generate the prefix of an index page that links to a page for each query
+string resolve_hits_html_outputter::index_prefix(const string &prm_css_href ///< The href of the CSS file (as written by css_string())
+                                                 ) {
+	return R"(<!DOCTYPE html>
+<html lang="en">
+
+<head>
+	<meta charset="utf-8">
+	<title>cath-resolve-hits</title>
+	<link rel="stylesheet" href=")" + dumb_html_escape_copy( prm_css_href ) + R"(">
+</head>
+
+<body class="crh-body">
+
+<div class="crh-advert-div">
+	<span class="crh-advert-span">
+		Generated by <a href="http://cath-tools.readthedocs.io/en/latest/tools/cath-resolve-hits/">cath-resolve-hits</a>,
+		one of the <a href="https://github.com/UCLOrengoGroup/cath-tools">cath-tools</a>
+	</span>
+</div>
+
+<h3 class="crh-query-header">Queries</h3>
+<ul class="crh-index-list">
+)";
+}
+
+/// \brief Generate the index page entry for the specified query
+string resolve_hits_html_outputter::index_entry_html(const string &prm_query_id, ///< The query ID
+                                                     const string &prm_href,     ///< The href of the query's page
+                                                     const size_t &prm_num_hits  ///< The number of input hits for the query
+                                                     ) {
+	return R"(	<li><a href=")"
+		+ dumb_html_escape_copy( prm_href )
+		+ R"(">)"
+		+ dumb_html_escape_copy( prm_query_id )
+		+ "</a> ("
+		+ std::to_string( prm_num_hits )
+		+ " hits)</li>\n";
+}
+
+/// \brief Generate the suffix of an index page that links to a page for each query
+string resolve_hits_html_outputter::index_suffix() {
+	return R"(</ul>
+
+</body>
+
+</html>
+)";
+}
+
 /// \brief Generate the CSS string
 string resolve_hits_html_outputter::css_string() {
 	return R"(/* --- Start of simple reset --- */
@@ -837,7 +905,8 @@ string resolve_hits_html_outputter::output_html(const string           &prm_quer
                                                 const crh_html_spec    &prm_html_spec,        ///< The specification for how to render the HTML
                                                 const bool             &prm_output_head_tail, ///< Whether to include the head and tail (ie prefix and suffix) in the output
                                                 const crh_filter_spec  &prm_filter_spec,      ///< The crh_filter_spec defining which input hits will be skipped by the algorithm
-                                                const size_t           &prm_batch_index       ///< The index of the batch of hits being output (used to allow hits' HTML to have unique data attributes)
+                                                const size_t           &prm_batch_index,      ///< The index of the batch of hits being output (used to allow hits' HTML to have unique data attributes)
+                                                const str_opt          &prm_all_hits_href     ///< An optional href of a page showing all the hits, to which to link if some hits are hidden
                                                 ) {
 	const auto  filtered_grey     = display_colour{ 0.666, 0.666, 0.666 };
 	const auto &the_full_hit_list = prm_calc_hit_list.get_full_hits();
@@ -1059,7 +1128,13 @@ string resolve_hits_html_outputter::output_html(const string           &prm_quer
 					+ std::to_string( prm_html_spec.get_max_num_non_soln_hits() )
 					+ R"(; use <code>--)"
 					+ crh_html_options_block::PO_MAX_NUM_NON_SOLN_HITS
-					+ R"(</code> to change)</div>)"
+					+ R"(</code> to change))"
+					+ (
+						prm_all_hits_href
+							? R"( <a class="crh-exclusion-more-link" href=")" + dumb_html_escape_copy( *prm_all_hits_href ) + R"(">show all hits</a>)"
+							: ""s
+					)
+					+ R"(</div>)"
 				)
 		)
 		+ R"(
@@ -81,13 +81,22 @@ namespace cath {
 			                                 const size_t &,
 			                                 const hit_row_context &);
 
+			static std::string html_prefix_with_css_html(const std::string &);
+
 		public:
 			static std::string html_prefix();
+			static std::string html_prefix(const std::string &);
 			static std::string html_key();
 			static std::string html_suffix();
 
 			static std::string css_string();
 
+			static std::string index_prefix(const std::string &);
+			static std::string index_entry_html(const std::string &,
+			                                    const std::string &,
+			                                    const size_t &);
+			static std::string index_suffix();
+
 			static size_t step_for_length(const size_t &);
 
 			static std::string output_html(const std::string &,
@@ -115,9 +124,8 @@ namespace cath {
 			                               const crh_html_spec & = crh_html_spec{},
 			                               const bool & = true,
 			                               const crh_filter_spec & = make_accept_all_filter_spec(),
-			                               const size_t & = 0);
-
-			
+			                               const size_t & = 0,
+			                               const str_opt & = boost::none);
 		};
 
 	} // namespace rslv
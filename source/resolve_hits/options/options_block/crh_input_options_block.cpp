@@ -21,6 +21,7 @@
 #include "crh_input_options_block.hpp"
 
 #include <boost/algorithm/string/join.hpp>
+#include <boost/filesystem/path.hpp>
 
 #include "common/boost_addenda/program_options/layout_values_with_descs.hpp"
 #include "common/clone/make_uptr_clone.hpp"
@@ -36,6 +37,7 @@ using namespace cath::seq;
 using namespace std::literals::string_literals;
 
 using boost::algorithm::join;
+using boost::filesystem::path;
 using boost::program_options::bool_switch;
 using boost::program_options::options_description;
 using boost::program_options::value;
@@ -56,6 +58,9 @@ const string crh_input_options_block::PO_MIN_GAP_LENGTH         { "min-gap-lengt
 /// \brief The option name for whether the code can assume that the input data is pre-grouped by query_id
 const string crh_input_options_block::PO_INPUT_HITS_ARE_GROUPED { "input-hits-are-grouped" };
 
+/// \brief The option name for the optional file in which to cache resolutions between runs
+const string crh_input_options_block::PO_RESULT_CACHE_FILE      { "result-cache-file"      };
+
 /// \brief A standard do_clone method
 unique_ptr<options_block> crh_input_options_block::do_clone() const {
 	return { make_uptr_clone( *this ) };
@@ -75,10 +80,12 @@ void crh_input_options_block::do_add_visible_options_to_description(options_desc
 
 	const string format_varname { "<format>" };
 	const string length_varname { "<length>" };
+	const string file_varname   { "<file>"   };
 
 	const auto input_format_notifier           = [&] (const hits_input_format_tag &x) { the_spec.set_input_format          ( x ); };
 	const auto min_gap_length_notifier         = [&] (const residx_t              &x) { the_spec.set_min_gap_length        ( x ); };
 	const auto input_hits_are_grouped_notifier = [&] (const bool                  &x) { the_spec.set_input_hits_are_grouped( x ); };
+	const auto result_cache_file_notifier      = [&] (const path                  &x) { the_spec.set_result_cache_file     ( x ); };
 
 	const str_vec input_format_descs = layout_values_with_descs(
 		all_hits_input_format_tags,
@@ -113,6 +120,14 @@ void crh_input_options_block::do_add_visible_options_to_description(options_desc
 				->default_value( crh_input_spec::DEFAULT_INPUT_HITS_ARE_GROUPED ),
 			"Rely on the input hits being grouped by query protein"
 			"\n(so the run is faster and uses less memory)"
+		)
+		(
+			( PO_RESULT_CACHE_FILE ).c_str(),
+			value<path>()
+				->value_name   ( file_varname                                   )
+				->notifier     ( result_cache_file_notifier                     ),
+			( "Cache resolutions in " + file_varname + " (created if absent)"
+				"\n(so a rerun skips resolving queries whose hits and settings are unchanged)" ).c_str()
 		);
 
 	static_assert( ! crh_input_spec::DEFAULT_READ_FROM_STDIN,        "If crh_input_spec::DEFAULT_READ_FROM_STDIN        isn't false, it might mess up the bool switch in here" );
@@ -165,6 +180,7 @@ str_vec crh_input_options_block::do_get_all_options_names() const {
 		crh_input_options_block::PO_INPUT_FORMAT,
 		crh_input_options_block::PO_MIN_GAP_LENGTH,
 		crh_input_options_block::PO_INPUT_HITS_ARE_GROUPED,
+		crh_input_options_block::PO_RESULT_CACHE_FILE,
 	};
 }
 
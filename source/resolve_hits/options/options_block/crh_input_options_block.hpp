@@ -49,6 +49,7 @@ namespace cath {
 			static const std::string PO_INPUT_FORMAT;
 			static const std::string PO_MIN_GAP_LENGTH;
 			static const std::string PO_INPUT_HITS_ARE_GROUPED;
+			static const std::string PO_RESULT_CACHE_FILE;
 
 			const crh_input_spec & get_crh_input_spec() const;
 		};
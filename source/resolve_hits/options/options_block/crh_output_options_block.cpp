@@ -41,28 +41,40 @@ using std::string;
 using std::unique_ptr;
 
 /// \brief The option name for an optional file to which the hits text should be output
-const string crh_output_options_block::PO_HITS_TEXT_TO_FILE    { "hits-text-to-file"    };
+const string crh_output_options_block::PO_HITS_TEXT_TO_FILE       { "hits-text-to-file"       };
 
 /// \brief The option name for whether to suppress the default output of hits text to stdout
-const string crh_output_options_block::PO_QUIET                { "quiet"                };
+const string crh_output_options_block::PO_QUIET                   { "quiet"                   };
 
 /// \brief The option name for whether to output the hits starts/stops *after* trimming
-const string crh_output_options_block::PO_OUTPUT_TRIMMED_HITS  { "output-trimmed-hits"  };
+const string crh_output_options_block::PO_OUTPUT_TRIMMED_HITS     { "output-trimmed-hits"     };
 
 /// \brief The option name for an optional file to which a summary of the input data should be output
-const string crh_output_options_block::PO_SUMMARISE_TO_FILE    { "summarise-to-file"    };
+const string crh_output_options_block::PO_SUMMARISE_TO_FILE       { "summarise-to-file"       };
 
 /// \brief The option name for an optional file to which HTML should be output
-const string crh_output_options_block::PO_HTML_OUTPUT_TO_FILE  { "html-output-to-file"  };
+const string crh_output_options_block::PO_HTML_OUTPUT_TO_FILE     { "html-output-to-file"     };
+
+/// \brief The option name for an optional directory to which HTML should be output as an index page and a page per query
+const string crh_output_options_block::PO_HTML_OUTPUT_TO_DIR      { "html-output-to-dir"      };
 
 /// \brief The option name for an optional file to which JSON should be output
-const string crh_output_options_block::PO_JSON_OUTPUT_TO_FILE  { "json-output-to-file"  };
+const string crh_output_options_block::PO_JSON_OUTPUT_TO_FILE     { "json-output-to-file"     };
+
+/// \brief The option name for an optional file to which compact JSON Lines (one line per query) should be output
+const string crh_output_options_block::PO_JSONL_OUTPUT_TO_FILE    { "jsonl-output-to-file"    };
+
+/// \brief The option name for whether to gzip-compress the JSON Lines output
+const string crh_output_options_block::PO_GZIP_JSONL_OUTPUT       { "gzip-jsonl-output"       };
+
+/// \brief The option name for an optional file to which binary columnar output should be written
+const string crh_output_options_block::PO_COLUMNAR_OUTPUT_TO_FILE { "columnar-output-to-file" };
 
 /// \brief The option name for an optional file to which the CSS should be output
-const string crh_output_options_block::PO_EXPORT_CSS_FILE      { "export-css-file"      };
+const string crh_output_options_block::PO_EXPORT_CSS_FILE         { "export-css-file"         };
 
 /// \brief The option name for whether to output a summary of the HMMER alignment
-const string crh_output_options_block::PO_OUTPUT_HMMER_ALN     { "output-hmmer-aln"     };
+const string crh_output_options_block::PO_OUTPUT_HMMER_ALN        { "output-hmmer-aln"        };
 
 /// \brief A standard do_clone method
 unique_ptr<options_block> crh_output_options_block::do_clone() const {
@@ -79,13 +91,18 @@ void crh_output_options_block::do_add_visible_options_to_description(options_des
                                                                      const size_t        &/*prm_line_length*/ ///< The line length to be used when outputting the description (not very clearly documented in Boost)
                                                                      ) {
 	const string file_varname   { "<file>" };
+	const string dir_varname    { "<dir>"  };
 
 	const auto hits_text_files_notifier     = [&] (const path_vec &x) { the_spec.set_hits_text_files     ( x           ); };
 	const auto quiet_notifier               = [&] (const bool     &x) { the_spec.set_quiet               ( x           ); };
 	const auto output_trimmed_hits_notifier = [&] (const bool     &x) {          set_output_trimmed_hits ( the_spec, x ); };
 	const auto summarise_files_notifier     = [&] (const path_vec &x) { the_spec.set_summarise_files     ( x           ); };
 	const auto html_output_files_notifier   = [&] (const path_vec &x) { the_spec.set_html_output_files   ( x           ); };
+	const auto html_output_dir_notifier     = [&] (const path     &x) { the_spec.set_html_output_dir     ( x           ); };
 	const auto json_output_files_notifier   = [&] (const path_vec &x) { the_spec.set_json_output_files   ( x           ); };
+	const auto jsonl_output_files_notifier  = [&] (const path_vec &x) { the_spec.set_jsonl_output_files  ( x           ); };
+	const auto gzip_jsonl_output_notifier   = [&] (const bool     &x) { the_spec.set_gzip_jsonl_output   ( x           ); };
+	const auto columnar_output_notifier     = [&] (const path_vec &x) { the_spec.set_columnar_output_files( x          ); };
 	const auto export_css_file_notifier     = [&] (const path     &x) { the_spec.set_export_css_file     ( x           ); };
 
 	prm_desc.add_options()
@@ -127,6 +144,13 @@ void crh_output_options_block::do_add_visible_options_to_description(options_des
 				->notifier     ( html_output_files_notifier            ),
 			( "Write the results as HTML to file " + file_varname + " (or '-' for stdout)" ).c_str()
 		)
+		(
+			PO_HTML_OUTPUT_TO_DIR.c_str(),
+			value<path>()
+				->value_name   ( dir_varname                           )
+				->notifier     ( html_output_dir_notifier              ),
+			( "Write the results as HTML to directory " + dir_varname + " as an index page and a page per query, written as each query completes" ).c_str()
+		)
 		(
 			PO_JSON_OUTPUT_TO_FILE.c_str(),
 			value<path_vec>()
@@ -134,6 +158,27 @@ void crh_output_options_block::do_add_visible_options_to_description(options_des
 				->notifier     ( json_output_files_notifier            ),
 			( "Write the results as JSON to file " + file_varname + " (or '-' for stdout)" ).c_str()
 		)
+		(
+			PO_JSONL_OUTPUT_TO_FILE.c_str(),
+			value<path_vec>()
+				->value_name   ( file_varname                          )
+				->notifier     ( jsonl_output_files_notifier           ),
+			( "Write the results as compact JSON Lines (one line per query) to file " + file_varname + " (or '-' for stdout)" ).c_str()
+		)
+		(
+			PO_GZIP_JSONL_OUTPUT.c_str(),
+			bool_switch()
+				->notifier     ( gzip_jsonl_output_notifier                 )
+				->default_value( crh_output_spec::DEFAULT_GZIP_JSONL_OUTPUT ),
+			( "Gzip-compress the output of --" + PO_JSONL_OUTPUT_TO_FILE ).c_str()
+		)
+		(
+			PO_COLUMNAR_OUTPUT_TO_FILE.c_str(),
+			value<path_vec>()
+				->value_name   ( file_varname                          )
+				->notifier     ( columnar_output_notifier              ),
+			( "Write the resolved hits in a binary columnar format (see the docs) to file " + file_varname + " (or '-' for stdout)" ).c_str()
+		)
 		(
 			PO_EXPORT_CSS_FILE.c_str(),
 			value<path>()
@@ -146,6 +191,8 @@ void crh_output_options_block::do_add_visible_options_to_description(options_des
 		"If crh_output_spec::DEFAULT_QUIET                isn't false, it might mess up the bool switch in here" );
 	static_assert( ! means_output_trimmed_hits( crh_output_spec::DEFAULT_BOUNDARY_OUTPUT ),
 		"If crh_segment_spec::DEFAULT_OUTPUT_TRIMMED_HITS isn't false, it might mess up the bool switch in here" );
+	static_assert( !                            crh_output_spec::DEFAULT_GZIP_JSONL_OUTPUT,
+		"If crh_output_spec::DEFAULT_GZIP_JSONL_OUTPUT    isn't false, it might mess up the bool switch in here" );
 }
 
 /// \brief Add any hidden options to the provided options_description
@@ -225,7 +272,10 @@ str_vec crh_output_options_block::get_all_non_deprecated_option_names_that_clash
 		crh_output_options_block::PO_QUIET,
 		crh_output_options_block::PO_SUMMARISE_TO_FILE,
 		crh_output_options_block::PO_HTML_OUTPUT_TO_FILE,
+		crh_output_options_block::PO_HTML_OUTPUT_TO_DIR,
 		crh_output_options_block::PO_JSON_OUTPUT_TO_FILE,
+		crh_output_options_block::PO_JSONL_OUTPUT_TO_FILE,
+		crh_output_options_block::PO_COLUMNAR_OUTPUT_TO_FILE,
 	};
 }
 /// \brief Return all non-deprecated options names for this block that should clash with
@@ -238,6 +288,7 @@ str_vec crh_output_options_block::get_all_non_deprecated_option_names_that_do_no
 		crh_output_options_block::PO_OUTPUT_TRIMMED_HITS,
 		crh_output_options_block::PO_EXPORT_CSS_FILE,
 		crh_output_options_block::PO_OUTPUT_HMMER_ALN,
+		crh_output_options_block::PO_GZIP_JSONL_OUTPUT,
 	};
 }
 
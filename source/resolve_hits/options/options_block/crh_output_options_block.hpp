@@ -60,7 +60,11 @@ namespace cath {
 			static const std::string PO_OUTPUT_TRIMMED_HITS;
 			static const std::string PO_SUMMARISE_TO_FILE;
 			static const std::string PO_HTML_OUTPUT_TO_FILE;
+			static const std::string PO_HTML_OUTPUT_TO_DIR;
 			static const std::string PO_JSON_OUTPUT_TO_FILE;
+			static const std::string PO_JSONL_OUTPUT_TO_FILE;
+			static const std::string PO_GZIP_JSONL_OUTPUT;
+			static const std::string PO_COLUMNAR_OUTPUT_TO_FILE;
 			static const std::string PO_EXPORT_CSS_FILE;
 			static const std::string PO_OUTPUT_HMMER_ALN;
 
@@ -58,6 +58,11 @@ const bool & crh_input_spec::get_input_hits_are_grouped() const {
 	return input_hits_are_grouped;
 }
 
+/// \brief Getter for the optional file in which to cache resolutions between runs
+const path_opt & crh_input_spec::get_result_cache_file() const {
+	return result_cache_file;
+}
+
 /// \brief Setter for the input file from which data should be read
 crh_input_spec & crh_input_spec::set_input_file(const path &prm_input_file ///< The input file from which data should be read
                                                 ) {
@@ -93,6 +98,13 @@ crh_input_spec & crh_input_spec::set_input_hits_are_grouped(const bool &prm_inpu
 	return *this;
 }
 
+/// \brief Setter for the optional file in which to cache resolutions between runs
+crh_input_spec & crh_input_spec::set_result_cache_file(const path &prm_result_cache_file ///< The file in which to cache resolutions between runs
+                                                       ) {
+	result_cache_file = prm_result_cache_file;
+	return *this;
+}
+
 /// \brief Generate a description of any problem that makes the specified crh_input_spec invalid
 ///        or none otherwise
 ///
@@ -48,6 +48,9 @@ namespace cath {
 			/// \brief Whether the code can assume that the input data is pre-grouped by query_id
 			bool                  input_hits_are_grouped = DEFAULT_INPUT_HITS_ARE_GROUPED;
 
+			/// \brief An optional file in which to cache resolutions between runs
+			path_opt              result_cache_file;
+
 		public:
 			/// \brief The default value for whether to read the input data from stdin
 			static constexpr bool                  DEFAULT_READ_FROM_STDIN        = false;
@@ -66,12 +69,14 @@ namespace cath {
 			const hits_input_format_tag & get_input_format() const;
 			const seq::residx_t & get_min_gap_length() const;
 			const bool & get_input_hits_are_grouped() const;
+			const path_opt & get_result_cache_file() const;
 
 			crh_input_spec & set_input_file(const boost::filesystem::path &);
 			crh_input_spec & set_read_from_stdin(const bool &);
 			crh_input_spec & set_input_format(const hits_input_format_tag &);
 			crh_input_spec & set_min_gap_length(const seq::residx_t &);
 			crh_input_spec & set_input_hits_are_grouped(const bool &);
+			crh_input_spec & set_result_cache_file(const boost::filesystem::path &);
 		};
 
 		str_opt get_invalid_description(const crh_input_spec &);
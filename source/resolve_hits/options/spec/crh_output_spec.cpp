@@ -43,6 +43,7 @@ using std::string;
 constexpr bool                crh_output_spec::DEFAULT_QUIET;
 constexpr hit_boundary_output crh_output_spec::DEFAULT_BOUNDARY_OUTPUT;
 constexpr bool                crh_output_spec::DEFAULT_OUTPUT_HMMER_ALN;
+constexpr bool                crh_output_spec::DEFAULT_GZIP_JSONL_OUTPUT;
 
 /// \brief Getter for any files to which hits text should be output
 const path_vec & crh_output_spec::get_hits_text_files() const {
@@ -69,11 +70,31 @@ const path_vec & crh_output_spec::get_html_output_files() const {
 	return html_output_files;
 }
 
+/// \brief Getter for an optional directory to which HTML should be output as an index page and a page per query
+const path_opt & crh_output_spec::get_html_output_dir() const {
+	return html_output_dir;
+}
+
 /// \brief Getter for any files to which JSON should be output
 const path_vec & crh_output_spec::get_json_output_files() const {
 	return json_output_files;
 }
 
+/// \brief Getter for any files to which compact JSON Lines (one line per query) should be output
+const path_vec & crh_output_spec::get_jsonl_output_files() const {
+	return jsonl_output_files;
+}
+
+/// \brief Getter for whether to gzip-compress the JSON Lines output
+const bool & crh_output_spec::get_gzip_jsonl_output() const {
+	return gzip_jsonl_output;
+}
+
+/// \brief Getter for any files to which binary columnar output should be written
+const path_vec & crh_output_spec::get_columnar_output_files() const {
+	return columnar_output_files;
+}
+
 /// \brief Getter for any files to which the HTML's CSS should be output
 const path_opt & crh_output_spec::get_export_css_file() const {
 	return export_css_file;
@@ -119,6 +140,13 @@ crh_output_spec & crh_output_spec::set_html_output_files(const path_vec &prm_htm
 	return *this;
 }
 
+/// \brief Setter for an optional directory to which HTML should be output as an index page and a page per query
+crh_output_spec & crh_output_spec::set_html_output_dir(const path_opt &prm_html_output_dir ///< An optional directory to which HTML should be output as an index page and a page per query
+                                                       ) {
+	html_output_dir = prm_html_output_dir;
+	return *this;
+}
+
 /// \brief Setter for any files to which JSON should be output
 crh_output_spec & crh_output_spec::set_json_output_files(const path_vec &prm_json_output_files ///< Any files to which JSON should be output
                                                          ) {
@@ -126,6 +154,27 @@ crh_output_spec & crh_output_spec::set_json_output_files(const path_vec &prm_jso
 	return *this;
 }
 
+/// \brief Setter for any files to which compact JSON Lines (one line per query) should be output
+crh_output_spec & crh_output_spec::set_jsonl_output_files(const path_vec &prm_jsonl_output_files ///< Any files to which compact JSON Lines (one line per query) should be output
+                                                          ) {
+	jsonl_output_files = prm_jsonl_output_files;
+	return *this;
+}
+
+/// \brief Setter for whether to gzip-compress the JSON Lines output
+crh_output_spec & crh_output_spec::set_gzip_jsonl_output(const bool &prm_gzip_jsonl_output ///< Whether to gzip-compress the JSON Lines output
+                                                         ) {
+	gzip_jsonl_output = prm_gzip_jsonl_output;
+	return *this;
+}
+
+/// \brief Setter for any files to which binary columnar output should be written
+crh_output_spec & crh_output_spec::set_columnar_output_files(const path_vec &prm_columnar_output_files ///< Any files to which binary columnar output should be written
+                                                             ) {
+	columnar_output_files = prm_columnar_output_files;
+	return *this;
+}
+
 /// \brief Setter for any files to which the HTML's CSS should be output
 crh_output_spec & crh_output_spec::set_export_css_file(const path_opt &prm_export_css_file ///< Any files to which the HTML's CSS should be output
                                                        ) {
@@ -145,7 +194,11 @@ crh_output_spec & crh_output_spec::set_output_hmmer_aln(const bool &prm_output_h
 /// \relates crh_output_spec
 bool cath::rslv::has_html_output(const crh_output_spec &prm_output_spec ///< The crh_output_spec to query
                                  ) {
-	return ! prm_output_spec.get_html_output_files().empty();
+	return (
+		! prm_output_spec.get_html_output_files().empty()
+		||
+		static_cast<bool>( prm_output_spec.get_html_output_dir() )
+	);
 }
 
 /// \brief Return whether the specified crh_output_spec implies any hits-text output
@@ -163,13 +216,17 @@ bool cath::rslv::has_any_out_files_matching(const crh_output_spec &prm_output_sp
                                             const path            &prm_query_path   ///< The file being searched for
                                             ) {
 	return (
-		contains( prm_output_spec.get_hits_text_files(),   prm_query_path )
+		contains( prm_output_spec.get_hits_text_files(),       prm_query_path )
 		||
-		contains( prm_output_spec.get_summarise_files(),   prm_query_path )
+		contains( prm_output_spec.get_summarise_files(),       prm_query_path )
 		||
-		contains( prm_output_spec.get_html_output_files(), prm_query_path )
+		contains( prm_output_spec.get_html_output_files(),     prm_query_path )
 		||
-		contains( prm_output_spec.get_json_output_files(), prm_query_path )
+		contains( prm_output_spec.get_json_output_files(),     prm_query_path )
+		||
+		contains( prm_output_spec.get_jsonl_output_files(),    prm_query_path )
+		||
+		contains( prm_output_spec.get_columnar_output_files(), prm_query_path )
 		||
 		( prm_output_spec.get_export_css_file() == prm_query_path )
 	);
@@ -181,10 +238,12 @@ bool cath::rslv::has_any_out_files_matching(const crh_output_spec &prm_output_sp
 path_vec cath::rslv::get_all_output_paths(const crh_output_spec &prm_output_spec ///< The crh_output_spec to query
                                           ) {
 	path_vec the_paths;
-	append( the_paths, prm_output_spec.get_hits_text_files()   );
-	append( the_paths, prm_output_spec.get_summarise_files()   );
-	append( the_paths, prm_output_spec.get_html_output_files() );
-	append( the_paths, prm_output_spec.get_json_output_files() );
+	append( the_paths, prm_output_spec.get_hits_text_files()       );
+	append( the_paths, prm_output_spec.get_summarise_files()       );
+	append( the_paths, prm_output_spec.get_html_output_files()     );
+	append( the_paths, prm_output_spec.get_json_output_files()     );
+	append( the_paths, prm_output_spec.get_jsonl_output_files()    );
+	append( the_paths, prm_output_spec.get_columnar_output_files() );
 	if ( prm_output_spec.get_export_css_file() ) {
 		the_paths.push_back( *prm_output_spec.get_export_css_file() );
 	}
@@ -212,6 +271,20 @@ str_opt cath::rslv::get_invalid_description(const crh_output_spec &prm_output_sp
 		return "Cannot send more than one type of output to the same output file"s;
 	}
 
+	if ( prm_output_spec.get_html_output_dir() && *prm_output_spec.get_html_output_dir() == path{ "-" } ) {
+		return
+			"Cannot send output for --"
+			+ crh_output_options_block::PO_HTML_OUTPUT_TO_DIR
+			+ " to stdout (which is specified as \"-\") because it must be a directory";
+	}
+
+	if ( prm_output_spec.get_gzip_jsonl_output() && prm_output_spec.get_jsonl_output_files().empty() ) {
+		return
+			"Cannot gzip-compress JSON Lines output if not outputting any JSON Lines (with --"
+			+ crh_output_options_block::PO_JSONL_OUTPUT_TO_FILE
+			+ ")";
+	}
+
 	const bool hits_text_to_stdout = num_stdouts == 0 && ! prm_output_spec.get_quiet();
 	if ( means_output_trimmed_hits( prm_output_spec.get_boundary_output() ) && ! ( hits_text_to_stdout || has_hits_text_output( prm_output_spec ) ) ) {
 		return
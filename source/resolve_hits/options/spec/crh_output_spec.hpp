@@ -37,10 +37,10 @@ namespace cath {
 			path_vec            hits_text_files;
 
 			/// \brief Whether to suppress the default output of hits text to stdout
-			bool                quiet            = DEFAULT_QUIET;
+			bool                quiet             = DEFAULT_QUIET;
 
 			/// \brief Whether to output the hits starts/stops *after* trimming
-			hit_boundary_output boundary_output  = DEFAULT_BOUNDARY_OUTPUT;
+			hit_boundary_output boundary_output   = DEFAULT_BOUNDARY_OUTPUT;
 
 			/// \brief Any files to which a summary of the input should be output
 			path_vec            summarise_files;
@@ -48,31 +48,50 @@ namespace cath {
 			/// \brief Any files to which HTML should be output
 			path_vec            html_output_files;
 
+			/// \brief An optional directory to which HTML should be output as an index page and a page per query
+			path_opt            html_output_dir;
+
 			/// \brief Any files to which JSON should be output
 			path_vec            json_output_files;
 
+			/// \brief Any files to which compact JSON Lines (one line per query) should be output
+			path_vec            jsonl_output_files;
+
+			/// \brief Whether to gzip-compress the JSON Lines output
+			bool                gzip_jsonl_output = DEFAULT_GZIP_JSONL_OUTPUT;
+
+			/// \brief Any files to which binary columnar output should be written
+			path_vec            columnar_output_files;
+
 			/// \brief Any files to which the HTML's CSS should be output
 			path_opt            export_css_file;
 
 			/// \brief Whether to output a summary of the HMMER alignment
-			bool                output_hmmer_aln = DEFAULT_OUTPUT_HMMER_ALN;
+			bool                output_hmmer_aln  = DEFAULT_OUTPUT_HMMER_ALN;
 
 		public:
 			/// \brief The default value for whether to suppress the default output of hits text to stdout
-			static constexpr bool                DEFAULT_QUIET            = false;
+			static constexpr bool                DEFAULT_QUIET             = false;
 
 			/// \brief The default value for whether to output the hits starts/stops *after* trimming
-			static constexpr hit_boundary_output DEFAULT_BOUNDARY_OUTPUT  = hit_boundary_output::ORIG;
+			static constexpr hit_boundary_output DEFAULT_BOUNDARY_OUTPUT   = hit_boundary_output::ORIG;
 
 			/// \brief The default value for whether to output a summary of the HMMER alignment
-			static constexpr bool                DEFAULT_OUTPUT_HMMER_ALN = false;
+			static constexpr bool                DEFAULT_OUTPUT_HMMER_ALN  = false;
+
+			/// \brief The default value for whether to gzip-compress the JSON Lines output
+			static constexpr bool                DEFAULT_GZIP_JSONL_OUTPUT = false;
 
 			const path_vec & get_hits_text_files() const;
 			const bool & get_quiet() const;
 			const hit_boundary_output & get_boundary_output() const;
 			const path_vec & get_summarise_files() const;
 			const path_vec & get_html_output_files() const;
+			const path_opt & get_html_output_dir() const;
 			const path_vec & get_json_output_files() const;
+			const path_vec & get_jsonl_output_files() const;
+			const bool & get_gzip_jsonl_output() const;
+			const path_vec & get_columnar_output_files() const;
 			const path_opt & get_export_css_file() const;
 			const bool & get_output_hmmer_aln() const;
 
@@ -81,7 +100,11 @@ namespace cath {
 			crh_output_spec & set_boundary_output(const hit_boundary_output &);
 			crh_output_spec & set_summarise_files(const path_vec &);
 			crh_output_spec & set_html_output_files(const path_vec &);
+			crh_output_spec & set_html_output_dir(const path_opt &);
 			crh_output_spec & set_json_output_files(const path_vec &);
+			crh_output_spec & set_jsonl_output_files(const path_vec &);
+			crh_output_spec & set_gzip_jsonl_output(const bool &);
+			crh_output_spec & set_columnar_output_files(const path_vec &);
 			crh_output_spec & set_export_css_file(const path_opt &);
 			crh_output_spec & set_output_hmmer_aln(const bool &);
 		};
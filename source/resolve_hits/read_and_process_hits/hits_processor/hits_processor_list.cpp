@@ -26,8 +26,11 @@
 #include "resolve_hits/options/spec/crh_output_spec.hpp"
 #include "resolve_hits/options/spec/crh_single_output_spec.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/summarise_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_columnar_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_html_dir_hits_processor.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/write_html_hits_processor.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/write_json_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_jsonl_hits_processor.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/write_results_hits_processor.hpp"
 
 using namespace cath::common;
@@ -38,6 +41,7 @@ using boost::algorithm::any_of;
 using std::initializer_list;
 using std::make_unique;
 using std::ostream;
+using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
 
@@ -60,6 +64,18 @@ const crh_segment_spec & hits_processor_list::get_segment_spec() const {
 	return the_segment_spec;
 }
 
+/// \brief Getter for the optional cache of resolutions through which each query's hits are resolved
+const shared_ptr<crh_result_cache> & hits_processor_list::get_result_cache_ptr() const {
+	return result_cache_ptr;
+}
+
+/// \brief Setter for the optional cache of resolutions through which each query's hits are resolved
+hits_processor_list & hits_processor_list::set_result_cache_ptr(shared_ptr<crh_result_cache> prm_result_cache_ptr ///< The cache of resolutions (or nullptr for none)
+                                                                ) {
+	result_cache_ptr = std::move( prm_result_cache_ptr );
+	return *this;
+}
+
 /// \brief Add a processor to the list
 hits_processor_list & hits_processor_list::add_processor(const hits_processor &prm_hits_processor ///< The processor to add
                                                          ) {
@@ -152,10 +168,13 @@ hits_processor_list cath::rslv::detail::make_hits_processors(ofstream_list
 		} () );
 	}
 	else {
-		const path_vec &summarise_files   = prm_output_spec.get_summarise_files();
-		const path_vec &html_output_files = prm_output_spec.get_html_output_files();
-		const path_vec &json_output_files = prm_output_spec.get_json_output_files();
-		const path_vec  hits_text_files   = [&] {
+		const path_vec &summarise_files    = prm_output_spec.get_summarise_files();
+		const path_vec &html_output_files  = prm_output_spec.get_html_output_files();
+		const path_opt &html_output_dir    = prm_output_spec.get_html_output_dir();
+		const path_vec &json_output_files  = prm_output_spec.get_json_output_files();
+		const path_vec &jsonl_output_files = prm_output_spec.get_jsonl_output_files();
+		const path_vec &columnar_files     = prm_output_spec.get_columnar_output_files();
+		const path_vec  hits_text_files    = [&] {
 			path_vec temp_hits_text_files = prm_output_spec.get_hits_text_files();
 			if ( ! prm_output_spec.get_quiet() && ! has_any_out_files_matching( prm_output_spec, prm_ofstreams.get_flag() ) ) {
 				temp_hits_text_files.push_back( prm_ofstreams.get_flag() );
@@ -166,6 +185,9 @@ hits_processor_list cath::rslv::detail::make_hits_processors(ofstream_list
 		if ( ! html_output_files.empty() ) {
 			the_list.add_processor( make_unique< write_html_hits_processor    >( prm_ofstreams.open_ofstreams( html_output_files ), prm_html_spec ) );
 		}
+		if ( html_output_dir ) {
+			the_list.add_processor( make_unique< write_html_dir_hits_processor >( *html_output_dir, prm_html_spec ) );
+		}
 		if ( ! summarise_files.empty()   ) {
 			the_list.add_processor( make_unique< summarise_hits_processor     >( prm_ofstreams.open_ofstreams( summarise_files   )                ) );
 		}
@@ -175,6 +197,12 @@ hits_processor_list cath::rslv::detail::make_hits_processors(ofstream_list
 		if ( ! json_output_files.empty() ) {
 			the_list.add_processor( make_unique< write_json_hits_processor    >( prm_ofstreams.open_ofstreams( json_output_files )                ) );
 		}
+		if ( ! jsonl_output_files.empty() ) {
+			the_list.add_processor( make_unique< write_jsonl_hits_processor   >( prm_ofstreams.open_ofstreams( jsonl_output_files ), prm_output_spec.get_gzip_jsonl_output() ) );
+		}
+		if ( ! columnar_files.empty() ) {
+			the_list.add_processor( make_unique< write_columnar_hits_processor >( prm_ofstreams.open_ofstreams( columnar_files ), bound_out ) );
+		}
 	}
 	return the_list;
 }
@@ -28,8 +28,10 @@
 #include "common/cpp14/cbegin_cend.hpp"
 #include "common/type_aliases.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/hits_processor.hpp"
+#include "resolve_hits/resolve/crh_result_cache.hpp"
 
 #include <initializer_list>
+#include <memory>
 #include <utility>
 
 namespace cath { namespace common { class ofstream_list; } }
@@ -53,8 +55,11 @@ namespace cath {
 				/// \brief The segment spec to apply to incoming hits
 				crh_segment_spec the_segment_spec;
 
-				const crh_score_spec & get_score_spec() const;
-				const crh_segment_spec & get_segment_spec() const;
+				/// \brief An optional cache of resolutions, through which each query's hits are resolved
+				///        before being passed to the hits_processors
+				///
+				/// This is shared so that copies of the list share (and flush) the same cache
+				std::shared_ptr<crh_result_cache> result_cache_ptr;
 
 			public:
 				/// \brief A const_iterator type alias as part of making this a range
@@ -74,6 +79,12 @@ namespace cath {
 				hits_processor_list & operator=(const hits_processor_list &) = default;
 				hits_processor_list & operator=(hits_processor_list &&) = default;
 
+				const crh_score_spec & get_score_spec() const;
+				const crh_segment_spec & get_segment_spec() const;
+
+				const std::shared_ptr<crh_result_cache> & get_result_cache_ptr() const;
+				hits_processor_list & set_result_cache_ptr(std::shared_ptr<crh_result_cache>);
+
 				hits_processor_list & add_processor(const hits_processor &);
 				hits_processor_list & add_processor(hits_processor_uptr);
 				hits_processor_list & add_processor(hits_processor_clptr);
@@ -107,11 +118,14 @@ namespace cath {
 			/// \brief Process the specified full_hit_list for the specified query using the specified crh_filter_spec
 			///
 			/// This builds a calc_hit_list from the specified full_hit_list once and then passes it to each of the hits_processors
+			///
+			/// If there's a result cache, the hits are resolved through it first and the resolution
+			/// is attached to the calc_hit_list so that the hits_processors' calls to resolve_hits() just return it
 			inline void hits_processor_list::process_hits_for_query(const std::string     &prm_query_id,    ///< The query_protein_id string
 			                                                        const crh_filter_spec &prm_filter_spec, ///< The filter spec to apply to hits
 			                                                        full_hit_list          prm_full_hits    ///< The full hits to be processed
 			                                                        ) {
-				const calc_hit_list the_calc_hit_list{
+				calc_hit_list the_calc_hit_list{
 					std::move( prm_full_hits ),
 					get_score_spec(),
 					get_segment_spec(),
@@ -125,6 +139,13 @@ namespace cath {
 					)
 				};
 				prm_full_hits = full_hit_list{};
+				if ( result_cache_ptr ) {
+					const bool &naive_greedy = get_score_spec().get_naive_greedy();
+					the_calc_hit_list.set_known_resolution(
+						result_cache_ptr->resolve( the_calc_hit_list, naive_greedy ),
+						naive_greedy
+					);
+				}
 				boost::for_each(
 					processors,
 					[&] (common::clone_ptr<hits_processor> &x) {
@@ -140,6 +161,7 @@ namespace cath {
 			}
 
 			/// \brief Get each of the hits_processors in the list to finish any work they've started
+			///        and write out any new entries in the result cache
 			inline void hits_processor_list::finish_work() {
 				boost::for_each(
 					processors,
@@ -147,6 +169,9 @@ namespace cath {
 						x->finish_work();
 					}
 				);
+				if ( result_cache_ptr ) {
+					result_cache_ptr->flush();
+				}
 			}
 
 
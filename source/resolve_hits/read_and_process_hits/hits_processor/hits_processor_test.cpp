@@ -18,22 +18,34 @@
 /// You should have received a copy of the GNU General Public License
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "common/file/slurp.hpp"
+#include "common/file/temp_file.hpp"
+#include "resolve_hits/html_output/resolve_hits_html_outputter.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/summarise_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_columnar_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_html_dir_hits_processor.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/write_html_hits_processor.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/write_json_hits_processor.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/write_jsonl_hits_processor.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/write_results_hits_processor.hpp"
 
 #include <sstream>
 
 namespace cath { namespace test { } }
 
+using namespace cath::common;
+using namespace cath::rslv;
 using namespace cath::rslv::detail;
 using namespace cath::test;
 
+using boost::filesystem::exists;
+using boost::filesystem::remove_all;
 using std::ostream;
 using std::ostringstream;
+using std::string;
 
 namespace cath {
 	namespace test {
@@ -72,10 +84,22 @@ BOOST_AUTO_TEST_CASE(write_html_hits_processor_requires_strictly_worse_hits) {
 	BOOST_CHECK(   write_html_hits_processor   ( ostreams ).requires_strictly_worse_hits() );
 }
 
+BOOST_AUTO_TEST_CASE(write_columnar_hits_processor_does_not_require_strictly_worse_hits) {
+	BOOST_CHECK( ! write_columnar_hits_processor( ostreams ).requires_strictly_worse_hits() );
+}
+
+BOOST_AUTO_TEST_CASE(write_html_dir_hits_processor_requires_strictly_worse_hits) {
+	BOOST_CHECK(   write_html_dir_hits_processor( "dummy_dir" ).requires_strictly_worse_hits() );
+}
+
 BOOST_AUTO_TEST_CASE(write_json_hits_processor_does_not_require_strictly_worse_hits) {
 	BOOST_CHECK( ! write_json_hits_processor   ( ostreams ).requires_strictly_worse_hits() );
 }
 
+BOOST_AUTO_TEST_CASE(write_jsonl_hits_processor_does_not_require_strictly_worse_hits) {
+	BOOST_CHECK( ! write_jsonl_hits_processor  ( ostreams ).requires_strictly_worse_hits() );
+}
+
 BOOST_AUTO_TEST_CASE(write_results_hits_processor_does_not_require_strictly_worse_hits) {
 	BOOST_CHECK( ! write_results_hits_processor( ostreams ).requires_strictly_worse_hits() );
 }
@@ -84,4 +108,17 @@ BOOST_AUTO_TEST_SUITE_END()
 
 
 
+BOOST_AUTO_TEST_CASE(write_html_dir_hits_processor_writes_index_and_css_with_no_queries) {
+	const temp_file output_dir_file{ ".hits_processor_test.%%%%-%%%%-%%%%-%%%%" };
+	const auto      output_dir = get_filename( output_dir_file );
+
+	write_html_dir_hits_processor{ output_dir }.finish_work();
+	const bool   css_exists = exists( output_dir / "crh.css" );
+	const string index_html = exists( output_dir / "index.html" ) ? slurp( output_dir / "index.html" ) : string{};
+	remove_all( output_dir );
+
+	BOOST_CHECK( css_exists );
+	BOOST_CHECK_EQUAL( index_html, resolve_hits_html_outputter::index_prefix( "crh.css" ) + resolve_hits_html_outputter::index_suffix() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -27,6 +27,7 @@
 
 #include "common/boost_addenda/range/front.hpp"
 #include "common/clone/make_uptr_clone.hpp"
+#include "resolve_hits/algo/dominated_hits_finder.hpp"
 #include "resolve_hits/full_hit_fns.hpp"
 #include "resolve_hits/full_hit_list.hpp"
 
@@ -55,10 +56,10 @@ unique_ptr<hits_processor> summarise_hits_processor::do_clone() const {
 ///
 /// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
 void summarise_hits_processor::do_process_hits_for_query(const string           &prm_query_id,         ///< The query_protein_id string
-                                                         const crh_filter_spec  &/*prm_filter_spec*/,  ///< The filter_spec to apply to the hits
-                                                         const crh_score_spec   &/*prm_score_spec*/,   ///< The score spec to apply to the hits
-                                                         const crh_segment_spec &/*prm_segment_spec*/, ///< The segment spec to apply to the hits
-                                                         const calc_hit_list    &prm_calc_hits         ///< The hits to process
+                                                         const crh_filter_spec  &prm_filter_spec,  ///< The filter_spec to apply to the hits
+                                                         const crh_score_spec   &prm_score_spec,   ///< The score spec to apply to the hits
+                                                         const crh_segment_spec &prm_segment_spec, ///< The segment spec to apply to the hits
+                                                         const calc_hit_list    &prm_calc_hits     ///< The hits to process
                                                          ) {
 	const full_hit_list &full_hits = prm_calc_hits.get_full_hits();
 	if ( ! example_query_id_and_hit && ! full_hits.empty() ) {
@@ -73,7 +74,8 @@ void summarise_hits_processor::do_process_hits_for_query(const string
 		max_stops.push_back( *max_stop_opt );
 	}
 
-	num_hits += full_hits.size();
+	num_hits           += full_hits.size();
+	num_dominated_hits += count_dominated_hits( full_hits, prm_score_spec, prm_segment_spec, prm_filter_spec );
 }
 
 /// \brief Calculate the median of an unsorted bunch of size_t values
@@ -111,6 +113,8 @@ void summarise_hits_processor::do_finish_work() {
 				<< " * Number of queries : " << right << setw( 6 ) << max_stops.size() << " (excludes any queries with no hits)\n"
 				<< " * Number of hits    : " << right << setw( 6 ) << num_hits
 				<< " (ie an average of " << ( numeric_cast<double>( num_hits ) / numeric_cast<double>( max_stops.size() ) ) << " per query)\n"
+				<< " * Dominated hits    : " << right << setw( 6 ) << num_dominated_hits
+				<< " (strictly worse than a hit within one of their segments, so prunable without changing the results)\n"
 				<< " * Minimum max-stop  : " << right << setw( 6 ) << ( max_stops.empty() ? "<N/A>" : std::to_string( *min_element( max_stops ) ) ) << "\n"
 				<< " * Median  max-stop  : "
 				<< (
@@ -124,10 +128,10 @@ void summarise_hits_processor::do_finish_work() {
 				<< (
 					example_query_id_and_hit
 					?
-						  "    * Query ID : " + example_query_id_and_hit->first                         + "\n"
-						+ "    * Match ID : " + example_query_id_and_hit->second.get_label()            + "\n"
-						+ "    * Score    : " + get_score_string   ( example_query_id_and_hit->second ) + "\n"
-						+ "    * Segments : " + get_segments_string( example_query_id_and_hit->second ) + "\n"
+						  "    * Query ID : " + example_query_id_and_hit->first                          + "\n"
+						+ "    * Match ID : " + example_query_id_and_hit->second.get_label().to_string() + "\n"
+						+ "    * Score    : " + get_score_string   ( example_query_id_and_hit->second )  + "\n"
+						+ "    * Segments : " + get_segments_string( example_query_id_and_hit->second )  + "\n"
 					:
 						""
 				);
@@ -40,6 +40,9 @@ namespace cath {
 				/// \brief Record the number of hits
 				size_t num_hits = 0;
 
+				/// \brief Record the number of hits that are strictly dominated by a better hit (and so may be pruned)
+				size_t num_dominated_hits = 0;
+
 				/// \brief Record an example query_id/full_hit pair
 				str_full_hit_pair_opt example_query_id_and_hit;
 
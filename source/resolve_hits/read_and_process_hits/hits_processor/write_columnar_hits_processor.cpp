@@ -0,0 +1,125 @@
+/// \file
+/// \brief The write_columnar_hits_processor class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "write_columnar_hits_processor.hpp"
+
+#include "common/clone/make_uptr_clone.hpp"
+#include "common/exception/out_of_range_exception.hpp"
+#include "resolve_hits/calc_hit_list.hpp"
+#include "resolve_hits/full_hit_list_fns.hpp"
+#include "resolve_hits/resolve/hit_resolver.hpp"
+#include "resolve_hits/scored_hit_arch.hpp"
+
+#include <ios>
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::rslv::detail;
+
+using std::move;
+using std::ostream;
+using std::streamsize;
+using std::string;
+using std::unique_ptr;
+
+/// \brief The number of rows to accumulate in a row group before writing it to the ostreams
+static constexpr size_t COLUMNAR_ROW_GROUP_SIZE = 65536;
+
+/// \brief Write the specified bytes to each of the ostreams
+void write_columnar_hits_processor::write_to_ostreams(const string &prm_bytes ///< The bytes to write
+                                                      ) {
+	for (const ostream_ref &ostream_ref : get_ostreams() ) {
+		ostream_ref.get().write( prm_bytes.data(), static_cast<streamsize>( prm_bytes.size() ) );
+	}
+}
+
+/// \brief A standard do_clone method
+unique_ptr<hits_processor> write_columnar_hits_processor::do_clone() const {
+	return { make_uptr_clone( *this ) };
+}
+
+/// \brief Process the specified data
+///
+/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
+void write_columnar_hits_processor::do_process_hits_for_query(const string           &prm_query_id,        ///< The query_protein_id string
+                                                              const crh_filter_spec  &/*prm_filter_spec*/, ///< The filter_spec to apply to the hits
+                                                              const crh_score_spec   &prm_score_spec,      ///< The score spec to apply to the hits
+                                                              const crh_segment_spec &prm_segment_spec,    ///< The segment spec to apply to the hits
+                                                              const calc_hit_list    &prm_calc_hits        ///< The hits to process
+                                                              ) {
+	if ( ! written_header ) {
+		write_to_ostreams( crh_columnar_encoder::header_bytes() );
+		written_header = true;
+	}
+
+	// Resolve the hits
+	const auto result_hit_arch  = resolve_hits( prm_calc_hits, prm_score_spec.get_naive_greedy() );
+	const auto result_full_hits = get_full_hits_of_hit_arch(
+		result_hit_arch,
+		prm_calc_hits.get_full_hits()
+	);
+
+	encoder.add_query( prm_query_id, result_full_hits, prm_segment_spec, boundary_output );
+	if ( encoder.num_pending_rows() >= COLUMNAR_ROW_GROUP_SIZE ) {
+		write_to_ostreams( encoder.row_group_bytes() );
+	}
+}
+
+/// \brief Write any pending row group and flush the ostreams
+///
+/// The header is written here if it hasn't already been so that the output is valid even if there were no queries
+void write_columnar_hits_processor::do_finish_work() {
+	if ( ! written_header ) {
+		write_to_ostreams( crh_columnar_encoder::header_bytes() );
+		written_header = true;
+	}
+	write_to_ostreams( encoder.row_group_bytes() );
+	for (const ostream_ref &ostream_ref : get_ostreams() ) {
+		ostream_ref.get().flush();
+	}
+}
+
+/// \brief Return false: read_and_resolve_mgr needn't parse hits that fail the score filter or pass them to this processor
+bool write_columnar_hits_processor::do_wants_hits_that_fail_score_filter() const {
+	return false;
+}
+
+/// \brief Return false: read_and_resolve_mgr may strip out strictly worse hits from the data; they aren't required
+bool write_columnar_hits_processor::do_requires_strictly_worse_hits() const {
+	return false;
+}
+
+/// \brief Ctor for write_columnar_hits_processor
+write_columnar_hits_processor::write_columnar_hits_processor(ref_vec<ostream>           prm_ostreams,       ///< The ostreams to which the results should be written
+                                                             const hit_boundary_output &prm_boundary_output ///< Whether to trim the boundaries before outputting them
+                                                             ) noexcept : super           { move( prm_ostreams ) },
+                                                                          boundary_output { prm_boundary_output  } {
+}
+
+/// \brief Copy ctor for write_columnar_hits_processor
+write_columnar_hits_processor::write_columnar_hits_processor(const write_columnar_hits_processor &prm_rhs ///< The other write_columnar_hits_processor from which to copy construct
+                                                             ) : super           { prm_rhs                 },
+                                                                 boundary_output { prm_rhs.boundary_output },
+                                                                 encoder         { prm_rhs.encoder         },
+                                                                 written_header  { prm_rhs.written_header  } {
+	if ( prm_rhs.encoder.num_pending_rows() > 0 ) {
+		BOOST_THROW_EXCEPTION(out_of_range_exception("Unable to copy construct from write_columnar_hits_processor that has unwritten rows"));
+	}
+}
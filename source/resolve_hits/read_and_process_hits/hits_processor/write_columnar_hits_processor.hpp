@@ -0,0 +1,80 @@
+/// \file
+/// \brief The write_columnar_hits_processor class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_COLUMNAR_HITS_PROCESSOR_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_COLUMNAR_HITS_PROCESSOR_HPP
+
+#include "resolve_hits/file/crh_columnar_format.hpp"
+#include "resolve_hits/options/spec/hit_boundary_output.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/hits_processor.hpp"
+
+namespace cath {
+	namespace rslv {
+		namespace detail {
+
+			/// \brief Hits processor that writes the resolved hits in the binary columnar format
+			///        (see crh_columnar_encoder) to the hits_processor's ostreams
+			///
+			/// The rows are written in row groups as the queries complete.
+			class write_columnar_hits_processor final : public hits_processor {
+			private:
+				/// \brief Convenience type alias for the parent class
+				using super = hits_processor;
+
+				/// \brief Whether to trim the boundaries before outputting them
+				hit_boundary_output  boundary_output;
+
+				/// \brief The encoder that holds the dictionaries and the pending row group
+				crh_columnar_encoder encoder;
+
+				/// \brief Whether the header has yet been written
+				bool                 written_header = false;
+
+				void write_to_ostreams(const std::string &);
+
+				std::unique_ptr<hits_processor> do_clone() const final;
+
+				void do_process_hits_for_query(const std::string &,
+				                               const crh_filter_spec &,
+				                               const crh_score_spec &,
+				                               const crh_segment_spec &,
+				                               const calc_hit_list &) final;
+
+				void do_finish_work() final;
+
+				bool do_wants_hits_that_fail_score_filter() const final;
+
+				bool do_requires_strictly_worse_hits() const final;
+
+			public:
+				explicit write_columnar_hits_processor(ref_vec<std::ostream>,
+				                                       const hit_boundary_output & = hit_boundary_output{}) noexcept;
+
+				write_columnar_hits_processor(const write_columnar_hits_processor &);
+				write_columnar_hits_processor(write_columnar_hits_processor &&) noexcept = default;
+				write_columnar_hits_processor & operator=(const write_columnar_hits_processor &) = delete;
+				write_columnar_hits_processor & operator=(write_columnar_hits_processor &&) = delete;
+			};
+
+		} // namespace detail
+	} // namespace rslv
+} // namespace cath
+
+#endif
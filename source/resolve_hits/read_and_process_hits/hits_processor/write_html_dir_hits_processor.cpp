@@ -0,0 +1,212 @@
+/// \file
+/// \brief The write_html_dir_hits_processor class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "write_html_dir_hits_processor.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "common/clone/make_uptr_clone.hpp"
+#include "common/exception/out_of_range_exception.hpp"
+#include "common/file/open_fstream.hpp"
+#include "resolve_hits/calc_hit_list.hpp"
+#include "resolve_hits/html_output/resolve_hits_html_outputter.hpp"
+
+#include <fstream>
+#include <limits>
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::rslv::detail;
+
+using boost::filesystem::create_directories;
+using boost::filesystem::path;
+using boost::none;
+using std::ios_base;
+using std::move;
+using std::numeric_limits;
+using std::ofstream;
+using std::string;
+using std::unique_ptr;
+
+/// \brief The number of query pages to put in each subdirectory of the queries directory
+///
+/// This keeps the number of files per directory manageable for very large numbers of queries
+static constexpr size_t QUERIES_PER_SHARD = 1000;
+
+/// \brief The number of bytes of index entries to accumulate before appending them to the index file
+static constexpr size_t INDEX_BUFFER_FLUSH_SIZE = 1024 * 1024;
+
+/// \brief The name of the shared CSS file within the output directory
+static const string CSS_FILENAME   = "crh.css";
+
+/// \brief The name of the index file within the output directory
+static const string INDEX_FILENAME = "index.html";
+
+/// \brief Write the specified string to the specified file, replacing any previous contents
+static void write_string_to_file(const path   &prm_file,  ///< The file to write
+                                 const string &prm_string ///< The string to write
+                                 ) {
+	ofstream out_stream;
+	open_ofstream( out_stream, prm_file );
+	out_stream << prm_string;
+	out_stream.close();
+}
+
+/// \brief Create the output directory and write the CSS file and the start of the index file
+void write_html_dir_hits_processor::start_output() {
+	create_directories( output_dir );
+	write_string_to_file( output_dir / CSS_FILENAME,   resolve_hits_html_outputter::css_string()                );
+	write_string_to_file( output_dir / INDEX_FILENAME, resolve_hits_html_outputter::index_prefix( CSS_FILENAME ) );
+}
+
+/// \brief Append any buffered index entries to the index file and then empty the buffer
+void write_html_dir_hits_processor::flush_index_buffer() {
+	if ( index_buffer.empty() ) {
+		return;
+	}
+	ofstream index_stream;
+	open_ofstream( index_stream, output_dir / INDEX_FILENAME, ios_base::out | ios_base::app );
+	index_stream << index_buffer;
+	index_stream.close();
+	index_buffer.clear();
+}
+
+/// \brief A standard do_clone method
+unique_ptr<hits_processor> write_html_dir_hits_processor::do_clone() const {
+	return { make_uptr_clone( *this ) };
+}
+
+/// \brief Process the specified data
+///
+/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
+void write_html_dir_hits_processor::do_process_hits_for_query(const string           &prm_query_id,     ///< The query_protein_id string
+                                                              const crh_filter_spec  &prm_filter_spec,  ///< The filter_spec to apply to the hits
+                                                              const crh_score_spec   &prm_score_spec,   ///< The score spec to apply to the hits
+                                                              const crh_segment_spec &prm_segment_spec, ///< The segment spec to apply to the hits
+                                                              const calc_hit_list    &prm_calc_hits     ///< The hits to process
+                                                              ) {
+	if ( batch_counter == 0 ) {
+		start_output();
+	}
+
+	const path shard_rel_dir = path{ "queries" } / std::to_string( batch_counter / QUERIES_PER_SHARD );
+	if ( batch_counter % QUERIES_PER_SHARD == 0 ) {
+		create_directories( output_dir / shard_rel_dir );
+	}
+
+	// The query pages are two levels beneath the CSS file
+	const string css_href      = "../../" + CSS_FILENAME;
+	const string page_filename = std::to_string( batch_counter ) + ".html";
+	const string all_filename  = std::to_string( batch_counter ) + ".all.html";
+
+	// If some of the hits may be hidden, write a page with all of them, to which the main page can link
+	const bool may_hide_hits = ( prm_calc_hits.size() > html_spec.get_max_num_non_soln_hits() );
+	if ( may_hide_hits ) {
+		auto all_hits_html_spec = html_spec;
+		all_hits_html_spec.set_max_num_non_soln_hits( numeric_limits<size_t>::max() );
+		write_string_to_file(
+			output_dir / shard_rel_dir / all_filename,
+			resolve_hits_html_outputter::html_prefix( css_href )
+				+ resolve_hits_html_outputter::output_html(
+					prm_query_id,
+					prm_calc_hits,
+					prm_score_spec,
+					prm_segment_spec,
+					all_hits_html_spec,
+					false,
+					prm_filter_spec,
+					batch_counter
+				)
+				+ resolve_hits_html_outputter::html_key()
+				+ resolve_hits_html_outputter::html_suffix()
+		);
+	}
+
+	// Write the main page for this query
+	write_string_to_file(
+		output_dir / shard_rel_dir / page_filename,
+		resolve_hits_html_outputter::html_prefix( css_href )
+			+ resolve_hits_html_outputter::output_html(
+				prm_query_id,
+				prm_calc_hits,
+				prm_score_spec,
+				prm_segment_spec,
+				html_spec,
+				false,
+				prm_filter_spec,
+				batch_counter,
+				may_hide_hits ? str_opt{ all_filename } : str_opt{ none }
+			)
+			+ resolve_hits_html_outputter::html_key()
+			+ resolve_hits_html_outputter::html_suffix()
+	);
+
+	// Add an entry to the index
+	index_buffer += resolve_hits_html_outputter::index_entry_html(
+		prm_query_id,
+		( shard_rel_dir / page_filename ).generic_string(),
+		prm_calc_hits.size()
+	);
+	if ( index_buffer.size() >= INDEX_BUFFER_FLUSH_SIZE ) {
+		flush_index_buffer();
+	}
+
+	++batch_counter;
+}
+
+/// \brief Write any remaining index entries and the index suffix to finish the work
+///
+/// If no queries were processed, this first writes the directory, CSS file and index start
+/// so that the output is still a complete (empty) index
+void write_html_dir_hits_processor::do_finish_work() {
+	if ( batch_counter == 0 ) {
+		start_output();
+	}
+	index_buffer += resolve_hits_html_outputter::index_suffix();
+	flush_index_buffer();
+}
+
+/// \brief Return true: read_and_resolve_mgr should still parse hits that fail the score filter and pass them to this processor
+bool write_html_dir_hits_processor::do_wants_hits_that_fail_score_filter() const {
+	return true;
+}
+
+/// \brief Return true: read_and_resolve_mgr may not strip out strictly worse hits from the data; they are required
+bool write_html_dir_hits_processor::do_requires_strictly_worse_hits() const {
+	return true;
+}
+
+/// \brief Ctor for write_html_dir_hits_processor
+write_html_dir_hits_processor::write_html_dir_hits_processor(path          prm_output_dir, ///< The directory to which the HTML should be written
+                                                             crh_html_spec prm_html_spec   ///< The specification for how to render the HTML
+                                                             ) noexcept : output_dir { move( prm_output_dir ) },
+                                                                          html_spec  { move( prm_html_spec  ) } {
+}
+
+/// \brief Copy ctor for write_html_dir_hits_processor
+write_html_dir_hits_processor::write_html_dir_hits_processor(const write_html_dir_hits_processor &prm_rhs ///< The other write_html_dir_hits_processor from which to copy construct
+                                                             ) : super         { prm_rhs               },
+                                                                 output_dir    { prm_rhs.output_dir    },
+                                                                 html_spec     { prm_rhs.html_spec     },
+                                                                 batch_counter { prm_rhs.batch_counter } {
+	if ( ! prm_rhs.index_buffer.empty() ) {
+		BOOST_THROW_EXCEPTION(out_of_range_exception("Unable to copy construct from write_html_dir_hits_processor that has unwritten index entries"));
+	}
+}
@@ -0,0 +1,99 @@
+/// \file
+/// \brief The write_html_dir_hits_processor class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_HTML_DIR_HITS_PROCESSOR_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_HTML_DIR_HITS_PROCESSOR_HPP
+
+#include <boost/filesystem/path.hpp>
+
+#include "resolve_hits/options/spec/crh_html_spec.hpp"
+#include "resolve_hits/read_and_process_hits/hits_processor/hits_processor.hpp"
+
+#include <string>
+
+namespace cath {
+	namespace rslv {
+		namespace detail {
+
+			/// \brief Hits processor that writes a directory of HTML pages: one per query plus an index
+			///
+			/// Each query's page is written (and the memory released) as soon as the query is
+			/// processed, so the memory use doesn't grow with the number of queries and a browser
+			/// only ever has to render one query's hits at a time. The CSS is written to a single
+			/// file that's shared by all the pages. Where some of a query's hits may be hidden
+			/// (by the max-num-non-soln-hits limit), a separate page showing all of them is written
+			/// and linked from the main page.
+			///
+			/// The layout is:
+			///  * `<dir>/index.html`
+			///  * `<dir>/crh.css`
+			///  * `<dir>/queries/<shard>/<n>.html` (and `<n>.all.html` where needed)
+			///
+			/// where the n-th query (from 0) is in shard `n / 1000`
+			class write_html_dir_hits_processor final : public hits_processor {
+			private:
+				/// \brief Convenience type alias for the parent class
+				using super = hits_processor;
+
+				/// \brief The directory to which the HTML should be written
+				boost::filesystem::path output_dir;
+
+				/// \brief The specification for how to render the HTML
+				crh_html_spec html_spec;
+
+				/// \brief A counter of the batch being processed
+				///        (used to name the query pages and to allow hits' HTML to have unique data attributes)
+				size_t batch_counter = 0;
+
+				/// \brief The index entries that have yet to be appended to the index file
+				std::string index_buffer;
+
+				void start_output();
+				void flush_index_buffer();
+
+				std::unique_ptr<hits_processor> do_clone() const final;
+
+				void do_process_hits_for_query(const std::string &,
+				                               const crh_filter_spec &,
+				                               const crh_score_spec &,
+				                               const crh_segment_spec &,
+				                               const calc_hit_list &) final;
+
+				void do_finish_work() final;
+
+				bool do_wants_hits_that_fail_score_filter() const final;
+
+				bool do_requires_strictly_worse_hits() const final;
+
+			public:
+				explicit write_html_dir_hits_processor(boost::filesystem::path,
+				                                       crh_html_spec = crh_html_spec{}) noexcept;
+
+				write_html_dir_hits_processor(const write_html_dir_hits_processor &);
+				write_html_dir_hits_processor(write_html_dir_hits_processor &&) noexcept = default;
+				write_html_dir_hits_processor & operator=(const write_html_dir_hits_processor &) = delete;
+				write_html_dir_hits_processor & operator=(write_html_dir_hits_processor &&) = delete;
+			};
+
+		} // namespace detail
+	} // namespace rslv
+} // namespace cath
+
+#endif
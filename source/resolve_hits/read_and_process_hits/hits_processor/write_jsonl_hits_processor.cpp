@@ -0,0 +1,148 @@
+/// \file
+/// \brief The write_jsonl_hits_processor class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "write_jsonl_hits_processor.hpp"
+
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "common/clone/make_uptr_clone.hpp"
+#include "common/exception/out_of_range_exception.hpp"
+#include "common/rapidjson_addenda/string_of_rapidjson_write.hpp"
+#include "resolve_hits/calc_hit_list.hpp"
+#include "resolve_hits/full_hit_list_fns.hpp"
+#include "resolve_hits/full_hit_rapidjson.hpp"
+#include "resolve_hits/resolve/hit_resolver.hpp"
+#include "resolve_hits/scored_hit_arch.hpp"
+
+#include <ios>
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::rslv::detail;
+
+using std::move;
+using std::ostream;
+using std::streamsize;
+using std::string;
+using std::unique_ptr;
+
+/// \brief The number of bytes of output to accumulate before writing it to the ostreams
+///
+/// This is large so that the output is written (and, if requested, compressed) in a small number of big chunks
+static constexpr size_t JSONL_BUFFER_FLUSH_SIZE = 4 * 1024 * 1024;
+
+/// \brief Return the gzip-compressed form of the specified data, as a single, complete gzip member
+static string gzip_compressed(const string &prm_data ///< The data to compress
+                              ) {
+	string compressed;
+	{
+		boost::iostreams::filtering_ostream gzip_stream;
+		gzip_stream.push( boost::iostreams::gzip_compressor{} );
+		gzip_stream.push( boost::iostreams::back_inserter( compressed ) );
+		gzip_stream.write( prm_data.data(), static_cast<streamsize>( prm_data.size() ) );
+	}
+	return compressed;
+}
+
+/// \brief Write the buffer (compressed if requested) to each of the ostreams and then empty it
+void write_jsonl_hits_processor::flush_buffer() {
+	if ( buffer.empty() ) {
+		return;
+	}
+	const string  compressed = gzip_output ? gzip_compressed( buffer ) : string{};
+	const string &to_write   = gzip_output ? compressed                : buffer;
+	for (const ostream_ref &ostream_ref : get_ostreams() ) {
+		ostream_ref.get().write( to_write.data(), static_cast<streamsize>( to_write.size() ) );
+	}
+	buffer.clear();
+}
+
+/// \brief A standard do_clone method
+unique_ptr<hits_processor> write_jsonl_hits_processor::do_clone() const {
+	return { make_uptr_clone( *this ) };
+}
+
+/// \brief Process the specified data
+///
+/// This is called directly in process_all_outstanding() and through async in trigger_async_process_query_id()
+void write_jsonl_hits_processor::do_process_hits_for_query(const string           &prm_query_id,        ///< The query_protein_id string
+                                                           const crh_filter_spec  &/*prm_filter_spec*/, ///< The filter_spec to apply to the hits
+                                                           const crh_score_spec   &prm_score_spec,      ///< The score spec to apply to the hits
+                                                           const crh_segment_spec &prm_segment_spec,    ///< The segment spec to apply to the hits
+                                                           const calc_hit_list    &prm_calc_hits        ///< The hits to process
+                                                           ) {
+	// Resolve the hits
+	const auto result_hit_arch  = resolve_hits( prm_calc_hits, prm_score_spec.get_naive_greedy() );
+	const auto result_full_hits = get_full_hits_of_hit_arch(
+		result_hit_arch,
+		prm_calc_hits.get_full_hits()
+	);
+
+	// Append the results to the buffer as a single line of compact JSON
+	buffer += string_of_rapidjson_write<json_style::COMPACT>(
+		[&] (rapidjson_writer<json_style::COMPACT> &x) {
+			x.start_object();
+			x.write_key( prm_query_id );
+			write_to_rapidjson_with_compact_fullhits( x, result_full_hits, prm_segment_spec );
+			x.end_object();
+		}
+	);
+	buffer += '\n';
+
+	if ( buffer.size() >= JSONL_BUFFER_FLUSH_SIZE ) {
+		flush_buffer();
+	}
+}
+
+/// \brief Write any remaining buffered output to the ostreams and flush them
+void write_jsonl_hits_processor::do_finish_work() {
+	flush_buffer();
+	for (const ostream_ref &ostream_ref : get_ostreams() ) {
+		ostream_ref.get().flush();
+	}
+}
+
+/// \brief Return false: read_and_resolve_mgr needn't parse hits that fail the score filter or pass them to this processor
+bool write_jsonl_hits_processor::do_wants_hits_that_fail_score_filter() const {
+	return false;
+}
+
+/// \brief Return false: read_and_resolve_mgr may strip out strictly worse hits from the data; they aren't required
+bool write_jsonl_hits_processor::do_requires_strictly_worse_hits() const {
+	return false;
+}
+
+/// \brief Ctor for write_jsonl_hits_processor
+write_jsonl_hits_processor::write_jsonl_hits_processor(ref_vec<ostream>  prm_ostreams,   ///< The ostreams to which the results should be written
+                                                       const bool       &prm_gzip_output ///< Whether to gzip-compress the output
+                                                       ) noexcept : super       { move( prm_ostreams ) },
+                                                                    gzip_output { prm_gzip_output      } {
+}
+
+/// \brief Copy ctor for write_jsonl_hits_processor
+write_jsonl_hits_processor::write_jsonl_hits_processor(const write_jsonl_hits_processor &prm_rhs ///< The other write_jsonl_hits_processor from which to copy construct
+                                                       ) : super       { prm_rhs             },
+                                                           gzip_output { prm_rhs.gzip_output } {
+	if ( ! prm_rhs.buffer.empty() ) {
+		BOOST_THROW_EXCEPTION(out_of_range_exception("Unable to copy construct from write_jsonl_hits_processor that has unwritten output"));
+	}
+}
@@ -0,0 +1,82 @@
+/// \file
+/// \brief The write_jsonl_hits_processor class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_JSONL_HITS_PROCESSOR_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_READ_AND_PROCESS_HITS_HITS_PROCESSOR_WRITE_JSONL_HITS_PROCESSOR_HPP
+
+#include "resolve_hits/read_and_process_hits/hits_processor/hits_processor.hpp"
+
+#include <string>
+
+namespace cath {
+	namespace rslv {
+		namespace detail {
+
+			/// \brief Hits processor that writes compact JSON Lines output (one line per query) to the hits_processor's ostreams
+			///
+			/// Each line is a compact JSON object with the query ID as its only key, so
+			/// the lines can be merged into the same structure as write_json_hits_processor's output.
+			///
+			/// The lines are accumulated in a large buffer, which is written to the ostreams in
+			/// single, large writes. If requested, each buffer-full is gzip-compressed as a separate
+			/// gzip member; standard tools (gzip, zcat etc) decompress the concatenated members
+			/// as one stream.
+			class write_jsonl_hits_processor final : public hits_processor {
+			private:
+				/// \brief Convenience type alias for the parent class
+				using super = hits_processor;
+
+				/// \brief Whether to gzip-compress the output
+				bool        gzip_output;
+
+				/// \brief The buffer of lines that have yet to be written to the ostreams
+				std::string buffer;
+
+				void flush_buffer();
+
+				std::unique_ptr<hits_processor> do_clone() const final;
+
+				void do_process_hits_for_query(const std::string &,
+				                               const crh_filter_spec &,
+				                               const crh_score_spec &,
+				                               const crh_segment_spec &,
+				                               const calc_hit_list &) final;
+
+				void do_finish_work() final;
+
+				bool do_wants_hits_that_fail_score_filter() const final;
+
+				bool do_requires_strictly_worse_hits() const final;
+
+			public:
+				explicit write_jsonl_hits_processor(ref_vec<std::ostream>,
+				                                    const bool & = false) noexcept;
+
+				write_jsonl_hits_processor(const write_jsonl_hits_processor &);
+				write_jsonl_hits_processor(write_jsonl_hits_processor &&) noexcept = default;
+				write_jsonl_hits_processor & operator=(const write_jsonl_hits_processor &) = delete;
+				write_jsonl_hits_processor & operator=(write_jsonl_hits_processor &&) = delete;
+			};
+
+		} // namespace detail
+	} // namespace rslv
+} // namespace cath
+
+#endif
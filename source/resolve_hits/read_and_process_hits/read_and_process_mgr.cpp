@@ -28,10 +28,12 @@
 #include "resolve_hits/options/spec/crh_input_spec.hpp"
 #include "resolve_hits/options/spec/crh_spec.hpp"
 #include "resolve_hits/read_and_process_hits/hits_processor/hits_processor_list.hpp"
+#include "resolve_hits/resolve/crh_result_cache.hpp"
 #include "resolve_hits/resolve/hit_resolver.hpp"
 #include "resolve_hits/scored_hit_arch.hpp"
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <thread>
 #include <utility>
@@ -41,6 +43,7 @@ using namespace cath::common;
 using namespace cath::rslv;
 using namespace cath::rslv::detail;
 
+using std::make_shared;
 using std::ostream;
 using std::string;
 
@@ -151,15 +154,16 @@ read_and_process_mgr cath::rslv::make_read_and_process_mgr(const hits_processor_
 read_and_process_mgr cath::rslv::make_read_and_process_mgr(ofstream_list  &prm_ofstreams, ///< The ofstream_list to which the read_and_process_mgr's hits_processors should write
                                                            const crh_spec &prm_spec       ///< The crh_spec to specify what to do
                                                            ) {
-	return make_read_and_process_mgr(
-		make_hits_processors(
-			prm_ofstreams,
-			prm_spec.get_single_output_spec(),
-			prm_spec.get_output_spec(),
-			prm_spec.get_score_spec(),
-			prm_spec.get_segment_spec(),
-			prm_spec.get_html_spec()
-		),
-		prm_spec
+	hits_processor_list the_processors = make_hits_processors(
+		prm_ofstreams,
+		prm_spec.get_single_output_spec(),
+		prm_spec.get_output_spec(),
+		prm_spec.get_score_spec(),
+		prm_spec.get_segment_spec(),
+		prm_spec.get_html_spec()
 	);
+	if ( const path_opt &result_cache_file = prm_spec.get_input_spec().get_result_cache_file() ) {
+		the_processors.set_result_cache_ptr( make_shared<crh_result_cache>( *result_cache_file ) );
+	}
+	return make_read_and_process_mgr( the_processors, prm_spec );
 }
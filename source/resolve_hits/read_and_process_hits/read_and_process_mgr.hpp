@@ -150,7 +150,7 @@ namespace cath {
 
 			void add_hit(const boost::string_ref &,
 			             seq::seq_seg_vec,
-			             std::string,
+			             const boost::string_ref &,
 			             const double &,
 			             const hit_score_type &,
 			             hit_extras_store = {});
@@ -242,7 +242,7 @@ namespace cath {
 		/// \pre `is_active()` else an invalid_argument_exception will be thrown
 		inline void read_and_process_mgr::add_hit(const boost::string_ref &prm_query_id,   ///< A string_ref of the query_id
 		                                          seq::seq_seg_vec         prm_segments,   ///< Any fragments of the new hit
-		                                          std::string              prm_label,      ///< The label associated with the new hit
+		                                          const boost::string_ref &prm_label,      ///< The label associated with the new hit
 		                                          const double            &prm_score,      ///< The score associated with the new hit
 		                                          const hit_score_type    &prm_score_type, ///< The type of the score
 		                                          hit_extras_store         prm_hit_extras  ///< Any HMMER aligned regions or else none
@@ -287,7 +287,10 @@ namespace cath {
 					detail::full_hit_prune_builder{
 						processors.requires_strictly_worse_hits()
 							? seg_dupl_hit_policy::PRESERVE
-							: seg_dupl_hit_policy::PRUNE
+							: seg_dupl_hit_policy::PRUNE,
+						processors.get_score_spec(),
+						processors.get_segment_spec(),
+						the_filter_spec
 					}
 				).first->second;
 			};
@@ -302,7 +305,7 @@ namespace cath {
 			// Add the new hit to the query's hits data
 			the_builder.add_hit( full_hit{
 				std::move( prm_segments ),
-				std::move( prm_label ),
+				prm_label,
 				prm_score,
 				prm_score_type,
 				std::move( prm_hit_extras )
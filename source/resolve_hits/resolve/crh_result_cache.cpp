@@ -0,0 +1,369 @@
+/// \file
+/// \brief The crh_result_cache class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "crh_result_cache.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#include "common/cpp14/cbegin_cend.hpp"
+#include "common/exception/runtime_error_exception.hpp"
+#include "common/file/open_fstream.hpp"
+#include "resolve_hits/calc_hit_list.hpp"
+#include "resolve_hits/resolve/hit_resolver.hpp"
+#include "resolve_hits/scored_hit_arch.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace cath::common;
+using namespace cath::rslv;
+
+using boost::filesystem::exists;
+using boost::filesystem::file_size;
+using boost::filesystem::path;
+using boost::filesystem::resize_file;
+using boost::none;
+using boost::numeric_cast;
+using std::ifstream;
+using std::ios_base;
+using std::ofstream;
+using std::streamsize;
+using std::string;
+using std::vector;
+
+constexpr size_t crh_result_cache::FLUSH_SIZE;
+
+/// \brief The magic at the start of a cath-resolve-hits result cache file
+static const string CRH_RESULT_CACHE_MAGIC { "CRHCACHE", 8 };
+
+/// \brief The version of the cath-resolve-hits result cache format
+///
+/// This is also fed into each fingerprint so that changing it invalidates old entries
+static constexpr uint32_t CRH_RESULT_CACHE_VERSION = 1;
+
+/// \brief The number of bytes in the header of a cath-resolve-hits result cache file
+static constexpr size_t CRH_RESULT_CACHE_HEADER_SIZE = 16;
+
+/// \brief The number of bytes in the fixed-size part of each entry (fingerprint, score and number of hits)
+static constexpr size_t CRH_RESULT_CACHE_ENTRY_FIXED_SIZE = 28;
+
+/// \brief Append the specified unsigned integer to the specified bytes in little-endian order
+template <typename T>
+static void append_le(string  &prm_bytes, ///< The bytes to which the value should be appended
+                      const T &prm_value  ///< The value to append
+                      ) {
+	static_assert( std::is_unsigned<T>::value, "append_le() should only be used with unsigned integers" );
+	for (size_t byte_ctr = 0; byte_ctr < sizeof( T ); ++byte_ctr) {
+		prm_bytes.push_back( static_cast<char>( ( prm_value >> ( 8 * byte_ctr ) ) & 0xFFu ) );
+	}
+}
+
+/// \brief Decode a little-endian unsigned integer from the specified position in the specified bytes
+template <typename T>
+static T decode_le(const string &prm_bytes, ///< The bytes from which to decode
+                   const size_t &prm_offset ///< The offset of the value in the bytes
+                   ) {
+	static_assert( std::is_unsigned<T>::value, "decode_le() should only be used with unsigned integers" );
+	T value = 0;
+	for (size_t byte_ctr = 0; byte_ctr < sizeof( T ); ++byte_ctr) {
+		value = static_cast<T>( value | ( static_cast<T>( static_cast<unsigned char>( prm_bytes[ prm_offset + byte_ctr ] ) ) << ( 8 * byte_ctr ) ) );
+	}
+	return value;
+}
+
+/// \brief Get the bits of the specified double
+static uint64_t bits_of_double(const double &prm_value ///< The value whose bits should be returned
+                               ) {
+	static_assert( sizeof( double ) == sizeof( uint64_t ), "This code requires that double is 64 bits" );
+	uint64_t bits;
+	std::memcpy( &bits, &prm_value, sizeof( bits ) );
+	return bits;
+}
+
+/// \brief Get the double with the specified bits
+static double double_of_bits(const uint64_t &prm_bits ///< The bits of the double
+                             ) {
+	double value;
+	std::memcpy( &value, &prm_bits, sizeof( value ) );
+	return value;
+}
+
+namespace {
+
+	/// \brief Accumulate a 128-bit fingerprint from a sequence of 64-bit words
+	///
+	/// This uses two differently-constructed 64-bit lanes (FNV-1a over the bytes and
+	/// a multiply-rotate mix over the words) so that a collision requires both to collide.
+	class fingerprint_builder final {
+	private:
+		/// \brief The FNV-1a lane
+		uint64_t fnv_lane = 0xcbf29ce484222325ULL;
+
+		/// \brief The multiply-rotate lane
+		uint64_t mix_lane = 0x9e3779b97f4a7c15ULL;
+
+	public:
+		/// \brief Add the specified word to the fingerprint
+		fingerprint_builder & add(const uint64_t &prm_word ///< The word to add
+		                          ) {
+			for (size_t byte_ctr = 0; byte_ctr < sizeof( prm_word ); ++byte_ctr) {
+				fnv_lane ^= ( ( prm_word >> ( 8 * byte_ctr ) ) & 0xFFu );
+				fnv_lane *= 0x100000001b3ULL;
+			}
+			uint64_t mixed = prm_word * 0x87c37b91114253d5ULL;
+			mixed = ( mixed << 31 ) | ( mixed >> 33 );
+			mix_lane ^= mixed * 0x4cf5ad432745937fULL;
+			mix_lane  = ( ( mix_lane << 27 ) | ( mix_lane >> 37 ) ) * 5 + 0x52dce729;
+			return *this;
+		}
+
+		/// \brief Add the specified string (preceded by its length) to the fingerprint
+		fingerprint_builder & add(const boost::string_ref &prm_string ///< The string to add
+		                          ) {
+			add( static_cast<uint64_t>( prm_string.length() ) );
+			uint64_t word = 0;
+			for (size_t char_ctr = 0; char_ctr < prm_string.length(); ++char_ctr) {
+				word |= static_cast<uint64_t>( static_cast<unsigned char>( prm_string[ char_ctr ] ) ) << ( 8 * ( char_ctr % 8 ) );
+				if ( char_ctr % 8 == 7 ) {
+					add( word );
+					word = 0;
+				}
+			}
+			if ( prm_string.length() % 8 != 0 ) {
+				add( word );
+			}
+			return *this;
+		}
+
+		/// \brief Get the fingerprint
+		crh_result_fingerprint get_fingerprint() const {
+			return { fnv_lane, mix_lane };
+		}
+	};
+
+} // namespace
+
+/// \brief Make a fingerprint of the specified calc_hit_list when resolved with the specified approach
+///
+/// The calc_hit_list's hits already reflect the score, segment and filter specs
+/// (and the hits' order reflects any tie-breaking on labels) so this covers everything
+/// that affects the resolution.
+crh_result_fingerprint cath::rslv::make_result_fingerprint(const calc_hit_list &prm_calc_hits,   ///< The calc_hit_list to fingerprint
+                                                           const bool          &prm_naive_greedy ///< Whether the hits are to be resolved using a naive, greedy approach
+                                                           ) {
+	fingerprint_builder builder;
+	builder.add( static_cast<uint64_t>( CRH_RESULT_CACHE_VERSION ) )
+	       .add( static_cast<uint64_t>( prm_naive_greedy         ) )
+	       .add( static_cast<uint64_t>( prm_calc_hits.size()     ) );
+	const full_hit_list &full_hits = prm_calc_hits.get_full_hits();
+	for (const calc_hit &the_hit : prm_calc_hits) {
+		const auto &segments = the_hit.get_segments();
+		builder.add( static_cast<uint64_t>( the_hit.get_label_idx() ) )
+		       .add( bits_of_double( static_cast<double>( the_hit.get_score() ) ) )
+		       .add( full_hits[ the_hit.get_label_idx() ].get_label() )
+		       .add( static_cast<uint64_t>( segments.get_num_segments() ) );
+		for (size_t seg_ctr = 0; seg_ctr < segments.get_num_segments(); ++seg_ctr) {
+			builder.add( static_cast<uint64_t>( segments.get_start_arrow_of_segment( seg_ctr ).get_index() ) )
+			       .add( static_cast<uint64_t>( segments.get_stop_arrow_of_segment ( seg_ctr ).get_index() ) );
+		}
+	}
+	return builder.get_fingerprint();
+}
+
+/// \brief Load any entries from the cache file, discarding any incomplete entry at the end
+void crh_result_cache::load() {
+	if ( ! exists( cache_file ) || file_size( cache_file ) == 0 ) {
+		return;
+	}
+
+	ifstream cache_stream;
+	open_ifstream( cache_stream, cache_file, ios_base::in | ios_base::binary );
+	const string bytes{ std::istreambuf_iterator<char>( cache_stream ), std::istreambuf_iterator<char>() };
+	cache_stream.close();
+
+	if ( bytes.size() < CRH_RESULT_CACHE_HEADER_SIZE || bytes.compare( 0, CRH_RESULT_CACHE_MAGIC.size(), CRH_RESULT_CACHE_MAGIC ) != 0 ) {
+		BOOST_THROW_EXCEPTION(runtime_error_exception(
+			"File \"" + cache_file.string() + "\" isn't a cath-resolve-hits result cache"
+		));
+	}
+	const auto version = decode_le<uint32_t>( bytes, CRH_RESULT_CACHE_MAGIC.size() );
+	if ( version != CRH_RESULT_CACHE_VERSION ) {
+		BOOST_THROW_EXCEPTION(runtime_error_exception(
+			"Cannot use cath-resolve-hits result cache \"" + cache_file.string() + "\" of unsupported version "
+			+ std::to_string( version )
+		));
+	}
+	file_has_header = true;
+
+	size_t offset = CRH_RESULT_CACHE_HEADER_SIZE;
+	while ( offset + CRH_RESULT_CACHE_ENTRY_FIXED_SIZE <= bytes.size() ) {
+		const auto num_hits   = decode_le<uint32_t>( bytes, offset + 24 );
+		const auto entry_size = CRH_RESULT_CACHE_ENTRY_FIXED_SIZE + num_hits * sizeof( uint32_t );
+		if ( offset + entry_size > bytes.size() ) {
+			break;
+		}
+		hitidx_vec label_idxs;
+		label_idxs.reserve( num_hits );
+		for (size_t hit_ctr = 0; hit_ctr < num_hits; ++hit_ctr) {
+			label_idxs.push_back( decode_le<uint32_t>( bytes, offset + CRH_RESULT_CACHE_ENTRY_FIXED_SIZE + hit_ctr * sizeof( uint32_t ) ) );
+		}
+		resolutions[ { decode_le<uint64_t>( bytes, offset ), decode_le<uint64_t>( bytes, offset + 8 ) } ] = {
+			static_cast<resscr_t>( double_of_bits( decode_le<uint64_t>( bytes, offset + 16 ) ) ),
+			std::move( label_idxs )
+		};
+		offset += entry_size;
+	}
+
+	// Drop any incomplete entry at the end so that new entries can be appended cleanly
+	if ( offset != bytes.size() ) {
+		resize_file( cache_file, offset );
+	}
+}
+
+/// \brief Ctor from the file in which the cache is (or is to be) stored, which loads any existing entries
+crh_result_cache::crh_result_cache(path prm_cache_file ///< The file in which the cache is (or is to be) stored
+                                   ) : cache_file{ std::move( prm_cache_file ) } {
+	load();
+}
+
+/// \brief Dtor that attempts to write any entries that haven't yet been written
+crh_result_cache::~crh_result_cache() noexcept {
+	try {
+		flush();
+	}
+	catch (...) {
+	}
+}
+
+/// \brief Get the number of resolutions in the cache
+size_t crh_result_cache::size() const {
+	return resolutions.size();
+}
+
+/// \brief Getter for the number of queries whose resolution was found in the cache
+const size_t & crh_result_cache::get_num_found() const {
+	return num_found;
+}
+
+/// \brief Getter for the number of queries that had to be resolved
+const size_t & crh_result_cache::get_num_resolved() const {
+	return num_resolved;
+}
+
+/// \brief Find the cached resolution of the specified calc_hit_list (with the specified fingerprint)
+///        or return none if there isn't one
+///
+/// This also returns none if the cached resolution refers to hits that aren't in the calc_hit_list,
+/// which shouldn't happen unless the cache file has been tampered with
+scored_hit_arch_opt crh_result_cache::find(const crh_result_fingerprint &prm_fingerprint, ///< The fingerprint of the calc_hit_list
+                                           const calc_hit_list          &prm_calc_hits    ///< The calc_hit_list whose resolution should be found
+                                           ) const {
+	const auto find_itr = resolutions.find( prm_fingerprint );
+	if ( find_itr == common::cend( resolutions ) ) {
+		return none;
+	}
+
+	// Index the calc_hits by their label indices
+	vector<const calc_hit *> hit_of_label_idx( prm_calc_hits.get_full_hits().size(), nullptr );
+	for (const calc_hit &the_hit : prm_calc_hits) {
+		hit_of_label_idx[ the_hit.get_label_idx() ] = &the_hit;
+	}
+
+	calc_hit_vec arch_hits;
+	arch_hits.reserve( find_itr->second.second.size() );
+	for (const hitidx_t &label_idx : find_itr->second.second) {
+		if ( label_idx >= hit_of_label_idx.size() || hit_of_label_idx[ label_idx ] == nullptr ) {
+			return none;
+		}
+		arch_hits.push_back( *hit_of_label_idx[ label_idx ] );
+	}
+	return scored_hit_arch{ find_itr->second.first, hit_arch{ std::move( arch_hits ) } };
+}
+
+/// \brief Store the specified resolution under the specified fingerprint
+///
+/// The entry is appended to the cache file on the next flush(), which is triggered
+/// automatically once FLUSH_SIZE bytes of new entries have accumulated
+void crh_result_cache::store(const crh_result_fingerprint &prm_fingerprint, ///< The fingerprint of the calc_hit_list that was resolved
+                             const scored_hit_arch        &prm_resolution   ///< The resolution of the calc_hit_list
+                             ) {
+	const hit_arch &the_arch = prm_resolution.get_arch();
+	hitidx_vec label_idxs;
+	label_idxs.reserve( the_arch.size() );
+	for (const calc_hit &the_hit : the_arch) {
+		label_idxs.push_back( the_hit.get_label_idx() );
+	}
+
+	append_le( unwritten_bytes, prm_fingerprint.first  );
+	append_le( unwritten_bytes, prm_fingerprint.second );
+	append_le( unwritten_bytes, bits_of_double( static_cast<double>( prm_resolution.get_score() ) ) );
+	append_le( unwritten_bytes, numeric_cast<uint32_t>( label_idxs.size() ) );
+	for (const hitidx_t &label_idx : label_idxs) {
+		append_le( unwritten_bytes, static_cast<uint32_t>( label_idx ) );
+	}
+
+	resolutions[ prm_fingerprint ] = { prm_resolution.get_score(), std::move( label_idxs ) };
+
+	if ( unwritten_bytes.size() >= FLUSH_SIZE ) {
+		flush();
+	}
+}
+
+/// \brief Resolve the specified calc_hit_list with the specified approach, using the cached
+///        resolution if there is one and otherwise resolving and storing the result
+scored_hit_arch crh_result_cache::resolve(const calc_hit_list &prm_calc_hits,   ///< The calc_hit_list to resolve
+                                          const bool          &prm_naive_greedy ///< Whether to use a naive, greedy approach to resolving
+                                          ) {
+	const crh_result_fingerprint fingerprint = make_result_fingerprint( prm_calc_hits, prm_naive_greedy );
+	if ( scored_hit_arch_opt found_resolution = find( fingerprint, prm_calc_hits ) ) {
+		++num_found;
+		return std::move( *found_resolution );
+	}
+
+	++num_resolved;
+	scored_hit_arch resolution = resolve_hits( prm_calc_hits, prm_naive_greedy );
+	store( fingerprint, resolution );
+	return resolution;
+}
+
+/// \brief Append any new entries to the cache file (writing the header first if required)
+///
+/// This can safely be called repeatedly
+void crh_result_cache::flush() {
+	if ( unwritten_bytes.empty() && file_has_header ) {
+		return;
+	}
+
+	ofstream cache_stream;
+	open_ofstream( cache_stream, cache_file, ios_base::out | ios_base::app | ios_base::binary );
+	if ( ! file_has_header ) {
+		string header_bytes = CRH_RESULT_CACHE_MAGIC;
+		append_le( header_bytes, CRH_RESULT_CACHE_VERSION );
+		append_le( header_bytes, static_cast<uint32_t>( 0 ) );
+		cache_stream.write( header_bytes.data(), static_cast<streamsize>( header_bytes.size() ) );
+		file_has_header = true;
+	}
+	cache_stream.write( unwritten_bytes.data(), static_cast<streamsize>( unwritten_bytes.size() ) );
+	cache_stream.close();
+	unwritten_bytes.clear();
+}
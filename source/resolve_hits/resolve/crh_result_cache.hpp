@@ -0,0 +1,124 @@
+/// \file
+/// \brief The crh_result_cache class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_RESOLVE_HITS_RESOLVE_CRH_RESULT_CACHE_HPP
+#define _CATH_TOOLS_SOURCE_RESOLVE_HITS_RESOLVE_CRH_RESULT_CACHE_HPP
+
+#include <boost/filesystem/path.hpp>
+
+#include "resolve_hits/resolve_hits_type_aliases.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace cath { namespace rslv { class calc_hit_list; } }
+
+namespace cath {
+	namespace rslv {
+
+		/// \brief Type alias for a 128-bit fingerprint of a query's hits and the settings that affect how they're resolved
+		using crh_result_fingerprint = std::pair<uint64_t, uint64_t>;
+
+		crh_result_fingerprint make_result_fingerprint(const calc_hit_list &,
+		                                               const bool &);
+
+		/// \brief An on-disk cache of resolved hit architectures, keyed on fingerprints of the queries' hits
+		///
+		/// This allows a rerun of cath-resolve-hits over mostly-unchanged data to skip
+		/// resolving any query whose hits (and relevant settings) are the same as before.
+		///
+		/// The fingerprint is made from the calc_hit_list, which already reflects the
+		/// score, segment and filter specs, so it only needs to add the resolving approach.
+		///
+		/// Each resolution is stored as its score and the label indices of its hits
+		/// (which index into the query's full_hit_list) so that it can be rebuilt
+		/// from the calc_hit_list on a later run.
+		///
+		/// The file is a little-endian, append-only log:
+		///  * a header: the 8-byte magic `CRHCACHE`, a u32 version and a u32 reserved field
+		///  * entries, each: u64 fingerprint (x2), f64 score, u32 number of hits, u32 label indices
+		///
+		/// New entries are buffered and appended to the file by flush(), which can safely be called repeatedly.
+		/// Any incomplete entry at the end of the file (eg from an interrupted run) is discarded on loading.
+		class crh_result_cache final {
+		private:
+			/// \brief Hasher for crh_result_fingerprint (which is already well mixed)
+			struct fingerprint_hasher final {
+				size_t operator()(const crh_result_fingerprint &prm_fingerprint ///< The fingerprint to hash
+				                  ) const {
+					return static_cast<size_t>( prm_fingerprint.first );
+				}
+			};
+
+			/// \brief Type alias for a cached resolution: the score and the label indices of the hits
+			using cached_resolution = std::pair<resscr_t, hitidx_vec>;
+
+			/// \brief The file in which the cache is stored
+			boost::filesystem::path cache_file;
+
+			/// \brief The resolutions in the cache, keyed on fingerprint
+			std::unordered_map<crh_result_fingerprint, cached_resolution, fingerprint_hasher> resolutions;
+
+			/// \brief Encoded entries that have yet to be appended to the cache file
+			std::string unwritten_bytes;
+
+			/// \brief Whether the cache file has a header yet
+			bool file_has_header = false;
+
+			/// \brief The number of queries whose resolution was found in the cache
+			size_t num_found    = 0;
+
+			/// \brief The number of queries that had to be resolved
+			size_t num_resolved = 0;
+
+			void load();
+
+		public:
+			/// \brief The number of bytes of new entries to accumulate before appending them to the cache file
+			static constexpr size_t FLUSH_SIZE = 1024 * 1024;
+
+			explicit crh_result_cache(boost::filesystem::path);
+			crh_result_cache(const crh_result_cache &) = delete;
+			crh_result_cache(crh_result_cache &&) = delete;
+			crh_result_cache & operator=(const crh_result_cache &) = delete;
+			crh_result_cache & operator=(crh_result_cache &&) = delete;
+			~crh_result_cache() noexcept;
+
+			size_t size() const;
+			const size_t & get_num_found() const;
+			const size_t & get_num_resolved() const;
+
+			scored_hit_arch_opt find(const crh_result_fingerprint &,
+			                         const calc_hit_list &) const;
+			void store(const crh_result_fingerprint &,
+			           const scored_hit_arch &);
+
+			scored_hit_arch resolve(const calc_hit_list &,
+			                        const bool &);
+
+			void flush();
+		};
+
+	} // namespace rslv
+} // namespace cath
+
+#endif
@@ -0,0 +1,128 @@
+/// \file
+/// \brief The crh_result_cache test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/filesystem.hpp>
+#include <boost/range/algorithm/equal.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "common/file/temp_file.hpp"
+#include "resolve_hits/calc_hit_list.hpp"
+#include "resolve_hits/options/spec/crh_segment_spec.hpp"
+#include "resolve_hits/resolve/crh_result_cache.hpp"
+#include "resolve_hits/resolve/hit_resolver.hpp"
+#include "resolve_hits/scored_hit_arch.hpp"
+
+using namespace cath::common;
+using namespace cath::rslv;
+using namespace cath::seq;
+
+using boost::filesystem::file_size;
+using boost::filesystem::resize_file;
+using boost::range::equal;
+
+namespace cath {
+	namespace test {
+
+		/// \brief The crh_result_cache_test_suite_fixture to assist in testing crh_result_cache
+		struct crh_result_cache_test_suite_fixture {
+		protected:
+			~crh_result_cache_test_suite_fixture() noexcept = default;
+
+			/// \brief Make a calc_hit_list from some overlapping hits, with the specified score for the last hit
+			static calc_hit_list make_calc_hits(const double &prm_last_score = 3.0 ///< The score for the last hit
+			                                    ) {
+				return calc_hit_list{
+					full_hit_list{ {
+						full_hit{ seq_seg_vec{ {  10,  79 }             }, "alice",   2.0            },
+						full_hit{ seq_seg_vec{ {  60, 139 }             }, "betty",   4.0            },
+						full_hit{ seq_seg_vec{ { 130, 199 }, { 230, 249 } }, "camilla", prm_last_score },
+					} },
+					crh_score_spec{},
+					crh_segment_spec{}
+				};
+			}
+
+			/// \brief A temporary file in which to store the cache
+			const temp_file cache_file{ ".crh_result_cache_test_file.%%%%-%%%%-%%%%-%%%%" };
+		};
+
+	} // namespace test
+} // namespace cath
+
+BOOST_FIXTURE_TEST_SUITE(crh_result_cache_test_suite, cath::test::crh_result_cache_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(fingerprint_depends_on_hits_and_approach) {
+	const auto fingerprint = make_result_fingerprint( make_calc_hits(), false );
+	BOOST_CHECK( fingerprint == make_result_fingerprint( make_calc_hits(),      false ) );
+	BOOST_CHECK( fingerprint != make_result_fingerprint( make_calc_hits(),      true  ) );
+	BOOST_CHECK( fingerprint != make_result_fingerprint( make_calc_hits( 3.5 ), false ) );
+}
+
+BOOST_AUTO_TEST_CASE(resolutions_are_found_after_reloading) {
+	const auto            calc_hits = make_calc_hits();
+	const scored_hit_arch expected  = resolve_hits( calc_hits, false );
+	{
+		crh_result_cache the_cache{ get_filename( cache_file ) };
+		BOOST_CHECK_EQUAL( the_cache.size(), 0 );
+		const scored_hit_arch got = the_cache.resolve( calc_hits, false );
+		BOOST_CHECK_EQUAL( got.get_score(), expected.get_score() );
+		BOOST_CHECK( equal( got.get_arch(), expected.get_arch() ) );
+		BOOST_CHECK_EQUAL( the_cache.get_num_resolved(), 1 );
+		the_cache.flush();
+	}
+
+	crh_result_cache the_cache{ get_filename( cache_file ) };
+	BOOST_CHECK_EQUAL( the_cache.size(), 1 );
+	const scored_hit_arch got = the_cache.resolve( calc_hits, false );
+	BOOST_CHECK_EQUAL( got.get_score(), expected.get_score() );
+	BOOST_CHECK( equal( got.get_arch(), expected.get_arch() ) );
+	BOOST_CHECK_EQUAL( the_cache.get_num_found(),    1 );
+	BOOST_CHECK_EQUAL( the_cache.get_num_resolved(), 0 );
+
+	the_cache.resolve( make_calc_hits( 3.5 ), false );
+	BOOST_CHECK_EQUAL( the_cache.get_num_resolved(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_final_entry_is_discarded) {
+	{
+		crh_result_cache the_cache{ get_filename( cache_file ) };
+		the_cache.resolve( make_calc_hits(),      false );
+		the_cache.resolve( make_calc_hits( 3.5 ), false );
+	}
+	resize_file( get_filename( cache_file ), file_size( get_filename( cache_file ) ) - 2 );
+
+	{
+		crh_result_cache the_cache{ get_filename( cache_file ) };
+		BOOST_CHECK_EQUAL( the_cache.size(), 1 );
+		the_cache.resolve( make_calc_hits( 3.5 ), false );
+	}
+
+	crh_result_cache the_cache{ get_filename( cache_file ) };
+	BOOST_CHECK_EQUAL( the_cache.size(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE(resolve_hits_uses_known_resolution_for_matching_approach_only) {
+	auto calc_hits = make_calc_hits();
+	calc_hits.set_known_resolution( scored_hit_arch{ 99.0, hit_arch{ calc_hit_vec{ calc_hits[ 0 ] } } }, false );
+	BOOST_CHECK_EQUAL( resolve_hits( calc_hits, false ).get_score(), 99.0 );
+	BOOST_CHECK_NE   ( resolve_hits( calc_hits, true  ).get_score(), 99.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -203,9 +203,15 @@ scored_hit_arch hit_resolver::resolve() {
 }
 
 /// \brief The front-end for resolving hits
+///
+/// If the calc_hit_list already carries a resolution made with the same approach
+/// (eg from a crh_result_cache), that's returned rather than resolving the hits again
 scored_hit_arch cath::rslv::resolve_hits(const calc_hit_list &prm_hits,        ///< The hits to resolve
                                          const bool          &prm_naive_greedy ///< Whether to use a naive, greedy approach to resolving
                                          ) {
+	if ( const scored_hit_arch * const known_resolution_ptr = prm_hits.get_known_resolution( prm_naive_greedy ) ) {
+		return *known_resolution_ptr;
+	}
 	return prm_naive_greedy ? naive_greedy_resolve_hits( prm_hits )
 	                        : detail::hit_resolver{ prm_hits }.resolve();
 }
@@ -26,6 +26,7 @@
 #include "common/type_aliases.hpp"
 #include "seq/seq_type_aliases.hpp"
 
+#include <cstdint>
 #include <iosfwd>
 #include <vector>
 
@@ -34,7 +35,9 @@ namespace cath { namespace rslv { class calc_hit_list; } }
 namespace cath { namespace rslv { class crh_segment_spec; } }
 namespace cath { namespace rslv { class full_hit; } }
 namespace cath { namespace rslv { class full_hit_list; } }
+namespace cath { namespace rslv { class hit_label_table; } }
 namespace cath { namespace rslv { class scored_arch_proxy; } }
+namespace cath { namespace rslv { class scored_hit_arch; } }
 namespace cath { namespace rslv { class trim_spec; } }
 namespace cath { namespace rslv { namespace detail { class full_hit_prune_builder; } } }
 namespace cath { namespace rslv { namespace detail { class hits_processor; } } }
@@ -77,6 +80,9 @@ namespace cath {
 		/// \brief Type alias for a vector of hitidx_t values
 		using hitidx_vec                    = std::vector<hitidx_t>;
 
+		/// \brief Type alias for the type to be used to identify hits' (interned) labels
+		using hitlbl_t                      = uint32_t;
+
 		/// \brief Type alias for a vector of html_hits
 		using html_hit_vec                  = std::vector<html_hit>;
 
@@ -104,6 +110,9 @@ namespace cath {
 		/// \brief Type alias for a vector of scored_arch_proxy objects
 		using scored_arch_proxy_vec         = std::vector<scored_arch_proxy>;
 
+		/// \brief Type alias for an optional scored_hit_arch object
+		using scored_hit_arch_opt           = boost::optional<scored_hit_arch>;
+
 		/// \brief Type alias for a pair of res_arrow_opt values
 		using seg_boundary_pair             = std::pair<seq::res_arrow_opt, seq::res_arrow_opt>;
 
@@ -25,9 +25,13 @@
 #include "common/exception/invalid_argument_exception.hpp"
 #include "common/invert_permutation.hpp"
 
+#include <tuple>
+
 using namespace cath;
 using namespace cath::common;
 
+using std::make_tuple;
+
 /// \brief Get the ordering rank of each entry
 ///
 ///        (ie the position in the resulting size_vec that corresponds to the "first"
@@ -42,9 +46,9 @@ size_vec cath::clust::get_sorting_scores(const id_of_str_bidirnl &prm_name_ider,
 		prm_name_ider.size(),
 		[&] (const size_t &x, const size_t &y) {
 			return (
-				tie( prm_props[ x ], prm_name_ider.get_name_of_id( x ) )
+				make_tuple( prm_props[ x ], prm_name_ider.get_name_of_id( x ) )
 				<
-				tie( prm_props[ y ], prm_name_ider.get_name_of_id( y ) )
+				make_tuple( prm_props[ y ], prm_name_ider.get_name_of_id( y ) )
 			);
 		}
 	) );
@@ -60,9 +64,9 @@ size_vec cath::clust::get_sorting_scores(const id_of_str_bidirnl &prm_name_ider
 		prm_name_ider.size(),
 		[&] (const size_t &x, const size_t &y) {
 			return (
-				tie( prm_name_ider.get_name_of_id( x ) )
+				prm_name_ider.get_name_of_id( x )
 				<
-				tie( prm_name_ider.get_name_of_id( y ) )
+				prm_name_ider.get_name_of_id( y )
 			);
 		}
 	) );
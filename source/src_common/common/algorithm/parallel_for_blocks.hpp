@@ -0,0 +1,144 @@
+/// \file
+/// \brief The parallel_for_blocks() header
+
+/// \copyright
+/// Tony Lewis's Common C++ Library Code (here imported into the CATH Tools project and then tweaked, eg namespaced in cath)
+/// Copyright (C) 2007, Tony Lewis
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_SRC_COMMON_COMMON_ALGORITHM_PARALLEL_FOR_BLOCKS_HPP
+#define _CATH_TOOLS_SOURCE_SRC_COMMON_COMMON_ALGORITHM_PARALLEL_FOR_BLOCKS_HPP
+
+#include "common/boost_addenda/range/indices.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cath {
+	namespace common {
+
+		/// \brief Get the number of threads to use for the specified requested number of threads
+		///
+		/// A request of 0 means one per hardware thread (or 1 if that isn't available)
+		inline size_t num_threads_or_hardware(const size_t &prm_num_threads ///< The requested number of threads (or 0 to use one per hardware thread)
+		                                      ) {
+			return ( prm_num_threads != 0 )
+				? prm_num_threads
+				: std::max( static_cast<size_t>( 1 ), static_cast<size_t>( std::thread::hardware_concurrency() ) );
+		}
+
+		/// \brief Get the number of contiguous blocks into which the specified number of items should be split
+		///
+		/// This is at least 1, at most the number of threads and is low enough that each block gets
+		/// the specified minimum number of items (unless that would make it 0)
+		inline size_t num_parallel_blocks(const size_t &prm_num_items,          ///< The number of items to split
+		                                  const size_t &prm_num_threads,        ///< The number of threads to use (or 0 to use one per hardware thread)
+		                                  const size_t &prm_min_items_per_block ///< The minimum number of items to give each block
+		                                  ) {
+			constexpr size_t ONE = 1;
+			return std::max(
+				ONE,
+				std::min(
+					num_threads_or_hardware( prm_num_threads ),
+					prm_num_items / std::max( ONE, prm_min_items_per_block )
+				)
+			);
+		}
+
+		namespace detail {
+
+			/// \brief Get the begin and end indices of the specified block when the specified number of items
+			///        are split into the specified number of contiguous blocks
+			inline std::pair<size_t, size_t> parallel_block_bounds(const size_t &prm_num_items,  ///< The number of items being split
+			                                                       const size_t &prm_num_blocks, ///< The number of blocks into which the items are being split
+			                                                       const size_t &prm_block_index ///< The index of the block of interest
+			                                                       ) {
+				const size_t block_size  = ( prm_num_items + prm_num_blocks - 1 ) / prm_num_blocks;
+				const size_t block_begin = std::min( prm_num_items, prm_block_index * block_size );
+				return { block_begin, std::min( prm_num_items, block_begin + block_size ) };
+			}
+
+		} // namespace detail
+
+		/// \brief Build a vector of the results of calling the specified function on the begin and end indices of
+		///        each of the contiguous blocks into which the specified number of items is split, concurrently
+		///        if there are multiple blocks
+		///
+		/// The results are in the order of the blocks. If there's only one block, the function is called
+		/// on the current thread.
+		template <typename Fn>
+		auto parallel_transform_blocks(const size_t  &prm_num_items,              ///< The number of items to split into blocks
+		                               const size_t  &prm_num_threads,            ///< The number of threads to use (or 0 to use one per hardware thread)
+		                               Fn           &&prm_fn,                     ///< The function to call on each block's begin and end indices
+		                               const size_t  &prm_min_items_per_block = 1 ///< The minimum number of items to give each block
+		                               ) {
+			using result_t = std::decay_t<decltype( prm_fn( std::declval<size_t>(), std::declval<size_t>() ) )>;
+
+			const size_t num_blocks = num_parallel_blocks( prm_num_items, prm_num_threads, prm_min_items_per_block );
+			std::vector<result_t> results;
+			results.reserve( num_blocks );
+			if ( num_blocks == 1 ) {
+				results.push_back( prm_fn( static_cast<size_t>( 0 ), prm_num_items ) );
+				return results;
+			}
+
+			std::vector<std::future<result_t>> block_futures;
+			block_futures.reserve( num_blocks );
+			for (const size_t &block_ctr : indices( num_blocks ) ) {
+				const auto bounds = detail::parallel_block_bounds( prm_num_items, num_blocks, block_ctr );
+				block_futures.push_back( std::async( std::launch::async, [&prm_fn, bounds] { return prm_fn( bounds.first, bounds.second ); } ) );
+			}
+			for (std::future<result_t> &block_future : block_futures) {
+				results.push_back( block_future.get() );
+			}
+			return results;
+		}
+
+		/// \brief Call the specified function on the begin and end indices of each of the contiguous blocks
+		///        into which the specified number of items is split, concurrently if there are multiple blocks
+		///
+		/// If there's only one block, the function is called on the current thread.
+		template <typename Fn>
+		void parallel_for_blocks(const size_t  &prm_num_items,              ///< The number of items to split into blocks
+		                         const size_t  &prm_num_threads,            ///< The number of threads to use (or 0 to use one per hardware thread)
+		                         Fn           &&prm_fn,                     ///< The function to call on each block's begin and end indices
+		                         const size_t  &prm_min_items_per_block = 1 ///< The minimum number of items to give each block
+		                         ) {
+			const size_t num_blocks = num_parallel_blocks( prm_num_items, prm_num_threads, prm_min_items_per_block );
+			if ( num_blocks == 1 ) {
+				prm_fn( static_cast<size_t>( 0 ), prm_num_items );
+				return;
+			}
+
+			std::vector<std::future<void>> block_futures;
+			block_futures.reserve( num_blocks );
+			for (const size_t &block_ctr : indices( num_blocks ) ) {
+				const auto bounds = detail::parallel_block_bounds( prm_num_items, num_blocks, block_ctr );
+				block_futures.push_back( std::async( std::launch::async, [&prm_fn, bounds] { prm_fn( bounds.first, bounds.second ); } ) );
+			}
+			for (std::future<void> &block_future : block_futures) {
+				block_future.get();
+			}
+		}
+
+	} // namespace common
+} // namespace cath
+
+#endif
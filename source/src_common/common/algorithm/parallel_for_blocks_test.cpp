@@ -0,0 +1,72 @@
+/// \file
+/// \brief The parallel_for_blocks test suite
+
+/// \copyright
+/// Tony Lewis's Common C++ Library Code (here imported into the CATH Tools project and then tweaked, eg namespaced in cath)
+/// Copyright (C) 2007, Tony Lewis
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "parallel_for_blocks.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/size_t_literal.hpp"
+#include "common/type_aliases.hpp"
+#include "test/boost_addenda/boost_check_equal_ranges.hpp"
+
+#include <utility>
+
+using namespace cath;
+using namespace cath::common;
+
+using std::make_pair;
+using std::pair;
+using std::vector;
+
+BOOST_AUTO_TEST_SUITE(parallel_for_blocks_test_suite)
+
+BOOST_AUTO_TEST_CASE(num_threads_or_hardware_keeps_nonzero_and_is_positive_for_zero) {
+	BOOST_CHECK_EQUAL( num_threads_or_hardware( 3 ), 3_z );
+	BOOST_CHECK_GE   ( num_threads_or_hardware( 0 ), 1_z );
+}
+
+BOOST_AUTO_TEST_CASE(num_parallel_blocks_respects_threads_and_min_items) {
+	BOOST_CHECK_EQUAL( num_parallel_blocks(   0, 4,   1 ), 1_z );
+	BOOST_CHECK_EQUAL( num_parallel_blocks(   2, 4,   1 ), 2_z );
+	BOOST_CHECK_EQUAL( num_parallel_blocks( 100, 4,   1 ), 4_z );
+	BOOST_CHECK_EQUAL( num_parallel_blocks( 100, 4,  30 ), 3_z );
+	BOOST_CHECK_EQUAL( num_parallel_blocks( 100, 4, 200 ), 1_z );
+	BOOST_CHECK_EQUAL( num_parallel_blocks( 100, 4,   0 ), 4_z );
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_blocks_visits_each_item_once) {
+	size_vec counts( 10, 0 );
+	parallel_for_blocks( counts.size(), 3, [&] (const size_t &prm_begin, const size_t &prm_end) {
+		for (size_t ctr = prm_begin; ctr < prm_end; ++ctr) {
+			++counts[ ctr ];
+		}
+	} );
+	BOOST_CHECK_EQUAL_RANGES( counts, size_vec( 10, 1 ) );
+}
+
+BOOST_AUTO_TEST_CASE(parallel_transform_blocks_returns_contiguous_blocks_in_order) {
+	const auto fn = [] (const size_t &prm_begin, const size_t &prm_end) { return make_pair( prm_begin, prm_end ); };
+	const vector<pair<size_t, size_t>> expected_multi  = { { 0, 4 }, { 4, 8 }, { 8, 10 } };
+	const vector<pair<size_t, size_t>> expected_single = { { 0, 10 } };
+	BOOST_CHECK( parallel_transform_blocks( 10, 3, fn     ) == expected_multi  );
+	BOOST_CHECK( parallel_transform_blocks( 10, 3, fn, 20 ) == expected_single );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/adaptor/sliced.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/irange.hpp>
 
@@ -99,6 +100,61 @@ size_size_pair_vec cath::common::get_edges_of_spanning_tree(const size_size_doub
 	);
 }
 
+/// \brief Select a sparse subset of the specified weighted edges that's guaranteed to span the specified
+///        number of items: each item's highest-weighted edges plus the edges of a max spanning tree
+///
+/// This is useful for selecting which pairs to score with an expensive comparison when
+/// only a max spanning tree of those expensive scores is required: the weights can come
+/// from a cheap comparison that correlates with the expensive one and the max-spanning-tree
+/// edges ensure that the expensive scores will still connect all the items.
+///
+/// Each edge in the result is ordered so that its lower index comes first and
+/// the result is sorted and contains no duplicates.
+///
+/// The edges must span all the items (so that a max spanning tree can be found)
+size_size_pair_vec cath::common::calc_top_neighbour_and_max_spanning_tree_edges(const size_size_doub_tpl_vec &prm_edges,         ///< The weighted edges from which the subset should be selected
+                                                                                const size_t                 &prm_num_items,     ///< The number of items to span
+                                                                                const size_t                 &prm_num_neighbours ///< The number of highest-weighted edges to select for each item
+                                                                                ) {
+	// Gather the indices of each item's edges
+	vector<size_vec> edge_indices_by_node( prm_num_items );
+	for (const size_t &edge_index : indices( prm_edges.size() ) ) {
+		const auto &the_edge = prm_edges[ edge_index ];
+		if ( max( get<0>( the_edge ), get<1>( the_edge ) ) >= prm_num_items ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot select edges from an edge with a node index >= the number of items"));
+		}
+		edge_indices_by_node[ get<0>( the_edge ) ].push_back( edge_index );
+		edge_indices_by_node[ get<1>( the_edge ) ].push_back( edge_index );
+	}
+
+	// Select each item's top prm_num_neighbours edges, breaking ties in favour of lower edge indices
+	std::set<size_size_pair> selected_edges;
+	const auto add_edge_fn = [&] (const size_t &x, const size_t &y) {
+		selected_edges.emplace( min( x, y ), max( x, y ) );
+	};
+	for (size_vec &node_edge_indices : edge_indices_by_node) {
+		const size_t num_to_select = min( prm_num_neighbours, node_edge_indices.size() );
+		std::partial_sort(
+			std::begin( node_edge_indices ),
+			std::next( std::begin( node_edge_indices ), static_cast<ptrdiff_t>( num_to_select ) ),
+			std::end( node_edge_indices ),
+			[&] (const size_t &x, const size_t &y) {
+				return make_tuple( -get<2>( prm_edges[ x ] ), x ) < make_tuple( -get<2>( prm_edges[ y ] ), y );
+			}
+		);
+		for (const size_t &edge_index : node_edge_indices | boost::adaptors::sliced( 0, num_to_select ) ) {
+			add_edge_fn( get<0>( prm_edges[ edge_index ] ), get<1>( prm_edges[ edge_index ] ) );
+		}
+	}
+
+	// Add the edges of a max spanning tree to ensure the result spans all the items
+	for (const size_size_doub_tpl &the_edge : calc_max_spanning_tree( prm_edges, prm_num_items ) ) {
+		add_edge_fn( get<0>( the_edge ), get<1>( the_edge ) );
+	}
+
+	return { common::cbegin( selected_edges ), common::cend( selected_edges ) };
+}
+
 /// \brief Return a copy of the specified spanning tree ordered such that:
 ///          * the first edge is the one with the specified index
 ///          * all edges after that contain exactly one node contained in an edge before it
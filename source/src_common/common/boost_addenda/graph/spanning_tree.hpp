@@ -174,6 +174,9 @@ namespace cath {
 		size_size_doub_tpl_vec calc_min_spanning_tree(const size_size_doub_tpl_vec &,
 		                                              const size_t &);
 		size_size_pair_vec get_edges_of_spanning_tree(const size_size_doub_tpl_vec &);
+		size_size_pair_vec calc_top_neighbour_and_max_spanning_tree_edges(const size_size_doub_tpl_vec &,
+		                                                                   const size_t &,
+		                                                                   const size_t &);
 		size_size_doub_tpl_vec order_spanning_tree_from_start(const size_size_doub_tpl_vec &,
 		                                                      const size_t &);
 		std::string make_graphviz_string_of_spanning_tree(const size_size_doub_tpl_vec &);
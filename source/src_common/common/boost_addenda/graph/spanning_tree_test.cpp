@@ -167,4 +167,32 @@ BOOST_AUTO_TEST_CASE(test_a) {
 	BOOST_TEST( order_spanning_tree_from_start( input, 0 ) == expected, per_element{} );
 }
 
+BOOST_AUTO_TEST_CASE(top_neighbour_edges_for_3_90_400_10) {
+	const size_size_doub_tpl_vec edges_and_scores = {
+		size_size_doub_tpl{ 0, 1, 85.40 },
+		size_size_doub_tpl{ 0, 2, 86.25 },
+		size_size_doub_tpl{ 0, 3, 87.96 },
+		size_size_doub_tpl{ 1, 2, 85.21 },
+		size_size_doub_tpl{ 1, 3, 84.20 },
+		size_size_doub_tpl{ 2, 3, 88.34 },
+	};
+	const size_size_pair_vec expected_one = { { 0, 1 }, { 0, 3 }, { 2, 3 } };
+	const size_size_pair_vec expected_two = { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 2, 3 } };
+	BOOST_TEST( calc_top_neighbour_and_max_spanning_tree_edges( edges_and_scores, 4, 1 ) == expected_one, per_element{} );
+	BOOST_TEST( calc_top_neighbour_and_max_spanning_tree_edges( edges_and_scores, 4, 2 ) == expected_two, per_element{} );
+}
+
+BOOST_AUTO_TEST_CASE(top_neighbour_edges_are_connected_by_max_spanning_tree) {
+	const size_size_doub_tpl_vec edges_and_scores = {
+		size_size_doub_tpl{ 0, 1, 10.0 },
+		size_size_doub_tpl{ 0, 2,  1.0 },
+		size_size_doub_tpl{ 0, 3,  2.0 },
+		size_size_doub_tpl{ 1, 2,  1.0 },
+		size_size_doub_tpl{ 1, 3,  1.0 },
+		size_size_doub_tpl{ 2, 3, 10.0 },
+	};
+	const size_size_pair_vec expected = { { 0, 1 }, { 0, 3 }, { 2, 3 } };
+	BOOST_TEST( calc_top_neighbour_and_max_spanning_tree_edges( edges_and_scores, 4, 1 ) == expected, per_element{} );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,15 +26,23 @@
 #include <boost/functional.hpp>
 #include <boost/optional.hpp>
 #include <boost/range/empty.hpp>
+#include <boost/utility/string_ref.hpp>
 
 #include "common/boost_addenda/range/front.hpp"
 #include "common/boost_addenda/range/max_proj_element.hpp"
 #include "common/boost_addenda/range/range_concept_type_aliases.hpp"
 #include "common/container/id_of_string_view.hpp"
+#include "common/container/string_arena.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
 #include "common/exception/out_of_range_exception.hpp"
 #include "common/type_aliases.hpp"
 
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace cath {
 	namespace common {
@@ -45,28 +53,78 @@ namespace cath {
 		///
 		/// The IDs are guaranteed to be stable (in-between calls to clear()) and
 		/// sensible for indexing into vectors without wasting much space.
+		///
+		/// This is designed to cope with very large numbers of names (eg hundreds of millions of
+		/// sequence names when mapping clusters):
+		///  * the names' characters are stored contiguously in a string_arena rather than in
+		///    individual std::strings
+		///  * the lookup from name to ID is a flat, open-addressing (linear-probing) hash table
+		///    of 8-byte slots, each holding a fragment of the name's hash and the name's ID
+		///
+		/// The string_refs returned by get_name_of_id() and the iteration remain valid as more
+		/// names are added (and if the id_of_str_bidirnl is moved) but are invalidated by
+		/// clear() and freeze().
 		class id_of_str_bidirnl final {
 		private:
-			/// \brief A map from the names to the corresponding ID
-			id_of_string_view ids_by_name;
+			/// \brief A slot in the hash table
+			struct slot final {
+				/// \brief The lower bits of the folded hash of the name (which are also used to choose the slot)
+				uint32_t hash_frag   = 0;
+
+				/// \brief One more than the ID of the name in this slot or 0 if the slot is empty
+				uint32_t id_plus_one = 0;
+			};
+
+			/// \brief The minimum number of slots in a non-empty hash table
+			static constexpr size_t MIN_NUM_SLOTS = 16;
+
+			/// \brief The maximum number of names that can be stored
+			static constexpr size_t MAX_NUM_NAMES = std::numeric_limits<uint32_t>::max() - 1;
+
+			/// \brief The arena that stores the characters of the names
+			string_arena                   name_chars;
+
+			/// \brief The names, where each ID is the index of the corresponding name
+			std::vector<boost::string_ref> names_by_id;
+
+			/// \brief The hash table from the names' hashes to their IDs (size is zero or a power of two)
+			std::vector<slot>              slots;
 
-			/// \brief A deque of the names where each ID is the index of the corresponding string
-			str_deq           names_by_id;
+			/// \brief Whether this has been frozen (and hence won't accept any new names)
+			bool                           is_frozen = false;
+
+			inline static uint32_t hash_of_name(const boost::string_ref &);
+			inline static size_t num_slots_for_num_names(const size_t &);
+			inline size_t index_of_slot_for_name(const boost::string_ref &,
+			                                     const uint32_t &) const;
+			inline void rehash(const size_t &);
 
 		public:
 			/// \brief A const_iterator type alias as part of making this a range over the names
-			using const_iterator = str_deq::const_iterator;
+			using const_iterator = std::vector<boost::string_ref>::const_iterator;
 
 			/// \brief Default ctor
 			id_of_str_bidirnl() = default;
+			inline id_of_str_bidirnl(const id_of_str_bidirnl &);
+			id_of_str_bidirnl(id_of_str_bidirnl &&) noexcept = default;
+			inline id_of_str_bidirnl & operator=(const id_of_str_bidirnl &);
+			id_of_str_bidirnl & operator=(id_of_str_bidirnl &&) noexcept = default;
+			~id_of_str_bidirnl() noexcept = default;
+
 			inline size_t add_name(const boost::string_ref &);
 			inline size_t add_name(const std::string &);
 			inline size_t add_name(std::string &&);
-			inline const std::string & get_name_of_id(const size_t &) const;
+			inline boost::string_ref get_name_of_id(const size_t &) const;
 			inline size_t get_id_of_name(const std::string &) const;
 			inline size_t get_id_of_name(const boost::string_ref &) const;
+			inline size_opt find_id_of_name(const boost::string_ref &) const;
 			inline bool empty() const;
 			inline size_t size() const;
+			inline size_t num_chars() const;
+			inline bool frozen() const;
+			inline id_of_str_bidirnl & reserve(const size_t &,
+			                                   const size_t &);
+			inline id_of_str_bidirnl & freeze();
 			inline id_of_str_bidirnl & clear();
 			inline const_iterator begin() const;
 			inline const_iterator end() const;
@@ -83,25 +141,127 @@ namespace cath {
 			return to_string( std::forward<Ts>( args )... );
 		}
 
+		/// \brief Calculate the hash of the specified name, folded into 32 bits
+		inline uint32_t id_of_str_bidirnl::hash_of_name(const boost::string_ref &prm_name ///< The name to hash
+		                                                ) {
+			const uint64_t the_hash = detail::string_view_hasher{}( prm_name );
+			return static_cast<uint32_t>( the_hash ^ ( the_hash >> 32 ) );
+		}
+
+		/// \brief Get the number of slots that should be used to store the specified number of names
+		///
+		/// This is the smallest power of two (no smaller than MIN_NUM_SLOTS) that keeps the load factor below 0.7
+		inline size_t id_of_str_bidirnl::num_slots_for_num_names(const size_t &prm_num_names ///< The number of names to be stored
+		                                                         ) {
+			size_t num_slots = MIN_NUM_SLOTS;
+			while ( prm_num_names * 10 >= num_slots * 7 ) {
+				num_slots *= 2;
+			}
+			return num_slots;
+		}
+
+		/// \brief Get the index of the slot that holds the specified name or, if it isn't present,
+		///        the index of the empty slot at which it should be inserted
+		///
+		/// \pre slots is non-empty and isn't full
+		inline size_t id_of_str_bidirnl::index_of_slot_for_name(const boost::string_ref &prm_name,     ///< The name to find
+		                                                        const uint32_t          &prm_hash_frag ///< The hash of the name (as calculated by hash_of_name())
+		                                                        ) const {
+			const size_t mask = slots.size() - 1;
+			size_t slot_index = ( prm_hash_frag & mask );
+			while ( true ) {
+				const slot &the_slot = slots[ slot_index ];
+				if ( the_slot.id_plus_one == 0 ) {
+					return slot_index;
+				}
+				if ( the_slot.hash_frag == prm_hash_frag && names_by_id[ the_slot.id_plus_one - 1 ] == prm_name ) {
+					return slot_index;
+				}
+				slot_index = ( slot_index + 1 ) & mask;
+			}
+		}
+
+		/// \brief Rebuild the hash table with the specified number of slots
+		///
+		/// This reuses the hashes stored in the slots so it doesn't need to rehash any names
+		///
+		/// \pre prm_num_slots is a power of two that's large enough to hold the current names
+		inline void id_of_str_bidirnl::rehash(const size_t &prm_num_slots ///< The number of slots to use
+		                                      ) {
+			std::vector<slot> new_slots( prm_num_slots );
+			const size_t mask = prm_num_slots - 1;
+			for (const slot &old_slot : slots) {
+				if ( old_slot.id_plus_one != 0 ) {
+					size_t slot_index = ( old_slot.hash_frag & mask );
+					while ( new_slots[ slot_index ].id_plus_one != 0 ) {
+						slot_index = ( slot_index + 1 ) & mask;
+					}
+					new_slots[ slot_index ] = old_slot;
+				}
+			}
+			slots = std::move( new_slots );
+		}
+
+		/// \brief Copy ctor
+		///
+		/// This can't just copy the members because the copied string_refs would refer to the
+		/// original's arena, so it adds each of the names afresh (in ID order, so as to preserve the IDs)
+		inline id_of_str_bidirnl::id_of_str_bidirnl(const id_of_str_bidirnl &prm_other ///< The id_of_str_bidirnl to copy
+		                                            ) {
+			reserve( prm_other.size(), prm_other.num_chars() );
+			for (const boost::string_ref &name : prm_other) {
+				add_name( name );
+			}
+			if ( prm_other.frozen() ) {
+				freeze();
+			}
+		}
+
+		/// \brief Copy assignment operator
+		inline id_of_str_bidirnl & id_of_str_bidirnl::operator=(const id_of_str_bidirnl &prm_other ///< The id_of_str_bidirnl to copy
+		                                                        ) {
+			id_of_str_bidirnl copy{ prm_other };
+			*this = std::move( copy );
+			return *this;
+		}
+
 		/// \brief Add the specified name and return its ID
 		///
 		/// Can be used if the name already exists
+		///
+		/// \pre If the name is new, the id_of_str_bidirnl mustn't have been frozen else an invalid_argument_exception will be thrown
 		inline size_t id_of_str_bidirnl::add_name(const boost::string_ref &prm_name ///< The name to add
 		                                          ) {
-			if ( ids_by_name.contains( prm_name ) ) {
-				return *ids_by_name[ prm_name ];
+			if ( ( names_by_id.size() + 1 ) * 10 >= slots.size() * 7 ) {
+				if ( names_by_id.size() >= MAX_NUM_NAMES ) {
+					BOOST_THROW_EXCEPTION(out_of_range_exception(
+						"id_of_str_bidirnl cannot store more than "
+						+ std::to_string( MAX_NUM_NAMES )
+						+ " names"
+					));
+				}
+				rehash( num_slots_for_num_names( names_by_id.size() + 1 ) );
+			}
+
+			const uint32_t hash_frag  = hash_of_name( prm_name );
+			const size_t   slot_index = index_of_slot_for_name( prm_name, hash_frag );
+			slot          &the_slot   = slots[ slot_index ];
+			if ( the_slot.id_plus_one != 0 ) {
+				return the_slot.id_plus_one - 1;
 			}
-			names_by_id.push_back( prm_name.to_string() );
-			const size_t &id = ids_by_name.emplace( boost::string_ref{ names_by_id.back() } ).second;
-			if ( id + 1 != names_by_id.size() ) {
-				BOOST_THROW_EXCEPTION(out_of_range_exception(
-					"id_of_str_bidirnl tried to add a name with ID "
-					+ to_string_hook( id                 )
-					+ " when only "
-					+ to_string_hook( names_by_id.size() )
-					+ " names have been stored."
+
+			if ( is_frozen ) {
+				BOOST_THROW_EXCEPTION(invalid_argument_exception(
+					"Unable to add new name \""
+					+ prm_name.to_string()
+					+ "\" to an id_of_str_bidirnl that has been frozen"
 				));
 			}
+
+			const size_t id = names_by_id.size();
+			names_by_id.push_back( name_chars.store( prm_name ) );
+			the_slot.hash_frag   = hash_frag;
+			the_slot.id_plus_one = static_cast<uint32_t>( id + 1 );
 			return id;
 		}
 
@@ -118,42 +278,47 @@ namespace cath {
 		/// Can be used if the name already exists
 		inline size_t id_of_str_bidirnl::add_name(std::string &&prm_name ///< The name to add
 		                                          ) {
-			if ( ids_by_name.contains( prm_name ) ) {
-				return *ids_by_name[ prm_name ];
-			}
-			names_by_id.push_back( std::move( prm_name ) );
-			const size_t &id = ids_by_name.emplace( boost::string_ref{ names_by_id.back() } ).second;
-			if ( id + 1 != names_by_id.size() ) {
-				BOOST_THROW_EXCEPTION(out_of_range_exception(
-					"id_of_str_bidirnl tried to add a name with ID "
-					+ to_string_hook( id                 )
-					+ " when only "
-					+ to_string_hook( names_by_id.size() )
-					+ " names have been stored."
-				));
-			}
-			return id;
+			return add_name( boost::string_ref{ prm_name } );
 		}
 
 		/// \brief Get the name associated with the specified ID
 		///
+		/// The returned string_ref remains valid until the next call to clear() or freeze()
+		///
 		/// \pre The ID must be a valid ID else this triggers undefined behaviour
 		///      (or something less nasty on a range-checked debug build)
-		inline const std::string & id_of_str_bidirnl::get_name_of_id(const size_t &prm_id ///< The ID to query
-		                                                             ) const {
+		inline boost::string_ref id_of_str_bidirnl::get_name_of_id(const size_t &prm_id ///< The ID to query
+		                                                           ) const {
 			return names_by_id[ prm_id ];
 		}
 
 		/// \brief Get the ID associated with the specified name
+		///
+		/// \pre The name must be present else this triggers undefined behaviour
 		inline auto id_of_str_bidirnl::get_id_of_name(const boost::string_ref &prm_name ///< The name to query
 		                                              ) const -> size_t {
-			return *ids_by_name[ prm_name ];
+			return *find_id_of_name( prm_name );
 		}
 
 		/// \brief Get the ID associated with the specified name
+		///
+		/// \pre The name must be present else this triggers undefined behaviour
 		inline auto id_of_str_bidirnl::get_id_of_name(const std::string &prm_name ///< The name to query
 		                                              ) const -> size_t {
-			return *ids_by_name[ prm_name ];
+			return *find_id_of_name( prm_name );
+		}
+
+		/// \brief Get the ID associated with the specified name or none if it isn't present
+		inline size_opt id_of_str_bidirnl::find_id_of_name(const boost::string_ref &prm_name ///< The name to query
+		                                                   ) const {
+			if ( slots.empty() ) {
+				return boost::none;
+			}
+			const slot &the_slot = slots[ index_of_slot_for_name( prm_name, hash_of_name( prm_name ) ) ];
+			if ( the_slot.id_plus_one == 0 ) {
+				return boost::none;
+			}
+			return static_cast<size_t>( the_slot.id_plus_one - 1 );
 		}
 
 		/// \brief Return whether the id_of_str_bidirnl is empty
@@ -166,12 +331,61 @@ namespace cath {
 			return names_by_id.size();
 		}
 
+		/// \brief The total number of characters in the names currently stored in the id_of_str_bidirnl
+		inline size_t id_of_str_bidirnl::num_chars() const {
+			return name_chars.size();
+		}
+
+		/// \brief Whether the id_of_str_bidirnl has been frozen
+		inline bool id_of_str_bidirnl::frozen() const {
+			return is_frozen;
+		}
+
+		/// \brief Reserve space for the specified number of further names, containing
+		///        the specified number of further characters between them
+		///
+		/// This is useful to avoid repeated growth of the storage when the volume of names
+		/// can be estimated up front (eg from the size of a file of names)
+		inline id_of_str_bidirnl & id_of_str_bidirnl::reserve(const size_t &prm_num_names, ///< The number of further names for which space should be reserved
+		                                                      const size_t &prm_num_chars  ///< The total number of characters in those names
+		                                                      ) {
+			const size_t num_names = names_by_id.size() + prm_num_names;
+			names_by_id.reserve( num_names );
+			const size_t num_slots = num_slots_for_num_names( num_names );
+			if ( num_slots > slots.size() ) {
+				rehash( num_slots );
+			}
+			name_chars.reserve( prm_num_chars );
+			return *this;
+		}
+
+		/// \brief Freeze the id_of_str_bidirnl so that no further names may be added
+		///
+		/// This compacts the names' characters into one contiguous block, in ID order, and releases
+		/// any spare capacity. After this, the IDs are unchanged and lookups work as before
+		/// but attempting to add a new name throws an invalid_argument_exception.
+		///
+		/// This invalidates any string_refs previously returned by get_name_of_id() and any iterators
+		inline id_of_str_bidirnl & id_of_str_bidirnl::freeze() {
+			string_arena frozen_chars;
+			frozen_chars.reserve( name_chars.size() );
+			for (boost::string_ref &name : names_by_id) {
+				name = frozen_chars.store( name );
+			}
+			name_chars = std::move( frozen_chars );
+			names_by_id.shrink_to_fit();
+			is_frozen = true;
+			return *this;
+		}
+
 		/// \brief Clear the id_of_str_bidirnl
 		///
-		/// Invalidates all IDs and iterators
+		/// Invalidates all IDs and iterators and unfreezes the id_of_str_bidirnl
 		inline id_of_str_bidirnl & id_of_str_bidirnl::clear() {
 			names_by_id.clear();
-			ids_by_name.clear();
+			slots.clear();
+			name_chars.clear();
+			is_frozen = false;
 			return *this;
 		}
 
@@ -204,7 +418,7 @@ namespace cath {
 					( ( front( x ) == '-' ) && boost::size( x ) == 1 )
 					||
 					boost::algorithm::any_of(
-						next( common::cbegin( x ) ),
+						std::next( common::cbegin( x ) ),
 						common::cend( x ),
 						[] (const auto &y) { return ! boost::algorithm::is_digit()( y ); }
 					)
@@ -216,7 +430,7 @@ namespace cath {
 			return max_proj(
 				prm_strings,
 				std::less<>{},
-				[] (const_str_ref x) { return std::stol( x ); }
+				[] (const_str_ref x) { return std::stol( std::string{ common::cbegin( x ), common::cend( x ) } ); }
 			);
 		}
 
@@ -22,16 +22,21 @@
 #include <boost/test/unit_test.hpp>
 
 #include "common/container/id_of_str_bidirnl.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
+#include "common/rapidjson_addenda/rapidjson_writer.hpp"
+#include "common/size_t_literal.hpp"
 
 #include <string>
 
 using namespace cath::common;
+using namespace cath::common::literals;
 using namespace std::literals::string_literals;
 
 using boost::make_optional;
 using boost::none;
 using boost::string_ref;
 using std::string;
+using std::to_string;
 
 BOOST_AUTO_TEST_SUITE(id_of_str_bidirnl_test_suite)
 
@@ -106,6 +111,97 @@ BOOST_AUTO_TEST_CASE(from_string_views) {
 	BOOST_CHECK_EQUAL(   the_ider.size(), 0 );
 }
 
+BOOST_AUTO_TEST_CASE(many_names_keep_their_ids_and_names_as_it_grows) {
+	id_of_str_bidirnl the_ider;
+	for (size_t ctr = 0; ctr < 100000; ++ctr) {
+		BOOST_REQUIRE_EQUAL( the_ider.add_name( "seq_" + to_string( ctr ) ), ctr );
+	}
+	BOOST_REQUIRE_EQUAL( the_ider.size(), 100000 );
+	for (size_t ctr = 0; ctr < 100000; ++ctr) {
+		const string name = "seq_" + to_string( ctr );
+		BOOST_REQUIRE_EQUAL( the_ider.get_id_of_name( name ), ctr  );
+		BOOST_REQUIRE_EQUAL( the_ider.get_name_of_id( ctr  ), name );
+	}
+	BOOST_CHECK_EQUAL( the_ider.find_id_of_name( "seq_100000" ), none );
+}
+
+BOOST_AUTO_TEST_CASE(find_id_of_name_returns_none_for_absent_names) {
+	id_of_str_bidirnl the_ider;
+	BOOST_CHECK_EQUAL( the_ider.find_id_of_name( "motorcycle" ), none );
+
+	the_ider.add_name( "motorcycle"s );
+	BOOST_CHECK_EQUAL( the_ider.find_id_of_name( "motorcycle" ), make_optional( 0_z ) );
+	BOOST_CHECK_EQUAL( the_ider.find_id_of_name( "emptiness"  ), none                 );
+}
+
+BOOST_AUTO_TEST_CASE(handles_empty_name) {
+	id_of_str_bidirnl the_ider;
+	BOOST_CHECK_EQUAL( the_ider.add_name      ( ""s ), 0   );
+	BOOST_CHECK_EQUAL( the_ider.add_name      ( "a"s ), 1  );
+	BOOST_CHECK_EQUAL( the_ider.add_name      ( ""s ), 0   );
+	BOOST_CHECK_EQUAL( the_ider.get_name_of_id( 0   ), ""s );
+}
+
+BOOST_AUTO_TEST_CASE(empty_name_can_be_written_as_json) {
+	id_of_str_bidirnl the_ider;
+	BOOST_CHECK_EQUAL( the_ider.add_name( ""s ), 0 );
+	BOOST_CHECK_EQUAL(
+		rapidjson_writer< json_style::COMPACT >{}
+			.start_array()
+				.write_value( the_ider.get_name_of_id( 0 ) )
+			.end_array()
+			.get_cpp_string(),
+		R"([""])"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(reserve_does_not_change_contents) {
+	id_of_str_bidirnl the_ider;
+	the_ider.add_name( "motorcycle"s );
+	the_ider.reserve( 1000, 10000 );
+	BOOST_CHECK_EQUAL( the_ider.add_name      ( "emptiness"s  ), 1             );
+	BOOST_CHECK_EQUAL( the_ider.get_id_of_name( "motorcycle"s ), 0             );
+	BOOST_CHECK_EQUAL( the_ider.get_name_of_id( 0             ), "motorcycle"s );
+	BOOST_CHECK_EQUAL( the_ider.size(),                            2             );
+	BOOST_CHECK_EQUAL( the_ider.num_chars(),                       19            );
+}
+
+BOOST_AUTO_TEST_CASE(freeze_compacts_names_and_rejects_new_names) {
+	id_of_str_bidirnl the_ider;
+	for (size_t ctr = 0; ctr < 1000; ++ctr) {
+		the_ider.add_name( "seq_" + to_string( ctr ) );
+	}
+	the_ider.freeze();
+
+	BOOST_CHECK( the_ider.frozen() );
+	for (size_t ctr = 0; ctr + 1 < 1000; ++ctr) {
+		const string_ref name      = the_ider.get_name_of_id( ctr     );
+		const string_ref next_name = the_ider.get_name_of_id( ctr + 1 );
+		BOOST_REQUIRE( name.data() + name.size() == next_name.data() );
+	}
+	BOOST_CHECK_EQUAL( the_ider.get_name_of_id( 999        ), "seq_999"s );
+	BOOST_CHECK_EQUAL( the_ider.get_id_of_name( "seq_999"s ), 999        );
+	BOOST_CHECK_EQUAL( the_ider.add_name      ( "seq_999"s ), 999        );
+	BOOST_CHECK_THROW( the_ider.add_name      ( "seq_1000"s ), invalid_argument_exception );
+
+	the_ider.clear();
+	BOOST_CHECK( ! the_ider.frozen() );
+	BOOST_CHECK_EQUAL( the_ider.add_name( "seq_1000"s ), 0 );
+}
+
+BOOST_AUTO_TEST_CASE(copies_are_independent) {
+	id_of_str_bidirnl the_ider;
+	the_ider.add_name( "motorcycle"s );
+	the_ider.add_name( "emptiness"s  );
+
+	id_of_str_bidirnl the_copy{ the_ider };
+	the_ider.clear();
+
+	BOOST_CHECK_EQUAL( the_copy.size(),                            2             );
+	BOOST_CHECK_EQUAL( the_copy.get_name_of_id( 0             ), "motorcycle"s );
+	BOOST_CHECK_EQUAL( the_copy.get_id_of_name( "emptiness"s  ), 1             );
+}
+
 
 BOOST_AUTO_TEST_SUITE(largest_number_if_names_all_numeric_integers_fn)
 
@@ -0,0 +1,135 @@
+/// \file
+/// \brief The string_arena class header
+
+/// \copyright
+/// Tony Lewis's Common C++ Library Code (here imported into the CATH Tools project and then tweaked, eg namespaced in cath)
+/// Copyright (C) 2007, Tony Lewis
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_SRC_COMMON_COMMON_CONTAINER_STRING_ARENA_HPP
+#define _CATH_TOOLS_SOURCE_SRC_COMMON_COMMON_CONTAINER_STRING_ARENA_HPP
+
+#include <boost/utility/string_ref.hpp>
+
+#include "common/cpp14/cbegin_cend.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace cath {
+	namespace common {
+
+		/// \brief Store the characters of many strings contiguously in large blocks and hand out
+		///        boost::string_refs to them
+		///
+		/// This avoids the per-string allocation and header overhead of storing each string in its own
+		/// std::string. Stored characters never move (until clear()), so the string_refs remain valid
+		/// even as more strings are stored and even if the string_arena is moved.
+		///
+		/// This is move-only and isn't thread-safe (except in the standard way)
+		class string_arena final {
+		private:
+			/// \brief The number of chars in the first block that's allocated by store()
+			static constexpr size_t MIN_BLOCK_SIZE = 256;
+
+			/// \brief The number of chars beyond which store() stops growing the size of the blocks it allocates
+			static constexpr size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+			/// \brief The blocks of chars
+			std::vector<std::unique_ptr<char[]>> blocks;
+
+			/// \brief The number of chars used in the last block
+			size_t num_used_in_last_block  = 0;
+
+			/// \brief The capacity of the last block
+			size_t last_block_capacity     = 0;
+
+			/// \brief The total number of chars stored
+			size_t num_chars               = 0;
+
+			inline void add_block(const size_t &);
+
+		public:
+			inline boost::string_ref store(const boost::string_ref &);
+			inline void reserve(const size_t &);
+			inline size_t size() const;
+			inline void clear();
+		};
+
+		/// \brief Add a new block of the specified number of chars and make it the current block
+		inline void string_arena::add_block(const size_t &prm_capacity ///< The number of chars the new block should be able to hold
+		                                    ) {
+			last_block_capacity    = prm_capacity;
+			num_used_in_last_block = 0;
+			blocks.emplace_back( new char[ last_block_capacity ] );
+		}
+
+		/// \brief Store a copy of the specified string's characters and return a string_ref to the copy
+		///
+		/// An empty string isn't stored but gets a string_ref with a non-null data() (so callers
+		/// can pass it on to interfaces that reject null pointers, such as rapidjson's String())
+		///
+		/// When this needs a new block, it makes it as large as all the chars stored so far
+		/// (within MIN_BLOCK_SIZE and MAX_BLOCK_SIZE) so that small arenas stay small and large
+		/// ones don't make too many allocations
+		inline boost::string_ref string_arena::store(const boost::string_ref &prm_string ///< The string to store
+		                                             ) {
+			if ( prm_string.empty() ) {
+				return { "", 0 };
+			}
+			if ( blocks.empty() || num_used_in_last_block + prm_string.size() > last_block_capacity ) {
+				const size_t growth_size = std::min( std::max( num_chars, size_t{ MIN_BLOCK_SIZE } ), size_t{ MAX_BLOCK_SIZE } );
+				add_block( std::max( prm_string.size(), growth_size ) );
+			}
+			char * const dest = blocks.back().get() + num_used_in_last_block;
+			std::copy( common::cbegin( prm_string ), common::cend( prm_string ), dest );
+			num_used_in_last_block += prm_string.size();
+			num_chars              += prm_string.size();
+			return { dest, prm_string.size() };
+		}
+
+		/// \brief Ensure that the specified number of further chars can be stored without allocating
+		///
+		/// If this allocates a new block, it's exactly the requested size, so reserving the total
+		/// size of a series of strings and then storing them puts them in one contiguous block
+		/// (and any spare space at the end of the previous block goes unused)
+		inline void string_arena::reserve(const size_t &prm_num_chars ///< The number of further chars to make space for
+		                                  ) {
+			if ( prm_num_chars > 0 && ( blocks.empty() || num_used_in_last_block + prm_num_chars > last_block_capacity ) ) {
+				add_block( prm_num_chars );
+			}
+		}
+
+		/// \brief The total number of chars stored
+		inline size_t string_arena::size() const {
+			return num_chars;
+		}
+
+		/// \brief Release all the blocks
+		///
+		/// Invalidates all the string_refs previously returned by store()
+		inline void string_arena::clear() {
+			blocks.clear();
+			num_used_in_last_block = 0;
+			last_block_capacity    = 0;
+			num_chars              = 0;
+		}
+
+	} // namespace common
+} // namespace cath
+
+#endif
@@ -0,0 +1,86 @@
+/// \file
+/// \brief The string_arena test suite
+
+/// \copyright
+/// Tony Lewis's Common C++ Library Code (here imported into the CATH Tools project and then tweaked, eg namespaced in cath)
+/// Copyright (C) 2007, Tony Lewis
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/container/string_arena.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace cath::common;
+
+using boost::string_ref;
+using std::string;
+using std::to_string;
+using std::vector;
+
+BOOST_AUTO_TEST_SUITE(string_arena_test_suite)
+
+BOOST_AUTO_TEST_CASE(stores_copies) {
+	string_arena the_arena;
+	string source{ "mongoose" };
+	const string_ref stored = the_arena.store( source );
+	source[ 0 ] = 'M';
+
+	BOOST_CHECK_EQUAL( stored,           "mongoose" );
+	BOOST_CHECK_EQUAL( the_arena.size(), 8          );
+}
+
+BOOST_AUTO_TEST_CASE(storing_empty_string_gives_non_null_empty_ref) {
+	string_arena the_arena;
+	const string_ref stored = the_arena.store( "" );
+
+	BOOST_CHECK      ( stored.empty()            );
+	BOOST_CHECK      ( stored.data() != nullptr  );
+	BOOST_CHECK_EQUAL( the_arena.size(),       0 );
+}
+
+BOOST_AUTO_TEST_CASE(stored_strings_do_not_move_as_more_are_stored_or_arena_is_moved) {
+	string_arena the_arena;
+	vector<string_ref> stored;
+	for (size_t ctr = 0; ctr < 100000; ++ctr) {
+		stored.push_back( the_arena.store( "name_" + to_string( ctr ) ) );
+	}
+	const string_arena moved_arena{ std::move( the_arena ) };
+	for (size_t ctr = 0; ctr < 100000; ++ctr) {
+		BOOST_REQUIRE_EQUAL( stored[ ctr ], "name_" + to_string( ctr ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(reserve_makes_subsequent_strings_contiguous) {
+	string_arena the_arena;
+	the_arena.store( "lemur" );
+	the_arena.reserve( 9 );
+	const string_ref first  = the_arena.store( "otter" );
+	const string_ref second = the_arena.store( "mole" );
+
+	BOOST_CHECK( first.data() + first.size() == second.data() );
+}
+
+BOOST_AUTO_TEST_CASE(clear_empties) {
+	string_arena the_arena;
+	the_arena.store( "badger" );
+	the_arena.clear();
+
+	BOOST_CHECK_EQUAL( the_arena.size(), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,8 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <boost/utility/string_ref.hpp>
+
 #include "common/debug_numeric_cast.hpp"
 #include "common/json_style.hpp"
 
@@ -113,6 +115,19 @@ namespace cath {
 				return *this;
 			}
 
+			/// \brief Write a string value to the JSON
+			///
+			/// This handles an empty string_ref with a null data() (eg a default-constructed string_ref),
+			/// which rapidjson would otherwise reject
+			rapidjson_writer & write_value(const boost::string_ref &prm_value ///< The string value
+			                               ) {
+				writer.String(
+					( prm_value.data() != nullptr ) ? prm_value.data() : "",
+					debug_numeric_cast<rapidjson::SizeType>( prm_value.length() )
+				);
+				return *this;
+			}
+
 			/// \brief Write a bool value to the JSON
 			rapidjson_writer & write_value(const bool &prm_value ///< The bool value to write to the JSON
 			                               ) {
@@ -89,5 +89,16 @@ BOOST_AUTO_TEST_CASE(everything_works) {
 	);
 }
 
+BOOST_AUTO_TEST_CASE(writes_empty_string_refs) {
+	BOOST_CHECK_EQUAL(
+		rapidjson_writer< json_style::COMPACT >{}
+			.start_array()
+				.write_value( boost::string_ref{}    )
+				.write_value( boost::string_ref{ "" } )
+			.end_array()
+			.get_cpp_string(),
+		R"(["",""])"
+	);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -122,22 +122,22 @@ uptr_vec<alignment_acquirer> cath::align::get_alignment_acquirers(const alignmen
 	// If the alignment is to be created by reading a legacy SSAP alignment file, do that
 	// If the alignment is to be created by reading a list of SSAP scores,        do that
 	if ( ! prm_alignment_input_spec.get_cora_alignment_file().empty()  ) {
-		alignment_acquirers.push_back( make_unique< cora_aln_file_alignment_acquirer    >( prm_alignment_input_spec.get_cora_alignment_file()  ) );
+		alignment_acquirers.push_back( make_unique< cora_aln_file_alignment_acquirer    >( prm_alignment_input_spec.get_cora_alignment_file(), prm_alignment_input_spec.get_refining_num_threads() ) );
 	}
 	if (   prm_alignment_input_spec.get_residue_name_align()           ) {
 		alignment_acquirers.push_back( make_unique< residue_name_alignment_acquirer     >(                                                     ) );
 	}
 	if ( ! prm_alignment_input_spec.get_fasta_alignment_file().empty() ) {
-		alignment_acquirers.push_back( make_unique< fasta_aln_file_alignment_acquirer   >( prm_alignment_input_spec.get_fasta_alignment_file() ) );
+		alignment_acquirers.push_back( make_unique< fasta_aln_file_alignment_acquirer   >( prm_alignment_input_spec.get_fasta_alignment_file(), prm_alignment_input_spec.get_refining_num_threads() ) );
 	}
 	if ( ! prm_alignment_input_spec.get_ssap_alignment_file().empty()  ) {
-		alignment_acquirers.push_back( make_unique< ssap_aln_file_alignment_acquirer    >( prm_alignment_input_spec.get_ssap_alignment_file()  ) );
+		alignment_acquirers.push_back( make_unique< ssap_aln_file_alignment_acquirer    >( prm_alignment_input_spec.get_ssap_alignment_file(), prm_alignment_input_spec.get_refining_num_threads() ) );
 	}
 	if ( ! prm_alignment_input_spec.get_ssap_scores_file().empty()     ) {
 		alignment_acquirers.push_back( make_unique< ssap_scores_file_alignment_acquirer >( prm_alignment_input_spec.get_ssap_scores_file()     ) );
 	}
 	if ( prm_alignment_input_spec.get_do_the_ssaps_dir() ) {
-		alignment_acquirers.push_back( make_unique< do_the_ssaps_alignment_acquirer     >( *prm_alignment_input_spec.get_do_the_ssaps_dir()    ) );
+		alignment_acquirers.push_back( make_unique< do_the_ssaps_alignment_acquirer     >( *prm_alignment_input_spec.get_do_the_ssaps_dir(), prm_alignment_input_spec.get_do_the_ssaps_neighbours() ) );
 	}
 
 	if ( alignment_acquirers.size() != get_num_acquirers( prm_alignment_input_spec ) ) {
@@ -168,7 +168,7 @@ unique_ptr<alignment_acquirer> cath::align::get_alignment_acquirer(const alignme
 
 	// If no alignment_acquirer has been specified then use a do_the_ssaps_alignment_acquirer
 	if ( alignment_acquirers.empty() ) {
-		return make_unique< do_the_ssaps_alignment_acquirer >();
+		return make_unique< do_the_ssaps_alignment_acquirer >( boost::none, prm_alignment_input_spec.get_do_the_ssaps_neighbours() );
 	}
 
 	if ( alignment_acquirers.size() != 1 ) {
@@ -81,8 +81,10 @@ pair<alignment, size_size_pair_vec> cora_aln_file_alignment_acquirer::do_get_ali
 }
 
 /// \brief Ctor for cora_aln_file_alignment_acquirer
-cora_aln_file_alignment_acquirer::cora_aln_file_alignment_acquirer(const path     &prm_cora_alignment_file ///< TODOCUMENT
-                                                                   ) : cora_alignment_file(prm_cora_alignment_file) {
+cora_aln_file_alignment_acquirer::cora_aln_file_alignment_acquirer(const path   &prm_cora_alignment_file, ///< TODOCUMENT
+                                                                   const size_t &prm_refining_num_threads ///< The number of threads over which to spread any refining's scoring (or 0 to use one per hardware thread)
+                                                                   ) : super( prm_refining_num_threads ),
+                                                                       cora_alignment_file(prm_cora_alignment_file) {
 }
 
 /// \brief TODOCUMENT
@@ -40,7 +40,8 @@ namespace cath {
 			std::pair<alignment, size_size_pair_vec> do_get_alignment_and_spanning_tree(const file::strucs_context &) const final;
 
 		public:
-			explicit cora_aln_file_alignment_acquirer(const boost::filesystem::path &);
+			explicit cora_aln_file_alignment_acquirer(const boost::filesystem::path &,
+			                                           const size_t & = 1);
 
 			boost::filesystem::path get_cora_alignment_file() const;
 		};
@@ -21,52 +21,368 @@
 #include "do_the_ssaps_alignment_acquirer.hpp"
 
 #include <boost/algorithm/string/join.hpp>
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/format.hpp>
 #include <boost/log/trivial.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/irange.hpp>
 
 #include "acquirer/alignment_acquirer/ssap_scores_file_alignment_acquirer.hpp"
 #include "alignment/alignment.hpp"
-#include "chopping/chopping_format/sillitoe_chopping_format.hpp"
+#include "alignment/io/alignment_io.hpp"
 #include "chopping/domain/domain.hpp"
+#include "common/algorithm/parallel_for_blocks.hpp"
+#include "common/algorithm/transform_build.hpp"
+#include "common/boost_addenda/graph/spanning_tree.hpp"
 #include "common/clone/make_uptr_clone.hpp"
-#include "common/exception/not_implemented_exception.hpp"
 #include "common/exception/runtime_error_exception.hpp"
-#include "common/file/open_fstream.hpp"
-#include "common/file/slurp.hpp"
 #include "common/file/spew.hpp"
-#include "common/matrix/matrix_index.hpp"
 #include "common/test_or_exe_run_mode.hpp"
+#include "file/options/data_dirs_spec.hpp"
+#include "file/ssap_scores_file/ssap_scores_entry.hpp"
+#include "file/ssap_scores_file/ssap_scores_file.hpp"
 #include "file/strucs_context.hpp"
+#include "scan/scan_action/record_scores_scan_action.hpp"
+#include "scan/scan_tools/all_vs_all.hpp"
+#include "scan/scan_tools/scan_metrics.hpp"
 #include "ssap/options/cath_ssap_options.hpp"
+#include "ssap/options/old_ssap_options_block.hpp"
 #include "ssap/ssap.hpp"
-#include "superposition/options/align_regions_options_block.hpp"
+#include "structure/protein/protein.hpp"
+#include "structure/protein/protein_io.hpp"
+#include "structure/protein/protein_list.hpp"
+#include "structure/protein/residue.hpp"
+#include "structure/protein/sec_struc.hpp"
+#include "structure/protein/sec_struc_planar_angles.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <vector>
 
 using namespace cath;
 using namespace cath::align;
-using namespace cath::chop;
 using namespace cath::common;
+using namespace cath::common::literals;
 using namespace cath::file;
 using namespace cath::opts;
+using namespace cath::scan;
 
-using boost::adaptors::transformed;
-using boost::algorithm::join;
-using boost::algorithm::trim_right_copy;
 using boost::filesystem::create_directories;
 using boost::filesystem::exists;
 using boost::filesystem::is_empty;
 using boost::filesystem::path;
-using boost::filesystem::temp_directory_path;
-using boost::format;
 using boost::irange;
-using std::ofstream;
+using boost::none;
+using std::get;
+using std::map;
 using std::max;
+using std::min;
 using std::pair;
 using std::string;
 using std::unique_ptr;
+using std::vector;
+
+namespace {
+
+	/// \brief Type alias for a pair of the SSAP scores and the optional SSAP alignment
+	using ssap_result = pair<ssap_scores_entry, alignment_opt>;
+
+	/// \brief Type alias for a vector of ssap_result values
+	using ssap_result_vec = vector<ssap_result>;
+
+	/// \brief Type alias for an optional ssap_result
+	using ssap_result_opt = boost::optional<ssap_result>;
+
+	/// \brief Type alias for a vector of ssap_result_opt values
+	using ssap_result_opt_vec = vector<ssap_result_opt>;
+
+	/// \brief Get the cath-ssap options with which to run the SSAPs, parsed from the same sources that a cath-ssap
+	///        run would use (ie the environment and any config file, or just the command line when testing)
+	///
+	/// This keeps the in-memory SSAPs consistent with the cath-ssap runs that this acquirer used to make
+	cath_ssap_options ssap_options_from_env_and_file() {
+		return make_and_parse_options<cath_ssap_options>(
+			str_vec{ cath_ssap_options::PROGRAM_NAME },
+			( run_mode_flag::value == run_mode::TEST )
+				? parse_sources::CMND_LINE_ONLY
+				: parse_sources::CMND_ENV_AND_FILE
+		);
+	}
+
+	/// \brief Make an SSAP-ready protein for the structure at the specified index of the specified strucs_context
+	///
+	/// This uses the already-loaded PDB (restricted to any regions) rather than re-reading it from disk
+	protein make_ssap_protein_of_index(const strucs_context &prm_strucs_context, ///< The strucs_context containing the structure
+	                                   const size_t         &prm_index           ///< The index of the structure within the strucs_context
+	                                   ) {
+		const name_set &the_name_set = prm_strucs_context.get_name_sets()[ prm_index ];
+		protein the_protein = make_protein_from_pdb_and_calc_dssp_and_sec(
+			get_regions_limited_pdb(
+				prm_strucs_context.get_regions()[ prm_index ],
+				prm_strucs_context.get_pdbs   ()[ prm_index ]
+			),
+			the_name_set.get_name_from_acq()
+		);
+		the_protein.set_name_set( the_name_set );
+		return the_protein;
+	}
+
+	/// \brief Get the ID that's used for the structure at the specified index of the specified strucs_context
+	///        in SSAP scores and in the names of cached files
+	string id_of_index(const strucs_context &prm_strucs_context, ///< The strucs_context containing the structure
+	                   const size_t         &prm_index           ///< The index of the structure within the strucs_context
+	                   ) {
+		return get_domain_or_specified_or_name_from_acq( prm_strucs_context.get_name_sets()[ prm_index ] );
+	}
+
+	/// \brief Get the pairs of the specified proteins between which the SSAPs should be done:
+	///        all pairs if there are no prm_num_neighbours, otherwise the pairs selected by
+	///        calc_top_neighbour_and_max_spanning_tree_edges() from fast all-vs-all scan scores
+	size_size_pair_vec pairs_to_compare(const protein_list &prm_proteins,      ///< The proteins to compare
+	                                    const size_opt     &prm_num_neighbours ///< The number of scan-ranked neighbours of each structure with which to do the SSAPs (or none to do the SSAPs between all pairs)
+	                                    ) {
+		const size_t num_strucs = prm_proteins.size();
+		if ( ! prm_num_neighbours || *prm_num_neighbours + 1 >= num_strucs ) {
+			size_size_pair_vec all_pairs;
+			for (const size_t &struc_1_index : indices( num_strucs ) ) {
+				for (const size_t &struc_2_index : irange( struc_1_index + 1, num_strucs ) ) {
+					all_pairs.emplace_back( struc_1_index, struc_2_index );
+				}
+			}
+			return all_pairs;
+		}
+
+		// Scan all against all and then symmetrise the scores
+		BOOST_LOG_TRIVIAL( info ) << "About to scan " << num_strucs << " structures all-vs-all to select the SSAPs to do";
+		const record_scores_scan_action scan_scores = all_vs_all{}.perform_scan( prm_proteins, prm_proteins ).first;
+		size_size_doub_tpl_vec scan_edges;
+		scan_edges.reserve( num_strucs * ( num_strucs - 1 ) / 2 );
+		for (const size_t &struc_1_index : indices( num_strucs ) ) {
+			for (const size_t &struc_2_index : irange( struc_1_index + 1, num_strucs ) ) {
+				scan_edges.emplace_back(
+					struc_1_index,
+					struc_2_index,
+					scan_scores.get_score( struc_1_index, struc_2_index ) + scan_scores.get_score( struc_2_index, struc_1_index )
+				);
+			}
+		}
+
+		return calc_top_neighbour_and_max_spanning_tree_edges( scan_edges, num_strucs, *prm_num_neighbours );
+	}
+
+	/// \brief Run the SSAPs for the specified pairs of proteins in the specified number of threads
+	///
+	/// \returns The results in the same order as the specified pairs
+	ssap_result_vec run_ssaps_concurrently(const protein_list       &prm_proteins,     ///< The proteins to compare
+	                                       const size_size_pair_vec &prm_pairs,        ///< The pairs of indices of the proteins to compare
+	                                       const cath_ssap_options  &prm_ssap_options, ///< The cath-ssap options with which to run the SSAPs
+	                                       const size_t             &prm_num_threads   ///< The number of threads to use
+	                                       ) {
+		const size_t num_pairs   = prm_pairs.size();
+		const size_t num_workers = num_parallel_blocks( num_pairs, prm_num_threads, 1 );
+
+		// Run worker i on pairs i, i + num_workers, i + 2 * num_workers, ...
+		// (interleaving rather than chunking spreads the large structures' comparisons across the workers)
+		const auto run_worker_fn = [&] (const size_t &prm_worker_index) {
+			ssap_result_vec results;
+			for (size_t pair_ctr = prm_worker_index; pair_ctr < num_pairs; pair_ctr += num_workers) {
+				const protein &protein_a = prm_proteins[ prm_pairs[ pair_ctr ].first  ];
+				const protein &protein_b = prm_proteins[ prm_pairs[ pair_ctr ].second ];
+				BOOST_LOG_TRIVIAL( info ) << "Running SSAP of " << get_domain_or_specified_or_name_from_acq( protein_a )
+				                          << " versus "         << get_domain_or_specified_or_name_from_acq( protein_b );
+				results.push_back( run_ssap_in_memory( protein_a, protein_b, prm_ssap_options.get_old_ssap_options(), prm_ssap_options.get_data_dirs_spec() ) );
+			}
+			return results;
+		};
+
+		// Run each worker as its own single-index block
+		vector<ssap_result_vec> worker_results = parallel_transform_blocks(
+			num_workers,
+			num_workers,
+			[&] (const size_t &prm_worker_index, const size_t &/*prm_end_index*/) {
+				return run_worker_fn( prm_worker_index );
+			}
+		);
+
+		ssap_result_vec results;
+		results.reserve( num_pairs );
+		for (const size_t &pair_ctr : indices( num_pairs ) ) {
+			results.push_back( std::move( worker_results[ pair_ctr % num_workers ][ pair_ctr / num_workers ] ) );
+		}
+		return results;
+	}
+
+	/// \brief Get the SSAP results for the specified pairs of the specified structures, using any cached
+	///        results in the specified cache directory and running the rest in the specified number of threads
+	///
+	/// \returns The results in the same order as the specified pairs
+	ssap_result_vec get_ssap_results(const strucs_context     &prm_strucs_context, ///< The strucs_context containing the structures
+	                                 const protein_list       &prm_proteins,       ///< SSAP-ready proteins for the structures
+	                                 const size_size_pair_vec &prm_pairs,          ///< The pairs of indices of the structures to compare
+	                                 const path_opt           &prm_cache_dir,      ///< An optional directory in which to cache the SSAP results
+	                                 const cath_ssap_options  &prm_ssap_options,   ///< The cath-ssap options with which to run the SSAPs
+	                                 const size_t             &prm_num_threads     ///< The number of threads with which to run the SSAPs
+	                                 ) {
+		// Grab any results that are already in the cache
+		ssap_result_opt_vec results( prm_pairs.size() );
+		size_vec        uncached_result_indices;
+		for (const size_t &result_index : indices( prm_pairs.size() ) ) {
+			if ( prm_cache_dir ) {
+				const size_t &struc_1_index = prm_pairs[ result_index ].first;
+				const size_t &struc_2_index = prm_pairs[ result_index ].second;
+				const string  id_pair       = id_of_index( prm_strucs_context, struc_1_index )
+				                            + id_of_index( prm_strucs_context, struc_2_index );
+				const path    scores_file   = *prm_cache_dir / ( id_pair + ".scores" );
+				const path    alnmnt_file   = *prm_cache_dir / ( id_pair + ".list"   );
+				if (   exists( scores_file ) && exists( alnmnt_file )
+				    && ! is_empty( scores_file ) && ! is_empty( alnmnt_file ) ) {
+					const ssap_scores_entry_vec entries = ssap_scores_file::parse_ssap_scores_file_simple( scores_file );
+					if ( ! entries.empty() ) {
+						BOOST_LOG_TRIVIAL( info ) << "Using cached SSAP results for " << id_pair << " from " << *prm_cache_dir;
+						results[ result_index ] = ssap_result{
+							entries.back(),
+							read_alignment_from_cath_ssap_legacy_format( alnmnt_file, prm_proteins[ struc_1_index ], prm_proteins[ struc_2_index ] )
+						};
+						continue;
+					}
+				}
+			}
+			uncached_result_indices.push_back( result_index );
+		}
+
+		// Run the uncached SSAPs
+		if ( ! uncached_result_indices.empty() ) {
+			size_size_pair_vec uncached_pairs;
+			uncached_pairs.reserve( uncached_result_indices.size() );
+			for (const size_t &result_index : uncached_result_indices) {
+				uncached_pairs.push_back( prm_pairs[ result_index ] );
+			}
+			BOOST_LOG_TRIVIAL( info ) << "About to run " << uncached_pairs.size() << " SSAPs in " << prm_num_threads << " thread(s)";
+			ssap_result_vec uncached_results = run_ssaps_concurrently( prm_proteins, uncached_pairs, prm_ssap_options, prm_num_threads );
+
+			for (const size_t &uncached_ctr : indices( uncached_results.size() ) ) {
+				const size_t  &result_index = uncached_result_indices[ uncached_ctr ];
+				ssap_result   &the_result   = uncached_results[ uncached_ctr ];
+
+				// Write the results to any cache directory
+				if ( prm_cache_dir ) {
+					const size_t &struc_1_index = prm_pairs[ result_index ].first;
+					const size_t &struc_2_index = prm_pairs[ result_index ].second;
+					const string  id_pair       = id_of_index( prm_strucs_context, struc_1_index )
+					                            + id_of_index( prm_strucs_context, struc_2_index );
+					spew( *prm_cache_dir / ( id_pair + ".scores" ), to_ssap_scores_line( the_result.first ) + "\n" );
+					if ( the_result.second ) {
+						write_alignment_as_cath_ssap_legacy_format(
+							*prm_cache_dir / ( id_pair + ".list" ),
+							*the_result.second,
+							prm_proteins[ struc_1_index ],
+							prm_proteins[ struc_2_index ]
+						);
+					}
+				}
+
+				results[ result_index ] = std::move( the_result );
+			}
+		}
+
+		ssap_result_vec all_results;
+		all_results.reserve( results.size() );
+		for (ssap_result_opt &result : results) {
+			all_results.push_back( std::move( *result ) );
+		}
+		return all_results;
+	}
+
+	/// \brief Label each structure with the index of its group of structures connected by the
+	///        specified SSAP results' alignments (the lowest index of a structure in the group)
+	size_vec groups_of_aligned_strucs(const size_t             &prm_num_strucs, ///< The number of structures
+	                                  const size_size_pair_vec &prm_pairs,      ///< The pairs of indices of the structures that have been compared
+	                                  const ssap_result_vec    &prm_results     ///< The SSAP results corresponding to prm_pairs
+	                                  ) {
+		// Repeatedly merge the groups of aligned pairs
+		size_vec group_of_struc = transform_build<size_vec>( indices( prm_num_strucs ), [] (const size_t &x) { return x; } );
+		for (const size_t &pair_index : indices( prm_pairs.size() ) ) {
+			if ( prm_results[ pair_index ].second ) {
+				const size_t old_group = max( group_of_struc[ prm_pairs[ pair_index ].first ], group_of_struc[ prm_pairs[ pair_index ].second ] );
+				const size_t new_group = min( group_of_struc[ prm_pairs[ pair_index ].first ], group_of_struc[ prm_pairs[ pair_index ].second ] );
+				std::replace( std::begin( group_of_struc ), std::end( group_of_struc ), old_group, new_group );
+			}
+		}
+		return group_of_struc;
+	}
+
+	/// \brief Choose a representative of each of the groups of structures connected by the specified
+	///        SSAP results' alignments: the member with the highest total SSAP score over its alignments
+	///        (or the group's lowest-indexed member if none of its members has any alignments)
+	///
+	/// \returns The indices of the representatives in ascending order
+	size_vec representatives_of_aligned_groups(const size_t             &prm_num_strucs, ///< The number of structures
+	                                           const size_size_pair_vec &prm_pairs,      ///< The pairs of indices of the structures that have been compared
+	                                           const ssap_result_vec    &prm_results     ///< The SSAP results corresponding to prm_pairs
+	                                           ) {
+		doub_vec total_scores( prm_num_strucs, 0.0 );
+		for (const size_t &pair_index : indices( prm_pairs.size() ) ) {
+			if ( prm_results[ pair_index ].second ) {
+				total_scores[ prm_pairs[ pair_index ].first  ] += prm_results[ pair_index ].first.get_ssap_score();
+				total_scores[ prm_pairs[ pair_index ].second ] += prm_results[ pair_index ].first.get_ssap_score();
+			}
+		}
+
+		const size_vec group_of_struc = groups_of_aligned_strucs( prm_num_strucs, prm_pairs, prm_results );
+		map<size_t, size_t> rep_of_group;
+		for (const size_t &struc_index : indices( prm_num_strucs ) ) {
+			const auto rep_itr = rep_of_group.find( group_of_struc[ struc_index ] );
+			if ( rep_itr == common::cend( rep_of_group ) ) {
+				rep_of_group.emplace( group_of_struc[ struc_index ], struc_index );
+			}
+			else if ( total_scores[ struc_index ] > total_scores[ rep_itr->second ] ) {
+				rep_itr->second = struc_index;
+			}
+		}
+
+		size_vec representatives;
+		representatives.reserve( rep_of_group.size() );
+		for (const auto &group_and_rep : rep_of_group) {
+			representatives.push_back( group_and_rep.second );
+		}
+		std::sort( std::begin( representatives ), std::end( representatives ) );
+		return representatives;
+	}
+
+	/// \brief Get pairs of the specified representatives (not already in the specified pairs) that bridge the
+	///        groups of structures connected by the specified SSAP results' alignments or empty if they're all
+	///        connected or if no such pair remains
+	///
+	/// This returns at most one pair for each group (other than the group of the first representative),
+	/// which joins one of the group's representatives to a representative of a group containing an
+	/// earlier representative.
+	size_size_pair_vec pairs_bridging_unaligned_groups(const size_t             &prm_num_strucs,     ///< The number of structures
+	                                                   const size_size_pair_vec &prm_pairs,          ///< The pairs of indices of the structures that have been compared
+	                                                   const ssap_result_vec    &prm_results,        ///< The SSAP results corresponding to prm_pairs
+	                                                   const size_vec           &prm_representatives ///< The ascending indices of the structures that may be used to bridge the groups
+	                                                   ) {
+		const size_vec                 group_of_struc = groups_of_aligned_strucs( prm_num_strucs, prm_pairs, prm_results );
+		const std::set<size_size_pair> compared_pairs{ common::cbegin( prm_pairs ), common::cend( prm_pairs ) };
+		std::set<size_t>               bridged_groups;
+		size_size_pair_vec             bridging_pairs;
+		for (const size_t &rep_2_ctr : indices( prm_representatives.size() ) ) {
+			const size_t &rep_2 = prm_representatives[ rep_2_ctr ];
+			for (const size_t &rep_1_ctr : indices( rep_2_ctr ) ) {
+				const size_t &rep_1 = prm_representatives[ rep_1_ctr ];
+				if (    group_of_struc[ rep_1 ] != group_of_struc[ rep_2 ]
+				     && bridged_groups.count( group_of_struc[ rep_2 ] ) == 0
+				     && compared_pairs.count( { rep_1, rep_2 } ) == 0
+				     && compared_pairs.count( { rep_2, rep_1 } ) == 0 ) {
+					bridging_pairs.emplace_back( rep_1, rep_2 );
+					bridged_groups.insert( group_of_struc[ rep_2 ] );
+					break;
+				}
+			}
+		}
+		return bridging_pairs;
+	}
+
+} // namespace
 
 /// \brief A standard do_clone method.
 unique_ptr<alignment_acquirer> do_the_ssaps_alignment_acquirer::do_clone() const {
@@ -78,138 +394,134 @@ bool do_the_ssaps_alignment_acquirer::do_requires_backbone_complete_input() cons
 	return true;
 }
 
-/// \brief Run the necessary cath-ssaps and then use them to get the alignment and spanning tree
+/// \brief Run the necessary SSAPs and then use them to get the alignment and spanning tree
+///
+/// The SSAPs are run in memory on the already-loaded structures, concurrently in get_num_threads() threads.
+/// If there is a directory_of_joy, it's used as a cache of the SSAP results.
 pair<alignment, size_size_pair_vec> do_the_ssaps_alignment_acquirer::do_get_alignment_and_spanning_tree(const strucs_context &prm_strucs_context, ///< The details of the structures for which the alignment and spanning tree is required
                                                                                                         const align_refining &prm_align_refining  ///< How much refining should be done to the alignment
                                                                                                         ) const {
-	using std::to_string;
-
-	// Get the directory in which the cath-ssaps should be done
-	const path ssaps_dir = get_directory_of_joy().value_or(
-		make_temp_dir_for_doing_ssaps( prm_strucs_context )
-	);
+	const size_t num_strucs = size( prm_strucs_context );
 
-	// Ensure the directory exists
-	if ( ! exists( ssaps_dir ) ) {
-		BOOST_LOG_TRIVIAL( info ) << "About to create directory " << ssaps_dir;
-		if ( ! create_directories( ssaps_dir ) ) {
+	// Ensure any cache directory exists
+	if ( get_directory_of_joy() && ! exists( *get_directory_of_joy() ) ) {
+		BOOST_LOG_TRIVIAL( info ) << "About to create directory " << *get_directory_of_joy();
+		if ( ! create_directories( *get_directory_of_joy() ) ) {
 			BOOST_THROW_EXCEPTION(runtime_error_exception(
 				"Unable to create directory "
-				+ ssaps_dir.string()
-				+ " for temporary cath-ssaps"
+				+ get_directory_of_joy()->string()
+				+ " for caching SSAP results"
 			));
 		}
 	}
 
-	// Perform any necessary cath-ssaps
-	path_vec scores_files;
-	const size_t num_strucs        = size( prm_strucs_context );
-	const size_t num_ssaps         = ( num_strucs * ( max( 1_z, num_strucs ) - 1_z ) ) / 2_z;
-	const string num_str           = to_string( num_ssaps );
-	const size_t num_str_width     = num_str.length();
-	const string num_str_width_str = "%" + to_string( num_str_width ) + "d";
-	BOOST_LOG_TRIVIAL( info ) << "About to check for and possibly run " << num_ssaps << " cath-ssaps in directory " << ssaps_dir;
-	for (const size_t &struc_1_index : indices( num_strucs ) ) {
-		for (const size_t &struc_2_index : irange( struc_1_index + 1, num_strucs ) ) {
-
-			const size_t comp_ctr_offset_1 = get_zero_index_of_strict_upper_half_matrix(
-				struc_1_index,
-				struc_2_index,
-				num_strucs
-			) + 1;
-			const string progress_str = ( format( num_str_width_str ) % comp_ctr_offset_1 ).str()
-				+ "/"
-				+ num_str;
-
-			// \TODO: Abstract out functions for making these standard file names
-			const string id_1   = get_domain_or_specified_or_name_from_acq( prm_strucs_context.get_name_sets()[ struc_1_index ] );
-			const string id_2   = get_domain_or_specified_or_name_from_acq( prm_strucs_context.get_name_sets()[ struc_2_index ] );
-			const path   scores_file = ssaps_dir / ( id_1 + id_2 + ".scores" );
-			const path   alnmnt_file = ssaps_dir / ( id_1 + id_2 + ".list"   );
-
-			scores_files.push_back( scores_file );
-
-			if (   ! exists( scores_file ) || ! exists( alnmnt_file )
-				|| is_empty( scores_file ) || is_empty( alnmnt_file ) ) {
-
-				// \TODO Tighten up the interface with the ssap/ssap.cpp code here
-				//
-				// In particular, the name_set will know the location of the file that each
-				// PDB was loaded from (if it was loaded from a PDB) so cath-ssap should have
-				// a --pdb-infile option and it should be explicitly used here.
-				str_vec cath_ssap_args{
-					cath_ssap_options::PROGRAM_NAME,
-					"--" + old_ssap_options_block::PO_ALIGN_DIR, ssaps_dir.string()
-				};
-				for (const size_t &index : { struc_1_index, struc_2_index } ) {
-					const auto       &name_set   = prm_strucs_context.get_name_sets()[ index ];
-					const domain_opt  opt_domain = get_domain_opt_of_index( prm_strucs_context, index );
-					cath_ssap_args.push_back( name_set.get_name_from_acq() );
-					if ( opt_domain ) {
-						cath_ssap_args.push_back( "--" + align_regions_options_block::PO_ALN_REGIONS );
-						cath_ssap_args.push_back( sillitoe_chopping_format{}.write_domain( *opt_domain ) );
-					}
-				}
-				BOOST_LOG_TRIVIAL( info ) << "[" << progress_str << "] Running : " << join( cath_ssap_args, " " ) << " and writing scores to " << scores_file;
-				ofstream out_scores_ofstream;
-				open_ofstream( out_scores_ofstream, scores_file );
-				run_ssap(
-					make_and_parse_options<cath_ssap_options>(
-						cath_ssap_args,
-						( run_mode_flag::value == run_mode::TEST )
-							? parse_sources::CMND_LINE_ONLY
-							: parse_sources::CMND_ENV_AND_FILE
-					),
-					std::cout,
-					std::cerr,
-					ostream_ref( out_scores_ofstream )
-				);
-				out_scores_ofstream.close();
-			}
-			else {
-				BOOST_LOG_TRIVIAL( info ) << "[" << progress_str << "] Skipping " << id_1 << " versus " << id_2 << " - non-empty data files already exist";
+	// Make SSAP-ready proteins from the structures and use them to choose the pairs to compare
+	protein_list proteins;
+	for (const size_t &struc_index : indices( num_strucs ) ) {
+		proteins.push_back( make_ssap_protein_of_index( prm_strucs_context, struc_index ) );
+	}
+	const cath_ssap_options ssap_options = ssap_options_from_env_and_file();
+	size_size_pair_vec      all_pairs    = pairs_to_compare( proteins, get_num_neighbours() );
+	ssap_result_vec         results      = get_ssap_results( prm_strucs_context, proteins, all_pairs, get_directory_of_joy(), ssap_options, get_num_threads() );
+
+	// If the selected pairs' alignments don't connect all the structures (because some of the SSAPs
+	// didn't produce alignments), fall back to also doing SSAPs between the disconnected groups.
+	//
+	// To keep this bounded, the bridging SSAPs are only done between the groups' representatives
+	// (as chosen after the selected pairs' SSAPs) and each round does at most one SSAP per group.
+	// So if the selected pairs leave k groups, this does k - 1 further SSAPs if they all produce alignments
+	// and at most k * ( k - 1 ) / 2 if most of them also fail to produce alignments.
+	// That's only O( N^2 ) in the pathological case that nearly none of the selected SSAPs produce alignments.
+	if ( get_num_neighbours() ) {
+		const size_vec representatives = representatives_of_aligned_groups( num_strucs, all_pairs, results );
+		while ( true ) {
+			const size_size_pair_vec bridging_pairs = pairs_bridging_unaligned_groups( num_strucs, all_pairs, results, representatives );
+			if ( bridging_pairs.empty() ) {
+				break;
 			}
+			BOOST_LOG_TRIVIAL( info ) << "The SSAP alignments don't connect all the structures, so also doing "
+			                          << bridging_pairs.size() << " SSAPs between representatives of the disconnected groups";
+			ssap_result_vec bridging_results = get_ssap_results( prm_strucs_context, proteins, bridging_pairs, get_directory_of_joy(), ssap_options, get_num_threads() );
+			all_pairs.insert( common::cend( all_pairs ), common::cbegin( bridging_pairs ), common::cend( bridging_pairs ) );
+			std::move( std::begin( bridging_results ), std::end( bridging_results ), std::back_inserter( results ) );
 		}
 	}
 
-	// Concatenate the scores files into one big file
-	const path scores_file = ssaps_dir / "ssap_scores";
-	spew(
-		scores_file,
-		join(
-			scores_files
-				| transformed( [] (const path &x) { return trim_right_copy( slurp( x ) ); } ),
-			"\n"
-		)
-	);
+	// Gather the SSAP scores (which may be sparse) and index the alignments by the pair of IDs
+	//
+	// The SSAP scores are indexed directly by the structures' indices rather than by parsing the
+	// scores together because that would order the IDs by their first appearance in the (possibly sparse) pairs.
+	// Pairs for which SSAP didn't produce an alignment are left out so the spanning tree can't use them.
+	map<pair<string, string>, alignment> alignment_of_ids;
+	size_size_doub_tpl_vec scores;
+	scores.reserve( results.size() );
+	for (const size_t &result_index : indices( results.size() ) ) {
+		if ( results[ result_index ].second ) {
+			const size_t &struc_1_index = all_pairs[ result_index ].first;
+			const size_t &struc_2_index = all_pairs[ result_index ].second;
+			scores.emplace_back( struc_1_index, struc_2_index, results[ result_index ].first.get_ssap_score() );
+			alignment_of_ids.emplace(
+				pair<string, string>{
+					id_of_index( prm_strucs_context, struc_1_index ),
+					id_of_index( prm_strucs_context, struc_2_index )
+				},
+				std::move( *results[ result_index ].second )
+			);
+		}
+	}
+	const str_vec ids = results.empty()
+		? str_vec{}
+		: transform_build<str_vec>(
+			indices( num_strucs ),
+			[&] (const size_t &x) { return id_of_index( prm_strucs_context, x ); }
+		);
 
-	// Use the ssap_scores_file_alignment_acquirer on the directory of data
-	return ssap_scores_file_alignment_acquirer{ scores_file }
-		.get_alignment_and_spanning_tree( prm_strucs_context, prm_align_refining );
+	// Glue the alignments together
+	return get_alignment_and_spanning_tree_of_ssap_data(
+		prm_strucs_context,
+		prm_align_refining,
+		ids,
+		scores,
+		[&] (const string &prm_name_a, const string &prm_name_b, const protein &/*prm_protein_a*/, const protein &/*prm_protein_b*/) {
+			const auto find_itr = alignment_of_ids.find( { prm_name_a, prm_name_b } );
+			if ( find_itr == common::cend( alignment_of_ids ) ) {
+				BOOST_THROW_EXCEPTION(runtime_error_exception(
+					"No SSAP alignment is available for "
+					+ prm_name_a
+					+ " versus "
+					+ prm_name_b
+					+ " (the SSAP scores may have been too low for an alignment to be produced)"
+				));
+			}
+			return find_itr->second;
+		},
+		"the SSAPs performed"
+	);
 }
 
 /// \brief Ctor for do_the_ssaps_alignment_acquirer
-do_the_ssaps_alignment_acquirer::do_the_ssaps_alignment_acquirer(const path_opt &prm_directory_of_joy ///< The directory in which the cath-ssaps should be performed
-                                                                 ) : directory_of_joy { prm_directory_of_joy } {
+do_the_ssaps_alignment_acquirer::do_the_ssaps_alignment_acquirer(const path_opt &prm_directory_of_joy, ///< An optional directory in which to cache the SSAP results
+                                                                 const size_opt &prm_num_neighbours,   ///< The number of scan-ranked neighbours of each structure with which to do the SSAPs (or none to do the SSAPs between all pairs)
+                                                                 const size_t   &prm_num_threads       ///< The number of threads with which to run the SSAPs (or 0 to use the hardware concurrency)
+                                                                 ) : directory_of_joy { prm_directory_of_joy },
+                                                                     num_neighbours   { prm_num_neighbours   },
+                                                                     num_threads      { prm_num_threads      } {
 }
 
-/// \brief Getter for the directory in which the cath-ssaps should be performed
+/// \brief Getter for the optional directory in which to cache the SSAP results
 const path_opt & do_the_ssaps_alignment_acquirer::get_directory_of_joy() const {
 	return directory_of_joy;
 }
 
-/// \brief Make a path with a temporary directory in which cath-ssaps for the specified strucs_context should be done
-///
-/// This aims to create a temporary directory that is likely to persist across multiple identical runs
-/// but very unlikely to clash amongst different inputs
+/// \brief Getter for the number of scan-ranked neighbours of each structure with which to do the SSAPs
+///        (or none to do the SSAPs between all pairs)
+const size_opt & do_the_ssaps_alignment_acquirer::get_num_neighbours() const {
+	return num_neighbours;
+}
+
+/// \brief Get the number of threads with which to run the SSAPs
 ///
-/// This doesn't actually create the directory
-path do_the_ssaps_alignment_acquirer::make_temp_dir_for_doing_ssaps(const strucs_context &prm_strucs_context ///< The strucs_context for which the directory should make a cath-ssaps temporary directory
-                                                                    ) {
-	return temp_directory_path() / (
-		  "cath-tools.tmp."
-		+ ( boost::format( R"(%|08X|)" ) % non_crypto_hash_copy( 0, prm_strucs_context ) ).str()
-		+ "_"
-		+ ( boost::format( R"(%|08X|)" ) % non_crypto_hash_copy( 1, prm_strucs_context ) ).str()
-	);
+/// If num_threads is 0, this returns the hardware concurrency (or 1 if that isn't available)
+size_t do_the_ssaps_alignment_acquirer::get_num_threads() const {
+	return num_threads_or_hardware( num_threads );
 }
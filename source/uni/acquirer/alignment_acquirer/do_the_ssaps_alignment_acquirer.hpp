@@ -26,31 +26,52 @@
 
 #include "acquirer/alignment_acquirer/alignment_acquirer.hpp"
 #include "common/path_type_aliases.hpp"
+#include "common/type_aliases.hpp"
+
+#include <cstddef>
 
 namespace cath { namespace align { class alignment; } }
 
 namespace cath { namespace align {
 
-	/// \brief Acquire the alignment by performing any necessary cath-ssaps in
-	///        a temp directory and then using ssap_scores_file_alignment_acquirer
+	/// \brief Acquire the alignment by performing the pairwise SSAPs in memory (concurrently)
+	///        and then glueing the alignments together as ssap_scores_file_alignment_acquirer does
+	///
+	/// If a directory is specified, it's used as a cache: any non-empty .scores/.list files
+	/// found there are used rather than re-running those SSAPs and any newly computed
+	/// results are written there
+	///
+	/// Only a max spanning tree of the SSAP scores is needed to glue the alignments together,
+	/// so if a number of neighbours is specified, the SSAPs are only done between each structure and
+	/// its top neighbours by a fast structural scan, plus the pairs in a max spanning tree of
+	/// the scan scores (to ensure the SSAP scores still connect all the structures)
 	class do_the_ssaps_alignment_acquirer final : public alignment_acquirer {
 	private:
 		using super = alignment_acquirer;
 
-		/// \brief Where the magic shall happen
+		/// \brief An optional directory in which to cache the SSAP results
 		path_opt directory_of_joy;
 
+		/// \brief The number of scan-ranked neighbours of each structure with which to do the SSAPs
+		///        (or none to do the SSAPs between all pairs)
+		size_opt num_neighbours;
+
+		/// \brief The number of threads with which to run the SSAPs (or 0 to use the hardware concurrency)
+		size_t num_threads;
+
 		std::unique_ptr<alignment_acquirer> do_clone() const final;
 		bool do_requires_backbone_complete_input() const final;
 		std::pair<alignment, size_size_pair_vec> do_get_alignment_and_spanning_tree(const file::strucs_context &,
 		                                                                            const align_refining &) const final;
 
 	public:
-		explicit do_the_ssaps_alignment_acquirer(const path_opt & = boost::none);
+		explicit do_the_ssaps_alignment_acquirer(const path_opt & = boost::none,
+		                                         const size_opt & = boost::none,
+		                                         const size_t & = 1);
 
 		const path_opt & get_directory_of_joy() const;
-
-		static boost::filesystem::path make_temp_dir_for_doing_ssaps(const file::strucs_context &);
+		const size_opt & get_num_neighbours() const;
+		size_t get_num_threads() const;
 	};
 
 } } // namespace cath::align
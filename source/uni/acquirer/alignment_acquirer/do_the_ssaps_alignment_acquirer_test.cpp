@@ -18,15 +18,107 @@
 /// You should have received a copy of the GNU General Public License
 /// along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <boost/test/unit_test.hpp>
+
+#include <boost/filesystem.hpp>
+
 #include "acquirer/alignment_acquirer/do_the_ssaps_alignment_acquirer.hpp"
+#include "alignment/alignment.hpp"
+#include "alignment/io/alignment_io.hpp"
+#include "common/boost_addenda/log/stringstream_log_sink.hpp"
+#include "common/file/temp_file.hpp"
+#include "common/size_t_literal.hpp"
+#include "file/name_set/name_set_list.hpp"
+#include "file/strucs_context.hpp"
+#include "test/global_test_constants.hpp"
 
-#include <boost/test/unit_test.hpp>
+namespace cath { namespace test { } }
+
+using namespace cath;
+using namespace cath::align;
+using namespace cath::common;
+using namespace cath::common::literals;
+using namespace cath::file;
+using namespace cath::test;
+
+using boost::filesystem::create_directory;
+using boost::filesystem::exists;
+using boost::filesystem::remove_all;
+using std::string;
+
+namespace cath {
+	namespace test {
+
+		/// \brief The do_the_ssaps_alignment_acquirer_test_suite_fixture to assist in testing do_the_ssaps_alignment_acquirer
+		struct do_the_ssaps_alignment_acquirer_test_suite_fixture : protected global_test_constants {
+		protected:
+			~do_the_ssaps_alignment_acquirer_test_suite_fixture() noexcept = default;
+
+			/// \brief The names of the structures to use in the tests
+			const str_vec names = { "1o7iB00", "3uljB00", "4gs3A00" };
+
+			/// \brief The PDBs of the structures to use in the tests
+			const pdb_list the_pdbs = read_pdb_files( {
+				TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / names[ 0 ],
+				TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / names[ 1 ],
+				TEST_SSAP_ALIGNMENT_GLUING_DATA_DIR() / names[ 2 ],
+			} );
+
+			/// \brief Get the alignment from the specified do_the_ssaps_alignment_acquirer as a FASTA string
+			string fasta_alignment_of_acquirer(const do_the_ssaps_alignment_acquirer &prm_acquirer ///< The do_the_ssaps_alignment_acquirer to query
+			                                   ) const {
+				const stringstream_log_sink log_sink;
+				return alignment_as_fasta_string(
+					prm_acquirer.get_alignment_and_spanning_tree(
+						strucs_context{ the_pdbs, build_name_set_list( names ) }
+					).first,
+					the_pdbs,
+					names
+				);
+			}
+		};
 
-BOOST_AUTO_TEST_SUITE(do_the_ssaps_alignment_acquirer_test_suite)
+	}  // namespace test
+}  // namespace cath
 
-BOOST_AUTO_TEST_CASE(basic) {
-	BOOST_TEST( true );
+BOOST_FIXTURE_TEST_SUITE(do_the_ssaps_alignment_acquirer_test_suite, do_the_ssaps_alignment_acquirer_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(gives_same_alignment_whatever_the_number_of_threads) {
+	BOOST_CHECK_EQUAL(
+		fasta_alignment_of_acquirer( do_the_ssaps_alignment_acquirer{ boost::none, boost::none, 1 } ),
+		fasta_alignment_of_acquirer( do_the_ssaps_alignment_acquirer{ boost::none, boost::none, 3 } )
+	);
 }
 
-BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_CASE(writes_and_reuses_cache_dir) {
+	const temp_file cache_dir_file{ ".do_the_ssaps_alignment_acquirer_test.%%%%-%%%%-%%%%-%%%%" };
+	const auto      cache_dir = get_filename( cache_dir_file );
+	BOOST_REQUIRE( create_directory( cache_dir ) );
+
+	const string uncached_aln = fasta_alignment_of_acquirer( do_the_ssaps_alignment_acquirer{ cache_dir, boost::none, 2 } );
+	BOOST_CHECK( exists( cache_dir / "1o7iB003uljB00.scores" ) );
+	BOOST_CHECK( exists( cache_dir / "1o7iB003uljB00.list"   ) );
+	const string cached_aln   = fasta_alignment_of_acquirer( do_the_ssaps_alignment_acquirer{ cache_dir, boost::none, 2 } );
+	remove_all( cache_dir );
+
+	BOOST_CHECK_EQUAL( uncached_aln, cached_aln );
+	BOOST_CHECK_EQUAL( uncached_aln, fasta_alignment_of_acquirer( do_the_ssaps_alignment_acquirer{} ) );
+}
 
+BOOST_AUTO_TEST_CASE(neighbours_option_still_aligns_all_structures) {
+	const stringstream_log_sink log_sink;
+	const auto aln_and_tree = do_the_ssaps_alignment_acquirer{ boost::none, 1_z, 1 }.get_alignment_and_spanning_tree(
+		strucs_context{ the_pdbs, build_name_set_list( names ) }
+	);
+	BOOST_CHECK_EQUAL( aln_and_tree.first.num_entries(), 3_z );
+	BOOST_CHECK_EQUAL( aln_and_tree.second.size(),       2_z );
+}
+
+BOOST_AUTO_TEST_CASE(neighbours_option_with_enough_neighbours_does_all_pairs) {
+	BOOST_CHECK_EQUAL(
+		fasta_alignment_of_acquirer( do_the_ssaps_alignment_acquirer{ boost::none, 2_z, 1 } ),
+		fasta_alignment_of_acquirer( do_the_ssaps_alignment_acquirer{ boost::none, boost::none, 1 } )
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
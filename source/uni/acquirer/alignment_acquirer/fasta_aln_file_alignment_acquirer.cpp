@@ -77,8 +77,10 @@ pair<alignment, size_size_pair_vec> fasta_aln_file_alignment_acquirer::do_get_al
 }
 
 /// \brief Ctor for fasta_aln_file_alignment_acquirer
-fasta_aln_file_alignment_acquirer::fasta_aln_file_alignment_acquirer(const path &prm_fasta_alignment_file ///< TODOCUMENT
-                                                                     ) : fasta_alignment_file(prm_fasta_alignment_file) {
+fasta_aln_file_alignment_acquirer::fasta_aln_file_alignment_acquirer(const path   &prm_fasta_alignment_file, ///< TODOCUMENT
+                                                                     const size_t &prm_refining_num_threads  ///< The number of threads over which to spread any refining's scoring (or 0 to use one per hardware thread)
+                                                                     ) : super( prm_refining_num_threads ),
+                                                                         fasta_alignment_file(prm_fasta_alignment_file) {
 }
 
 /// \brief TODOCUMENT
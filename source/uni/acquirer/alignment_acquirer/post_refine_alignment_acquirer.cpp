@@ -61,9 +61,19 @@ pair<alignment, size_size_pair_vec> post_refine_alignment_acquirer::do_get_align
 		prm_strucs_context
 	);
 	const protein_list proteins                 = build_protein_list( backbone_complete_strucs_context );
-	const alignment    refined_alignment        = alignment_refiner().iterate( unrefined_aln_n_spntree.first, proteins, gap_penalty( 50, 0 ) );
+	const alignment    refined_alignment        = alignment_refiner( refining_num_threads ).iterate( unrefined_aln_n_spntree.first, proteins, gap_penalty( 50, 0 ) );
 	const alignment    scored_refined_alignment = score_alignment_copy( residue_scorer(), refined_alignment, proteins );
 
 	// Return the result
 	return make_pair( scored_refined_alignment, unrefined_aln_n_spntree.second );
 }
+
+/// \brief Ctor from the number of threads over which to spread the refining's scoring
+post_refine_alignment_acquirer::post_refine_alignment_acquirer(const size_t &prm_refining_num_threads ///< The number of threads over which to spread the refining's scoring (or 0 to use one per hardware thread)
+                                                               ) : refining_num_threads{ prm_refining_num_threads } {
+}
+
+/// \brief Getter for the number of threads over which to spread the refining's scoring (or 0 to use one per hardware thread)
+const size_t & post_refine_alignment_acquirer::get_refining_num_threads() const {
+	return refining_num_threads;
+}
@@ -34,12 +34,21 @@ namespace cath {
 		private:
 			using super = alignment_acquirer;
 
+			/// \brief The number of threads over which to spread the refining's scoring (or 0 to use one per hardware thread)
+			size_t refining_num_threads = 1;
+
 			virtual std::unique_ptr<alignment_acquirer> do_clone() const = 0;
 
 			virtual std::pair<alignment, size_size_pair_vec> do_get_alignment_and_spanning_tree(const file::strucs_context &) const = 0;
 
 			std::pair<alignment, size_size_pair_vec> do_get_alignment_and_spanning_tree(const file::strucs_context &,
 			                                                                            const align_refining &) const final;
+
+		protected:
+			explicit post_refine_alignment_acquirer(const size_t & = 1);
+
+		public:
+			const size_t & get_refining_num_threads() const;
 		};
 
 	} // namespace align
@@ -101,8 +101,10 @@ pair<alignment, size_size_pair_vec> ssap_aln_file_alignment_acquirer::do_get_ali
 }
 
 /// \brief Ctor for ssap_aln_file_alignment_acquirer
-ssap_aln_file_alignment_acquirer::ssap_aln_file_alignment_acquirer(const path &prm_ssap_alignment_file ///< TODOCUMENT
-                                                                   ) : ssap_alignment_file( prm_ssap_alignment_file ) {
+ssap_aln_file_alignment_acquirer::ssap_aln_file_alignment_acquirer(const path   &prm_ssap_alignment_file, ///< TODOCUMENT
+                                                                   const size_t &prm_refining_num_threads ///< The number of threads over which to spread any refining's scoring (or 0 to use one per hardware thread)
+                                                                   ) : super( prm_refining_num_threads ),
+                                                                       ssap_alignment_file( prm_ssap_alignment_file ) {
 }
 
 /// \brief TODOCUMENT
@@ -83,65 +83,29 @@ static_assert( aln_glue_style_of_align_refining( align_refining::NO    ) == aln_
 static_assert( aln_glue_style_of_align_refining( align_refining::LIGHT ) == aln_glue_style::INCREMENTALLY_WITH_PAIR_REFINING, "" );
 static_assert( aln_glue_style_of_align_refining( align_refining::HEAVY ) == aln_glue_style::WITH_HEAVY_REFINING,              "" );
 
-/// \brief TODOCUMENT
-pair<alignment, size_size_pair_vec> ssap_scores_file_alignment_acquirer::do_get_alignment_and_spanning_tree(const strucs_context &prm_strucs_context, ///< TODOCUMENT
+/// \brief Get the alignment and spanning tree by parsing the SSAP scores file and reading the alignments from its directory
+pair<alignment, size_size_pair_vec> ssap_scores_file_alignment_acquirer::do_get_alignment_and_spanning_tree(const strucs_context &prm_strucs_context, ///< The details of the structures for which the alignment and spanning tree is required
                                                                                                             const align_refining &prm_align_refining  ///< How much refining should be done to the alignment
                                                                                                             ) const {
 	// Parse the SSAP scores file
-	const pdb_list &the_pdbs         = prm_strucs_context.get_pdbs();
-	const size_t    num_pdbs         = the_pdbs.size();
 	const path      ssaps_filename   = get_ssap_scores_file();
 	const auto      ssap_scores_data = ssap_scores_file::parse_ssap_scores_file( ssaps_filename );
-	const str_vec  &names            = ssap_scores_data.first;
-	const auto     &scores           = ssap_scores_data.second;
-
-	if ( names.size() != num_pdbs ) {
-		if ( !names.empty() && num_pdbs != 1 ) {
-			BOOST_THROW_EXCEPTION(runtime_error_exception(
-				"The number of PDBs is "
-				+ ::std::to_string( num_pdbs         )
-				+ ", which doesn't match the "
-				+ ::std::to_string( names.size() )
-				+ " structures required for combining with the SSAP scores file \""
-				+ ssaps_filename.string()
-				+ "\""
-			));
-		}
-	}
-
-	// Construct the new alignment
-	const auto aln_and_spantree = build_multi_alignment(
-		the_pdbs,
-		names,
-		scores,
-		ssaps_filename.parent_path(),
-		aln_glue_style_of_align_refining( prm_align_refining ),
-		ostream_ref{ cerr }
-	);
-	const alignment          &new_alignment = aln_and_spantree.first;
-	const size_size_pair_vec &spanning_tree = aln_and_spantree.second;
-
-	// TODOCUMENT
-	if ( names.empty() ) {
-		// Return the results
-		return make_pair( new_alignment, spanning_tree );
-	}
-
-//	BOOST_LOG_TRIVIAL( warning )<< "About to attempt to build protein list using data that's been read from ssaps_filename (with " << num_pdbs << " pdbs and " << names.size() << " names)";
 
-	const protein_list proteins_of_pdbs     = build_protein_list_of_pdb_list_and_names(
-		prm_strucs_context.get_pdbs(),
-		build_name_set_list( names )
+	return get_alignment_and_spanning_tree_of_ssap_data(
+		prm_strucs_context,
+		prm_align_refining,
+		ssap_scores_data.first,
+		ssap_scores_data.second,
+		[&] (const string &prm_name_a, const string &prm_name_b, const protein &prm_protein_a, const protein &prm_protein_b) {
+			return read_alignment_from_cath_ssap_legacy_format(
+				ssaps_filename.parent_path() / ( prm_name_a + prm_name_b + ".list" ),
+				prm_protein_a,
+				prm_protein_b,
+				ostream_ref{ cerr }
+			);
+		},
+		"the SSAP scores file \"" + ssaps_filename.string() + "\""
 	);
-	const alignment    scored_new_alignment = score_alignment_copy( residue_scorer(), new_alignment, proteins_of_pdbs );
-
-//	cerr << "Did generate alignment : \n";
-//	cerr << horiz_align_outputter( scored_new_alignment ) << endl;
-//	write_alignment_as_fasta_alignment( cerr, scored_new_alignment, build_protein_list_of_pdb_list( prm_strucs_context ) );
-//	cerr << endl;
-
-	// Return the results
-	return make_pair( scored_new_alignment, spanning_tree );
 }
 
 /// \brief Ctor for ssap_scores_file_alignment_acquirer
@@ -154,13 +118,12 @@ path ssap_scores_file_alignment_acquirer::get_ssap_scores_file() const {
 	return ssap_scores_filename;
 }
 
-/// \brief Build an alignment between the specified PDBs & names using the specified scores and directory of SSAP alignments
-pair<alignment, size_size_pair_vec> cath::align::build_multi_alignment(const pdb_list               &prm_pdbs,           ///< The PDBs to be aligned
-                                                                       const str_vec                &prm_names,          ///< The names of the structures to be aligned
-                                                                       const size_size_doub_tpl_vec &prm_scores,         ///< The SSAP scores between the structures
-                                                                       const path                   &prm_alignments_dir, ///< The directory containing alignments for the structures
-                                                                       const aln_glue_style         &prm_aln_glue_style, ///< The approach that should be used for glueing alignments together
-                                                                       const ostream_ref_opt        &prm_ostream         ///< An (optional reference_wrapper of an) ostream to which warnings/errors should be written
+/// \brief Build an alignment between the specified PDBs & names using the specified scores and function for getting the SSAP alignments
+pair<alignment, size_size_pair_vec> cath::align::build_multi_alignment(const pdb_list                 &prm_pdbs,            ///< The PDBs to be aligned
+                                                                       const str_vec                  &prm_names,           ///< The names of the structures to be aligned
+                                                                       const size_size_doub_tpl_vec   &prm_scores,          ///< The SSAP scores between the structures
+                                                                       const ssap_alignment_getter_fn &prm_alignment_getter, ///< The function to get the SSAP alignment between a pair of the structures
+                                                                       const aln_glue_style           &prm_aln_glue_style   ///< The approach that should be used for glueing alignments together
                                                                        ) {
 	const protein_list prots = build_protein_list_of_pdb_list( prm_pdbs );
 	auto aln_and_spantree = build_alignment(
@@ -173,11 +136,11 @@ pair<alignment, size_size_pair_vec> cath::align::build_multi_alignment(const pdb
 		[&] (const size_t  &prm_index_a, //< The index of the first  protein for which the alignment is required
 		     const size_t  &prm_index_b  //< The index of the second protein for which the alignment is required
 		     ) {
-			return read_alignment_from_cath_ssap_legacy_format(
-				prm_alignments_dir / ( prm_names[ prm_index_a ] + prm_names[ prm_index_b ] + ".list" ),
+			return prm_alignment_getter(
+				prm_names[ prm_index_a ],
+				prm_names[ prm_index_b ],
 				prots[ prm_index_a ],
-				prots[ prm_index_b ],
-				prm_ostream
+				prots[ prm_index_b ]
 			);
 		}
 	);
@@ -187,3 +150,81 @@ pair<alignment, size_size_pair_vec> cath::align::build_multi_alignment(const pdb
 		get_edges_of_spanning_tree( aln_and_spantree.second )
 	};
 }
+
+/// \brief Build an alignment between the specified PDBs & names using the specified scores and directory of SSAP alignments
+pair<alignment, size_size_pair_vec> cath::align::build_multi_alignment(const pdb_list               &prm_pdbs,           ///< The PDBs to be aligned
+                                                                       const str_vec                &prm_names,          ///< The names of the structures to be aligned
+                                                                       const size_size_doub_tpl_vec &prm_scores,         ///< The SSAP scores between the structures
+                                                                       const path                   &prm_alignments_dir, ///< The directory containing alignments for the structures
+                                                                       const aln_glue_style         &prm_aln_glue_style, ///< The approach that should be used for glueing alignments together
+                                                                       const ostream_ref_opt        &prm_ostream         ///< An (optional reference_wrapper of an) ostream to which warnings/errors should be written
+                                                                       ) {
+	return build_multi_alignment(
+		prm_pdbs,
+		prm_names,
+		prm_scores,
+		[&] (const string &prm_name_a, const string &prm_name_b, const protein &prm_protein_a, const protein &prm_protein_b) {
+			return read_alignment_from_cath_ssap_legacy_format(
+				prm_alignments_dir / ( prm_name_a + prm_name_b + ".list" ),
+				prm_protein_a,
+				prm_protein_b,
+				prm_ostream
+			);
+		},
+		prm_aln_glue_style
+	);
+}
+
+/// \brief Get the scored alignment and spanning tree for the specified structures from the specified SSAP scores data
+///        and function for getting the SSAP alignments
+///
+/// This is the common core of ssap_scores_file_alignment_acquirer and do_the_ssaps_alignment_acquirer
+pair<alignment, size_size_pair_vec> cath::align::get_alignment_and_spanning_tree_of_ssap_data(const strucs_context           &prm_strucs_context,   ///< The details of the structures for which the alignment and spanning tree is required
+                                                                                              const align_refining           &prm_align_refining,   ///< How much refining should be done to the alignment
+                                                                                              const str_vec                  &prm_names,            ///< The names of the structures, as parsed from the SSAP scores data
+                                                                                              const size_size_doub_tpl_vec   &prm_scores,           ///< The SSAP scores between the structures, as parsed from the SSAP scores data
+                                                                                              const ssap_alignment_getter_fn &prm_alignment_getter, ///< The function to get the SSAP alignment between a pair of the structures
+                                                                                              const string                   &prm_source_descr      ///< A description of the source of the SSAP scores data for use in error messages
+                                                                                              ) {
+	const pdb_list &the_pdbs = prm_strucs_context.get_pdbs();
+	const size_t    num_pdbs = the_pdbs.size();
+
+	if ( prm_names.size() != num_pdbs ) {
+		if ( !prm_names.empty() && num_pdbs != 1 ) {
+			BOOST_THROW_EXCEPTION(runtime_error_exception(
+				"The number of PDBs is "
+				+ ::std::to_string( num_pdbs         )
+				+ ", which doesn't match the "
+				+ ::std::to_string( prm_names.size() )
+				+ " structures required for combining with "
+				+ prm_source_descr
+			));
+		}
+	}
+
+	// Construct the new alignment
+	const auto aln_and_spantree = build_multi_alignment(
+		the_pdbs,
+		prm_names,
+		prm_scores,
+		prm_alignment_getter,
+		aln_glue_style_of_align_refining( prm_align_refining )
+	);
+	const alignment          &new_alignment = aln_and_spantree.first;
+	const size_size_pair_vec &spanning_tree = aln_and_spantree.second;
+
+	// TODOCUMENT
+	if ( prm_names.empty() ) {
+		// Return the results
+		return make_pair( new_alignment, spanning_tree );
+	}
+
+	const protein_list proteins_of_pdbs     = build_protein_list_of_pdb_list_and_names(
+		prm_strucs_context.get_pdbs(),
+		build_name_set_list( prm_names )
+	);
+	const alignment    scored_new_alignment = score_alignment_copy( residue_scorer(), new_alignment, proteins_of_pdbs );
+
+	// Return the results
+	return make_pair( scored_new_alignment, spanning_tree );
+}
@@ -28,6 +28,10 @@
 #include "alignment/align_type_aliases.hpp"
 #include "alignment/aln_glue_style.hpp"
 
+#include <functional>
+#include <string>
+
+namespace cath { class protein; }
 namespace cath { namespace align { class alignment; } }
 namespace cath { namespace file { class pdb_list; } }
 
@@ -51,6 +55,19 @@ namespace cath {
 			boost::filesystem::path get_ssap_scores_file() const;
 		};
 
+		/// \brief Type alias for a function to get the SSAP alignment between the two structures with the specified
+		///        names (as used in SSAP scores data) and proteins
+		using ssap_alignment_getter_fn = std::function<alignment(const std::string &,
+		                                                         const std::string &,
+		                                                         const protein &,
+		                                                         const protein &)>;
+
+		std::pair<alignment, size_size_pair_vec> build_multi_alignment(const file::pdb_list &,
+		                                                               const str_vec &,
+		                                                               const size_size_doub_tpl_vec &,
+		                                                               const ssap_alignment_getter_fn &,
+		                                                               const aln_glue_style &);
+
 		std::pair<alignment, size_size_pair_vec> build_multi_alignment(const file::pdb_list &,
 		                                                               const str_vec &,
 		                                                               const size_size_doub_tpl_vec &,
@@ -58,6 +75,13 @@ namespace cath {
 		                                                               const aln_glue_style &,
 		                                                               const ostream_ref_opt & = boost::none);
 
+		std::pair<alignment, size_size_pair_vec> get_alignment_and_spanning_tree_of_ssap_data(const file::strucs_context &,
+		                                                                                      const align_refining &,
+		                                                                                      const str_vec &,
+		                                                                                      const size_size_doub_tpl_vec &,
+		                                                                                      const ssap_alignment_getter_fn &,
+		                                                                                      const std::string &);
+
 	} // namespace align
 } // namespace cath
 
@@ -26,6 +26,7 @@
 
 #include "alignment/dyn_prog_align/detail/path_step.hpp"
 
+#include <cstdint>
 #include <map>
 #include <utility>
 #include <vector>
@@ -47,6 +48,13 @@ namespace cath {
 		/// \brief TODOCUMENT
 		using aln_posn_opt_vec_vec = std::vector<aln_posn_opt_vec>;
 
+		/// \brief The compact type used to store a (possibly absent) position within an alignment
+		///
+		/// An absent position is stored as alignment::ABSENT_POSN
+		using compact_aln_posn_type = uint32_t;
+		/// \brief Type alias for a vector of compact_aln_posn_type values
+		using compact_aln_posn_vec = std::vector<compact_aln_posn_type>;
+
 		namespace detail {
 			/// \brief TODOCUMENT
 			using path_step_score_map = std::map<  path_step, score_type >;
@@ -28,15 +28,16 @@
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/count_if.hpp>
+#include <boost/range/algorithm/equal.hpp>
 #include <boost/range/algorithm/max_element.hpp>
 #include <boost/range/irange.hpp>
-#include <boost/range/irange.hpp>
 #include <boost/range/numeric.hpp>
 #include <boost/throw_exception.hpp>
 
 #include "alignment/alignment_row.hpp"
 #include "common/algorithm/copy_build.hpp"
 #include "common/boost_addenda/range/indices.hpp"
+#include "common/cpp14/cbegin_cend.hpp"
 #include "common/exception/invalid_argument_exception.hpp"
 #include "common/temp_check_offset_1.hpp"
 #include "file/pdb/backbone_complete_indices.hpp"
@@ -67,6 +68,7 @@ using boost::range::count_if;
 constexpr alignment::size_type alignment::NUM_ENTRIES_IN_PAIR_ALIGNMENT;
 constexpr alignment::size_type alignment::PAIR_A_IDX;
 constexpr alignment::size_type alignment::PAIR_B_IDX;
+constexpr compact_aln_posn_type alignment::ABSENT_POSN;
 
 /// \brief TODOCUMENT
 void alignment::check_scored() const {
@@ -98,9 +100,15 @@ void alignment::check_index_in_range(const alignment::size_type &prm_index ///<
 	}
 }
 
-/// \brief TODOCUMENT
-alignment::size_type alignment::reserved_length() const {
-	return positions.empty() ? 0 : positions.front().size();
+/// \brief Extend the alignment (with absent positions) so that it includes the specified index
+///
+/// This is a no-op if the alignment already includes the specified index
+void alignment::extend_to_index(const size_type &prm_index ///< The index that the alignment should include
+                                ) {
+	if ( prm_index >= length() ) {
+		logical_length = prm_index + 1;
+		positions.resize( logical_length * entry_count, ABSENT_POSN );
+	}
 }
 
 /// \brief Ctor for alignment
@@ -108,7 +116,7 @@ alignment::size_type alignment::reserved_length() const {
 /// It is useful to allow an alignment with one entry so that cath-superpose doesn't
 /// have to treat that as a special case.
 alignment::alignment(const size_type &prm_num_entries ///< TODOCUMENT
-                     ) : positions      ( prm_num_entries ),
+                     ) : entry_count    ( prm_num_entries ),
                          logical_length ( 0               ) {
 	if ( prm_num_entries < 1 ) {
 		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot currently create alignment of with no entries"));
@@ -120,7 +128,7 @@ alignment::alignment(const size_type &prm_num_entries ///< TODOCUMENT
 /// It is useful to allow an alignment with one entry so that cath-superpose doesn't
 /// have to treat that as a special case.
 alignment::alignment(const aln_posn_opt_vec_vec &prm_lists ///< TODOCUMENT
-                     ) : positions      ( prm_lists.size() ),
+                     ) : entry_count    ( prm_lists.size() ),
                          logical_length ( 0                ) {
 	// If there isn't at least one list, then throw a wobbly
 	const size_type the_num_entries = prm_lists.size();
@@ -159,17 +167,17 @@ alignment::alignment(const aln_posn_opt_vec_vec &prm_lists ///< TODOCUMENT
 	}
 }
 
-/// \brief TODOCUMENT
-void alignment::reserve(const size_type &prm_size ///< TODOCUMENT
+/// \brief Reserve space for the specified number of indices
+///
+/// This doesn't change the length of the alignment
+void alignment::reserve(const size_type &prm_size ///< The number of indices for which space should be reserved
                         ) {
-	for (aln_posn_opt_vec &position_part : positions) {
-		position_part.resize( prm_size, none );
-	}
+	positions.reserve( prm_size * entry_count );
 }
 
 /// \brief TODOCUMENT
 alignment::size_type alignment::num_entries() const {
-	return positions.size();
+	return entry_count;
 }
 
 /// \brief TODOCUMENT
@@ -191,9 +199,33 @@ const alignment_residue_scores & alignment::get_alignment_residue_scores() const
 aln_posn_opt alignment::position_of_entry_of_index(const size_type &prm_entry, ///< TODOCUMENT
                                                    const size_type &prm_index  ///< TODOCUMENT
                                                    ) const {
+	const compact_aln_posn_type position = compact_position_of_entry_of_index( prm_entry, prm_index );
+	return is_present_compact_posn( position ) ? aln_posn_opt{ position } : aln_posn_opt{ none };
+}
+
+/// \brief Get the compact position of the specified entry at the specified index
+///
+/// This avoids the overhead of an aln_posn_opt for code that scans through an alignment:
+/// an absent position is represented as ABSENT_POSN (see is_present_compact_posn())
+compact_aln_posn_type alignment::compact_position_of_entry_of_index(const size_type &prm_entry, ///< The entry of interest
+                                                                    const size_type &prm_index  ///< The index of interest
+                                                                    ) const {
 	check_entry_in_range( prm_entry );
 	check_index_in_range( prm_index );
-	return positions[ prm_entry ][ prm_index ];
+	return positions[ prm_index * entry_count + prm_entry ];
+}
+
+/// \brief Get the compact positions of all the entries at the specified index
+///
+/// The range has one value per entry and absent positions are represented as ABSENT_POSN
+/// (see is_present_compact_posn())
+///
+/// The range is invalidated by any modification of the alignment
+compact_aln_posn_crange alignment::compact_positions_of_index(const size_type &prm_index ///< The index of interest
+                                                             ) const {
+	check_index_in_range( prm_index );
+	const auto begin_itr = common::cbegin( positions ) + static_cast<ptrdiff_t>( prm_index * entry_count );
+	return { begin_itr, begin_itr + static_cast<ptrdiff_t>( entry_count ) };
 }
 
 /// \brief TODOCUMENT
@@ -213,18 +245,18 @@ void alignment::set_position_value(const size_type     &prm_entry, ///< TODOCUME
 		BOOST_THROW_EXCEPTION(invalid_argument_exception("Not currently able to add multiple rows to an existing alignment"));
 	}
 
-	if ( prm_index >= reserved_length() ) {
-		for (aln_posn_opt_vec &position_part : positions ) {
-			position_part.resize ( prm_index + 1, none );
-		}
+	if ( prm_value >= ABSENT_POSN ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception(
+			"Position value "
+			+ lexical_cast<string>( prm_value )
+			+ " is too large to be stored in an alignment"
+		));
 	}
 
-	if (prm_index >= length()) {
-		logical_length = prm_index+1;
-	}
+	extend_to_index( prm_index );
 
 	// Set the entry
-	positions[ prm_entry ][ prm_index ] = prm_value;
+	positions[ prm_index * entry_count + prm_entry ] = static_cast<compact_aln_posn_type>( prm_value );
 }
 
 /// \brief Clear the specified value in the alignment
@@ -243,18 +275,10 @@ void alignment::unset_position_value(const size_type &prm_entry, ///< The entry
 		BOOST_THROW_EXCEPTION(invalid_argument_exception("Not currently able to add multiple rows to an existing alignment"));
 	}
 
-	if ( prm_index >= reserved_length() ) {
-		for (aln_posn_opt_vec &position_part : positions ) {
-			position_part.resize ( prm_index + 1, none );
-		}
-	}
+	extend_to_index( prm_index );
 
-	if (prm_index >= length()) {
-		logical_length = prm_index+1;
-	}
-
-	// Set the entry
-	positions[ prm_entry ][ prm_index ] = none;
+	// Clear the entry
+	positions[ prm_index * entry_count + prm_entry ] = ABSENT_POSN;
 }
 
 /// \brief TODOCUMENT
@@ -343,7 +367,7 @@ bool cath::align::has_position_of_entry_of_index(const alignment &prm_alignment,
                                                  const size_t    &prm_entry,     ///< TODOCUMENT
                                                  const size_t    &prm_index      ///< TODOCUMENT
                                                  ) {
-	return static_cast<bool>( prm_alignment.position_of_entry_of_index( prm_entry, prm_index ) );
+	return is_present_compact_posn( prm_alignment.compact_position_of_entry_of_index( prm_entry, prm_index ) );
 }
 
 /// \brief TODOCUMENT
@@ -425,19 +449,12 @@ bool cath::align::operator==(const alignment &prm_aln_a, ///< TODOCUMENT
 	}
 
 	// Otherwise, check each of the positions match
-	const alignment::size_type length      = prm_aln_a.length();
-	const alignment::size_type num_entries = prm_aln_a.num_entries();
-	for (const alignment::size_type &index_ctr : indices( length ) ) {
-		for (const alignment::size_type &entry_ctr : indices( num_entries ) ) {
-			const aln_posn_opt &a_position = prm_aln_a.position_of_entry_of_index( entry_ctr, index_ctr );
-			const aln_posn_opt &b_position = prm_aln_b.position_of_entry_of_index( entry_ctr, index_ctr );
-			if ( a_position != b_position ) {
-				return false;
-			}
+	return all_of(
+		indices( prm_aln_a.length() ),
+		[&] (const size_t &x) {
+			return boost::range::equal( prm_aln_a.compact_positions_of_index( x ), prm_aln_b.compact_positions_of_index( x ) );
 		}
-	}
-
-	return true;
+	);
 }
 
 /// \brief Basic insertion operator to output a rough summary of an alignment to an ostream
@@ -469,14 +486,63 @@ ostream & cath::align::operator<<(ostream         &prm_ostream,  ///< The stream
 size_vec cath::align::entries_present_at_index(const alignment            &prm_alignment, ///< TODOCUMENT
                                                const alignment::size_type &prm_index      ///< TODOCUMENT
                                                ) {
-	return copy_build<size_vec>(
-		indices( prm_alignment.num_entries() )
-			| filtered(
-				[&] (const size_t &x) {
-					return has_position_of_entry_of_index( prm_alignment, x, prm_index );
-				}
-			)
-	);
+	size_vec present_entries;
+	size_t entry_ctr = 0;
+	for (const compact_aln_posn_type &position : prm_alignment.compact_positions_of_index( prm_index ) ) {
+		if ( is_present_compact_posn( position ) ) {
+			present_entries.push_back( entry_ctr );
+		}
+		++entry_ctr;
+	}
+	return present_entries;
+}
+
+/// \brief Get the indices at which both of the specified entries have present positions in the specified alignment
+///
+/// \relates alignment
+size_vec cath::align::indices_of_present_positions_of_both_entries(const alignment            &prm_alignment, ///< The alignment to be inspected
+                                                                   const alignment::size_type &prm_entry_a,   ///< The first entry of interest
+                                                                   const alignment::size_type &prm_entry_b    ///< The second entry of interest
+                                                                   ) {
+	if ( prm_entry_a >= prm_alignment.num_entries() || prm_entry_b >= prm_alignment.num_entries() ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Entry argument is greater than or equal to the number of entries being aligned"));
+	}
+	size_vec both_present_indices;
+	for (const size_t &index_ctr : indices( prm_alignment.length() ) ) {
+		if ( is_present_compact_posn( prm_alignment.compact_position_of_entry_of_index( prm_entry_a, index_ctr ) )
+		     && is_present_compact_posn( prm_alignment.compact_position_of_entry_of_index( prm_entry_b, index_ctr ) ) ) {
+			both_present_indices.push_back( index_ctr );
+		}
+	}
+	return both_present_indices;
+}
+
+/// \brief Get the pairs of positions of the two specified entries at each of the specified indices in the specified alignment
+///
+/// \pre Both entries must have present positions at each of the specified indices,
+///      else an invalid_argument_exception will be thrown
+///
+/// \relates alignment
+size_size_pair_vec cath::align::positions_of_both_entries_at_indices(const alignment            &prm_alignment, ///< The alignment to be inspected
+                                                                     const alignment::size_type &prm_entry_a,   ///< The first entry of interest
+                                                                     const alignment::size_type &prm_entry_b,   ///< The second entry of interest
+                                                                     const size_vec             &prm_indices    ///< The indices at which the positions should be retrieved
+                                                                     ) {
+	size_size_pair_vec positions_pairs;
+	positions_pairs.reserve( prm_indices.size() );
+	for (const size_t &index : prm_indices) {
+		const compact_aln_posn_type position_a = prm_alignment.compact_position_of_entry_of_index( prm_entry_a, index );
+		const compact_aln_posn_type position_b = prm_alignment.compact_position_of_entry_of_index( prm_entry_b, index );
+		if ( ! is_present_compact_posn( position_a ) || ! is_present_compact_posn( position_b ) ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception(
+				"Cannot get positions of both entries at index "
+				+ lexical_cast<string>( index )
+				+ " because at least one of them is absent"
+			));
+		}
+		positions_pairs.emplace_back( position_a, position_b );
+	}
+	return positions_pairs;
 }
 
 /// \brief Return the entries that have present positions within the specified range in the specified alignment
@@ -502,7 +568,10 @@ size_vec cath::align::entries_present_in_index_range(const alignment &prm_alignm
 size_t cath::align::num_present_positions_of_index(const alignment            &prm_alignment, ///< TODOCUMENT
                                                    const alignment::size_type &prm_index      ///< TODOCUMENT
                                                    ) {
-	return entries_present_at_index( prm_alignment, prm_index ).size();
+	return numeric_cast<size_t>( count_if(
+		prm_alignment.compact_positions_of_index( prm_index ),
+		[] (const compact_aln_posn_type &x) { return is_present_compact_posn( x ); }
+	) );
 }
 
 /// \brief TODOCUMENT
@@ -597,12 +666,7 @@ size_t cath::align::num_present_positions_of_both_entries(const alignment
                                                           const alignment::size_type &prm_entry_a,   ///< TODOCUMENT
                                                           const alignment::size_type &prm_entry_b    ///< TODOCUMENT
                                                           ) {
-	return numeric_cast<size_t>( count_if(
-		indices( prm_alignment.length() ),
-		[&] (const size_t &x) {
-			return has_position_of_both_entries_of_index( prm_alignment, prm_entry_a, prm_entry_b, x );
-		}
-	) );
+	return indices_of_present_positions_of_both_entries( prm_alignment, prm_entry_a, prm_entry_b ).size();
 }
 
 /// \brief TODOCUMENT
@@ -613,7 +677,7 @@ size_t cath::align::num_present_positions_of_all_entries(const alignment &prm_al
 	return numeric_cast<size_t>( count_if(
 		indices( prm_alignment.length() ),
 		[&] (const size_t &x) {
-			return has_position_of_all_entries_of_index( prm_alignment, x );
+			return all_of( prm_alignment.compact_positions_of_index( x ), is_present_compact_posn );
 		}
 	) );
 }
@@ -23,6 +23,7 @@
 
 #include <boost/operators.hpp>
 #include <boost/optional.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include "alignment/align_type_aliases.hpp"
 #include "alignment/residue_score/alignment_residue_scores.hpp"
@@ -30,6 +31,7 @@
 
 #include <cstddef>
 #include <iosfwd>
+#include <limits>
 
 namespace cath { namespace align { class alignment_row; } }
 namespace cath { namespace file { class backbone_complete_indices; } }
@@ -38,6 +40,9 @@ namespace cath { namespace file { using backbone_complete_indices_vec = std::vec
 namespace cath {
 	namespace align {
 
+		/// \brief Type alias for a const range over compact_aln_posn_type values
+		using compact_aln_posn_crange = boost::iterator_range<compact_aln_posn_vec::const_iterator>;
+
 		/// \brief TODOCUMENT
 		///
 		/// There is one score for each position (which is how both SSAP and CORA score alignments)
@@ -59,19 +64,28 @@ namespace cath {
 		///
 		/// It's useful to allow an alignment with one entry so that cath-superpose doesn't
 		/// have to treat that as a special case.
+		///
+		/// The positions are stored in one contiguous buffer of compact_aln_posn_type values
+		/// (with absent positions stored as ABSENT_POSN), arranged index by index so that all
+		/// the positions of one index are adjacent. This keeps large multiple alignments small
+		/// and makes it cheap to scan along the alignment: code that wants to do that should prefer
+		/// the bulk accessors (eg compact_positions_of_index(), indices_of_present_positions_of_both_entries())
+		/// over repeated calls to position_of_entry_of_index().
 		class alignment final : private boost::equality_comparable<alignment> {
 		public:
 			/// \brief TODOCUMENT
 			using size_type = size_vec_vec::size_type;
 
 		private:
-//			bool_deq_vec     position_presences;
-//			aln_posn_vec_vec old_positions;
+			/// \brief The positions, index by index, with ABSENT_POSN for any absent positions
+			///
+			/// The position of entry e at index i is at positions[ i * num_entries() + e ]
+			compact_aln_posn_vec positions;
 
-			/// \brief TODOCUMENT
-			aln_posn_opt_vec_vec positions;
+			/// \brief The number of entries being aligned
+			size_type entry_count;
 
-			/// \brief TODOCUMENT
+			/// \brief The number of indices in the alignment
 			size_type logical_length;
 
 			/// \brief TODOCUMENT
@@ -83,7 +97,7 @@ namespace cath {
 			void check_entry_in_range(const size_type &) const;
 			void check_index_in_range(const size_type &) const;
 
-			size_type reserved_length() const;
+			void extend_to_index(const size_type &);
 
 		public:
 			explicit alignment(const size_type &);
@@ -100,6 +114,11 @@ namespace cath {
 			aln_posn_opt position_of_entry_of_index(const size_type &,
 			                                        const size_type &) const;
 
+			compact_aln_posn_type compact_position_of_entry_of_index(const size_type &,
+			                                                         const size_type &) const;
+
+			compact_aln_posn_crange compact_positions_of_index(const size_type &) const;
+
 			void set_position_value(const size_type &,
 			                        const size_type &,
 			                        const aln_posn_type &);
@@ -116,8 +135,19 @@ namespace cath {
 			static constexpr size_type PAIR_A_IDX = 0;
 			/// \brief A constant for the index of the B entry (1) in a pair alignment
 			static constexpr size_type PAIR_B_IDX = 1;
+
+			/// \brief The value used to store an absent position
+			static constexpr compact_aln_posn_type ABSENT_POSN = std::numeric_limits<compact_aln_posn_type>::max();
 		};
 
+		/// \brief Whether the specified compact position (as stored in an alignment) represents a present position
+		///
+		/// \relates alignment
+		inline constexpr bool is_present_compact_posn(const compact_aln_posn_type &prm_compact_posn ///< The compact position to query
+		                                              ) {
+			return ( prm_compact_posn != alignment::ABSENT_POSN );
+		}
+
 		size_size_pair_opt first_non_consecutive_entry_positions(const alignment &);
 
 		void check_entry_positions_are_consecutive(const alignment &);
@@ -155,6 +185,15 @@ namespace cath {
 		size_vec entries_present_at_index(const alignment &,
 		                                  const alignment::size_type &);
 
+		size_vec indices_of_present_positions_of_both_entries(const alignment &,
+		                                                      const alignment::size_type &,
+		                                                      const alignment::size_type &);
+
+		size_size_pair_vec positions_of_both_entries_at_indices(const alignment &,
+		                                                        const alignment::size_type &,
+		                                                        const alignment::size_type &,
+		                                                        const size_vec &);
+
 		size_vec entries_present_in_index_range(const alignment &,
 		                                        const size_t &,
 		                                        const size_t &);
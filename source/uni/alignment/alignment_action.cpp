@@ -114,6 +114,7 @@ alignment cath::align::glue_two_alignments(const alignment &prm_alignment_a,
 	// Create a new alignment with one fewer than the sum of the number of entries in the two alignments
 	// (because two entries, one in each alignment, will be identified to make one new entry)
 	alignment new_alignment( num_entries_in_a + num_entries_in_b - 1 );
+	new_alignment.reserve( length_a + length_b );
 
 	// Loop down the two alignments until the end of both has been reached,
 	// keeping track of the position in the two alignments and the position in the entry being identified ("glue_ctr")
@@ -57,22 +57,23 @@ alignment_coord_extractor::residue_cref_residue_cref_pair_vec alignment_coord_ex
 	// Use the common_residue_selection_policy to determine which indices to grab
 	const vector<aln_size_type> selection_aln_indices = prm_res_seln_policy.select_common_residues(prm_alignment, prm_entry_index_a, prm_entry_index_b);
 
-	// TODOCUMENT
-	for (const aln_size_type &alignment_index : selection_aln_indices) {
-		const bool aln_has_posn_for_first_entry(  has_position_of_entry_of_index( prm_alignment, prm_entry_index_a, alignment_index) );
-		const bool aln_has_posn_for_second_entry( has_position_of_entry_of_index( prm_alignment, prm_entry_index_b, alignment_index) );
-		if ( ! aln_has_posn_for_first_entry || ! aln_has_posn_for_second_entry ) {
-			BOOST_THROW_EXCEPTION(runtime_error_exception("Unable to retrieve both entries for alignment index selected by common_residue_selection_policy"));
-		}
-	}
+	// Grab the positions of both entries at each of the selected indices
+	// (this throws if the common_residue_selection_policy has selected an index without positions for both entries)
+	const size_size_pair_vec positions_pairs = positions_of_both_entries_at_indices(
+		prm_alignment,
+		prm_entry_index_a,
+		prm_entry_index_b,
+		selection_aln_indices
+	);
 
 	// Fill array with coordinates
 	residue_cref_residue_cref_pair_vec residues;
-	for (const aln_size_type &alignment_index : selection_aln_indices) {
-		const aln_posn_type a_position = get_position_of_entry_of_index( prm_alignment, prm_entry_index_a, alignment_index );
-		const aln_posn_type b_position = get_position_of_entry_of_index( prm_alignment, prm_entry_index_b, alignment_index );
-		const residue      &residue_a  = prm_protein_a.get_residue_ref_of_index( a_position );
-		const residue      &residue_b  = prm_protein_b.get_residue_ref_of_index( b_position );
+	residues.reserve( positions_pairs.size() );
+	for (const size_size_pair &positions_pair : positions_pairs) {
+		const aln_posn_type &a_position = positions_pair.first;
+		const aln_posn_type &b_position = positions_pair.second;
+		const residue       &residue_a  = prm_protein_a.get_residue_ref_of_index( a_position );
+		const residue       &residue_b  = prm_protein_b.get_residue_ref_of_index( b_position );
 
 //		if ( ! residue_a.get_pdb_name_number() &&  ! residue_b.get_pdb_name_number() ) {
 //			BOOST_THROW_EXCEPTION(runtime_error_exception(
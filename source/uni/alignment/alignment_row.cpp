@@ -26,11 +26,14 @@
 #include "common/boost_addenda/range/indices.hpp"
 #include "common/exception/invalid_argument_exception.hpp"
 
+#include <utility>
+
 using namespace cath::align;
 using namespace cath::common;
 using namespace std;
 
 using boost::lexical_cast;
+using boost::none;
 
 /// \brief Sanity check the specified entry value is within the range given the current number of entries
 ///        and throw an exception if not
@@ -136,14 +139,13 @@ alignment_row cath::align::get_row_of_entries_of_alignment(const alignment &prm_
                                                            const size_vec  &prm_entries,   ///< TODOCUMENT
                                                            const size_t    &prm_index      ///< TODOCUMENT
                                                            ) {
-	const size_t num_entries = prm_entries.size();
 	aln_posn_opt_vec positions;
-	positions.reserve( num_entries );
+	positions.reserve( prm_entries.size() );
 	for (const size_t &entry : prm_entries) {
-		const aln_posn_opt position = prm_alignment.position_of_entry_of_index( entry, prm_index );
-		positions.push_back( position );
+		const compact_aln_posn_type position = prm_alignment.compact_position_of_entry_of_index( entry, prm_index );
+		positions.push_back( is_present_compact_posn( position ) ? aln_posn_opt( position ) : aln_posn_opt( none ) );
 	}
-	return alignment_row( positions );
+	return alignment_row( std::move( positions ) );
 }
 
 /// \brief TODOCUMENT
@@ -152,14 +154,13 @@ alignment_row cath::align::get_row_of_entries_of_alignment(const alignment &prm_
 alignment_row cath::align::get_row_of_alignment(const alignment &prm_alignment, ///< TODOCUMENT
                                                 const size_t    &prm_index      ///< TODOCUMENT
                                                 ) {
-	const size_t num_entries = prm_alignment.num_entries();
+	const compact_aln_posn_crange aln_positions = prm_alignment.compact_positions_of_index( prm_index );
 	aln_posn_opt_vec positions;
-	positions.reserve( num_entries );
-	for (const size_t &entry_ctr : indices( num_entries ) ) {
-		const aln_posn_opt position = prm_alignment.position_of_entry_of_index( entry_ctr, prm_index );
-		positions.push_back( position );
+	positions.reserve( aln_positions.size() );
+	for (const compact_aln_posn_type &position : aln_positions) {
+		positions.push_back( is_present_compact_posn( position ) ? aln_posn_opt( position ) : aln_posn_opt( none ) );
 	}
-	return alignment_row( positions );
+	return alignment_row( std::move( positions ) );
 }
 
 /// \brief TODOCUMENT
@@ -379,6 +379,56 @@ BOOST_AUTO_TEST_CASE(entries_present_in_index_range_works) {
 	BOOST_CHECK_EQUAL_RANGES( entries_present_in_index_range( the_aln, 2, 5 ), size_vec{ 0, 1 } );
 }
 
+BOOST_AUTO_TEST_CASE(compact_positions_of_index_works) {
+	const auto the_aln = alignment_of_scaffold_lines( {
+		"  XXXX",
+		"XX  XX"
+	} );
+
+	BOOST_CHECK_THROW( the_aln.compact_positions_of_index( 6 ), invalid_argument_exception );
+
+	BOOST_CHECK_EQUAL_RANGES( the_aln.compact_positions_of_index( 0 ), compact_aln_posn_vec{ alignment::ABSENT_POSN, 0                       } );
+	BOOST_CHECK_EQUAL_RANGES( the_aln.compact_positions_of_index( 3 ), compact_aln_posn_vec{ 1,                       alignment::ABSENT_POSN } );
+	BOOST_CHECK_EQUAL_RANGES( the_aln.compact_positions_of_index( 5 ), compact_aln_posn_vec{ 3,                       3                      } );
+}
+
+BOOST_AUTO_TEST_CASE(rejects_position_too_large_to_store) {
+	alignment the_aln( 1 );
+	BOOST_CHECK_THROW( the_aln.set_position_value( 0, 0, alignment::ABSENT_POSN ), invalid_argument_exception );
+	BOOST_CHECK_EQUAL( the_aln.length(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE(indices_of_present_positions_of_both_entries_works) {
+	const auto the_aln = alignment_of_scaffold_lines( {
+		"  XXXX",
+		"XX  XX"
+	} );
+
+	BOOST_CHECK_THROW( indices_of_present_positions_of_both_entries( the_aln, 0, 2 ), invalid_argument_exception );
+
+	BOOST_CHECK_EQUAL_RANGES( indices_of_present_positions_of_both_entries( the_aln, 0, 1 ), size_vec{ 4, 5             } );
+	BOOST_CHECK_EQUAL_RANGES( indices_of_present_positions_of_both_entries( the_aln, 1, 1 ), size_vec{ 0, 1, 4, 5       } );
+	BOOST_CHECK_EQUAL       ( num_present_positions_of_both_entries       ( the_aln, 0, 1 ), 2                            );
+}
+
+BOOST_AUTO_TEST_CASE(positions_of_both_entries_at_indices_works) {
+	const auto the_aln = alignment_of_scaffold_lines( {
+		"  XXXX",
+		"XX  XX"
+	} );
+
+	BOOST_CHECK_THROW( positions_of_both_entries_at_indices( the_aln, 0, 1, { 3 } ), invalid_argument_exception );
+
+	BOOST_CHECK_EQUAL_RANGES(
+		positions_of_both_entries_at_indices( the_aln, 0, 1, { 4, 5 } ),
+		size_size_pair_vec{ { 2, 2 }, { 3, 3 } }
+	);
+	BOOST_CHECK_EQUAL_RANGES(
+		positions_of_both_entries_at_indices( the_aln, 1, 0, { 5 } ),
+		size_size_pair_vec{ { 3, 3 } }
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -22,14 +22,12 @@
 
 #include <boost/assign/ptr_list_inserter.hpp>
 #include <boost/lexical_cast.hpp>
-#include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/irange.hpp>
 
 #include "alignment/alignment.hpp"
 #include "alignment/common_residue_selection_policy/common_residue_select_all_policy.hpp"
 #include "alignment/common_residue_selection_policy/common_residue_select_best_score_percent_policy.hpp"
 #include "alignment/common_residue_selection_policy/common_residue_select_min_score_policy.hpp"
-#include "common/algorithm/copy_build.hpp"
-#include "common/boost_addenda/range/indices.hpp"
 #include "common/clone/check_uptr_clone_against_this.hpp"
 #include "common/cpp14/make_unique.hpp"
 #include "common/exception/invalid_argument_exception.hpp"
@@ -40,7 +38,6 @@ using namespace cath::align;
 using namespace cath::common;
 using namespace std;
 
-using boost::adaptors::filtered;
 using boost::assign::ptr_push_back;
 using boost::irange;
 using boost::lexical_cast;
@@ -70,18 +67,7 @@ vector<alignment::size_type> common_residue_selection_policy::select_common_resi
 	}
 
 	// Grab the indices of the positions that are in common between the entries prm_entry_a and prm_entry_b
-	const auto original_indices = copy_build<aln_size_vec>(
-		indices( prm_alignment.length() )
-			| filtered(
-				[&] (const size_t &x) {
-					return (
-						has_position_of_entry_of_index( prm_alignment, prm_entry_a, x )
-						&&
-						has_position_of_entry_of_index( prm_alignment, prm_entry_b, x )
-					);
-				}
-			)
-	);
+	const aln_size_vec original_indices = indices_of_present_positions_of_both_entries( prm_alignment, prm_entry_a, prm_entry_b );
 
 	// Grab the results from the concrete class's implementation of the do_select_common_residues() method
 	const size_vec common_coords_raw = do_select_common_residues(
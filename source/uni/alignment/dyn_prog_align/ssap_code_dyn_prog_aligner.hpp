@@ -21,11 +21,23 @@
 #ifndef _CATH_TOOLS_SOURCE_UNI_ALIGNMENT_DYN_PROG_ALIGN_SSAP_CODE_DYN_PROG_ALIGNER_HPP
 #define _CATH_TOOLS_SOURCE_UNI_ALIGNMENT_DYN_PROG_ALIGN_SSAP_CODE_DYN_PROG_ALIGNER_HPP
 
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/irange.hpp>
 #include <boost/tuple/tuple.hpp>
 
+#include "alignment/alignment.hpp"
 #include "alignment/dyn_prog_align/dyn_prog_aligner.hpp"
+#include "alignment/gap/gap_penalty.hpp"
+#include "common/boost_addenda/range/indices.hpp"
+#include "common/debug_numeric_cast.hpp"
+#include "common/exception/not_implemented_exception.hpp"
 #include "common/type_aliases.hpp"
 
+#include <limits>
+#include <tuple>
+#include <utility>
+
 namespace cath {
 	namespace align {
 		class alignment;
@@ -45,7 +57,10 @@ namespace cath {
 			                                                 int,
 			                                                 score_type>;
 
-			static size_size_int_int_score_tuple score_matrix(const dyn_prog_score_source &,
+			template <typename FN>
+			static size_size_int_int_score_tuple score_matrix(const FN &,
+			                                                  const size_t &,
+			                                                  const size_t &,
 			                                                  const score_type &,
 			                                                  const size_type &,
 			                                                  int_vec_vec &);
@@ -70,7 +85,276 @@ namespace cath {
 			score_alignment_pair do_align(const dyn_prog_score_source &,
 			                              const gap::gap_penalty &,
 			                              const size_type &) const final;
+
+		public:
+			template <typename FN>
+			static score_alignment_pair align_with_score_fn(const FN &,
+			                                                const size_t &,
+			                                                const size_t &,
+			                                                const gap::gap_penalty &,
+			                                                const size_type &);
 		};
+
+		/// \brief Determines the best pathways through the upper and lower score matrices
+		///        using the Needleman and Wunsch dynamic programming algorithm
+		///
+		/// This finds the best pathway through the matrix and returns that alignment along with the score.
+		///
+		/// \todo Continue sorting out this nightmare of a subroutine, which was a huge violator of the
+		///       Dependency Inversion Principle (http://en.wikipedia.org/wiki/Dependency_inversion_principle)
+		///       but which has gotten a bit simpler since populate_upper_score_matrix() was separated out.
+		///
+		/// Notes on trying to figure this out (~September 2013)
+		/// ====================================================
+		///
+		/// Overview
+		/// --------
+		///
+		/// This currently operates on the upper and lower matrices.
+		/// It doesn't store its own score matrix, it just retrieves values as it needs them.
+		///
+		/// Organisation of dynamic programming (DP)
+		/// ----------------------------------------
+		///
+		/// The dynamic programming (DP) code nomenclature considers the matrix of a versus b scores
+		/// to be laid out like this:
+		///
+		///             ---b-->
+		///          + + + + + + +
+		///       |  + + + + + + +
+		///       a  + + + + + + +
+		///       |  + + + + + + +
+		///       V  + + + + + + +
+		///          + + + + + + +
+		///
+		/// Both dimensions (currently) use an offset of 1, ie they're labelled from 1 to length (inclusive).
+		///
+		/// Note that the actual matrix is indexed by b and then a (which I think someone has done
+		/// in the past to make existing indexing errors less catastrophic) but just ignore this when
+		/// considering rows/columns.
+		/// \todo Rectify this as part of moving to use a windowed matrix class
+		///
+		/// The DP code sweeps from bottom-right to top-left, working up each column before moving
+		/// one column to the left. Since the matrix is typically windowed, the sweep up each column
+		/// may only cover a sub-strip of the cells.
+		///
+		/// Still fairly opaque:
+		/// --------------------
+		///
+		/// It is not clear how the following variables are used.
+		///  - enter
+		///  - rat
+		///
+		///
+		///
+		template <typename FN>
+		ssap_code_dyn_prog_aligner::size_size_int_int_score_tuple ssap_code_dyn_prog_aligner::score_matrix(const FN         &prm_score_fn,     ///< The function returning the score for a pair of entries (indexed with offset 1)
+		                                                                                                   const size_t     &prm_length_a,     ///< The number of entries in the first  sequence
+		                                                                                                   const size_t     &prm_length_b,     ///< The number of entries in the second sequence
+		                                                                                                   const score_type &prm_gap_penalty,  ///< The gap penalty to be applied for each gap step (ie for opening OR extending a gap)
+		                                                                                                   const size_type  &prm_window_width, ///< TODOCUMENT
+		                                                                                                   int_vec_vec      &prm_path_matrix   ///< TODOCUMENT
+		                                                                                                   ) {
+			const score_type  VERY_POOR_SCORE    = std::numeric_limits<score_type>::min() / 10;
+			score_type        best_score         = VERY_POOR_SCORE;
+			size_t            flip_flop_current  = 0;
+			size_t            flip_flop_previous = 1;
+			size_t            mat_a              = 0;
+			size_t            mat_b              = 0;
+			int               final_path_a       = 0;
+			int               final_path_b       = 0;
+			int               enter              = 0;
+			bool              edge_set           = false;
+
+			// (These working vectors are static to reuse their memory but thread_local so that SSAPs can run concurrently)
+
+			// The best scores...???
+			/// \todo Are the +2s necessary?
+			static thread_local score_vec best_scores_in_column;
+			best_scores_in_column.assign( prm_window_width + 2, 0 );
+
+			// The indices corresponding to the best scores...???
+			/// \todo Are the +2s necessary?
+			static thread_local size_vec indices_of_best_scores_in_column;
+			indices_of_best_scores_in_column.assign( prm_window_width + 2, 0 );
+
+			// Matrix to store row scores in a flip-flop fashion (ie two sets of values: one active; one inactive)
+			/// \todo Are the +2s necessary?
+			static thread_local score_vec_vec row_scores_flipflop_matrix;
+			row_scores_flipflop_matrix.assign( 2, score_vec( prm_window_width + 2, VERY_POOR_SCORE ) );
+
+			// Initialise various variable for the right-most column
+			for (const size_t &a_dest_to_index : common::indices( prm_window_width + 2 ) ) {
+				row_scores_flipflop_matrix[ 0 ][ a_dest_to_index ] = VERY_POOR_SCORE;
+				row_scores_flipflop_matrix[ 1 ][ a_dest_to_index ] = VERY_POOR_SCORE;
+				prm_path_matrix[ a_dest_to_index ][ prm_length_b ]     = 0;
+				best_scores_in_column[ a_dest_to_index ]           = VERY_POOR_SCORE;
+			}
+
+			// Compare each element in protein B with each element in protein A within window
+			for (const size_t &ctr_b : common::indices( prm_length_b ) | boost::adaptors::reversed ) {
+				const size_t ctr_b__offset_1  = ctr_b + 1;
+				score_type best_row_score = VERY_POOR_SCORE;
+				size_t     best_row_index = 0;
+
+				// Set pointer to element in protein B
+				const size_t window_start__offset_1 = get_window_start_a_for_b__offset_1( prm_length_a, prm_length_b, prm_window_width, ctr_b__offset_1 );
+				const size_t window_stop__offset_1  = get_window_stop_a_for_b__offset_1 ( prm_length_a, prm_length_b, prm_window_width, ctr_b__offset_1 );
+
+				// Set window range, if comparing residues, window is set by selected residues
+				if ( --enter < 0 ) {
+					enter = debug_numeric_cast<int>(prm_window_width) - 1;
+				}
+
+				if ( window_stop__offset_1 == prm_length_a ) {
+					prm_path_matrix[prm_length_a - window_start__offset_1][ctr_b__offset_1] = 0;
+				}
+
+				for (const size_t &ctr_a : boost::irange( window_start__offset_1 - 1, window_stop__offset_1 ) | boost::adaptors::reversed ) {
+					const size_t ctr_a__offset_1 = ctr_a + 1;
+					const int a_matrix_idx = get_window_matrix_a_index__offset_1(prm_length_a, prm_length_b, prm_window_width, ctr_a__offset_1, ctr_b__offset_1);
+					int       rat          = enter + a_matrix_idx;
+
+		//			cerr << "Getting score from " << ctr_a__offset_1 << " (os1) and " << ctr_b__offset_1 << " (os1) : " << prm_score_fn( ctr_a__offset_1, ctr_b__offset_1 ) << endl;
+					row_scores_flipflop_matrix[flip_flop_current][ boost::numeric_cast<size_t>( a_matrix_idx ) ] = prm_score_fn( ctr_a__offset_1, ctr_b__offset_1 );
+
+					if ( ctr_a__offset_1 == prm_length_a || ctr_b__offset_1 == prm_length_b ) {
+						continue;
+					}
+
+					// ACCUMULATING MATRIX
+
+					// Adjust rat index and window edge
+					if ( rat < 0 ) {
+						rat += debug_numeric_cast<int>(prm_window_width);
+					}
+					if ( rat >= debug_numeric_cast<int>(prm_window_width) ) {
+						rat -= debug_numeric_cast<int>(prm_window_width);
+					}
+					if (ctr_a__offset_1 == window_start__offset_1 && !edge_set) {
+						best_scores_in_column           [ boost::numeric_cast<size_t>( rat ) ] = VERY_POOR_SCORE;
+						indices_of_best_scores_in_column[ boost::numeric_cast<size_t>( rat ) ] = ctr_b__offset_1;
+						if ( ctr_a__offset_1 == 1 ) {
+							edge_set = true;
+						}
+					}
+
+					// Set diagonal score and maximum row and column scores
+					const score_type best_col_score = best_scores_in_column           [ boost::numeric_cast<size_t>( rat ) ];
+					const size_t     best_col_index = indices_of_best_scores_in_column[ boost::numeric_cast<size_t>( rat ) ];
+
+					const score_type diag_score     = row_scores_flipflop_matrix[flip_flop_previous][ boost::numeric_cast<size_t>( a_matrix_idx ) ];
+					const score_type col_score      = best_col_score - prm_gap_penalty;
+					const score_type row_score      = best_row_score - prm_gap_penalty;
+
+					// If diagonal cell score greater than max score from row or column - penalty,
+					// accumulate diagonal score
+					if ( diag_score >= col_score && diag_score >= row_score ) {
+						row_scores_flipflop_matrix[flip_flop_current][ boost::numeric_cast<size_t>( a_matrix_idx ) ] += diag_score;
+						prm_path_matrix[ boost::numeric_cast<size_t>( a_matrix_idx ) ][ctr_b__offset_1]                         = 1;
+					}
+					// Else if row score is better than column score, accumulate maximum score from row
+					else if ( row_score > col_score ) {
+						row_scores_flipflop_matrix[flip_flop_current][ boost::numeric_cast<size_t>( a_matrix_idx ) ] +=   row_score;
+						prm_path_matrix[ boost::numeric_cast<size_t>( a_matrix_idx ) ][ctr_b__offset_1]                         =   boost::numeric_cast<int>( best_row_index - ctr_a__offset_1 + 1 );
+					}
+					// Else accumulate maximum score from column
+					else {
+						row_scores_flipflop_matrix[flip_flop_current][ boost::numeric_cast<size_t>( a_matrix_idx ) ] +=   col_score;
+						prm_path_matrix[ boost::numeric_cast<size_t>( a_matrix_idx ) ][ctr_b__offset_1]                         = - boost::numeric_cast<int>( best_col_index - ctr_b__offset_1 + 1 );
+					}
+
+					// If diagonal score greater than previous maximum for row or column, save
+					if (diag_score > best_row_score) {
+						best_row_score = diag_score;
+						best_row_index = ctr_a__offset_1;
+					}
+					if (diag_score > best_col_score) {
+						best_scores_in_column[ boost::numeric_cast<size_t>( rat ) ]            = diag_score;
+						indices_of_best_scores_in_column[ boost::numeric_cast<size_t>( rat ) ] = ctr_b__offset_1;
+					}
+
+					// Save highest score in matrix and cell coordinates
+					if ( row_scores_flipflop_matrix[flip_flop_current][ boost::numeric_cast<size_t>( a_matrix_idx ) ] >= best_score ) {
+						best_score   = row_scores_flipflop_matrix[flip_flop_current][ boost::numeric_cast<size_t>( a_matrix_idx ) ];
+						final_path_a = a_matrix_idx;
+						final_path_b = boost::numeric_cast<int>( ctr_b__offset_1 );
+						mat_a        = 1;
+						mat_b        = 1;
+						if ( ctr_a__offset_1 == 1 ) {
+							mat_b = ctr_b__offset_1;
+						}
+						if ( ctr_b__offset_1 == 1 ) {
+							mat_a = ctr_a__offset_1;
+						}
+					}
+				}
+				std::swap(flip_flop_current, flip_flop_previous);
+			}
+
+			return std::make_tuple(
+				mat_a,
+				mat_b,
+				final_path_a,
+				final_path_b,
+				best_score
+			);
+		}
+
+		/// \brief Align using a score function rather than a dyn_prog_score_source
+		///
+		/// This performs the same alignment as align() would on a dyn_prog_score_source
+		/// returning the same scores but, because the score function's type is known at compile-time,
+		/// the per-cell scoring can be inlined into the dynamic-programming loops rather than
+		/// going through a virtual call for each cell.
+		///
+		/// The score function is called with the indices of the two entries (using offset 1)
+		/// and should return the score_type score for that pair.
+		template <typename FN>
+		score_alignment_pair ssap_code_dyn_prog_aligner::align_with_score_fn(const FN               &prm_score_fn,     ///< The function returning the score for a pair of entries (indexed with offset 1)
+		                                                                     const size_t           &prm_length_a,     ///< The number of entries in the first  sequence
+		                                                                     const size_t           &prm_length_b,     ///< The number of entries in the second sequence
+		                                                                     const gap::gap_penalty &prm_gap_penalty,  ///< The gap penalty to be applied for each gap step (ie for opening OR extending a gap)
+		                                                                     const size_type        &prm_window_width  ///< TODOCUMENT
+		                                                                     ) {
+			if (prm_gap_penalty.get_extend_gap_penalty() != 0) {
+				BOOST_THROW_EXCEPTION(common::not_implemented_exception("ssap_code_dyn_prog_aligner unable to handle non-zero extend_gap_penalty"));
+			}
+
+			// Matrix to store the first step in the best path from each cell to the bottom right of the matrix
+			/// \todo Are the +2s necessary?
+			/// \todo Is the +1 necessary?
+			static thread_local int_vec_vec path_matrix;
+			path_matrix.assign( prm_window_width + 2, int_vec( prm_length_b + 1, 0 ) );
+
+			// Score the matrix and hence build up a matrix of the best path back
+			const size_size_int_int_score_tuple score_nums = score_matrix(
+				prm_score_fn,
+				prm_length_a,
+				prm_length_b,
+				prm_gap_penalty.get_open_gap_penalty(),
+				prm_window_width,
+				path_matrix
+			);
+			const size_t     &mat_a        = std::get<0>( score_nums );
+			const size_t     &mat_b        = std::get<1>( score_nums );
+			const int        &final_path_a = std::get<2>( score_nums );
+			const int        &final_path_b = std::get<3>( score_nums );
+			const score_type &best_score   = std::get<4>( score_nums );
+
+			// Trace back through matrix from highest scoring cell
+			alignment new_alignment = traceback(
+				prm_length_a,
+				prm_length_b,
+				static_cast<int>( mat_a ),
+				static_cast<int>( mat_b ),
+				final_path_a,
+				final_path_b,
+				path_matrix
+			);
+
+			return std::make_pair( best_score, new_alignment );
+		}
 	} // namespace align
 } // namespace cath
 
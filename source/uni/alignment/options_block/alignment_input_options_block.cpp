@@ -63,9 +63,15 @@ const string alignment_input_options_block::PO_SSAP_SCORE_INFILE { "ssap-scores-
 /// \brief The option name for a directory in which to do the necessary SSAPs and then use the scores to glue the resulting alignments together
 const string alignment_input_options_block::PO_DO_THE_SSAPS      { "do-the-ssaps"       };
 
+/// \brief The option name for the number of cheap-scan-ranked neighbours of each structure with which to do the SSAPs
+const string alignment_input_options_block::PO_DO_THE_SSAPS_NEIGHBOURS{ "do-the-ssaps-neighbours" };
+
 /// \brief The option name for how much refining should be done to the alignment
 const string alignment_input_options_block::PO_REFINING          { "align-refining"     };
 
+/// \brief The option name for the number of threads over which to spread the refining's scoring
+const string alignment_input_options_block::PO_REFINING_NUM_THREADS{ "align-refining-threads" };
+
 /// \brief A standard do_clone method.
 unique_ptr<options_block> alignment_input_options_block::do_clone() const {
 	return { make_uptr_clone( *this ) };
@@ -84,6 +90,7 @@ void alignment_input_options_block::do_add_visible_options_to_description(option
 	const auto &sub_sep = SUB_DESC_PAIR_SEPARATOR;
 
 	const string dir_varname      { "<dir>"  };
+	const string num_varname      { "<num>"  };
 	const string file_varname     { "<file>" };
 	const string refining_varname { "<refn>" };
 
@@ -95,7 +102,9 @@ void alignment_input_options_block::do_add_visible_options_to_description(option
 	const auto do_the_ssaps_notifier         = [&] (const path           &x) {
 		the_alignment_input_spec.set_do_the_ssaps_dir( make_optional_if( x != path{}, x ) );
 	};
+	const auto do_the_ssaps_nbrs_notifier    = [&] (const size_t         &x) { the_alignment_input_spec.set_do_the_ssaps_neighbours( x ); };
 	const auto refining_notifier             = [&] (const align_refining &x) { the_alignment_input_spec.set_refining            ( x ); };
+	const auto refining_threads_notifier     = [&] (const size_t         &x) { the_alignment_input_spec.set_refining_num_threads( x ); };
 
 	prm_desc.add_options()
 		(
@@ -139,8 +148,16 @@ void alignment_input_options_block::do_add_visible_options_to_description(option
 				->value_name    ( dir_varname                   )
 				->notifier      ( do_the_ssaps_notifier         )
 				->implicit_value( path{}                        ),
-			( "Do the required SSAPs in directory " + dir_varname + "; use results as with --" + PO_SSAP_SCORE_INFILE + "\n"
-				"Use a suitable temp directory if none is specified" ).c_str()
+			( "Do the required SSAPs (in parallel) and glue the alignments as with --" + PO_SSAP_SCORE_INFILE + "\n"
+				"Cache the SSAP results in directory " + dir_varname + " if one is specified" ).c_str()
+		)
+		(
+			PO_DO_THE_SSAPS_NEIGHBOURS.c_str(),
+			value<size_t>()
+				->value_name    ( num_varname                   )
+				->notifier      ( do_the_ssaps_nbrs_notifier    ),
+			( "Under --" + PO_DO_THE_SSAPS + ", only do the SSAPs between each structure and its " + num_varname + " nearest neighbours\n"
+				"(as ranked by a fast structural scan), plus any needed to connect all the structures" ).c_str()
 		);
 
 	// Create and add a sub-block for alignment refining
@@ -161,6 +178,15 @@ void alignment_input_options_block::do_add_visible_options_to_description(option
 			( "Apply " + refining_varname + " refining to the alignment" + ", one of available values:" + sep
 				+ join( refining_descs, sep ) + "\n"
 				+ "This can change the method of gluing alignments under --" + PO_SSAP_SCORE_INFILE + " and --" + PO_DO_THE_SSAPS ).c_str()
+		)
+		(
+			PO_REFINING_NUM_THREADS.c_str(),
+			value<size_t>()
+				->value_name    ( num_varname                                        )
+				->notifier      ( refining_threads_notifier                          )
+				->default_value ( alignment_input_spec::DEFAULT_REFINING_NUM_THREADS ),
+			( "Spread the scoring of each step of refining a complete alignment over " + num_varname + " threads (or 0 for one per hardware thread)\n"
+				"(the results are identical whatever the number of threads)" ).c_str()
 		);
 	prm_desc.add( sub_refine_desc );
 
@@ -174,6 +200,14 @@ str_opt alignment_input_options_block::do_invalid_string(const variables_map &/*
 	if ( get_num_acquirers( *this ) > 1 ) {
 		return "Cannot specify more than one alignment input"s;
 	}
+	if ( the_alignment_input_spec.get_do_the_ssaps_neighbours() ) {
+		if ( *the_alignment_input_spec.get_do_the_ssaps_neighbours() == 0 ) {
+			return "The number of --" + PO_DO_THE_SSAPS_NEIGHBOURS + " must be at least 1";
+		}
+		if ( get_num_acquirers( *this ) > 0 && ! the_alignment_input_spec.get_do_the_ssaps_dir() ) {
+			return "Cannot specify --" + PO_DO_THE_SSAPS_NEIGHBOURS + " with an alignment input other than --" + PO_DO_THE_SSAPS;
+		}
+	}
 	if ( ! the_alignment_input_spec.get_fasta_alignment_file().empty() && ! is_acceptable_input_file( the_alignment_input_spec.get_fasta_alignment_file()    ) ) {
 		return "FASTA alignment file " + the_alignment_input_spec.get_ssap_alignment_file().string() + " is not a valid input file";
 	}
@@ -198,7 +232,9 @@ str_vec alignment_input_options_block::do_get_all_options_names() const {
 		alignment_input_options_block::PO_CORA_ALIGN_INFILE,
 		alignment_input_options_block::PO_SSAP_SCORE_INFILE,
 		alignment_input_options_block::PO_DO_THE_SSAPS,
-		alignment_input_options_block::PO_REFINING
+		alignment_input_options_block::PO_DO_THE_SSAPS_NEIGHBOURS,
+		alignment_input_options_block::PO_REFINING,
+		alignment_input_options_block::PO_REFINING_NUM_THREADS
 	};
 }
 
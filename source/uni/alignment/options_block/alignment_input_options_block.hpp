@@ -49,7 +49,9 @@ namespace cath {
 			static const std::string PO_CORA_ALIGN_INFILE;
 			static const std::string PO_SSAP_SCORE_INFILE;
 			static const std::string PO_DO_THE_SSAPS;
+			static const std::string PO_DO_THE_SSAPS_NEIGHBOURS;
 			static const std::string PO_REFINING;
+			static const std::string PO_REFINING_NUM_THREADS;
 
 			alignment_input_options_block() = default;
 			explicit alignment_input_options_block(const align::align_refining &);
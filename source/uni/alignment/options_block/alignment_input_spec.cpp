@@ -37,6 +37,7 @@ using boost::range::count;
 using std::array;
 
 constexpr bool alignment_input_spec::DEFAULT_RESIDUE_NAME_ALIGN;
+constexpr size_t alignment_input_spec::DEFAULT_REFINING_NUM_THREADS;
 
 /// \brief Ctor from how much refining should be done to the alignment
 alignment_input_spec::alignment_input_spec(const align_refining &prm_refining ///< How much refining should be done to the alignment
@@ -74,11 +75,22 @@ const path_opt_opt & alignment_input_spec::get_do_the_ssaps_dir() const {
 	return do_the_ssaps_dir;
 }
 
+/// \brief Getter for the number of cheap-scan-ranked neighbours of each structure with which the SSAPs should be done
+///        or none to do the SSAPs between all pairs
+const size_opt & alignment_input_spec::get_do_the_ssaps_neighbours() const {
+	return do_the_ssaps_neighbours;
+}
+
 /// \brief Getter for how much refining should be done to the alignment
 const align_refining & alignment_input_spec::get_refining() const {
 	return refining;
 }
 
+/// \brief Getter for the number of threads over which to spread the refining's scoring (or 0 to use one per hardware thread)
+const size_t & alignment_input_spec::get_refining_num_threads() const {
+	return refining_num_threads;
+}
+
 /// \brief Setter for whether to align based on matching residue names
 alignment_input_spec & alignment_input_spec::set_residue_name_align(const bool &prm_residue_name_align ///< Whether to align based on matching residue names
                                                                     ) {
@@ -122,6 +134,14 @@ alignment_input_spec & alignment_input_spec::set_do_the_ssaps_dir(const path_opt
 	return *this;
 }
 
+/// \brief Setter for the number of cheap-scan-ranked neighbours of each structure with which the SSAPs should be done
+///        or none to do the SSAPs between all pairs
+alignment_input_spec & alignment_input_spec::set_do_the_ssaps_neighbours(const size_opt &prm_do_the_ssaps_neighbours ///< The number of cheap-scan-ranked neighbours of each structure with which the SSAPs should be done or none to do the SSAPs between all pairs
+                                                                         ) {
+	do_the_ssaps_neighbours = prm_do_the_ssaps_neighbours;
+	return *this;
+}
+
 /// \brief Setter for how much refining should be done to the alignment
 alignment_input_spec & alignment_input_spec::set_refining(const align_refining &prm_refining
                                                           ) {
@@ -129,6 +149,13 @@ alignment_input_spec & alignment_input_spec::set_refining(const align_refining &
 	return *this;
 }
 
+/// \brief Setter for the number of threads over which to spread the refining's scoring (or 0 to use one per hardware thread)
+alignment_input_spec & alignment_input_spec::set_refining_num_threads(const size_t &prm_refining_num_threads ///< The number of threads over which to spread the refining's scoring (or 0 to use one per hardware thread)
+                                                                      ) {
+	refining_num_threads = prm_refining_num_threads;
+	return *this;
+}
+
 /// \brief Get the number of alignment_acquirer objects that would be created by get_alignment_acquirers() on the specified alignment_input_spec
 ///
 /// \relates alignment_input_spec
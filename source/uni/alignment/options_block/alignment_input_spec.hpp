@@ -26,6 +26,7 @@
 
 #include "acquirer/alignment_acquirer/align_refining.hpp"
 #include "common/path_type_aliases.hpp"
+#include "common/type_aliases.hpp"
 
 namespace cath {
 	namespace opts {
@@ -58,9 +59,16 @@ namespace cath {
 			/// (rather than cath-tools choosing)
 			path_opt_opt do_the_ssaps_dir;
 
+			/// \brief The number of cheap-scan-ranked neighbours of each structure with which the SSAPs should be done
+			///        or none to do the SSAPs between all pairs
+			size_opt do_the_ssaps_neighbours;
+
 			/// \brief How much refining should be done to the alignment
 			align::align_refining refining = DEFAULT_REFINING;
 
+			/// \brief The number of threads over which to spread the refining's scoring (or 0 to use one per hardware thread)
+			size_t refining_num_threads = DEFAULT_REFINING_NUM_THREADS;
+
 		public:
 			/// \brief The default value for whether to align based on matching residue names
 			static constexpr bool DEFAULT_RESIDUE_NAME_ALIGN = false;
@@ -68,6 +76,9 @@ namespace cath {
 			/// \brief The default value for how much refining should be done to the alignment
 			static constexpr align::align_refining DEFAULT_REFINING = align::align_refining::NO;
 
+			/// \brief The default value for the number of threads over which to spread the refining's scoring
+			static constexpr size_t DEFAULT_REFINING_NUM_THREADS = 1;
+
 			alignment_input_spec() = default;
 			explicit alignment_input_spec(const align::align_refining &);
 
@@ -77,7 +88,9 @@ namespace cath {
 			const boost::filesystem::path & get_cora_alignment_file() const;
 			const boost::filesystem::path & get_ssap_scores_file() const;
 			const path_opt_opt & get_do_the_ssaps_dir() const;
+			const size_opt & get_do_the_ssaps_neighbours() const;
 			const align::align_refining & get_refining() const;
+			const size_t & get_refining_num_threads() const;
 
 			alignment_input_spec & set_residue_name_align(const bool &);
 			alignment_input_spec & set_fasta_alignment_file(const boost::filesystem::path &);
@@ -85,7 +98,9 @@ namespace cath {
 			alignment_input_spec & set_cora_alignment_file(const boost::filesystem::path &);
 			alignment_input_spec & set_ssap_scores_file(const boost::filesystem::path &);
 			alignment_input_spec & set_do_the_ssaps_dir(const path_opt &);
+			alignment_input_spec & set_do_the_ssaps_neighbours(const size_opt &);
 			alignment_input_spec & set_refining(const align::align_refining &);
+			alignment_input_spec & set_refining_num_threads(const size_t &);
 		};
 
 		size_t get_num_acquirers(const alignment_input_spec &);
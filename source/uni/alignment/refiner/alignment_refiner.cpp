@@ -37,6 +37,7 @@
 #include "alignment/refiner/detail/alignment_split_list.hpp"
 #include "alignment/refiner/detail/alignment_split_mapping.hpp"
 #include "alignment/residue_score/residue_scorer.hpp"
+#include "common/algorithm/parallel_for_blocks.hpp"
 #include "common/boost_addenda/range/indices.hpp"
 #include "common/exception/not_implemented_exception.hpp"
 #include "common/file/open_fstream.hpp"
@@ -57,6 +58,91 @@ using namespace cath::common;
 using namespace cath::index;
 using namespace std;
 
+namespace {
+
+	/// \brief Add the from/to context scores for the specified alignment split mappings into the rows
+	///        [prm_begin_row, prm_end_row) of the specified from/to score matrices
+	///
+	/// Restricting to a range of rows lets the matrices be scored in parallel without any locking
+	/// and without changing the order in which any one cell's contributions are summed
+	void add_context_scores_for_rows(float_score_vec_vec           &prm_from_alignment_scores, ///< The from-alignment scores matrix to which scores should be added
+	                                 float_score_vec_vec           &prm_to_alignment_scores,   ///< The to-alignment scores matrix to which scores should be added
+	                                 const alignment               &prm_alignment,             ///< The alignment being refined
+	                                 const protein_list            &prm_proteins,              ///< The proteins being aligned
+	                                 const view_cache_list         &prm_view_cache_list,       ///< The view_cache_list for the proteins
+	                                 const alignment_split_mapping &prm_mapping_a,             ///< The mapping for the first  half of the split
+	                                 const alignment_split_mapping &prm_mapping_b,             ///< The mapping for the second half of the split
+	                                 const size_t                  &prm_begin_row,             ///< The first row of the matrices to score
+	                                 const size_t                  &prm_end_row                ///< One past the last row of the matrices to score
+	                                 ) {
+		const alignment::size_type alignment_length = prm_alignment.length();
+		for (const size_t &aln_ctr : indices( alignment_length ) ) {
+			const size_opt mapping_index_a = prm_mapping_a.index_of_orig_aln_index( aln_ctr );
+			const size_opt mapping_index_b = prm_mapping_b.index_of_orig_aln_index( aln_ctr );
+			if ( ! mapping_index_a || ! mapping_index_b ) {
+				continue;
+			}
+
+			const size_vec present_orig_aln_entries_a = present_orig_aln_entries_of_index( prm_mapping_a, *mapping_index_a );
+			const size_vec present_orig_aln_entries_b = present_orig_aln_entries_of_index( prm_mapping_b, *mapping_index_b );
+
+			for (const size_t &present_orig_aln_entry_a : present_orig_aln_entries_a) {
+				for (const size_t &present_orig_aln_entry_b : present_orig_aln_entries_b) {
+					const size_t        present_entry_a = * prm_mapping_a.entry_of_orig_aln_entry( present_orig_aln_entry_a );
+					const size_t        present_entry_b = * prm_mapping_b.entry_of_orig_aln_entry( present_orig_aln_entry_b );
+					const aln_posn_type a_position      = get_position_of_entry_of_index( prm_mapping_a, present_entry_a, *mapping_index_a );
+					const aln_posn_type b_position      = get_position_of_entry_of_index( prm_mapping_b, present_entry_b, *mapping_index_b );
+					const size_t        length_a        = prm_proteins[ present_orig_aln_entry_a ].get_length();
+					const size_t        length_b        = prm_proteins[ present_orig_aln_entry_b ].get_length();
+
+					for (const size_t &res_ctr_a : indices( length_a ) ) {
+						if ( res_ctr_a == a_position ) {
+							continue;
+						}
+						const size_t other_mapping_index_a = prm_mapping_a.index_of_protein_index( present_entry_a, res_ctr_a );
+						if ( other_mapping_index_a < prm_begin_row || other_mapping_index_a >= prm_end_row ) {
+							continue;
+						}
+						float_score_vec &from_scores_row = prm_from_alignment_scores[ other_mapping_index_a ];
+						float_score_vec &to_scores_row   = prm_to_alignment_scores  [ other_mapping_index_a ];
+
+						for (const size_t &res_ctr_b : indices( length_b ) ) {
+							if ( res_ctr_b != b_position ) {
+								const size_t other_mapping_index_b = prm_mapping_b.index_of_protein_index( present_entry_b, res_ctr_b );
+
+								from_scores_row[ other_mapping_index_b ] += get_residue_context(
+									prm_view_cache_list,
+									present_orig_aln_entry_a,
+									present_orig_aln_entry_b,
+									a_position,
+									b_position,
+									res_ctr_a,
+									res_ctr_b
+								);
+								to_scores_row[ other_mapping_index_b ] += get_residue_context(
+									prm_view_cache_list,
+									present_orig_aln_entry_a,
+									present_orig_aln_entry_b,
+									res_ctr_a,
+									res_ctr_b,
+									a_position,
+									b_position
+								);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+} // namespace
+
+/// \brief Ctor for alignment_refiner
+alignment_refiner::alignment_refiner(const size_t &prm_num_threads ///< The number of threads over which to spread the scoring of each split's matrix (or 0 to use one per hardware thread)
+                                     ) : num_threads( prm_num_threads ) {
+}
+
 /// \brief TODOCUMENT
 bool_aln_pair alignment_refiner::iterate_step(const alignment       &prm_alignment,       ///< TODOCUMENT
                                               const protein_list    &prm_proteins,        ///< TODOCUMENT
@@ -139,72 +225,32 @@ bool_aln_pair alignment_refiner::iterate_step_for_alignment_split(const alignmen
 //	cerr << "number of entries in half a of split is " << mapping_a.num_entries() << endl;
 //	cerr << "number of entries in half b of split is " << mapping_b.num_entries() << endl;
 
-	const alignment::size_type alignment_length = prm_alignment.length();
-	for (const size_t &aln_ctr : indices( alignment_length ) ) {
-		const size_opt mapping_index_a = mapping_a.index_of_orig_aln_index( aln_ctr );
-		const size_opt mapping_index_b = mapping_b.index_of_orig_aln_index( aln_ctr );
-		if ( ! mapping_index_a || ! mapping_index_b ) {
-			continue;
-		}
-//		cerr << "At alignment counter " << aln_ctr << endl;
-
-		const size_vec present_orig_aln_entries_a = present_orig_aln_entries_of_index( mapping_a, *mapping_index_a );
-		const size_vec present_orig_aln_entries_b = present_orig_aln_entries_of_index( mapping_b, *mapping_index_b );
-
-		for (const size_t &present_orig_aln_entry_a : present_orig_aln_entries_a) {
-			for (const size_t &present_orig_aln_entry_b : present_orig_aln_entries_b) {
-				const size_t        present_entry_a = * mapping_a.entry_of_orig_aln_entry( present_orig_aln_entry_a );
-				const size_t        present_entry_b = * mapping_b.entry_of_orig_aln_entry( present_orig_aln_entry_b );
-				const aln_posn_type a_position      = get_position_of_entry_of_index( mapping_a, present_entry_a, *mapping_index_a );
-				const aln_posn_type b_position      = get_position_of_entry_of_index( mapping_b, present_entry_b, *mapping_index_b );
-
-	//			cerr << "Rescoring based on pair " << a_position << ", " << b_position << endl;
-				const protein &protein_a = prm_proteins[ present_orig_aln_entry_a ];
-				const protein &protein_b = prm_proteins[ present_orig_aln_entry_b ];
-				const size_t   length_a  = protein_a.get_length();
-				const size_t   length_b  = protein_b.get_length();
-//				const residue &residue_a = protein_a.get_residue_ref_of_index( a_position );
-//				const residue &residue_b = protein_b.get_residue_ref_of_index( b_position );
-
-				for (const size_t &res_ctr_a : indices( length_a ) ) {
-					for (const size_t &res_ctr_b : indices( length_b ) ) {
-						if ( res_ctr_a != a_position && res_ctr_b != b_position ) {
-							const size_t   other_mapping_index_a = mapping_a.index_of_protein_index( present_entry_a, res_ctr_a );
-							const size_t   other_mapping_index_b = mapping_b.index_of_protein_index( present_entry_b, res_ctr_b );
-//							const residue &other_residue_a       = protein_a.get_residue_ref_of_index( res_ctr_a );
-//							const residue &other_residue_b       = protein_b.get_residue_ref_of_index( res_ctr_b );
-
-							from_alignment_scores[ other_mapping_index_a ][ other_mapping_index_b ] += get_residue_context(
-								prm_view_cache_list,
-								present_orig_aln_entry_a,
-								present_orig_aln_entry_b,
-								a_position,
-								b_position,
-								res_ctr_a,
-								res_ctr_b
-							);
-							to_alignment_scores[ other_mapping_index_a ][ other_mapping_index_b ] += get_residue_context(
-								prm_view_cache_list,
-								present_orig_aln_entry_a,
-								present_orig_aln_entry_b,
-								res_ctr_a,
-								res_ctr_b,
-								a_position,
-								b_position
-							);
-						}
-					}
-				}
-			}
+	// Score the matrices, splitting the rows into contiguous blocks over the threads
+	parallel_for_blocks(
+		full_length_a,
+		num_threads,
+		[&] (const size_t &prm_begin_row, const size_t &prm_end_row) {
+			add_context_scores_for_rows(
+				from_alignment_scores,
+				to_alignment_scores,
+				prm_alignment,
+				prm_proteins,
+				prm_view_cache_list,
+				mapping_a,
+				mapping_b,
+				prm_begin_row,
+				prm_end_row
+			);
 		}
-	}
+	);
 
-	float_score_vec_vec avg_scores( full_length_a, float_score_vec( full_length_b, 0 ) );
+	// Average the from/to scores in place (rather than into a fresh matrix) so the buffers are reused across splits
 	for (const size_t &ctr_a : indices( full_length_a ) ) {
 		for (const size_t &ctr_b : indices( full_length_b ) ) {
-			avg_scores[ctr_a][ctr_b] = (from_alignment_scores[ctr_a][ctr_b] + to_alignment_scores[ctr_a][ctr_b]) / 2.0;
+			from_alignment_scores[ctr_a][ctr_b] = (from_alignment_scores[ctr_a][ctr_b] + to_alignment_scores[ctr_a][ctr_b]) / 2.0;
 		}
 	}
+	const float_score_vec_vec &avg_scores = from_alignment_scores;
 
 //	matrix_plot<gnuplot_matrix_plotter>( path("matrix_plot_from"), new_matrix_dyn_prog_score_source( from_alignment_scores, length_a, length_b) );
 //	matrix_plot<gnuplot_matrix_plotter>( path("matrix_plot___to"), new_matrix_dyn_prog_score_source( to_alignment_scores,   length_a, length_b) );
@@ -43,6 +43,10 @@ namespace cath {
 			/// \brief TODOCUMENT
 			float_score_vec_vec to_alignment_scores;
 
+			/// \brief The number of threads over which to spread the scoring of each split's matrix
+			///        (or 0 to use one per hardware thread)
+			size_t num_threads = 1;
+
 			detail::bool_aln_pair iterate_step(const alignment &,
 			                                   const protein_list &,
 			                                   const index::view_cache_list &,
@@ -61,6 +65,8 @@ namespace cath {
 			                                                       const detail::alignment_split &);
 
 		public:
+			explicit alignment_refiner(const size_t & = 1);
+
 			alignment iterate(const alignment &,
 			                  const protein_list &,
 			                  const gap::gap_penalty &);
@@ -20,28 +20,73 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "alignment/alignment.hpp"
+#include "alignment/alignment_action.hpp"
+#include "alignment/gap/gap_penalty.hpp"
+#include "alignment/io/alignment_io.hpp"
 #include "alignment/refiner/alignment_refiner.hpp"
+#include "file/pdb/dssp_skip_policy.hpp"
+#include "structure/protein/protein.hpp"
+#include "structure/protein/protein_io.hpp"
+#include "structure/protein/protein_list.hpp"
+#include "structure/protein/residue.hpp"
+#include "structure/protein/sec_struc.hpp"
+#include "structure/protein/sec_struc_planar_angles.hpp"
+#include "test/global_test_constants.hpp"
 
+using namespace cath;
 using namespace cath::align;
+using namespace cath::align::gap;
+using namespace cath::file;
+using namespace std;
+
+using boost::filesystem::path;
 
 namespace cath {
 	namespace test {
 
 		/// \brief The alignment_refiner_test_suite_fixture to assist in testing alignment_refiner
-		struct alignment_refiner_test_suite_fixture {
+		struct alignment_refiner_test_suite_fixture : protected global_test_constants {
+		private:
+			ostringstream test_stderr;
+
 		protected:
 			~alignment_refiner_test_suite_fixture() noexcept = default;
+
+			const path         root_dir            = { TEST_MULTI_SSAP_SUPERPOSE_DIR() };
+			const protein      protein_1g5aA03     = { read_protein_from_dssp_and_pdb( root_dir / "1g5aA03.dssp", root_dir / "1g5aA03", dssp_skip_policy::SKIP__BREAK_ANGLES, "1g5aA03", ostream_ref( test_stderr ) ) };
+			const protein      protein_1r7aA02     = { read_protein_from_dssp_and_pdb( root_dir / "1r7aA02.dssp", root_dir / "1r7aA02", dssp_skip_policy::SKIP__BREAK_ANGLES, "1r7aA02", ostream_ref( test_stderr ) ) };
+			const protein      protein_1zjaA02     = { read_protein_from_dssp_and_pdb( root_dir / "1zjaA02.dssp", root_dir / "1zjaA02", dssp_skip_policy::SKIP__BREAK_ANGLES, "1zjaA02", ostream_ref( test_stderr ) ) };
+			const protein_list all_proteins        = { make_protein_list( { protein_1g5aA03, protein_1r7aA02, protein_1zjaA02 } ) };
+			const alignment    aln_1g5aA03_1zjaA02 = { read_alignment_from_cath_ssap_legacy_format( root_dir / "1g5aA031zjaA02.list", protein_1g5aA03, protein_1zjaA02, ostream_ref( test_stderr ) ) };
+			const alignment    aln_1g5aA03_1r7aA02 = { read_alignment_from_cath_ssap_legacy_format( root_dir / "1g5aA031r7aA02.list", protein_1g5aA03, protein_1r7aA02, ostream_ref( test_stderr ) ) };
+			const alignment    unrefined_aln       = { build_alignment_from_parts(
+				{
+					make_tuple( 0, 2, aln_1g5aA03_1zjaA02 ),
+					make_tuple( 0, 1, aln_1g5aA03_1r7aA02 )
+				},
+				all_proteins,
+				aln_glue_style::SIMPLY
+			) };
 		};
 
-	}
-}  // namespace cath
+	} // namespace test
+} // namespace cath
 
-/// \brief TODOCUMENT
 BOOST_FIXTURE_TEST_SUITE(alignment_refiner_test_suite, cath::test::alignment_refiner_test_suite_fixture)
 
-/// \brief TODOCUMENT
-BOOST_AUTO_TEST_CASE(basic){
-	BOOST_CHECK( true );
+/// \brief Check that refining gives the same alignment however many threads are used to score the splits' matrices
+BOOST_AUTO_TEST_CASE(iterate_gives_same_result_for_any_number_of_threads) {
+	const alignment refined_with_1_thread  = alignment_refiner( 1 ).iterate( unrefined_aln, all_proteins, gap_penalty( 50, 0 ) );
+	const alignment refined_with_3_threads = alignment_refiner( 3 ).iterate( unrefined_aln, all_proteins, gap_penalty( 50, 0 ) );
+	BOOST_CHECK( refined_with_1_thread == refined_with_3_threads );
+}
+
+/// \brief Check that refining an already-refined alignment leaves it unchanged
+BOOST_AUTO_TEST_CASE(iterate_is_stable_on_refined_alignment) {
+	alignment_refiner the_refiner;
+	const alignment refined_aln = the_refiner.iterate( unrefined_aln, all_proteins, gap_penalty( 50, 0 ) );
+	BOOST_CHECK( the_refiner.iterate( refined_aln, all_proteins, gap_penalty( 50, 0 ) ) == refined_aln );
 }
 
 BOOST_AUTO_TEST_SUITE_END()
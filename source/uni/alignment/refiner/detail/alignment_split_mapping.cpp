@@ -81,11 +81,9 @@ alignment_split_mapping::alignment_split_mapping(const alignment &prm_alignment,
 			for (const size_t &entry : indices( orig_aln_entries.size() ) ) {
 				// Grab some details for this entry:
 				//  * a reference to the relevant entry of index_of_pdb_res_index
-				//  * the equivalent entry in the original alignment
-				//  * the position for this index/entry in the original alignment
+				//  * the position for this index/entry in the original alignment (from the local_row)
 				size_vec          &pdb_res_indices = index_of_pdb_res_index[ entry ];
-				const size_t      &orig_aln_entry  = orig_aln_entries      [ entry ];
-				const aln_posn_opt position        = prm_alignment.position_of_entry_of_index( orig_aln_entry, orig_aln_index );
+				const aln_posn_opt position        = local_row.position_of_entry( entry );
 
 				// If there is something present here in the original alignment then add any missing residues
 				if ( position ) {
@@ -103,11 +101,9 @@ alignment_split_mapping::alignment_split_mapping(const alignment &prm_alignment,
 			for (const size_t &entry : indices( orig_aln_entries.size() ) ) {
 				// Grab some details for this entry:
 				//  * a reference to the relevant entry of index_of_pdb_res_index
-				//  * the equivalent entry in the original alignment
-				//  * the position for this index/entry in the original alignment
+				//  * the position for this index/entry in the original alignment (from the local_row)
 				size_vec          &pdb_res_indices = index_of_pdb_res_index[ entry ];
-				const size_t      &orig_aln_entry  = orig_aln_entries      [ entry ];
-				const aln_posn_opt position        = prm_alignment.position_of_entry_of_index( orig_aln_entry, orig_aln_index );
+				const aln_posn_opt position        = local_row.position_of_entry( entry );
 
 				// If there is something present here in the original alignment then store the residue for this index will go
 				if ( position ) {
@@ -90,6 +90,9 @@ namespace cath {
 		/// \brief Type alias for a vector of ssap_scores_entry objects
 		using ssap_scores_entry_vec = std::vector<ssap_scores_entry>;
 
+		/// \brief Type alias for an optional ssap_scores_entry
+		using ssap_scores_entry_opt = boost::optional<ssap_scores_entry>;
+
 		/// \brief Type alias for a vector of prc_scores_entry objects
 		using prc_scores_entry_vec = std::vector<prc_scores_entry>;
 
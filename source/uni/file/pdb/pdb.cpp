@@ -51,9 +51,11 @@
 #include "file/pdb/backbone_complete_indices.hpp"
 #include "file/pdb/pdb_atom.hpp"
 #include "file/pdb/pdb_list.hpp"
+#include "file/pdb/pdb_record_buffer.hpp"
 #include "file/pdb/pdb_residue.hpp"
 #include "file/pdb/protein_info.hpp"
 #include "structure/geometry/coord.hpp"
+#include "structure/geometry/rotation.hpp"
 #include "structure/protein/protein.hpp"
 #include "structure/protein/residue.hpp"
 #include "structure/protein/sec_struc.hpp"
@@ -813,6 +815,90 @@ void cath::file::write_pdb_file(const path           &prm_filename,      ///< Th
 	out_ofstream.close();
 }
 
+/// \brief Write a PDB file of the specified pdb, translated and then rotated by the specified
+///        translation and rotation, into the specified ostream
+///
+/// This writes exactly the same bytes as translating and rotating a copy of the pdb, optionally
+/// setting its chain labels (which doesn't affect post-TER residues) and then calling write_pdb_file()
+/// but it transforms each coord as it's written (rather than copying the pdb) and formats the
+/// records into a pdb_record_buffer (rather than via the ostream's formatting).
+///
+/// \relates pdb
+ostream & cath::file::write_transformed_pdb_file(ostream               &prm_os,             ///< The ostream into which the PDB file should be inserted
+                                                 const pdb             &prm_pdb,            ///< The pdb to describe
+                                                 const coord           &prm_translation,    ///< The translation to apply to each coord (before the rotation)
+                                                 const rotation        &prm_rotation,       ///< The rotation to apply to each coord (after the translation)
+                                                 const chain_label_opt &prm_chain_label,    ///< An optional chain label with which to overwrite the chain labels of the pre-TER residues
+                                                 const region_vec_opt  &prm_regions,        ///< Optional specification of regions to which the written records should be restricted
+                                                 const pdb_write_mode  &prm_pdb_write_mode  ///< Whether this is the only/last part of the PDB file
+                                                 ) {
+	// Transform coords in the same order as `pdb += translation` followed by `pdb.rotate( rotation )`
+	const auto transform_coord = [&] (coord the_coord) {
+		the_coord += prm_translation;
+		rotate( prm_rotation, the_coord );
+		return the_coord;
+	};
+
+	// Use a regions_limiter for extracting the correct regions
+	regions_limiter the_regions_limiter{ prm_regions };
+	pdb_record_buffer the_buffer{ prm_os };
+
+	// Write the pre-TER atom records, keeping track of the last one and its residue_id
+	const pdb_atom     *last_atom_ptr = nullptr;
+	optional<residue_id> last_res_id;
+	for (const size_t &residue_ctr : indices( prm_pdb.get_num_residues() ) ) {
+		const pdb_residue &the_residue = prm_pdb.get_residue_of_index__backbone_unchecked( residue_ctr );
+		const residue_id   the_res_id  = prm_chain_label
+			? residue_id{ *prm_chain_label, the_residue.get_residue_id().get_residue_name() }
+			: the_residue.get_residue_id();
+
+		// If the residue is included, write its atoms
+		if ( the_regions_limiter.update_residue_is_included( the_res_id ) ) {
+			for (const pdb_atom &the_atom : the_residue) {
+				the_buffer.append_atom_record( the_res_id, the_atom, transform_coord( the_atom.get_coord() ) );
+				last_atom_ptr = &the_atom;
+			}
+			if ( the_residue.get_num_atoms() > 0 ) {
+				last_res_id = the_res_id;
+			}
+		}
+	}
+
+	// Write out the TER record, using the details of the last atom or made-up details if there weren't any
+	if ( last_atom_ptr != nullptr ) {
+		the_buffer.append_ter_record(
+			*last_res_id,
+			last_atom_ptr->get_atom_serial(),
+			last_atom_ptr->get_amino_acid()
+		);
+	}
+	else {
+		the_buffer.append_ter_record( make_residue_id( ' ', 1 ), 0, amino_acid{ 'X' } );
+	}
+
+	// Write out any post-TER records
+	for (const pdb_residue &the_residue : prm_pdb.get_post_ter_residues() ) {
+		for (const pdb_atom &the_atom : the_residue) {
+			the_buffer.append_atom_record( the_residue.get_residue_id(), the_atom, transform_coord( the_atom.get_coord() ) );
+		}
+	}
+
+	// If this is the only or last PDB then "END   " the file
+	if ( prm_pdb_write_mode == pdb_write_mode::ONLY_OR_LAST_PDB ) {
+		the_buffer.append( "END   \n" );
+	}
+	the_buffer.flush();
+
+	// Warn if the regions_limiter didn't see all the regions it hoped to
+	const auto warn_str = warn_str_if_specified_regions_remain_unseen( the_regions_limiter );
+	if ( warn_str ) {
+		BOOST_LOG_TRIVIAL( warning ) << *warn_str;
+	}
+
+	// Return the ostream
+	return prm_os;
+}
+
 /// \brief Write the specified PDB to a string
 ///
 /// \relates pdb
@@ -42,6 +42,7 @@ namespace cath { class protein; }
 namespace cath { namespace file { class pdb_list; } }
 namespace cath { namespace file { class pdb_residue; } }
 namespace cath { namespace file { struct protein_info; } }
+namespace cath { namespace geom { class rotation; } }
 
 namespace cath {
 	namespace file {
@@ -145,6 +146,13 @@ namespace cath {
 		                    const pdb &,
 		                    const chop::region_vec_opt & = boost::none,
 		                    const pdb_write_mode & = pdb_write_mode::ONLY_OR_LAST_PDB);
+		std::ostream & write_transformed_pdb_file(std::ostream &,
+		                                          const pdb &,
+		                                          const geom::coord &,
+		                                          const geom::rotation &,
+		                                          const chain_label_opt & = boost::none,
+		                                          const chop::region_vec_opt & = boost::none,
+		                                          const pdb_write_mode & = pdb_write_mode::ONLY_OR_LAST_PDB);
 
 		std::string pdb_file_to_string(const pdb &,
 		                               const chop::region_vec_opt & = boost::none,
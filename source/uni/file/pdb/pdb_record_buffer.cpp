@@ -0,0 +1,266 @@
+/// \file
+/// \brief The pdb_record_buffer class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pdb_record_buffer.hpp"
+
+#include "biocore/residue_id.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
+#include "file/pdb/pdb.hpp"
+#include "file/pdb/pdb_atom.hpp"
+#include "structure/geometry/coord.hpp"
+#include "structure/protein/amino_acid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::file;
+using namespace cath::geom;
+
+using boost::string_ref;
+using std::array;
+using std::fabs;
+using std::fixed;
+using std::floor;
+using std::int64_t;
+using std::isfinite;
+using std::min;
+using std::ostream;
+using std::ostringstream;
+using std::setprecision;
+using std::signbit;
+using std::string;
+using std::uint64_t;
+
+constexpr size_t pdb_record_buffer::FLUSH_THRESHOLD;
+
+namespace {
+
+	/// \brief Append the specified string, right-justified to the specified width, to the specified buffer
+	///
+	/// Like setw(), this doesn't truncate strings that are longer than the width
+	void append_right_justified(string           &prm_buffer, ///< The buffer to which the string should be appended
+	                            const string_ref &prm_string, ///< The string to append
+	                            const size_t     &prm_width   ///< The width to which the string should be right-justified
+	                            ) {
+		if ( prm_string.length() < prm_width ) {
+			prm_buffer.append( prm_width - prm_string.length(), ' ' );
+		}
+		prm_buffer.append( prm_string.data(), prm_string.length() );
+	}
+
+	/// \brief Append the residue number and insert code (or space) of the specified residue_id,
+	///        right-justified to five characters, as for make_residue_name_string_with_insert_or_space()
+	void append_residue_number_and_insert(string           &prm_buffer, ///< The buffer to which the residue number and insert should be appended
+	                                      const residue_id &prm_res_id  ///< The residue_id whose residue number and insert should be appended
+	                                      ) {
+		const residue_name &the_residue_name = prm_res_id.get_residue_name();
+		const int           residue_number   = the_residue_name.residue_number();
+
+		// Write the characters backwards from the end of a local array
+		array<char, 16> chars;
+		char * const chars_end = chars.data() + chars.size();
+		char *       char_itr  = chars_end;
+		*--char_itr            = has_insert( the_residue_name ) ? insert( the_residue_name ) : ' ';
+		auto         abs_number = static_cast<uint64_t>( residue_number < 0 ? -static_cast<int64_t>( residue_number ) : residue_number );
+		do {
+			*--char_itr = static_cast<char>( '0' + ( abs_number % 10 ) );
+			abs_number /= 10;
+		} while ( abs_number != 0 );
+		if ( residue_number < 0 ) {
+			*--char_itr = '-';
+		}
+		append_right_justified( prm_buffer, string_ref{ char_itr, static_cast<size_t>( chars_end - char_itr ) }, 5 );
+	}
+
+} // namespace
+
+/// \brief Append the specified unsigned integer, right-justified to the specified width, to the specified buffer
+///
+/// This gives the same result as `<< right << setw( width ) << value`
+void cath::file::detail::append_right_justified_uint(string       &prm_buffer, ///< The buffer to which the number should be appended
+                                                     const size_t &prm_value,  ///< The number to append
+                                                     const size_t &prm_width   ///< The width to which the number should be right-justified
+                                                     ) {
+	array<char, 24> chars;
+	char * const chars_end = chars.data() + chars.size();
+	char *       char_itr  = chars_end;
+	size_t       the_value = prm_value;
+	do {
+		*--char_itr = static_cast<char>( '0' + ( the_value % 10 ) );
+		the_value /= 10;
+	} while ( the_value != 0 );
+	append_right_justified( prm_buffer, string_ref{ char_itr, static_cast<size_t>( chars_end - char_itr ) }, prm_width );
+}
+
+/// \brief Append the specified number, formatted to the specified number of decimal places and
+///        right-justified to the specified width, to the specified buffer
+///
+/// This gives the same result as `<< right << setw( width ) << fixed << setprecision( precision ) << value`
+/// (ie the same as printf's `%{width}.{precision}f`), including the rounding and printing "-0.000" for
+/// small negative numbers.
+///
+/// The fast path rounds the scaled value to the nearest integer. It falls back on an ostringstream
+/// where that might round differently from the exact binary value (ie very near a half) and for
+/// very large or non-finite values, which are all very rare in PDB files.
+void cath::file::detail::append_right_justified_fixed(string       &prm_buffer,    ///< The buffer to which the number should be appended
+                                                      const double &prm_value,     ///< The number to append
+                                                      const size_t &prm_precision, ///< The number of decimal places
+                                                      const size_t &prm_width      ///< The width to which the number should be right-justified
+                                                      ) {
+	static constexpr array<double, 4> SCALE_OF_PRECISION{ { 1.0, 10.0, 100.0, 1000.0 } };
+
+	const bool   fast_precision = ( prm_precision < SCALE_OF_PRECISION.size() );
+	const double scaled         = fast_precision ? ( fabs( prm_value ) * SCALE_OF_PRECISION[ prm_precision ] ) : 0.0;
+	const bool   use_fast_path  = fast_precision
+	                              && isfinite( prm_value )
+	                              && scaled < 1e9
+	                              && fabs( scaled - floor( scaled ) - 0.5 ) > 1e-6;
+	if ( ! use_fast_path ) {
+		ostringstream value_ss;
+		value_ss << fixed << setprecision( static_cast<int>( prm_precision ) ) << prm_value;
+		append_right_justified( prm_buffer, value_ss.str(), prm_width );
+		return;
+	}
+
+	// Write the characters backwards from the end of a local array
+	array<char, 32> chars;
+	char * const chars_end = chars.data() + chars.size();
+	char *       char_itr  = chars_end;
+	uint64_t     rounded   = static_cast<uint64_t>( floor( scaled + 0.5 ) );
+	for (size_t decimal_ctr = 0; decimal_ctr < prm_precision; ++decimal_ctr) {
+		*--char_itr = static_cast<char>( '0' + ( rounded % 10 ) );
+		rounded /= 10;
+	}
+	if ( prm_precision > 0 ) {
+		*--char_itr = '.';
+	}
+	do {
+		*--char_itr = static_cast<char>( '0' + ( rounded % 10 ) );
+		rounded /= 10;
+	} while ( rounded != 0 );
+	if ( signbit( prm_value ) ) {
+		*--char_itr = '-';
+	}
+	append_right_justified( prm_buffer, string_ref{ char_itr, static_cast<size_t>( chars_end - char_itr ) }, prm_width );
+}
+
+/// \brief Write the buffer to the ostream if it has reached FLUSH_THRESHOLD
+void pdb_record_buffer::flush_if_full() {
+	if ( buffer.size() >= FLUSH_THRESHOLD ) {
+		flush();
+	}
+}
+
+/// \brief Ctor from the ostream to which the records should be written
+pdb_record_buffer::pdb_record_buffer(ostream &prm_ostream ///< The ostream to which the records should be written
+                                     ) : the_ostream( prm_ostream ) {
+	buffer.reserve( FLUSH_THRESHOLD + 256 );
+}
+
+/// \brief Append an ATOM/HETATM record (and a newline) for the specified residue_id and pdb_atom
+///        but with the specified coord in place of the pdb_atom's
+///
+/// This gives the same result as write_pdb_file_entry() (followed by "\n")
+pdb_record_buffer & pdb_record_buffer::append_atom_record(const residue_id &prm_res_id,   ///< The residue_id of the atom's residue
+                                                          const pdb_atom   &prm_pdb_atom, ///< The atom to write
+                                                          const coord      &prm_coord     ///< The coordinates to write for the atom
+                                                          ) {
+	// Sanity check the inputs
+	if ( prm_res_id.get_residue_name().is_null() ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Empty residue_name in cath::pdb_record_buffer::append_atom_record()"));
+	}
+
+	                                                                                                    // Comments with PDB format documentation
+	                                                                                                    // (http://www.wwpdb.org/documentation/format33/sect9.html#ATOM)
+	buffer.append( prm_pdb_atom.get_record_type() == pdb_record::HETATM ? "HETATM" : "ATOM  " );      //  1 -  6        Record name   "ATOM  " or "HETATM"
+	detail::append_right_justified_uint  ( buffer, prm_pdb_atom.get_atom_serial(), 5 );                //  7 - 11        Integer       serial       Atom  serial number.
+	buffer.push_back( ' ' );
+	append_right_justified               ( buffer, get_element_type_untrimmed_str_ref( prm_pdb_atom ), 4 ); // 13 - 16     Atom          name         Atom name.
+	buffer.push_back( prm_pdb_atom.get_alt_locn() );                                                    // 17             Character     altLoc       Alternate location indicator.
+	const auto aa_code = prm_pdb_atom.get_amino_acid().get_code();                                      // 18 - 20        Residue name  resName      Residue name.
+	buffer.append( aa_code.data(), aa_code.size() );
+	buffer.push_back( ' ' );
+	buffer.append( prm_res_id.get_chain_label().to_string() );                                          // 22             Character     chainID      Chain identifier.
+	append_residue_number_and_insert     ( buffer, prm_res_id );                                       // 23 - 27        Integer/AChar resSeq/iCode Residue sequence number/insertion code.
+	buffer.append( "   " );
+	detail::append_right_justified_fixed ( buffer, prm_coord.get_x(), 3, 8 );                          // 31 - 38        Real(8.3)     x            Orthogonal coordinates for X in Angstroms.
+	detail::append_right_justified_fixed ( buffer, prm_coord.get_y(), 3, 8 );                          // 39 - 46        Real(8.3)     y            Orthogonal coordinates for Y in Angstroms.
+	detail::append_right_justified_fixed ( buffer, prm_coord.get_z(), 3, 8 );                          // 47 - 54        Real(8.3)     z            Orthogonal coordinates for Z in Angstroms.
+	detail::append_right_justified_fixed ( buffer, prm_pdb_atom.get_occupancy(), 2, 6 );               // 55 - 60        Real(6.2)     occupancy    Occupancy.
+
+	// 61 - 66        Real(6.2)     tempFactor   Temperature  factor (truncated to six characters)
+	const size_t temp_factor_start = buffer.size();
+	detail::append_right_justified_fixed ( buffer, prm_pdb_atom.get_temp_factor(), 2, 6 );
+	buffer.resize( min( buffer.size(), temp_factor_start + 6 ) );
+
+	const auto element_sym_strref = get_element_symbol_str_ref( prm_pdb_atom );                      // 77 - 78        LString(2)    element      Element symbol, right-justified.
+	const auto charge_strref      = get_charge_str_ref        ( prm_pdb_atom );                       // 79 - 80        LString(2)    charge       Charge  on the atom.
+	if ( ! element_sym_strref.empty() || ! charge_strref.empty() ) {
+		buffer.append( "          " );
+		append_right_justified( buffer, ( element_sym_strref.empty() ? string_ref{ "  " } : element_sym_strref ), 2 );
+		buffer.append( charge_strref.data(), charge_strref.length() );
+	}
+	buffer.push_back( '\n' );
+
+	flush_if_full();
+	return *this;
+}
+
+/// \brief Append a TER record for the specified residue_id, atom serial number and amino_acid of the last atom
+///
+/// This gives the same result as the TER record written by write_pdb_file()
+pdb_record_buffer & pdb_record_buffer::append_ter_record(const residue_id &prm_res_id,      ///< The residue_id of the last atom before the TER
+                                                         const size_t     &prm_atom_serial, ///< The atom serial number of the last atom before the TER
+                                                         const amino_acid &prm_amino_acid   ///< The amino_acid of the last atom before the TER
+                                                         ) {
+	buffer.append( pdb::PDB_RECORD_STRING_TER );
+	detail::append_right_justified_uint( buffer, prm_atom_serial + 1, 5 );
+	buffer.append( "      " );
+	const auto aa_code = prm_amino_acid.get_code();
+	buffer.append( aa_code.data(), aa_code.size() );
+	buffer.push_back( ' ' );
+	buffer.append( prm_res_id.get_chain_label().to_string() );
+	append_residue_number_and_insert( buffer, prm_res_id );
+	buffer.append( "                                                     \n" );
+
+	flush_if_full();
+	return *this;
+}
+
+/// \brief Append the specified string verbatim
+pdb_record_buffer & pdb_record_buffer::append(const string_ref &prm_string ///< The string to append
+                                              ) {
+	buffer.append( prm_string.data(), prm_string.length() );
+	flush_if_full();
+	return *this;
+}
+
+/// \brief Write any buffered records to the ostream
+void pdb_record_buffer::flush() {
+	the_ostream.get().write( buffer.data(), static_cast<std::streamsize>( buffer.size() ) );
+	buffer.clear();
+}
@@ -0,0 +1,91 @@
+/// \file
+/// \brief The pdb_record_buffer class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_UNI_FILE_PDB_PDB_RECORD_BUFFER_HPP
+#define _CATH_TOOLS_SOURCE_UNI_FILE_PDB_PDB_RECORD_BUFFER_HPP
+
+#include <boost/utility/string_ref.hpp>
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace cath { class amino_acid; }
+namespace cath { class residue_id; }
+namespace cath { namespace file { class pdb_atom; } }
+namespace cath { namespace geom { class coord; } }
+
+namespace cath {
+	namespace file {
+
+		/// \brief Build fixed-width PDB records in a large buffer and write them to an ostream in big chunks
+		///
+		/// This writes exactly the same bytes as write_pdb_file_entry() and write_pdb_file()
+		/// but formats the integers and floating-point numbers by hand rather than
+		/// through the ostream's formatting (which dominates the time to write big PDBs).
+		///
+		/// An ATOM/HETATM record's coordinates are supplied separately from the pdb_atom so that
+		/// callers can write transformed coordinates without first copying and transforming the pdb.
+		///
+		/// Call flush() when finished: the dtor doesn't flush because that may throw.
+		class pdb_record_buffer final {
+		private:
+			/// \brief The ostream to which the buffered records should be written
+			std::reference_wrapper<std::ostream> the_ostream;
+
+			/// \brief The records that are yet to be written
+			std::string buffer;
+
+			void flush_if_full();
+
+		public:
+			/// \brief The size the buffer may reach before it's written to the ostream
+			static constexpr size_t FLUSH_THRESHOLD = 1 << 20;
+
+			explicit pdb_record_buffer(std::ostream &);
+
+			pdb_record_buffer & append_atom_record(const residue_id &,
+			                                       const pdb_atom &,
+			                                       const geom::coord &);
+			pdb_record_buffer & append_ter_record(const residue_id &,
+			                                      const size_t &,
+			                                      const amino_acid &);
+			pdb_record_buffer & append(const boost::string_ref &);
+
+			void flush();
+		};
+
+		namespace detail {
+
+			void append_right_justified_uint(std::string &,
+			                                 const size_t &,
+			                                 const size_t &);
+
+			void append_right_justified_fixed(std::string &,
+			                                  const double &,
+			                                  const size_t &,
+			                                  const size_t &);
+
+		} // namespace detail
+
+	} // namespace file
+} // namespace cath
+
+#endif
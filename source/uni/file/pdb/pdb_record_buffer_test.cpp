@@ -0,0 +1,132 @@
+/// \file
+/// \brief The pdb_record_buffer test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/size_t_literal.hpp"
+#include "common/type_aliases.hpp"
+#include "file/pdb/pdb_atom.hpp"
+#include "file/pdb/pdb_record_buffer.hpp"
+
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::file;
+using namespace cath::file::detail;
+using namespace std;
+
+namespace cath {
+	namespace test {
+
+		/// \brief The pdb_record_buffer_test_suite_fixture to assist in testing pdb_record_buffer
+		struct pdb_record_buffer_test_suite_fixture {
+		protected:
+			~pdb_record_buffer_test_suite_fixture() noexcept = default;
+
+			/// \brief Some example ATOM/HETATM records, including awkward cases
+			const str_vec example_records = {
+				"ATOM      1  N   LEU A 999       0.041 148.800  54.967  1.00 35.61           N  ",
+				"ATOM     60  P    DT B 405     -34.489  40.044 103.442  1.00 22.35           P  ",
+				"ATOM   2041  N   ASN B  -1     -27.445  -1.104  16.047  1.00 65.16           N  ",
+				"ATOM    182  N   GLU  200       -0.292   3.837   4.911  1.00226.06           N  ",
+				"ATOM    183  CA  GLU A 201A     -0.000   3.837   4.911  0.50  0.00              ",
+				"HETATM 2959 ZN    ZN A1392      19.359  67.577 -13.048  1.00 34.67          ZN2+",
+			};
+
+			/// \brief Format the specified value as `<< right << setw( width ) << fixed << setprecision( precision )` does
+			static string format_via_ostream(const double &prm_value,     ///< The value to format
+			                                 const size_t &prm_precision, ///< The number of decimal places
+			                                 const size_t &prm_width      ///< The width to which the number should be right-justified
+			                                 ) {
+				ostringstream value_ss;
+				value_ss << right << setw( static_cast<int>( prm_width ) ) << fixed << setprecision( static_cast<int>( prm_precision ) ) << prm_value;
+				return value_ss.str();
+			}
+
+			/// \brief Format the specified value with append_right_justified_fixed()
+			static string format_via_buffer(const double &prm_value,     ///< The value to format
+			                                const size_t &prm_precision, ///< The number of decimal places
+			                                const size_t &prm_width      ///< The width to which the number should be right-justified
+			                                ) {
+				string the_buffer;
+				append_right_justified_fixed( the_buffer, prm_value, prm_precision, prm_width );
+				return the_buffer;
+			}
+		};
+
+	} // namespace test
+} // namespace cath
+
+BOOST_FIXTURE_TEST_SUITE(pdb_record_buffer_test_suite, cath::test::pdb_record_buffer_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(formats_awkward_fixed_values_as_ostream_does) {
+	for (const double &value : { 0.0, -0.0, 0.0004, -0.0004, 0.0005, -0.0005, 0.0015, 2.675, -2.675, 1.0005, 999.9995, 12345.678, -1234.5678, 1e9, -3e12, 1e300 } ) {
+		for (const size_t &precision : { 0_z, 2_z, 3_z, 6_z } ) {
+			BOOST_CHECK_EQUAL( format_via_buffer( value, precision, 8 ), format_via_ostream( value, precision, 8 ) );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(formats_random_fixed_values_as_ostream_does) {
+	mt19937 rng{ 1979 };
+	uniform_real_distribution<double> dist{ -1000.0, 1000.0 };
+	for (size_t value_ctr = 0; value_ctr < 20000; ++value_ctr) {
+		const double value = dist( rng );
+		BOOST_REQUIRE_EQUAL( format_via_buffer( value, 3, 8 ), format_via_ostream( value, 3, 8 ) );
+		BOOST_REQUIRE_EQUAL( format_via_buffer( value, 2, 6 ), format_via_ostream( value, 2, 6 ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(formats_uints_as_ostream_does) {
+	for (const size_t &value : { 0_z, 7_z, 99999_z, 100000_z, 1234567_z } ) {
+		string the_buffer;
+		append_right_justified_uint( the_buffer, value, 5 );
+		ostringstream value_ss;
+		value_ss << right << setw( 5 ) << value;
+		BOOST_CHECK_EQUAL( the_buffer, value_ss.str() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(writes_atom_records_as_write_pdb_file_entry_does) {
+	for (const string &example_record : example_records) {
+		const resid_atom_pair parsed_details = parse_pdb_atom_record( example_record );
+
+		ostringstream buffer_ss;
+		pdb_record_buffer the_buffer{ buffer_ss };
+		the_buffer.append_atom_record( parsed_details.first, parsed_details.second, parsed_details.second.get_coord() );
+		the_buffer.flush();
+
+		BOOST_CHECK_EQUAL( buffer_ss.str(), to_pdb_file_entry( parsed_details.first, parsed_details.second ) + "\n" );
+	}
+}
+
+BOOST_AUTO_TEST_CASE(does_not_write_until_flushed) {
+	ostringstream buffer_ss;
+	pdb_record_buffer the_buffer{ buffer_ss };
+	the_buffer.append( "END   \n" );
+	BOOST_CHECK_EQUAL( buffer_ss.str(), "" );
+	the_buffer.flush();
+	BOOST_CHECK_EQUAL( buffer_ss.str(), "END   \n" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,8 @@
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/finder.hpp>
+#include <boost/format.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 
 #include "common/boost_addenda/string_algorithm/split_build.hpp"
 #include "common/exception/runtime_error_exception.hpp"
@@ -34,6 +36,8 @@ using namespace cath::file;
 using namespace std;
 
 using boost::algorithm::is_space;
+using boost::format;
+using boost::numeric_cast;
 using boost::token_compress_on;
 
 /// \brief Ctor from all of the required pieces of information
@@ -157,6 +161,28 @@ ssap_scores_entry cath::file::ssap_scores_entry_from_line(const string &prm_ssap
 	};
 }
 
+/// \brief Generate a SSAP scores line for the specified ssap_scores_entry in the format output by SSAP
+///
+/// This is the inverse of ssap_scores_entry_from_line() for entries whose scores and RMSD are
+/// given to two decimal places and whose percentages are whole numbers
+///
+/// \relates ssap_scores_entry
+string cath::file::to_ssap_scores_line(const ssap_scores_entry &prm_ssap_scores_entry ///< The ssap_scores_entry to output as a SSAP scores line
+                                       ) {
+	return (
+		format( "%6s  %6s %4d %4d %6.2f %4d %4d %4d %6.2f" )
+			% prm_ssap_scores_entry.get_name_1()
+			% prm_ssap_scores_entry.get_name_2()
+			% prm_ssap_scores_entry.get_length_1()
+			% prm_ssap_scores_entry.get_length_2()
+			% prm_ssap_scores_entry.get_ssap_score()
+			% prm_ssap_scores_entry.get_num_equivs()
+			% numeric_cast<size_t>( prm_ssap_scores_entry.get_overlap_pc() )
+			% numeric_cast<size_t>( prm_ssap_scores_entry.get_seq_id_pc()  )
+			% prm_ssap_scores_entry.get_rmsd()
+	).str();
+}
+
 /// \brief Simple to_string() overload for ssap_scores_entry
 ///
 /// \relates ssap_scores_entry
@@ -87,6 +87,8 @@ namespace cath {
 
 		ssap_scores_entry ssap_scores_entry_from_line(const std::string &);
 
+		std::string to_ssap_scores_line(const ssap_scores_entry &);
+
 		std::string to_string(const ssap_scores_entry &);
 
 		std::ostream & operator<<(std::ostream &,
@@ -73,6 +73,11 @@ BOOST_AUTO_TEST_CASE(parses_from_line) {
 	BOOST_CHECK_EQUAL( ssap_scores_entry_from_line( "1cukA03  1hjpA03   48   44  94.92   44   91   97   0.71" ), eg_entry );
 }
 
+BOOST_AUTO_TEST_CASE(writes_to_line) {
+	BOOST_CHECK_EQUAL( to_ssap_scores_line( eg_entry ), "1cukA03  1hjpA03   48   44  94.92   44   91   97   0.71" );
+	BOOST_CHECK_EQUAL( ssap_scores_entry_from_line( to_ssap_scores_line( eg_entry ) ), eg_entry );
+}
+
 BOOST_AUTO_TEST_CASE(getters) {
 	BOOST_CHECK_EQUAL( eg_entry.get_name_1(),     "1cukA03" );
 	BOOST_CHECK_EQUAL( eg_entry.get_name_2(),     "1hjpA03" );
@@ -50,6 +50,7 @@ using std::unique_ptr;
 
 const string superposition_output_options_block::PO_SUP_FILE         ( "sup-to-pdb-file"      );
 const string superposition_output_options_block::PO_SUP_FILES_DIR    ( "sup-to-pdb-files-dir" );
+const string superposition_output_options_block::PO_SUP_FILES_THREADS( "sup-to-pdb-files-threads" );
 const string superposition_output_options_block::PO_SUP_TO_STDOUT    ( "sup-to-stdout"        );
 const string superposition_output_options_block::PO_SUP_TO_PYMOL     ( "sup-to-pymol"         );
 const string superposition_output_options_block::PO_PYMOL_PROGRAM    ( "pymol-program"        );
@@ -57,6 +58,7 @@ const string superposition_output_options_block::PO_SUP_TO_PYMOL_FILE( "sup-to-p
 const string superposition_output_options_block::PO_SUP_TO_JSON_FILE ( "sup-to-json-file"     );
 
 const string superposition_output_options_block::DEFAULT_PYMOL_PROGRAM( "pymol" );
+const size_t superposition_output_options_block::DEFAULT_SUP_TO_PDB_FILES_THREADS( 1 );
 
 /// \brief A standard do_clone method.
 unique_ptr<options_block> superposition_output_options_block::do_clone() const {
@@ -75,6 +77,8 @@ void superposition_output_options_block::do_add_visible_options_to_description(o
 	prm_desc.add_options()
 		(PO_SUP_FILE.c_str(),          value<path>(&sup_to_pdb_file),                                     "Write the superposed structures to a single PDB file arg, separated using faked chain codes"  )
 		(PO_SUP_FILES_DIR.c_str(),     value<path>(&sup_to_pdb_files_dir),                                "Write the superposed structures to separate PDB files in directory arg"                       )
+		(PO_SUP_FILES_THREADS.c_str(), value<size_t>(&sup_to_pdb_files_threads)->default_value(DEFAULT_SUP_TO_PDB_FILES_THREADS),
+		                                                                                                  ( "Write the separate PDB files under --" + PO_SUP_FILES_DIR + " with arg threads\n(or 0 for one per hardware thread)" ).c_str() )
 		(PO_SUP_TO_STDOUT.c_str(),     bool_switch(&sup_to_stdout)->default_value(false),                 "Print the superposed structures to stdout, separated using faked chain codes"                 )
 		(PO_SUP_TO_PYMOL.c_str(),      bool_switch(&sup_to_pymol )->default_value(false),                 "Start up PyMOL for viewing the superposition"                                                 )
 		(PO_PYMOL_PROGRAM.c_str(),     value<path>(&pymol_program)->default_value(DEFAULT_PYMOL_PROGRAM), "Use arg as the PyMOL executable for viewing; may optionally include the full path"            )
@@ -111,6 +115,7 @@ str_vec superposition_output_options_block::do_get_all_options_names() const {
 	return {
 		superposition_output_options_block::PO_SUP_FILE,
 		superposition_output_options_block::PO_SUP_FILES_DIR,
+		superposition_output_options_block::PO_SUP_FILES_THREADS,
 		superposition_output_options_block::PO_SUP_TO_STDOUT,
 		superposition_output_options_block::PO_SUP_TO_PYMOL,
 		superposition_output_options_block::PO_PYMOL_PROGRAM,
@@ -129,6 +134,11 @@ path superposition_output_options_block::get_sup_to_pdb_files_dir() const {
 	return sup_to_pdb_files_dir;
 }
 
+/// \brief Getter for the number of threads with which to write the separate PDB files (or 0 to use one per hardware thread)
+size_t superposition_output_options_block::get_sup_to_pdb_files_threads() const {
+	return sup_to_pdb_files_threads;
+}
+
 /// TODOCUMENT
 bool superposition_output_options_block::get_sup_to_stdout() const {
 	return sup_to_stdout;
@@ -164,7 +174,7 @@ superposition_outputter_list superposition_output_options_block::get_superpositi
 		superposition_outputters.push_back( pdb_file_superposition_outputter   { get_sup_to_pdb_file(),                        prm_content_spec } );
 	}
 	if ( ! get_sup_to_pdb_files_dir().empty() ) {
-		superposition_outputters.push_back( pdb_files_superposition_outputter  { get_sup_to_pdb_files_dir(),                   prm_content_spec } );
+		superposition_outputters.push_back( pdb_files_superposition_outputter  { get_sup_to_pdb_files_dir(),                   prm_content_spec, get_sup_to_pdb_files_threads() } );
 	}
 	if ( get_sup_to_stdout() ) {
 		superposition_outputters.push_back( ostream_superposition_outputter    {                                               prm_content_spec } );
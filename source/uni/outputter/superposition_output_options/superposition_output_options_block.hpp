@@ -35,6 +35,8 @@ namespace cath { namespace sup { class superposition_content_spec; } }
 
 namespace superposition_output_options_block_test_suite { struct parses_option_for_to_json_file; }
 namespace superposition_output_options_block_test_suite { struct unparsed_has_no_json_file; }
+namespace superposition_output_options_block_test_suite { struct parses_option_for_sup_to_pdb_files_threads; }
+namespace superposition_output_options_block_test_suite { struct unparsed_has_one_sup_to_pdb_files_thread; }
 
 namespace cath {
 	namespace opts {
@@ -50,13 +52,17 @@ namespace cath {
 		private:
 			friend struct superposition_output_options_block_test_suite::parses_option_for_to_json_file;
 			friend struct superposition_output_options_block_test_suite::unparsed_has_no_json_file;
+			friend struct superposition_output_options_block_test_suite::parses_option_for_sup_to_pdb_files_threads;
+			friend struct superposition_output_options_block_test_suite::unparsed_has_one_sup_to_pdb_files_thread;
 
 			using super = options_block;
 
 			static const std::string DEFAULT_PYMOL_PROGRAM;
+			static const size_t DEFAULT_SUP_TO_PDB_FILES_THREADS;
 
 			boost::filesystem::path sup_to_pdb_file;
 			boost::filesystem::path sup_to_pdb_files_dir;
+			size_t sup_to_pdb_files_threads = DEFAULT_SUP_TO_PDB_FILES_THREADS;
 			bool sup_to_stdout;
 			bool sup_to_pymol;
 			boost::filesystem::path sup_to_pymol_file;
@@ -72,6 +78,7 @@ namespace cath {
 
 			boost::filesystem::path get_sup_to_pdb_file() const;
 			boost::filesystem::path get_sup_to_pdb_files_dir() const;
+			size_t get_sup_to_pdb_files_threads() const;
 			bool get_sup_to_stdout() const;
 			bool get_sup_to_pymol() const;
 			boost::filesystem::path get_pymol_program() const;
@@ -81,6 +88,7 @@ namespace cath {
 		public:
 			static const std::string PO_SUP_FILE;
 			static const std::string PO_SUP_FILES_DIR;
+			static const std::string PO_SUP_FILES_THREADS;
 			static const std::string PO_SUP_TO_STDOUT;
 			static const std::string PO_SUP_TO_PYMOL;
 			static const std::string PO_PYMOL_PROGRAM;
@@ -21,6 +21,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "common/exception/not_implemented_exception.hpp"
+#include "common/size_t_literal.hpp"
 #include "display/options/display_spec.hpp"
 #include "options/options_block/options_block_tester.hpp"
 #include "outputter/superposition_output_options/superposition_output_options_block.hpp"
@@ -59,6 +60,18 @@ BOOST_AUTO_TEST_CASE(parses_option_for_to_json_file) {
 	BOOST_CHECK_EQUAL( parsed_block.get_json_file(), path( "the_filename" ) );
 }
 
+BOOST_AUTO_TEST_CASE(unparsed_has_one_sup_to_pdb_files_thread) {
+	BOOST_CHECK_EQUAL( superposition_output_options_block{}.get_sup_to_pdb_files_threads(), 1_z );
+}
+
+BOOST_AUTO_TEST_CASE(parses_option_for_sup_to_pdb_files_threads) {
+	const auto parsed_block = parse_into_options_block_copy(
+		superposition_output_options_block{},
+		{ "--" + superposition_output_options_block::PO_SUP_FILES_THREADS, "3" }
+	);
+	BOOST_CHECK_EQUAL( parsed_block.get_sup_to_pdb_files_threads(), 3_z );
+}
+
 BOOST_AUTO_TEST_CASE(option_for_to_json_file) {
 	const auto parsed_block = parse_into_options_block_copy(
 		superposition_output_options_block{},
@@ -20,6 +20,8 @@
 
 #include "json_file_superposition_outputter.hpp"
 
+#include <boost/optional.hpp>
+
 #include "chopping/region/region.hpp"
 #include "common/clone/make_uptr_clone.hpp"
 #include "common/file/open_fstream.hpp"
@@ -29,6 +31,7 @@
 
 #include <fstream>
 
+using namespace cath;
 using namespace cath::common;
 using namespace cath::opts;
 using namespace cath::sup;
@@ -59,6 +62,11 @@ bool json_file_superposition_outputter::do_involves_display_spec() const {
 	return false;
 }
 
+/// \brief Return the JSON file to which this writes
+path_opt json_file_superposition_outputter::do_get_output_path() const {
+	return output_file;
+}
+
 /// \brief Getter for the name of this superposition_outputter
 string json_file_superposition_outputter::do_get_name() const {
 	return "json_file_superposition_outputter";
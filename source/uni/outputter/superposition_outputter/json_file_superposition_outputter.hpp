@@ -44,6 +44,7 @@ namespace cath {
 			                             std::ostream &,
 			                             const boost::string_ref &) const final;
 			bool do_involves_display_spec() const final;
+			path_opt do_get_output_path() const final;
 			std::string do_get_name() const final;
 
 		public:
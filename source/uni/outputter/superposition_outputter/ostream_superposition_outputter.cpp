@@ -20,6 +20,8 @@
 
 #include "ostream_superposition_outputter.hpp"
 
+#include <boost/optional.hpp>
+
 #include "chopping/region/region.hpp"
 #include "common/clone/make_uptr_clone.hpp"
 #include "file/pdb/pdb.hpp"
@@ -28,10 +30,12 @@
 #include "superposition/io/superposition_io.hpp"
 #include "superposition/superposition_context.hpp"
 
+using namespace cath;
 using namespace cath::common;
 using namespace cath::opts;
 using namespace cath::sup;
 
+using boost::none;
 using boost::string_ref;
 using std::ostream;
 using std::string;
@@ -61,6 +65,11 @@ bool ostream_superposition_outputter::do_involves_display_spec() const {
 	return false;
 }
 
+/// \brief Return none because this writes to the ostream rather than to its own file
+path_opt ostream_superposition_outputter::do_get_output_path() const {
+	return none;
+}
+
 /// \brief Getter for the name of this superposition_outputter
 string ostream_superposition_outputter::do_get_name() const {
 	return "ostream_superposition_outputter";
@@ -20,12 +20,15 @@
 
 #include "pdb_file_superposition_outputter.hpp"
 
+#include <boost/optional.hpp>
+
 #include "common/clone/make_uptr_clone.hpp"
 #include "common/file/open_fstream.hpp"
 #include "outputter/superposition_outputter/ostream_superposition_outputter.hpp"
 
 #include <fstream>
 
+using namespace cath;
 using namespace cath::common;
 using namespace cath::opts;
 using namespace cath::sup;
@@ -63,6 +66,11 @@ bool pdb_file_superposition_outputter::do_involves_display_spec() const {
 	return false;
 }
 
+/// \brief Return the PDB file to which this writes
+path_opt pdb_file_superposition_outputter::do_get_output_path() const {
+	return output_file;
+}
+
 /// \brief Getter for the name of this superposition_outputter
 string pdb_file_superposition_outputter::do_get_name() const {
 	return "pdb_file_superposition_outputter";
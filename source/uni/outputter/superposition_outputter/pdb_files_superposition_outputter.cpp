@@ -20,14 +20,20 @@
 
 #include "pdb_files_superposition_outputter.hpp"
 
+#include <boost/optional.hpp>
+
 
 #include "chopping/region/region.hpp"
+#include "common/algorithm/parallel_for_blocks.hpp"
 #include "common/boost_addenda/range/indices.hpp"
 #include "common/clone/make_uptr_clone.hpp"
 #include "file/pdb/pdb.hpp"
 #include "superposition/io/superposition_io.hpp"
 #include "superposition/superposition_context.hpp"
 
+
+using namespace cath;
+using namespace cath::chop;
 using namespace cath::common;
 using namespace cath::file;
 using namespace cath::opts;
@@ -44,23 +50,35 @@ unique_ptr<superposition_outputter> pdb_files_superposition_outputter::do_clone(
 	return { make_uptr_clone( *this ) };
 }
 
-/// \brief TODOCUMENT
-void pdb_files_superposition_outputter::do_output_superposition(const superposition_context &prm_supn_context, ///< TODOCUMENT
-                                                                ostream                     &/*prm_ostream*/,  ///< TODOCUMENT
+/// \brief Write each entry's superposed PDB to its own file in output_dir
+///
+/// The files are independent so they're written concurrently, with the entries split
+/// into contiguous blocks over num_threads workers. Each worker only extracts the
+/// superposition content of the entry it's currently writing (rather than all of them
+/// being extracted up front) and writes it via a fixed-size buffer, so the memory used
+/// is bounded by the number of workers rather than the number of entries.
+void pdb_files_superposition_outputter::do_output_superposition(const superposition_context &prm_supn_context, ///< The superposition_context to output
+                                                                ostream                     &/*prm_ostream*/,  ///< Unused: this writes to files in output_dir
                                                                 const string_ref            &/*prm_name*/      ///< A name for the superposition (so users of the superposition know what it represents)
                                                                 ) const {
-	const pdb_list       pdbs      = get_supn_content_pdbs( prm_supn_context, content_spec );
-	const name_set_list &name_sets = get_name_sets( prm_supn_context );
-	const str_vec       &names     = get_supn_pdb_file_names( name_sets );
-
-	for (const size_t &pdb_ctr : indices( pdbs.size() ) ) {
-		write_superposed_pdb_to_file(
-			prm_supn_context.get_superposition(),
-			( output_dir / names[ pdb_ctr ] ).string(),
-			pdbs[ pdb_ctr ],
-			pdb_ctr
-		);
-	}
+	const pdb_list            &pdbs      = get_pdbs     ( prm_supn_context );
+	const region_vec_opt_vec  &regions   = get_regions  ( prm_supn_context );
+	const name_set_list       &name_sets = get_name_sets( prm_supn_context );
+	const str_vec              names     = get_supn_pdb_file_names( name_sets );
+	const size_t               num_pdbs  = pdbs.size();
+
+	const auto write_pdbs_fn = [&] (const size_t &prm_begin_index, const size_t &prm_end_index) {
+		for (size_t pdb_ctr = prm_begin_index; pdb_ctr < prm_end_index; ++pdb_ctr) {
+			write_superposed_pdb_to_file(
+				prm_supn_context.get_superposition(),
+				( output_dir / names[ pdb_ctr ] ).string(),
+				get_supn_content_pdb( pdbs[ pdb_ctr ], regions[ pdb_ctr ], content_spec ),
+				pdb_ctr
+			);
+		}
+	};
+
+	parallel_for_blocks( num_pdbs, get_num_threads(), write_pdbs_fn );
 }
 
 /// \brief TODOCUMENT
@@ -68,15 +86,28 @@ bool pdb_files_superposition_outputter::do_involves_display_spec() const {
 	return false;
 }
 
+/// \brief Return the directory in which this writes its PDB files
+path_opt pdb_files_superposition_outputter::do_get_output_path() const {
+	return output_dir;
+}
+
 /// \brief Getter for the name of this superposition_outputter
 string pdb_files_superposition_outputter::do_get_name() const {
 	return "pdb_files_superposition_outputter";
 }
 
 /// \brief Ctor for pdb_files_superposition_outputter
-pdb_files_superposition_outputter::pdb_files_superposition_outputter(const path                 &prm_output_dir,  ///< TODOCUMENT
-                                                                     superposition_content_spec  prm_content_spec ///< The specification of what should be included in the superposition
+pdb_files_superposition_outputter::pdb_files_superposition_outputter(const path                 &prm_output_dir,   ///< TODOCUMENT
+                                                                     superposition_content_spec  prm_content_spec, ///< The specification of what should be included in the superposition
+                                                                     const size_t               &prm_num_threads   ///< The number of threads with which to write the files (or 0 to use one per hardware thread)
                                                                      ) : output_dir  { prm_output_dir                },
-                                                                         content_spec{ std::move( prm_content_spec ) } {
+                                                                         content_spec{ std::move( prm_content_spec ) },
+                                                                         num_threads { prm_num_threads               } {
 }
 
+/// \brief Get the number of threads with which to write the files
+///
+/// If num_threads is 0, this returns the hardware concurrency (or 1 if that isn't available)
+size_t pdb_files_superposition_outputter::get_num_threads() const {
+	return num_threads_or_hardware( num_threads );
+}
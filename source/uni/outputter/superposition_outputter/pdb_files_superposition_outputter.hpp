@@ -38,16 +38,24 @@ namespace cath {
 			/// \brief The specification of what should be included in the superposition
 			sup::superposition_content_spec content_spec;
 
+			/// \brief The number of threads with which to write the files
+			///        (or 0 to use one per hardware thread)
+			size_t num_threads;
+
 			std::unique_ptr<superposition_outputter> do_clone() const final;
 			void do_output_superposition(const sup::superposition_context &,
 			                             std::ostream &,
 			                             const boost::string_ref &) const final;
 			bool do_involves_display_spec() const final;
+			path_opt do_get_output_path() const final;
 			std::string do_get_name() const final;
 
 		public:
 			pdb_files_superposition_outputter(const boost::filesystem::path &,
-			                                  sup::superposition_content_spec);
+			                                  sup::superposition_content_spec,
+			                                  const size_t & = 1);
+
+			size_t get_num_threads() const;
 		};
 
 	} // namespace opts
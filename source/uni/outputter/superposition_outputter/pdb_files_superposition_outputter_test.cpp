@@ -20,23 +20,75 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <boost/filesystem.hpp>
+
+#include "common/file/read_string_from_file.hpp"
+#include "common/file/temp_file.hpp"
+#include "file/name_set/name_set_list.hpp"
+#include "file/options/data_dirs_options_block.hpp"
+#include "outputter/superposition_outputter/pdb_files_superposition_outputter.hpp"
+#include "test/superposition_fixture.hpp"
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::opts;
+using namespace cath::sup;
+
+using boost::filesystem::create_directory;
+using boost::filesystem::path;
+using boost::filesystem::remove_all;
+using std::ostringstream;
+using std::string;
+
 namespace cath {
 	namespace test {
 
 		/// \brief The pdb_files_superposition_outputter_test_suite_fixture to assist in testing pdb_files_superposition_outputter
-		struct pdb_files_superposition_outputter_test_suite_fixture {
+		struct pdb_files_superposition_outputter_test_suite_fixture : protected sup::superposition_fixture {
 		protected:
 			~pdb_files_superposition_outputter_test_suite_fixture() noexcept = default;
+
+			/// \brief The example superposition_context with its PDBs loaded
+			const superposition_context loaded_sup_con = load_pdbs_from_names_copy(
+				the_sup_con,
+				build_data_dirs_spec_of_dir( TEST_SOURCE_DATA_DIR() )
+			);
+
+			/// \brief Write the loaded superposition with a pdb_files_superposition_outputter using the specified
+			///        number of threads and return the contents of the files, concatenated in entry order
+			string superposed_files_contents(const size_t &prm_num_threads ///< The number of threads with which to write the files
+			                                 ) const {
+				const temp_file out_dir_file{ ".pdb_files_superposition_outputter_test.%%%%-%%%%-%%%%-%%%%" };
+				const path      out_dir = get_filename( out_dir_file );
+				BOOST_REQUIRE( create_directory( out_dir ) );
+
+				ostringstream dummy_ss;
+				pdb_files_superposition_outputter{ out_dir, superposition_content_spec{}, prm_num_threads }
+					.output_superposition( loaded_sup_con, dummy_ss, "" );
+
+				string contents;
+				for (const string &file_name : get_supn_pdb_file_names( get_name_sets( loaded_sup_con ) ) ) {
+					contents += read_string_from_file( out_dir / file_name );
+				}
+				remove_all( out_dir );
+				return contents;
+			}
 		};
 
-	}
-}  // namespace cath
+	} // namespace test
+} // namespace cath
 
 BOOST_FIXTURE_TEST_SUITE(pdb_files_superposition_outputter_test_suite, cath::test::pdb_files_superposition_outputter_test_suite_fixture)
 
-/// \brief TODOCUMENT
-BOOST_AUTO_TEST_CASE(basic) {
-	BOOST_CHECK( true );
+BOOST_AUTO_TEST_CASE(uses_hardware_concurrency_for_zero_threads) {
+	BOOST_CHECK_EQUAL  ( pdb_files_superposition_outputter( "", superposition_content_spec{}, 3 ).get_num_threads(), 3 );
+	BOOST_CHECK_GE     ( pdb_files_superposition_outputter( "", superposition_content_spec{}    ).get_num_threads(), 1 );
 }
-BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_CASE(writes_same_files_whatever_the_number_of_threads) {
+	const string single_threaded_contents = superposed_files_contents( 1 );
+	BOOST_CHECK( ! single_threaded_contents.empty() );
+	BOOST_CHECK_EQUAL( superposed_files_contents( 3 ), single_threaded_contents );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
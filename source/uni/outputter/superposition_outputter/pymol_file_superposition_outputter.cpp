@@ -20,10 +20,13 @@
 
 #include "pymol_file_superposition_outputter.hpp"
 
+#include <boost/optional.hpp>
+
 #include "common/clone/make_uptr_clone.hpp"
 #include "display/viewer/pymol_viewer.hpp"
 #include "superposition/superposition_context.hpp"
 
+using namespace cath;
 using namespace cath::common;
 using namespace cath::opts;
 using namespace cath::sup;
@@ -61,6 +64,11 @@ bool pymol_file_superposition_outputter::do_involves_display_spec() const {
 	return true;
 }
 
+/// \brief Return the PyMOL script file to which this writes
+path_opt pymol_file_superposition_outputter::do_get_output_path() const {
+	return output_file;
+}
+
 /// \brief Getter for the name of this superposition_outputter
 string pymol_file_superposition_outputter::do_get_name() const {
 	return "pymol_file_superposition_outputter";
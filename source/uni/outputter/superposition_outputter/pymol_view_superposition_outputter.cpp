@@ -21,6 +21,7 @@
 #include "pymol_view_superposition_outputter.hpp"
 
 #include <boost/log/trivial.hpp>
+#include <boost/optional.hpp>
 
 #include "common/clone/make_uptr_clone.hpp"
 #include "common/command_executer.hpp"
@@ -29,11 +30,13 @@
 
 #include <iostream>
 
+using namespace cath;
 using namespace cath::common;
 using namespace cath::opts;
 using namespace cath::sup;
 
 using boost::filesystem::path;
+using boost::none;
 using boost::string_ref;
 using std::ostream;
 using std::string;
@@ -71,6 +74,11 @@ bool pymol_view_superposition_outputter::do_involves_display_spec() const {
 	return true;
 }
 
+/// \brief Return none because this launches a viewer rather than writing to its own file
+path_opt pymol_view_superposition_outputter::do_get_output_path() const {
+	return none;
+}
+
 /// \brief Getter for the name of this superposition_outputter
 string pymol_view_superposition_outputter::do_get_name() const {
 	return "pymol_view_superposition_outputter";
@@ -20,11 +20,14 @@
 
 #include "superposition_outputter.hpp"
 
+#include <boost/optional.hpp>
+
 #include "common/clone/check_uptr_clone_against_this.hpp"
 
 #include <cassert>
 #include <typeinfo>
 
+using namespace cath;
 using namespace cath::common;
 using namespace cath::opts;
 using namespace cath::sup;
@@ -54,3 +57,9 @@ void superposition_outputter::output_superposition(const superposition_context &
 bool superposition_outputter::involves_display_spec() const {
 	return do_involves_display_spec();
 }
+
+/// \brief NVI pass-through to the file or directory to which the concrete superposition_outputter writes
+///        (or none if it doesn't write to its own file/directory)
+path_opt superposition_outputter::get_output_path() const {
+	return do_get_output_path();
+}
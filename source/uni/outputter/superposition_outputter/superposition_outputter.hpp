@@ -23,6 +23,8 @@
 
 #include <boost/utility/string_ref_fwd.hpp>
 
+#include "common/path_type_aliases.hpp"
+
 #include <iosfwd>
 #include <memory>
 
@@ -45,6 +47,10 @@ namespace cath {
 			/// \brief TODOCUMENT
 			virtual bool do_involves_display_spec() const = 0;
 
+			/// \brief Pure virtual method with which each concrete superposition_outputter must define the file
+			///        or directory to which it writes (or none if it doesn't write to its own file/directory)
+			virtual path_opt do_get_output_path() const = 0;
+
 			/// \brief Pure virtual method with which each concrete superposition_outputter must define its name
 			virtual std::string do_get_name() const = 0;
 
@@ -62,6 +68,7 @@ namespace cath {
 			                          std::ostream &,
 			                          const boost::string_ref &) const;
 			bool involves_display_spec() const;
+			path_opt get_output_path() const;
 
 			std::string get_name() const;
 		};
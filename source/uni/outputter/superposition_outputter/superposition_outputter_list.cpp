@@ -22,12 +22,15 @@
 
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/optional.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
 #include "common/boost_addenda/ptr_container/unique_ptr_functions.hpp"
 #include "common/cpp14/cbegin_cend.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
 #include "outputter/superposition_outputter/superposition_outputter.hpp"
 
+using namespace cath::common;
 using namespace cath::opts;
 using namespace cath::sup;
 
@@ -38,9 +41,24 @@ using boost::string_ref;
 using std::ostream;
 using std::string;
 
-/// \brief TODOCUMENT
-void superposition_outputter_list::push_back(const superposition_outputter &prm_outputter ///< TODOCUMENT
+/// \brief Add a copy of the specified superposition_outputter to the list
+///
+/// This rejects an outputter that would write to the same file or directory as one already in the list
+/// because their outputs would clobber each other
+void superposition_outputter_list::push_back(const superposition_outputter &prm_outputter ///< The superposition_outputter to add
                                              ) {
+	const path_opt output_path = prm_outputter.get_output_path();
+	if ( output_path ) {
+		const bool path_already_used = any_of( outputters, [&] (const superposition_outputter &x) {
+			const path_opt x_output_path = x.get_output_path();
+			return x_output_path && x_output_path->lexically_normal() == output_path->lexically_normal();
+		} );
+		if ( path_already_used ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception(
+				"Cannot use more than one superposition outputter to write to " + output_path->string()
+			));
+		}
+	}
 	cath::common::push_back( outputters, prm_outputter.clone() );
 }
 
@@ -20,13 +20,37 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "common/exception/invalid_argument_exception.hpp"
+#include "common/file/read_string_from_file.hpp"
+#include "common/file/temp_file.hpp"
+#include "common/size_t_literal.hpp"
+#include "file/options/data_dirs_options_block.hpp"
+#include "outputter/superposition_outputter/ostream_superposition_outputter.hpp"
+#include "outputter/superposition_outputter/pdb_file_superposition_outputter.hpp"
+#include "outputter/superposition_outputter/superposition_outputter_list.hpp"
+#include "test/superposition_fixture.hpp"
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::opts;
+using namespace cath::sup;
+
+using std::ostringstream;
+using std::string;
+
 namespace cath {
 	namespace test {
 
 		/// \brief The superposition_outputter_list_test_suite_fixture to assist in testing superposition_outputter_list
-		struct superposition_outputter_list_test_suite_fixture {
+		struct superposition_outputter_list_test_suite_fixture : protected sup::superposition_fixture {
 		protected:
 			~superposition_outputter_list_test_suite_fixture() noexcept = default;
+
+			/// \brief The example superposition_context with its PDBs loaded
+			const superposition_context loaded_sup_con = load_pdbs_from_names_copy(
+				the_sup_con,
+				build_data_dirs_spec_of_dir( TEST_SOURCE_DATA_DIR() )
+			);
 		};
 
 	}
@@ -34,10 +58,36 @@ namespace cath {
 
 BOOST_FIXTURE_TEST_SUITE(superposition_outputter_list_test_suite, cath::test::superposition_outputter_list_test_suite_fixture)
 
-/// \brief TODOCUMENT
-BOOST_AUTO_TEST_CASE(basic) {
-	BOOST_CHECK( true );
+BOOST_AUTO_TEST_CASE(file_and_ostream_outputters_give_same_output_as_when_used_alone) {
+	const temp_file pdb_file_1{ ".superposition_outputter_list_test.%%%%-%%%%-%%%%-%%%%.pdb" };
+	const temp_file pdb_file_2{ ".superposition_outputter_list_test.%%%%-%%%%-%%%%-%%%%.pdb" };
+
+	ostringstream alone_ss;
+	ostream_superposition_outputter{ superposition_content_spec{} }.output_superposition( loaded_sup_con, alone_ss, "" );
+
+	superposition_outputter_list the_outputters;
+	the_outputters.push_back( pdb_file_superposition_outputter{ get_filename( pdb_file_1 ), superposition_content_spec{} } );
+	the_outputters.push_back( ostream_superposition_outputter { superposition_content_spec{} } );
+	the_outputters.push_back( ostream_superposition_outputter { superposition_content_spec{} } );
+	the_outputters.push_back( pdb_file_superposition_outputter{ get_filename( pdb_file_2 ), superposition_content_spec{} } );
+
+	ostringstream stdout_ss;
+	ostringstream stderr_ss;
+	use_all_superposition_outputters( the_outputters, loaded_sup_con, stdout_ss, stderr_ss, "" );
+
+	BOOST_CHECK( ! alone_ss.str().empty() );
+	BOOST_CHECK_EQUAL( stdout_ss.str(),                                        alone_ss.str() + alone_ss.str() );
+	BOOST_CHECK_EQUAL( read_string_from_file( get_filename( pdb_file_1 ) ), alone_ss.str()                  );
+	BOOST_CHECK_EQUAL( read_string_from_file( get_filename( pdb_file_2 ) ), alone_ss.str()                  );
 }
 
-BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_CASE(rejects_two_outputters_writing_to_the_same_file) {
+	superposition_outputter_list the_outputters;
+	the_outputters.push_back( pdb_file_superposition_outputter{ "dir/file.pdb", superposition_content_spec{} } );
+	the_outputters.push_back( ostream_superposition_outputter { superposition_content_spec{} } );
+	the_outputters.push_back( ostream_superposition_outputter { superposition_content_spec{} } );
+	BOOST_CHECK_THROW( the_outputters.push_back( pdb_file_superposition_outputter{ "dir/./file.pdb", superposition_content_spec{} } ), invalid_argument_exception );
+	BOOST_CHECK_EQUAL( the_outputters.size(), 3_z );
+}
 
+BOOST_AUTO_TEST_SUITE_END()
@@ -115,12 +115,18 @@ namespace cath {
 			}
 		}
 
+		/// \brief Scan the specified lattice for neighbours of the residues in the specified range of
+		///        indices of the specified PDB
+		///
+		/// This allows the residues of a PDB to be scanned in separate blocks (eg on separate threads)
 		template <typename Fn>
-		void scan_sparse_lattice(const locn_index_store &prm_store,     ///< TODOCUMENT
-		                         const file::pdb        &prm_pdb,       ///< TODOCUMENT
-		                         const float            &prm_cell_size, ///< TODOCUMENT
-		                         const float            &prm_max_dist,  ///< TODOCUMENT
-		                         Fn                      prm_fn         ///< TODOCUMENT
+		void scan_sparse_lattice(const locn_index_store &prm_store,     ///< The lattice of the PDB's residues
+		                         const file::pdb        &prm_pdb,       ///< The PDB whose residues should be scanned
+		                         const size_t           &prm_begin_idx, ///< The index of the first residue to scan
+		                         const size_t           &prm_end_idx,   ///< One past the index of the last residue to scan
+		                         const float            &prm_cell_size, ///< The cell size with which the lattice was built
+		                         const float            &prm_max_dist,  ///< The maximum distance between neighbours
+		                         Fn                      prm_fn         ///< The function to call on each pair of neighbours
 		                         ) {
 			const auto the_keyer = make_res_pair_keyer(
 				simple_locn_x_keyer_part{ prm_cell_size },
@@ -132,7 +138,7 @@ namespace cath {
 			const float max_squared_dist = prm_max_dist * prm_max_dist;
 			const simple_locn_crit the_crit{ max_squared_dist };
 
-			for (const size_t &the_res_idx : common::indices( prm_pdb.get_num_residues() ) ) {
+			for (size_t the_res_idx = prm_begin_idx; the_res_idx < prm_end_idx; ++the_res_idx) {
 				const auto &the_res = prm_pdb.get_residue_of_index__backbone_unchecked( the_res_idx );
 				const auto  data    = make_simple_locn_index_of_ca( the_res, debug_numeric_cast<unsigned int>( the_res_idx ) );
 				for (const auto &key : common::cross( the_keyer.make_close_keys( data, the_crit ) ) ) {
@@ -148,6 +154,24 @@ namespace cath {
 			}
 		}
 
+		template <typename Fn>
+		void scan_sparse_lattice(const locn_index_store &prm_store,     ///< TODOCUMENT
+		                         const file::pdb        &prm_pdb,       ///< TODOCUMENT
+		                         const float            &prm_cell_size, ///< TODOCUMENT
+		                         const float            &prm_max_dist,  ///< TODOCUMENT
+		                         Fn                      prm_fn         ///< TODOCUMENT
+		                         ) {
+			scan_sparse_lattice(
+				prm_store,
+				prm_pdb,
+				0,
+				prm_pdb.get_num_residues(),
+				prm_cell_size,
+				prm_max_dist,
+				prm_fn
+			);
+		}
+
 		template <typename Fn>
 		void scan_dense_lattice(const locn_index_store &prm_store,     ///< TODOCUMENT
 		                        const protein          &prm_protein,   ///< TODOCUMENT
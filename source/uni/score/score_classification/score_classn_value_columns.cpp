@@ -0,0 +1,437 @@
+/// \file
+/// \brief The score_classn_value_columns class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "score_classn_value_columns.hpp"
+
+#include <boost/range/algorithm/lower_bound.hpp>
+#include <boost/range/algorithm/sort.hpp>
+
+#include "common/algorithm/parallel_for_blocks.hpp"
+#include "common/boost_addenda/range/indices.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
+#include "common/size_t_literal.hpp"
+#include "score/score_classification/score_classn_value.hpp"
+#include "score/score_classification/score_classn_value_list.hpp"
+#include "score/score_classification/score_classn_value_results_set.hpp"
+#include "score/true_pos_false_neg/classn_rate_stat.hpp"
+#include "score/true_pos_false_neg/classn_stat.hpp"
+#include "score/true_pos_false_neg/classn_stat_pair_series.hpp"
+#include "score/true_pos_false_neg/classn_stat_pair_series_list.hpp"
+#include "score/true_pos_false_neg/named_true_false_pos_neg_list.hpp"
+#include "score/true_pos_false_neg/named_true_false_pos_neg_list_list.hpp"
+#include "score/true_pos_false_neg/true_false_pos_neg.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+using namespace cath;
+using namespace cath::common;
+using namespace cath::score;
+
+using boost::range::lower_bound;
+using boost::range::sort;
+using std::iota;
+using std::make_pair;
+using std::string;
+using std::vector;
+
+namespace {
+
+	/// \brief Call the specified function on each of the true_false_pos_neg values for the specified score
+	///        in order (ie the initial one, with no predicted positives, followed by one for each group
+	///        of equal values from best to worst)
+	///
+	/// This sorts the instance ids once on the score's values and then streams through them.
+	/// The true_false_pos_neg values are the same as those make_named_true_false_pos_neg_list() generates
+	/// from an equivalent score_classn_value_list.
+	template <typename Fn>
+	void for_each_true_false_pos_neg(const score_classn_value_columns &prm_columns,   ///< The score_classn_value_columns to query
+	                                 const size_t                     &prm_score_idx, ///< The index of the score to evaluate
+	                                 Fn                              &&prm_fn         ///< The function to call on each true_false_pos_neg
+	                                 ) {
+		const doub_vec &values           = prm_columns.get_values          ( prm_score_idx );
+		const bool      higher_is_better = prm_columns.get_higher_is_better( prm_score_idx );
+		const size_t    num_instances    = prm_columns.get_num_instances();
+		const auto      better_than      = [&] (const size_t &x, const size_t &y) {
+			return higher_is_better ? ( values[ x ] > values[ y ] )
+			                        : ( values[ x ] < values[ y ] );
+		};
+
+		// Sort the instance ids from best value to worst
+		size_vec sorted_ids( num_instances );
+		iota( sorted_ids.begin(), sorted_ids.end(), 0_z );
+		sort( sorted_ids, better_than );
+
+		// Initialise running_tfpn_counts to have no positives and the correct number of true/false negatives
+		size_t total_num_positives = 0;
+		for (const size_t &id : indices( num_instances ) ) {
+			total_num_positives += ( prm_columns.get_instance_is_positive( id ) ? 1_z : 0_z );
+		}
+		auto running_tfpn_counts = true_false_pos_neg{ 0, num_instances - total_num_positives, 0, total_num_positives };
+		prm_fn( running_tfpn_counts );
+
+		// Stream through the groups of equal values (which, as in equal_grouped( better_than ),
+		// are separated wherever one value is strictly better than the next)
+		size_t group_begin = 0;
+		while ( group_begin < num_instances ) {
+			size_t group_end     = group_begin + 1;
+			size_t num_positives = prm_columns.get_instance_is_positive( sorted_ids[ group_begin ] ) ? 1_z : 0_z;
+			while ( group_end < num_instances && ! better_than( sorted_ids[ group_end - 1 ], sorted_ids[ group_end ] ) ) {
+				num_positives += ( prm_columns.get_instance_is_positive( sorted_ids[ group_end ] ) ? 1_z : 0_z );
+				++group_end;
+			}
+			update_with_predicted_positives( running_tfpn_counts, num_positives, ( group_end - group_begin ) - num_positives );
+			prm_fn( running_tfpn_counts );
+			group_begin = group_end;
+		}
+	}
+
+	/// \brief Build a vector of the results of calling the specified function on the index of each score
+	///        in the specified score_classn_value_columns, using up to the specified number of threads
+	///
+	/// The scores are split into contiguous blocks, one per thread
+	template <typename Vec, typename Fn>
+	Vec transform_build_over_scores(const score_classn_value_columns &prm_columns,     ///< The score_classn_value_columns to query
+	                                const size_t                     &prm_num_threads, ///< The number of threads to use (or 0 to use one per hardware thread)
+	                                Fn                              &&prm_fn           ///< The function to call on the index of each score
+	                                ) {
+		using value_t = typename Vec::value_type;
+		const size_t num_scores = prm_columns.size();
+
+		vector<Vec> block_results = parallel_transform_blocks(
+			num_scores,
+			prm_num_threads,
+			[&] (const size_t &prm_begin_idx, const size_t &prm_end_idx) {
+				Vec block_result;
+				block_result.reserve( prm_end_idx - prm_begin_idx );
+				for (size_t score_ctr = prm_begin_idx; score_ctr < prm_end_idx; ++score_ctr) {
+					block_result.push_back( prm_fn( score_ctr ) );
+				}
+				return block_result;
+			}
+		);
+		if ( block_results.size() == 1 ) {
+			return std::move( block_results.front() );
+		}
+
+		Vec results;
+		results.reserve( num_scores );
+		for (Vec &block_result : block_results) {
+			for (value_t &value : block_result) {
+				results.push_back( std::move( value ) );
+			}
+		}
+		return results;
+	}
+
+} // namespace
+
+/// \brief Get the index at which a score of the specified name should be inserted
+///        (or throw if there's already a score of that name)
+size_t score_classn_value_columns::index_of_new_name(const string &prm_name ///< The name of the new score
+                                                     ) const {
+	const auto insert_itr = lower_bound( names, prm_name );
+	if ( insert_itr != names.end() && *insert_itr == prm_name ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot add score \"" + prm_name + "\" to score_classn_value_columns because it already contains a score of that name"));
+	}
+	return static_cast<size_t>( std::distance( names.begin(), insert_itr ) );
+}
+
+/// \brief Whether this score_classn_value_columns has no scores
+bool score_classn_value_columns::empty() const {
+	return names.empty();
+}
+
+/// \brief The number of scores in this score_classn_value_columns
+size_t score_classn_value_columns::size() const {
+	return names.size();
+}
+
+/// \brief The number of instances in this score_classn_value_columns
+size_t score_classn_value_columns::get_num_instances() const {
+	return instance_labels.size();
+}
+
+/// \brief Get the label of the instance with the specified id
+const string & score_classn_value_columns::get_instance_label(const size_t &prm_id ///< The id of the instance to query
+                                                              ) const {
+	return instance_labels[ prm_id ];
+}
+
+/// \brief Get whether the instance with the specified id is positive
+bool score_classn_value_columns::get_instance_is_positive(const size_t &prm_id ///< The id of the instance to query
+                                                          ) const {
+	return ( instance_is_positives[ prm_id ] != 0 );
+}
+
+/// \brief Get the id of the instance with the specified label
+///
+/// \pre There must be an instance with the specified label else an invalid_argument_exception is thrown
+size_t score_classn_value_columns::get_id_of_instance_label(const string &prm_label ///< The label of the instance to find
+                                                            ) const {
+	const auto find_itr = id_of_instance_label.find( prm_label );
+	if ( find_itr == id_of_instance_label.end() ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("No instance found in score_classn_value_columns with label \"" + prm_label + "\""));
+	}
+	return find_itr->second;
+}
+
+/// \brief Get the name of the score at the specified index
+const string & score_classn_value_columns::get_name(const size_t &prm_index ///< The index of the score to query
+                                                    ) const {
+	return names[ prm_index ];
+}
+
+/// \brief Get whether a higher value is better for the score at the specified index
+bool score_classn_value_columns::get_higher_is_better(const size_t &prm_index ///< The index of the score to query
+                                                      ) const {
+	return ( higher_is_betters[ prm_index ] != 0 );
+}
+
+/// \brief Get the values (indexed by instance id) of the score at the specified index
+const doub_vec & score_classn_value_columns::get_values(const size_t &prm_index ///< The index of the score to query
+                                                        ) const {
+	return values[ prm_index ];
+}
+
+/// \brief Add the scores from the specified score_classn_value_list as a new column,
+///        using the specified value for any instances that the list is missing
+///
+/// This is the columnar equivalent of add_score_classn_value_list_and_add_missing().
+/// If this is the first score to be added, its instances become the instances of this
+/// score_classn_value_columns.
+///
+/// This throws an invalid_argument_exception if there's already a score with the list's name,
+/// if the list contains repeated instance labels or if it contains instances that aren't
+/// already present (or that are present but with a different positive/negative status)
+score_classn_value_columns & score_classn_value_columns::add_score_classn_value_list(const score_classn_value_list &prm_score_classn_value_list, ///< The score_classn_value_list to add
+                                                                                    const double                  &prm_score_for_missing        ///< The value to use for any instances that prm_score_classn_value_list is missing
+                                                                                    ) {
+	const string  name         = prm_score_classn_value_list.get_name();
+	const size_t  insert_index = index_of_new_name( name );
+	const bool    is_first     = empty();
+
+	if ( is_first ) {
+		instance_labels.clear();
+		instance_is_positives.clear();
+		id_of_instance_label.clear();
+		for (const score_classn_value &the_value : prm_score_classn_value_list) {
+			const string &label = the_value.get_instance_label();
+			if ( ! id_of_instance_label.emplace( label, instance_labels.size() ).second ) {
+				BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot add score_classn_value_list to score_classn_value_columns because it contains a repeated instance label \"" + label + "\""));
+			}
+			instance_labels.push_back( label );
+			instance_is_positives.push_back( the_value.get_instance_is_positive() ? 1 : 0 );
+		}
+	}
+
+	doub_vec   new_values( get_num_instances(), prm_score_for_missing );
+	char_vec   seen      ( get_num_instances(), 0                     );
+	for (const score_classn_value &the_value : prm_score_classn_value_list) {
+		const string &label    = the_value.get_instance_label();
+		const auto    find_itr = id_of_instance_label.find( label );
+		if ( find_itr == id_of_instance_label.end() ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot add score_classn_value_list to score_classn_value_columns because it contains an extra instance label \"" + label + "\""));
+		}
+		const size_t &id = find_itr->second;
+		if ( seen[ id ] != 0 ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot add score_classn_value_list to score_classn_value_columns because it contains a repeated instance label \"" + label + "\""));
+		}
+		if ( the_value.get_instance_is_positive() != get_instance_is_positive( id ) ) {
+			BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot add score_classn_value_list to score_classn_value_columns because it conflicts about whether instance \"" + label + "\" is positive"));
+		}
+		seen      [ id ] = 1;
+		new_values[ id ] = the_value.get_score_value();
+	}
+
+	const char new_higher_is_better = cath::score::get_higher_is_better( prm_score_classn_value_list ) ? 1 : 0;
+	const auto insert_offset        = static_cast<ptrdiff_t>( insert_index );
+	names.insert            ( std::next( names.begin(),             insert_offset ), name                    );
+	higher_is_betters.insert( std::next( higher_is_betters.begin(), insert_offset ), new_higher_is_better    );
+	values.insert           ( std::next( values.begin(),            insert_offset ), std::move( new_values ) );
+	return *this;
+}
+
+/// \brief Make a score_classn_value_columns from the specified score_classn_value_lists, filling in any
+///        missing instances with the worst possible score (as make_score_classn_value_results_set() does)
+///
+/// \relates score_classn_value_columns
+score_classn_value_columns cath::score::make_score_classn_value_columns(const score_classn_value_list_vec &prm_score_classn_value_lists ///< The score_classn_value_lists from which to build the score_classn_value_columns
+                                                                        ) {
+	score_classn_value_columns new_columns;
+	for (const score_classn_value_list &scv_list : prm_score_classn_value_lists) {
+		new_columns.add_score_classn_value_list( scv_list, worst_possible_score( scv_list ) );
+	}
+	return new_columns;
+}
+
+/// \brief Make a score_classn_value_columns from the data in the specified score_classn_value_results_set
+///
+/// \relates score_classn_value_columns
+score_classn_value_columns cath::score::make_score_classn_value_columns(const score_classn_value_results_set &prm_results_set ///< The score_classn_value_results_set from which to build the score_classn_value_columns
+                                                                        ) {
+	return make_score_classn_value_columns( make_score_classn_value_list_vec( prm_results_set ) );
+}
+
+/// \brief Make the named_true_false_pos_neg_list for the score at the specified index
+///
+/// \relates score_classn_value_columns
+named_true_false_pos_neg_list cath::score::make_named_true_false_pos_neg_list(const score_classn_value_columns &prm_columns,  ///< The score_classn_value_columns to query
+                                                                              const size_t                     &prm_score_idx ///< The index of the score to evaluate
+                                                                              ) {
+	true_false_pos_neg_vec tfpns;
+	for_each_true_false_pos_neg(
+		prm_columns,
+		prm_score_idx,
+		[&] (const true_false_pos_neg &x) { tfpns.push_back( x ); }
+	);
+	return { tfpns, prm_columns.get_name( prm_score_idx ) };
+}
+
+/// \brief Make the named_true_false_pos_neg_list_list for all the scores, evaluating different scores on up to
+///        the specified number of threads
+///
+/// \relates score_classn_value_columns
+named_true_false_pos_neg_list_list cath::score::make_named_true_false_pos_neg_list_list(const score_classn_value_columns &prm_columns,    ///< The score_classn_value_columns to query
+                                                                                        const size_t                     &prm_num_threads ///< The number of threads to use (or 0 to use one per hardware thread)
+                                                                                        ) {
+	return named_true_false_pos_neg_list_list{
+		transform_build_over_scores<named_true_false_pos_neg_list_vec>(
+			prm_columns,
+			prm_num_threads,
+			[&] (const size_t &x) {
+				return make_named_true_false_pos_neg_list( prm_columns, x );
+			}
+		)
+	};
+}
+
+/// \brief Make the classn_stat_pair_series_list of the specified pair of statistics for all the scores,
+///        evaluating different scores on up to the specified number of threads
+///
+/// \relates score_classn_value_columns
+classn_stat_pair_series_list cath::score::make_classn_stat_pair_series_list(const score_classn_value_columns &prm_columns,       ///< The score_classn_value_columns to query
+                                                                            const classn_stat                &prm_classn_stat_a, ///< The statistic for the first  (x-axis) of each pair
+                                                                            const classn_stat                &prm_classn_stat_b, ///< The statistic for the second (y-axis) of each pair
+                                                                            const size_t                     &prm_num_threads    ///< The number of threads to use (or 0 to use one per hardware thread)
+                                                                            ) {
+	return classn_stat_pair_series_list{
+		transform_build_over_scores<classn_stat_pair_series_vec>(
+			prm_columns,
+			prm_num_threads,
+			[&] (const size_t &x) {
+				doub_doub_pair_vec data;
+				for_each_true_false_pos_neg(
+					prm_columns,
+					x,
+					[&] (const true_false_pos_neg &y) {
+						data.emplace_back(
+							calculate_and_convert( prm_classn_stat_a, y ),
+							calculate_and_convert( prm_classn_stat_b, y )
+						);
+					}
+				);
+				return classn_stat_pair_series{ std::move( data ), prm_columns.get_name( x ) };
+			}
+		)
+	};
+}
+
+/// \brief Make the ROC series for all the scores, evaluating different scores on up to the specified number of threads
+///
+/// \relates score_classn_value_columns
+classn_stat_pair_series_list cath::score::make_roc_series_list(const score_classn_value_columns &prm_columns,    ///< The score_classn_value_columns to query
+                                                               const size_t                     &prm_num_threads ///< The number of threads to use (or 0 to use one per hardware thread)
+                                                               ) {
+	return make_classn_stat_pair_series_list(
+		prm_columns,
+		roc_rates::first_type(),
+		roc_rates::second_type(),
+		prm_num_threads
+	);
+}
+
+/// \brief Make the precision-recall series for all the scores, evaluating different scores on up to the specified number of threads
+///
+/// \relates score_classn_value_columns
+classn_stat_pair_series_list cath::score::make_precision_recall_series_list(const score_classn_value_columns &prm_columns,    ///< The score_classn_value_columns to query
+                                                                            const size_t                     &prm_num_threads ///< The number of threads to use (or 0 to use one per hardware thread)
+                                                                            ) {
+	return make_classn_stat_pair_series_list(
+		prm_columns,
+		precision_recall_rates::first_type(),
+		precision_recall_rates::second_type(),
+		prm_num_threads
+	);
+}
+
+/// \brief Calculate the area under the curve of the specified pair of statistics for each of the scores,
+///        evaluating different scores on up to the specified number of threads
+///
+/// This accumulates each area in the same pass that generates the curve's points, without storing them
+///
+/// \relates score_classn_value_columns
+str_doub_pair_vec cath::score::areas_under_curves(const score_classn_value_columns &prm_columns,       ///< The score_classn_value_columns to query
+                                                  const classn_stat                &prm_classn_stat_x, ///< The statistic for the x-axis
+                                                  const classn_stat                &prm_classn_stat_y, ///< The statistic for the y-axis
+                                                  const size_t                     &prm_num_threads    ///< The number of threads to use (or 0 to use one per hardware thread)
+                                                  ) {
+	return transform_build_over_scores<str_doub_pair_vec>(
+		prm_columns,
+		prm_num_threads,
+		[&] (const size_t &x) {
+			double         area = 0.0;
+			doub_doub_pair prev_point;
+			bool           is_first = true;
+			for_each_true_false_pos_neg(
+				prm_columns,
+				x,
+				[&] (const true_false_pos_neg &y) {
+					const doub_doub_pair point{
+						calculate_and_convert( prm_classn_stat_x, y ),
+						calculate_and_convert( prm_classn_stat_y, y )
+					};
+					if ( ! is_first ) {
+						area += area_under_curve_segment( prev_point, point );
+					}
+					prev_point = point;
+					is_first   = false;
+				}
+			);
+			return make_pair( prm_columns.get_name( x ), area );
+		}
+	);
+}
+
+/// \brief Calculate the area under the ROC curve for each of the scores,
+///        evaluating different scores on up to the specified number of threads
+///
+/// \relates score_classn_value_columns
+str_doub_pair_vec cath::score::areas_under_roc_curves(const score_classn_value_columns &prm_columns,    ///< The score_classn_value_columns to query
+                                                      const size_t                     &prm_num_threads ///< The number of threads to use (or 0 to use one per hardware thread)
+                                                      ) {
+	return areas_under_curves(
+		prm_columns,
+		roc_rates::first_type(),
+		roc_rates::second_type(),
+		prm_num_threads
+	);
+}
@@ -0,0 +1,131 @@
+/// \file
+/// \brief The score_classn_value_columns class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_UNI_SCORE_SCORE_CLASSIFICATION_SCORE_CLASSN_VALUE_COLUMNS_HPP
+#define _CATH_TOOLS_SOURCE_UNI_SCORE_SCORE_CLASSIFICATION_SCORE_CLASSN_VALUE_COLUMNS_HPP
+
+#include "common/type_aliases.hpp"
+#include "score/score_type_aliases.hpp"
+
+#include <string>
+#include <unordered_map>
+
+namespace cath { namespace score { class classn_stat; } }
+namespace cath { namespace score { class classn_stat_pair_series_list; } }
+namespace cath { namespace score { class named_true_false_pos_neg_list; } }
+namespace cath { namespace score { class named_true_false_pos_neg_list_list; } }
+namespace cath { namespace score { class score_classn_value_list; } }
+namespace cath { namespace score { class score_classn_value_results_set; } }
+
+namespace cath {
+	namespace score {
+
+		/// \brief Store the values of a number of scores over the same set of labelled instances
+		///        in a columnar layout for fast batch evaluation (eg ROC / precision-recall)
+		///
+		/// This holds the same data as a score_classn_value_results_set but rather than storing
+		/// a sorted score_classn_value_list (with a copy of each instance label) for each score, it:
+		///  * interns each instance label to an id (its index in instance_labels) and
+		///  * stores each score's values in a contiguous doub_vec, indexed by those ids.
+		///
+		/// The evaluation functions (eg make_named_true_false_pos_neg_list_list()) then just
+		/// sort the ids once per score and stream through them, and can evaluate different scores
+		/// on different threads. They give exactly the same results as the equivalent
+		/// score_classn_value_results_set functions.
+		///
+		/// Invariants:
+		///  * the scores are kept sorted and uniqued on their names (as in score_classn_value_results_set)
+		///  * every score has a value for every instance
+		class score_classn_value_columns final {
+		private:
+			/// \brief The label of each instance, indexed by the instance's id
+			str_vec instance_labels;
+
+			/// \brief Whether each instance is positive (1) or negative (0), indexed by the instance's id
+			///
+			/// This is a char_vec rather than a std::vector<bool> so that it's contiguous and
+			/// safe to read from multiple threads
+			char_vec instance_is_positives;
+
+			/// \brief A map from each instance label to its id
+			std::unordered_map<std::string, size_t> id_of_instance_label;
+
+			/// \brief The name of each score
+			str_vec names;
+
+			/// \brief Whether a higher value is better for each score
+			///
+			/// This is a char_vec rather than a std::vector<bool> for the same reasons as instance_is_positives
+			char_vec higher_is_betters;
+
+			/// \brief The values for each score, each indexed by the instances' ids
+			doub_vec_vec values;
+
+			size_t index_of_new_name(const std::string &) const;
+
+		public:
+			bool empty() const;
+			size_t size() const;
+			size_t get_num_instances() const;
+
+			const std::string & get_instance_label(const size_t &) const;
+			bool get_instance_is_positive(const size_t &) const;
+			size_t get_id_of_instance_label(const std::string &) const;
+
+			const std::string & get_name(const size_t &) const;
+			bool get_higher_is_better(const size_t &) const;
+			const doub_vec & get_values(const size_t &) const;
+
+			score_classn_value_columns & add_score_classn_value_list(const score_classn_value_list &,
+			                                                         const double &);
+		};
+
+		score_classn_value_columns make_score_classn_value_columns(const score_classn_value_list_vec &);
+		score_classn_value_columns make_score_classn_value_columns(const score_classn_value_results_set &);
+
+		named_true_false_pos_neg_list make_named_true_false_pos_neg_list(const score_classn_value_columns &,
+		                                                                 const size_t &);
+
+		named_true_false_pos_neg_list_list make_named_true_false_pos_neg_list_list(const score_classn_value_columns &,
+		                                                                           const size_t & = 1);
+
+		classn_stat_pair_series_list make_classn_stat_pair_series_list(const score_classn_value_columns &,
+		                                                               const classn_stat &,
+		                                                               const classn_stat &,
+		                                                               const size_t & = 1);
+
+		classn_stat_pair_series_list make_roc_series_list(const score_classn_value_columns &,
+		                                                  const size_t & = 1);
+
+		classn_stat_pair_series_list make_precision_recall_series_list(const score_classn_value_columns &,
+		                                                               const size_t & = 1);
+
+		str_doub_pair_vec areas_under_curves(const score_classn_value_columns &,
+		                                     const classn_stat &,
+		                                     const classn_stat &,
+		                                     const size_t & = 1);
+
+		str_doub_pair_vec areas_under_roc_curves(const score_classn_value_columns &,
+		                                         const size_t & = 1);
+
+	} // namespace score
+} // namespace cath
+
+#endif
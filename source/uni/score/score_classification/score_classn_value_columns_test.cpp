@@ -0,0 +1,190 @@
+/// \file
+/// \brief The score_classn_value_columns test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/boost_addenda/range/indices.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
+#include "common/size_t_literal.hpp"
+#include "score/score_classification/score_classn_value.hpp"
+#include "score/score_classification/score_classn_value_columns.hpp"
+#include "score/score_classification/score_classn_value_list.hpp"
+#include "score/score_classification/score_classn_value_results_set.hpp"
+#include "score/true_pos_false_neg/classn_rate_stat.hpp"
+#include "score/true_pos_false_neg/classn_stat_pair_series.hpp"
+#include "score/true_pos_false_neg/classn_stat_pair_series_list.hpp"
+#include "score/true_pos_false_neg/named_true_false_pos_neg_list.hpp"
+#include "score/true_pos_false_neg/named_true_false_pos_neg_list_list.hpp"
+#include "score/true_pos_false_neg/true_false_pos_neg.hpp"
+#include "score/true_pos_false_neg/true_false_pos_neg_list.hpp"
+
+using namespace cath::common;
+using namespace cath::score;
+
+namespace cath {
+	namespace test {
+
+		/// \brief The score_classn_value_columns_test_suite_fixture to assist in testing score_classn_value_columns
+		struct score_classn_value_columns_test_suite_fixture {
+		protected:
+			~score_classn_value_columns_test_suite_fixture() noexcept = default;
+
+			/// \brief A higher-is-better score with ties between a positive and a negative
+			const score_classn_value_list list_a = make_score_classn_value_list( {
+				{ 0.9, true,  "d" },
+				{ 0.7, false, "b" },
+				{ 0.7, true,  "a" },
+				{ 0.5, true,  "c" },
+				{ 0.1, false, "e" },
+				{ 0.5, false, "f" },
+			}, true, "score_a" );
+
+			/// \brief A lower-is-better score that's missing instances "c" and "f"
+			const score_classn_value_list list_b = make_score_classn_value_list( {
+				{ 3.0, true,  "a" },
+				{ 1.0, false, "b" },
+				{ 2.0, true,  "d" },
+				{ 2.0, false, "e" },
+			}, false, "score_b" );
+
+			/// \brief Another higher-is-better score with all instances tied
+			const score_classn_value_list list_c = make_score_classn_value_list( {
+				{ 1.0, false, "e" },
+				{ 1.0, true,  "a" },
+				{ 1.0, false, "b" },
+				{ 1.0, true,  "c" },
+				{ 1.0, true,  "d" },
+				{ 1.0, false, "f" },
+			}, true, "another_score" );
+
+			/// \brief All the lists (deliberately not in name order)
+			const score_classn_value_list_vec lists = { list_a, list_b, list_c };
+
+			/// \brief Check that the two specified named_true_false_pos_neg_list_list objects are identical
+			static void check_tfpn_lists_equal(const named_true_false_pos_neg_list_list &prm_got,     ///< The named_true_false_pos_neg_list_list generated
+			                                   const named_true_false_pos_neg_list_list &prm_expected ///< The named_true_false_pos_neg_list_list expected
+			                                   ) {
+				BOOST_REQUIRE_EQUAL( prm_got.size(), prm_expected.size() );
+				for (const size_t &list_ctr : indices( prm_got.size() ) ) {
+					const named_true_false_pos_neg_list &got      = prm_got     [ list_ctr ];
+					const named_true_false_pos_neg_list &expected = prm_expected[ list_ctr ];
+					BOOST_CHECK_EQUAL  ( got.get_name(),        expected.get_name()        );
+					BOOST_REQUIRE_EQUAL( got.get_list().size(), expected.get_list().size() );
+					for (const size_t &tfpn_ctr : indices( got.get_list().size() ) ) {
+						const true_false_pos_neg &got_tfpn      = got.get_list()     [ tfpn_ctr ];
+						const true_false_pos_neg &expected_tfpn = expected.get_list()[ tfpn_ctr ];
+						BOOST_CHECK_EQUAL( get_num_true_positives ( got_tfpn ), get_num_true_positives ( expected_tfpn ) );
+						BOOST_CHECK_EQUAL( get_num_true_negatives ( got_tfpn ), get_num_true_negatives ( expected_tfpn ) );
+						BOOST_CHECK_EQUAL( get_num_false_positives( got_tfpn ), get_num_false_positives( expected_tfpn ) );
+						BOOST_CHECK_EQUAL( get_num_false_negatives( got_tfpn ), get_num_false_negatives( expected_tfpn ) );
+					}
+				}
+			}
+
+			/// \brief Check that the two specified classn_stat_pair_series_list objects are identical
+			static void check_series_lists_equal(const classn_stat_pair_series_list &prm_got,     ///< The classn_stat_pair_series_list generated
+			                                     const classn_stat_pair_series_list &prm_expected ///< The classn_stat_pair_series_list expected
+			                                     ) {
+				BOOST_REQUIRE_EQUAL( prm_got.size(), prm_expected.size() );
+				for (const size_t &series_ctr : indices( prm_got.size() ) ) {
+					const classn_stat_pair_series &got      = prm_got     [ series_ctr ];
+					const classn_stat_pair_series &expected = prm_expected[ series_ctr ];
+					BOOST_CHECK_EQUAL  ( got.get_name(), expected.get_name() );
+					BOOST_REQUIRE_EQUAL( got.size(),     expected.size()     );
+					for (const size_t &point_ctr : indices( got.size() ) ) {
+						BOOST_CHECK_EQUAL( got[ point_ctr ].first,  expected[ point_ctr ].first  );
+						BOOST_CHECK_EQUAL( got[ point_ctr ].second, expected[ point_ctr ].second );
+					}
+				}
+			}
+		};
+
+	} // namespace test
+} // namespace cath
+
+BOOST_FIXTURE_TEST_SUITE(score_classn_value_columns_test_suite, cath::test::score_classn_value_columns_test_suite_fixture)
+
+BOOST_AUTO_TEST_CASE(interns_labels_sorts_names_and_fills_missing) {
+	const auto columns = make_score_classn_value_columns( lists );
+	BOOST_REQUIRE_EQUAL( columns.size(),              3 );
+	BOOST_REQUIRE_EQUAL( columns.get_num_instances(), 6 );
+	BOOST_CHECK_EQUAL  ( columns.get_name( 0 ),       "another_score" );
+	BOOST_CHECK_EQUAL  ( columns.get_name( 1 ),       "score_a"       );
+	BOOST_CHECK_EQUAL  ( columns.get_name( 2 ),       "score_b"       );
+	BOOST_CHECK        ( ! columns.get_higher_is_better( 2 ) );
+
+	const size_t id_of_c = columns.get_id_of_instance_label( "c" );
+	BOOST_CHECK_EQUAL( columns.get_instance_label      ( id_of_c ), "c" );
+	BOOST_CHECK      ( columns.get_instance_is_positive( id_of_c )      );
+	BOOST_CHECK_EQUAL( columns.get_values( 2 )[ id_of_c ], worst_possible_score( list_b ) );
+	BOOST_CHECK_EQUAL( columns.get_values( 1 )[ id_of_c ], 0.5                            );
+}
+
+BOOST_AUTO_TEST_CASE(throws_on_bad_inputs) {
+	score_classn_value_columns columns;
+	columns.add_score_classn_value_list( list_a, 0.0 );
+	BOOST_CHECK_THROW( columns.add_score_classn_value_list( list_a, 0.0 ), invalid_argument_exception );
+	BOOST_CHECK_THROW( columns.add_score_classn_value_list( make_score_classn_value_list( { { 1.0, true,  "z" } }, true, "extra"     ), 0.0 ), invalid_argument_exception );
+	BOOST_CHECK_THROW( columns.add_score_classn_value_list( make_score_classn_value_list( { { 1.0, false, "a" } }, true, "conflicts" ), 0.0 ), invalid_argument_exception );
+	BOOST_CHECK_THROW( columns.get_id_of_instance_label( "z" ), invalid_argument_exception );
+}
+
+// The score_classn_value_results_set functions now use score_classn_value_columns, so these compare
+// against evaluating each (missing-filled) score_classn_value_list separately
+
+BOOST_AUTO_TEST_CASE(tfpn_lists_match_per_list_evaluation_for_any_number_of_threads) {
+	const auto filled_lists = make_score_classn_value_list_vec( make_score_classn_value_results_set( lists ) );
+	const auto columns      = make_score_classn_value_columns( lists );
+	const auto expected     = make_named_true_false_pos_neg_list_list( filled_lists );
+	check_tfpn_lists_equal( make_named_true_false_pos_neg_list_list( make_score_classn_value_results_set( lists ) ), expected );
+	check_tfpn_lists_equal( make_named_true_false_pos_neg_list_list( columns    ), expected );
+	check_tfpn_lists_equal( make_named_true_false_pos_neg_list_list( columns, 2 ), expected );
+	check_tfpn_lists_equal( make_named_true_false_pos_neg_list_list( columns, 5 ), expected );
+}
+
+BOOST_AUTO_TEST_CASE(series_match_per_list_evaluation_for_any_number_of_threads) {
+	const auto results_set  = make_score_classn_value_results_set( lists );
+	const auto filled_lists = make_score_classn_value_list_vec( results_set );
+	const auto columns      = make_score_classn_value_columns( filled_lists );
+	const auto expected_roc = make_classn_stat_pair_series_list( filled_lists, false_positive_rate{}, true_positive_rate{} );
+	const auto expected_pr  = make_classn_stat_pair_series_list( filled_lists, recall{},              precision{}          );
+	check_series_lists_equal( make_roc_series_list             ( results_set ), expected_roc );
+	check_series_lists_equal( make_roc_series_list             ( columns     ), expected_roc );
+	check_series_lists_equal( make_roc_series_list             ( columns, 3  ), expected_roc );
+	check_series_lists_equal( make_precision_recall_series_list( results_set ), expected_pr  );
+	check_series_lists_equal( make_precision_recall_series_list( columns     ), expected_pr  );
+	check_series_lists_equal( make_precision_recall_series_list( columns, 3  ), expected_pr  );
+}
+
+BOOST_AUTO_TEST_CASE(areas_under_roc_curves_match_per_list_evaluation_for_any_number_of_threads) {
+	const auto expected = areas_under_roc_curves( make_named_true_false_pos_neg_list_list( make_score_classn_value_list_vec( make_score_classn_value_results_set( lists ) ) ) );
+	const auto columns  = make_score_classn_value_columns( lists );
+	for (const size_t &num_threads : { 1_z, 2_z, 3_z } ) {
+		const auto got = areas_under_roc_curves( columns, num_threads );
+		BOOST_REQUIRE_EQUAL( got.size(), expected.size() );
+		for (const size_t &score_ctr : indices( got.size() ) ) {
+			BOOST_CHECK_EQUAL( got[ score_ctr ].first,  expected[ score_ctr ].first  );
+			BOOST_CHECK_EQUAL( got[ score_ctr ].second, expected[ score_ctr ].second );
+		}
+	}
+	BOOST_CHECK_EQUAL( areas_under_roc_curves( columns ).front().second, 0.5 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
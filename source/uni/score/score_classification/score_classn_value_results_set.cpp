@@ -47,6 +47,7 @@
 #include "common/exception/out_of_range_exception.hpp"
 #include "common/size_t_literal.hpp"
 #include "score/aligned_pair_score_list/aligned_pair_score_value_list.hpp"
+#include "score/score_classification/score_classn_value_columns.hpp"
 #include "score/score_classification/value_list_scaling.hpp"
 #include "score/true_pos_false_neg/classn_rate_stat.hpp"
 #include "score/true_pos_false_neg/classn_stat_pair_series.hpp"
@@ -534,25 +535,16 @@ const score_classn_value_list & cath::score::find_score_classn_value_list_of_nam
 
 /// \brief TODOCUMENT
 ///
+/// This evaluates the scores via a score_classn_value_columns, which sorts each score's
+/// instances once without copying their labels. All the lists in a score_classn_value_results_set
+/// have the same instances so this gives the same results as evaluating each list separately.
+///
 /// \relates score_classn_value_results_set
 named_true_false_pos_neg_list_list cath::score::make_named_true_false_pos_neg_list_list(const score_classn_value_results_set &prm_score_classn_value_results_set ///< TODOCUMENT
                                                                                         ) {
-	/// \todo Come C++17, if Herb Sutter has gotten his way (n4029), just use braced list here
-	return named_true_false_pos_neg_list_list{
-		transform_build<named_true_false_pos_neg_list_vec>(
-			indices( prm_score_classn_value_results_set.size() ),
-			[&] (const size_t &x) {
-				const auto &name   = get_name_of_index( prm_score_classn_value_results_set, x );
-				const auto &scores = prm_score_classn_value_results_set.get_score_classn_value_list_of_name( name );
-
-				// \todo Put this check in get_score_classn_value_list_of_name()
-				if ( name != scores.get_name() ) {
-					BOOST_THROW_EXCEPTION(invalid_argument_exception("Mismatching names in score_classn_value_results_set"));
-				}
-				return make_named_true_false_pos_neg_list( scores );
-			}
-		)
-	};
+	return make_named_true_false_pos_neg_list_list(
+		make_score_classn_value_columns( prm_score_classn_value_results_set )
+	);
 }
 
 /// \brief TODOCUMENT
@@ -573,15 +565,17 @@ named_true_false_pos_neg_list_list cath::score::make_named_true_false_pos_neg_li
 
 /// \brief TODOCUMENT
 ///
+/// This evaluates the scores via a score_classn_value_columns, which builds each series directly
+/// from a single sort of each score's instances (see make_named_true_false_pos_neg_list_list()).
+/// make_roc_series_list() and make_precision_recall_series_list() use this too.
+///
 /// \relates score_classn_value_results_set
 classn_stat_pair_series_list cath::score::make_classn_stat_pair_series_list(const score_classn_value_results_set &prm_score_classn_value_results_set, ///< TODOCUMENT
                                                                             const classn_stat                    &prm_classn_stat_a,                  ///< TODOCUMENT
                                                                             const classn_stat                    &prm_classn_stat_b                   ///< TODOCUMENT
                                                                             ) {
 	return make_classn_stat_pair_series_list(
-		make_named_true_false_pos_neg_list_list(
-			prm_score_classn_value_results_set
-		),
+		make_score_classn_value_columns( prm_score_classn_value_results_set ),
 		prm_classn_stat_a,
 		prm_classn_stat_b
 	);
@@ -23,7 +23,6 @@
 #include <boost/range/numeric.hpp>
 
 #include "common/algorithm/adjacent_accumulate.hpp"
-#include "common/boost_addenda/range/range_concept_type_aliases.hpp"
 #include "common/cpp14/cbegin_cend.hpp"
 #include "common/exception/invalid_argument_exception.hpp"
 #include "score/true_pos_false_neg/classn_stat.hpp"
@@ -76,6 +75,33 @@ const string & classn_stat_pair_series::get_name() const {
 	return name;
 }
 
+/// \brief Calculate the area of the trapezium under the curve segment between the two specified (x, y) points
+///
+/// This is the contribution of one adjacent pair of points to area_under_curve(), which allows the area to
+/// be accumulated as a curve's points are generated, without storing them all
+///
+/// \relates classn_stat_pair_series
+double cath::score::area_under_curve_segment(const doub_doub_pair &prm_point_a, ///< The first  point of the segment
+                                             const doub_doub_pair &prm_point_b  ///< The second point of the segment
+                                             ) {
+	// Sanity check the inputs...
+	//
+	// Check that the second x-axis value isn't greater
+	// (but allow it to be equal because curves like ROC curves should be allowed to go straight up)
+	if ( prm_point_a.first > prm_point_b.first ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot calculate area under curve that isn't monotonically increasing over the x-axis"));
+	}
+	// Check that neither y-axis value is less than 0
+	if ( prm_point_a.second < 0.0 || prm_point_b.second < 0.0 ) {
+		BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot calculate area under curve that goes below the x-axis"));
+	}
+
+	// Calculate and return the area of the trapezium defined by dropping the two points down to the x-axis
+	const auto x_diff =   prm_point_b.first  - prm_point_a.first;
+	const auto y_mean = ( prm_point_a.second + prm_point_b.second ) / 2.0;
+	return ( x_diff * y_mean );
+}
+
 /// \brief TODOCUMENT
 ///
 /// \todo Write an "adjacented" adaptor that returns pairs of references to consecutive pairs of
@@ -84,28 +110,11 @@ const string & classn_stat_pair_series::get_name() const {
 /// \relates classn_stat_pair_series
 double cath::score::area_under_curve(const classn_stat_pair_series &prm_curve ///< TODOCUMENT
                                      ) {
-	using value_type = range_value_t<const classn_stat_pair_series>;
-
 	return adjacent_accumulate(
 		prm_curve,
 		0.0,
-		[] (const value_type &a, const value_type &b) {
-			// Sanity check the inputs...
-			//
-			// Check that the second x-axis value isn't greater
-			// (but allow it to be equal because curves like ROC curves should be allowed to go straight up)
-			if ( a.first > b.first ) {
-				BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot calculate area under curve that isn't monotonically increasing over the x-axis"));
-			}
-			// Check that neither y-axis value is less than 0
-			if ( a.second < 0.0 || b.second < 0.0 ) {
-				BOOST_THROW_EXCEPTION(invalid_argument_exception("Cannot calculate area under curve that goes below the x-axis"));
-			}
-
-			// Calculate and return the area of the trapezium defined by dropping the two points down to the x-axis
-			const auto x_diff =   b.first  - a.first;
-			const auto y_mean = ( a.second + b.second ) / 2.0;
-			return ( x_diff * y_mean );
+		[] (const doub_doub_pair &a, const doub_doub_pair &b) {
+			return area_under_curve_segment( a, b );
 		}
 	);
 }
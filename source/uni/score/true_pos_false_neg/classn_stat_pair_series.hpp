@@ -59,6 +59,9 @@ namespace cath {
 			const std::string & get_name() const;
 		};
 
+		double area_under_curve_segment(const doub_doub_pair &,
+		                                const doub_doub_pair &);
+
 		double area_under_curve(const classn_stat_pair_series &);
 	} // namespace score
 } // namespace cath
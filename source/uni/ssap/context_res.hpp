@@ -23,12 +23,16 @@
 
 #include "common/debug_numeric_cast.hpp"
 #include "ssap/distance_score_formula.hpp"
+#include "ssap/ssap.hpp"
 #include "structure/entry_querier/entry_querier.hpp"
 #include "structure/entry_querier/residue_querier.hpp"
 #include "structure/geometry/coord.hpp"
 #include "structure/protein/protein.hpp"
+#include "structure/protein/protein_comparison_view.hpp"
 #include "structure/protein/residue.hpp"
 
+#include <cassert>
+
 namespace cath {
 
 	template <distance_score_formula F = distance_score_formula::USED_IN_PREVIOUS_CODE>
@@ -177,6 +181,24 @@ namespace cath {
 		);
 	}
 
+	/// \brief Compares vectors/scalars/Hbonds/SSbonds between residues in the two proteins,
+	///        reading the residue data from protein_comparison_views
+	///
+	/// This gives the same result as context_res() on the equivalent residues
+	template <bool prm_int_rounding, distance_score_formula F = distance_score_formula::USED_IN_PREVIOUS_CODE>
+	inline float_score_type context_res(const protein_comparison_view &prm_view_a,       ///< A view of the first  protein's residue data
+	                                    const protein_comparison_view &prm_view_b,       ///< A view of the second protein's residue data
+	                                    const size_t                  &prm_from_index_a, ///< The index of the "from" residue in the first  protein
+	                                    const size_t                  &prm_from_index_b, ///< The index of the "from" residue in the second protein
+	                                    const size_t                  &prm_to_index_a,   ///< The index of the "to"   residue in the first  protein
+	                                    const size_t                  &prm_to_index_b    ///< The index of the "to"   residue in the second protein
+	                                    ) {
+		return context_res_vec<prm_int_rounding, F>(
+			view_vector_of_index_pair( prm_view_a, prm_from_index_a, prm_to_index_a ),
+			view_vector_of_index_pair( prm_view_b, prm_from_index_b, prm_to_index_b )
+		);
+	}
+
 	/// \brief TODOCUMENT
 	inline float_score_type context_res(const residue                &prm_from_res_a,                                               ///< The "from" residue in the first  protein
 	                                    const residue                &prm_from_res_b,                                               ///< The "from" residue in the second protein
@@ -213,6 +235,58 @@ namespace cath {
 			prm_dist_form
 		);
 	}
+
+	/// \brief Calculate the context score for the two specified pairs of residues
+	///
+	/// This is defined inline here (rather than in residue_querier.cpp) so that the SSAP passes
+	/// that are specialised on residue_querier can inline it into their inner loops
+	inline score_type residue_querier::distance_score__offset_1(const protein &prm_protein_a,                   ///< The first protein
+	                                                            const protein &prm_protein_b,                   ///< The second protein
+	                                                            const size_t  &prm_a_view_from_index__offset_1, ///< The offset-1 index of the view-from residue in the first protein
+	                                                            const size_t  &prm_b_view_from_index__offset_1, ///< The offset-1 index of the view-from residue in the second protein
+	                                                            const size_t  &prm_a_dest_to_index__offset_1,   ///< The offset-1 index of the destination residue in the first protein
+	                                                            const size_t  &prm_b_dest_to_index__offset_1    ///< The offset-1 index of the destination residue in the second protein
+	                                                            ) const {
+		if ( view_a && view_b ) {
+			assert( view_a->get().is_view_of( prm_protein_a ) && view_b->get().is_view_of( prm_protein_b ) );
+			return debug_numeric_cast<score_type>(
+				context_res<true>(
+					view_a->get(),                       view_b->get(),
+					prm_a_view_from_index__offset_1 - 1, prm_b_view_from_index__offset_1 - 1,
+					prm_a_dest_to_index__offset_1   - 1, prm_b_dest_to_index__offset_1   - 1
+				)
+			);
+		}
+		return debug_numeric_cast<score_type>(
+			context_res<true>(
+				get_residue_ref_of_index__offset_1( prm_protein_a, prm_a_view_from_index__offset_1 ),
+				get_residue_ref_of_index__offset_1( prm_protein_b, prm_b_view_from_index__offset_1 ),
+				get_residue_ref_of_index__offset_1( prm_protein_a, prm_a_dest_to_index__offset_1   ),
+				get_residue_ref_of_index__offset_1( prm_protein_b, prm_b_dest_to_index__offset_1   )
+			)
+		);
+	}
+
+	/// \brief Return whether the two specified residues have similar area and angle properties
+	///
+	/// This is defined inline here for the same reason as residue_querier::distance_score__offset_1()
+	inline bool residue_querier::are_similar__offset_1(const protein &prm_protein_a,         ///< The first protein
+	                                                   const protein &prm_protein_b,         ///< The second protein
+	                                                   const size_t  &prm_index_a__offset_1, ///< The offset-1 index of the residue in the first protein
+	                                                   const size_t  &prm_index_b__offset_1  ///< The offset-1 index of the residue in the second protein
+	                                                   ) const {
+		if ( view_a && view_b ) {
+			assert( view_a->get().is_view_of( prm_protein_a ) && view_b->get().is_view_of( prm_protein_b ) );
+			return residues_have_similar_area_angle_props(
+				view_a->get(), prm_index_a__offset_1 - 1,
+				view_b->get(), prm_index_b__offset_1 - 1
+			);
+		}
+		return residues_have_similar_area_angle_props(
+			get_residue_ref_of_index__offset_1( prm_protein_a, prm_index_a__offset_1 ),
+			get_residue_ref_of_index__offset_1( prm_protein_b, prm_index_b__offset_1 )
+		);
+	}
 } // namespace cath
 
 #endif
@@ -66,6 +66,7 @@ const string old_ssap_options_block::PO_DOMIN_FILE           = { "domin-file"
 const string old_ssap_options_block::PO_MAX_SCORE_TO_REFAST  = { "max-score-to-fast-rerun" }; ///< The option name for the max_score_to_fast_ssap_rerun option
 const string old_ssap_options_block::PO_MAX_SCORE_TO_RESLOW  = { "max-score-to-slow-rerun" }; ///< The option name for the max_score_to_slow_ssap_rerun option
 const string old_ssap_options_block::PO_SLOW_SSAP_ONLY       = { "slow-ssap-only"          }; ///< The option name for the slow_ssap_only option
+const string old_ssap_options_block::PO_PRUNE_BELOW_SCORE    = { "prune-below-score"       }; ///< The option name for the prune_below_score option
 
 const string old_ssap_options_block::PO_LOC_SSAP_SCORE       = { "local-ssap-score"        }; ///< The option name for the use_local_ssap_score option
 const string old_ssap_options_block::PO_ALL_SCORES           = { "all-scores"              }; ///< The option name for the write_all_scores option
@@ -77,6 +78,7 @@ const string old_ssap_options_block::PO_MIN_OUT_SCORE        = { "min-score-for-
 const string old_ssap_options_block::PO_MIN_SUP_SCORE        = { "min-sup-score"           }; ///< The option name for the min_score_for_superposition option
 const string old_ssap_options_block::PO_RASMOL_SCRIPT        = { "rasmol-script"           }; ///< The option name for the write_rasmol_script option
 const string old_ssap_options_block::PO_XML_SUP              = { "xmlsup"                  }; ///< The option name for write_xml_sup option
+const string old_ssap_options_block::PO_TIMINGS_FILE         = { "timings-file"            }; ///< The option name for the timings_file option
 
 /// \brief The single-character for the output file option
 constexpr char old_ssap_options_block::PO_CHAR_OUT_FILE;
@@ -107,6 +109,7 @@ void old_ssap_options_block::do_add_visible_options_to_description(options_descr
 	const string set_varname  { "<set>"   };
 
 	const auto write_rasmol_script_notifier = [&] (const bool &x) { set_write_rasmol_script( x ? sup_pdbs_script_policy::WRITE_RASMOL_SCRIPT : sup_pdbs_script_policy::LEAVE_RAW_PDBS ); };
+	const auto prune_below_score_notifier   = [&] (const double &x) { set_prune_below_score( x ); };
 
 	const string PO_OUT_FILE_W_CHAR = PO_OUT_FILE + ',' + PO_CHAR_OUT_FILE;
 
@@ -121,6 +124,7 @@ void old_ssap_options_block::do_add_visible_options_to_description(options_descr
 		( PO_MAX_SCORE_TO_REFAST.c_str(),  value<double>            ( &max_score_to_fast_ssap_rerun )->value_name(score_varname)->default_value(DEF_REFAST    ), ( "Run a second fast SSAP with looser cutoffs if the first fast SSAP's score falls below " + score_varname ).c_str()      )
 		( PO_MAX_SCORE_TO_RESLOW.c_str(),  value<double>            ( &max_score_to_slow_ssap_rerun )->value_name(score_varname)->default_value(DEF_RESLOW    ), ( "Perform a slow SSAP if the (best) fast SSAP score falls below " + score_varname ).c_str()                              )
 		( PO_SLOW_SSAP_ONLY.c_str(),       bool_switch              ( &slow_ssap_only               )                           ->default_value(DEF_BOOL      ),   "Don't try any fast SSAPs; only use slow SSAP"                                                                          )
+		( PO_PRUNE_BELOW_SCORE.c_str(),    value<double>()->notifier( prune_below_score_notifier    )->value_name(score_varname),                                ( "Skip the comparison (and output zero scores) if the structures' lengths mean it can't score " + score_varname ).c_str() )
 
 		( PO_LOC_SSAP_SCORE.c_str(),       bool_switch              ( &use_local_ssap_score         )                           ->default_value(DEF_BOOL      ),   "[DEPRECATED] Normalise the SSAP score over the length of the smallest domain rather than the largest"                  )
 		( PO_ALL_SCORES.c_str(),           bool_switch              ( &write_all_scores             )                           ->default_value(DEF_BOOL      ),   "[DEPRECATED] Output all SSAP scores from fast and slow runs, not just the highest"                                     )
@@ -131,7 +135,8 @@ void old_ssap_options_block::do_add_visible_options_to_description(options_descr
 		( PO_MIN_OUT_SCORE.c_str(),        value<double>            ( &min_score_for_writing_files  )->value_name(score_varname)->default_value(DEF_FILE_SC   ), ( "Only output alignment/superposition files if the SSAP score exceeds " + score_varname ).c_str()                        )
 		( PO_MIN_SUP_SCORE.c_str(),        value<double>            ( &min_score_for_superposition  )->value_name(score_varname)->default_value(DEF_SUP       ), ( "[DEPRECATED] Calculate superposition based on the residue-pairs with scores greater than " + score_varname ).c_str()   )
 		( PO_RASMOL_SCRIPT.c_str(),        bool_switch()->notifier  ( write_rasmol_script_notifier  ),                                                             "[DEPRECATED] Write a rasmol superposition script to load and colour the superposed structures"                         )
-		( PO_XML_SUP.c_str(),              bool_switch              ( &write_xml_sup                )                           ->default_value(DEF_BOOL      ),   "[DEPRECATED] Write a small xml superposition file, from which a larger superposition file can be reconstructed"        );
+		( PO_XML_SUP.c_str(),              bool_switch              ( &write_xml_sup                )                           ->default_value(DEF_BOOL      ),   "[DEPRECATED] Write a small xml superposition file, from which a larger superposition file can be reconstructed"        )
+		( PO_TIMINGS_FILE.c_str(),         value<path>              ( &timings_file                 )->value_name(file_varname ),                                ( "Append a JSON line of the time spent in each phase of the comparison to " + file_varname + " (and log a summary)" ).c_str() );
 }
 
 /// \brief Add any hidden options to the provided options_description
@@ -213,6 +218,7 @@ str_vec old_ssap_options_block::do_get_all_options_names() const {
 		old_ssap_options_block::PO_MAX_SCORE_TO_REFAST,
 		old_ssap_options_block::PO_MAX_SCORE_TO_RESLOW,
 		old_ssap_options_block::PO_SLOW_SSAP_ONLY,
+		old_ssap_options_block::PO_PRUNE_BELOW_SCORE,
 		old_ssap_options_block::PO_LOC_SSAP_SCORE,
 		old_ssap_options_block::PO_ALL_SCORES,
 		old_ssap_options_block::PO_PROTEIN_SOURCE_FILES,
@@ -222,6 +228,7 @@ str_vec old_ssap_options_block::do_get_all_options_names() const {
 		old_ssap_options_block::PO_MIN_SUP_SCORE,
 		old_ssap_options_block::PO_RASMOL_SCRIPT,
 		old_ssap_options_block::PO_XML_SUP,
+		old_ssap_options_block::PO_TIMINGS_FILE,
 	};
 }
 
@@ -286,6 +293,11 @@ bool old_ssap_options_block::get_slow_ssap_only() const {
 	return slow_ssap_only;
 }
 
+/// \brief Getter for the optional score below which comparisons that provably can't reach it should be abandoned
+const doub_opt & old_ssap_options_block::get_prune_below_score() const {
+	return prune_below_score;
+}
+
 /// \brief Getter for use_local_score
 bool old_ssap_options_block::get_use_local_ssap_score() const {
 	return use_local_ssap_score;
@@ -331,6 +343,11 @@ bool old_ssap_options_block::get_write_xml_sup() const {
 	return write_xml_sup;
 }
 
+/// \brief Getter for the file to which a JSON record of the time spent in each phase should be appended (or none)
+path_opt old_ssap_options_block::get_opt_timings_file() const {
+	return ( ! timings_file.empty() ) ? path_opt( timings_file ) : none;
+}
+
 /// \brief Setter for write_script
 old_ssap_options_block & old_ssap_options_block::set_write_rasmol_script(const sup_pdbs_script_policy &prm_write_rasmol_script ///< The new policy for writing a script for superposition PDBs
                                                                          ) {
@@ -338,6 +355,13 @@ old_ssap_options_block & old_ssap_options_block::set_write_rasmol_script(const s
 	return *this;
 }
 
+/// \brief Setter for the optional score below which comparisons that provably can't reach it should be abandoned
+old_ssap_options_block & old_ssap_options_block::set_prune_below_score(const doub_opt &prm_prune_below_score ///< The optional score below which comparisons should be abandoned
+                                                                       ) {
+	prune_below_score = prm_prune_below_score;
+	return *this;
+}
+
 /// \brief Getter for whether a clique_file has been specified
 bool cath::opts::has_clique_file(const old_ssap_options_block &prm_old_ssap_options_block ///< TODOCUMENT
                                  ) {
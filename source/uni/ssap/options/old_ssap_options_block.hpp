@@ -72,6 +72,7 @@ namespace cath {
 			double                      max_score_to_fast_ssap_rerun = DEF_REFAST;    ///< Maximum fast SSAP score to trigger running a second fast SSAP with looser cutoffs
 			double                      max_score_to_slow_ssap_rerun = DEF_RESLOW;    ///< Maximum (best) fast SSAP score to trigger running a slow SSAP
 			bool                        slow_ssap_only               = DEF_BOOL;      ///< Whether to only run a slow SSAP (and skip all fast SSAPs)
+			doub_opt                    prune_below_score;                            ///< An optional score below which comparisons that provably can't reach it should be abandoned
 
 			bool                        use_local_ssap_score         = DEF_BOOL;      ///< Use local score normalised over smallest protein
 			bool                        write_all_scores             = DEF_BOOL;      ///< Whether to output all SSAP scores, rather than just the best
@@ -84,6 +85,8 @@ namespace cath {
 			sup::sup_pdbs_script_policy write_rasmol_script          = DEF_SCRIPT;    ///< Whether to write a Rasmol superposition script file
 			bool                        write_xml_sup                = DEF_BOOL;      ///< Whether to write an XML superposition file
 
+			boost::filesystem::path     timings_file;                                 ///< A file to which a JSON record of the time spent in each phase should be appended, or empty if none should be
+
 			std::unique_ptr<options_block> do_clone() const final;
 			std::string do_get_block_name() const final;
 			void do_add_visible_options_to_description(boost::program_options::options_description &,
@@ -109,6 +112,7 @@ namespace cath {
 			double get_max_score_to_fast_ssap_rerun() const;
 			double get_max_score_to_slow_ssap_rerun() const;
 			bool get_slow_ssap_only() const;
+			const doub_opt & get_prune_below_score() const;
 
 			bool get_use_local_ssap_score() const;
 			bool get_write_all_scores() const;
@@ -120,8 +124,10 @@ namespace cath {
 			double get_min_score_for_superposition() const;
 			sup::sup_pdbs_script_policy get_write_rasmol_script() const;
 			bool get_write_xml_sup() const;
+			path_opt get_opt_timings_file() const;
 
 			old_ssap_options_block & set_write_rasmol_script(const sup::sup_pdbs_script_policy &);
+			old_ssap_options_block & set_prune_below_score(const doub_opt &);
 
 			static const std::string PO_NAME;
 
@@ -134,6 +140,7 @@ namespace cath {
 			static const std::string PO_MAX_SCORE_TO_REFAST;
 			static const std::string PO_MAX_SCORE_TO_RESLOW;
 			static const std::string PO_SLOW_SSAP_ONLY;
+			static const std::string PO_PRUNE_BELOW_SCORE;
 
 			static const std::string PO_LOC_SSAP_SCORE;
 			static const std::string PO_ALL_SCORES;
@@ -145,6 +152,7 @@ namespace cath {
 			static const std::string PO_MIN_SUP_SCORE;
 			static const std::string PO_RASMOL_SCRIPT;
 			static const std::string PO_XML_SUP;
+			static const std::string PO_TIMINGS_FILE;
 
 			static constexpr char PO_CHAR_OUT_FILE = 'o';
 		};
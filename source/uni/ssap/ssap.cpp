@@ -125,8 +125,6 @@
 
 #include "alignment/alignment_coord_extractor.hpp"
 #include "alignment/common_residue_selection_policy/common_residue_select_min_score_policy.hpp"
-#include "alignment/dyn_prog_align/dyn_prog_score_source/entry_querier_dyn_prog_score_source.hpp"
-#include "alignment/dyn_prog_align/dyn_prog_score_source/mask_dyn_prog_score_source.hpp"
 #include "alignment/dyn_prog_align/dyn_prog_score_source/old_matrix_dyn_prog_score_source.hpp"
 #include "alignment/dyn_prog_align/ssap_code_dyn_prog_aligner.hpp"
 #include "alignment/gap/gap_penalty.hpp"
@@ -146,10 +144,12 @@
 #include "common/string/booled_to_string.hpp"
 #include "common/temp_check_offset_1.hpp"
 #include "common/type_aliases.hpp"
+#include "file/ssap_scores_file/ssap_scores_entry.hpp"
 #include "ssap/clique.hpp"
 #include "ssap/options/cath_ssap_options.hpp"
 #include "ssap/options/old_ssap_options_block.hpp"
 #include "ssap/selected_pair.hpp"
+#include "ssap/ssap_phase_timings.hpp"
 #include "ssap/ssap_scores.hpp"
 #include "ssap/windowed_matrix.hpp"
 #include "structure/entry_querier/residue_querier.hpp"
@@ -157,6 +157,7 @@
 #include "structure/geometry/coord.hpp"
 #include "structure/geometry/coord_list.hpp"
 #include "structure/protein/protein.hpp"
+#include "structure/protein/protein_comparison_view.hpp"
 #include "structure/protein/protein_io.hpp"
 #include "structure/protein/protein_source_file_set/protein_source_file_set.hpp"
 #include "structure/protein/residue.hpp"
@@ -167,8 +168,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 using namespace cath;
@@ -194,14 +197,17 @@ using std::boolalpha;
 using std::deque;
 using std::fill_n;
 using std::fixed;
+using std::lock_guard;
 using std::make_pair;
 using std::max;
 using std::min;
+using std::mutex;
 using std::ofstream;
 using std::ostream;
 using std::pair;
 using std::setprecision;
 using std::string;
+using std::trunc;
 using std::vector;
 
 /// \brief The number of top-scoring residue pairs to select
@@ -230,45 +236,103 @@ constexpr size_t     SEC_STRUC_PLANAR_C_ANGLE =  10;
 //        - allocating the required amount of memory rather than just using 5000x5000 ints for each!
 //       Also, I suspect that quite a bit of complication throughout the file is just indexing these matrices,
 //       which should be encapsulated.
+//
+// These are all thread_local so that separate threads can each run SSAPs concurrently
+// (eg do_the_ssaps_alignment_acquirer uses run_ssap_in_memory() in multiple threads).
+// That's a stopgap: it doesn't remove the shared state, it just gives each thread its own copy.
+// The proper fix is still to move this state into objects that are passed through the SSAP functions.
 
 /// \brief Matrix of upper scores
-static score_vec_of_vec   global_upper_score_matrix;
+static thread_local score_vec_of_vec   global_upper_score_matrix;
 
 /// \brief Matrix to mask out comparisons that should be skipped whilst performing upper-matrix residue comparisons
-static bool_vec_of_vec    global_upper_res_mask_matrix;
+static thread_local bool_vec_of_vec    global_upper_res_mask_matrix;
 
 /// \brief Matrix to mask out comparisons that should be skipped whilst performing upper-matrix, secondary-structure comparisons
-static bool_vec_of_vec    global_upper_ss_mask_matrix;
+static thread_local bool_vec_of_vec    global_upper_ss_mask_matrix;
 
 /// \brief Matrix to mask out comparisons that should be skipped whilst performing lower-matrix (residue or secondary structure) comparisons
-static bool_vec_of_vec    global_lower_mask_matrix;
+static thread_local bool_vec_of_vec    global_lower_mask_matrix;
+
+static thread_local size_size_pair_vec global_selections;              ///< Selected region within matrix
+
+static thread_local size_t             global_num_selections  =     0; ///< The number of selected top-scoring residue pairs
+static thread_local size_t             global_window          =     0; ///< The size of the window to
+static thread_local size_t             global_window_add      =    70; ///< The amount that should be added to the difference in lengths to calculate window size
+static thread_local size_t             global_res_sim_cutoff  =   150; ///<
+
+static thread_local ptrdiff_t          global_run_counter     =     0; ///<
 
-static size_size_pair_vec global_selections;              ///< Selected region within matrix
+static thread_local score_type         global_gap_penalty     =    50; ///< The gap penalty to be used in dynamic programming
 
-static size_t             global_num_selections  =     0; ///< The number of selected top-scoring residue pairs
-static size_t             global_window          =     0; ///< The size of the window to
-static size_t             global_window_add      =    70; ///< The amount that should be added to the difference in lengths to calculate window size
-static size_t             global_res_sim_cutoff  =   150; ///<
+static thread_local bool               global_debug           = false; ///< Whether to output debug messages
+static thread_local bool               global_align_pass      = false; ///< Whether the pass is a later, refining alignment pass
+static thread_local bool               global_supaln          =  true; ///<
+static thread_local bool               global_doing_fast_ssap =  true; ///< Whether currently performing a fast SSAP
+static thread_local bool               global_res_score       = false; ///<
 
-static ptrdiff_t          global_run_counter     =     0; ///<
+static thread_local double             global_frac_selected   =   0.0; ///<
 
-static score_type         global_gap_penalty     =    50; ///< The gap penalty to be used in dynamic programming
+static thread_local double             global_score_run1      =   0.0; ///<
+static thread_local double             global_score_run2      =   0.0; ///<
+static thread_local double             global_ssap_score1     =   0.0; ///<
+static thread_local double             global_ssap_score2     =   0.0; ///<
 
-static bool               global_debug           = false; ///< Whether to output debug messages
-static bool               global_align_pass      = false; ///< Whether the pass is a later, refining alignment pass
-static bool               global_supaln          =  true; ///<
-static bool               global_doing_fast_ssap =  true; ///< Whether currently performing a fast SSAP
-static bool               global_res_score       = false; ///<
+static thread_local char               global_ssap_line1[SSAP_LINE_LENGTH]; ///<
+static thread_local char               global_ssap_line2[SSAP_LINE_LENGTH]; ///<
 
-static double             global_frac_selected   =   0.0; ///<
+static thread_local ssap_scores_entry_opt global_ssap_entry1;        ///< The scores in global_ssap_line1 as an ssap_scores_entry
+static thread_local ssap_scores_entry_opt global_ssap_entry2;        ///< The scores in global_ssap_line2 as an ssap_scores_entry
+
+static thread_local bool               global_write_aln_files =  true; ///< Whether plot_aln() should write its alignment to a file in the alignment directory
+static thread_local alignment_opt      global_output_alignment;       ///< The alignment that plot_aln() last chose to output (if not global_write_aln_files)
+
+static thread_local bool               global_record_phase_timings = false; ///< Whether the time spent in each phase of the current comparison should be recorded
+static thread_local ssap_phase_timings global_phase_timings;                ///< The time spent in each phase of the current comparison (if global_record_phase_timings)
+
+/// \brief The phase timings summed over all comparisons (in any thread) that have recorded them
+///
+/// This is guarded by global_phase_timings_summary_mutex, which also serialises appends to the timings files
+static ssap_phase_timings              global_phase_timings_summary;
 
-static double             global_score_run1      =   0.0; ///<
-static double             global_score_run2      =   0.0; ///<
-static double             global_ssap_score1     =   0.0; ///<
-static double             global_ssap_score2     =   0.0; ///<
+/// \brief Mutex to guard global_phase_timings_summary and appends to the timings files
+static mutex                           global_phase_timings_summary_mutex;
+
+namespace {
+
+	/// \brief Get a pointer to this thread's global_phase_timings if they're being recorded or nullptr otherwise
+	///
+	/// This is intended to be passed to an ssap_phase_timer, which does nothing if given nullptr
+	ssap_phase_timings * phase_timings_ptr() {
+		return global_record_phase_timings ? &global_phase_timings : nullptr;
+	}
+
+	/// \brief If phase timings are being recorded for the current comparison, append them to the timings file
+	///        and add them to global_phase_timings_summary
+	void record_phase_timings(const protein                &prm_protein_a,   ///< The first protein
+	                          const protein                &prm_protein_b,   ///< The second protein
+	                          const old_ssap_options_block &prm_ssap_options ///< The old_ssap_options_block specifying the timings file
+	                          ) {
+		const path_opt timings_file = prm_ssap_options.get_opt_timings_file();
+		if ( ! global_record_phase_timings || ! timings_file ) {
+			return;
+		}
+		global_phase_timings.add_comparison();
+		const string record_line = to_json_record_string(
+			global_phase_timings,
+			get_domain_or_specified_or_name_from_acq( prm_protein_a ),
+			get_domain_or_specified_or_name_from_acq( prm_protein_b )
+		) + "\n";
+
+		const lock_guard<mutex> summary_lock{ global_phase_timings_summary_mutex };
+		ofstream timings_ofstream;
+		open_ofstream( timings_ofstream, *timings_file, std::ios_base::out | std::ios_base::app );
+		timings_ofstream << record_line;
+		timings_ofstream.close();
+		global_phase_timings_summary += global_phase_timings;
+	}
 
-static char               global_ssap_line1[SSAP_LINE_LENGTH]; ///<
-static char               global_ssap_line2[SSAP_LINE_LENGTH]; ///<
+} // namespace
 
 /// \brief Reset all the global variable that are used by SSAP
 ///
@@ -303,6 +367,19 @@ void cath::reset_ssap_global_variables() {
 	global_ssap_score2     =   0.0;
 	fill_n(global_ssap_line1, SSAP_LINE_LENGTH, 0);
 	fill_n(global_ssap_line2, SSAP_LINE_LENGTH, 0);
+	global_ssap_entry1      = none;
+	global_ssap_entry2      = none;
+	global_write_aln_files  =  true;
+	global_output_alignment =  none;
+	global_record_phase_timings = false;
+	global_phase_timings        = ssap_phase_timings{};
+}
+
+/// \brief Get the phase timings summed over all comparisons (in any thread) that have recorded them
+///        (ie that have been run with a timings file specified)
+ssap_phase_timings cath::get_ssap_phase_timings_summary() {
+	const lock_guard<mutex> summary_lock{ global_phase_timings_summary_mutex };
+	return global_phase_timings_summary;
 }
 
 /// \brief Temporary setter for global_run_counter to allow tests to check their fixtures are
@@ -393,8 +470,12 @@ void cath::run_ssap(const cath_ssap_options &prm_cath_ssap_options, ///< The cat
 		);
 	}
 
-	global_debug = prm_cath_ssap_options.get_old_ssap_options().get_debug();
-	const prot_prot_pair proteins = read_protein_pair( prm_cath_ssap_options, prm_stderr );
+	global_debug                = prm_cath_ssap_options.get_old_ssap_options().get_debug();
+	global_record_phase_timings = static_cast<bool>( prm_cath_ssap_options.get_old_ssap_options().get_opt_timings_file() );
+	const prot_prot_pair proteins = [&] {
+		const ssap_phase_timer load_timer{ phase_timings_ptr(), ssap_phase::LOAD_STRUCTURES };
+		return read_protein_pair( prm_cath_ssap_options, prm_stderr );
+	} ();
 
 	global_run_counter = 0;
 
@@ -492,22 +573,76 @@ void cath::run_ssap(const cath_ssap_options &prm_cath_ssap_options, ///< The cat
 		exit( static_cast<int>( logger::return_code::SUCCESS ) );
 	}
 
-	// Run SSAP
-	align_proteins( proteins.first, proteins.second, the_ssap_options, the_data_dirs );
-
-	// Print the results
-	print_ssap_scores(
-		scores_stream->get(),
-		global_ssap_score1,
-		global_ssap_score2,
-		global_ssap_line1,
-		global_ssap_line2,
-		global_run_counter,
-		the_ssap_options.get_write_all_scores()
-	);
+	{
+		const ssap_phase_timer whole_timer{ phase_timings_ptr(), ssap_phase::WHOLE_COMPARISON };
+
+		// Run SSAP
+		align_proteins( proteins.first, proteins.second, the_ssap_options, the_data_dirs );
+
+		// Print the results
+		const ssap_phase_timer write_timer{ phase_timings_ptr(), ssap_phase::WRITE_SCORES };
+		print_ssap_scores(
+			scores_stream->get(),
+			global_ssap_score1,
+			global_ssap_score2,
+			global_ssap_line1,
+			global_ssap_line2,
+			global_run_counter,
+			the_ssap_options.get_write_all_scores()
+		);
+	}
+
+	// If requested, record the phase timings and log a summary of them
+	if ( global_record_phase_timings ) {
+		record_phase_timings( proteins.first, proteins.second, the_ssap_options );
+		BOOST_LOG_TRIVIAL( info ) << to_summary_string( get_ssap_phase_timings_summary() );
+	}
 }
 
 
+/// \brief SSAP a pair of already-loaded, SSAP-ready proteins in memory
+///
+/// This performs the same comparison as run_ssap() but rather than writing the scores
+/// and the alignment to streams/files, it returns them.
+///
+/// This can be called concurrently from different threads because the SSAP global variables are thread_local.
+///
+/// \returns A pair of the scores (the best of the runs, as would be written by run_ssap()) and the alignment
+///          (as would be written to the alignment directory) or none if the scores weren't high enough for
+///          an alignment to be written
+pair<ssap_scores_entry, alignment_opt> cath::run_ssap_in_memory(const protein                &prm_protein_a,    ///< The first protein
+                                                                const protein                &prm_protein_b,    ///< The second protein
+                                                                const old_ssap_options_block &prm_ssap_options, ///< The old_ssap_options_block to specify how things should be done
+                                                                const data_dirs_spec         &prm_data_dirs     ///< The data directories from which data should be read
+                                                                ) {
+	// Start by resetting this thread's SSAP global variables and then prevent alignment files being written
+	reset_ssap_global_variables();
+	global_write_aln_files      = false;
+	global_debug                = prm_ssap_options.get_debug();
+	global_record_phase_timings = static_cast<bool>( prm_ssap_options.get_opt_timings_file() );
+
+	if ( prm_protein_a.get_length() == 0 || prm_protein_b.get_length() == 0 ) {
+		save_zero_scores( prm_protein_a, prm_protein_b, 2 );
+		return { *global_ssap_entry2, none };
+	}
+
+	{
+		const ssap_phase_timer whole_timer{ phase_timings_ptr(), ssap_phase::WHOLE_COMPARISON };
+
+		// Run SSAP
+		align_proteins( prm_protein_a, prm_protein_b, prm_ssap_options, prm_data_dirs );
+	}
+	record_phase_timings( prm_protein_a, prm_protein_b, prm_ssap_options );
+
+	// Grab the results, choosing between the runs as print_ssap_scores() does
+	const bool use_run2 = ( global_run_counter == 2 && global_ssap_score2 >= global_ssap_score1 );
+	const ssap_scores_entry_opt &best_entry = use_run2 ? global_ssap_entry2 : global_ssap_entry1;
+	if ( ! best_entry ) {
+		BOOST_THROW_EXCEPTION(out_of_range_exception("SSAP didn't record any scores for the comparison"));
+	}
+	return { *best_entry, global_output_alignment };
+}
+
 /// \brief Align structures
 ///
 /// JEB v1.12 12.09.2002
@@ -529,6 +664,31 @@ void cath::align_proteins(const protein                 &prm_protein_a,    ///<
 	BOOST_LOG_TRIVIAL( debug ) << "Function: alnseq:  seqa->nsec=" << prm_protein_a.get_num_sec_strucs();
 	BOOST_LOG_TRIVIAL( debug ) << "Function: alnseq:  seqb->nsec=" << prm_protein_b.get_num_sec_strucs();
 
+	// If a score threshold has been specified and the lengths mean this comparison can't reach it,
+	// then abandon it before any of the passes and just record zero scores
+	const doub_opt &prune_below_score = prm_ssap_options.get_prune_below_score();
+	if ( prune_below_score ) {
+		const double score_bound = ssap_score_upper_bound(
+			prm_protein_a.get_length(),
+			prm_protein_b.get_length(),
+			residue_querier(),
+			prm_ssap_options.get_use_local_ssap_score()
+		);
+		if ( score_bound < *prune_below_score ) {
+			BOOST_LOG_TRIVIAL( info ) << "Pruning comparison of "
+			                          << get_domain_or_specified_or_name_from_acq( prm_protein_a )
+			                          << " and "
+			                          << get_domain_or_specified_or_name_from_acq( prm_protein_b )
+			                          << " before any passes because the lengths bound its score at "
+			                          << score_bound
+			                          << ", which is below "
+			                          << *prune_below_score;
+			global_run_counter = 1;
+			save_zero_scores( prm_protein_a, prm_protein_b, global_run_counter );
+			return;
+		}
+	}
+
 	ssap_scores fast_ssap_scores;
 	if ( !prm_ssap_options.get_slow_ssap_only() ) {
 		// Check for minimum number of secondary structures
@@ -613,13 +773,17 @@ void cath::align_proteins(const protein                 &prm_protein_a,    ///<
 		global_doing_fast_ssap = false;
 		global_num_selections  =     0;
 
+		// Copy the residue data used in the residue passes' inner loops into contiguous arrays
+		const protein_comparison_view view_a{ prm_protein_a };
+		const protein_comparison_view view_b{ prm_protein_b };
+
 		// Perform two residue alignment passes
 		for (const size_t &pass_ctr : { 1_z, 2_z } ) {
 			BOOST_LOG_TRIVIAL( debug ) << "Function: alnseq:  pass=" << pass_ctr;
 
 			global_align_pass = ( pass_ctr > 1 );
 			if (pass_ctr == 1 || (pass_ctr == 2 && global_res_score))  {
-				compare( prm_protein_a, prm_protein_b, pass_ctr, residue_querier(), prm_ssap_options, prm_data_dirs, none );
+				compare( prm_protein_a, prm_protein_b, pass_ctr, residue_querier{ view_a, view_b }, prm_ssap_options, prm_data_dirs, none );
 			}
 		}
 	}
@@ -659,12 +823,16 @@ ssap_scores cath::fast_ssap(const protein                 &prm_protein_a,    ///
 	global_doing_fast_ssap =  true;
 	global_num_selections  =     0;
 
+	// Copy the residue data used in the residue passes' inner loops into contiguous arrays
+	const protein_comparison_view view_a{ prm_protein_a };
+	const protein_comparison_view view_b{ prm_protein_b };
+
 	// Perform two residue alignment passes
 	for (const size_t &pass_ctr  : { 1_z, 2_z } ) {
 		BOOST_LOG_TRIVIAL( debug ) << "Function: fast_ssap:  pass=" << pass_ctr;
 		global_align_pass = ( pass_ctr > 1 );
 		if ( pass_ctr == 1 || ( pass_ctr == 2 && global_res_score ) ) {
-			const pair<ssap_scores, alignment> tmp_scores_and_aln = compare( prm_protein_a, prm_protein_b, pass_ctr, residue_querier(), prm_ssap_options, prm_data_dirs, sec_struc_alignment );
+			const pair<ssap_scores, alignment> tmp_scores_and_aln = compare( prm_protein_a, prm_protein_b, pass_ctr, residue_querier{ view_a, view_b }, prm_ssap_options, prm_data_dirs, sec_struc_alignment );
 			new_ssap_scores = tmp_scores_and_aln.first;
 		}
 	}
@@ -685,6 +853,9 @@ pair<ssap_scores, alignment> cath::compare(const protein                 &prm_pr
 	const bool   res_not_ss__hacky = prm_entry_querier.temp_hacky_is_residue();
 	const string entry_plural_name = get_plural_name(prm_entry_querier);
 
+	// Time the comparison as the secondary structure pass if comparing secondary structures
+	const ssap_phase_timer sec_struc_timer{ res_not_ss__hacky ? nullptr : phase_timings_ptr(), ssap_phase::SEC_STRUC_PASS };
+
 	const size_t length_a = prm_entry_querier.get_length(prm_protein_a);
 	const size_t length_b = prm_entry_querier.get_length(prm_protein_b);
 
@@ -749,11 +920,14 @@ pair<ssap_scores, alignment> cath::compare(const protein                 &prm_pr
 	);
 
 	// Align the upper matrix using dynamic-programming
-	score_alignment_pair score_and_alignment = ssap_code_dyn_prog_aligner().align(
-		upper_score_matrix_score_source,
-		gap_penalty( global_gap_penalty, 0 ),
-		global_window
-	);
+	score_alignment_pair score_and_alignment = [&] {
+		const ssap_phase_timer dyn_prog_timer{ phase_timings_ptr(), ssap_phase::FINAL_DYN_PROG };
+		return ssap_code_dyn_prog_aligner().align(
+			upper_score_matrix_score_source,
+			gap_penalty( global_gap_penalty, 0 ),
+			global_window
+		);
+	} ();
 	const score_type &score         = score_and_alignment.first;
 	alignment        &new_alignment = score_and_alignment.second;
 
@@ -1085,78 +1259,340 @@ void cath::set_mask_matrix(const protein       &prm_protein_a,        ///< The f
 }
 
 
-/// \brief Selects residue pairs in similar structural locations or secondary structures of same type
-///
-/// This sets global_lower_mask_matrix and possibly global_upper_ss_mask_matrix with the selections
-void cath::select_pairs(const protein       &prm_protein_a,    ///< The first protein
-                        const protein       &prm_protein_b,    ///< The second protein
-                        const size_t        &prm_pass,         ///< The pass of this comparison (where the second typically refines the alignment generated by the first)
-                        const entry_querier &prm_entry_querier ///< The entry_querier to query either residues or secondary structures
-                        ) {
-	const size_t length_a = prm_entry_querier.get_length(prm_protein_a);
-	const size_t length_b = prm_entry_querier.get_length(prm_protein_b);
+namespace {
 
-	deque<selected_pair> selected_pairs;
-
-	// Reset variables/arrays for selected residue pairs
-	size_t num_entries_selected         = 0;
-	size_t total_num_entries_considered = 0;
-
-	// Compare properties of residue/SS pairs for each cell in matrix window
-	for (const size_t &ctr_b : indices( length_b ) | reversed ) {
-		const size_t ctr_b__offset_1 = ctr_b + 1;
-		const size_t window_start__offset_1 = get_window_start_a_for_b__offset_1( length_a, length_b, global_window, ctr_b__offset_1 );
-		const size_t window_stop__offset_1  = get_window_stop_a_for_b__offset_1 ( length_a, length_b, global_window, ctr_b__offset_1 );
-
-		for (const size_t &ctr_a : irange( window_start__offset_1 - 1, window_stop__offset_1 ) | reversed ) {
-			const size_t ctr_a__offset_1 = ctr_a + 1;
-			++total_num_entries_considered;
-			const int a_matrix_idx__offset_1 = get_window_matrix_a_index__offset_1( length_a, length_b, global_window, ctr_a__offset_1, ctr_b__offset_1 );
-
-			// First pass:
-			//   for residues:             select if areas/angles similar
-			//   for secondary structures: select if both are of same type
-			if ( prm_pass == 1 ) {
-				if ( prm_entry_querier.are_similar__offset_1( prm_protein_a, prm_protein_b, ctr_a__offset_1, ctr_b__offset_1 ) ) {
-					++num_entries_selected;
-					global_lower_mask_matrix.set   ( ctr_b__offset_1, ctr_a__offset_1, true );
-					global_upper_ss_mask_matrix.set( ctr_b__offset_1, ctr_a__offset_1, true );
+	/// \brief Implementation of select_pairs() for a particular type of entry_querier
+	///
+	/// This is templated on the type of the querier so that, when instantiated with a concrete
+	/// (final) querier type, the per-cell queries in the loops are resolved at compile-time
+	/// rather than through entry_querier's virtual functions. See dispatch_on_querier_type().
+	template <typename QRY>
+	void select_pairs_impl(const protein &prm_protein_a, ///< The first protein
+	                       const protein &prm_protein_b, ///< The second protein
+	                       const size_t  &prm_pass,      ///< The pass of this comparison (where the second typically refines the alignment generated by the first)
+	                       const QRY     &prm_querier    ///< The querier to query either residues or secondary structures
+	                       ) {
+		const size_t length_a = prm_querier.get_length(prm_protein_a);
+		const size_t length_b = prm_querier.get_length(prm_protein_b);
+
+		deque<selected_pair> selected_pairs;
+
+		// Reset variables/arrays for selected residue pairs
+		size_t num_entries_selected         = 0;
+		size_t total_num_entries_considered = 0;
+
+		// Compare properties of residue/SS pairs for each cell in matrix window
+		for (const size_t &ctr_b : indices( length_b ) | reversed ) {
+			const size_t ctr_b__offset_1 = ctr_b + 1;
+			const size_t window_start__offset_1 = get_window_start_a_for_b__offset_1( length_a, length_b, global_window, ctr_b__offset_1 );
+			const size_t window_stop__offset_1  = get_window_stop_a_for_b__offset_1 ( length_a, length_b, global_window, ctr_b__offset_1 );
+
+			for (const size_t &ctr_a : irange( window_start__offset_1 - 1, window_stop__offset_1 ) | reversed ) {
+				const size_t ctr_a__offset_1 = ctr_a + 1;
+				++total_num_entries_considered;
+				const int a_matrix_idx__offset_1 = get_window_matrix_a_index__offset_1( length_a, length_b, global_window, ctr_a__offset_1, ctr_b__offset_1 );
+
+				// First pass:
+				//   for residues:             select if areas/angles similar
+				//   for secondary structures: select if both are of same type
+				if ( prm_pass == 1 ) {
+					if ( prm_querier.are_similar__offset_1( prm_protein_a, prm_protein_b, ctr_a__offset_1, ctr_b__offset_1 ) ) {
+						++num_entries_selected;
+						global_lower_mask_matrix.set   ( ctr_b__offset_1, ctr_a__offset_1, true );
+						global_upper_ss_mask_matrix.set( ctr_b__offset_1, ctr_a__offset_1, true );
+					}
+					else {
+						global_lower_mask_matrix.set   ( ctr_b__offset_1, ctr_a__offset_1, false );
+						global_upper_ss_mask_matrix.set( ctr_b__offset_1, ctr_a__offset_1, false );
+					}
 				}
+				// Subsequent passes (must be residues):
+				//   select 20 highest scoring residue pairs from first pass
 				else {
-					global_lower_mask_matrix.set   ( ctr_b__offset_1, ctr_a__offset_1, false );
-					global_upper_ss_mask_matrix.set( ctr_b__offset_1, ctr_a__offset_1, false );
+					const score_type score = global_upper_score_matrix.get( ctr_b__offset_1, numeric_cast<size_t>( a_matrix_idx__offset_1 ) );
+					update_best_pair_selections( selected_pairs, selected_pair( ctr_a__offset_1, ctr_b__offset_1, score ), NUM_SELECTIONS_TO_SAVE );
 				}
 			}
-			// Subsequent passes (must be residues):
-			//   select 20 highest scoring residue pairs from first pass
-			else {
-				const score_type score = global_upper_score_matrix.get( ctr_b__offset_1, numeric_cast<size_t>( a_matrix_idx__offset_1 ) );
-				update_best_pair_selections( selected_pairs, selected_pair( ctr_a__offset_1, ctr_b__offset_1, score ), NUM_SELECTIONS_TO_SAVE );
+		}
+
+		// For second pass and residue comparisons, copy selected residues into select structure
+		if ( global_align_pass && prm_querier.temp_hacky_is_residue() ) {
+			global_selections.assign( NUM_SELECTIONS_TO_SAVE + 1, make_pair( 0_z, 0_z ) );
+			for (const size_t &selected_ctr : indices( selected_pairs.size() ) ) {
+				// Index is calculated to put the selection at the end of the positions with indices 1..NUM_TO_SAVE
+				const size_t index_in_global_selections = NUM_SELECTIONS_TO_SAVE + 1 - ( selected_pairs.size() - selected_ctr );
+				global_selections[ index_in_global_selections ] = make_pair(
+					selected_pairs[ selected_ctr ].get_index_a(),
+					selected_pairs[ selected_ctr ].get_index_b()
+				);
 			}
+			global_num_selections = NUM_SELECTIONS_TO_SAVE;
+		}
+
+		// Calculate fraction of total residue pairs selected
+		if ( prm_pass > 1 ) {
+			num_entries_selected = NUM_SELECTIONS_TO_SAVE;
+		}
+		if ( global_align_pass && prm_querier.temp_hacky_is_residue()) {
+			global_frac_selected = numeric_cast<double>( num_entries_selected ) / numeric_cast<double>( total_num_entries_considered );
+		}
+		if ( global_record_phase_timings ) {
+			global_phase_timings.add_pairs_selected( num_entries_selected );
 		}
 	}
 
-	// For second pass and residue comparisons, copy selected residues into select structure
-	if ( global_align_pass && prm_entry_querier.temp_hacky_is_residue() ) {
-		global_selections.assign( NUM_SELECTIONS_TO_SAVE + 1, make_pair( 0_z, 0_z ) );
-		for (const size_t &selected_ctr : indices( selected_pairs.size() ) ) {
-			// Index is calculated to put the selection at the end of the positions with indices 1..NUM_TO_SAVE
-			const size_t index_in_global_selections = NUM_SELECTIONS_TO_SAVE + 1 - ( selected_pairs.size() - selected_ctr );
-			global_selections[ index_in_global_selections ] = make_pair(
-				selected_pairs[ selected_ctr ].get_index_a(),
-				selected_pairs[ selected_ctr ].get_index_b()
+	/// \brief Implementation of compare_upper_cell() for a particular type of entry_querier
+	///
+	/// This is templated on the type of the querier (for the same reasons as select_pairs_impl())
+	/// and it aligns with score functions rather than with dyn_prog_score_sources so that
+	/// the aligner can inline the per-cell scoring
+	template <typename QRY>
+	compare_upper_cell_result compare_upper_cell_impl(const protein &prm_protein_a,                   ///< The first  protein
+	                                                  const protein &prm_protein_b,                   ///< The second protein
+	                                                  const size_t  &prm_a_view_from_index__offset_1, ///< The index of the residue/secondary-structure in the first  protein on which this should be performed
+	                                                  const size_t  &prm_b_view_from_index__offset_1, ///< The index of the residue/secondary-structure in the second protein on which this should be performed
+	                                                  const QRY     &prm_querier,                     ///< The querier to query either residues or secondary structures
+	                                                  const double  &prm_normalisation                ///< The value that should be used to normalise the score for residues before comparison against MIN_LOWER_MAT_RES_SCORE
+	                                                  ) {
+		const bool   res_not_ss__hacky = prm_querier.temp_hacky_is_residue();
+		const size_t length_a          = prm_querier.get_length(prm_protein_a);
+		const size_t length_b          = prm_querier.get_length(prm_protein_b);
+
+		// Construct two score functions to be used for aligning using dynamic-programming:
+		//  * the first just uses prm_querier, prm_a_view_from_index and prm_b_view_from_index
+		//  * the second is a masked version of the first, using global_lower_mask_matrix
+		//
+		// These do the same as entry_querier_dyn_prog_score_source and mask_dyn_prog_score_source
+		// but their types are known here so the aligner can inline them into its loops
+		check_offset_1(prm_a_view_from_index__offset_1);
+		check_offset_1(prm_b_view_from_index__offset_1);
+		const auto querier_score_fn = [&] (const size_t &prm_index_a__offset_1, const size_t &prm_index_b__offset_1) {
+			return prm_querier.distance_score__offset_1(
+				prm_protein_a,                   prm_protein_b,
+				prm_a_view_from_index__offset_1, prm_b_view_from_index__offset_1,
+				prm_index_a__offset_1,           prm_index_b__offset_1
 			);
+		};
+		const auto mask_score_fn = [&] (const size_t &prm_index_a__offset_1, const size_t &prm_index_b__offset_1) {
+			return global_lower_mask_matrix.get( prm_index_b__offset_1, prm_index_a__offset_1 ) ? querier_score_fn( prm_index_a__offset_1, prm_index_b__offset_1 )
+			                                                                                    : score_type{ 0 };
+		};
+
+		// Align the lower matrix using dynamic-programming, choosing between the two score functions:
+		//  * if this is an aligning pass, then use querier_score_fn;
+		//  * otherwise, use mask_score_fn, which is like querier_score_fn but masked
+		const gap_penalty    lower_gap_penalty{ global_gap_penalty, 0 };
+		score_alignment_pair score_and_alignment = global_align_pass ? ssap_code_dyn_prog_aligner::align_with_score_fn( querier_score_fn, length_a, length_b, lower_gap_penalty, global_window )
+		                                                             : ssap_code_dyn_prog_aligner::align_with_score_fn( mask_score_fn,    length_a, length_b, lower_gap_penalty, global_window );
+		score_type       score        = score_and_alignment.first;
+		const alignment &my_alignment = score_and_alignment.second;
+
+	//	cerr << "Comparing\t" << prm_a_view_from_index << "\t" << prm_b_view_from_index << "\t" << prm_querier.get_entry_name();
+	//	cerr << "\tscore is " << score << "\twith alignment length " << my_alignment.length() << endl;
+
+		// Check whether normalised score is above threshold
+		if ( res_not_ss__hacky ) {
+			if ( prm_normalisation != 0.0 ) {
+				score = numeric_cast<score_type>( numeric_cast<double>( score ) / prm_normalisation );
+			}
+			else {
+				score = 0;
+			}
+		}
+
+		if ( score == 0 ) {
+			return compare_upper_cell_result::ZERO;
+		}
+		if ( res_not_ss__hacky && score < MIN_LOWER_MAT_RES_SCORE ) {
+			return compare_upper_cell_result::NON_ZERO_BELOW_THRESHOLD;
 		}
-		global_num_selections = NUM_SELECTIONS_TO_SAVE;
+
+		// If yes, trace distance (lower) level alignment path, onto residue (upper) level matrix
+		for (const size_t &alignment_ctr : indices( my_alignment.length() ) ) {
+			if (has_both_positions_of_index(my_alignment, alignment_ctr)) {
+				const aln_posn_type a_dest_to_index__offset_1 = get_a_offset_1_position_of_index( my_alignment, alignment_ctr );
+				const aln_posn_type b_dest_to_index__offset_1 = get_b_offset_1_position_of_index( my_alignment, alignment_ctr );
+				const int           a_matrix_idx__offset_1    = get_window_matrix_a_index__offset_1(length_a, length_b, global_window, a_dest_to_index__offset_1, b_dest_to_index__offset_1);
+				const score_type    score_addend              = prm_querier.distance_score__offset_1(
+					prm_protein_a,                   prm_protein_b,
+					prm_a_view_from_index__offset_1, prm_b_view_from_index__offset_1,
+					a_dest_to_index__offset_1,       b_dest_to_index__offset_1
+				);
+				global_upper_score_matrix.get( b_dest_to_index__offset_1, numeric_cast<size_t>( a_matrix_idx__offset_1 ) ) += score_addend;
+	//			cerr << "At\t" << ( prm_a_view_from_index__offset_1 - 1 );
+	//			cerr << "\t"   << ( prm_b_view_from_index__offset_1 - 1 );
+	//			cerr << "\t"   << ( a_dest_to_index__offset_1       - 1 );
+	//			cerr << "\t"   << ( b_dest_to_index__offset_1       - 1 );
+	//			cerr << "\tadding score:\t" << score_addend;
+	//			cerr << "\tto get:\t" << global_upper_score_matrix[b_dest_to_index__offset_1][ numeric_cast<size_t>( a_matrix_idx__offset_1 ) ];
+	//			cerr <<"\t["   << get_plural_name(prm_querier) << "]" << endl;
+			}
+		}
+		return compare_upper_cell_result::SCORED;
 	}
 
-	// Calculate fraction of total residue pairs selected
-	if ( prm_pass > 1 ) {
-		num_entries_selected = NUM_SELECTIONS_TO_SAVE;
+	/// \brief Implementation of populate_upper_score_matrix() for a particular type of entry_querier
+	///
+	/// This is templated on the type of the querier (for the same reasons as select_pairs_impl())
+	/// and calls compare_upper_cell_impl() with the same type for each cell
+	template <typename QRY>
+	void populate_upper_score_matrix_impl(const protein &prm_protein_a,  ///< The first protein
+	                                      const protein &prm_protein_b,  ///< The second protein
+	                                      const QRY     &prm_querier,    ///< The querier to query either residues or secondary structures
+	                                      const bool    &prm_align_pass  ///< Whether this is a later, alignment-refining pass
+	                                      ) {
+		// If this is a later, alignment-refining pass of residue this use the selected
+		// set of top-scoring residue pairs
+		const bool res_not_ss__hacky = prm_querier.temp_hacky_is_residue();
+		const bool using_selections  = (res_not_ss__hacky && prm_align_pass);
+
+		// Set number of elements in protein A and B to compare
+
+		const size_t full_length_a = prm_querier.get_length(prm_protein_a);
+		const size_t full_length_b = prm_querier.get_length(prm_protein_b);
+		const size_t length_a      =                                            full_length_a;
+		const size_t length_b      = using_selections ? global_num_selections : full_length_b;
+
+		// Set normalisation constant
+		//
+		// Note: it's not very clear where these two constants come from and the value
+		//       only seems to get used in compare_upper_cell() if comparing residues
+		//       (not secondary structures) anyway.
+		const double normalisation_num = res_not_ss__hacky ? 200.0 : 25.0;
+		const double normalisation     = global_frac_selected * sqrt( normalisation_num * numeric_cast<double>( min( length_a, length_b ) ) );
+
+		size_t num_potential_upper_cell_comps = 0;
+		size_t num_actual_upper_cell_comps    = 0;
+		bool   found_non_zero_cell            = false;
+		bool   found_threshold_cell           = false;
+
+		// Reverse-iterate over the elements in prm_protein_b
+		// (or over the selections if using them)
+		for (const size_t &ctr_b : indices( length_b ) | reversed ) {
+			const size_t ctr_b__offset_1 = ctr_b + 1;
+			// Calculate the prm_protein_a window start/stop for this prm_protein_b entry
+			// (or just set them both from the selected pair if using selections)
+			const size_t window_start__offset_1 = using_selections ? global_selections[ctr_b__offset_1].first
+			                                                       : get_window_start_a_for_b__offset_1( length_a, length_b, global_window, ctr_b__offset_1 );
+			const size_t window_stop__offset_1  = using_selections ? global_selections[ctr_b__offset_1].first
+			                                                       : get_window_stop_a_for_b__offset_1(  length_a, length_b, global_window, ctr_b__offset_1 );
+			const size_t jval                   = using_selections ? global_selections[ctr_b__offset_1].second
+			                                                       : ctr_b__offset_1;
+
+			// Iterate over the window that's been calculated
+			for (const size_t &ctr_a : irange( window_start__offset_1 - 1, window_stop__offset_1 ) | reversed ) {
+				const size_t ctr_a__offset_1 = ctr_a + 1;
+				// Determine whether this pair should be compared:
+				//  - If using selections,           then true, else
+				//  - If using residues,             then consult global_upper_res_mask_matrix, else
+				//  -    Using secondary structures, so   consult global_upper_ss_mask_matrix
+				bool should_compare_pair = true;
+				if ( ! using_selections ) {
+					if ( res_not_ss__hacky ) {
+						const int a_matrix_idx__offset_1 = get_window_matrix_a_index__offset_1( length_a, length_b, global_window, ctr_a__offset_1, ctr_b__offset_1 );
+						should_compare_pair = global_upper_res_mask_matrix.get( ctr_b__offset_1, numeric_cast<size_t>( a_matrix_idx__offset_1 ) );
+					}
+					else {
+						should_compare_pair = global_upper_ss_mask_matrix.get( ctr_b__offset_1, ctr_a__offset_1 );
+					}
+				}
+
+				// Compare environments of allowed pairs
+				++num_potential_upper_cell_comps;
+				if ( should_compare_pair ) {
+					++num_actual_upper_cell_comps;
+					const auto compare_result = compare_upper_cell_impl(
+						prm_protein_a,
+						prm_protein_b,
+						ctr_a__offset_1,
+						jval,
+						prm_querier,
+						normalisation
+					);
+					found_non_zero_cell  = found_non_zero_cell  || ( compare_result != compare_upper_cell_result::ZERO   );
+					found_threshold_cell = found_threshold_cell || ( compare_result == compare_upper_cell_result::SCORED );
+				}
+			}
+		}
+
+
+		const string msg_context_prfx = "When populating upper_score_matrix ("
+		                                + prm_querier.get_entry_name()
+		                                + "; pass "
+		                                + booled_to_string( prm_align_pass )
+		                                + "), ";
+		if ( global_record_phase_timings ) {
+			global_phase_timings.add_cells_evaluated( num_actual_upper_cell_comps );
+		}
+		BOOST_LOG_TRIVIAL( trace ) << msg_context_prfx
+		                           << "compared "
+		                           << num_actual_upper_cell_comps
+		                           << " residue pairs out of a possible "
+		                           << num_potential_upper_cell_comps;
+		if ( res_not_ss__hacky && ! prm_align_pass ) {
+			if ( num_actual_upper_cell_comps == 0 ) {
+				BOOST_LOG_TRIVIAL( warning ) << msg_context_prfx
+				                             << "chose no residue pairs out of a possible "
+				                             << num_potential_upper_cell_comps
+				                             << " to compare."
+				                                " This may relate to https://github.com/UCLOrengoGroup/cath-tools/issues/8"
+				                                " - please see that issue for more information and please add a comment"
+				                                " if it's causing you problems (or open a new issue if this message is spurious).";
+			}
+			else if ( ! found_threshold_cell ) {
+				if ( found_non_zero_cell ) {
+					BOOST_LOG_TRIVIAL( warning ) << msg_context_prfx
+					                             << "attempted alignment for "
+					                             << num_potential_upper_cell_comps
+					                             << " cells in the upper matrix and though some achieved non-zero scores,"
+					                                " none of them reached the threshold after their normalisation";
+				}
+				else {
+					BOOST_LOG_TRIVIAL( warning ) << msg_context_prfx
+					                             << "attempted alignment for "
+					                             << num_potential_upper_cell_comps
+					                             << " cells in the upper matrix but none of them achieved non-zero scores";
+				}
+			}
+		}
 	}
-	if ( global_align_pass && prm_entry_querier.temp_hacky_is_residue()) {
-		global_frac_selected = numeric_cast<double>( num_entries_selected ) / numeric_cast<double>( total_num_entries_considered );
+
+	/// \brief Call the specified function with the specified entry_querier as its concrete type
+	///        if it's a residue_querier or sec_struc_querier or as a plain entry_querier otherwise
+	///
+	/// This allows the SSAP passes to pay for one dynamic_cast per pass rather than
+	/// for a virtual call per cell.
+	template <typename FN>
+	void dispatch_on_querier_type(const entry_querier &prm_entry_querier, ///< The entry_querier to dispatch on
+	                              FN                  &&prm_fn            ///< The (generic) function to call with the querier
+	                              ) {
+		if ( const auto * const residue_querier_ptr = dynamic_cast<const residue_querier *>( &prm_entry_querier ) ) {
+			prm_fn( *residue_querier_ptr );
+			return;
+		}
+		if ( const auto * const sec_struc_querier_ptr = dynamic_cast<const sec_struc_querier *>( &prm_entry_querier ) ) {
+			prm_fn( *sec_struc_querier_ptr );
+			return;
+		}
+		prm_fn( prm_entry_querier );
 	}
+
+} // namespace
+
+/// \brief Selects residue pairs in similar structural locations or secondary structures of same type
+///
+/// This sets global_lower_mask_matrix and possibly global_upper_ss_mask_matrix with the selections
+///
+/// This dispatches to select_pairs_impl() for the concrete type of prm_entry_querier
+void cath::select_pairs(const protein       &prm_protein_a,    ///< The first protein
+                        const protein       &prm_protein_b,    ///< The second protein
+                        const size_t        &prm_pass,         ///< The pass of this comparison (where the second typically refines the alignment generated by the first)
+                        const entry_querier &prm_entry_querier ///< The entry_querier to query either residues or secondary structures
+                        ) {
+	const ssap_phase_timer select_timer{ phase_timings_ptr(), ssap_phase::SELECT_PAIRS };
+	dispatch_on_querier_type( prm_entry_querier, [&] (const auto &prm_querier) {
+		select_pairs_impl( prm_protein_a, prm_protein_b, prm_pass, prm_querier );
+	} );
 }
 
 
@@ -1195,6 +1631,54 @@ void cath::update_best_pair_selections(deque<selected_pair> &prm_selected_pairs,
 }
 
 
+namespace {
+
+	/// \brief Check whether a pair of residues' area/angle properties are similar
+	///
+	/// This is the implementation shared by both residues_have_similar_area_angle_props() overloads
+	bool area_angle_props_are_similar(const int        &prm_buried_i, ///< The "accessi" value of the first  residue (see get_accessi_of_residue())
+	                                  const int        &prm_buried_j, ///< The "accessi" value of the second residue (see get_accessi_of_residue())
+	                                  const doub_angle &prm_phi_i,    ///< The phi angle of the first  residue
+	                                  const doub_angle &prm_phi_j,    ///< The phi angle of the second residue
+	                                  const doub_angle &prm_psi_i,    ///< The psi angle of the first  residue
+	                                  const doub_angle &prm_psi_j,    ///< The psi angle of the second residue
+	                                  const size_t     &prm_access_i, ///< The accessibility of the first  residue
+	                                  const size_t     &prm_access_j  ///< The accessibility of the second residue
+	                                  ) {
+		const size_t buried_difference          = numeric_cast<size_t>( difference( prm_buried_i, prm_buried_j ) );
+		const size_t phi_angle_diff_in_degrees  = numeric_cast<size_t>( round( difference(
+			angle_in_degrees( prm_phi_i ),
+			angle_in_degrees( prm_phi_j )
+		) ) );
+		const size_t psi_angle_diff_in_degrees  = numeric_cast<size_t>( round( difference(
+			angle_in_degrees( prm_psi_i ),
+			angle_in_degrees( prm_psi_j )
+		) ) );
+
+		const size_t mean_angle_diff_in_degrees = ( phi_angle_diff_in_degrees + psi_angle_diff_in_degrees ) / 2;
+		const size_t accessibility_sum          = prm_access_i + prm_access_j;
+//		const size_t accessibility_difference   = difference( prm_residue_i.get_access(), prm_residue_j.get_access() );
+
+//		cerr << "Phi     a                  : " << prm_residue_i.get_phi_angle()               << endl;
+//		cerr << "Phi     b                  : " << prm_residue_j.get_phi_angle()               << endl;
+//		cerr << "Psi     a                  : " << prm_residue_i.get_psi_angle()               << endl;
+//		cerr << "Psi     b                  : " << prm_residue_j.get_psi_angle()               << endl;
+//		cerr << "Average phi/psi difference : " << mean_angle_diff_in_degrees                  << endl;
+//		cerr << "Access  a                  : " << prm_residue_i.get_access()                  << endl;
+//		cerr << "Access  b                  : " << prm_residue_j.get_access()                  << endl;
+//		cerr << "Residue a                  : " << prm_residue_i.get_amino_acid().get_letter() << endl;
+//		cerr << "Residue b                  : " << prm_residue_j.get_amino_acid().get_letter() << endl;
+//		cerr << "Buried  a                  : " << buried_i                                    << endl;
+//		cerr << "Buried  b                  : " << buried_j                                    << endl;
+//		cerr << "Buried difference          : " << buried_difference                           << endl;
+
+		// Combined areas and angles
+		return ( buried_difference + accessibility_sum        + mean_angle_diff_in_degrees < global_res_sim_cutoff );
+//		return ( buried_difference + accessibility_difference + mean_angle_diff_in_degrees < global_res_sim_cutoff );
+	}
+
+} // namespace
+
 /// \brief Check whether residue pair have similar area/angle properties.
 ///
 /// Current globals used:
@@ -1212,38 +1696,29 @@ void cath::update_best_pair_selections(deque<selected_pair> &prm_selected_pairs,
 bool cath::residues_have_similar_area_angle_props(const residue &prm_residue_i, ///< The first  residue to compare
                                                   const residue &prm_residue_j  ///< The second residue to compare
                                                   ) {
-	const int    buried_i                   = get_accessi_of_residue( prm_residue_i );
-	const int    buried_j                   = get_accessi_of_residue( prm_residue_j );
-	const size_t buried_difference          = numeric_cast<size_t>( difference( buried_i, buried_j ) );
-	const size_t phi_angle_diff_in_degrees  = numeric_cast<size_t>( round( difference(
-		angle_in_degrees( prm_residue_i.get_phi_angle() ),
-		angle_in_degrees( prm_residue_j.get_phi_angle() )
-	) ) );
-	const size_t psi_angle_diff_in_degrees  = numeric_cast<size_t>( round( difference(
-		angle_in_degrees( prm_residue_i.get_psi_angle() ),
-		angle_in_degrees( prm_residue_j.get_psi_angle() )
-	) ) );
-
-	const size_t mean_angle_diff_in_degrees = ( phi_angle_diff_in_degrees + psi_angle_diff_in_degrees ) / 2;
-	const size_t accessibility_sum          = prm_residue_i.get_access() + prm_residue_j.get_access();
-//	const size_t accessibility_difference   = difference( prm_residue_i.get_access(), prm_residue_j.get_access() );
-
-//	cerr << "Phi     a                  : " << prm_residue_i.get_phi_angle()               << endl;
-//	cerr << "Phi     b                  : " << prm_residue_j.get_phi_angle()               << endl;
-//	cerr << "Psi     a                  : " << prm_residue_i.get_psi_angle()               << endl;
-//	cerr << "Psi     b                  : " << prm_residue_j.get_psi_angle()               << endl;
-//	cerr << "Average phi/psi difference : " << mean_angle_diff_in_degrees                  << endl;
-//	cerr << "Access  a                  : " << prm_residue_i.get_access()                  << endl;
-//	cerr << "Access  b                  : " << prm_residue_j.get_access()                  << endl;
-//	cerr << "Residue a                  : " << prm_residue_i.get_amino_acid().get_letter() << endl;
-//	cerr << "Residue b                  : " << prm_residue_j.get_amino_acid().get_letter() << endl;
-//	cerr << "Buried  a                  : " << buried_i                                    << endl;
-//	cerr << "Buried  b                  : " << buried_j                                    << endl;
-//	cerr << "Buried difference          : " << buried_difference                           << endl;
-
-	// Combined areas and angles
-	return ( buried_difference + accessibility_sum        + mean_angle_diff_in_degrees < global_res_sim_cutoff );
-//	return ( buried_difference + accessibility_difference + mean_angle_diff_in_degrees < global_res_sim_cutoff );
+	return area_angle_props_are_similar(
+		get_accessi_of_residue( prm_residue_i ), get_accessi_of_residue( prm_residue_j ),
+		prm_residue_i.get_phi_angle(),           prm_residue_j.get_phi_angle(),
+		prm_residue_i.get_psi_angle(),           prm_residue_j.get_psi_angle(),
+		prm_residue_i.get_access(),              prm_residue_j.get_access()
+	);
+}
+
+/// \brief Check whether residue pair have similar area/angle properties, reading the residue data
+///        from protein_comparison_views
+///
+/// This gives the same result as residues_have_similar_area_angle_props() on the equivalent residues
+bool cath::residues_have_similar_area_angle_props(const protein_comparison_view &prm_view_i,  ///< A view of the protein containing the first  residue
+                                                  const size_t                  &prm_index_i, ///< The index of the first  residue to compare
+                                                  const protein_comparison_view &prm_view_j,  ///< A view of the protein containing the second residue
+                                                  const size_t                  &prm_index_j  ///< The index of the second residue to compare
+                                                  ) {
+	return area_angle_props_are_similar(
+		prm_view_i.get_accessi_of_index  ( prm_index_i ), prm_view_j.get_accessi_of_index  ( prm_index_j ),
+		prm_view_i.get_phi_angle_of_index( prm_index_i ), prm_view_j.get_phi_angle_of_index( prm_index_j ),
+		prm_view_i.get_psi_angle_of_index( prm_index_i ), prm_view_j.get_psi_angle_of_index( prm_index_j ),
+		prm_view_i.get_access_of_index   ( prm_index_i ), prm_view_j.get_access_of_index   ( prm_index_j )
+	);
 }
 
 /// \brief Populate the scores for the upper (ie major, whole) matrix
@@ -1273,128 +1748,25 @@ bool cath::residues_have_similar_area_angle_props(const residue &prm_residue_i,
 ///       Ensure that the standard matrix iteration matches the sweep that's required
 ///       by the dynamic-programming code in score_matrix().
 ///
+/// This dispatches to populate_upper_score_matrix_impl() for the concrete type of prm_entry_querier
+///
 /// \todo For this function, ensure that the particular masking behaviour is also dependency-injected
 void cath::populate_upper_score_matrix(const protein       &prm_protein_a,     ///< The first protein
                                        const protein       &prm_protein_b,     ///< The second protein
                                        const entry_querier &prm_entry_querier, ///< The entry_querier to query either residues or secondary structures
                                        const bool          &prm_align_pass     ///< Whether this is a later, alignment-refining pass
                                        ) {
-	// If this is a later, alignment-refining pass of residue this use the selected
-	// set of top-scoring residue pairs
-	const bool res_not_ss__hacky = prm_entry_querier.temp_hacky_is_residue();
-	const bool using_selections  = (res_not_ss__hacky && prm_align_pass);
-
-	// Set number of elements in protein A and B to compare
-
-	const size_t full_length_a = prm_entry_querier.get_length(prm_protein_a);
-	const size_t full_length_b = prm_entry_querier.get_length(prm_protein_b);
-	const size_t length_a      =                                            full_length_a;
-	const size_t length_b      = using_selections ? global_num_selections : full_length_b;
-
-	// Set normalisation constant
-	//
-	// Note: it's not very clear where these two constants come from and the value
-	//       only seems to get used in compare_upper_cell() if comparing residues
-	//       (not secondary structures) anyway.
-	const double normalisation_num = res_not_ss__hacky ? 200.0 : 25.0;
-	const double normalisation     = global_frac_selected * sqrt( normalisation_num * numeric_cast<double>( min( length_a, length_b ) ) );
-
-	size_t num_potential_upper_cell_comps = 0;
-	size_t num_actual_upper_cell_comps    = 0;
-	bool   found_non_zero_cell            = false;
-	bool   found_threshold_cell           = false;
-
-	// Reverse-iterate over the elements in prm_protein_b
-	// (or over the selections if using them)
-	for (const size_t &ctr_b : indices( length_b ) | reversed ) {
-		const size_t ctr_b__offset_1 = ctr_b + 1;
-		// Calculate the prm_protein_a window start/stop for this prm_protein_b entry
-		// (or just set them both from the selected pair if using selections)
-		const size_t window_start__offset_1 = using_selections ? global_selections[ctr_b__offset_1].first
-		                                                       : get_window_start_a_for_b__offset_1( length_a, length_b, global_window, ctr_b__offset_1 );
-		const size_t window_stop__offset_1  = using_selections ? global_selections[ctr_b__offset_1].first
-		                                                       : get_window_stop_a_for_b__offset_1(  length_a, length_b, global_window, ctr_b__offset_1 );
-		const size_t jval                   = using_selections ? global_selections[ctr_b__offset_1].second
-		                                                       : ctr_b__offset_1;
-
-		// Iterate over the window that's been calculated
-		for (const size_t &ctr_a : irange( window_start__offset_1 - 1, window_stop__offset_1 ) | reversed ) {
-			const size_t ctr_a__offset_1 = ctr_a + 1;
-			// Determine whether this pair should be compared:
-			//  - If using selections,           then true, else
-			//  - If using residues,             then consult global_upper_res_mask_matrix, else
-			//  -    Using secondary structures, so   consult global_upper_ss_mask_matrix
-			bool should_compare_pair = true;
-			if ( ! using_selections ) {
-				if ( res_not_ss__hacky ) {
-					const int a_matrix_idx__offset_1 = get_window_matrix_a_index__offset_1( length_a, length_b, global_window, ctr_a__offset_1, ctr_b__offset_1 );
-					should_compare_pair = global_upper_res_mask_matrix.get( ctr_b__offset_1, numeric_cast<size_t>( a_matrix_idx__offset_1 ) );
-				}
-				else {
-					should_compare_pair = global_upper_ss_mask_matrix.get( ctr_b__offset_1, ctr_a__offset_1 );
-				}
-			}
-
-			// Compare environments of allowed pairs
-			++num_potential_upper_cell_comps;
-			if ( should_compare_pair ) {
-				++num_actual_upper_cell_comps;
-				const auto compare_result = compare_upper_cell(
-					prm_protein_a,
-					prm_protein_b,
-					ctr_a__offset_1,
-					jval,
-					prm_entry_querier,
-					normalisation
-				);
-				found_non_zero_cell  = found_non_zero_cell  || ( compare_result != compare_upper_cell_result::ZERO   );
-				found_threshold_cell = found_threshold_cell || ( compare_result == compare_upper_cell_result::SCORED );
-			}
-		}
-	}
-
-
-	const string msg_context_prfx = "When populating upper_score_matrix ("
-	                                + prm_entry_querier.get_entry_name()
-	                                + "; pass "
-	                                + booled_to_string( prm_align_pass )
-	                                + "), ";
-	BOOST_LOG_TRIVIAL( trace ) << msg_context_prfx
-	                           << "compared "
-	                           << num_actual_upper_cell_comps
-	                           << " residue pairs out of a possible "
-	                           << num_potential_upper_cell_comps;
-	if ( res_not_ss__hacky && ! prm_align_pass ) {
-		if ( num_actual_upper_cell_comps == 0 ) {
-			BOOST_LOG_TRIVIAL( warning ) << msg_context_prfx
-			                             << "chose no residue pairs out of a possible "
-			                             << num_potential_upper_cell_comps
-			                             << " to compare."
-			                                " This may relate to https://github.com/UCLOrengoGroup/cath-tools/issues/8"
-			                                " - please see that issue for more information and please add a comment"
-			                                " if it's causing you problems (or open a new issue if this message is spurious).";
-		}
-		else if ( ! found_threshold_cell ) {
-			if ( found_non_zero_cell ) {
-				BOOST_LOG_TRIVIAL( warning ) << msg_context_prfx
-				                             << "attempted alignment for "
-				                             << num_potential_upper_cell_comps
-				                             << " cells in the upper matrix and though some achieved non-zero scores,"
-				                                " none of them reached the threshold after their normalisation";
-			}
-			else {
-				BOOST_LOG_TRIVIAL( warning ) << msg_context_prfx
-				                             << "attempted alignment for "
-				                             << num_potential_upper_cell_comps
-				                             << " cells in the upper matrix but none of them achieved non-zero scores";
-			}
-		}
-	}
+	const ssap_phase_timer populate_timer{ phase_timings_ptr(), ssap_phase::POPULATE_UPPER_SCORE_MATRIX };
+	dispatch_on_querier_type( prm_entry_querier, [&] (const auto &prm_querier) {
+		populate_upper_score_matrix_impl( prm_protein_a, prm_protein_b, prm_querier, prm_align_pass );
+	} );
 }
 
 /// \brief Compares residue environments in lower level matrix, if score above threshold,
 ///        adds alignment path to upper level matrix
 ///
+/// This dispatches to compare_upper_cell_impl() for the concrete type of prm_entry_querier
+///
 /// \todo Figure out what's going on
 compare_upper_cell_result cath::compare_upper_cell(const protein       &prm_protein_a,                   ///< The first  protein
                                                    const protein       &prm_protein_b,                   ///< The second protein
@@ -1403,84 +1775,18 @@ compare_upper_cell_result cath::compare_upper_cell(const protein       &prm_prot
                                                    const entry_querier &prm_entry_querier,               ///< The entry_querier to query either residues or secondary structures
                                                    const double        &prm_normalisation                ///< The value that should be used to normalise the score for residues before comparison against MIN_LOWER_MAT_RES_SCORE
                                                    ) {
-	const bool   res_not_ss__hacky = prm_entry_querier.temp_hacky_is_residue();
-	const size_t length_a          = prm_entry_querier.get_length(prm_protein_a);
-	const size_t length_b          = prm_entry_querier.get_length(prm_protein_b);
-
-	// Construct two sources of scores to be used for aligning using dynamic-programming:
-	//  * the first just uses prm_entry_querier, prm_a_view_from_index and prm_b_view_from_index
-	//  * the second is a masked version of the first, using global_lower_mask_matrix
-	check_offset_1(prm_a_view_from_index__offset_1);
-	check_offset_1(prm_b_view_from_index__offset_1);
-	const entry_querier_dyn_prog_score_source entry_querier_score_source(
-		prm_entry_querier,
-		prm_protein_a,
-		prm_protein_b,
-		prm_a_view_from_index__offset_1 - 1,
-		prm_b_view_from_index__offset_1 - 1
-	);
-	const mask_dyn_prog_score_source mask_score_source(
-		global_lower_mask_matrix,
-		entry_querier_score_source
-	);
-
-	// Choose between the two score sources:
-	//  * if this is an aligning pass, then use entry_querier_score_source;
-	//  * otherwise, use mask_score_source, which is like entry_querier_score_source but masked
-	const dyn_prog_score_source &the_score_source = global_align_pass ? static_cast<const dyn_prog_score_source &>(entry_querier_score_source)
-	                                                                  : static_cast<const dyn_prog_score_source &>(mask_score_source);
-
-	// Align the lower matrix using dynamic-programming
-	score_alignment_pair score_and_alignment = ssap_code_dyn_prog_aligner().align(
-		the_score_source,
-		gap_penalty(global_gap_penalty, 0),
-		global_window
-	);
-	score_type       score        = score_and_alignment.first;
-	const alignment &my_alignment = score_and_alignment.second;
-
-//	cerr << "Comparing\t" << prm_a_view_from_index << "\t" << prm_b_view_from_index << "\t" << prm_entry_querier.get_entry_name();
-//	cerr << "\tscore is " << score << "\twith alignment length " << my_alignment.length() << endl;
-
-	// Check whether normalised score is above threshold
-	if ( res_not_ss__hacky ) {
-		if ( prm_normalisation != 0.0 ) {
-			score = numeric_cast<score_type>( numeric_cast<double>( score ) / prm_normalisation );
-		}
-		else {
-			score = 0;
-		}
-	}
-
-	if ( score == 0 ) {
-		return compare_upper_cell_result::ZERO;
-	}
-	if ( res_not_ss__hacky && score < MIN_LOWER_MAT_RES_SCORE ) {
-		return compare_upper_cell_result::NON_ZERO_BELOW_THRESHOLD;
-	}
-
-	// If yes, trace distance (lower) level alignment path, onto residue (upper) level matrix
-	for (const size_t &alignment_ctr : indices( my_alignment.length() ) ) {
-		if (has_both_positions_of_index(my_alignment, alignment_ctr)) {
-			const aln_posn_type a_dest_to_index__offset_1 = get_a_offset_1_position_of_index( my_alignment, alignment_ctr );
-			const aln_posn_type b_dest_to_index__offset_1 = get_b_offset_1_position_of_index( my_alignment, alignment_ctr );
-			const int           a_matrix_idx__offset_1    = get_window_matrix_a_index__offset_1(length_a, length_b, global_window, a_dest_to_index__offset_1, b_dest_to_index__offset_1);
-			const score_type    score_addend              = prm_entry_querier.distance_score__offset_1(
-				prm_protein_a,                   prm_protein_b,
-				prm_a_view_from_index__offset_1, prm_b_view_from_index__offset_1,
-				a_dest_to_index__offset_1,       b_dest_to_index__offset_1
-			);
-			global_upper_score_matrix.get( b_dest_to_index__offset_1, numeric_cast<size_t>( a_matrix_idx__offset_1 ) ) += score_addend;
-//			cerr << "At\t" << ( prm_a_view_from_index__offset_1 - 1 );
-//			cerr << "\t"   << ( prm_b_view_from_index__offset_1 - 1 );
-//			cerr << "\t"   << ( a_dest_to_index__offset_1       - 1 );
-//			cerr << "\t"   << ( b_dest_to_index__offset_1       - 1 );
-//			cerr << "\tadding score:\t" << score_addend;
-//			cerr << "\tto get:\t" << global_upper_score_matrix[b_dest_to_index__offset_1][ numeric_cast<size_t>( a_matrix_idx__offset_1 ) ];
-//			cerr <<"\t["   << get_plural_name(prm_entry_querier) << "]" << endl;
-		}
-	}
-	return compare_upper_cell_result::SCORED;
+	compare_upper_cell_result result = compare_upper_cell_result::ZERO;
+	dispatch_on_querier_type( prm_entry_querier, [&] (const auto &prm_querier) {
+		result = compare_upper_cell_impl(
+			prm_protein_a,
+			prm_protein_b,
+			prm_a_view_from_index__offset_1,
+			prm_b_view_from_index__offset_1,
+			prm_querier,
+			prm_normalisation
+		);
+	} );
+	return result;
 }
 
 
@@ -1756,6 +2062,40 @@ ssap_scores cath::calculate_log_score(const alignment     &prm_alignment,    ///
 	return local_ssap_scores;
 }
 
+/// \brief Calculate an upper bound on the SSAP score that calculate_log_score() could give
+///        for any alignment of two structures of the specified lengths
+///
+/// Each comparable pair contributes at most the entry_querier's optimum_single_score() to the
+/// final score and, since aligned positions are distinct in both structures, there can be no
+/// more than num_comparable() of the smaller length. So the score normalised over the larger
+/// structure can't exceed \f$ 100 \left( 1 + \log_k{ \frac{ N_{min} }{ N_{max} } } \right) \f$
+/// (see the notes in calculate_log_score()) and the score normalised over the smaller structure
+/// can't exceed 100.
+///
+/// This is cheap enough to call before any of the passes so that a comparison that can't reach
+/// a required score (typically because the lengths are very different) can be abandoned.
+double cath::ssap_score_upper_bound(const size_t        &prm_length_a,              ///< The length of the first structure
+                                    const size_t        &prm_length_b,              ///< The length of the second structure
+                                    const entry_querier &prm_entry_querier,         ///< The entry_querier with which the final score is calculated
+                                    const bool          &prm_normalise_over_smaller ///< Whether the score is normalised over the smaller structure (rather than the larger)
+                                    ) {
+	const double final_score_scaling     = 1000.0;
+	const size_t num_comparable_over_min = num_comparable( prm_entry_querier, min( prm_length_a, prm_length_b ) );
+	const size_t num_comparable_over_max = num_comparable( prm_entry_querier, max( prm_length_a, prm_length_b ) );
+
+	// If nothing's comparable, no score gets set so the zero default is the bound
+	if ( num_comparable_over_min == 0 ) {
+		return 0.0;
+	}
+	if ( prm_normalise_over_smaller ) {
+		return 100.0;
+	}
+
+	const double max_log = std::log( prm_entry_querier.optimum_single_score() * final_score_scaling );
+	const double ratio   = numeric_cast<double>( num_comparable_over_min ) / numeric_cast<double>( num_comparable_over_max );
+	return 100.0 * ( 1.0 + std::log( ratio ) / max_log );
+}
+
 
 /// \brief Calculate the sequence identity from an alignment and the two proteins
 ///
@@ -1799,6 +2139,7 @@ bool cath::save_ssap_scores(const alignment               &prm_alignment,    ///
                             const data_dirs_spec          &prm_data_dirs     ///< The data directories from which data should be read
                             ) {
 	BOOST_LOG_TRIVIAL( debug ) << "Function: save_ssap_scores";
+	const ssap_phase_timer write_timer{ phase_timings_ptr(), ssap_phase::WRITE_SCORES };
 	
 	// Select get_ssap_score_over_smaller if a local score is needed, or get_ssap_score_over_larger otherwise
 	const double select_score = prm_ssap_options.get_use_local_ssap_score() ? prm_ssap_scores.get_ssap_score_over_smaller()
@@ -1841,6 +2182,17 @@ bool cath::save_ssap_scores(const alignment               &prm_alignment,    ///
 			const string temp_prev_global_ssap_line1(global_ssap_line1);
 			snprintf( global_ssap_line1, SSAP_LINE_LENGTH - 1, "%s %4zu", temp_prev_global_ssap_line1.c_str(), num_superposed );
 		}
+		global_ssap_entry1 = ssap_scores_entry{
+			get_domain_or_specified_or_name_from_acq( prm_protein_a ),
+			get_domain_or_specified_or_name_from_acq( prm_protein_b ),
+			prm_protein_a.get_length(),
+			prm_protein_b.get_length(),
+			select_score,
+			prm_ssap_scores.get_num_aligned_pairs(),
+			trunc( prm_ssap_scores.get_percentage_aligned_pairs_over_larger() ),
+			trunc( prm_ssap_scores.get_seq_id() ),
+			rmsd
+		};
 				
 		global_ssap_score1 = select_score;
 	}
@@ -1866,6 +2218,17 @@ bool cath::save_ssap_scores(const alignment               &prm_alignment,    ///
 			const string temp_prev_global_ssap_line2(global_ssap_line2);
 			snprintf( global_ssap_line2, SSAP_LINE_LENGTH - 1, "%s %4zu", temp_prev_global_ssap_line2.c_str(), num_superposed );
 		}
+		global_ssap_entry2 = ssap_scores_entry{
+			get_domain_or_specified_or_name_from_acq( prm_protein_a ),
+			get_domain_or_specified_or_name_from_acq( prm_protein_b ),
+			prm_protein_a.get_length(),
+			prm_protein_b.get_length(),
+			select_score,
+			prm_ssap_scores.get_num_aligned_pairs(),
+			trunc( prm_ssap_scores.get_percentage_aligned_pairs_over_larger() ),
+			trunc( prm_ssap_scores.get_seq_id() ),
+			rmsd
+		};
 
 		global_ssap_score2 = select_score;	
 	}
@@ -1897,6 +2260,18 @@ void cath::save_zero_scores(const protein   &prm_protein_a,  ///< The first prot
 			0.0
 		);
 		
+		global_ssap_entry1 = ssap_scores_entry{
+			get_domain_or_specified_or_name_from_acq( prm_protein_a ),
+			get_domain_or_specified_or_name_from_acq( prm_protein_b ),
+			prm_protein_a.get_length(),
+			prm_protein_b.get_length(),
+			0.0,
+			0,
+			0.0,
+			0.0,
+			0.0
+		};
+
 		global_ssap_score1 = 0.0;
 	}
 	else if ( prm_run_counter == 2 ) {
@@ -1916,6 +2291,18 @@ void cath::save_zero_scores(const protein   &prm_protein_a,  ///< The first prot
 			0.0
 		);
 
+		global_ssap_entry2 = ssap_scores_entry{
+			get_domain_or_specified_or_name_from_acq( prm_protein_a ),
+			get_domain_or_specified_or_name_from_acq( prm_protein_b ),
+			prm_protein_a.get_length(),
+			prm_protein_b.get_length(),
+			0.0,
+			0,
+			0.0,
+			0.0,
+			0.0
+		};
+
 		global_ssap_score2 = 0.0;
 	}
 }
@@ -1962,6 +2349,7 @@ size_doub_pair cath::superpose(const protein                 &prm_protein_a,
                                const data_dirs_spec          &prm_data_dirs,           ///< The data directories from which data should be read
                                const bool                    &prm_score_is_high_enough ///< Whether the score is high enough to justify outputting files
                                ) {
+	const ssap_phase_timer superpose_timer{ phase_timings_ptr(), ssap_phase::SUPERPOSE };
 	const auto common_coords = alignment_coord_extractor::get_common_coords(
 		prm_alignment,
 		prm_protein_a,
@@ -2110,17 +2498,22 @@ ssap_scores cath::plot_aln(const protein                 &prm_protein_a,     ///
 					<< " "
 					<< to_string( prm_protein_b.get_name_set() )
 					;
-				const path alignment_out_file = prm_ssap_options.get_alignment_dir() / (
-					  get_domain_or_specified_or_name_from_acq( prm_protein_a )
-					+ get_domain_or_specified_or_name_from_acq( prm_protein_b )
-					+ ".list"
-				);
-				write_alignment_as_cath_ssap_legacy_format(
-					alignment_out_file,
-					prm_alignment,
-					prm_protein_a,
-					prm_protein_b
-				);
+				if ( global_write_aln_files ) {
+					const path alignment_out_file = prm_ssap_options.get_alignment_dir() / (
+						  get_domain_or_specified_or_name_from_acq( prm_protein_a )
+						+ get_domain_or_specified_or_name_from_acq( prm_protein_b )
+						+ ".list"
+					);
+					write_alignment_as_cath_ssap_legacy_format(
+						alignment_out_file,
+						prm_alignment,
+						prm_protein_a,
+						prm_protein_b
+					);
+				}
+				else {
+					global_output_alignment = prm_alignment;
+				}
 			}
 		}
 	}
@@ -36,11 +36,14 @@
 namespace cath { struct clique;                 }
 namespace cath { class entry_querier;           }
 namespace cath { class protein;                 }
+namespace cath { class protein_comparison_view; }
 namespace cath { class protein_source_file_set; }
 namespace cath { class residue;                 }
 namespace cath { class sec_struc;               }
 namespace cath { class selected_pair;           }
+namespace cath { class ssap_phase_timings;      }
 namespace cath { class ssap_scores;             }
+namespace cath { namespace file { class ssap_scores_entry; } }
 namespace cath { namespace geom { class coord; } }
 namespace cath { namespace opts { class cath_ssap_options; } }
 namespace cath { namespace opts { class data_dirs_spec; } }
@@ -53,6 +56,8 @@ namespace cath {
 
 	ptrdiff_t temp_get_global_run_counter();
 
+	ssap_phase_timings get_ssap_phase_timings_summary();
+
 	prot_prot_pair read_protein_pair(const opts::cath_ssap_options &,
 	                                 std::ostream & = std::cerr);
 
@@ -70,6 +75,11 @@ namespace cath {
 	              std::ostream & = std::cerr,
 	              const ostream_ref_opt & = boost::none);
 
+	std::pair<file::ssap_scores_entry, align::alignment_opt> run_ssap_in_memory(const protein &,
+	                                                                            const protein &,
+	                                                                            const opts::old_ssap_options_block &,
+	                                                                            const opts::data_dirs_spec &);
+
 	void align_proteins(const protein &,
 	                    const protein &,
 	                    const opts::old_ssap_options_block &,
@@ -114,6 +124,11 @@ namespace cath {
 	bool residues_have_similar_area_angle_props(const residue &,
 	                                            const residue &);
 
+	bool residues_have_similar_area_angle_props(const protein_comparison_view &,
+	                                            const size_t &,
+	                                            const protein_comparison_view &,
+	                                            const size_t &);
+
 	void populate_upper_score_matrix(const protein &,
 	                                 const protein &,
 	                                 const entry_querier &,
@@ -139,6 +154,11 @@ namespace cath {
 	                                const protein &,
 	                                const entry_querier &);
 
+	double ssap_score_upper_bound(const size_t &,
+	                              const size_t &,
+	                              const entry_querier &,
+	                              const bool &);
+
 	double calculate_sequence_identity(const align::alignment &,
 	                                   const protein &,
 	                                   const protein &);
@@ -0,0 +1,215 @@
+/// \file
+/// \brief The ssap_phase_timings class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "ssap_phase_timings.hpp"
+
+#include "common/chrono/duration_to_seconds_string.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
+#include "common/rapidjson_addenda/string_of_rapidjson_write.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+using namespace cath;
+using namespace cath::common;
+
+using std::chrono::high_resolution_clock;
+using std::fixed;
+using std::left;
+using std::ostringstream;
+using std::right;
+using std::setprecision;
+using std::setw;
+using std::string;
+
+namespace {
+
+	/// \brief Get the index of the specified phase in the ssap_phase_timings arrays
+	size_t index_of_phase(const ssap_phase &prm_phase ///< The phase whose index should be returned
+	                      ) {
+		return static_cast<size_t>( prm_phase );
+	}
+
+} // namespace
+
+/// \brief Generate a string describing the specified ssap_phase
+///
+/// This is also used as the phase's key in the JSON written by to_json_record_string()
+///
+/// \relates ssap_phase
+string cath::to_string(const ssap_phase &prm_phase ///< The ssap_phase to describe
+                       ) {
+	switch ( prm_phase ) {
+		case ( ssap_phase::WHOLE_COMPARISON            ) : { return "whole_comparison"            ; }
+		case ( ssap_phase::LOAD_STRUCTURES             ) : { return "load_structures"             ; }
+		case ( ssap_phase::SEC_STRUC_PASS              ) : { return "sec_struc_pass"              ; }
+		case ( ssap_phase::SELECT_PAIRS                ) : { return "select_pairs"                ; }
+		case ( ssap_phase::POPULATE_UPPER_SCORE_MATRIX ) : { return "populate_upper_score_matrix" ; }
+		case ( ssap_phase::FINAL_DYN_PROG              ) : { return "final_dyn_prog"              ; }
+		case ( ssap_phase::SUPERPOSE                   ) : { return "superpose"                   ; }
+		case ( ssap_phase::WRITE_SCORES                ) : { return "write_scores"                ; }
+	}
+	BOOST_THROW_EXCEPTION(invalid_argument_exception("Value of ssap_phase not recognised whilst converting to_string()"));
+}
+
+/// \brief Default ctor to zero all the durations and counts
+ssap_phase_timings::ssap_phase_timings() {
+	durations.fill  ( hrc_duration::zero() );
+	num_entries.fill( 0                    );
+}
+
+/// \brief Add the specified duration to the specified phase (and count one more entry into that phase)
+ssap_phase_timings & ssap_phase_timings::add_duration(const ssap_phase   &prm_phase,   ///< The phase to which the duration should be added
+                                                      const hrc_duration &prm_duration ///< The duration to add
+                                                      ) {
+	durations  [ index_of_phase( prm_phase ) ] += prm_duration;
+	num_entries[ index_of_phase( prm_phase ) ] += 1;
+	return *this;
+}
+
+/// \brief Count one more comparison
+ssap_phase_timings & ssap_phase_timings::add_comparison() {
+	++num_comparisons;
+	return *this;
+}
+
+/// \brief Add the specified number of cells to the count of those evaluated in populate_upper_score_matrix()
+ssap_phase_timings & ssap_phase_timings::add_cells_evaluated(const size_t &prm_num_cells ///< The number of cells evaluated
+                                                             ) {
+	num_cells_evaluated += prm_num_cells;
+	return *this;
+}
+
+/// \brief Add the specified number of pairs to the count of those chosen by select_pairs()
+ssap_phase_timings & ssap_phase_timings::add_pairs_selected(const size_t &prm_num_pairs ///< The number of pairs selected
+                                                            ) {
+	num_pairs_selected += prm_num_pairs;
+	return *this;
+}
+
+/// \brief Getter for the total time spent in the specified phase
+const hrc_duration & ssap_phase_timings::get_duration(const ssap_phase &prm_phase ///< The phase to query
+                                                      ) const {
+	return durations[ index_of_phase( prm_phase ) ];
+}
+
+/// \brief Getter for the number of times the specified phase has been entered
+const size_t & ssap_phase_timings::get_num_entries(const ssap_phase &prm_phase ///< The phase to query
+                                                   ) const {
+	return num_entries[ index_of_phase( prm_phase ) ];
+}
+
+/// \brief Getter for the number of comparisons these timings cover
+const size_t & ssap_phase_timings::get_num_comparisons() const {
+	return num_comparisons;
+}
+
+/// \brief Getter for the number of cells whose environments have been compared in populate_upper_score_matrix()
+const size_t & ssap_phase_timings::get_num_cells_evaluated() const {
+	return num_cells_evaluated;
+}
+
+/// \brief Getter for the number of pairs of entries chosen by select_pairs()
+const size_t & ssap_phase_timings::get_num_pairs_selected() const {
+	return num_pairs_selected;
+}
+
+/// \brief Add the durations and counts of another ssap_phase_timings into this one
+ssap_phase_timings & ssap_phase_timings::operator+=(const ssap_phase_timings &prm_other ///< The ssap_phase_timings to add into this one
+                                                    ) {
+	for (const ssap_phase &phase : detail::all_ssap_phases) {
+		durations  [ index_of_phase( phase ) ] += prm_other.get_duration   ( phase );
+		num_entries[ index_of_phase( phase ) ] += prm_other.get_num_entries( phase );
+	}
+	num_comparisons     += prm_other.get_num_comparisons();
+	num_cells_evaluated += prm_other.get_num_cells_evaluated();
+	num_pairs_selected  += prm_other.get_num_pairs_selected();
+	return *this;
+}
+
+/// \brief Generate a single line of compact JSON recording the specified timings for a comparison of the two named structures
+///
+/// \relates ssap_phase_timings
+string cath::to_json_record_string(const ssap_phase_timings &prm_timings, ///< The timings to record
+                                   const string             &prm_name_a,  ///< The name of the first structure
+                                   const string             &prm_name_b   ///< The name of the second structure
+                                   ) {
+	return string_of_rapidjson_write<json_style::COMPACT>(
+		[&] (rapidjson_writer<json_style::COMPACT> &x) {
+			x.start_object();
+			x.write_key( "name_a"          ).write_value( prm_name_a                           );
+			x.write_key( "name_b"          ).write_value( prm_name_b                           );
+			x.write_key( "cells_evaluated" ).write_value( prm_timings.get_num_cells_evaluated() );
+			x.write_key( "pairs_selected"  ).write_value( prm_timings.get_num_pairs_selected()  );
+			x.write_key( "phases"          );
+			x.start_object();
+			for (const ssap_phase &phase : detail::all_ssap_phases) {
+				x.write_key( to_string( phase ) );
+				x.start_object();
+				x.write_key( "seconds" ).write_value( durn_to_seconds_double( prm_timings.get_duration( phase ) ) );
+				x.write_key( "entries" ).write_value( prm_timings.get_num_entries( phase )                        );
+				x.end_object();
+			}
+			x.end_object();
+			x.end_object();
+		}
+	);
+}
+
+/// \brief Generate a human-readable, multi-line summary of the specified timings
+///
+/// \relates ssap_phase_timings
+string cath::to_summary_string(const ssap_phase_timings &prm_timings ///< The timings to summarise
+                               ) {
+	const size_t &num_comparisons = prm_timings.get_num_comparisons();
+
+	ostringstream summary_ss;
+	summary_ss << "SSAP phase timings over "
+	           << num_comparisons
+	           << " comparison(s) (each phase's times include those of any phases nested within it)\n";
+	for (const ssap_phase &phase : detail::all_ssap_phases) {
+		const double total_seconds = durn_to_seconds_double( prm_timings.get_duration( phase ) );
+		summary_ss << "  "
+		           << left  << setw( 28 ) << to_string( phase )
+		           << right << fixed << setprecision( 6 )
+		           << " total "                << setw( 12 ) << total_seconds                        << "s"
+		           << ", mean per comparison " << setw( 12 ) << ( num_comparisons > 0 ? total_seconds / static_cast<double>( num_comparisons ) : 0.0 ) << "s"
+		           << ", entries "             << prm_timings.get_num_entries( phase )
+		           << "\n";
+	}
+	summary_ss << "  cells evaluated : " << prm_timings.get_num_cells_evaluated() << "\n";
+	summary_ss << "  pairs selected  : " << prm_timings.get_num_pairs_selected();
+	return summary_ss.str();
+}
+
+/// \brief Ctor that starts timing the specified phase (unless the pointer is null)
+ssap_phase_timer::ssap_phase_timer(ssap_phase_timings * const  prm_timings_ptr, ///< A pointer to the ssap_phase_timings to which the time should be added (or nullptr to do nothing)
+                                   const ssap_phase           &prm_phase        ///< The phase to time
+                                   ) : timings_ptr( prm_timings_ptr                                                  ),
+                                       phase      ( prm_phase                                                        ),
+                                       start_time ( ( timings_ptr != nullptr ) ? high_resolution_clock::now() : hrc_time_point{} ) {
+}
+
+/// \brief Dtor that adds the time since construction to the phase (unless the pointer is null)
+ssap_phase_timer::~ssap_phase_timer() noexcept {
+	if ( timings_ptr != nullptr ) {
+		timings_ptr->add_duration( phase, high_resolution_clock::now() - start_time );
+	}
+}
@@ -0,0 +1,142 @@
+/// \file
+/// \brief The ssap_phase_timings class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_UNI_SSAP_SSAP_PHASE_TIMINGS_HPP
+#define _CATH_TOOLS_SOURCE_UNI_SSAP_SSAP_PHASE_TIMINGS_HPP
+
+#include "common/algorithm/constexpr_is_uniq.hpp"
+#include "common/chrono/chrono_type_aliases.hpp"
+#include "common/cpp20/make_array.hpp"
+
+#include <array>
+#include <string>
+
+namespace cath {
+
+	/// \brief The phases of a SSAP comparison that can be timed with an ssap_phase_timings
+	///
+	/// Some of these phases nest within others (eg SELECT_PAIRS occurs within SEC_STRUC_PASS
+	/// and everything occurs within WHOLE_COMPARISON) and the times are inclusive of any nested
+	/// phases, so they shouldn't be summed.
+	enum class ssap_phase : unsigned int {
+		WHOLE_COMPARISON,            ///< The whole comparison (excluding loading the structures)
+		LOAD_STRUCTURES,             ///< Reading the structures from their data files
+		SEC_STRUC_PASS,              ///< The secondary structure comparison at the start of a fast SSAP
+		SELECT_PAIRS,                ///< Selecting the pairs of entries to compare (select_pairs())
+		POPULATE_UPPER_SCORE_MATRIX, ///< Comparing the selected pairs' environments (populate_upper_score_matrix())
+		FINAL_DYN_PROG,              ///< Aligning the populated upper score matrix with dynamic-programming
+		SUPERPOSE,                   ///< Superposing the structures using the alignment (superpose())
+		WRITE_SCORES                 ///< Saving and printing the scores (including any alignment/superposition files)
+	};
+
+	namespace detail {
+
+		/// \brief All the ssap_phase values
+		static constexpr auto all_ssap_phases = common::make_array(
+			ssap_phase::WHOLE_COMPARISON,
+			ssap_phase::LOAD_STRUCTURES,
+			ssap_phase::SEC_STRUC_PASS,
+			ssap_phase::SELECT_PAIRS,
+			ssap_phase::POPULATE_UPPER_SCORE_MATRIX,
+			ssap_phase::FINAL_DYN_PROG,
+			ssap_phase::SUPERPOSE,
+			ssap_phase::WRITE_SCORES
+		);
+
+		static_assert( common::constexpr_is_uniq( all_ssap_phases ), "all_ssap_phases shouldn't contain repeated values" );
+
+	} // namespace detail
+
+	/// \brief The number of ssap_phase values
+	static constexpr size_t NUM_SSAP_PHASES = std::tuple_size< decltype( detail::all_ssap_phases ) >::value;
+
+	std::string to_string(const ssap_phase &);
+
+	/// \brief Accumulate the time spent in each ssap_phase, along with a few counters of the work done,
+	///        over one or more SSAP comparisons
+	class ssap_phase_timings final {
+	private:
+		/// \brief The total time spent in each phase
+		std::array<hrc_duration, NUM_SSAP_PHASES> durations;
+
+		/// \brief The number of times each phase has been entered
+		std::array<size_t,       NUM_SSAP_PHASES> num_entries;
+
+		/// \brief The number of comparisons these timings cover
+		size_t num_comparisons      = 0;
+
+		/// \brief The number of cells whose environments have been compared in populate_upper_score_matrix()
+		size_t num_cells_evaluated  = 0;
+
+		/// \brief The number of pairs of entries chosen by select_pairs()
+		size_t num_pairs_selected   = 0;
+
+	public:
+		ssap_phase_timings();
+
+		ssap_phase_timings & add_duration(const ssap_phase &,
+		                                  const hrc_duration &);
+		ssap_phase_timings & add_comparison();
+		ssap_phase_timings & add_cells_evaluated(const size_t &);
+		ssap_phase_timings & add_pairs_selected(const size_t &);
+
+		const hrc_duration & get_duration(const ssap_phase &) const;
+		const size_t & get_num_entries(const ssap_phase &) const;
+		const size_t & get_num_comparisons() const;
+		const size_t & get_num_cells_evaluated() const;
+		const size_t & get_num_pairs_selected() const;
+
+		ssap_phase_timings & operator+=(const ssap_phase_timings &);
+	};
+
+	std::string to_json_record_string(const ssap_phase_timings &,
+	                                  const std::string &,
+	                                  const std::string &);
+
+	std::string to_summary_string(const ssap_phase_timings &);
+
+	/// \brief Add the time spent in a scope to a phase of an ssap_phase_timings
+	///
+	/// If constructed with a null pointer, this does nothing (not even reading the clock) so that
+	/// the instrumentation costs almost nothing when timings haven't been requested.
+	class ssap_phase_timer final {
+	private:
+		/// \brief A pointer to the ssap_phase_timings to which the time should be added (or nullptr to do nothing)
+		ssap_phase_timings * timings_ptr;
+
+		/// \brief The phase being timed
+		ssap_phase           phase;
+
+		/// \brief The time at which the scope was entered
+		hrc_time_point       start_time;
+
+	public:
+		ssap_phase_timer(ssap_phase_timings * const,
+		                 const ssap_phase &);
+		ssap_phase_timer(const ssap_phase_timer &) = delete;
+		ssap_phase_timer(ssap_phase_timer &&) = delete;
+		ssap_phase_timer & operator=(const ssap_phase_timer &) = delete;
+		ssap_phase_timer & operator=(ssap_phase_timer &&) = delete;
+		~ssap_phase_timer() noexcept;
+	};
+
+} // namespace cath
+
+#endif
@@ -0,0 +1,74 @@
+/// \file
+/// \brief The ssap_phase_timings test suite
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <boost/test/unit_test.hpp>
+
+#include "ssap/ssap_phase_timings.hpp"
+
+using namespace cath;
+
+using std::chrono::milliseconds;
+
+BOOST_AUTO_TEST_SUITE(ssap_phase_timings_test_suite)
+
+BOOST_AUTO_TEST_CASE(durations_and_counts_accumulate) {
+	ssap_phase_timings the_timings;
+	BOOST_CHECK( the_timings.get_duration   ( ssap_phase::SELECT_PAIRS ) == hrc_duration::zero() );
+	BOOST_CHECK_EQUAL( the_timings.get_num_entries( ssap_phase::SELECT_PAIRS ), 0 );
+
+	the_timings.add_duration( ssap_phase::SELECT_PAIRS, milliseconds( 3 ) )
+		.add_duration( ssap_phase::SELECT_PAIRS, milliseconds( 4 ) )
+		.add_cells_evaluated( 10 )
+		.add_pairs_selected( 5 )
+		.add_comparison();
+	BOOST_CHECK( the_timings.get_duration   ( ssap_phase::SELECT_PAIRS ) == milliseconds( 7 ) );
+	BOOST_CHECK( the_timings.get_duration   ( ssap_phase::SUPERPOSE    ) == hrc_duration::zero() );
+	BOOST_CHECK_EQUAL( the_timings.get_num_entries    ( ssap_phase::SELECT_PAIRS ), 2 );
+	BOOST_CHECK_EQUAL( the_timings.get_num_comparisons    (), 1 );
+	BOOST_CHECK_EQUAL( the_timings.get_num_cells_evaluated(), 10 );
+	BOOST_CHECK_EQUAL( the_timings.get_num_pairs_selected (), 5 );
+
+	ssap_phase_timings the_summary;
+	the_summary += the_timings;
+	the_summary += the_timings;
+	BOOST_CHECK( the_summary.get_duration( ssap_phase::SELECT_PAIRS ) == milliseconds( 14 ) );
+	BOOST_CHECK_EQUAL( the_summary.get_num_comparisons    (), 2 );
+	BOOST_CHECK_EQUAL( the_summary.get_num_cells_evaluated(), 20 );
+}
+
+BOOST_AUTO_TEST_CASE(timer_only_records_if_given_timings) {
+	ssap_phase_timings the_timings;
+	{
+		const ssap_phase_timer null_timer{ nullptr,      ssap_phase::SUPERPOSE };
+		const ssap_phase_timer real_timer{ &the_timings, ssap_phase::FINAL_DYN_PROG };
+	}
+	BOOST_CHECK_EQUAL( the_timings.get_num_entries( ssap_phase::SUPERPOSE      ), 0 );
+	BOOST_CHECK_EQUAL( the_timings.get_num_entries( ssap_phase::FINAL_DYN_PROG ), 1 );
+}
+
+BOOST_AUTO_TEST_CASE(json_record_is_a_single_line_with_each_phase) {
+	const auto json_record = to_json_record_string( ssap_phase_timings{}.add_cells_evaluated( 3 ), "1a04A02", "1fseB00" );
+	BOOST_CHECK_EQUAL( json_record.find( '\n' ), std::string::npos );
+	BOOST_CHECK_NE   ( json_record.find( R"("name_a":"1a04A02")"  ), std::string::npos );
+	BOOST_CHECK_NE   ( json_record.find( R"("cells_evaluated":3)" ), std::string::npos );
+	BOOST_CHECK_NE   ( json_record.find( R"("populate_upper_score_matrix":{"seconds":0.0,"entries":0})" ), std::string::npos );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,17 +21,28 @@
 #include <boost/test/unit_test.hpp>
 
 #include <boost/optional.hpp> // ***** TEMPORARY *****
+#include <boost/optional/optional_io.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/range/irange.hpp>
 
+#include "alignment/alignment.hpp"
+#include "alignment/io/alignment_io.hpp"
 #include "chopping/domain/domain.hpp"
 #include "chopping/region/region.hpp"
 #include "common/boost_addenda/log/stringstream_log_sink.hpp"
 #include "common/boost_addenda/range/indices.hpp"
+#include "common/file/read_string_from_file.hpp"
 #include "common/file/simple_file_read_write.hpp"
 #include "common/size_t_literal.hpp"
 #include "common/type_aliases.hpp"
 #include "file/options/data_dirs_options_block.hpp"
+#include "file/ssap_scores_file/ssap_scores_entry.hpp"
+#include "ssap/context_res.hpp"
+#include "ssap/options/old_ssap_options_block.hpp"
 #include "ssap/ssap.hpp"
+#include "structure/entry_querier/residue_querier.hpp"
 #include "structure/protein/protein.hpp"
+#include "structure/protein/protein_comparison_view.hpp"
 #include "structure/protein/protein_source_file_set/protein_from_wolf_and_sec.hpp"
 #include "structure/protein/residue.hpp"
 #include "structure/protein/sec_struc.hpp"
@@ -40,10 +51,14 @@
 #include "test/global_test_constants.hpp"
 
 using namespace cath;
+using namespace cath::align;
 using namespace cath::common;
+using namespace cath::file;
 using namespace cath::opts;
 using namespace std;
 
+using boost::algorithm::trim_copy;
+using boost::filesystem::path;
 using boost::none;
 
 namespace cath {
@@ -101,6 +116,12 @@ namespace cath {
 			void check_context_sec_scores_as_expected() const;
 
 			void check_residues_have_similar_area_angle_props() const;
+
+			void check_views_give_same_results_as_residues() const;
+
+			void check_ssap_results_match_recorded() const;
+
+			void check_pruning_only_skips_comparisons_below_bound() const;
 		};
 
 	}  // namespace test
@@ -175,6 +196,83 @@ void cath::test::ssap_pair_fixture<ID1, ID2>::check_residues_have_similar_area_a
 	BOOST_CHECK_EQUAL_RANGES( expected_residues_similar, got_residues_similar );
 }
 
+/// \brief Check that the residue-comparing functions give the same results when reading from
+///        protein_comparison_views as when reading from the residues
+template < const string * const ID1, const string * const ID2 >
+void cath::test::ssap_pair_fixture<ID1, ID2>::check_views_give_same_results_as_residues() const {
+	const protein_comparison_view view1{ prot1 };
+	const protein_comparison_view view2{ prot2 };
+	BOOST_REQUIRE_EQUAL( view1.get_length(), prot1.get_length() );
+	BOOST_REQUIRE_EQUAL( view2.get_length(), prot2.get_length() );
+	BOOST_CHECK        (   view1.is_view_of( prot1 ) );
+	BOOST_CHECK        ( ! view1.is_view_of( prot2 ) );
+
+	for (const size_t &residue_ctr_1 : indices( prot1.get_length() ) ) {
+		for (const size_t &residue_ctr_2 : indices( prot2.get_length() ) ) {
+			BOOST_CHECK_EQUAL(
+				residues_have_similar_area_angle_props( view1, residue_ctr_1, view2, residue_ctr_2 ),
+				residues_have_similar_area_angle_props(
+					prot1.get_residue_ref_of_index( residue_ctr_1 ),
+					prot2.get_residue_ref_of_index( residue_ctr_2 )
+				)
+			);
+		}
+	}
+
+	// Use a stride on the residues to keep the number of (from, to) pair-of-pairs manageable
+	constexpr size_t stride = 7;
+	for (const size_t &from_ctr_1 : boost::irange( 0_z, prot1.get_length(), stride ) ) {
+		for (const size_t &from_ctr_2 : boost::irange( 0_z, prot2.get_length(), stride ) ) {
+			for (const size_t &to_ctr_1 : boost::irange( 0_z, prot1.get_length(), stride ) ) {
+				for (const size_t &to_ctr_2 : boost::irange( 0_z, prot2.get_length(), stride ) ) {
+					BOOST_CHECK_EQUAL(
+						context_res<true>( view1, view2, from_ctr_1, from_ctr_2, to_ctr_1, to_ctr_2 ),
+						context_res<true>(
+							prot1.get_residue_ref_of_index( from_ctr_1 ),
+							prot2.get_residue_ref_of_index( from_ctr_2 ),
+							prot1.get_residue_ref_of_index( to_ctr_1   ),
+							prot2.get_residue_ref_of_index( to_ctr_2   )
+						)
+					);
+				}
+			}
+		}
+	}
+}
+
+/// \brief Check that running SSAP in memory gives the scores and alignment recorded (by the previous
+///        implementation of the SSAP passes) in the regression data directory
+template < const string * const ID1, const string * const ID2 >
+void cath::test::ssap_pair_fixture<ID1, ID2>::check_ssap_results_match_recorded() const {
+	const path expected_scores_file    = TEST_SSAP_REGRESSION_DATA_DIR() / ( id1 + id2 + ".ssap_output" );
+	const path expected_alignment_file = TEST_SSAP_REGRESSION_DATA_DIR() / ( id1 + id2 + ".list"        );
+
+	const auto result = run_ssap_in_memory( prot1, prot2, old_ssap_options_block{}, data_dirs );
+
+	BOOST_CHECK_EQUAL( to_ssap_scores_line( result.first ), trim_copy( read_string_from_file( expected_scores_file ) ) );
+	BOOST_REQUIRE( result.second );
+	BOOST_CHECK_EQUAL( *result.second, read_alignment_from_cath_ssap_legacy_format( expected_alignment_file, prot1, prot2 ) );
+}
+
+/// \brief Check that a prune-below score under the length-derived bound leaves the results unchanged
+///        and that one above the bound abandons the comparison
+template < const string * const ID1, const string * const ID2 >
+void cath::test::ssap_pair_fixture<ID1, ID2>::check_pruning_only_skips_comparisons_below_bound() const {
+	const double score_bound = ssap_score_upper_bound( prot1.get_length(), prot2.get_length(), residue_querier(), false );
+	old_ssap_options_block ssap_options;
+	const auto unpruned_result = run_ssap_in_memory( prot1, prot2, ssap_options, data_dirs );
+
+	ssap_options.set_prune_below_score( score_bound - 1.0 );
+	const auto loose_result = run_ssap_in_memory( prot1, prot2, ssap_options, data_dirs );
+	BOOST_CHECK_EQUAL( loose_result.first,  unpruned_result.first  );
+	BOOST_CHECK      ( loose_result.second == unpruned_result.second );
+
+	ssap_options.set_prune_below_score( score_bound + 1.0 );
+	const auto pruned_result = run_ssap_in_memory( prot1, prot2, ssap_options, data_dirs );
+	BOOST_CHECK      ( pruned_result.first != unpruned_result.first );
+	BOOST_CHECK      ( ! pruned_result.second                      );
+}
+
 /// \todo Should add further regression tests (not least for context_res() )
 //
 //int context_res(const residue &,
@@ -242,5 +340,38 @@ BOOST_FIXTURE_TEST_CASE(residues_have_similar_area_angle_props_1a04A02_1fseB00,
 	check_residues_have_similar_area_angle_props();
 }
 
+/// \brief Check that the 1a04A02/1fseB00 comparisons give the same results via protein_comparison_views
+BOOST_FIXTURE_TEST_CASE(views_give_same_results_as_residues_1a04A02_1fseB00, fixture_1a04A02_1fseB00) {
+	check_views_give_same_results_as_residues();
+}
+
+/// \brief Check that the 1a04A02/1fseB00 SSAP gives the recorded scores and alignment
+BOOST_FIXTURE_TEST_CASE(ssap_results_match_recorded_1a04A02_1fseB00, fixture_1a04A02_1fseB00) {
+	check_ssap_results_match_recorded();
+}
+
+/// \brief Check that the length-derived SSAP score bound is 100 for equal lengths or when normalising over the smaller structure
+BOOST_AUTO_TEST_CASE(ssap_score_upper_bound_is_100_for_equal_lengths_or_local_score) {
+	BOOST_CHECK_EQUAL( ssap_score_upper_bound(  80,  80, residue_querier(), false ), 100.0 );
+	BOOST_CHECK_EQUAL( ssap_score_upper_bound(  70, 300, residue_querier(), true  ), 100.0 );
+}
+
+/// \brief Check that the length-derived SSAP score bound decreases as the lengths diverge and is zero if nothing is comparable
+BOOST_AUTO_TEST_CASE(ssap_score_upper_bound_decreases_with_length_difference) {
+	BOOST_CHECK_LT   ( ssap_score_upper_bound(  70,  80, residue_querier(), false ), 100.0                                              );
+	BOOST_CHECK_LT   ( ssap_score_upper_bound(  70, 300, residue_querier(), false ), ssap_score_upper_bound( 70, 80, residue_querier(), false ) );
+	BOOST_CHECK_EQUAL( ssap_score_upper_bound(   3, 300, residue_querier(), false ),   0.0                                              );
+}
+
+/// \brief Check that the 1a04A02/1fseB00 length-derived bound is above its real SSAP score (87.49)
+BOOST_FIXTURE_TEST_CASE(ssap_score_upper_bound_exceeds_real_score_1a04A02_1fseB00, fixture_1a04A02_1fseB00) {
+	BOOST_CHECK_GT( ssap_score_upper_bound( prot1.get_length(), prot2.get_length(), residue_querier(), false ), 87.49 );
+}
+
+/// \brief Check that the 1a04A02/1fseB00 SSAP is only pruned if the prune-below score exceeds the length-derived bound
+BOOST_FIXTURE_TEST_CASE(pruning_only_skips_comparisons_below_bound_1a04A02_1fseB00, fixture_1a04A02_1fseB00) {
+	check_pruning_only_skips_comparisons_below_bound();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
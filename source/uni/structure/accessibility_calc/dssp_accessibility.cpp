@@ -25,8 +25,10 @@
 #include <boost/range/irange.hpp>
 #include <boost/range/numeric.hpp>
 
+#include "common/algorithm/parallel_for_blocks.hpp"
 #include "common/algorithm/transform_build.hpp"
 #include "common/boost_addenda/range/accumulate_proj.hpp"
+#include "common/boost_addenda/range/indices.hpp"
 #include "common/debug_numeric_cast.hpp"
 #include "common/size_t_literal.hpp"
 #include "file/pdb/pdb.hpp"
@@ -233,11 +235,29 @@ static vector<simple_locn_index> make_all_atom_entries(const pdb &prm_pdb ///< T
 	return results;
 }
 
-/// \brief Build a lattice of the specified PDB's atoms using the specified cell size and maximum distance
+/// \brief Make a vector of simple_locn_index values for all the atoms in the specified PDB, with each index
+///        holding the atom's position in the PDB's atoms (rather than its coarse_element_type)
+static vector<simple_locn_index> make_all_atom_entries_with_atom_indices(const pdb &prm_pdb ///< The PDB to query
+                                                                         ) {
+	vector<simple_locn_index> results;
+	for (const pdb_residue &the_residue : prm_pdb) {
+		for (const pdb_atom &the_atom : the_residue) {
+			results.push_back(
+				make_simple_locn_index(
+					the_atom.get_coord(),
+					debug_numeric_cast<unsigned int>( results.size() )
+				)
+			);
+		}
+	}
+	return results;
+}
+
+/// \brief Build a lattice of the specified atom entries using the specified cell size and maximum distance
 template <sod Sod>
-static auto make_access_atom_lattice(const pdb   &prm_pdb,       ///< The PDB for which the atom should be indexed
-                                     const float &prm_cell_size, ///< The cell size of the lattice
-                                     const float &prm_max_dist   ///< The maximum distance between points that lattic should be used to find
+static auto make_access_atom_lattice(const vector<simple_locn_index> &prm_all_atom_entries, ///< The atom entries to be indexed
+                                     const float                     &prm_cell_size,        ///< The cell size of the lattice
+                                     const float                     &prm_max_dist          ///< The maximum distance between points that lattic should be used to find
                                      ) {
 	const auto keyer = make_res_pair_keyer(
 		simple_locn_x_keyer_part{ prm_cell_size },
@@ -245,12 +265,10 @@ static auto make_access_atom_lattice(const pdb   &prm_pdb,       ///< The PDB fo
 		simple_locn_z_keyer_part{ prm_cell_size }
 	);
 
-	const auto all_atom_entries = make_all_atom_entries( prm_pdb );
-
 	using cell_type  = vector< simple_locn_index >;
 	using store_type = scan_index_lattice_store<decltype( keyer )::key_index_tuple_type, cell_type>;
-	auto the_store = empty_store_maker<sod::SPARSE, store_type>{}( all_atom_entries, keyer, simple_locn_crit{ prm_max_dist * prm_max_dist } );
-	for (const auto &data : all_atom_entries) {
+	auto the_store = empty_store_maker<sod::SPARSE, store_type>{}( prm_all_atom_entries, keyer, simple_locn_crit{ prm_max_dist * prm_max_dist } );
+	for (const auto &data : prm_all_atom_entries) {
 		the_store.push_back_entry_to_cell(
 			keyer.make_key( data ),
 			data
@@ -269,7 +287,7 @@ doub_vec cath::sec::calc_accessibilities_with_scanning(const pdb &prm_pdb ///< T
 		return {};
 	}
 
-	const auto the_store = make_access_atom_lattice<sod::SPARSE>( prm_pdb, CELL_SIZE, MAX_DIST );
+	const auto the_store = make_access_atom_lattice<sod::SPARSE>( make_all_atom_entries( prm_pdb ), CELL_SIZE, MAX_DIST );
 
 	const auto keyer = make_res_pair_keyer(
 		simple_locn_x_keyer_part{ CELL_SIZE },
@@ -337,4 +355,185 @@ doub_vec cath::sec::calc_accessibilities_with_scanning(const pdb &prm_pdb ///< T
 			);
 		}
 	);
-}
\ No newline at end of file
+}
+namespace {
+
+	/// \brief Structure-of-arrays store of the neighbours of an atom that may occlude its ball points
+	///
+	/// The coordinates are the (float-precision) lattice coordinates so that the results match
+	/// calc_accessibilities_with_scanning() exactly.
+	struct access_neighbour_list final {
+		/// \brief The x coordinates of the neighbours
+		doub_vec xs;
+
+		/// \brief The y coordinates of the neighbours
+		doub_vec ys;
+
+		/// \brief The z coordinates of the neighbours
+		doub_vec zs;
+
+		/// \brief The squared radii (with water) of the neighbours
+		doub_vec radii_sq;
+
+		/// \brief Remove all neighbours (whilst keeping the memory for reuse)
+		void clear() {
+			xs.clear();
+			ys.clear();
+			zs.clear();
+			radii_sq.clear();
+		}
+	};
+
+	/// \brief Mark the ball points that are occluded by any of the specified neighbours
+	///
+	/// The inner loop is a branch-free squared-distance test over contiguous arrays so that
+	/// the compiler can vectorise it
+	void mark_occluded_ball_points(const doub_vec              &prm_ball_xs,    ///< The x coordinates of the ball points
+	                               const doub_vec              &prm_ball_ys,    ///< The y coordinates of the ball points
+	                               const doub_vec              &prm_ball_zs,    ///< The z coordinates of the ball points
+	                               const access_neighbour_list &prm_neighbours, ///< The neighbours that may occlude the ball points
+	                               vector<unsigned char>       &prm_occluded    ///< The flags of which ball points are occluded, to be updated
+	                               ) {
+		const size_t num_ball_points = prm_ball_xs.size();
+		const double * const ball_xs  = prm_ball_xs.data();
+		const double * const ball_ys  = prm_ball_ys.data();
+		const double * const ball_zs  = prm_ball_zs.data();
+		unsigned char * const occluded = prm_occluded.data();
+		for (const size_t &neighbour_ctr : indices( prm_neighbours.xs.size() ) ) {
+			const double that_x         = prm_neighbours.xs      [ neighbour_ctr ];
+			const double that_y         = prm_neighbours.ys      [ neighbour_ctr ];
+			const double that_z         = prm_neighbours.zs      [ neighbour_ctr ];
+			const double that_radius_sq = prm_neighbours.radii_sq[ neighbour_ctr ];
+			for (size_t point_ctr = 0; point_ctr < num_ball_points; ++point_ctr) {
+				const double dist_x = that_x - ball_xs[ point_ctr ];
+				const double dist_y = that_y - ball_ys[ point_ctr ];
+				const double dist_z = that_z - ball_zs[ point_ctr ];
+				occluded[ point_ctr ] |= static_cast<unsigned char>( dist_x * dist_x + dist_y * dist_y + dist_z * dist_z < that_radius_sq );
+			}
+		}
+	}
+
+} // namespace
+
+/// \brief Calculate the accessibilities using per-atom neighbour lists, a vectorisable occlusion kernel
+///        and (optionally) multiple threads
+///
+/// This gives exactly the same results as calc_accessibilities_with_scanning() but rather than
+/// re-testing each ball point against neighbours found during the lattice scan, it first gathers each
+/// atom's occluding neighbours into a compact structure-of-arrays list and then tests all the ball points
+/// against each neighbour in a tight loop. The atoms are split into contiguous blocks, which are
+/// processed concurrently if more than one thread is requested and there are enough atoms.
+doub_vec cath::sec::calc_accessibilities_with_neighbour_lists(const pdb    &prm_pdb,                 ///< The PDB to query
+                                                              const size_t &prm_num_threads,         ///< The number of threads to use (or 0 to use the hardware concurrency)
+                                                              const size_t &prm_min_atoms_per_thread ///< The minimum number of atoms to give each thread (tip: you should probably just use the default value)
+                                                              ) {
+	constexpr float MAX_DIST  = static_cast<float>( dssp_ball_constants::MAX_ATOM_DIST ); // 6.54
+	constexpr float CELL_SIZE = 13.0;
+
+	if ( prm_pdb.empty() ) {
+		return {};
+	}
+
+	// Gather each atom's lattice entry, coordinates, radius (with water), element type and residue index
+	const auto                  all_atom_entries = make_all_atom_entries_with_atom_indices( prm_pdb );
+	const size_t                num_atoms        = all_atom_entries.size();
+	coord_vec                   atom_coords;
+	doub_vec                    atom_radii;
+	vector<coarse_element_type> atom_element_types;
+	size_vec                    atom_residue_indices;
+	atom_coords.reserve         ( num_atoms );
+	atom_radii.reserve          ( num_atoms );
+	atom_element_types.reserve  ( num_atoms );
+	atom_residue_indices.reserve( num_atoms );
+	size_t residue_ctr = 0;
+	for (const pdb_residue &the_residue : prm_pdb) {
+		for (const pdb_atom &the_atom : the_residue) {
+			atom_coords.push_back         ( the_atom.get_coord()                          );
+			atom_radii.push_back          ( get_dssp_access_radius_with_water( the_atom ) );
+			atom_element_types.push_back  ( get_coarse_element_type          ( the_atom ) );
+			atom_residue_indices.push_back( residue_ctr                                   );
+		}
+		++residue_ctr;
+	}
+
+	const auto the_store = make_access_atom_lattice<sod::SPARSE>( all_atom_entries, CELL_SIZE, MAX_DIST );
+	const auto keyer = make_res_pair_keyer(
+		simple_locn_x_keyer_part{ CELL_SIZE },
+		simple_locn_y_keyer_part{ CELL_SIZE },
+		simple_locn_z_keyer_part{ CELL_SIZE }
+	);
+	const coord_vec dssp_ball_points = make_dssp_ball_points();
+	const size_t    num_ball_points  = dssp_ball_points.size();
+
+	// Calculate the accessible surface-areas of the atoms in [prm_begin, prm_end) into atom_areas
+	doub_vec atom_areas( num_atoms, 0.0 );
+	const auto calc_atom_areas_fn = [&] (const size_t &prm_begin, const size_t &prm_end) {
+		access_neighbour_list neighbours;
+		doub_vec              ball_xs ( num_ball_points );
+		doub_vec              ball_ys ( num_ball_points );
+		doub_vec              ball_zs ( num_ball_points );
+		vector<unsigned char> occluded( num_ball_points );
+
+		for (const size_t &atom_ctr : irange( prm_begin, prm_end ) ) {
+			const coord             &this_coord  = atom_coords[ atom_ctr ];
+			const double            &this_radius = atom_radii [ atom_ctr ];
+			const simple_locn_index  data        = make_simple_locn_index(
+				this_coord,
+				static_cast<unsigned int>( atom_element_types[ atom_ctr ] )
+			);
+
+			// Build the list of neighbours close enough to occlude any of this atom's ball points
+			neighbours.clear();
+			for (const auto &key : common::cross( keyer.make_close_keys( data, simple_locn_crit{ MAX_DIST * MAX_DIST } ) ) ) {
+				if ( the_store.has_matches( key ) ) {
+					for (const simple_locn_index &that_entry : the_store.find_matches( key ) ) {
+						const auto eg = make_simple_locn_index(
+							get_coord( that_entry ),
+							static_cast<unsigned int>( atom_element_types[ that_entry.index ] )
+						);
+						if ( data == eg ) {
+							continue;
+						}
+						const double that_radius     = atom_radii[ that_entry.index ];
+						const double total_radius    = this_radius + that_radius;
+						const double total_radius_sq = total_radius * total_radius;
+						if ( are_within_distance_doub( data, eg, total_radius, total_radius_sq ) ) {
+							const coord that_point = get_coord( eg );
+							neighbours.xs.push_back      ( that_point.get_x()        );
+							neighbours.ys.push_back      ( that_point.get_y()        );
+							neighbours.zs.push_back      ( that_point.get_z()        );
+							neighbours.radii_sq.push_back( that_radius * that_radius );
+						}
+					}
+				}
+			}
+
+			// Test this atom's ball points against the neighbours
+			for (const size_t &point_ctr : indices( num_ball_points ) ) {
+				const coord ball_point = this_coord + ( this_radius * dssp_ball_points[ point_ctr ] );
+				ball_xs [ point_ctr ] = ball_point.get_x();
+				ball_ys [ point_ctr ] = ball_point.get_y();
+				ball_zs [ point_ctr ] = ball_point.get_z();
+				occluded[ point_ctr ] = 0;
+			}
+			mark_occluded_ball_points( ball_xs, ball_ys, ball_zs, neighbours, occluded );
+
+			const size_t num_occluded        = numeric_cast<size_t>( count( occluded, static_cast<unsigned char>( 1 ) ) );
+			const double sphere_surface_area = 4.0 * pi<double>() * this_radius * this_radius;
+			atom_areas[ atom_ctr ] =
+				  sphere_surface_area
+				* ( numeric_cast<double>( num_ball_points ) - numeric_cast<double>( num_occluded ) )
+				/ numeric_cast<double>( num_ball_points );
+		}
+	};
+
+	// Split the atoms into contiguous blocks and process them, concurrently if there are multiple blocks
+	parallel_for_blocks( num_atoms, prm_num_threads, calc_atom_areas_fn, prm_min_atoms_per_thread );
+
+	// Sum the atoms' areas into their residues (in the same order as calc_accessibilities_with_scanning())
+	doub_vec residue_areas( residue_ctr, 0.0 );
+	for (const size_t &atom_ctr : indices( num_atoms ) ) {
+		residue_areas[ atom_residue_indices[ atom_ctr ] ] += atom_areas[ atom_ctr ];
+	}
+	return residue_areas;
+}
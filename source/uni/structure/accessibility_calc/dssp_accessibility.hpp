@@ -62,6 +62,11 @@ namespace cath {
 				static constexpr double MAX_ATOM_DIST    = RADIUS_CA + RADIUS_CA + RADIUS_WATER + RADIUS_WATER;
 			};
 
+			/// \brief The default minimum number of atoms to give each thread in calc_accessibilities_with_neighbour_lists()
+			///
+			/// Below this, the cost of starting a thread outweighs the work it would do
+			static constexpr size_t DEF_MIN_ATOMS_PER_ACCESS_THREAD = 2000;
+
 		} // namespace detail
 
 		geom::coord_vec make_dssp_ball_points(const size_t & = detail::dssp_ball_constants::NUMBER);
@@ -99,6 +104,10 @@ namespace cath {
 
 		doub_vec calc_accessibilities_with_scanning(const file::pdb &);
 
+		doub_vec calc_accessibilities_with_neighbour_lists(const file::pdb &,
+		                                                   const size_t & = 1,
+		                                                   const size_t & = detail::DEF_MIN_ATOMS_PER_ACCESS_THREAD);
+
 	} // namespace sec
 } // namespace cath
 
@@ -128,4 +128,15 @@ BOOST_AUTO_TEST_CASE(gets_pdb_accessibility_surface_area_correct) {
 	BOOST_CHECK_EQUAL_RANGES( get_accesses_raw, expected_accesses );
 }
 
+BOOST_AUTO_TEST_CASE(calc_accessibilities_with_neighbour_lists_does_not_throw_or_error_on_empty_pdb) {
+	BOOST_CHECK_NO_THROW_DIAG( calc_accessibilities_with_neighbour_lists( pdb{} ) );
+}
+
+BOOST_AUTO_TEST_CASE(neighbour_lists_give_identical_accessibilities_to_scanning) {
+	const auto     parsed_pdb        = read_pdb_file( global_test_constants::EXAMPLE_A_PDB_FILENAME() );
+	const doub_vec scanning_accesses = calc_accessibilities_with_scanning( parsed_pdb );
+	BOOST_CHECK_EQUAL_RANGES( calc_accessibilities_with_neighbour_lists( parsed_pdb       ), scanning_accesses );
+	BOOST_CHECK_EQUAL_RANGES( calc_accessibilities_with_neighbour_lists( parsed_pdb, 3, 1 ), scanning_accesses );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -20,12 +20,8 @@
 
 #include "residue_querier.hpp"
 
-#include <boost/numeric/conversion/cast.hpp>
-
-#include "common/debug_numeric_cast.hpp"
-#include "ssap/context_res.hpp"
-#include "ssap/ssap.hpp"
 #include "structure/protein/protein.hpp"
+#include "structure/protein/protein_comparison_view.hpp"
 
 using namespace cath;
 using namespace std;
@@ -35,6 +31,15 @@ constexpr float_score_type residue_querier::RESIDUE_B_VALUE;
 constexpr float_score_type residue_querier::RESIDUE_MIN_SCORE_CUTOFF;
 constexpr float_score_type residue_querier::RESIDUE_MAX_DIST_SQ_CUTOFF;
 
+/// \brief Ctor from views of the two proteins' residue data
+///
+/// The views must outlive this residue_querier
+residue_querier::residue_querier(const protein_comparison_view &prm_view_a, ///< A view of the first  protein's residue data
+                                 const protein_comparison_view &prm_view_b  ///< A view of the second protein's residue data
+                                 ) : view_a{ prm_view_a },
+                                     view_b{ prm_view_b } {
+}
+
 /// \brief TODOCUMENT
 size_t residue_querier::do_get_length(const protein &prm_protein ///< TODOCUMENT
                                       ) const {
@@ -61,9 +66,7 @@ string residue_querier::do_get_entry_name() const {
 	return "residue";
 }
 
-/// \brief TODOCUMENT
-///
-/// TEMPORARILY DEBUGGING
+/// \brief An override that passes through to the non-virtual distance_score__offset_1()
 score_type residue_querier::do_distance_score__offset_1(const protein &prm_protein_a,                   ///< TODOCUMENT
                                                         const protein &prm_protein_b,                   ///< TODOCUMENT
                                                         const size_t  &prm_a_view_from_index__offset_1, ///< TODOCUMENT
@@ -71,15 +74,13 @@ score_type residue_querier::do_distance_score__offset_1(const protein &prm_prote
                                                         const size_t  &prm_a_dest_to_index__offset_1,   ///< TODOCUMENT
                                                         const size_t  &prm_b_dest_to_index__offset_1    ///< TODOCUMENT
                                                         ) const {
-	const residue &residue_a_view_from = get_residue_ref_of_index__offset_1( prm_protein_a, prm_a_view_from_index__offset_1 );
-	const residue &residue_b_view_from = get_residue_ref_of_index__offset_1( prm_protein_b, prm_b_view_from_index__offset_1 );
-	const residue &residue_a_dest_to   = get_residue_ref_of_index__offset_1( prm_protein_a, prm_a_dest_to_index__offset_1   );
-	const residue &residue_b_dest_to   = get_residue_ref_of_index__offset_1( prm_protein_b, prm_b_dest_to_index__offset_1   );
-	return debug_numeric_cast<score_type>(
-		context_res<true>(
-			residue_a_view_from, residue_b_view_from,
-			residue_a_dest_to,   residue_b_dest_to
-		)
+	return distance_score__offset_1(
+		prm_protein_a,
+		prm_protein_b,
+		prm_a_view_from_index__offset_1,
+		prm_b_view_from_index__offset_1,
+		prm_a_dest_to_index__offset_1,
+		prm_b_dest_to_index__offset_1
 	);
 }
 
@@ -94,15 +95,18 @@ bool residue_querier::do_are_comparable__offset_1(const protein &/*prm_protein_a
 	return true;
 }
 
-/// \brief TODOCUMENT
+/// \brief An override that passes through to the non-virtual are_similar__offset_1()
 bool residue_querier::do_are_similar__offset_1(const protein &prm_protein_a,         ///< TODOCUMENT
                                                const protein &prm_protein_b,         ///< TODOCUMENT
                                                const size_t  &prm_index_a__offset_1, ///< TODOCUMENT
                                                const size_t  &prm_index_b__offset_1  ///< TODOCUMENT
                                                ) const {
-	const residue &residue_a = get_residue_ref_of_index__offset_1( prm_protein_a, prm_index_a__offset_1 );
-	const residue &residue_b = get_residue_ref_of_index__offset_1( prm_protein_b, prm_index_b__offset_1 );
-	return residues_have_similar_area_angle_props(residue_a, residue_b);
+	return are_similar__offset_1(
+		prm_protein_a,
+		prm_protein_b,
+		prm_index_a__offset_1,
+		prm_index_b__offset_1
+	);
 }
 
 /// \brief TODOCUMENT
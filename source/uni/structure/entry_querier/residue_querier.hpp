@@ -21,13 +21,27 @@
 #ifndef _CATH_TOOLS_SOURCE_UNI_STRUCTURE_ENTRY_QUERIER_RESIDUE_QUERIER_HPP
 #define _CATH_TOOLS_SOURCE_UNI_STRUCTURE_ENTRY_QUERIER_RESIDUE_QUERIER_HPP
 
+#include <boost/optional.hpp>
+
 #include "structure/entry_querier/entry_querier.hpp"
+#include "structure/structure_type_aliases.hpp"
 
 namespace cath {
 
 	/// \brief TODOCUMENT
+	///
+	/// If constructed from a pair of protein_comparison_views, this reads the residue data from
+	/// those views rather than from the proteins' residues. The views must have been built from
+	/// the same proteins that are passed to the querying methods (which is asserted) and must
+	/// outlive this residue_querier.
 	class residue_querier final : public entry_querier {
 	private:
+		/// \brief An optional view of the first protein's residue data
+		protein_comparison_view_cref_opt view_a;
+
+		/// \brief An optional view of the second protein's residue data
+		protein_comparison_view_cref_opt view_b;
+
 		size_t           do_get_length(const cath::protein &) const final;
 		double           do_get_gap_penalty_ratio() const final;
 		size_t           do_num_excluded_on_either_size() const final;
@@ -56,6 +70,28 @@ namespace cath {
 		bool         do_temp_hacky_is_residue() const final;
 
 	public:
+		residue_querier() = default;
+		residue_querier(const protein_comparison_view &,
+		                const protein_comparison_view &);
+
+		/// These shadow the entry_querier NVI functions of the same names so that code
+		/// that knows it's dealing with a residue_querier (eg the SSAP passes specialised on
+		/// the querier type) can call them directly rather than through a virtual call
+
+		inline score_type distance_score__offset_1(const cath::protein &,
+		                                           const cath::protein &,
+		                                           const size_t &,
+		                                           const size_t &,
+		                                           const size_t &,
+		                                           const size_t &) const;
+
+		inline bool  are_similar__offset_1(const cath::protein &,
+		                                   const cath::protein &,
+		                                   const size_t &,
+		                                   const size_t &) const;
+
+		inline bool  temp_hacky_is_residue() const;
+
 		/// As in the SSAP paper(s), the a and b values are used to convert the distance into a score
 		/// for dynamic programming. The inherited code (this is being written in August 2013), which
 		/// appears to use the square of the distance between residues rather than the distance as indicated
@@ -95,6 +131,15 @@ namespace cath {
 		static constexpr float_score_type RESIDUE_MAX_DIST_SQ_CUTOFF = RESIDUE_A_VALUE / RESIDUE_MIN_SCORE_CUTOFF - RESIDUE_B_VALUE;
 	};
 
+	/// \brief Return whether this querier queries residues, which it does
+	inline bool residue_querier::temp_hacky_is_residue() const {
+		return true;
+	}
+
 } // namespace cath
 
+// The inline definitions of distance_score__offset_1() and are_similar__offset_1() are at the end
+// of context_res.hpp, which needs the complete residue_querier (for its constants)
+#include "ssap/context_res.hpp"
+
 #endif
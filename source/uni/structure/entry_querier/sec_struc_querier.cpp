@@ -22,7 +22,6 @@
 
 #include <boost/numeric/conversion/cast.hpp>
 
-#include "ssap/ssap.hpp"
 #include "structure/protein/protein.hpp"
 #include "structure/protein/residue.hpp"
 #include "structure/protein/sec_struc.hpp"
@@ -64,7 +63,7 @@ string sec_struc_querier::do_get_entry_name() const {
 	return "secondary structure";
 }
 
-/// \brief TODOCUMENT
+/// \brief An override that passes through to the non-virtual distance_score__offset_1()
 score_type sec_struc_querier::do_distance_score__offset_1(const protein &prm_protein_a,                   ///< TODOCUMENT
                                                           const protein &prm_protein_b,                   ///< TODOCUMENT
                                                           const size_t  &prm_a_view_from_index__offset_1, ///< TODOCUMENT
@@ -72,27 +71,13 @@ score_type sec_struc_querier::do_distance_score__offset_1(const protein &prm_pro
                                                           const size_t  &prm_a_dest_to_index__offset_1,   ///< TODOCUMENT
                                                           const size_t  &prm_b_dest_to_index__offset_1    ///< TODOCUMENT
                                                           ) const {
-	// Sanity check the inputs
-	const size_t num_sec_strucs_in_a = prm_protein_a.get_num_sec_strucs();
-	if (prm_a_view_from_index__offset_1 < 1 || prm_a_view_from_index__offset_1 > num_sec_strucs_in_a ) {
-		BOOST_THROW_EXCEPTION(invalid_argument_exception("prm_a_view_from_index__offset_1 is out of range"));
-	}
-	if (prm_a_dest_to_index__offset_1   < 1 || prm_a_dest_to_index__offset_1   > num_sec_strucs_in_a ) {
-		BOOST_THROW_EXCEPTION(invalid_argument_exception("prm_a_dest_to_index__offset_1   is out of range"));
-	}
-	const size_t num_sec_strucs_in_b = prm_protein_b.get_num_sec_strucs();
-	if (prm_b_view_from_index__offset_1 < 1 || prm_b_view_from_index__offset_1 > num_sec_strucs_in_b ) {
-		BOOST_THROW_EXCEPTION(invalid_argument_exception("prm_b_view_from_index__offset_1 is out of range"));
-	}
-	if (prm_b_dest_to_index__offset_1   < 1 || prm_b_dest_to_index__offset_1   > num_sec_strucs_in_b ) {
-		BOOST_THROW_EXCEPTION(invalid_argument_exception("prm_b_dest_to_index__offset_1   is out of range"));
-	}
-
-	// Pass through to context_sec (whilst switching the indices to use offset 0)
-	return context_sec(
-		prm_protein_a,                       prm_protein_b,
-		prm_a_view_from_index__offset_1 - 1, prm_b_view_from_index__offset_1 - 1,
-		prm_a_dest_to_index__offset_1   - 1, prm_b_dest_to_index__offset_1   - 1
+	return distance_score__offset_1(
+		prm_protein_a,
+		prm_protein_b,
+		prm_a_view_from_index__offset_1,
+		prm_b_view_from_index__offset_1,
+		prm_a_dest_to_index__offset_1,
+		prm_b_dest_to_index__offset_1
 	);
 }
 
@@ -120,19 +105,18 @@ bool sec_struc_querier::do_are_comparable__offset_1(const protein &prm_protein_a
 	return ( i_sec_strucs_match && j_sec_strucs_match );
 }
 
-/// \brief TODOCUMENT
+/// \brief An override that passes through to the non-virtual are_similar__offset_1()
 bool sec_struc_querier::do_are_similar__offset_1(const protein &prm_protein_a,         ///< TODOCUMENT
                                                  const protein &prm_protein_b,         ///< TODOCUMENT
                                                  const size_t  &prm_index_a__offset_1, ///< TODOCUMENT
                                                  const size_t  &prm_index_b__offset_1  ///< TODOCUMENT
                                                  ) const {
-	check_offset_1( prm_index_a__offset_1 );
-	check_offset_1( prm_index_b__offset_1 );
-
-	const sec_struc &sec_struc_a = prm_protein_a.get_sec_struc_ref_of_index( prm_index_a__offset_1 - 1 );
-	const sec_struc &sec_struc_b = prm_protein_b.get_sec_struc_ref_of_index( prm_index_b__offset_1 - 1 );
-
-	return ( sec_struc_a.get_type() == sec_struc_b.get_type() );
+	return are_similar__offset_1(
+		prm_protein_a,
+		prm_protein_b,
+		prm_index_a__offset_1,
+		prm_index_b__offset_1
+	);
 }
 
 /// \brief TODOCUMENT
@@ -21,7 +21,11 @@
 #ifndef _CATH_TOOLS_SOURCE_UNI_STRUCTURE_ENTRY_QUERIER_SEC_STRUC_QUERIER_HPP
 #define _CATH_TOOLS_SOURCE_UNI_STRUCTURE_ENTRY_QUERIER_SEC_STRUC_QUERIER_HPP
 
+#include "common/exception/invalid_argument_exception.hpp"
+#include "ssap/ssap.hpp"
 #include "structure/entry_querier/entry_querier.hpp"
+#include "structure/protein/protein.hpp"
+#include "structure/protein/sec_struc.hpp"
 
 namespace cath {
 
@@ -58,6 +62,24 @@ namespace cath {
 		bool         do_temp_hacky_is_residue() const final;
 
 	public:
+		/// These shadow the entry_querier NVI functions of the same names so that code
+		/// that knows it's dealing with a sec_struc_querier (eg the SSAP passes specialised on
+		/// the querier type) can call them directly rather than through a virtual call
+
+		inline score_type distance_score__offset_1(const cath::protein &,
+		                                           const cath::protein &,
+		                                           const size_t &,
+		                                           const size_t &,
+		                                           const size_t &,
+		                                           const size_t &) const;
+
+		inline bool  are_similar__offset_1(const cath::protein &,
+		                                   const cath::protein &,
+		                                   const size_t &,
+		                                   const size_t &) const;
+
+		inline bool  temp_hacky_is_residue() const;
+
 		/// \brief The value a used in the SSAP paper (for secondary structures)
 		///
 		/// Note that this scaled by INTEGER_SCALING^2 ( = 10 * 10 = 100), which matches
@@ -90,6 +112,62 @@ namespace cath {
 		static constexpr size_t SEC_STRUC_MAX_DIST_SQ_CUTOFF = SEC_STRUC_A_VALUE / SEC_STRUC_MIN_SCORE_CUTOFF - SEC_STRUC_B_VALUE;
 	};
 
+	/// \brief TODOCUMENT
+	///
+	/// This is defined inline so that the SSAP passes that are specialised on sec_struc_querier can inline it
+	inline score_type sec_struc_querier::distance_score__offset_1(const protein &prm_protein_a,                   ///< TODOCUMENT
+	                                                              const protein &prm_protein_b,                   ///< TODOCUMENT
+	                                                              const size_t  &prm_a_view_from_index__offset_1, ///< TODOCUMENT
+	                                                              const size_t  &prm_b_view_from_index__offset_1, ///< TODOCUMENT
+	                                                              const size_t  &prm_a_dest_to_index__offset_1,   ///< TODOCUMENT
+	                                                              const size_t  &prm_b_dest_to_index__offset_1    ///< TODOCUMENT
+	                                                              ) const {
+		// Sanity check the inputs
+		const size_t num_sec_strucs_in_a = prm_protein_a.get_num_sec_strucs();
+		if (prm_a_view_from_index__offset_1 < 1 || prm_a_view_from_index__offset_1 > num_sec_strucs_in_a ) {
+			BOOST_THROW_EXCEPTION(common::invalid_argument_exception("prm_a_view_from_index__offset_1 is out of range"));
+		}
+		if (prm_a_dest_to_index__offset_1   < 1 || prm_a_dest_to_index__offset_1   > num_sec_strucs_in_a ) {
+			BOOST_THROW_EXCEPTION(common::invalid_argument_exception("prm_a_dest_to_index__offset_1   is out of range"));
+		}
+		const size_t num_sec_strucs_in_b = prm_protein_b.get_num_sec_strucs();
+		if (prm_b_view_from_index__offset_1 < 1 || prm_b_view_from_index__offset_1 > num_sec_strucs_in_b ) {
+			BOOST_THROW_EXCEPTION(common::invalid_argument_exception("prm_b_view_from_index__offset_1 is out of range"));
+		}
+		if (prm_b_dest_to_index__offset_1   < 1 || prm_b_dest_to_index__offset_1   > num_sec_strucs_in_b ) {
+			BOOST_THROW_EXCEPTION(common::invalid_argument_exception("prm_b_dest_to_index__offset_1   is out of range"));
+		}
+
+		// Pass through to context_sec (whilst switching the indices to use offset 0)
+		return context_sec(
+			prm_protein_a,                       prm_protein_b,
+			prm_a_view_from_index__offset_1 - 1, prm_b_view_from_index__offset_1 - 1,
+			prm_a_dest_to_index__offset_1   - 1, prm_b_dest_to_index__offset_1   - 1
+		);
+	}
+
+	/// \brief TODOCUMENT
+	///
+	/// This is defined inline for the same reason as sec_struc_querier::distance_score__offset_1()
+	inline bool sec_struc_querier::are_similar__offset_1(const protein &prm_protein_a,         ///< TODOCUMENT
+	                                                     const protein &prm_protein_b,         ///< TODOCUMENT
+	                                                     const size_t  &prm_index_a__offset_1, ///< TODOCUMENT
+	                                                     const size_t  &prm_index_b__offset_1  ///< TODOCUMENT
+	                                                     ) const {
+		check_offset_1( prm_index_a__offset_1 );
+		check_offset_1( prm_index_b__offset_1 );
+
+		const sec_struc &sec_struc_a = prm_protein_a.get_sec_struc_ref_of_index( prm_index_a__offset_1 - 1 );
+		const sec_struc &sec_struc_b = prm_protein_b.get_sec_struc_ref_of_index( prm_index_b__offset_1 - 1 );
+
+		return ( sec_struc_a.get_type() == sec_struc_b.get_type() );
+	}
+
+	/// \brief Return whether this querier queries residues, which it doesn't
+	inline bool sec_struc_querier::temp_hacky_is_residue() const {
+		return false;
+	}
+
 } // namespace cath
 
 #endif
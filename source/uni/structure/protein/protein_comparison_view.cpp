@@ -0,0 +1,51 @@
+/// \file
+/// \brief The protein_comparison_view class definitions
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "protein_comparison_view.hpp"
+
+#include "structure/protein/protein.hpp"
+#include "structure/protein/residue.hpp"
+
+using namespace cath;
+
+/// \brief Ctor from the protein whose residues' data should be copied into the view
+protein_comparison_view::protein_comparison_view(const protein &prm_protein ///< The protein from which the view should be built
+                                                 ) : source_protein_ptr{ &prm_protein } {
+	const size_t num_residues = prm_protein.get_length();
+	carbon_alpha_coords.reserve( num_residues );
+	carbon_beta_coords.reserve ( num_residues );
+	frames.reserve             ( num_residues );
+	phi_angles.reserve         ( num_residues );
+	psi_angles.reserve         ( num_residues );
+	sec_struc_types.reserve    ( num_residues );
+	accesses.reserve           ( num_residues );
+	accessis.reserve           ( num_residues );
+
+	for (const residue &the_residue : prm_protein) {
+		carbon_alpha_coords.push_back( the_residue.get_carbon_alpha_coord() );
+		carbon_beta_coords.push_back ( the_residue.get_carbon_beta_coord()  );
+		frames.push_back             ( the_residue.get_frame()              );
+		phi_angles.push_back         ( the_residue.get_phi_angle()          );
+		psi_angles.push_back         ( the_residue.get_psi_angle()          );
+		sec_struc_types.push_back    ( the_residue.get_sec_struc_type()     );
+		accesses.push_back           ( the_residue.get_access()             );
+		accessis.push_back           ( get_accessi_of_residue( the_residue ) );
+	}
+}
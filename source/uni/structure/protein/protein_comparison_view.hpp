@@ -0,0 +1,174 @@
+/// \file
+/// \brief The protein_comparison_view class header
+
+/// \copyright
+/// CATH Tools - Protein structure comparison tools such as SSAP and SNAP
+/// Copyright (C) 2011, Orengo Group, University College London
+///
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _CATH_TOOLS_SOURCE_UNI_STRUCTURE_PROTEIN_PROTEIN_COMPARISON_VIEW_HPP
+#define _CATH_TOOLS_SOURCE_UNI_STRUCTURE_PROTEIN_PROTEIN_COMPARISON_VIEW_HPP
+
+#include "common/type_aliases.hpp"
+#include "structure/geometry/angle.hpp"
+#include "structure/geometry/coord.hpp"
+#include "structure/geometry/rotation.hpp"
+#include "structure/protein/sec_struc_type.hpp"
+#include "structure/structure_type_aliases.hpp"
+
+#include <cstddef>
+
+namespace cath { class protein; }
+
+namespace cath {
+
+	/// \brief A structure-of-arrays copy of the per-residue data of a protein that's used in the
+	///        inner loops of structure comparison
+	///
+	/// A residue holds lots of data (IDs, amino acid, coordinates, frame, angles, accessibility etc)
+	/// but the hot loops in SSAP and the scan only each use a few of them. Storing each of those
+	/// in its own contiguous array means that each cache line fetched in those loops only contains
+	/// data that's actually used.
+	///
+	/// This also precomputes each residue's "accessi" value (see get_accessi_of_residue()),
+	/// which otherwise requires a lookup by amino acid.
+	///
+	/// This is built from a protein and doesn't track any subsequent changes to that protein
+	/// so it should be built after the protein has been fully populated (including DSSP/sec data).
+	/// It records the address of that protein so that users can check (with is_view_of()) that
+	/// they're pairing it with the right protein.
+	class protein_comparison_view final {
+	private:
+		/// \brief The protein from which this view was built (only used to check that the view is being used with it)
+		const protein *      source_protein_ptr;
+
+		/// \brief The carbon alpha coordinates of the residues
+		geom::coord_vec      carbon_alpha_coords;
+
+		/// \brief The carbon beta coordinates of the residues
+		geom::coord_vec      carbon_beta_coords;
+
+		/// \brief The coordinate frames of the residues
+		geom::rotation_vec   frames;
+
+		/// \brief The phi angles of the residues
+		geom::doub_angle_vec phi_angles;
+
+		/// \brief The psi angles of the residues
+		geom::doub_angle_vec psi_angles;
+
+		/// \brief The secondary structure types of the residues
+		sec_struc_type_vec   sec_struc_types;
+
+		/// \brief The accessibilities of the residues (calculated in a DSSP/wolf manner)
+		size_vec             accesses;
+
+		/// \brief The "accessi" values of the residues (see get_accessi_of_residue())
+		int_vec              accessis;
+
+	public:
+		explicit protein_comparison_view(const protein &);
+
+		inline bool is_view_of(const protein &) const;
+		inline size_t get_length() const;
+
+		inline const geom::coord & get_carbon_alpha_coord_of_index(const size_t &) const;
+		inline const geom::coord & get_carbon_beta_coord_of_index(const size_t &) const;
+		inline const geom::rotation & get_frame_of_index(const size_t &) const;
+		inline const geom::doub_angle & get_phi_angle_of_index(const size_t &) const;
+		inline const geom::doub_angle & get_psi_angle_of_index(const size_t &) const;
+		inline const sec_struc_type & get_sec_struc_type_of_index(const size_t &) const;
+		inline const size_t & get_access_of_index(const size_t &) const;
+		inline const int & get_accessi_of_index(const size_t &) const;
+	};
+
+	/// \brief Whether this view was built from the specified protein
+	inline bool protein_comparison_view::is_view_of(const protein &prm_protein ///< The protein to check
+	                                                ) const {
+		return ( source_protein_ptr == &prm_protein );
+	}
+
+	/// \brief Get the number of residues in the view
+	inline size_t protein_comparison_view::get_length() const {
+		return carbon_beta_coords.size();
+	}
+
+	/// \brief Get the carbon alpha coordinates of the residue at the specified index
+	inline const geom::coord & protein_comparison_view::get_carbon_alpha_coord_of_index(const size_t &prm_index ///< The index of the residue of interest
+	                                                                                   ) const {
+		return carbon_alpha_coords[ prm_index ];
+	}
+
+	/// \brief Get the carbon beta coordinates of the residue at the specified index
+	inline const geom::coord & protein_comparison_view::get_carbon_beta_coord_of_index(const size_t &prm_index ///< The index of the residue of interest
+	                                                                                  ) const {
+		return carbon_beta_coords[ prm_index ];
+	}
+
+	/// \brief Get the coordinate frame of the residue at the specified index
+	inline const geom::rotation & protein_comparison_view::get_frame_of_index(const size_t &prm_index ///< The index of the residue of interest
+	                                                                         ) const {
+		return frames[ prm_index ];
+	}
+
+	/// \brief Get the phi angle of the residue at the specified index
+	inline const geom::doub_angle & protein_comparison_view::get_phi_angle_of_index(const size_t &prm_index ///< The index of the residue of interest
+	                                                                               ) const {
+		return phi_angles[ prm_index ];
+	}
+
+	/// \brief Get the psi angle of the residue at the specified index
+	inline const geom::doub_angle & protein_comparison_view::get_psi_angle_of_index(const size_t &prm_index ///< The index of the residue of interest
+	                                                                               ) const {
+		return psi_angles[ prm_index ];
+	}
+
+	/// \brief Get the secondary structure type of the residue at the specified index
+	inline const sec_struc_type & protein_comparison_view::get_sec_struc_type_of_index(const size_t &prm_index ///< The index of the residue of interest
+	                                                                                  ) const {
+		return sec_struc_types[ prm_index ];
+	}
+
+	/// \brief Get the accessibility of the residue at the specified index
+	inline const size_t & protein_comparison_view::get_access_of_index(const size_t &prm_index ///< The index of the residue of interest
+	                                                                  ) const {
+		return accesses[ prm_index ];
+	}
+
+	/// \brief Get the "accessi" value of the residue at the specified index (see get_accessi_of_residue())
+	inline const int & protein_comparison_view::get_accessi_of_index(const size_t &prm_index ///< The index of the residue of interest
+	                                                                ) const {
+		return accessis[ prm_index ];
+	}
+
+	/// \brief Get the view from the "from" residue to the "to" residue: the to-residue's carbon beta
+	///        coordinates, relative to the from-residue's carbon beta and rotated into its frame
+	///
+	/// This matches view_vector_of_residue_pair() on the equivalent residues
+	///
+	/// \relates protein_comparison_view
+	inline geom::coord view_vector_of_index_pair(const protein_comparison_view &prm_view,       ///< The protein_comparison_view containing the two residues
+	                                             const size_t                  &prm_from_index, ///< The index of the "from" residue
+	                                             const size_t                  &prm_to_index    ///< The index of the "to"   residue
+	                                             ) {
+		return rotate_copy(
+			prm_view.get_frame_of_index( prm_from_index ),
+			prm_view.get_carbon_beta_coord_of_index( prm_to_index ) - prm_view.get_carbon_beta_coord_of_index( prm_from_index )
+		);
+	}
+
+} // namespace cath
+
+#endif
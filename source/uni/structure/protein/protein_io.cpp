@@ -187,8 +187,8 @@ protein cath::make_protein_from_pdb_and_calc_dssp(const pdb             &prm_pdb
 
 	// build_protein_of_pdb_and_name() already does phi/psi angles
 	// so now do the sec_struc types and accessibilities
-	set_sec_struc_types( the_protein, calc_sec_strucs_of_backbone_complete_pdb( the_pdb ) );
-	set_accessibilities( the_protein, calc_accessibilities_with_scanning      ( the_pdb ) );
+	set_sec_struc_types( the_protein, calc_sec_strucs_of_backbone_complete_pdb( the_pdb, 0 ) );
+	set_accessibilities( the_protein, calc_accessibilities_with_neighbour_lists( the_pdb, 0 ) );
 	return the_protein;
 }
 
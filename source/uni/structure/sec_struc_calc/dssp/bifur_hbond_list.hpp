@@ -23,7 +23,9 @@
 
 #include <boost/optional.hpp>
 
+#include "common/boost_addenda/range/indices.hpp"
 #include "common/cpp14/cbegin_cend.hpp"
+#include "common/exception/invalid_argument_exception.hpp"
 
 #include <utility>
 #include <vector>
@@ -136,6 +138,22 @@ namespace cath {
 			}
 		}
 
+		/// \brief Update an half_bond_opt_pair with each of the (present) hbond_halfs in another hbond_half_opt_pair
+		///
+		/// Since each hbond_half_opt_pair holds the best two hbond_halfs it has been updated with and
+		/// since is_bondier_than() is a strict ordering, this leaves the first hbond_half_opt_pair as it would have
+		/// been if it had been updated with all the hbond_halfs used to build both (in any order)
+		inline void update_half_bond_pair(hbond_half_opt_pair       &prm_hbond_pair,      ///< The hbond_half_opt_pair to update
+		                                  const hbond_half_opt_pair &prm_other_hbond_pair ///< The hbond_half_opt_pair whose hbond_halfs should be used to update the first
+		                                  ) {
+			if ( prm_other_hbond_pair.first ) {
+				update_half_bond_pair( prm_hbond_pair, *prm_other_hbond_pair.first );
+			}
+			if ( prm_other_hbond_pair.second ) {
+				update_half_bond_pair( prm_hbond_pair, *prm_other_hbond_pair.second );
+			}
+		}
+
 		/// \brief Copy the specified hbond_half_opt_pair and update_half_bond_pair() and return the copy
 		inline hbond_half_opt_pair update_half_bond_pair_copy(hbond_half_opt_pair  prm_hbond_pair, ///< The hbond_half_opt_pair from which to take a copy to update_half_bond_pair() and return
 		                                                      const hbond_half    &prm_hbond       ///< The hbond_half with which the copy of the hbond_half_opt_pair should be updated
@@ -144,6 +162,14 @@ namespace cath {
 			return prm_hbond_pair;
 		}
 
+		/// \brief Copy the specified hbond_half_opt_pair and update_half_bond_pair() with another and return the copy
+		inline hbond_half_opt_pair update_half_bond_pair_copy(hbond_half_opt_pair        prm_hbond_pair,      ///< The hbond_half_opt_pair from which to take a copy to update_half_bond_pair() and return
+		                                                      const hbond_half_opt_pair &prm_other_hbond_pair ///< The hbond_half_opt_pair with which the copy of the first should be updated
+		                                                      ) {
+			update_half_bond_pair( prm_hbond_pair, prm_other_hbond_pair );
+			return prm_hbond_pair;
+		}
+
 		/// \brief Wipe each half of the specified hbond_half_opt_pair to none if 
 		///         * (a) it isn't already and
 		///         * (b) it isn't strong enough to be considered a true hbond
@@ -169,6 +195,7 @@ namespace cath {
 		public:
 			bifur_hbond & update_for_this_nh(const hbond_half &);
 			bifur_hbond & update_for_this_co(const hbond_half &);
+			bifur_hbond & update_with(const bifur_hbond &);
 
 			bifur_hbond & remove_not_bondy_enough();
 
@@ -190,6 +217,15 @@ namespace cath {
 			return *this;
 		}
 
+		/// \brief Update the best h-bonds from the NH and CO atoms of this residue with those of another bifur_hbond
+		///        (typically calculated from a different subset of the candidate bonds)
+		inline bifur_hbond & bifur_hbond::update_with(const bifur_hbond &prm_other ///< The other bifur_hbond with which to update
+		                                              ) {
+			update_half_bond_pair( for_this_nh, prm_other.get_bound_pair_for_this_nh() );
+			update_half_bond_pair( for_this_co, prm_other.get_bound_pair_for_this_co() );
+			return *this;
+		}
+
 		/// \brief Remove any parts of the bifur_hbond that aren't strong enough to be considered a true hbond
 		inline bifur_hbond & bifur_hbond::remove_not_bondy_enough() {
 			cath::sec::remove_not_bondy_enough( for_this_nh );
@@ -238,6 +274,8 @@ namespace cath {
 			                                                    const hbond_partner_t &,
 			                                                    const hbond_energy_t &);
 
+			bifur_hbond_list & update_with(const bifur_hbond_list &);
+
 			const_iterator begin() const;
 			const_iterator end() const;
 		};
@@ -282,6 +320,25 @@ namespace cath {
 			return *this;
 		}
 
+		/// \brief Update the bifur_hbond_list with the candidate bonds of another bifur_hbond_list
+		///        of the same structure
+		///
+		/// This allows separate bifur_hbond_lists to be calculated from disjoint subsets of the candidate
+		/// bonds (eg on separate threads) and then combined into the same result as if they'd all been
+		/// added to one bifur_hbond_list.
+		///
+		/// \pre `prm_other.size() == size()` else an invalid_argument_exception is thrown
+		inline bifur_hbond_list & bifur_hbond_list::update_with(const bifur_hbond_list &prm_other ///< The other bifur_hbond_list with which to update
+		                                                        ) {
+			if ( prm_other.size() != size() ) {
+				BOOST_THROW_EXCEPTION(common::invalid_argument_exception("Cannot update a bifur_hbond_list with one of a different size"));
+			}
+			for (const size_t &bifur_hbond_ctr : common::indices( size() ) ) {
+				bifur_hbonds[ bifur_hbond_ctr ].update_with( prm_other[ bifur_hbond_ctr ] );
+			}
+			return *this;
+		}
+
 		/// \brief Standard begin() method to allow iteration over the bifur_hbonds
 		inline auto bifur_hbond_list::begin() const -> const_iterator {
 			return common::cbegin( bifur_hbonds );
@@ -94,6 +94,14 @@ BOOST_AUTO_TEST_CASE(hbond_half_pair_updates_correctly) {
 	BOOST_CHECK_EQUAL( update_half_bond_pair_copy( { none, none }, b ), hbond_half_opt_pair( b, none ) );
 }
 
+BOOST_AUTO_TEST_CASE(hbond_half_pair_updates_correctly_with_another_pair) {
+	BOOST_CHECK_EQUAL( update_half_bond_pair_copy( { a,    none }, { c,    b    } ), hbond_half_opt_pair( c, b    ) );
+	BOOST_CHECK_EQUAL( update_half_bond_pair_copy( { b,    none }, { c,    a    } ), hbond_half_opt_pair( c, b    ) );
+	BOOST_CHECK_EQUAL( update_half_bond_pair_copy( { c,    a    }, { b,    none } ), hbond_half_opt_pair( c, b    ) );
+	BOOST_CHECK_EQUAL( update_half_bond_pair_copy( { b,    none }, { none, none } ), hbond_half_opt_pair( b, none ) );
+	BOOST_CHECK_EQUAL( update_half_bond_pair_copy( { none, none }, { b,    a    } ), hbond_half_opt_pair( b, a    ) );
+}
+
 BOOST_AUTO_TEST_CASE(bifur_hbond_updates_correctly) {
 	BOOST_CHECK_EQUAL( bifur_hbond{}.update_for_this_nh( a ).get_bound_pair_for_this_nh(), hbond_half_opt_pair( a,    none ) );
 	BOOST_CHECK_EQUAL( bifur_hbond{}.update_for_this_nh( a ).get_bound_pair_for_this_co(), hbond_half_opt_pair( none, none ) );
@@ -101,6 +109,17 @@ BOOST_AUTO_TEST_CASE(bifur_hbond_updates_correctly) {
 	BOOST_CHECK_EQUAL( bifur_hbond{}.update_for_this_co( a ).get_bound_pair_for_this_co(), hbond_half_opt_pair( a,    none ) );
 }
 
+BOOST_AUTO_TEST_CASE(bifur_hbond_list_updates_with_another_list_as_if_with_all_its_bonds) {
+	bifur_hbond_list all_bonds  { 3 };
+	bifur_hbond_list first_half { 3 };
+	bifur_hbond_list second_half{ 3 };
+	all_bonds  .update_with_nh_idx_co_idx_energy( 0, 2, energy_a ).update_with_nh_idx_co_idx_energy( 0, 1, energy_c ).update_with_nh_idx_co_idx_energy( 1, 2, energy_b );
+	first_half .update_with_nh_idx_co_idx_energy( 0, 2, energy_a );
+	second_half.update_with_nh_idx_co_idx_energy( 0, 1, energy_c ).update_with_nh_idx_co_idx_energy( 1, 2, energy_b );
+
+	BOOST_CHECK_EQUAL( to_string( first_half.update_with( second_half ) ), to_string( all_bonds ) );
+}
+
 BOOST_AUTO_TEST_CASE(bifur_hbond_list_to_strings_correctly) {
 	BOOST_CHECK_EQUAL( to_string( bifur_hbond_list{ 2 } ), "bifur_hbond_list[\n\tbifur_hbond[nh_1st:(             ), nh_2nd(             ), co_1st:(             ), co_2nd:(             )]\n\tbifur_hbond[nh_1st:(             ), nh_2nd(             ), co_1st:(             ), co_2nd:(             )]]" );
 }
@@ -21,7 +21,11 @@
 #include "dssp_hbond_calc.hpp"
 
 
+#include <boost/range/irange.hpp>
+
+#include "common/algorithm/parallel_for_blocks.hpp"
 #include "common/debug_numeric_cast.hpp"
+#include "common/size_t_literal.hpp"
 #include "file/pdb/pdb_atom.hpp"
 #include "scan/spatial_index/spatial_index.hpp"
 #include "structure/sec_struc_calc/dssp/bifur_hbond_list.hpp"
@@ -31,21 +35,26 @@ using namespace cath::file;
 using namespace cath::scan;
 using namespace cath::sec;
 
+using boost::irange;
+using std::vector;
+
 /// \brief Calculate the bifur_hbond_list list of (possibly bifurcating) hbonds between
 ///        the residues in the specified PDB
 ///
 /// This calls backbone_complete_subset_of_pdb() on the PDB. If the results are being generated
 /// in a context where that is required for other tasks, it's better to call backbone_complete_subset_of_pdb()
 /// outside and then use calc_bifur_hbonds_of_backbone_complete_pdb() instead.
-bifur_hbond_list dssp_hbond_calc::calc_bifur_hbonds_of_pdb__recalc_backbone_residues(const pdb             &prm_pdb,            ///< The PDB to query
-                                                                                     const ostream_ref_opt &prm_ostream_ref_opt ///< An optional reference to an ostream to which any logging should be sent
+bifur_hbond_list dssp_hbond_calc::calc_bifur_hbonds_of_pdb__recalc_backbone_residues(const pdb             &prm_pdb,             ///< The PDB to query
+                                                                                     const ostream_ref_opt &prm_ostream_ref_opt, ///< An optional reference to an ostream to which any logging should be sent
+                                                                                     const size_t          &prm_num_threads      ///< The number of threads to use (or 0 to use one per hardware thread)
                                                                                      ) {
 	return calc_bifur_hbonds_of_backbone_complete_pdb(
 		backbone_complete_subset_of_pdb(
 			prm_pdb,
 			prm_ostream_ref_opt,
 			dssp_skip_res_skipping::SKIP
-		).first
+		).first,
+		prm_num_threads
 	);
 }
 
@@ -56,7 +65,14 @@ bifur_hbond_list dssp_hbond_calc::calc_bifur_hbonds_of_pdb__recalc_backbone_resi
 ///
 /// For simplicity, calc_bifur_hbonds_of_pdb__recalc_backbone_residues() can be used
 /// with a non backbone-complete PDB
-bifur_hbond_list dssp_hbond_calc::calc_bifur_hbonds_of_backbone_complete_pdb(const pdb &prm_pdb ///< The PDB to query
+///
+/// If more than one thread is used, the residues are split into contiguous blocks, each of which is
+/// scanned for its hbonds into a separate bifur_hbond_list on its own thread, and then those
+/// bifur_hbond_lists are combined. Each bifur_hbond just keeps the best two bonds it's seen
+/// so this gives exactly the same results as the single-threaded calculation.
+bifur_hbond_list dssp_hbond_calc::calc_bifur_hbonds_of_backbone_complete_pdb(const pdb    &prm_pdb,                    ///< The PDB to query
+                                                                             const size_t &prm_num_threads,            ///< The number of threads to use (or 0 to use one per hardware thread)
+                                                                             const size_t &prm_min_residues_per_thread ///< The minimum number of residues to give each thread
                                                                              ) {
 	// Note that this is set a little bit higher because sometimes float rounding
 	// errors take the answer over the cutoff. This can be fixed using doubles
@@ -73,26 +89,46 @@ bifur_hbond_list dssp_hbond_calc::calc_bifur_hbonds_of_backbone_complete_pdb(con
 	if ( num_pdb_residues > 0 ) {
 		const auto lattice = make_sparse_lattice( prm_pdb, CELL_SIZE, MAX_DIST );
 
-		scan_sparse_lattice(
-			lattice,
-			prm_pdb,
-			CELL_SIZE,
-			MAX_DIST,
-			[&] (const simple_locn_index &x, const simple_locn_index &y) {
-				if ( x.index != y.index ) {
-					if ( dssp_hbond_calc::has_hbond_energy_asymm( prm_pdb, x.index, y.index ) ) {
-						const auto energy = dssp_hbond_calc::get_hbond_energy_asymm( prm_pdb, x.index, y.index );
-						if ( energy < 0.0 ) {
-							results.update_with_nh_idx_co_idx_energy(
-								x.index,
-								y.index,
-								energy
-							);
+		// Scan the residues in the specified range of indices for their hbonds and add them to the specified bifur_hbond_list
+		const auto scan_block_fn = [&] (const size_t &prm_begin_idx, const size_t &prm_end_idx, bifur_hbond_list &prm_block_results) {
+			scan_sparse_lattice(
+				lattice,
+				prm_pdb,
+				prm_begin_idx,
+				prm_end_idx,
+				CELL_SIZE,
+				MAX_DIST,
+				[&] (const simple_locn_index &x, const simple_locn_index &y) {
+					if ( x.index != y.index ) {
+						if ( dssp_hbond_calc::has_hbond_energy_asymm( prm_pdb, x.index, y.index ) ) {
+							const auto energy = dssp_hbond_calc::get_hbond_energy_asymm( prm_pdb, x.index, y.index );
+							if ( energy < 0.0 ) {
+								prm_block_results.update_with_nh_idx_co_idx_energy(
+									x.index,
+									y.index,
+									energy
+								);
+							}
 						}
 					}
 				}
-			}
+			);
+		};
+
+		vector<bifur_hbond_list> block_results = parallel_transform_blocks(
+			num_pdb_residues,
+			prm_num_threads,
+			[&] (const size_t &prm_begin_idx, const size_t &prm_end_idx) {
+				bifur_hbond_list block_result{ num_pdb_residues };
+				scan_block_fn( prm_begin_idx, prm_end_idx, block_result );
+				return block_result;
+			},
+			prm_min_residues_per_thread
 		);
+		results = std::move( block_results.front() );
+		for (const size_t &block_ctr : irange( 1_z, block_results.size() ) ) {
+			results.update_with( block_results[ block_ctr ] );
+		}
 	}
 
 	return results;
@@ -49,6 +49,14 @@ namespace cath { namespace sec { class bifur_hbond_list; } }
 
 namespace cath {
 	namespace sec {
+		namespace detail {
+
+			/// \brief The default minimum number of residues to give each thread in the multi-threaded DSSP calculations
+			///
+			/// Below this, the cost of starting the threads isn't worth paying
+			static constexpr size_t DEF_MIN_RESIDUES_PER_DSSP_THREAD = 1000;
+
+		} // namespace detail
 
 		/// \brief The type to use for hbond energy calculations
 		///
@@ -83,9 +91,12 @@ namespace cath {
 			                                   const size_t &);
 
 			static bifur_hbond_list calc_bifur_hbonds_of_pdb__recalc_backbone_residues(const file::pdb &,
-			                                                                           const ostream_ref_opt & = boost::none);
+			                                                                           const ostream_ref_opt & = boost::none,
+			                                                                           const size_t & = 1);
 
-			static bifur_hbond_list calc_bifur_hbonds_of_backbone_complete_pdb(const file::pdb &);
+			static bifur_hbond_list calc_bifur_hbonds_of_backbone_complete_pdb(const file::pdb &,
+			                                                                   const size_t & = 1,
+			                                                                   const size_t & = detail::DEF_MIN_RESIDUES_PER_DSSP_THREAD);
 		};
 
 		/// \brief Calculate the DSSP hbond energy between the specified N & H coords of one
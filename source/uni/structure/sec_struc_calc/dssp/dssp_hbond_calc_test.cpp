@@ -108,6 +108,14 @@ namespace cath {
 				// BOOST_TEST_INFO() isn't present in Boost > 1.58.0
 				// BOOST_TEST_INFO  ( "Checking DSSP file \"" + prm_dssp_file.string() + "\"" );
 				BOOST_CHECK_EQUAL( difference_string( dssp_hbonds, bifur_hbonds ), none );
+
+				// Check that splitting the residues across multiple threads gives the same results
+				const auto multi_threaded_bifur_hbonds = dssp_hbond_calc::calc_bifur_hbonds_of_backbone_complete_pdb(
+					backbone_complete_subset_of_pdb( parsed_pdb, none, dssp_skip_res_skipping::SKIP ).first,
+					3,
+					1
+				);
+				BOOST_CHECK_EQUAL( difference_string( dssp_hbonds, multi_threaded_bifur_hbonds ), none );
 			}
 		}
 
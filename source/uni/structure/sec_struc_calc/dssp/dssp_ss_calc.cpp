@@ -32,6 +32,7 @@
 #include <boost/range/irange.hpp>
 
 #include "common/algorithm/append.hpp"
+#include "common/algorithm/parallel_for_blocks.hpp"
 #include "common/algorithm/transform_build.hpp"
 #include "common/boost_addenda/range/indices.hpp"
 #include "structure/protein/protein.hpp"
@@ -41,6 +42,7 @@
 #include "structure/sec_struc_calc/dssp/dssp_hbond_calc.hpp"
 
 #include <algorithm>
+#include <utility>
 
 using namespace cath;
 using namespace cath::common;
@@ -64,6 +66,7 @@ using std::max;
 using std::min;
 using std::ostream;
 using std::string;
+using std::vector;
 
 constexpr size_t sec_struc_consts::MIN_ALLOWABLE_RES_DIFF_FOR_BETA_BRIDGE;
 constexpr size_t sec_struc_consts::BETA_BULGE_MAX_DIFF_SOURCE;
@@ -723,19 +726,35 @@ bool cath::sec::detail::indices_straddle_break(const size_vec &prm_break_indices
 ///
 /// \pre `prm_break_indices` must be sorted in ascending order
 ///
+/// If more than one thread is used, the per-residue work of finding the beta-bridges and of
+/// finding the helices is split into contiguous blocks of residues on separate threads. Those steps
+/// only read the hbonds and each writes only its own residue's results, so this gives exactly the
+/// same results as the single-threaded calculation. The beta-bulge step (which may write to
+/// residues far from the one being considered) remains single-threaded.
+///
 /// \relates bifur_hbond_list
-sec_struc_type_vec cath::sec::calc_sec_strucs(const bifur_hbond_list &prm_bifur_hbond_list_raw, ///< The bifur_hbond_list to query
-                                              const size_vec         &prm_break_indices         ///< A list of the residues that are preceded by a chain break in ascending order
+sec_struc_type_vec cath::sec::calc_sec_strucs(const bifur_hbond_list &prm_bifur_hbond_list_raw,  ///< The bifur_hbond_list to query
+                                              const size_vec         &prm_break_indices,         ///< A list of the residues that are preceded by a chain break in ascending order
+                                              const size_t           &prm_num_threads,           ///< The number of threads to use (or 0 to use one per hardware thread)
+                                              const size_t           &prm_min_residues_per_thread ///< The minimum number of residues to give each thread
                                               ) {
-	const auto prm_bifur_hbond_list = remove_not_bondy_enough_copy( prm_bifur_hbond_list_raw );
+	const auto   prm_bifur_hbond_list = remove_not_bondy_enough_copy( prm_bifur_hbond_list_raw );
+	const size_t num_residues         = prm_bifur_hbond_list.size();
+
+	beta_bridge_vec_vec raw_beta_bridges( num_residues );
+	parallel_for_blocks(
+		num_residues,
+		prm_num_threads,
+		[&] (const size_t &prm_begin_idx, const size_t &prm_end_idx) {
+			for (size_t res_ctr = prm_begin_idx; res_ctr < prm_end_idx; ++res_ctr) {
+				raw_beta_bridges[ res_ctr ] = has_beta_bridge( prm_bifur_hbond_list, res_ctr );
+			}
+		},
+		prm_min_residues_per_thread
+	);
 
 	const auto beta_bridges = set_bridges_contexts_copy( remove_bridges_to_chain_break_residues_copy(
-		transform_build<beta_bridge_vec_vec>(
-			indices( prm_bifur_hbond_list.size() ),
-			[&] (const size_t &x) {
-				return has_beta_bridge( prm_bifur_hbond_list, x );
-			}
-		),
+		std::move( raw_beta_bridges ),
 		prm_break_indices
 	) );
 
@@ -770,25 +789,32 @@ sec_struc_type_vec cath::sec::calc_sec_strucs(const bifur_hbond_list &prm_bifur_
 	}
 
 	// Label the residues
-	for (const size_t &bifur_bond_ctr : indices( prm_bifur_hbond_list.size() ) ) {
-		// std::cerr << bifur_bond_ctr << "\t" << prm_bifur_hbond_list [ bifur_bond_ctr ];
-		// std::cerr <<  "  [";
-		// std::cerr << ( is_n_helix_bonded_to_later( prm_bifur_hbond_list, prm_break_indices, bifur_bond_ctr, 4 ) ? "4"s : " "s );
-		// std::cerr <<  "] [";
-		// std::cerr << ( is_n_helix_bonded_to_later( prm_bifur_hbond_list, prm_break_indices, bifur_bond_ctr, 3 ) ? "3"s : " "s );
-		// std::cerr <<  "] [";
-		// std::cerr << ( is_n_helix_bonded_to_later( prm_bifur_hbond_list, prm_break_indices, bifur_bond_ctr, 5 ) ? "5"s : " "s );
-		// std::cerr <<  "]\n";
-
-		// If this residue is part of a 4-helix (and not a 5-helix), label with alpha-helix
-		if ( is_in_4_helix_not_conflicting_with_5_helix( prm_bifur_hbond_list, prm_break_indices, bifur_bond_ctr ) ) {
-			results[ bifur_bond_ctr ] = sec_struc_type::ALPHA_HELIX;
-		}
-		// If this residue has any beta-bridges that are in beta-sheets, label with beta-strand
-		else if ( any_of( beta_bridges[ bifur_bond_ctr ], [] (const beta_bridge &x) { return x.context == beta_bridge_context::IN_SHEET; } ) ) {
-			results[ bifur_bond_ctr ] = sec_struc_type::BETA_STRAND;
-		}
-	}
+	parallel_for_blocks(
+		num_residues,
+		prm_num_threads,
+		[&] (const size_t &prm_begin_idx, const size_t &prm_end_idx) {
+			for (size_t bifur_bond_ctr = prm_begin_idx; bifur_bond_ctr < prm_end_idx; ++bifur_bond_ctr) {
+				// std::cerr << bifur_bond_ctr << "\t" << prm_bifur_hbond_list [ bifur_bond_ctr ];
+				// std::cerr <<  "  [";
+				// std::cerr << ( is_n_helix_bonded_to_later( prm_bifur_hbond_list, prm_break_indices, bifur_bond_ctr, 4 ) ? "4"s : " "s );
+				// std::cerr <<  "] [";
+				// std::cerr << ( is_n_helix_bonded_to_later( prm_bifur_hbond_list, prm_break_indices, bifur_bond_ctr, 3 ) ? "3"s : " "s );
+				// std::cerr <<  "] [";
+				// std::cerr << ( is_n_helix_bonded_to_later( prm_bifur_hbond_list, prm_break_indices, bifur_bond_ctr, 5 ) ? "5"s : " "s );
+				// std::cerr <<  "]\n";
+
+				// If this residue is part of a 4-helix (and not a 5-helix), label with alpha-helix
+				if ( is_in_4_helix_not_conflicting_with_5_helix( prm_bifur_hbond_list, prm_break_indices, bifur_bond_ctr ) ) {
+					results[ bifur_bond_ctr ] = sec_struc_type::ALPHA_HELIX;
+				}
+				// If this residue has any beta-bridges that are in beta-sheets, label with beta-strand
+				else if ( any_of( beta_bridges[ bifur_bond_ctr ], [] (const beta_bridge &x) { return x.context == beta_bridge_context::IN_SHEET; } ) ) {
+					results[ bifur_bond_ctr ] = sec_struc_type::BETA_STRAND;
+				}
+			}
+		},
+		prm_min_residues_per_thread
+	);
 
 	return results;
 }
@@ -796,28 +822,28 @@ sec_struc_type_vec cath::sec::calc_sec_strucs(const bifur_hbond_list &prm_bifur_
 /// \brief Calculate the sec_struc_type values for the specified pdb
 ///
 /// \relates pdb
-sec_struc_type_vec cath::sec::calc_sec_strucs_of_pdb__recalc_backbone_residues(const pdb             &prm_pdb,   ///< The pdb to query
-                                                                               const ostream_ref_opt &prm_stderr ///< An optional reference to an ostream to which any logging should be performed
+sec_struc_type_vec cath::sec::calc_sec_strucs_of_pdb__recalc_backbone_residues(const pdb             &prm_pdb,        ///< The pdb to query
+                                                                               const ostream_ref_opt &prm_stderr,     ///< An optional reference to an ostream to which any logging should be performed
+                                                                               const size_t          &prm_num_threads ///< The number of threads to use (or 0 to use one per hardware thread)
                                                                                ) {
 	const auto backbone_pdb = backbone_complete_subset_of_pdb(
 		prm_pdb,
 		prm_stderr,
 		dssp_skip_res_skipping::SKIP
 	).first;
-	return calc_sec_strucs(
-		dssp_hbond_calc::calc_bifur_hbonds_of_backbone_complete_pdb( backbone_pdb ),
-		indices_of_residues_following_chain_breaks( backbone_pdb )
-	);
+	return calc_sec_strucs_of_backbone_complete_pdb( backbone_pdb, prm_num_threads );
 }
 
 /// \brief Calculate the sec_struc_type values for the specified pdb
 ///
 /// \relates pdb
-sec_struc_type_vec cath::sec::calc_sec_strucs_of_backbone_complete_pdb(const pdb &prm_pdb ///< The pdb to query
+sec_struc_type_vec cath::sec::calc_sec_strucs_of_backbone_complete_pdb(const pdb    &prm_pdb,        ///< The pdb to query
+                                                                       const size_t &prm_num_threads ///< The number of threads to use (or 0 to use one per hardware thread)
                                                                        ) {
 	return calc_sec_strucs(
-		dssp_hbond_calc::calc_bifur_hbonds_of_backbone_complete_pdb( prm_pdb ),
-		indices_of_residues_following_chain_breaks( prm_pdb )
+		dssp_hbond_calc::calc_bifur_hbonds_of_backbone_complete_pdb( prm_pdb, prm_num_threads ),
+		indices_of_residues_following_chain_breaks( prm_pdb ),
+		prm_num_threads
 	);
 }
 
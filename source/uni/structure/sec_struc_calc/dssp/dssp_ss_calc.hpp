@@ -23,6 +23,7 @@
 
 #include <boost/optional/optional.hpp>
 
+#include "structure/sec_struc_calc/dssp/dssp_hbond_calc.hpp"
 #include "structure/structure_type_aliases.hpp"
 
 #include <vector>
@@ -240,12 +241,16 @@ namespace cath {
 		} // namespace detail
 
 		sec_struc_type_vec calc_sec_strucs(const bifur_hbond_list &,
-		                                   const size_vec &);
+		                                   const size_vec &,
+		                                   const size_t & = 1,
+		                                   const size_t & = detail::DEF_MIN_RESIDUES_PER_DSSP_THREAD);
 
 		sec_struc_type_vec calc_sec_strucs_of_pdb__recalc_backbone_residues(const file::pdb &,
-		                                                                    const ostream_ref_opt & = boost::none);
+		                                                                    const ostream_ref_opt & = boost::none,
+		                                                                    const size_t & = 1);
 
-		sec_struc_type_vec calc_sec_strucs_of_backbone_complete_pdb(const file::pdb &);
+		sec_struc_type_vec calc_sec_strucs_of_backbone_complete_pdb(const file::pdb &,
+		                                                            const size_t & = 1);
 
 		sec_struc_type_vec get_sec_strucs(const protein &);
 
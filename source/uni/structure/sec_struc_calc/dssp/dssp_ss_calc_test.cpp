@@ -32,6 +32,7 @@
 #include "structure/protein/residue.hpp"
 #include "structure/protein/sec_struc.hpp"
 #include "structure/protein/sec_struc_planar_angles.hpp"
+#include "structure/sec_struc_calc/dssp/bifur_hbond_list.hpp"
 #include "structure/sec_struc_calc/dssp/test/dssp_dupl_fixture.hpp"
 #include "test/boost_addenda/boost_check_equal_ranges.hpp"
 #include "test/global_test_constants.hpp"
@@ -47,6 +48,7 @@ using namespace cath::test;
 using boost::filesystem::directory_entry;
 using boost::filesystem::directory_iterator;
 using boost::filesystem::path;
+using boost::none;
 using boost::range::sort;
 
 namespace cath {
@@ -69,6 +71,17 @@ namespace cath {
 				const auto got_sss      = calc_sec_strucs_of_pdb__recalc_backbone_residues( parsed_pdb );
 
 				BOOST_CHECK_EQUAL_RANGES( got_sss, expected_sss );
+
+				// Check that splitting the residues across multiple threads gives the same results
+				const auto backbone_pdb       = backbone_complete_subset_of_pdb( parsed_pdb, none, dssp_skip_res_skipping::SKIP ).first;
+				const auto multi_threaded_sss = calc_sec_strucs(
+					dssp_hbond_calc::calc_bifur_hbonds_of_backbone_complete_pdb( backbone_pdb, 3, 1 ),
+					indices_of_residues_following_chain_breaks( backbone_pdb ),
+					3,
+					1
+				);
+
+				BOOST_CHECK_EQUAL_RANGES( multi_threaded_sss, expected_sss );
 			}
 
 			/// \brief Check the DSSP SS calculations against those in the specified file
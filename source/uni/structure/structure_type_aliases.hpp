@@ -27,12 +27,14 @@
 #include "common/type_aliases.hpp"
 #include "structure/geometry/coord_linkage.hpp"
 
+#include <functional>
 #include <set>
 #include <vector>
 
 namespace cath { class amino_acid; }
 namespace cath { class chain_label; }
 namespace cath { class protein; }
+namespace cath { class protein_comparison_view; }
 namespace cath { class residue; }
 namespace cath { class residue_id; }
 namespace cath { class residue_name; }
@@ -192,6 +194,12 @@ namespace cath {
 	/// \brief TODOCUMENT
 	using protein_vec                     = std::vector<protein>;
 
+	/// \brief Type alias for a reference_wrapper to a const protein_comparison_view
+	using protein_comparison_view_cref     = std::reference_wrapper<const protein_comparison_view>;
+
+	/// \brief Type alias for an optional protein_comparison_view_cref
+	using protein_comparison_view_cref_opt = boost::optional<protein_comparison_view_cref>;
+
 	/// \brief TODOCUMENT
 	using sec_struc_planar_angles_vec     = std::vector<sec_struc_planar_angles>;
 
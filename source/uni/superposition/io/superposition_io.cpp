@@ -178,23 +178,20 @@ void cath::sup::write_xml_sup_filename(const superposition  &prm_superposition,
 //	return prm_os;
 //}
 
-/// \brief TODOCUMENT
+/// \brief Write the specified pdb, superposed by the specified superposition's transformation for the specified index, to the specified ostream
+///
+/// This transforms the coordinates as it writes them (via write_transformed_pdb_file()) rather than copying the pdb
 ///
 /// \relates superposition
-ostream & cath::sup::write_superposed_pdb_to_ostream(ostream                    &prm_os,            ///< TODOCUMENT
-                                                     const superposition        &prm_superposition, ///< TODOCUMENT
-                                                     pdb                         prm_pdb,           ///< TODOCUMENT
-                                                     const size_t               &prm_chain_index,   ///< TODOCUMENT
-                                                     const chain_relabel_policy &prm_relabel_chain, ///< TODOCUMENT
+ostream & cath::sup::write_superposed_pdb_to_ostream(ostream                    &prm_os,            ///< The ostream to which the superposed PDB should be written
+                                                     const superposition        &prm_superposition, ///< The superposition to apply
+                                                     const pdb                  &prm_pdb,           ///< The pdb to superpose and write
+                                                     const size_t               &prm_chain_index,   ///< The index of the pdb within the superposition
+                                                     const chain_relabel_policy &prm_relabel_chain, ///< Whether to relabel the pdb's chains with a label for its index in the superposition
                                                      const region_vec_opt       &prm_regions,       ///< Optional specification of regions to which the written records should be restricted
                                                      const pdb_write_mode       &prm_pdb_write_mode ///< Whether this is the only/last part of the PDB file
                                                      ) {
-	// Translate PDB
-	prm_pdb += prm_superposition.get_translation_of_index( prm_chain_index );
-
-	// Rotate PDB
-	prm_pdb.rotate( prm_superposition.get_rotation_of_index( prm_chain_index ) );
-
+	chain_label_opt new_chain_label;
 	if ( prm_relabel_chain == chain_relabel_policy::RELABEL ) {
 		// Label structure with sensible chain label
 		//
@@ -220,12 +217,18 @@ ostream & cath::sup::write_superposed_pdb_to_ostream(ostream
 				<< ".";
 		}
 
-		prm_pdb.set_chain_label( superposition::SUPERPOSITION_CHAIN_LABELS[ prm_chain_index ] );
+		new_chain_label = superposition::SUPERPOSITION_CHAIN_LABELS[ prm_chain_index ];
 	}
 
-	write_pdb_file( prm_os, prm_pdb, prm_regions, prm_pdb_write_mode );
-
-	return prm_os;
+	return write_transformed_pdb_file(
+		prm_os,
+		prm_pdb,
+		prm_superposition.get_translation_of_index( prm_chain_index ),
+		prm_superposition.get_rotation_of_index( prm_chain_index ),
+		new_chain_label,
+		prm_regions,
+		prm_pdb_write_mode
+	);
 }
 
 /// \brief TODOCUMENT
@@ -233,7 +236,7 @@ ostream & cath::sup::write_superposed_pdb_to_ostream(ostream
 /// \relates superposition
 ostream & cath::sup::write_superposed_pdbs_to_ostream(ostream                      &prm_os,             ///< TODOCUMENT
                                                       const superposition          &prm_superposition,  ///< TODOCUMENT
-                                                      const pdb_list                prm_pdbs,           ///< TODOCUMENT
+                                                      const pdb_list               &prm_pdbs,           ///< TODOCUMENT
                                                       const sup_pdbs_script_policy &prm_script_policy,  ///< TODOCUMENT
                                                       const chain_relabel_policy   &prm_relabel_chain,  ///< TODOCUMENT
                                                       const region_vec_opt         &prm_regions         ///< Optional specification of regions to which the written records should be restricted
@@ -67,7 +67,7 @@ namespace cath {
 
 		std::ostream & write_superposed_pdb_to_ostream(std::ostream &,
 		                                               const superposition &,
-		                                               file::pdb,
+		                                               const file::pdb &,
 		                                               const size_t &,
 		                                               const chain_relabel_policy & = chain_relabel_policy::LEAVE,
 		                                               const chop::region_vec_opt & = boost::none,
@@ -75,7 +75,7 @@ namespace cath {
 
 		std::ostream & write_superposed_pdbs_to_ostream(std::ostream &,
 		                                                const superposition &,
-		                                                file::pdb_list,
+		                                                const file::pdb_list &,
 		                                                const sup_pdbs_script_policy &,
 		                                                const chain_relabel_policy & = chain_relabel_policy::LEAVE,
 		                                                const chop::region_vec_opt & = boost::none);
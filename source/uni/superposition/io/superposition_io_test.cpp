@@ -23,9 +23,12 @@
 
 #include "chopping/region/region.hpp"
 #include "common/boost_addenda/log/stringstream_log_sink.hpp"
+#include "common/boost_addenda/range/indices.hpp"
 #include "common/file/temp_file.hpp"
 #include "common/property_tree/from_json_string.hpp"
 #include "common/property_tree/to_json_string.hpp"
+#include "structure/geometry/angle.hpp"
+#include "structure/geometry/rotation.hpp"
 #include "superposition/io/superposition_io.hpp"
 #include "test/superposition_fixture.hpp"
 
@@ -41,11 +44,50 @@ using namespace cath::sup;
 using ::boost::filesystem::path;
 using ::std::ostringstream;
 using ::std::regex;
+using ::std::string;
 
 /// \brief The superposition_io_test_suite_fixture to assist in testing superposition I/O
 struct superposition_io_test_suite_fixture : protected superposition_fixture{
 protected:
 	~superposition_io_test_suite_fixture() noexcept = default;
+
+	/// \brief Some example PDBs (the first of which has multiple chains)
+	const pdb_list example_pdbs = make_pdb_list( {
+		read_pdb_file( TEST_SOURCE_DATA_DIR() / "supn_content" / "1bdh" ),
+		read_pdb_file( TEST_SOURCE_DATA_DIR() / "1c0pA01"               )
+	} );
+
+	/// \brief A superposition with a non-trivial translation and rotation for the second entry
+	const superposition transforming_sup{
+		coord_vec{ ORIGIN_COORD, coord{ 12.3456, -7.0005, 0.1234 } },
+		rotation_vec{ rotation::IDENTITY_ROTATION(), rotation_of_angle( make_angle_from_degrees<double>( 37.5 ) ) }
+	};
+
+	/// \brief Write the specified pdb superposed in the old way: by transforming a copy and then calling write_pdb_file()
+	string superposed_pdb_string_via_copy(const pdb                  &prm_pdb,           ///< The pdb to superpose and write
+	                                      const size_t               &prm_index,         ///< The index of the pdb in transforming_sup
+	                                      const chain_relabel_policy &prm_relabel_chain  ///< Whether to relabel the chains
+	                                      ) const {
+		pdb pdb_copy = prm_pdb;
+		pdb_copy += transforming_sup.get_translation_of_index( prm_index );
+		pdb_copy.rotate( transforming_sup.get_rotation_of_index( prm_index ) );
+		if ( prm_relabel_chain == chain_relabel_policy::RELABEL ) {
+			pdb_copy.set_chain_label( superposition::SUPERPOSITION_CHAIN_LABELS[ prm_index ] );
+		}
+		ostringstream out_ss;
+		write_pdb_file( out_ss, pdb_copy );
+		return out_ss.str();
+	}
+
+	/// \brief Write the specified pdb superposed via write_superposed_pdb_to_ostream()
+	string superposed_pdb_string(const pdb                  &prm_pdb,           ///< The pdb to superpose and write
+	                             const size_t               &prm_index,         ///< The index of the pdb in transforming_sup
+	                             const chain_relabel_policy &prm_relabel_chain  ///< Whether to relabel the chains
+	                             ) const {
+		ostringstream out_ss;
+		write_superposed_pdb_to_ostream( out_ss, transforming_sup, prm_pdb, prm_index, prm_relabel_chain );
+		return out_ss.str();
+	}
 };
 
 BOOST_FIXTURE_TEST_SUITE(superposition_io_test_suite, superposition_io_test_suite_fixture)
@@ -70,6 +112,18 @@ BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_CASE(write_superposed_pdb_gives_same_bytes_as_transforming_a_copy) {
+	const stringstream_log_sink log_sink;
+	for (const size_t &pdb_ctr : indices( example_pdbs.size() ) ) {
+		for (const chain_relabel_policy &relabel : { chain_relabel_policy::LEAVE, chain_relabel_policy::RELABEL } ) {
+			BOOST_CHECK_EQUAL(
+				superposed_pdb_string         ( example_pdbs[ pdb_ctr ], pdb_ctr, relabel ),
+				superposed_pdb_string_via_copy( example_pdbs[ pdb_ctr ], pdb_ctr, relabel )
+			);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE(warns_if_overwriting_chain_label_in_pdb_with_multiple_chains) {
 	const stringstream_log_sink log_sink;
 	const temp_file temp_file("cath_tools_test_temp_file.superposition_chain_munge_warning.%%%%");